@@ -305,6 +305,329 @@ int unicode_from_utf8(const uint8_t *p, int max_len, const uint8_t **pp)
     return c;
 }
 
+/* Helpers for the conversions between UTF-8 and the 8 bit or 16 bit
+   strings. They process 16 bytes at a time with SSE2. */
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* return the number of leading chars < 0x80 */
+size_t mem_ascii_len_u8(const uint8_t *s, size_t n)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    uint32_t mask;
+    for(; i + 16 <= n; i += 16) {
+        mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i)));
+        if (mask)
+            return i + ctz32(mask);
+    }
+#endif
+    while (i < n && s[i] < 0x80)
+        i++;
+    return i;
+}
+
+size_t mem_ascii_len_u16(const uint16_t *s, size_t n)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i v, m = _mm_set1_epi16(0xff80), zero = _mm_setzero_si128();
+    uint32_t mask;
+    for(; i + 8 <= n; i += 8) {
+        v = _mm_and_si128(_mm_loadu_si128((const __m128i *)(s + i)), m);
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi16(v, zero)) ^ 0xffff;
+        if (mask)
+            return i + (ctz32(mask) >> 1);
+    }
+#endif
+    while (i < n && s[i] < 0x80)
+        i++;
+    return i;
+}
+
+/* return the number of chars >= 0x80 */
+size_t mem_count_non_ascii_u8(const uint8_t *s, size_t n)
+{
+    size_t i = 0, count = 0;
+#if defined(__SSE2__)
+    __m128i acc, zero = _mm_setzero_si128();
+    int j;
+    while (i + 16 <= n) {
+        /* at most 255 iterations so that the byte counters do not
+           overflow */
+        acc = zero;
+        for(j = 0; j < 255 && i + 16 <= n; j++, i += 16) {
+            acc = _mm_sub_epi8(acc, _mm_cmplt_epi8(_mm_loadu_si128((const __m128i *)(s + i)), zero));
+        }
+        acc = _mm_sad_epu8(acc, zero);
+        count += _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+    }
+#endif
+    for(; i < n; i++)
+        count += s[i] >> 7;
+    return count;
+}
+
+/* dst[i] = src[i] for i < n */
+void mem_widen_u8(uint16_t *dst, const uint8_t *src, size_t n)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i v, zero = _mm_setzero_si128();
+    for(; i + 16 <= n; i += 16) {
+        v = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i *)(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+#endif
+    for(; i < n; i++)
+        dst[i] = src[i];
+}
+
+/* dst[i] = src[i] for i < n. src[i] must be < 0x100. */
+void mem_narrow_u16(uint8_t *dst, const uint16_t *src, size_t n)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i a, b;
+    for(; i + 16 <= n; i += 16) {
+        a = _mm_loadu_si128((const __m128i *)(src + i));
+        b = _mm_loadu_si128((const __m128i *)(src + i + 8));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(a, b));
+    }
+#endif
+    for(; i < n; i++)
+        dst[i] = src[i];
+}
+
+/* return the length of the prefix of 's' without '"', '\\', control
+   or non-ASCII characters, i.e. the plain part of a JSON string */
+size_t mem_json_str_len(const uint8_t *s, size_t n)
+{
+    size_t i = 0;
+    int c;
+#if defined(__SSE2__)
+    __m128i v, m, quote = _mm_set1_epi8('\"'), bs = _mm_set1_epi8('\\');
+    __m128i space = _mm_set1_epi8(0x20);
+    uint32_t mask;
+    for(; i + 16 <= n; i += 16) {
+        v = _mm_loadu_si128((const __m128i *)(s + i));
+        /* signed comparison: also true for the chars >= 0x80 */
+        m = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmplt_epi8(v, space));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, bs));
+        mask = _mm_movemask_epi8(m);
+        if (mask)
+            return i + ctz32(mask);
+    }
+#endif
+    for(; i < n; i++) {
+        c = s[i];
+        if (c < 0x20 || c >= 0x80 || c == '\"' || c == '\\')
+            break;
+    }
+    return i;
+}
+
+/* Fast search of a pair of elements. The substring search uses it
+   with the first and last characters of the searched string, which
+   gives few false positives. */
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+#define MEM_VEC_LEN 32 /* number of elements per block */
+typedef __m256i mem_vec;
+
+static inline mem_vec mem_vec_set8(int c)
+{
+    return _mm256_set1_epi8(c);
+}
+
+static inline mem_vec mem_vec_set16(int c)
+{
+    return _mm256_set1_epi16(c);
+}
+
+/* bit i is set if s[i] == c0 and s[i + d] == c1 */
+static inline uint32_t mem_find2_mask_u8(const uint8_t *s, size_t d,
+                                         mem_vec v0, mem_vec v1)
+{
+    __m256i a, b;
+    a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)s), v0);
+    b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + d)), v1);
+    return _mm256_movemask_epi8(_mm256_and_si256(a, b));
+}
+
+static inline uint32_t mem_find2_mask_u16(const uint16_t *s, size_t d,
+                                          mem_vec v0, mem_vec v1)
+{
+    __m256i a, b, lo, hi;
+    a = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)s), v0);
+    b = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)(s + d)), v1);
+    lo = _mm256_and_si256(a, b);
+    a = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)(s + 16)), v0);
+    b = _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)(s + d + 16)), v1);
+    hi = _mm256_and_si256(a, b);
+    /* packs works on 128 bit lanes */
+    lo = _mm256_permute4x64_epi64(_mm256_packs_epi16(lo, hi), 0xd8);
+    return _mm256_movemask_epi8(lo);
+}
+
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+
+#define MEM_VEC_LEN 16 /* number of elements per block */
+typedef __m128i mem_vec;
+
+static inline mem_vec mem_vec_set8(int c)
+{
+    return _mm_set1_epi8(c);
+}
+
+static inline mem_vec mem_vec_set16(int c)
+{
+    return _mm_set1_epi16(c);
+}
+
+/* bit i is set if s[i] == c0 and s[i + d] == c1 */
+static inline uint32_t mem_find2_mask_u8(const uint8_t *s, size_t d,
+                                         mem_vec v0, mem_vec v1)
+{
+    __m128i a, b;
+    a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)s), v0);
+    b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + d)), v1);
+    return _mm_movemask_epi8(_mm_and_si128(a, b));
+}
+
+static inline uint32_t mem_find2_mask_u16(const uint16_t *s, size_t d,
+                                          mem_vec v0, mem_vec v1)
+{
+    __m128i a, b, lo, hi;
+    a = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)s), v0);
+    b = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(s + d)), v1);
+    lo = _mm_and_si128(a, b);
+    a = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(s + 8)), v0);
+    b = _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)(s + d + 8)), v1);
+    hi = _mm_and_si128(a, b);
+    return _mm_movemask_epi8(_mm_packs_epi16(lo, hi));
+}
+
+#endif
+
+/* return the first position i in [0, n) such that s[i] == c0 and
+   s[i + d] == c1 or NULL if none. s[n + d - 1] must be readable. */
+const uint8_t *mem_find2_u8(const uint8_t *s, size_t n,
+                            uint8_t c0, uint8_t c1, size_t d)
+{
+    size_t i;
+
+    if (d == 0) {
+        if (c0 != c1)
+            return NULL;
+        return memchr(s, c0, n);
+    }
+    i = 0;
+#ifdef MEM_VEC_LEN
+    {
+        mem_vec v0 = mem_vec_set8(c0), v1 = mem_vec_set8(c1);
+        uint32_t mask;
+        for(; i + MEM_VEC_LEN <= n; i += MEM_VEC_LEN) {
+            mask = mem_find2_mask_u8(s + i, d, v0, v1);
+            if (mask)
+                return s + i + ctz32(mask);
+        }
+    }
+#endif
+    for(; i < n; i++) {
+        if (s[i] == c0 && s[i + d] == c1)
+            return s + i;
+    }
+    return NULL;
+}
+
+/* same as mem_find2_u8() but return the last position */
+const uint8_t *mem_rfind2_u8(const uint8_t *s, size_t n,
+                             uint8_t c0, uint8_t c1, size_t d)
+{
+    size_t i;
+
+    if (c0 != c1 && d == 0)
+        return NULL;
+    i = n;
+#ifdef MEM_VEC_LEN
+    {
+        mem_vec v0 = mem_vec_set8(c0), v1 = mem_vec_set8(c1);
+        uint32_t mask;
+        for(; i >= MEM_VEC_LEN; i -= MEM_VEC_LEN) {
+            mask = mem_find2_mask_u8(s + i - MEM_VEC_LEN, d, v0, v1);
+            if (mask)
+                return s + i - 1 - clz32(mask) + (32 - MEM_VEC_LEN);
+        }
+    }
+#endif
+    while (i > 0) {
+        i--;
+        if (s[i] == c0 && s[i + d] == c1)
+            return s + i;
+    }
+    return NULL;
+}
+
+const uint16_t *mem_find2_u16(const uint16_t *s, size_t n,
+                              uint16_t c0, uint16_t c1, size_t d)
+{
+    size_t i;
+
+    if (c0 != c1 && d == 0)
+        return NULL;
+    i = 0;
+#ifdef MEM_VEC_LEN
+    {
+        mem_vec v0 = mem_vec_set16(c0), v1 = mem_vec_set16(c1);
+        uint32_t mask;
+        for(; i + MEM_VEC_LEN <= n; i += MEM_VEC_LEN) {
+            mask = mem_find2_mask_u16(s + i, d, v0, v1);
+            if (mask)
+                return s + i + ctz32(mask);
+        }
+    }
+#endif
+    for(; i < n; i++) {
+        if (s[i] == c0 && s[i + d] == c1)
+            return s + i;
+    }
+    return NULL;
+}
+
+const uint16_t *mem_rfind2_u16(const uint16_t *s, size_t n,
+                               uint16_t c0, uint16_t c1, size_t d)
+{
+    size_t i;
+
+    if (c0 != c1 && d == 0)
+        return NULL;
+    i = n;
+#ifdef MEM_VEC_LEN
+    {
+        mem_vec v0 = mem_vec_set16(c0), v1 = mem_vec_set16(c1);
+        uint32_t mask;
+        for(; i >= MEM_VEC_LEN; i -= MEM_VEC_LEN) {
+            mask = mem_find2_mask_u16(s + i - MEM_VEC_LEN, d, v0, v1);
+            if (mask)
+                return s + i - 1 - clz32(mask) + (32 - MEM_VEC_LEN);
+        }
+    }
+#endif
+    while (i > 0) {
+        i--;
+        if (s[i] == c0 && s[i + d] == c1)
+            return s + i;
+    }
+    return NULL;
+}
+
 #if 0
 
 #if defined(EMSCRIPTEN) || defined(__ANDROID__)
@@ -298,6 +298,22 @@ static inline void dbuf_set_error(DynBuf *s)
 int unicode_to_utf8(uint8_t *buf, unsigned int c);
 int unicode_from_utf8(const uint8_t *p, int max_len, const uint8_t **pp);
 
+size_t mem_ascii_len_u8(const uint8_t *s, size_t n);
+size_t mem_ascii_len_u16(const uint16_t *s, size_t n);
+size_t mem_count_non_ascii_u8(const uint8_t *s, size_t n);
+void mem_widen_u8(uint16_t *dst, const uint8_t *src, size_t n);
+void mem_narrow_u16(uint8_t *dst, const uint16_t *src, size_t n);
+size_t mem_json_str_len(const uint8_t *s, size_t n);
+
+const uint8_t *mem_find2_u8(const uint8_t *s, size_t n,
+                            uint8_t c0, uint8_t c1, size_t d);
+const uint8_t *mem_rfind2_u8(const uint8_t *s, size_t n,
+                             uint8_t c0, uint8_t c1, size_t d);
+const uint16_t *mem_find2_u16(const uint16_t *s, size_t n,
+                              uint16_t c0, uint16_t c1, size_t d);
+const uint16_t *mem_rfind2_u16(const uint16_t *s, size_t n,
+                               uint16_t c0, uint16_t c1, size_t d);
+
 static inline BOOL is_surrogate(uint32_t c)
 {
     return (c >> 11) == (0xD800 >> 11); // 0xD800-0xDFFF
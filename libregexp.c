@@ -32,6 +32,12 @@
 #include "libregexp.h"
 #include "libunicode.h"
 
+#if defined(CONFIG_REGEXP_JIT) && defined(__x86_64__) && defined(__linux__)
+#define RE_JIT
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
 /*
   TODO:
 
@@ -57,6 +63,10 @@ typedef enum {
 /* must be large enough to have a negligible runtime cost and small
    enough to call the interrupt callback often. */
 #define INTERRUPT_COUNTER_INIT 10000
+/* internal: the backtracking engine gives up and the NFA is used */
+#define LRE_RET_NFA_FALLBACK (-3)
+/* number of backtracking steps per input char before using the NFA */
+#define NFA_FALLBACK_STEPS 32
 
 /* unicode code points */
 #define CP_LS   0x2028
@@ -107,8 +117,27 @@ static const REOpCode reopcode_info[REOP_COUNT] = {
 #define RE_HEADER_CAPTURE_COUNT 2
 #define RE_HEADER_STACK_SIZE    3
 #define RE_HEADER_BYTECODE_LEN  4
+#define RE_HEADER_PREFILTER_LEN 8
+#define RE_HEADER_NFA_LEN       10
+
+#define RE_HEADER_LEN 14
+
+/* The prefilter follows the bytecode. It is used by lre_exec() to
+   skip the positions where the regexp cannot start to match. */
+#define RE_PREFILTER_FLAGS        0
+#define RE_PREFILTER_PREFIX_LEN   1 /* number of chars of the literal prefix */
+#define RE_PREFILTER_REQUIRED_LEN 2 /* number of chars of the required literal */
+#define RE_PREFILTER_LEN 3
+/* followed by the first char bitmap (32 bytes, if
+   RE_PREFILTER_FIRST_SET), the prefix and the required literal (16
+   bit chars) */
 
-#define RE_HEADER_LEN 8
+#define RE_PREFILTER_HAS_LOOP       (1 << 0) /* bytecode starts with the search loop */
+#define RE_PREFILTER_FIRST_SET      (1 << 1) /* first char bitmap for chars < 256 */
+#define RE_PREFILTER_FIRST_SET_WIDE (1 << 2) /* any char >= 256 may start a match */
+
+#define RE_SEARCH_LOOP_LEN (5 + 1 + 5)
+#define RE_LITERAL_MAX 32
 
 static inline int is_digit(int c) {
     return c >= '0' && c <= '9';
@@ -470,7 +499,9 @@ static __maybe_unused void lre_dump_bytecode(const uint8_t *buf,
            re_flags, buf[RE_HEADER_CAPTURE_COUNT], buf[RE_HEADER_STACK_SIZE]);
     if (re_flags & LRE_FLAG_NAMED_GROUPS) {
         const char *p;
-        p = (char *)buf + RE_HEADER_LEN + bc_len;
+        p = (char *)buf + RE_HEADER_LEN + bc_len +
+            get_u16(buf + RE_HEADER_PREFILTER_LEN) +
+            get_u32(buf + RE_HEADER_NFA_LEN);
         printf("named groups: ");
         for(i = 1; i < buf[RE_HEADER_CAPTURE_COUNT]; i++) {
             if (i != 1)
@@ -2444,6 +2475,610 @@ static void *lre_bytecode_realloc(void *opaque, void *ptr, size_t size)
     }
 }
 
+typedef struct {
+    const uint8_t *bc_buf;
+    int bc_len;
+    uint8_t *visited;
+    uint8_t first_set[32];
+    BOOL first_set_wide;
+    int depth;
+} REFirstCharState;
+
+static void re_first_set_add(REFirstCharState *s, uint32_t c1, uint32_t c2)
+{
+    uint32_t c;
+    if (c2 >= 256) {
+        s->first_set_wide = TRUE;
+        c2 = 255;
+    }
+    for(c = c1; c <= c2; c++)
+        s->first_set[c >> 3] |= 1 << (c & 7);
+}
+
+/* Add to s->first_set the characters which can be matched first when
+   executing the bytecode from 'pos'. Return -1 if they cannot be
+   determined (assertion, empty match, ...). */
+static int re_first_chars(REFirstCharState *s, int pos)
+{
+    int opcode, n, i, ret;
+    uint32_t c, val;
+
+    if (++s->depth > 64)
+        return -1;
+    for(;;) {
+        if (pos < 0 || pos >= s->bc_len)
+            return -1;
+        /* already explored */
+        if (s->visited[pos >> 3] & (1 << (pos & 7)))
+            break;
+        s->visited[pos >> 3] |= 1 << (pos & 7);
+        opcode = s->bc_buf[pos];
+        switch(opcode) {
+        case REOP_char:
+        case REOP_char32:
+            if (opcode == REOP_char)
+                c = get_u16(s->bc_buf + pos + 1);
+            else
+                c = get_u32(s->bc_buf + pos + 1);
+            re_first_set_add(s, c, c);
+            goto done;
+        case REOP_char_i:
+        case REOP_char32_i:
+            /* no char >= 128 and < 256 has an ASCII canonical form */
+            if (opcode == REOP_char_i)
+                c = get_u16(s->bc_buf + pos + 1);
+            else
+                c = get_u32(s->bc_buf + pos + 1);
+            if (c >= 128)
+                return -1;
+            re_first_set_add(s, c, c);
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+                re_first_set_add(s, c ^ 0x20, c ^ 0x20);
+            /* non ASCII chars such as U+212A may be canonicalized to ASCII */
+            s->first_set_wide = TRUE;
+            goto done;
+        case REOP_range:
+            n = get_u16(s->bc_buf + pos + 1);
+            for(i = 0; i < n; i++) {
+                re_first_set_add(s, get_u16(s->bc_buf + pos + 3 + i * 4),
+                                 get_u16(s->bc_buf + pos + 3 + i * 4 + 2));
+            }
+            goto done;
+        case REOP_range32:
+            n = get_u16(s->bc_buf + pos + 1);
+            for(i = 0; i < n; i++) {
+                re_first_set_add(s, get_u32(s->bc_buf + pos + 3 + i * 8),
+                                 get_u32(s->bc_buf + pos + 3 + i * 8 + 4));
+            }
+            goto done;
+        case REOP_save_start:
+        case REOP_save_end:
+        case REOP_save_reset:
+            pos += reopcode_info[opcode].size;
+            break;
+        case REOP_goto:
+            val = get_u32(s->bc_buf + pos + 1);
+            pos += 5 + (int)val;
+            break;
+        case REOP_split_goto_first:
+        case REOP_split_next_first:
+            val = get_u32(s->bc_buf + pos + 1);
+            ret = re_first_chars(s, pos + 5);
+            if (ret < 0)
+                return ret;
+            pos += 5 + (int)val;
+            break;
+        case REOP_simple_greedy_quant:
+            ret = re_first_chars(s, pos + 17);
+            if (ret < 0)
+                return ret;
+            /* quant_min */
+            if (get_u32(s->bc_buf + pos + 5) != 0)
+                goto done;
+            val = get_u32(s->bc_buf + pos + 1);
+            pos += 17 + (int)val;
+            break;
+        default:
+            return -1;
+        }
+    }
+ done:
+    s->depth--;
+    return 0;
+}
+
+/* Extract from the bytecode a literal prefix, the set of the possible
+   first chars and a literal which must be present in any match. The
+   literals are found by a linear scan of the bytecode: an opcode is
+   executed by every match if no jump goes over it. */
+static int re_compute_prefilter(REParseState *s, BOOL has_loop)
+{
+    const uint8_t *bc_buf;
+    int bc_len, start, pos, len, opcode, skip_until, target;
+    int prefix_len, required_len, lit_len, first_ok, i, flags;
+    BOOL at_start;
+    uint16_t lit[RE_LITERAL_MAX], prefix[RE_LITERAL_MAX];
+    uint16_t required[RE_LITERAL_MAX];
+    REFirstCharState fc_s, *fc = &fc_s;
+    size_t pf_pos;
+    uint32_t c;
+
+    bc_buf = s->byte_code.buf + RE_HEADER_LEN;
+    bc_len = s->byte_code.size - RE_HEADER_LEN;
+    start = has_loop ? RE_SEARCH_LOOP_LEN : 0;
+
+    prefix_len = 0;
+    required_len = 0;
+    lit_len = 0;
+    at_start = TRUE;
+    skip_until = start;
+    for(pos = start; pos < bc_len; pos += len) {
+        opcode = bc_buf[pos];
+        len = reopcode_info[opcode].size;
+        switch(opcode) {
+        case REOP_range:
+        case REOP_range_i:
+            len += get_u16(bc_buf + pos + 1) * 4;
+            break;
+        case REOP_range32:
+        case REOP_range32_i:
+            len += get_u16(bc_buf + pos + 1) * 8;
+            break;
+        case REOP_goto:
+        case REOP_split_goto_first:
+        case REOP_split_next_first:
+        case REOP_lookahead:
+        case REOP_negative_lookahead:
+        case REOP_loop:
+            target = pos + 5 + (int)get_u32(bc_buf + pos + 1);
+            skip_until = max_int(skip_until, target);
+            break;
+        case REOP_simple_greedy_quant:
+            target = pos + 17 + (int)get_u32(bc_buf + pos + 1);
+            skip_until = max_int(skip_until, target);
+            break;
+        }
+        if (pos >= skip_until) {
+            if (opcode == REOP_char) {
+                c = get_u16(bc_buf + pos + 1);
+                if (!is_surrogate(c)) {
+                    if (lit_len < RE_LITERAL_MAX)
+                        lit[lit_len++] = c;
+                    continue;
+                }
+            } else if (opcode == REOP_save_start ||
+                       opcode == REOP_save_end ||
+                       opcode == REOP_save_reset) {
+                continue;
+            }
+        }
+        /* end of the current literal */
+        if (at_start) {
+            memcpy(prefix, lit, lit_len * sizeof(lit[0]));
+            prefix_len = lit_len;
+            at_start = FALSE;
+        } else if (lit_len > required_len) {
+            memcpy(required, lit, lit_len * sizeof(lit[0]));
+            required_len = lit_len;
+        }
+        lit_len = 0;
+    }
+    if (!has_loop) {
+        /* sticky: the prefix is only used as a required literal */
+        if (prefix_len > required_len) {
+            memcpy(required, prefix, prefix_len * sizeof(prefix[0]));
+            required_len = prefix_len;
+        }
+        prefix_len = 0;
+    }
+
+    first_ok = -1;
+    memset(fc, 0, sizeof(*fc));
+    if (has_loop && prefix_len == 0) {
+        fc->bc_buf = bc_buf;
+        fc->bc_len = bc_len;
+        fc->visited = lre_realloc(s->opaque, NULL, (bc_len + 7) >> 3);
+        if (fc->visited) {
+            memset(fc->visited, 0, (bc_len + 7) >> 3);
+            first_ok = re_first_chars(fc, start);
+            lre_realloc(s->opaque, fc->visited, 0);
+        }
+        if (first_ok == 0 && fc->first_set_wide) {
+            /* useless if all the chars can start a match */
+            for(i = 0; i < 32; i++) {
+                if (fc->first_set[i] != 0xff)
+                    break;
+            }
+            if (i == 32)
+                first_ok = -1;
+        }
+    }
+
+    if (first_ok < 0 && prefix_len == 0 && required_len == 0)
+        return 0;
+    flags = 0;
+    if (has_loop)
+        flags |= RE_PREFILTER_HAS_LOOP;
+    if (first_ok == 0) {
+        flags |= RE_PREFILTER_FIRST_SET;
+        if (fc->first_set_wide)
+            flags |= RE_PREFILTER_FIRST_SET_WIDE;
+    }
+    pf_pos = s->byte_code.size;
+    dbuf_putc(&s->byte_code, flags);
+    dbuf_putc(&s->byte_code, prefix_len);
+    dbuf_putc(&s->byte_code, required_len);
+    if (first_ok == 0)
+        dbuf_put(&s->byte_code, fc->first_set, 32);
+    for(i = 0; i < prefix_len; i++)
+        dbuf_put_u16(&s->byte_code, prefix[i]);
+    for(i = 0; i < required_len; i++)
+        dbuf_put_u16(&s->byte_code, required[i]);
+    if (dbuf_error(&s->byte_code))
+        return -1;
+    put_u16(s->byte_code.buf + RE_HEADER_PREFILTER_LEN,
+            s->byte_code.size - pf_pos);
+    return 0;
+}
+
+/* Linear time engine: the regexps without back references and
+   lookarounds are also compiled to a Thompson NFA, executed by a Pike
+   VM when the backtracking engine takes too long. The counted
+   quantifiers are unrolled. The zero advance checks of the loops are
+   nested: each thread has a bit mask 'no advance' of its enclosing
+   loops indexed by their nesting level. push_char_pos sets the bit of
+   its loop, check_advance kills the thread if it is still set and
+   consuming a char clears the mask. The set bits are always the
+   innermost loops, so a node is visited at most once per lowest set
+   bit at each position. */
+
+#define RE_NFA_MAX_NODES 4096
+#define RE_NFA_NODE_SIZE 12
+#define RE_NFA_MAX_LEVELS 31 /* maximum nesting of the zero advance checks */
+
+typedef enum {
+    RE_NFA_CHAR, /* consume a char: 'arg' is the offset of the opcode */
+    RE_NFA_ASSERT, /* zero width assertion: 'arg' is the offset of the opcode */
+    RE_NFA_JMP,
+    RE_NFA_SPLIT, /* try 'out' first, then 'arg' */
+    RE_NFA_SAVE, /* capture[2 * a + b] = current position */
+    RE_NFA_RESET, /* reset the captures a to b */
+    RE_NFA_PUSH_CHAR_POS, /* set the bit 'a' of the no advance mask */
+    RE_NFA_CHECK_ADVANCE, /* fail if the bit 'a' is set */
+    RE_NFA_MATCH,
+} RENFAOpEnum;
+
+typedef struct {
+    uint8_t op;
+    uint8_t a, b;
+    int out;
+    int arg;
+} RENFANode;
+
+typedef struct {
+    const uint8_t *bc_buf;
+    int bc_len;
+    uint8_t *level; /* nesting level of the zero advance checks */
+    RENFANode *nodes;
+    int node_count;
+    int node_size;
+    void *opaque;
+} RENFABuildState;
+
+static int re_nfa_new_node(RENFABuildState *b)
+{
+    RENFANode *n;
+    int new_size;
+
+    if (b->node_count >= RE_NFA_MAX_NODES)
+        return -1;
+    if (b->node_count >= b->node_size) {
+        new_size = min_int(max_int(16, b->node_size * 3 / 2), RE_NFA_MAX_NODES);
+        n = lre_realloc(b->opaque, b->nodes, new_size * sizeof(b->nodes[0]));
+        if (!n)
+            return -1;
+        b->nodes = n;
+        b->node_size = new_size;
+    }
+    n = &b->nodes[b->node_count];
+    n->op = RE_NFA_JMP;
+    n->a = 0;
+    n->b = 0;
+    n->out = -1;
+    n->arg = -1;
+    return b->node_count++;
+}
+
+/* return the position after the opcode at 'pos' or after the counted
+   loop or simple quantifier starting at 'pos'. Return -1 if
+   unexpected bytecode. */
+static int re_nfa_op_end(RENFABuildState *b, int pos)
+{
+    const uint8_t *bc_buf = b->bc_buf;
+    int opcode, len, depth, p;
+
+    opcode = bc_buf[pos];
+    len = reopcode_info[opcode].size;
+    switch(opcode) {
+    case REOP_range:
+    case REOP_range_i:
+        len += get_u16(bc_buf + pos + 1) * 4;
+        break;
+    case REOP_range32:
+    case REOP_range32_i:
+        len += get_u16(bc_buf + pos + 1) * 8;
+        break;
+    case REOP_simple_greedy_quant:
+        len += get_u32(bc_buf + pos + 1);
+        break;
+    case REOP_push_i32:
+        /* push_i32 n; L: atom; loop L; drop */
+        depth = 0;
+        for(p = pos + len; p < b->bc_len; p += len) {
+            opcode = bc_buf[p];
+            len = reopcode_info[opcode].size;
+            if (opcode == REOP_push_i32) {
+                depth++;
+            } else if (opcode == REOP_drop) {
+                if (depth == 0) {
+                    if (p < pos + 10 || bc_buf[p - 5] != REOP_loop ||
+                        p + (int)get_u32(bc_buf + p - 4) != pos + 5)
+                        return -1;
+                    return p + 1;
+                }
+                depth--;
+            } else if (opcode == REOP_range || opcode == REOP_range_i) {
+                len += get_u16(bc_buf + p + 1) * 4;
+            } else if (opcode == REOP_range32 || opcode == REOP_range32_i) {
+                len += get_u16(bc_buf + p + 1) * 8;
+            }
+        }
+        return -1;
+    }
+    return pos + len;
+}
+
+/* Build the nodes of the bytecode range [start, end). Falling thru
+   'end' goes to 'exit_node' and jumping to 'brk_pos' goes to
+   'brk_node'. Return the entry node or -1 if not possible. */
+static int re_nfa_build(RENFABuildState *b, int start, int end,
+                        int exit_node, int brk_pos, int brk_node)
+{
+    const uint8_t *bc_buf = b->bc_buf;
+    int *map, pos, next, opcode, idx, out, target, ret, e, n, i;
+    uint32_t count, quant_min, quant_max;
+
+    if (start >= end)
+        return exit_node;
+    map = lre_realloc(b->opaque, NULL, sizeof(map[0]) * (end - start));
+    if (!map)
+        return -1;
+    ret = -1;
+    /* allocate one node per opcode */
+    for(pos = start; pos < end; pos = next) {
+        next = re_nfa_op_end(b, pos);
+        if (next < 0 || next > end)
+            goto done;
+        idx = re_nfa_new_node(b);
+        if (idx < 0)
+            goto done;
+        map[pos - start] = idx;
+        for(i = pos + 1; i < next; i++)
+            map[i - start] = -1;
+    }
+
+#define RESOLVE(pos1) ((pos1) >= start && (pos1) < end ? map[(pos1) - start] : \
+                       (pos1) == end ? exit_node :                      \
+                       (pos1) == brk_pos ? brk_node : -1)
+
+    for(pos = start; pos < end; pos = next) {
+        next = re_nfa_op_end(b, pos);
+        idx = map[pos - start];
+        opcode = bc_buf[pos];
+        out = RESOLVE(next);
+        switch(opcode) {
+        case REOP_char:
+        case REOP_char_i:
+        case REOP_char32:
+        case REOP_char32_i:
+        case REOP_dot:
+        case REOP_any:
+        case REOP_range:
+        case REOP_range_i:
+        case REOP_range32:
+        case REOP_range32_i:
+            b->nodes[idx].op = RE_NFA_CHAR;
+            b->nodes[idx].arg = pos;
+            break;
+        case REOP_line_start:
+        case REOP_line_start_m:
+        case REOP_line_end:
+        case REOP_line_end_m:
+        case REOP_word_boundary:
+        case REOP_word_boundary_i:
+        case REOP_not_word_boundary:
+        case REOP_not_word_boundary_i:
+            b->nodes[idx].op = RE_NFA_ASSERT;
+            b->nodes[idx].arg = pos;
+            break;
+        case REOP_goto:
+            target = next + (int)get_u32(bc_buf + pos + 1);
+            out = RESOLVE(target);
+            break;
+        case REOP_split_goto_first:
+        case REOP_split_next_first:
+            target = next + (int)get_u32(bc_buf + pos + 1);
+            e = RESOLVE(target);
+            if (e < 0)
+                goto done;
+            b->nodes[idx].op = RE_NFA_SPLIT;
+            if (opcode == REOP_split_goto_first) {
+                b->nodes[idx].arg = out;
+                out = e;
+            } else {
+                b->nodes[idx].arg = e;
+            }
+            break;
+        case REOP_save_start:
+        case REOP_save_end:
+            b->nodes[idx].op = RE_NFA_SAVE;
+            b->nodes[idx].a = bc_buf[pos + 1];
+            b->nodes[idx].b = opcode - REOP_save_start;
+            break;
+        case REOP_save_reset:
+            b->nodes[idx].op = RE_NFA_RESET;
+            b->nodes[idx].a = bc_buf[pos + 1];
+            b->nodes[idx].b = bc_buf[pos + 2];
+            break;
+        case REOP_push_char_pos:
+            b->nodes[idx].op = RE_NFA_PUSH_CHAR_POS;
+            b->nodes[idx].a = b->level[pos];
+            break;
+        case REOP_check_advance:
+            b->nodes[idx].op = RE_NFA_CHECK_ADVANCE;
+            b->nodes[idx].a = b->level[pos];
+            break;
+        case REOP_match:
+            b->nodes[idx].op = RE_NFA_MATCH;
+            out = 0;
+            break;
+        case REOP_push_i32:
+            /* unroll the loop */
+            count = get_u32(bc_buf + pos + 1);
+            if (out < 0 || count == 0 || count > RE_NFA_MAX_NODES)
+                goto done;
+            e = out;
+            for(i = 0; i < count; i++) {
+                e = re_nfa_build(b, pos + 5, next - 6, e, next - 1, out);
+                if (e < 0)
+                    goto done;
+            }
+            out = e;
+            break;
+        case REOP_simple_greedy_quant:
+            quant_min = get_u32(bc_buf + pos + 5);
+            quant_max = get_u32(bc_buf + pos + 9);
+            if (out < 0 || bc_buf[next - 1] != REOP_match ||
+                quant_min > RE_NFA_MAX_NODES ||
+                (quant_max != INT32_MAX && quant_max > RE_NFA_MAX_NODES))
+                goto done;
+            e = out;
+            if (quant_max == INT32_MAX) {
+                n = re_nfa_new_node(b);
+                if (n < 0)
+                    goto done;
+                e = re_nfa_build(b, pos + 17, next - 1, n, -1, -1);
+                if (e < 0)
+                    goto done;
+                b->nodes[n].op = RE_NFA_SPLIT;
+                b->nodes[n].out = e;
+                b->nodes[n].arg = out;
+                e = n;
+            } else {
+                for(i = quant_min; i < quant_max; i++) {
+                    n = re_nfa_new_node(b);
+                    if (n < 0)
+                        goto done;
+                    e = re_nfa_build(b, pos + 17, next - 1, e, -1, -1);
+                    if (e < 0)
+                        goto done;
+                    b->nodes[n].op = RE_NFA_SPLIT;
+                    b->nodes[n].out = e;
+                    b->nodes[n].arg = out;
+                    e = n;
+                }
+            }
+            for(i = 0; i < quant_min; i++) {
+                e = re_nfa_build(b, pos + 17, next - 1, e, -1, -1);
+                if (e < 0)
+                    goto done;
+            }
+            out = e;
+            break;
+        default:
+            /* back references, lookarounds */
+            goto done;
+        }
+        if (out < 0)
+            goto done;
+        if (opcode != REOP_match)
+            b->nodes[idx].out = out;
+    }
+#undef RESOLVE
+    ret = map[0];
+ done:
+    lre_realloc(b->opaque, map, 0);
+    return ret;
+}
+
+/* Append the NFA to the bytecode if the regexp can be executed by the
+   linear time engine. */
+static int re_compute_nfa(REParseState *s)
+{
+    RENFABuildState b_s, *b = &b_s;
+    int start, i, pos, len, opcode, depth;
+    size_t nfa_pos;
+
+    b->bc_buf = s->byte_code.buf + RE_HEADER_LEN;
+    b->bc_len = get_u32(s->byte_code.buf + RE_HEADER_BYTECODE_LEN);
+    b->nodes = NULL;
+    b->node_count = 0;
+    b->node_size = 0;
+    b->opaque = s->opaque;
+    b->level = lre_realloc(s->opaque, NULL, b->bc_len);
+    if (!b->level)
+        return -1;
+    /* push_char_pos and check_advance are nested as parentheses */
+    depth = 0;
+    for(pos = 0; pos < b->bc_len; pos += len) {
+        opcode = b->bc_buf[pos];
+        len = reopcode_info[opcode].size;
+        switch(opcode) {
+        case REOP_range:
+        case REOP_range_i:
+            len += get_u16(b->bc_buf + pos + 1) * 4;
+            break;
+        case REOP_range32:
+        case REOP_range32_i:
+            len += get_u16(b->bc_buf + pos + 1) * 8;
+            break;
+        case REOP_push_char_pos:
+            if (depth >= RE_NFA_MAX_LEVELS)
+                goto done;
+            b->level[pos] = depth++;
+            break;
+        case REOP_check_advance:
+            b->level[pos] = --depth;
+            break;
+        }
+    }
+    start = re_nfa_build(b, 0, b->bc_len, -1, -1, -1);
+    if (start < 0)
+        goto done;
+
+    nfa_pos = s->byte_code.size;
+    dbuf_put_u32(&s->byte_code, start);
+    for(i = 0; i < b->node_count; i++) {
+        RENFANode *n = &b->nodes[i];
+        dbuf_putc(&s->byte_code, n->op);
+        dbuf_putc(&s->byte_code, n->a);
+        dbuf_putc(&s->byte_code, n->b);
+        dbuf_putc(&s->byte_code, 0);
+        dbuf_put_u32(&s->byte_code, n->out);
+        dbuf_put_u32(&s->byte_code, n->arg);
+    }
+    if (dbuf_error(&s->byte_code)) {
+        lre_realloc(s->opaque, b->nodes, 0);
+        lre_realloc(s->opaque, b->level, 0);
+        return -1;
+    }
+    put_u32(s->byte_code.buf + RE_HEADER_NFA_LEN, s->byte_code.size - nfa_pos);
+ done:
+    lre_realloc(s->opaque, b->nodes, 0);
+    lre_realloc(s->opaque, b->level, 0);
+    return 0;
+}
+
 /* 'buf' must be a zero terminated UTF-8 string of length buf_len.
    Return NULL if error and allocate an error message in *perror_msg,
    otherwise the compiled bytecode and its length in plen.
@@ -2479,6 +3114,8 @@ uint8_t *lre_compile(int *plen, char *error_msg, int error_msg_size,
     dbuf_putc(&s->byte_code, 0); /* second element is the number of captures */
     dbuf_putc(&s->byte_code, 0); /* stack size */
     dbuf_put_u32(&s->byte_code, 0); /* bytecode length */
+    dbuf_put_u16(&s->byte_code, 0); /* prefilter length */
+    dbuf_put_u32(&s->byte_code, 0); /* NFA length */
 
     if (!is_sticky) {
         /* iterate thru all positions (about the same as .*?( ... ) )
@@ -2525,6 +3162,11 @@ uint8_t *lre_compile(int *plen, char *error_msg, int error_msg_size,
     put_u32(s->byte_code.buf + RE_HEADER_BYTECODE_LEN,
             s->byte_code.size - RE_HEADER_LEN);
 
+    if (re_compute_prefilter(s, !is_sticky) || re_compute_nfa(s)) {
+        re_parse_out_of_memory(s);
+        goto error;
+    }
+
     /* add the named groups if needed */
     if (s->group_names.size > (s->capture_count - 1)) {
         dbuf_put(&s->byte_code, s->group_names.buf, s->group_names.size);
@@ -2666,6 +3308,13 @@ typedef struct {
     BOOL is_unicode;
     int interrupt_counter;
     void *opaque; /* used for stack overflow check */
+    /* if not NULL, switch to the NFA when nfa_fallback_counter
+       reaches zero */
+    const uint8_t *nfa;
+    int nfa_fallback_counter;
+    /* if not NULL, native code used for the 8 bit strings */
+    const struct LREJitCode *jit;
+    const uint8_t *bc_start;
 
     size_t state_size;
     uint8_t *state_stack;
@@ -2711,13 +3360,21 @@ static int push_state(REExecContext *s,
     return 0;
 }
 
-static int lre_poll_timeout(REExecContext *s)
+/* return LRE_RET_TIMEOUT, LRE_RET_NFA_FALLBACK or 0 */
+static no_inline int lre_poll_timeout_slow(REExecContext *s)
 {
-    if (unlikely(--s->interrupt_counter <= 0)) {
-        s->interrupt_counter = INTERRUPT_COUNTER_INIT;
-        if (lre_check_timeout(s->opaque))
-            return LRE_RET_TIMEOUT;
-    }
+    s->interrupt_counter = INTERRUPT_COUNTER_INIT;
+    if (lre_check_timeout(s->opaque))
+        return LRE_RET_TIMEOUT;
+    if (s->nfa && --s->nfa_fallback_counter <= 0)
+        return LRE_RET_NFA_FALLBACK;
+    return 0;
+}
+
+static inline int lre_poll_timeout(REExecContext *s)
+{
+    if (unlikely(--s->interrupt_counter <= 0))
+        return lre_poll_timeout_slow(s);
     return 0;
 }
 
@@ -2742,6 +3399,7 @@ static intptr_t lre_exec_backtrack(REExecContext *s, uint8_t **capture,
         case REOP_match:
             {
                 REExecState *rs;
+                int poll_ret;
                 if (no_recurse)
                     return (intptr_t)cptr;
                 ret = 1;
@@ -2752,8 +3410,8 @@ static intptr_t lre_exec_backtrack(REExecContext *s, uint8_t **capture,
                 ret = 0;
             recurse:
                 for(;;) {
-                    if (lre_poll_timeout(s))
-                        return LRE_RET_TIMEOUT;
+                    if ((poll_ret = lre_poll_timeout(s)) != 0)
+                        return poll_ret;
                     if (s->state_stack_len == 0)
                         return ret;
                     rs = (REExecState *)(s->state_stack +
@@ -2863,8 +3521,9 @@ static intptr_t lre_exec_backtrack(REExecContext *s, uint8_t **capture,
         case REOP_goto:
             val = get_u32(pc);
             pc += 4 + (int)val;
-            if (lre_poll_timeout(s))
-                return LRE_RET_TIMEOUT;
+            ret = lre_poll_timeout(s);
+            if (ret)
+                return ret;
             break;
         case REOP_line_start:
         case REOP_line_start_m:
@@ -2931,8 +3590,9 @@ static intptr_t lre_exec_backtrack(REExecContext *s, uint8_t **capture,
             pc += 4;
             if (--stack[stack_len - 1] != 0) {
                 pc += (int)val;
-                if (lre_poll_timeout(s))
-                    return LRE_RET_TIMEOUT;
+                ret = lre_poll_timeout(s);
+                if (ret)
+                    return ret;
             }
             break;
         case REOP_push_char_pos:
@@ -3120,12 +3780,12 @@ static intptr_t lre_exec_backtrack(REExecContext *s, uint8_t **capture,
 
                 q = 0;
                 for(;;) {
-                    if (lre_poll_timeout(s))
-                        return LRE_RET_TIMEOUT;
+                    ret = lre_poll_timeout(s);
+                    if (ret)
+                        return ret;
                     res = lre_exec_backtrack(s, capture, stack, stack_len,
                                              pc1, cptr, TRUE);
-                    if (res == LRE_RET_MEMORY_ERROR ||
-                        res == LRE_RET_TIMEOUT)
+                    if (res < 0)
                         return res;
                     if (!res)
                         break;
@@ -3153,40 +3813,1482 @@ static intptr_t lre_exec_backtrack(REExecContext *s, uint8_t **capture,
     }
 }
 
-/* Return 1 if match, 0 if not match or < 0 if error (see LRE_RET_x). cindex is the
-   starting position of the match and must be such as 0 <= cindex <=
-   clen. */
-int lre_exec(uint8_t **capture,
-             const uint8_t *bc_buf, const uint8_t *cbuf, int cindex, int clen,
-             int cbuf_type, void *opaque)
-{
-    REExecContext s_s, *s = &s_s;
-    int re_flags, i, alloca_size, ret;
-    StackInt *stack_buf;
-    const uint8_t *cptr;
+#ifdef CONFIG_REGEXP_JIT
+#ifdef RE_JIT
 
-    re_flags = lre_get_flags(bc_buf);
-    s->is_unicode = (re_flags & (LRE_FLAG_UNICODE | LRE_FLAG_UNICODE_SETS)) != 0;
-    s->capture_count = bc_buf[RE_HEADER_CAPTURE_COUNT];
-    s->stack_size_max = bc_buf[RE_HEADER_STACK_SIZE];
-    s->cbuf = cbuf;
-    s->cbuf_end = cbuf + (clen << cbuf_type);
-    s->cbuf_type = cbuf_type;
-    if (s->cbuf_type == 1 && s->is_unicode)
-        s->cbuf_type = 2;
-    s->interrupt_counter = INTERRUPT_COUNTER_INIT;
-    s->opaque = opaque;
+/* x86-64 JIT: the bytecode is translated to native code executing the
+   backtracking algorithm. It only handles the 8 bit strings and the
+   regexps without lookarounds, back references and counted loops.
+   Instead of copying the captures at each split, the modified
+   captures are saved in an undo log stored in the backtracking stack.
 
-    s->state_size = sizeof(REExecState) +
-        s->capture_count * sizeof(capture[0]) * 2 +
-        s->stack_size_max * sizeof(stack_buf[0]);
-    s->state_stack = NULL;
-    s->state_stack_len = 0;
-    s->state_stack_size = 0;
+   backtracking stack entry (3 words):
+   split: native resume address, cptr, aux value
+   undo:  0, capture pointer, saved value
+*/
 
-    for(i = 0; i < s->capture_count * 2; i++)
-        capture[i] = NULL;
-    alloca_size = s->stack_size_max * sizeof(stack_buf[0]);
+enum {
+    RE_JIT_RAX, RE_JIT_RCX, RE_JIT_RDX, RE_JIT_RBX,
+    RE_JIT_RSP, RE_JIT_RBP, RE_JIT_RSI, RE_JIT_RDI,
+    RE_JIT_R8, RE_JIT_R9, RE_JIT_R10, RE_JIT_R11,
+    RE_JIT_R12, RE_JIT_R13, RE_JIT_R14, RE_JIT_R15,
+};
+
+#define RE_JIT_CPTR     RE_JIT_RBX
+#define RE_JIT_CBUF     RE_JIT_RBP
+#define RE_JIT_BT_SP    RE_JIT_R12
+#define RE_JIT_BT_END   RE_JIT_R13
+#define RE_JIT_STATE    RE_JIT_R14
+#define RE_JIT_CAPTURE  RE_JIT_R15
+/* simple greedy quantifier: count, iteration start, aux value, start */
+#define RE_JIT_COUNT    RE_JIT_R8
+#define RE_JIT_ITER     RE_JIT_R9
+#define RE_JIT_AUX      RE_JIT_R10
+#define RE_JIT_QSTART   RE_JIT_R11
+
+enum {
+    RE_JIT_CC_B = 0x2,
+    RE_JIT_CC_AE = 0x3,
+    RE_JIT_CC_E = 0x4,
+    RE_JIT_CC_NE = 0x5,
+    RE_JIT_CC_BE = 0x6,
+    RE_JIT_CC_LE = 0xe,
+    RE_JIT_CC_G = 0xf,
+};
+
+#define RE_JIT_CC_JMP (-1)
+#define RE_JIT_CC_CALL (-2)
+#define RE_JIT_CC_LEA (-3) /* lea rax, [rip + label] */
+
+#define RE_JIT_BT_ENTRY_SIZE (3 * sizeof(uintptr_t))
+#define RE_JIT_BT_STACK_INIT 256 /* entries */
+
+typedef struct {
+    REExecContext *s;
+    uint8_t **capture;
+    const uint8_t *cbuf;
+    const uint8_t *cbuf_end;
+    uintptr_t *bt_stack;
+    uintptr_t *bt_stack_end;
+    BOOL bt_stack_allocated;
+} REJitState;
+
+struct LREJitCode {
+    size_t size; /* size of the mapping */
+    uint32_t entry[2]; /* bytecode start and regexp body */
+    uint8_t code[0];
+};
+
+typedef int REJitFunc(REJitState *js, const uint8_t *cptr,
+                           const uint8_t *entry);
+
+typedef struct {
+    uint32_t offset; /* position of the rel32 field */
+    int label;
+} REJitRef;
+
+typedef struct {
+    DynBuf code;
+    DynBuf tables; /* 256 byte tables (label, table) */
+    const uint8_t *bc_buf;
+    int bc_len;
+    BOOL is_unicode;
+    void *opaque;
+    int *labels; /* native offset or -1. The first labels are the
+                    bytecode positions */
+    int label_count;
+    int label_size;
+    REJitRef *refs;
+    int ref_count;
+    int ref_size;
+    int fail_label; /* backtrack */
+    int exit_label; /* restore the registers and return eax */
+    int grow_label; /* grow the backtracking stack */
+} REJitCompiler;
+
+static void re_jit_u8(REJitCompiler *s, int v)
+{
+    dbuf_putc(&s->code, v);
+}
+
+static void re_jit_u32(REJitCompiler *s, uint32_t v)
+{
+    dbuf_put_u32(&s->code, v);
+}
+
+static void re_jit_op_mem(REJitCompiler *s, int w, int op,
+                          int reg, int base, int32_t disp)
+{
+    int rex, mod;
+    rex = (w << 3) | ((reg & 8) >> 1) | ((base & 8) >> 3);
+    if (rex)
+        re_jit_u8(s, 0x40 | rex);
+    if (op > 0xff)
+        re_jit_u8(s, op >> 8);
+    re_jit_u8(s, op);
+    if (disp == 0 && (base & 7) != RE_JIT_RBP)
+        mod = 0;
+    else if (disp == (int8_t)disp)
+        mod = 1;
+    else
+        mod = 2;
+    re_jit_u8(s, (mod << 6) | ((reg & 7) << 3) | (base & 7));
+    if ((base & 7) == RE_JIT_RSP)
+        re_jit_u8(s, 0x24); /* SIB without index */
+    if (mod == 1)
+        re_jit_u8(s, disp);
+    else if (mod == 2)
+        re_jit_u32(s, disp);
+}
+
+static void re_jit_op_reg(REJitCompiler *s, int w, int op, int reg, int rm)
+{
+    int rex;
+    rex = (w << 3) | ((reg & 8) >> 1) | ((rm & 8) >> 3);
+    if (rex)
+        re_jit_u8(s, 0x40 | rex);
+    if (op > 0xff)
+        re_jit_u8(s, op >> 8);
+    re_jit_u8(s, op);
+    re_jit_u8(s, 0xc0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+static void re_jit_load(REJitCompiler *s, int reg, int base, int32_t disp)
+{
+    re_jit_op_mem(s, 1, 0x8b, reg, base, disp);
+}
+
+static void re_jit_store(REJitCompiler *s, int base, int32_t disp, int reg)
+{
+    re_jit_op_mem(s, 1, 0x89, reg, base, disp);
+}
+
+static void re_jit_mov_reg(REJitCompiler *s, int dst, int src)
+{
+    re_jit_op_reg(s, 1, 0x89, src, dst);
+}
+
+/* op reg, imm32 with op = 0 (add), 5 (sub) or 7 (cmp) */
+static void re_jit_alu_imm(REJitCompiler *s, int w, int op, int reg,
+                           int32_t val)
+{
+    if (val == (int8_t)val) {
+        re_jit_op_reg(s, w, 0x83, op, reg);
+        re_jit_u8(s, val);
+    } else {
+        re_jit_op_reg(s, w, 0x81, op, reg);
+        re_jit_u32(s, val);
+    }
+}
+
+static int re_jit_new_label(REJitCompiler *s)
+{
+    int *new_labels, new_size;
+    if (s->label_count >= s->label_size) {
+        new_size = max_int(16, s->label_size * 3 / 2);
+        new_labels = lre_realloc(s->opaque, s->labels,
+                                 sizeof(s->labels[0]) * new_size);
+        if (!new_labels)
+            return -1;
+        s->labels = new_labels;
+        s->label_size = new_size;
+    }
+    s->labels[s->label_count] = -1;
+    return s->label_count++;
+}
+
+static void re_jit_bind(REJitCompiler *s, int label)
+{
+    s->labels[label] = s->code.size;
+}
+
+/* jcc, jmp, call or lea rax with a label */
+static int re_jit_jcc(REJitCompiler *s, int cc, int label)
+{
+    REJitRef *ref;
+    int new_size;
+
+    if (label < 0)
+        return -1;
+    if (cc == RE_JIT_CC_JMP) {
+        re_jit_u8(s, 0xe9);
+    } else if (cc == RE_JIT_CC_CALL) {
+        re_jit_u8(s, 0xe8);
+    } else if (cc == RE_JIT_CC_LEA) {
+        re_jit_u8(s, 0x48);
+        re_jit_u8(s, 0x8d);
+        re_jit_u8(s, 0x05); /* rax, [rip + disp32] */
+    } else {
+        re_jit_u8(s, 0x0f);
+        re_jit_u8(s, 0x80 + cc);
+    }
+    re_jit_u32(s, 0);
+    if (s->ref_count >= s->ref_size) {
+        new_size = max_int(16, s->ref_size * 3 / 2);
+        ref = lre_realloc(s->opaque, s->refs, sizeof(s->refs[0]) * new_size);
+        if (!ref)
+            return -1;
+        s->refs = ref;
+        s->ref_size = new_size;
+    }
+    ref = &s->refs[s->ref_count++];
+    ref->offset = s->code.size - 4;
+    ref->label = label;
+    return 0;
+}
+
+static void re_jit_call(REJitCompiler *s, const void *func)
+{
+    re_jit_u8(s, 0x48); /* movabs rax, func */
+    re_jit_u8(s, 0xb8);
+    dbuf_put_u64(&s->code, (uintptr_t)func);
+    re_jit_u8(s, 0xff); /* call rax */
+    re_jit_u8(s, 0xd0);
+}
+
+/* return a label to a 256 byte table */
+static int re_jit_table(REJitCompiler *s, const uint8_t *tab)
+{
+    int label = re_jit_new_label(s);
+    if (label < 0)
+        return -1;
+    dbuf_put_u32(&s->tables, label);
+    dbuf_put(&s->tables, tab, 256);
+    return label;
+}
+
+/* cmp rbx, cbuf_end */
+static void re_jit_cmp_end(REJitCompiler *s)
+{
+    re_jit_op_mem(s, 1, 0x3b, RE_JIT_CPTR, RE_JIT_STATE,
+                  offsetof(REJitState, cbuf_end));
+}
+
+/* movzx eax, byte [rbx + disp] */
+static void re_jit_load_char(REJitCompiler *s, int reg, int32_t disp)
+{
+    re_jit_op_mem(s, 0, 0x0fb6, reg, RE_JIT_CPTR, disp);
+}
+
+/* size of the opcode at 'pc' including the simple quantifier body */
+static int re_jit_op_len(const uint8_t *pc)
+{
+    int len = reopcode_info[pc[0]].size;
+    switch(pc[0]) {
+    case REOP_range:
+    case REOP_range_i:
+        len += get_u16(pc + 1) * 4;
+        break;
+    case REOP_range32:
+    case REOP_range32_i:
+        len += get_u16(pc + 1) * 8;
+        break;
+    case REOP_simple_greedy_quant:
+        len += get_u32(pc + 1);
+        break;
+    }
+    return len;
+}
+
+/* push a backtracking entry. rax contains the first word */
+static int re_jit_push_entry(REJitCompiler *s, int reg1, int reg2)
+{
+    int label;
+    label = re_jit_new_label(s);
+    if (label < 0)
+        return -1;
+    re_jit_op_reg(s, 1, 0x39, RE_JIT_BT_END, RE_JIT_BT_SP); /* cmp r12, r13 */
+    if (re_jit_jcc(s, RE_JIT_CC_B, label))
+        return -1;
+    if (re_jit_jcc(s, RE_JIT_CC_CALL, s->grow_label))
+        return -1;
+    re_jit_bind(s, label);
+    re_jit_store(s, RE_JIT_BT_SP, 0, RE_JIT_RAX);
+    re_jit_store(s, RE_JIT_BT_SP, 8, reg1);
+    re_jit_store(s, RE_JIT_BT_SP, 16, reg2);
+    re_jit_alu_imm(s, 1, 0, RE_JIT_BT_SP, RE_JIT_BT_ENTRY_SIZE);
+    return 0;
+}
+
+/* push a split entry resuming at 'label' */
+static int re_jit_push_split(REJitCompiler *s, int label)
+{
+    if (re_jit_jcc(s, RE_JIT_CC_LEA, label))
+        return -1;
+    return re_jit_push_entry(s, RE_JIT_CPTR, RE_JIT_AUX);
+}
+
+/* save capture[idx] in the undo log */
+static int re_jit_push_undo(REJitCompiler *s, int idx)
+{
+    int32_t disp = idx * sizeof(uint8_t *);
+    re_jit_op_reg(s, 0, 0x31, RE_JIT_RAX, RE_JIT_RAX); /* xor eax, eax */
+    re_jit_op_mem(s, 1, 0x8d, RE_JIT_RCX, RE_JIT_CAPTURE, disp); /* lea */
+    re_jit_load(s, RE_JIT_RDX, RE_JIT_CAPTURE, disp);
+    return re_jit_push_entry(s, RE_JIT_RCX, RE_JIT_RDX);
+}
+
+/* poll the timeout. rax is preserved. */
+static int re_jit_poll(REJitCompiler *s)
+{
+    int label_done;
+
+    label_done = re_jit_new_label(s);
+    if (label_done < 0)
+        return -1;
+    re_jit_load(s, RE_JIT_RDI, RE_JIT_STATE, offsetof(REJitState, s));
+    /* sub dword [rdi + interrupt_counter], 1 */
+    re_jit_op_mem(s, 0, 0x83, 5, RE_JIT_RDI,
+                  offsetof(REExecContext, interrupt_counter));
+    re_jit_u8(s, 1);
+    if (re_jit_jcc(s, RE_JIT_CC_G, label_done))
+        return -1;
+    re_jit_u8(s, 0x50); /* push rax */
+    re_jit_alu_imm(s, 1, 5, RE_JIT_RSP, 8); /* keep rsp aligned */
+    re_jit_call(s, lre_poll_timeout_slow);
+    re_jit_alu_imm(s, 1, 0, RE_JIT_RSP, 8);
+    re_jit_u8(s, 0x59); /* pop rcx */
+    re_jit_op_reg(s, 0, 0x85, RE_JIT_RAX, RE_JIT_RAX); /* test eax, eax */
+    if (re_jit_jcc(s, RE_JIT_CC_NE, s->exit_label))
+        return -1;
+    re_jit_mov_reg(s, RE_JIT_RAX, RE_JIT_RCX);
+    re_jit_bind(s, label_done);
+    return 0;
+}
+
+/* compute the table of the 8 bit chars matched by the opcode at 'pc'
+   (char, dot or range). Return the number of matched chars. */
+static int re_jit_char_table(REJitCompiler *s, const uint8_t *pc, uint8_t *tab)
+{
+    int opcode, n, i, count;
+    uint32_t c, val, low, high;
+    BOOL ignore_case;
+
+    memset(tab, 0, 256);
+    opcode = pc[0];
+    ignore_case = (opcode == REOP_char_i || opcode == REOP_char32_i ||
+                   opcode == REOP_range_i || opcode == REOP_range32_i);
+    switch(opcode) {
+    case REOP_char:
+    case REOP_char_i:
+    case REOP_char32:
+    case REOP_char32_i:
+        if (opcode == REOP_char || opcode == REOP_char_i)
+            val = get_u16(pc + 1);
+        else
+            val = get_u32(pc + 1);
+        for(c = 0; c < 256; c++) {
+            if ((ignore_case ? lre_canonicalize(c, s->is_unicode) : c) == val)
+                tab[c] = 1;
+        }
+        break;
+    case REOP_dot:
+        for(c = 0; c < 256; c++)
+            tab[c] = !is_line_terminator(c);
+        break;
+    case REOP_any:
+        memset(tab, 1, 256);
+        break;
+    case REOP_range:
+    case REOP_range_i:
+    case REOP_range32:
+    case REOP_range32_i:
+        n = get_u16(pc + 1);
+        for(c = 0; c < 256; c++) {
+            val = ignore_case ? lre_canonicalize(c, s->is_unicode) : c;
+            for(i = 0; i < n; i++) {
+                if (opcode == REOP_range || opcode == REOP_range_i) {
+                    low = get_u16(pc + 3 + i * 4);
+                    high = get_u16(pc + 3 + i * 4 + 2);
+                } else {
+                    low = get_u32(pc + 3 + i * 8);
+                    high = get_u32(pc + 3 + i * 8 + 4);
+                }
+                if (val >= low && val <= high) {
+                    tab[c] = 1;
+                    break;
+                }
+            }
+        }
+        break;
+    default:
+        abort();
+    }
+    count = 0;
+    for(c = 0; c < 256; c++)
+        count += tab[c];
+    return count;
+}
+
+/* emit the code of a single char or assertion opcode. Jump to
+   'fail_label' if no match. */
+static int re_jit_emit_char(REJitCompiler *s, int pos, int fail_label)
+{
+    const uint8_t *pc = s->bc_buf + pos;
+    uint8_t tab[256];
+    int opcode, count, c, label, tab_label;
+
+    opcode = pc[0];
+    switch(opcode) {
+    case REOP_char:
+    case REOP_char_i:
+    case REOP_char32:
+    case REOP_char32_i:
+    case REOP_dot:
+    case REOP_any:
+    case REOP_range:
+    case REOP_range_i:
+    case REOP_range32:
+    case REOP_range32_i:
+        count = re_jit_char_table(s, pc, tab);
+        if (count == 0)
+            return re_jit_jcc(s, RE_JIT_CC_JMP, fail_label);
+        re_jit_cmp_end(s);
+        if (re_jit_jcc(s, RE_JIT_CC_AE, fail_label))
+            return -1;
+        if (count == 1) {
+            for(c = 0; c < 256; c++) {
+                if (tab[c])
+                    break;
+            }
+            /* cmp byte [rbx], c */
+            re_jit_op_mem(s, 0, 0x80, 7, RE_JIT_CPTR, 0);
+            re_jit_u8(s, c);
+            if (re_jit_jcc(s, RE_JIT_CC_NE, fail_label))
+                return -1;
+        } else if (count < 256) {
+            tab_label = re_jit_table(s, tab);
+            if (tab_label < 0)
+                return -1;
+            re_jit_load_char(s, RE_JIT_RCX, 0);
+            if (re_jit_jcc(s, RE_JIT_CC_LEA, tab_label))
+                return -1;
+            /* cmp byte [rax + rcx], 0 */
+            re_jit_u8(s, 0x80);
+            re_jit_u8(s, 0x3c);
+            re_jit_u8(s, 0x08);
+            re_jit_u8(s, 0x00);
+            if (re_jit_jcc(s, RE_JIT_CC_E, fail_label))
+                return -1;
+        }
+        re_jit_alu_imm(s, 1, 0, RE_JIT_CPTR, 1);
+        break;
+    case REOP_line_start:
+    case REOP_line_start_m:
+    case REOP_line_end:
+    case REOP_line_end_m:
+        label = re_jit_new_label(s);
+        if (label < 0)
+            return -1;
+        if (opcode == REOP_line_start || opcode == REOP_line_start_m)
+            re_jit_op_reg(s, 1, 0x39, RE_JIT_CBUF, RE_JIT_CPTR); /* cmp rbx, rbp */
+        else
+            re_jit_cmp_end(s);
+        if (re_jit_jcc(s, RE_JIT_CC_E, label))
+            return -1;
+        if (opcode == REOP_line_start || opcode == REOP_line_end) {
+            if (re_jit_jcc(s, RE_JIT_CC_JMP, fail_label))
+                return -1;
+        } else {
+            re_jit_load_char(s, RE_JIT_RAX, opcode == REOP_line_start_m ? -1 : 0);
+            re_jit_alu_imm(s, 0, 7, RE_JIT_RAX, '\n');
+            if (re_jit_jcc(s, RE_JIT_CC_E, label))
+                return -1;
+            re_jit_alu_imm(s, 0, 7, RE_JIT_RAX, '\r');
+            if (re_jit_jcc(s, RE_JIT_CC_NE, fail_label))
+                return -1;
+        }
+        re_jit_bind(s, label);
+        break;
+    case REOP_word_boundary:
+    case REOP_word_boundary_i:
+    case REOP_not_word_boundary:
+    case REOP_not_word_boundary_i:
+        {
+            BOOL ignore_case = (opcode == REOP_word_boundary_i ||
+                                opcode == REOP_not_word_boundary_i);
+            int label1;
+            for(c = 0; c < 256; c++) {
+                tab[c] = is_word_char(ignore_case ?
+                                      lre_canonicalize(c, s->is_unicode) : c);
+            }
+            tab_label = re_jit_table(s, tab);
+            label = re_jit_new_label(s);
+            label1 = re_jit_new_label(s);
+            if (tab_label < 0 || label < 0 || label1 < 0)
+                return -1;
+            if (re_jit_jcc(s, RE_JIT_CC_LEA, tab_label))
+                return -1;
+            re_jit_op_reg(s, 0, 0x31, RE_JIT_RCX, RE_JIT_RCX); /* xor ecx, ecx */
+            re_jit_op_reg(s, 0, 0x31, RE_JIT_RDX, RE_JIT_RDX); /* xor edx, edx */
+            /* char before */
+            re_jit_op_reg(s, 1, 0x39, RE_JIT_CBUF, RE_JIT_CPTR);
+            if (re_jit_jcc(s, RE_JIT_CC_E, label))
+                return -1;
+            re_jit_load_char(s, RE_JIT_RSI, -1);
+            re_jit_u8(s, 0x0f); /* movzx ecx, byte [rax + rsi] */
+            re_jit_u8(s, 0xb6);
+            re_jit_u8(s, 0x0c);
+            re_jit_u8(s, 0x30);
+            re_jit_bind(s, label);
+            /* current char */
+            re_jit_cmp_end(s);
+            if (re_jit_jcc(s, RE_JIT_CC_AE, label1))
+                return -1;
+            re_jit_load_char(s, RE_JIT_RSI, 0);
+            re_jit_u8(s, 0x0f); /* movzx edx, byte [rax + rsi] */
+            re_jit_u8(s, 0xb6);
+            re_jit_u8(s, 0x14);
+            re_jit_u8(s, 0x30);
+            re_jit_bind(s, label1);
+            re_jit_op_reg(s, 0, 0x31, RE_JIT_RDX, RE_JIT_RCX); /* xor ecx, edx */
+            if (re_jit_jcc(s, (opcode == REOP_word_boundary ||
+                               opcode == REOP_word_boundary_i) ?
+                           RE_JIT_CC_E : RE_JIT_CC_NE, fail_label))
+                return -1;
+        }
+        break;
+    default:
+        return -1;
+    }
+    return 0;
+}
+
+static int re_jit_emit_quant(REJitCompiler *s, int pos)
+{
+    const uint8_t *bc_buf = s->bc_buf;
+    uint32_t next_pos, quant_min, quant_max, char_count;
+    int label_loop, label_body_fail, label_done, label_backoff, label_cont;
+    int pos1, end;
+    int64_t min_len;
+
+    next_pos = get_u32(bc_buf + pos + 1);
+    quant_min = get_u32(bc_buf + pos + 5);
+    quant_max = get_u32(bc_buf + pos + 9);
+    char_count = get_u32(bc_buf + pos + 13);
+    end = pos + 17 + next_pos - 1; /* final REOP_match */
+    min_len = (int64_t)quant_min * char_count;
+    if (min_len > INT32_MAX)
+        return re_jit_jcc(s, RE_JIT_CC_JMP, s->fail_label);
+
+    label_loop = re_jit_new_label(s);
+    label_body_fail = re_jit_new_label(s);
+    label_done = re_jit_new_label(s);
+    label_backoff = re_jit_new_label(s);
+    label_cont = re_jit_new_label(s);
+    if (label_cont < 0)
+        return -1;
+
+    re_jit_op_reg(s, 0, 0x31, RE_JIT_COUNT, RE_JIT_COUNT); /* xor r8d, r8d */
+    re_jit_mov_reg(s, RE_JIT_QSTART, RE_JIT_CPTR);
+    re_jit_bind(s, label_loop);
+    if (quant_max != INT32_MAX) {
+        re_jit_alu_imm(s, 1, 7, RE_JIT_COUNT, quant_max);
+        if (re_jit_jcc(s, RE_JIT_CC_AE, label_done))
+            return -1;
+    }
+    re_jit_mov_reg(s, RE_JIT_ITER, RE_JIT_CPTR);
+    for(pos1 = pos + 17; pos1 < end; pos1 += re_jit_op_len(bc_buf + pos1)) {
+        if (re_jit_emit_char(s, pos1, label_body_fail))
+            return -1;
+    }
+    re_jit_alu_imm(s, 1, 0, RE_JIT_COUNT, 1);
+    if (re_jit_jcc(s, RE_JIT_CC_JMP, label_loop))
+        return -1;
+    re_jit_bind(s, label_body_fail);
+    re_jit_mov_reg(s, RE_JIT_CPTR, RE_JIT_ITER);
+    re_jit_bind(s, label_done);
+    re_jit_alu_imm(s, 1, 7, RE_JIT_COUNT, quant_min);
+    if (re_jit_jcc(s, RE_JIT_CC_B, s->fail_label))
+        return -1;
+    if (re_jit_jcc(s, RE_JIT_CC_E, label_cont))
+        return -1;
+    /* aux = minimum position */
+    re_jit_mov_reg(s, RE_JIT_AUX, RE_JIT_QSTART);
+    re_jit_alu_imm(s, 1, 0, RE_JIT_AUX, min_len);
+    if (re_jit_push_split(s, label_backoff))
+        return -1;
+    if (re_jit_jcc(s, RE_JIT_CC_JMP, label_cont))
+        return -1;
+
+    /* backtracking: try with one less iteration */
+    re_jit_bind(s, label_backoff);
+    re_jit_alu_imm(s, 1, 5, RE_JIT_CPTR, char_count);
+    re_jit_op_reg(s, 1, 0x39, RE_JIT_AUX, RE_JIT_CPTR); /* cmp rbx, r10 */
+    if (re_jit_jcc(s, RE_JIT_CC_BE, label_cont))
+        return -1;
+    if (re_jit_push_split(s, label_backoff))
+        return -1;
+    re_jit_bind(s, label_cont);
+    return 0;
+}
+
+static int re_jit_emit_op(REJitCompiler *s, int pos, int next)
+{
+    const uint8_t *bc_buf = s->bc_buf;
+    int opcode, target, i, a, b;
+
+    opcode = bc_buf[pos];
+    switch(opcode) {
+    case REOP_goto:
+        target = next + (int)get_u32(bc_buf + pos + 1);
+        if (target <= pos && re_jit_poll(s))
+            return -1;
+        return re_jit_jcc(s, RE_JIT_CC_JMP, target);
+    case REOP_split_goto_first:
+    case REOP_split_next_first:
+        target = next + (int)get_u32(bc_buf + pos + 1);
+        if (opcode == REOP_split_goto_first) {
+            if (re_jit_push_split(s, next))
+                return -1;
+            return re_jit_jcc(s, RE_JIT_CC_JMP, target);
+        } else {
+            return re_jit_push_split(s, target);
+        }
+    case REOP_match:
+        re_jit_u8(s, 0xb8); /* mov eax, 1 */
+        re_jit_u32(s, 1);
+        return re_jit_jcc(s, RE_JIT_CC_JMP, s->exit_label);
+    case REOP_save_start:
+    case REOP_save_end:
+        i = 2 * bc_buf[pos + 1] + opcode - REOP_save_start;
+        if (re_jit_push_undo(s, i))
+            return -1;
+        re_jit_store(s, RE_JIT_CAPTURE, i * sizeof(uint8_t *), RE_JIT_CPTR);
+        break;
+    case REOP_save_reset:
+        a = bc_buf[pos + 1];
+        b = bc_buf[pos + 2];
+        for(i = 2 * a; i < 2 * b + 2; i++) {
+            if (re_jit_push_undo(s, i))
+                return -1;
+            /* mov qword [r15 + i * 8], 0 */
+            re_jit_op_mem(s, 1, 0xc7, 0, RE_JIT_CAPTURE, i * sizeof(uint8_t *));
+            re_jit_u32(s, 0);
+        }
+        break;
+    case REOP_simple_greedy_quant:
+        return re_jit_emit_quant(s, pos);
+    default:
+        return re_jit_emit_char(s, pos, s->fail_label);
+    }
+    return 0;
+}
+
+static void re_jit_prologue(REJitCompiler *s)
+{
+    static const uint8_t push_regs[] = {
+        0x55, /* push rbp */
+        0x53, /* push rbx */
+        0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57, /* push r12-r15 */
+        0x48, 0x83, 0xec, 0x08, /* sub rsp, 8: align the stack */
+    };
+    static const uint8_t pop_regs[] = {
+        0x48, 0x83, 0xc4, 0x08, /* add rsp, 8 */
+        0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, /* pop r15-r12 */
+        0x5b, /* pop rbx */
+        0x5d, /* pop rbp */
+        0xc3, /* ret */
+    };
+    dbuf_put(&s->code, push_regs, sizeof(push_regs));
+    re_jit_mov_reg(s, RE_JIT_STATE, RE_JIT_RDI);
+    re_jit_mov_reg(s, RE_JIT_CPTR, RE_JIT_RSI);
+    re_jit_load(s, RE_JIT_CAPTURE, RE_JIT_STATE, offsetof(REJitState, capture));
+    re_jit_load(s, RE_JIT_CBUF, RE_JIT_STATE, offsetof(REJitState, cbuf));
+    re_jit_load(s, RE_JIT_BT_SP, RE_JIT_STATE, offsetof(REJitState, bt_stack));
+    re_jit_load(s, RE_JIT_BT_END, RE_JIT_STATE, offsetof(REJitState, bt_stack_end));
+    re_jit_u8(s, 0xff); /* jmp rdx */
+    re_jit_u8(s, 0xe2);
+
+    re_jit_bind(s, s->exit_label);
+    dbuf_put(&s->code, pop_regs, sizeof(pop_regs));
+}
+
+/* grow the backtracking stack. Return the new stack pointer or NULL
+   if not enough memory. */
+static uintptr_t *lre_jit_grow_stack(REJitState *js, uintptr_t *sp)
+{
+    size_t size, new_size;
+    uintptr_t *new_stack;
+
+    size = js->bt_stack_end - js->bt_stack;
+    new_size = size * 2;
+    if (js->bt_stack_allocated) {
+        new_stack = lre_realloc(js->s->opaque, js->bt_stack,
+                                new_size * sizeof(uintptr_t));
+        if (!new_stack)
+            return NULL;
+    } else {
+        new_stack = lre_realloc(js->s->opaque, NULL,
+                                new_size * sizeof(uintptr_t));
+        if (!new_stack)
+            return NULL;
+        memcpy(new_stack, js->bt_stack, size * sizeof(uintptr_t));
+        js->bt_stack_allocated = TRUE;
+    }
+    sp = new_stack + (sp - js->bt_stack);
+    js->bt_stack = new_stack;
+    js->bt_stack_end = new_stack + new_size;
+    return sp;
+}
+
+/* backtracking and stack growing */
+static int re_jit_emit_runtime(REJitCompiler *s)
+{
+    int label_no_match, label_undo, label_mem;
+
+    label_no_match = re_jit_new_label(s);
+    label_undo = re_jit_new_label(s);
+    label_mem = re_jit_new_label(s);
+    if (label_mem < 0)
+        return -1;
+
+    re_jit_bind(s, s->fail_label);
+    /* cmp r12, [r14 + bt_stack] */
+    re_jit_op_mem(s, 1, 0x3b, RE_JIT_BT_SP, RE_JIT_STATE,
+                  offsetof(REJitState, bt_stack));
+    if (re_jit_jcc(s, RE_JIT_CC_E, label_no_match))
+        return -1;
+    re_jit_alu_imm(s, 1, 5, RE_JIT_BT_SP, RE_JIT_BT_ENTRY_SIZE);
+    re_jit_load(s, RE_JIT_RAX, RE_JIT_BT_SP, 0);
+    re_jit_op_reg(s, 1, 0x85, RE_JIT_RAX, RE_JIT_RAX); /* test rax, rax */
+    if (re_jit_jcc(s, RE_JIT_CC_E, label_undo))
+        return -1;
+    if (re_jit_poll(s))
+        return -1;
+    re_jit_load(s, RE_JIT_CPTR, RE_JIT_BT_SP, 8);
+    re_jit_load(s, RE_JIT_AUX, RE_JIT_BT_SP, 16);
+    re_jit_u8(s, 0xff); /* jmp rax */
+    re_jit_u8(s, 0xe0);
+
+    re_jit_bind(s, label_undo);
+    re_jit_load(s, RE_JIT_RCX, RE_JIT_BT_SP, 8);
+    re_jit_load(s, RE_JIT_RDX, RE_JIT_BT_SP, 16);
+    re_jit_store(s, RE_JIT_RCX, 0, RE_JIT_RDX);
+    if (re_jit_jcc(s, RE_JIT_CC_JMP, s->fail_label))
+        return -1;
+
+    re_jit_bind(s, label_no_match);
+    re_jit_op_reg(s, 0, 0x31, RE_JIT_RAX, RE_JIT_RAX); /* xor eax, eax */
+    if (re_jit_jcc(s, RE_JIT_CC_JMP, s->exit_label))
+        return -1;
+
+    /* called with the return address on the stack */
+    re_jit_bind(s, s->grow_label);
+    re_jit_u8(s, 0x50); /* push rax */
+    re_jit_u8(s, 0x51); /* push rcx */
+    re_jit_u8(s, 0x52); /* push rdx */
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x50); /* push r8 */
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x51); /* push r9 */
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x52); /* push r10 */
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x53); /* push r11 */
+    re_jit_mov_reg(s, RE_JIT_RDI, RE_JIT_STATE);
+    re_jit_mov_reg(s, RE_JIT_RSI, RE_JIT_BT_SP);
+    re_jit_call(s, lre_jit_grow_stack);
+    re_jit_op_reg(s, 1, 0x85, RE_JIT_RAX, RE_JIT_RAX);
+    if (re_jit_jcc(s, RE_JIT_CC_E, label_mem))
+        return -1;
+    re_jit_mov_reg(s, RE_JIT_BT_SP, RE_JIT_RAX);
+    re_jit_load(s, RE_JIT_BT_END, RE_JIT_STATE, offsetof(REJitState, bt_stack_end));
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x5b); /* pop r11 */
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x5a); /* pop r10 */
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x59); /* pop r9 */
+    re_jit_u8(s, 0x41); re_jit_u8(s, 0x58); /* pop r8 */
+    re_jit_u8(s, 0x5a); /* pop rdx */
+    re_jit_u8(s, 0x59); /* pop rcx */
+    re_jit_u8(s, 0x58); /* pop rax */
+    re_jit_u8(s, 0xc3); /* ret */
+
+    re_jit_bind(s, label_mem);
+    /* saved registers and return address */
+    re_jit_alu_imm(s, 1, 0, RE_JIT_RSP, 8 * 8);
+    re_jit_u8(s, 0xb8); /* mov eax, LRE_RET_MEMORY_ERROR */
+    re_jit_u32(s, LRE_RET_MEMORY_ERROR);
+    return re_jit_jcc(s, RE_JIT_CC_JMP, s->exit_label);
+}
+
+/* return TRUE if the opcodes of the regexp are supported */
+static BOOL re_jit_is_supported(const uint8_t *bc_buf, int bc_len)
+{
+    int pos, opcode;
+    for(pos = 0; pos < bc_len; pos += re_jit_op_len(bc_buf + pos)) {
+        opcode = bc_buf[pos];
+        switch(opcode) {
+        case REOP_push_i32:
+        case REOP_drop:
+        case REOP_loop:
+        case REOP_push_char_pos:
+        case REOP_check_advance:
+        case REOP_lookahead:
+        case REOP_negative_lookahead:
+        case REOP_back_reference:
+        case REOP_back_reference_i:
+        case REOP_backward_back_reference:
+        case REOP_backward_back_reference_i:
+        case REOP_prev:
+            return FALSE;
+        default:
+            break;
+        }
+    }
+    return TRUE;
+}
+
+LREJitCode *lre_jit_compile(const uint8_t *bc_buf, void *opaque)
+{
+    REJitCompiler s_s, *s = &s_s;
+    LREJitCode *jit;
+    size_t size, page_size, tab_pos, code_size;
+    int pos, next, i, label;
+
+    jit = NULL;
+    memset(s, 0, sizeof(*s));
+    s->bc_buf = bc_buf + RE_HEADER_LEN;
+    s->bc_len = get_u32(bc_buf + RE_HEADER_BYTECODE_LEN);
+    s->is_unicode = (lre_get_flags(bc_buf) &
+                     (LRE_FLAG_UNICODE | LRE_FLAG_UNICODE_SETS)) != 0;
+    s->opaque = opaque;
+    dbuf_init2(&s->code, opaque, lre_realloc);
+    dbuf_init2(&s->tables, opaque, lre_realloc);
+    if (!re_jit_is_supported(s->bc_buf, s->bc_len))
+        goto done;
+    /* one label per bytecode position */
+    for(i = 0; i < s->bc_len; i++) {
+        if (re_jit_new_label(s) < 0)
+            goto done;
+    }
+    s->fail_label = re_jit_new_label(s);
+    s->exit_label = re_jit_new_label(s);
+    s->grow_label = re_jit_new_label(s);
+    if (s->grow_label < 0)
+        goto done;
+
+    re_jit_prologue(s);
+    if (re_jit_emit_runtime(s))
+        goto done;
+    for(pos = 0; pos < s->bc_len; pos = next) {
+        next = pos + re_jit_op_len(s->bc_buf + pos);
+        re_jit_bind(s, pos);
+        if (re_jit_emit_op(s, pos, next))
+            goto done;
+    }
+    /* the tables are aligned after the code */
+    while (s->code.size & 15)
+        re_jit_u8(s, 0xcc);
+    for(tab_pos = 0; tab_pos < s->tables.size; tab_pos += 4 + 256) {
+        label = get_u32(s->tables.buf + tab_pos);
+        re_jit_bind(s, label);
+        dbuf_put(&s->code, s->tables.buf + tab_pos + 4, 256);
+    }
+    if (dbuf_error(&s->code) || dbuf_error(&s->tables))
+        goto done;
+    for(i = 0; i < s->ref_count; i++) {
+        REJitRef *ref = &s->refs[i];
+        if (s->labels[ref->label] < 0)
+            goto done;
+        put_u32(s->code.buf + ref->offset,
+                s->labels[ref->label] - (ref->offset + 4));
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+    code_size = offsetof(LREJitCode, code) + s->code.size;
+    size = (code_size + page_size - 1) & ~(page_size - 1);
+    jit = mmap(NULL, size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (jit == MAP_FAILED) {
+        jit = NULL;
+        goto done;
+    }
+    jit->size = size;
+    jit->entry[0] = s->labels[0];
+    /* only used when the bytecode starts with the search loop */
+    jit->entry[1] = 0;
+    if (RE_SEARCH_LOOP_LEN < s->bc_len && s->labels[RE_SEARCH_LOOP_LEN] >= 0)
+        jit->entry[1] = s->labels[RE_SEARCH_LOOP_LEN];
+    memcpy(jit->code, s->code.buf, s->code.size);
+    if (mprotect(jit, size, PROT_READ | PROT_EXEC) < 0) {
+        munmap(jit, size);
+        jit = NULL;
+    }
+ done:
+    dbuf_free(&s->code);
+    dbuf_free(&s->tables);
+    lre_realloc(opaque, s->labels, 0);
+    lre_realloc(opaque, s->refs, 0);
+    return jit;
+}
+
+void lre_jit_free(LREJitCode *jit)
+{
+    munmap(jit, jit->size);
+}
+
+/* same as lre_exec_backtrack() with the native code */
+static intptr_t lre_exec_jit_code(REExecContext *s, uint8_t **capture,
+                                  const uint8_t *pc, const uint8_t *cptr)
+{
+    REJitState js_s, *js = &js_s;
+    uintptr_t bt_stack[RE_JIT_BT_STACK_INIT * 3];
+    const LREJitCode *jit = s->jit;
+    const uint8_t *entry;
+    int ret;
+
+    js->s = s;
+    js->capture = capture;
+    js->cbuf = s->cbuf;
+    js->cbuf_end = s->cbuf_end;
+    js->bt_stack = bt_stack;
+    js->bt_stack_end = bt_stack + countof(bt_stack);
+    js->bt_stack_allocated = FALSE;
+    if (pc == s->bc_start + RE_HEADER_LEN)
+        entry = jit->code + jit->entry[0];
+    else
+        entry = jit->code + jit->entry[1];
+    ret = ((REJitFunc *)jit->code)(js, cptr, entry);
+    if (js->bt_stack_allocated)
+        lre_realloc(s->opaque, js->bt_stack, 0);
+    return ret;
+}
+
+#else
+
+LREJitCode *lre_jit_compile(const uint8_t *bc_buf, void *opaque)
+{
+    return NULL;
+}
+
+void lre_jit_free(LREJitCode *jit)
+{
+}
+
+#endif /* !RE_JIT */
+#endif /* CONFIG_REGEXP_JIT */
+
+/* Return the first position >= cptr of the literal 'lit' of 'len'
+   chars or NULL if none. */
+static const uint8_t *re_find_literal(const uint8_t *cptr,
+                                      const uint8_t *cbuf_end, int cbuf_type,
+                                      const uint8_t *lit, int len)
+{
+    uint32_t c0;
+    int i;
+
+    c0 = get_u16(lit);
+    if (cbuf_type == 0) {
+        const uint8_t *p = cptr;
+        if (c0 >= 256)
+            return NULL;
+        while ((cbuf_end - p) >= len) {
+            p = memchr(p, c0, cbuf_end - p - len + 1);
+            if (!p)
+                break;
+            for(i = 1; i < len; i++) {
+                if (p[i] != get_u16(lit + 2 * i))
+                    break;
+            }
+            if (i == len)
+                return p;
+            p++;
+        }
+    } else {
+        const uint16_t *p = (const uint16_t *)cptr;
+        const uint16_t *end = (const uint16_t *)cbuf_end;
+        while ((end - p) >= len) {
+            if (*p == c0) {
+                for(i = 1; i < len; i++) {
+                    if (p[i] != get_u16(lit + 2 * i))
+                        break;
+                }
+                if (i == len)
+                    return (const uint8_t *)p;
+            }
+            p++;
+        }
+    }
+    return NULL;
+}
+
+/* Return the first position >= cptr whose char is in the first char
+   set or NULL if none. */
+static const uint8_t *re_find_first_char(const uint8_t *cptr,
+                                         const uint8_t *cbuf_start,
+                                         const uint8_t *cbuf_end, int cbuf_type,
+                                         const uint8_t *first_set, BOOL wide)
+{
+    uint32_t c;
+
+    if (cbuf_type == 0) {
+        const uint8_t *p;
+        for(p = cptr; p < cbuf_end; p++) {
+            c = *p;
+            if (first_set[c >> 3] & (1 << (c & 7)))
+                return p;
+        }
+    } else {
+        const uint16_t *p;
+        const uint16_t *start = (const uint16_t *)cbuf_start;
+        const uint16_t *end = (const uint16_t *)cbuf_end;
+        for(p = (const uint16_t *)cptr; p < end; p++) {
+            c = *p;
+            if (c < 256) {
+                if (first_set[c >> 3] & (1 << (c & 7)))
+                    return (const uint8_t *)p;
+            } else if (wide) {
+                /* never start in the middle of a surrogate pair */
+                if (cbuf_type == 2 && is_lo_surrogate(c) &&
+                    p > start && is_hi_surrogate(p[-1]))
+                    continue;
+                return (const uint8_t *)p;
+            }
+        }
+    }
+    return NULL;
+}
+
+static intptr_t lre_exec_run(REExecContext *s, uint8_t **capture,
+                             StackInt *stack_buf, const uint8_t *pc,
+                             const uint8_t *cptr)
+{
+#ifdef RE_JIT
+    if (s->jit)
+        return lre_exec_jit_code(s, capture, pc, cptr);
+#endif
+    return lre_exec_backtrack(s, capture, stack_buf, 0, pc, cptr, FALSE);
+}
+
+/* Same as lre_exec_backtrack() but use the prefilter 'pf' to skip the
+   positions where no match can start. */
+static intptr_t lre_exec_prefilter(REExecContext *s, uint8_t **capture,
+                                   StackInt *stack_buf, const uint8_t *pf,
+                                   const uint8_t *pc, const uint8_t *cptr)
+{
+    int flags, prefix_len, required_len, i;
+    const uint8_t *first_set, *prefix, *required;
+    intptr_t ret;
+
+    flags = pf[RE_PREFILTER_FLAGS];
+    prefix_len = pf[RE_PREFILTER_PREFIX_LEN];
+    required_len = pf[RE_PREFILTER_REQUIRED_LEN];
+    pf += RE_PREFILTER_LEN;
+    first_set = NULL;
+    if (flags & RE_PREFILTER_FIRST_SET) {
+        first_set = pf;
+        pf += 32;
+    }
+    prefix = pf;
+    required = pf + prefix_len * 2;
+
+    /* not done for the sticky regexps because they may be executed
+       at each position of the string (e.g. String.prototype.split) */
+    if (required_len != 0 && (flags & RE_PREFILTER_HAS_LOOP) &&
+        !re_find_literal(cptr, s->cbuf_end, s->cbuf_type,
+                         required, required_len))
+        return 0;
+    if (!(flags & RE_PREFILTER_HAS_LOOP) || (!first_set && prefix_len == 0))
+        return lre_exec_run(s, capture, stack_buf, pc, cptr);
+
+    /* replace the search loop of the bytecode */
+    pc += RE_SEARCH_LOOP_LEN;
+    for(;;) {
+        if (prefix_len != 0) {
+            cptr = re_find_literal(cptr, s->cbuf_end, s->cbuf_type,
+                                   prefix, prefix_len);
+        } else {
+            cptr = re_find_first_char(cptr, s->cbuf, s->cbuf_end,
+                                      s->cbuf_type, first_set,
+                                      (flags & RE_PREFILTER_FIRST_SET_WIDE) != 0);
+        }
+        if (!cptr)
+            return 0;
+        for(i = 0; i < s->capture_count * 2; i++)
+            capture[i] = NULL;
+        ret = lre_exec_run(s, capture, stack_buf, pc, cptr);
+        if (ret != 0)
+            return ret;
+        /* the candidate is never a surrogate pair */
+        cptr += 1 << (s->cbuf_type != 0);
+    }
+}
+
+typedef struct {
+    int node;
+    uint8_t **capture;
+} RENFAThread;
+
+typedef struct {
+    int slot; /* >= 0: restore the capture 'slot', otherwise explore 'node' */
+    int node;
+    uint32_t mask; /* no advance mask when exploring 'node' */
+    uint8_t *val;
+} RENFAStackEntry;
+
+typedef struct {
+    REExecContext *s;
+    const uint8_t *bc_buf;
+    RENFANode *nodes;
+    int *mark;
+    uint32_t *mark_levels; /* visited lowest mask bits if mark == gen */
+    int gen;
+    RENFAStackEntry *stack;
+    int capture_size;
+} RENFAExecState;
+
+static BOOL re_nfa_match_char(REExecContext *s, const uint8_t *pc, uint32_t c)
+{
+    int opcode, n, idx_min, idx_max, idx;
+    uint32_t val, low, high;
+
+    opcode = *pc++;
+    switch(opcode) {
+    case REOP_char:
+    case REOP_char_i:
+        val = get_u16(pc);
+        goto test_char;
+    case REOP_char32:
+    case REOP_char32_i:
+        val = get_u32(pc);
+    test_char:
+        if (opcode == REOP_char_i || opcode == REOP_char32_i)
+            c = lre_canonicalize(c, s->is_unicode);
+        return c == val;
+    case REOP_dot:
+        return !is_line_terminator(c);
+    case REOP_any:
+        return TRUE;
+    case REOP_range:
+    case REOP_range_i:
+        if (opcode == REOP_range_i)
+            c = lre_canonicalize(c, s->is_unicode);
+        n = get_u16(pc);
+        pc += 2;
+        /* 0xffff in for last value means +infinity */
+        if (c >= 0xffff && get_u16(pc + (n - 1) * 4 + 2) == 0xffff)
+            return TRUE;
+        idx_min = 0;
+        idx_max = n - 1;
+        while (idx_min <= idx_max) {
+            idx = (idx_min + idx_max) / 2;
+            low = get_u16(pc + idx * 4);
+            high = get_u16(pc + idx * 4 + 2);
+            if (c < low)
+                idx_max = idx - 1;
+            else if (c > high)
+                idx_min = idx + 1;
+            else
+                return TRUE;
+        }
+        return FALSE;
+    case REOP_range32:
+    case REOP_range32_i:
+        if (opcode == REOP_range32_i)
+            c = lre_canonicalize(c, s->is_unicode);
+        n = get_u16(pc);
+        pc += 2;
+        idx_min = 0;
+        idx_max = n - 1;
+        while (idx_min <= idx_max) {
+            idx = (idx_min + idx_max) / 2;
+            low = get_u32(pc + idx * 8);
+            high = get_u32(pc + idx * 8 + 4);
+            if (c < low)
+                idx_max = idx - 1;
+            else if (c > high)
+                idx_min = idx + 1;
+            else
+                return TRUE;
+        }
+        return FALSE;
+    default:
+        abort();
+    }
+}
+
+static BOOL re_nfa_check_assert(REExecContext *s, const uint8_t *pc,
+                                const uint8_t *cptr)
+{
+    int opcode, cbuf_type;
+    uint32_t c;
+    BOOL v1, v2, ignore_case, is_boundary;
+
+    cbuf_type = s->cbuf_type;
+    opcode = *pc;
+    switch(opcode) {
+    case REOP_line_start:
+    case REOP_line_start_m:
+        if (cptr == s->cbuf)
+            return TRUE;
+        if (opcode == REOP_line_start)
+            return FALSE;
+        PEEK_PREV_CHAR(c, cptr, s->cbuf, cbuf_type);
+        return is_line_terminator(c);
+    case REOP_line_end:
+    case REOP_line_end_m:
+        if (cptr == s->cbuf_end)
+            return TRUE;
+        if (opcode == REOP_line_end)
+            return FALSE;
+        PEEK_CHAR(c, cptr, s->cbuf_end, cbuf_type);
+        return is_line_terminator(c);
+    default:
+        ignore_case = (opcode == REOP_word_boundary_i || opcode == REOP_not_word_boundary_i);
+        is_boundary = (opcode == REOP_word_boundary || opcode == REOP_word_boundary_i);
+        if (cptr == s->cbuf) {
+            v1 = FALSE;
+        } else {
+            PEEK_PREV_CHAR(c, cptr, s->cbuf, cbuf_type);
+            if (ignore_case)
+                c = lre_canonicalize(c, s->is_unicode);
+            v1 = is_word_char(c);
+        }
+        if (cptr >= s->cbuf_end) {
+            v2 = FALSE;
+        } else {
+            PEEK_CHAR(c, cptr, s->cbuf_end, cbuf_type);
+            if (ignore_case)
+                c = lre_canonicalize(c, s->is_unicode);
+            v2 = is_word_char(c);
+        }
+        return !(v1 ^ v2 ^ is_boundary);
+    }
+}
+
+/* add the threads reachable from 'node' without consuming a char. The
+   threads are added in priority order. */
+static void re_nfa_add_thread(RENFAExecState *e, RENFAThread *list,
+                              int *pcount, int node, uint8_t **capture,
+                              const uint8_t *cptr)
+{
+    RENFAStackEntry *stack = e->stack;
+    RENFANode *n;
+    RENFAThread *t;
+    int sp, slot, i;
+    uint32_t mask, level;
+
+    sp = 0;
+    stack[sp].slot = -1;
+    stack[sp].node = node;
+    stack[sp].mask = 0;
+    sp++;
+    while (sp > 0) {
+        sp--;
+        if (stack[sp].slot >= 0) {
+            capture[stack[sp].slot] = stack[sp].val;
+            continue;
+        }
+        node = stack[sp].node;
+        mask = stack[sp].mask;
+        for(;;) {
+            n = &e->nodes[node];
+            /* the mask does not matter once a char is consumed */
+            level = 1;
+            if (mask != 0 && n->op != RE_NFA_CHAR && n->op != RE_NFA_MATCH)
+                level <<= 1 + ctz32(mask);
+            if (e->mark[node] != e->gen) {
+                e->mark[node] = e->gen;
+                e->mark_levels[node] = 0;
+            } else if (e->mark_levels[node] & level) {
+                break;
+            }
+            e->mark_levels[node] |= level;
+            switch(n->op) {
+            case RE_NFA_JMP:
+                break;
+            case RE_NFA_SPLIT:
+                stack[sp].slot = -1;
+                stack[sp].node = n->arg;
+                stack[sp].mask = mask;
+                sp++;
+                break;
+            case RE_NFA_PUSH_CHAR_POS:
+                mask |= 1 << n->a;
+                break;
+            case RE_NFA_CHECK_ADVANCE:
+                if (mask & (1 << n->a))
+                    goto next;
+                break;
+            case RE_NFA_SAVE:
+                slot = 2 * n->a + n->b;
+                stack[sp].slot = slot;
+                stack[sp].val = capture[slot];
+                sp++;
+                capture[slot] = (uint8_t *)cptr;
+                break;
+            case RE_NFA_RESET:
+                for(i = 2 * n->a; i < 2 * n->b + 2; i++) {
+                    stack[sp].slot = i;
+                    stack[sp].val = capture[i];
+                    sp++;
+                    capture[i] = NULL;
+                }
+                break;
+            case RE_NFA_ASSERT:
+                if (!re_nfa_check_assert(e->s, e->bc_buf + n->arg, cptr))
+                    goto next;
+                break;
+            default:
+                t = &list[(*pcount)++];
+                t->node = node;
+                memcpy(t->capture, capture, e->capture_size);
+                goto next;
+            }
+            node = n->out;
+        }
+    next: ;
+    }
+}
+
+/* Pike VM: the threads are executed in lock step so that the
+   execution time is linear in the length of the input. */
+static intptr_t lre_exec_nfa(REExecContext *s, uint8_t **capture,
+                             const uint8_t *bc_buf, const uint8_t *nfa,
+                             int nfa_len, const uint8_t *cptr)
+{
+    RENFAExecState e_s, *e = &e_s;
+    RENFAThread *clist, *nlist, *tmp;
+    int node_count, start, i, stack_size, ccount, ncount, cbuf_type;
+    int capture_count2, levels;
+    uint8_t **capture_buf, **capture_init;
+    const uint8_t *cptr1;
+    size_t size;
+    intptr_t ret;
+    uint32_t c;
+    uint8_t *mem;
+
+    cbuf_type = s->cbuf_type;
+    start = get_u32(nfa);
+    nfa += 4;
+    node_count = (nfa_len - 4) / RE_NFA_NODE_SIZE;
+    capture_count2 = 2 * s->capture_count;
+
+    e->s = s;
+    e->bc_buf = bc_buf;
+    e->gen = 0;
+    e->capture_size = sizeof(capture[0]) * capture_count2;
+
+    /* allocate everything in one block. A node is visited at most
+       once per level at each position. */
+    stack_size = 0;
+    levels = 1;
+    for(i = 0; i < node_count; i++) {
+        const uint8_t *p = nfa + i * RE_NFA_NODE_SIZE;
+        if (p[0] == RE_NFA_SPLIT || p[0] == RE_NFA_SAVE)
+            stack_size++;
+        else if (p[0] == RE_NFA_RESET)
+            stack_size += 2 * (p[2] - p[1] + 1);
+        else if (p[0] == RE_NFA_PUSH_CHAR_POS)
+            levels = max_int(levels, p[1] + 2);
+    }
+    stack_size = 1 + stack_size * levels;
+    size = sizeof(RENFAStackEntry) * stack_size +
+        sizeof(RENFAThread) * node_count * 2 +
+        e->capture_size * (node_count * 2 + 1) +
+        sizeof(RENFANode) * node_count +
+        (sizeof(int) + sizeof(uint32_t)) * node_count;
+    mem = lre_realloc(s->opaque, NULL, size);
+    if (!mem)
+        return LRE_RET_MEMORY_ERROR;
+    e->stack = (RENFAStackEntry *)mem;
+    clist = (RENFAThread *)(e->stack + stack_size);
+    nlist = clist + node_count;
+    capture_buf = (uint8_t **)(nlist + node_count);
+    e->nodes = (RENFANode *)(capture_buf + capture_count2 * (node_count * 2 + 1));
+    e->mark = (int *)(e->nodes + node_count);
+    e->mark_levels = (uint32_t *)(e->mark + node_count);
+    for(i = 0; i < node_count; i++) {
+        const uint8_t *p = nfa + i * RE_NFA_NODE_SIZE;
+        RENFANode *n = &e->nodes[i];
+        n->op = p[0];
+        n->a = p[1];
+        n->b = p[2];
+        n->out = get_u32(p + 4);
+        n->arg = get_u32(p + 8);
+        e->mark[i] = -1;
+        clist[i].capture = capture_buf + capture_count2 * i;
+        nlist[i].capture = capture_buf + capture_count2 * (node_count + i);
+    }
+    capture_init = capture_buf + capture_count2 * node_count * 2;
+    for(i = 0; i < capture_count2; i++)
+        capture_init[i] = NULL;
+
+    ret = 0;
+    ccount = 0;
+    re_nfa_add_thread(e, clist, &ccount, start, capture_init, cptr);
+    while (ccount != 0) {
+        if (lre_poll_timeout(s)) {
+            ret = LRE_RET_TIMEOUT;
+            break;
+        }
+        cptr1 = NULL;
+        c = 0;
+        if (cptr < s->cbuf_end) {
+            cptr1 = cptr;
+            GET_CHAR(c, cptr1, s->cbuf_end, cbuf_type);
+        }
+        e->gen++;
+        ncount = 0;
+        for(i = 0; i < ccount; i++) {
+            RENFANode *n = &e->nodes[clist[i].node];
+            if (n->op == RE_NFA_MATCH) {
+                /* the lower priority threads are discarded */
+                memcpy(capture, clist[i].capture, e->capture_size);
+                ret = 1;
+                break;
+            }
+            if (cptr1 && re_nfa_match_char(s, bc_buf + n->arg, c)) {
+                re_nfa_add_thread(e, nlist, &ncount, n->out,
+                                  clist[i].capture, cptr1);
+            }
+        }
+        tmp = clist;
+        clist = nlist;
+        nlist = tmp;
+        ccount = ncount;
+        if (!cptr1)
+            break;
+        cptr = cptr1;
+    }
+    lre_realloc(s->opaque, mem, 0);
+    return ret;
+}
+
+/* 'jit' is the optional native code of 'bc_buf' */
+static int lre_exec_internal(uint8_t **capture, const uint8_t *bc_buf,
+                             const struct LREJitCode *jit,
+                             const uint8_t *cbuf, int cindex, int clen,
+                             int cbuf_type, void *opaque)
+{
+    REExecContext s_s, *s = &s_s;
+    int re_flags, i, alloca_size, ret;
+    StackInt *stack_buf;
+    const uint8_t *cptr, *pc, *pf;
+    int pf_len, nfa_len;
+
+    re_flags = lre_get_flags(bc_buf);
+    s->is_unicode = (re_flags & (LRE_FLAG_UNICODE | LRE_FLAG_UNICODE_SETS)) != 0;
+    s->capture_count = bc_buf[RE_HEADER_CAPTURE_COUNT];
+    s->stack_size_max = bc_buf[RE_HEADER_STACK_SIZE];
+    s->cbuf = cbuf;
+    s->cbuf_end = cbuf + (clen << cbuf_type);
+    s->cbuf_type = cbuf_type;
+    if (s->cbuf_type == 1 && s->is_unicode)
+        s->cbuf_type = 2;
+    s->interrupt_counter = INTERRUPT_COUNTER_INIT;
+    s->opaque = opaque;
+    s->jit = NULL;
+    if (jit && cbuf_type == 0)
+        s->jit = jit;
+    s->bc_start = bc_buf;
+
+    s->state_size = sizeof(REExecState) +
+        s->capture_count * sizeof(capture[0]) * 2 +
+        s->stack_size_max * sizeof(stack_buf[0]);
+    s->state_stack = NULL;
+    s->state_stack_len = 0;
+    s->state_stack_size = 0;
+
+    for(i = 0; i < s->capture_count * 2; i++)
+        capture[i] = NULL;
+    alloca_size = s->stack_size_max * sizeof(stack_buf[0]);
     stack_buf = alloca(alloca_size);
 
     cptr = cbuf + (cindex << cbuf_type);
@@ -3197,12 +5299,61 @@ int lre_exec(uint8_t **capture,
         }
     }
 
-    ret = lre_exec_backtrack(s, capture, stack_buf, 0, bc_buf + RE_HEADER_LEN,
-                             cptr, FALSE);
+    pc = bc_buf + RE_HEADER_LEN;
+    pf = pc + get_u32(bc_buf + RE_HEADER_BYTECODE_LEN);
+    pf_len = get_u16(bc_buf + RE_HEADER_PREFILTER_LEN);
+    nfa_len = get_u32(bc_buf + RE_HEADER_NFA_LEN);
+    s->nfa = NULL;
+    if (nfa_len != 0) {
+        s->nfa = pf + pf_len;
+        s->nfa_fallback_counter = 1 + (int64_t)(clen - cindex + 1) *
+            NFA_FALLBACK_STEPS / INTERRUPT_COUNTER_INIT;
+    }
+    if (pf_len != 0) {
+        ret = lre_exec_prefilter(s, capture, stack_buf, pf, pc, cptr);
+    } else {
+        ret = lre_exec_run(s, capture, stack_buf, pc, cptr);
+    }
     lre_realloc(s->opaque, s->state_stack, 0);
+    if (ret == LRE_RET_NFA_FALLBACK) {
+        /* too much backtracking: use the linear time engine */
+        s->nfa = NULL;
+        lre_nfa_fallback(s->opaque);
+        ret = lre_exec_nfa(s, capture, pc, pf + pf_len, nfa_len, cptr);
+    }
     return ret;
 }
 
+/* Return 1 if match, 0 if not match or < 0 if error (see LRE_RET_x). cindex is the
+   starting position of the match and must be such as 0 <= cindex <=
+   clen. */
+int lre_exec(uint8_t **capture,
+             const uint8_t *bc_buf, const uint8_t *cbuf, int cindex, int clen,
+             int cbuf_type, void *opaque)
+{
+    return lre_exec_internal(capture, bc_buf, NULL, cbuf, cindex, clen,
+                             cbuf_type, opaque);
+}
+
+#ifdef CONFIG_REGEXP_JIT
+/* same as lre_exec() but use the native code 'jit' if not NULL */
+int lre_exec_jit(uint8_t **capture, const uint8_t *bc_buf, LREJitCode *jit,
+                 const uint8_t *cbuf, int cindex, int clen,
+                 int cbuf_type, void *opaque)
+{
+    return lre_exec_internal(capture, bc_buf, jit, cbuf, cindex, clen,
+                             cbuf_type, opaque);
+}
+#endif
+
+int lre_get_engine(const uint8_t *bc_buf)
+{
+    if (get_u32(bc_buf + RE_HEADER_NFA_LEN) != 0)
+        return LRE_ENGINE_NFA;
+    else
+        return LRE_ENGINE_BACKTRACK;
+}
+
 int lre_get_capture_count(const uint8_t *bc_buf)
 {
     return bc_buf[RE_HEADER_CAPTURE_COUNT];
@@ -3221,7 +5372,9 @@ const char *lre_get_groupnames(const uint8_t *bc_buf)
     if ((lre_get_flags(bc_buf) & LRE_FLAG_NAMED_GROUPS) == 0)
         return NULL;
     re_bytecode_len = get_u32(bc_buf + RE_HEADER_BYTECODE_LEN);
-    return (const char *)(bc_buf + RE_HEADER_LEN + re_bytecode_len);
+    return (const char *)(bc_buf + RE_HEADER_LEN + re_bytecode_len +
+                          get_u16(bc_buf + RE_HEADER_PREFILTER_LEN) +
+                          get_u32(bc_buf + RE_HEADER_NFA_LEN));
 }
 
 #ifdef TEST
@@ -3236,6 +5389,10 @@ void *lre_realloc(void *opaque, void *ptr, size_t size)
     return realloc(ptr, size);
 }
 
+void lre_nfa_fallback(void *opaque)
+{
+}
+
 int main(int argc, char **argv)
 {
     int len, flags, ret, i;
@@ -40,6 +40,10 @@
 #define LRE_RET_MEMORY_ERROR (-1)
 #define LRE_RET_TIMEOUT      (-2)
 
+/* engines available to lre_exec() */
+#define LRE_ENGINE_BACKTRACK 0 /* backtracking only */
+#define LRE_ENGINE_NFA       1 /* backtracking with linear time NFA fallback */
+
 uint8_t *lre_compile(int *plen, char *error_msg, int error_msg_size,
                      const char *buf, size_t buf_len, int re_flags,
                      void *opaque);
@@ -49,6 +53,18 @@ const char *lre_get_groupnames(const uint8_t *bc_buf);
 int lre_exec(uint8_t **capture,
              const uint8_t *bc_buf, const uint8_t *cbuf, int cindex, int clen,
              int cbuf_type, void *opaque);
+/* debug: return the LRE_ENGINE_x of the compiled regexp */
+int lre_get_engine(const uint8_t *bc_buf);
+
+#ifdef CONFIG_REGEXP_JIT
+typedef struct LREJitCode LREJitCode;
+/* return NULL if the regexp or the CPU are not supported */
+LREJitCode *lre_jit_compile(const uint8_t *bc_buf, void *opaque);
+void lre_jit_free(LREJitCode *jit);
+int lre_exec_jit(uint8_t **capture, const uint8_t *bc_buf, LREJitCode *jit,
+                 const uint8_t *cbuf, int cindex, int clen,
+                 int cbuf_type, void *opaque);
+#endif
 
 int lre_parse_escape(const uint8_t **pp, int allow_utf16);
 
@@ -56,6 +72,9 @@ int lre_parse_escape(const uint8_t **pp, int allow_utf16);
 int lre_check_stack_overflow(void *opaque, size_t alloca_size);
 /* must be provided by the user, return non zero if time out */
 int lre_check_timeout(void *opaque);
+/* must be provided by the user, called when lre_exec() switches to
+   the linear time engine */
+void lre_nfa_fallback(void *opaque);
 void *lre_realloc(void *opaque, void *ptr, size_t size);
 
 #endif /* LIBREGEXP_H */
@@ -52,18 +52,18 @@ static int eval_buf(JSContext *ctx, const void *buf, int buf_len,
     JSValue val;
     int ret;
 
+    /* compile then run to use the bytecode cache and, for the
+       modules, to be able to set import.meta */
+    val = js_std_compile(ctx, buf, buf_len, filename, eval_flags);
     if ((eval_flags & JS_EVAL_TYPE_MASK) == JS_EVAL_TYPE_MODULE) {
-        /* for the modules, we compile then run to be able to set
-           import.meta */
-        val = JS_Eval(ctx, buf, buf_len, filename,
-                      eval_flags | JS_EVAL_FLAG_COMPILE_ONLY);
         if (!JS_IsException(val)) {
             js_module_set_import_meta(ctx, val, TRUE, TRUE);
             val = JS_EvalFunction(ctx, val);
         }
         val = js_std_await(ctx, val);
     } else {
-        val = JS_Eval(ctx, buf, buf_len, filename, eval_flags);
+        if (!JS_IsException(val))
+            val = JS_EvalFunction(ctx, val);
     }
     if (JS_IsException(val)) {
         js_std_dump_error(ctx);
@@ -113,6 +113,74 @@ static JSContext *JS_NewCustomContext(JSRuntime *rt)
     return ctx;
 }
 
+/* the contexts must be initialized the same way to use snapshots */
+static int init_context(JSContext *ctx, int argc, char **argv, int load_std)
+{
+    js_std_add_helpers(ctx, argc, argv);
+
+    /* make 'std' and 'os' visible to non module code */
+    if (load_std) {
+        const char *str = "import * as std from 'std';\n"
+            "import * as os from 'os';\n"
+            "globalThis.std = std;\n"
+            "globalThis.os = os;\n";
+        return eval_buf(ctx, str, strlen(str), "<input>", JS_EVAL_TYPE_MODULE);
+    }
+    return 0;
+}
+
+static int load_snapshot(JSContext *ctx, const char *filename)
+{
+    uint8_t *buf;
+    size_t buf_len;
+    int ret;
+
+    buf = js_load_file(ctx, &buf_len, filename);
+    if (!buf) {
+        perror(filename);
+        return -1;
+    }
+    ret = JS_ReadSnapshot(ctx, buf, buf_len);
+    js_free(ctx, buf);
+    if (ret < 0)
+        js_std_dump_error(ctx);
+    return ret;
+}
+
+static int save_snapshot(JSContext *ctx, const char *filename,
+                         int argc, char **argv, int load_std)
+{
+    JSContext *base_ctx;
+    uint8_t *buf;
+    size_t buf_len;
+    FILE *f;
+    int ret = -1;
+
+    base_ctx = JS_NewCustomContext(JS_GetRuntime(ctx));
+    if (!base_ctx)
+        return -1;
+    if (init_context(base_ctx, argc, argv, load_std))
+        goto done;
+    buf = JS_WriteSnapshot(ctx, base_ctx, &buf_len);
+    if (!buf) {
+        js_std_dump_error(ctx);
+        goto done;
+    }
+    f = fopen(filename, "wb");
+    if (f) {
+        if (fwrite(buf, 1, buf_len, f) == buf_len)
+            ret = 0;
+        if (fclose(f) != 0)
+            ret = -1;
+    }
+    if (ret < 0)
+        perror(filename);
+    js_free(ctx, buf);
+ done:
+    JS_FreeContext(base_ctx);
+    return ret;
+}
+
 #if defined(__APPLE__)
 #define MALLOC_OVERHEAD  0
 #else
@@ -300,7 +368,18 @@ void help(void)
            "-d  --dump         dump the memory usage stats\n"
            "    --memory-limit n  limit the memory usage to 'n' bytes (SI suffixes allowed)\n"
            "    --stack-size n    limit the stack size to 'n' bytes (SI suffixes allowed)\n"
+           "    --gc-max-pause n  incremental GC with pauses of at most 'n' microseconds\n"
+           "    --nursery-size n  allocate the short lived objects in a nursery of 'n' bytes (SI suffixes allowed)\n"
+           "    --slab            use a slab allocator for the small blocks\n"
+           "    --slab-release    same as --slab and return the empty slab arenas to the system\n"
            "    --no-unhandled-rejection  ignore unhandled promise rejections\n"
+           "    --no-inline-cache  disable the property access inline caches\n"
+           "    --no-lazy         disable the lazy compilation of the functions\n"
+           "    --no-jit          disable the baseline JIT\n"
+           "    --bytecode-cache dir  cache the compiled scripts and modules in 'dir'\n"
+           "    --snapshot file   restore the global state saved in 'file' before running\n"
+           "    --save-snapshot file  save the global state in 'file' after running\n"
+           "    --jit-threshold n compile a function after 'n' calls or loop iterations\n"
            "-s                    strip all the debug info\n"
            "    --strip-source    strip the source code\n"
            "-q  --quit         just instantiate the interpreter and quit\n");
@@ -326,6 +405,16 @@ int main(int argc, char **argv)
     int i, include_count = 0;
     int strip_flags = 0;
     size_t stack_size = 0;
+    int inline_cache = 1;
+    int lazy = 1;
+    int jit = 1;
+    int jit_threshold = 0;
+    const char *bytecode_cache_dir = NULL;
+    const char *snapshot_file = NULL;
+    const char *save_snapshot_file = NULL;
+    int64_t gc_max_pause = 0;
+    size_t nursery_size = 0;
+    int slab_flags = 0;
 
     /* cannot use getopt because we want to pass the command line to
        the script */
@@ -404,6 +493,50 @@ int main(int argc, char **argv)
                 dump_unhandled_promise_rejection = 0;
                 continue;
             }
+            if (!strcmp(longopt, "no-inline-cache")) {
+                inline_cache = 0;
+                continue;
+            }
+            if (!strcmp(longopt, "no-lazy")) {
+                lazy = 0;
+                continue;
+            }
+            if (!strcmp(longopt, "no-jit")) {
+                jit = 0;
+                continue;
+            }
+            if (!strcmp(longopt, "jit-threshold")) {
+                if (optind >= argc) {
+                    fprintf(stderr, "expecting JIT threshold");
+                    exit(1);
+                }
+                jit_threshold = strtol(argv[optind++], NULL, 0);
+                continue;
+            }
+            if (!strcmp(longopt, "bytecode-cache")) {
+                if (optind >= argc) {
+                    fprintf(stderr, "expecting bytecode cache directory");
+                    exit(1);
+                }
+                bytecode_cache_dir = argv[optind++];
+                continue;
+            }
+            if (!strcmp(longopt, "snapshot")) {
+                if (optind >= argc) {
+                    fprintf(stderr, "expecting snapshot filename");
+                    exit(1);
+                }
+                snapshot_file = argv[optind++];
+                continue;
+            }
+            if (!strcmp(longopt, "save-snapshot")) {
+                if (optind >= argc) {
+                    fprintf(stderr, "expecting snapshot filename");
+                    exit(1);
+                }
+                save_snapshot_file = argv[optind++];
+                continue;
+            }
             if (opt == 'q' || !strcmp(longopt, "quit")) {
                 empty_run++;
                 continue;
@@ -424,6 +557,30 @@ int main(int argc, char **argv)
                 stack_size = get_suffixed_size(argv[optind++]);
                 continue;
             }
+            if (!strcmp(longopt, "gc-max-pause")) {
+                if (optind >= argc) {
+                    fprintf(stderr, "expecting GC pause");
+                    exit(1);
+                }
+                gc_max_pause = strtoll(argv[optind++], NULL, 0);
+                continue;
+            }
+            if (!strcmp(longopt, "nursery-size")) {
+                if (optind >= argc) {
+                    fprintf(stderr, "expecting nursery size");
+                    exit(1);
+                }
+                nursery_size = get_suffixed_size(argv[optind++]);
+                continue;
+            }
+            if (!strcmp(longopt, "slab")) {
+                slab_flags |= JS_SLAB_ENABLED;
+                continue;
+            }
+            if (!strcmp(longopt, "slab-release")) {
+                slab_flags |= JS_SLAB_ENABLED | JS_SLAB_RELEASE_EMPTY;
+                continue;
+            }
             if (opt == 's') {
                 strip_flags = JS_STRIP_DEBUG;
                 continue;
@@ -451,13 +608,32 @@ int main(int argc, char **argv)
         fprintf(stderr, "qjs: cannot allocate JS runtime\n");
         exit(2);
     }
+    if (!trace_memory)
+        JS_SetSlabAllocator(rt, slab_flags);
+    if (nursery_size != 0 && JS_SetNurserySize(rt, nursery_size) < 0) {
+        fprintf(stderr, "qjs: cannot allocate the nursery\n");
+        exit(2);
+    }
     if (memory_limit != 0)
         JS_SetMemoryLimit(rt, memory_limit);
     if (stack_size != 0)
         JS_SetMaxStackSize(rt, stack_size);
     JS_SetStripInfo(rt, strip_flags);
+    JS_SetInlineCacheEnabled(rt, inline_cache);
+    JS_SetLazyCompilationEnabled(rt, lazy);
+    JS_SetJITEnabled(rt, jit);
+    if (jit_threshold != 0)
+        JS_SetJITThreshold(rt, jit_threshold);
+    if (gc_max_pause != 0)
+        JS_SetGCMaxPause(rt, gc_max_pause);
     js_std_set_worker_new_context_func(JS_NewCustomContext);
     js_std_init_handlers(rt);
+    if (bytecode_cache_dir &&
+        js_std_set_bytecode_cache(rt, bytecode_cache_dir) < 0) {
+        fprintf(stderr, "qjs: cannot use the bytecode cache directory '%s'\n",
+                bytecode_cache_dir);
+        exit(2);
+    }
     ctx = JS_NewCustomContext(rt);
     if (!ctx) {
         fprintf(stderr, "qjs: cannot allocate JS context\n");
@@ -473,16 +649,10 @@ int main(int argc, char **argv)
     }
 
     if (!empty_run) {
-        js_std_add_helpers(ctx, argc - optind, argv + optind);
-
-        /* make 'std' and 'os' visible to non module code */
-        if (load_std) {
-            const char *str = "import * as std from 'std';\n"
-                "import * as os from 'os';\n"
-                "globalThis.std = std;\n"
-                "globalThis.os = os;\n";
-            eval_buf(ctx, str, strlen(str), "<input>", JS_EVAL_TYPE_MODULE);
-        }
+        init_context(ctx, argc - optind, argv + optind, load_std);
+
+        if (snapshot_file && load_snapshot(ctx, snapshot_file))
+            goto fail;
 
         for(i = 0; i < include_count; i++) {
             if (eval_file(ctx, include_list[i], module))
@@ -507,6 +677,11 @@ int main(int argc, char **argv)
             js_std_eval_binary(ctx, qjsc_repl, qjsc_repl_size, 0);
         }
         js_std_loop(ctx);
+
+        if (save_snapshot_file &&
+            save_snapshot(ctx, save_snapshot_file, argc - optind,
+                          argv + optind, load_std))
+            goto fail;
     }
 
     if (dump_memory) {
@@ -759,6 +759,8 @@ int main(int argc, char **argv)
     ctx = JS_NewContext(rt);
 
     JS_SetStripInfo(rt, strip_flags);
+    /* the bytecode of all the functions is output */
+    JS_SetLazyCompilationEnabled(rt, FALSE);
 
     /* loader for ES6 modules */
     JS_SetModuleLoaderFunc2(rt, NULL, jsc_module_loader, NULL, NULL);
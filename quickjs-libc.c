@@ -46,6 +46,7 @@
 #include <termios.h>
 #include <sys/ioctl.h>
 #include <sys/wait.h>
+#include <sys/mman.h>
 
 #if defined(__FreeBSD__)
 extern char **environ;
@@ -72,6 +73,12 @@ typedef sig_t sighandler_t;
 #include <stdatomic.h>
 #endif
 
+/* use epoll() instead of select() in the event loop */
+#if defined(__linux__)
+#define USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
 #include "cutils.h"
 #include "list.h"
 #include "quickjs-libc.h"
@@ -88,6 +95,10 @@ typedef struct {
     struct list_head link;
     int fd;
     JSValue rw_func[2];
+#ifdef USE_EPOLL
+    int epoll_events; /* registered events */
+    BOOL always_ready; /* fd not supported by epoll (regular file) */
+#endif
 } JSOSRWHandler;
 
 typedef struct {
@@ -96,13 +107,20 @@ typedef struct {
     JSValue func;
 } JSOSSignalHandler;
 
-typedef struct {
-    struct list_head link;
-    int timer_id;
+typedef struct JSOSTimer {
+    int timer_id; /* -1 if none */
+    int heap_idx; /* position in JSThreadState.timer_heap */
     int64_t timeout;
+    uint64_t seq; /* order of the timers having the same timeout */
+    struct JSOSTimer *hash_next;
     JSValue func;
 } JSOSTimer;
 
+typedef struct {
+    uint8_t *data; /* allocated with malloc(), NULL if received */
+    size_t len;
+} JSWorkerTransfer;
+
 typedef struct {
     struct list_head link;
     uint8_t *data;
@@ -110,6 +128,9 @@ typedef struct {
     /* list of SharedArrayBuffers, necessary to free the message */
     uint8_t **sab_tab;
     size_t sab_tab_len;
+    /* data of the transferred ArrayBuffers */
+    JSWorkerTransfer *transfer_tab;
+    size_t transfer_tab_len;
 } JSWorkerMessage;
 
 typedef struct JSWaker {
@@ -134,6 +155,9 @@ typedef struct {
     struct list_head link;
     JSWorkerMessagePipe *recv_pipe;
     JSValue on_message_func;
+#ifdef USE_EPOLL
+    BOOL epoll_registered;
+#endif
 } JSWorkerMessageHandler;
 
 typedef struct {
@@ -144,14 +168,29 @@ typedef struct {
 
 typedef struct JSThreadState {
     struct list_head os_rw_handlers; /* list of JSOSRWHandler.link */
+    /* handlers indexed by file descriptor */
+    JSOSRWHandler **rw_handler_tab;
+    int rw_handler_tab_size;
     struct list_head os_signal_handlers; /* list JSOSSignalHandler.link */
-    struct list_head os_timers; /* list of JSOSTimer.link */
+    /* binary heap of the timers ordered by timeout */
+    JSOSTimer **timer_heap;
+    int timer_count;
+    int timer_heap_size;
+    uint64_t timer_seq;
+    /* timers indexed by timer_id */
+    JSOSTimer **timer_hash;
+    int timer_hash_size; /* power of two */
+#ifdef USE_EPOLL
+    int epoll_fd;
+    int rw_always_ready_count;
+#endif
     struct list_head port_list; /* list of JSWorkerMessageHandler.link */
     struct list_head rejected_promise_list; /* list of JSRejectedPromiseEntry.link */
     int eval_script_recurse; /* only used in the main thread */
     int next_timer_id; /* for setTimeout() */
     /* not used in the main thread */
     JSWorkerMessagePipe *recv_pipe, *send_pipe;
+    char *bytecode_cache_dir; /* NULL if no bytecode cache */
 } JSThreadState;
 
 static uint64_t os_pending_signals;
@@ -430,6 +469,262 @@ uint8_t *js_load_file(JSContext *ctx, size_t *pbuf_len, const char *filename)
     return buf;
 }
 
+/* Bytecode cache: the compiled code of the scripts and modules is
+   stored in a directory. The file name is a hash of the file name and
+   of the compilation flags, so the entry of a modified source file is
+   replaced instead of being kept. The source code is stored with the
+   bytecode and compared before using it. */
+
+#define BC_CACHE_MAGIC "QJSBCC02"
+
+#ifdef CONFIG_VERSION
+#define BC_CACHE_VERSION CONFIG_VERSION
+#else
+#define BC_CACHE_VERSION "unknown"
+#endif
+
+typedef struct {
+    char magic[8];
+    char version[16]; /* QuickJS version */
+    uint32_t flags; /* eval flags, strip flags and pointer size */
+    uint32_t filename_len;
+    uint64_t source_len;
+    uint64_t bytecode_len;
+    /* followed by the file name, the source code and the bytecode */
+} JSBytecodeCacheHeader;
+
+/* FNV-1a hash */
+static uint64_t bc_cache_hash(uint64_t h, const void *buf, size_t len)
+{
+    const uint8_t *p = buf;
+    size_t i;
+    for(i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3;
+    }
+    return h;
+}
+
+static void bc_cache_init_header(JSContext *ctx, JSBytecodeCacheHeader *hdr,
+                                 size_t buf_len, const char *filename,
+                                 int eval_flags)
+{
+    memset(hdr, 0, sizeof(*hdr));
+    memcpy(hdr->magic, BC_CACHE_MAGIC, sizeof(hdr->magic));
+    pstrcpy(hdr->version, sizeof(hdr->version), BC_CACHE_VERSION);
+    hdr->flags = (eval_flags & 0xffff) |
+        (JS_GetStripInfo(JS_GetRuntime(ctx)) << 16) |
+        (sizeof(void *) << 24);
+    hdr->filename_len = strlen(filename);
+    hdr->source_len = buf_len;
+}
+
+/* return the path of the cache file in 'path' */
+static void bc_cache_get_path(char *path, size_t path_size, const char *dir,
+                              const JSBytecodeCacheHeader *hdr,
+                              const char *filename)
+{
+    uint64_t h;
+    h = bc_cache_hash(0xcbf29ce484222325, hdr,
+                      offsetof(JSBytecodeCacheHeader, source_len));
+    h = bc_cache_hash(h, filename, hdr->filename_len);
+    snprintf(path, path_size, "%s/%016" PRIx64 ".qbc", dir, h);
+}
+
+#if defined(_WIN32)
+
+static uint8_t *bc_cache_map_file(JSContext *ctx, size_t *pbuf_len,
+                                  const char *filename)
+{
+    return js_load_file(ctx, pbuf_len, filename);
+}
+
+static void bc_cache_unmap_file(JSRuntime *rt, uint8_t *buf, size_t buf_len)
+{
+    js_free_rt(rt, buf);
+}
+
+#else
+
+/* the file is mapped so that the pages of the functions which are
+   never called are not read and so that the pages are shared between
+   the processes */
+static uint8_t *bc_cache_map_file(JSContext *ctx, size_t *pbuf_len,
+                                  const char *filename)
+{
+    struct stat st;
+    void *ptr;
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    ptr = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return NULL;
+    *pbuf_len = st.st_size;
+    return ptr;
+}
+
+static void bc_cache_unmap_file(JSRuntime *rt, uint8_t *buf, size_t buf_len)
+{
+    munmap(buf, buf_len);
+}
+
+#endif /* !_WIN32 */
+
+/* the bytecode ends the file */
+static void bc_cache_free_image(JSRuntime *rt, void *opaque,
+                                const uint8_t *buf, size_t buf_len)
+{
+    uint8_t *file_buf = opaque;
+    bc_cache_unmap_file(rt, file_buf, buf + buf_len - file_buf);
+}
+
+/* return JS_UNDEFINED if the cache file is missing or invalid */
+static JSValue bc_cache_load(JSContext *ctx, const char *path,
+                             const JSBytecodeCacheHeader *hdr,
+                             const char *filename,
+                             const char *source, size_t source_len)
+{
+    JSBytecodeCacheHeader hdr1;
+    uint8_t *buf;
+    size_t buf_len, pos;
+    JSValue obj;
+
+    buf = bc_cache_map_file(ctx, &buf_len, path);
+    if (!buf)
+        return JS_UNDEFINED;
+    if (buf_len < sizeof(hdr1))
+        goto invalid;
+    memcpy(&hdr1, buf, sizeof(hdr1));
+    pos = sizeof(hdr1);
+    if (memcmp(&hdr1, hdr, offsetof(JSBytecodeCacheHeader, bytecode_len)) != 0 ||
+        hdr1.filename_len > buf_len - pos ||
+        memcmp(buf + pos, filename, hdr1.filename_len) != 0)
+        goto invalid;
+    pos += hdr1.filename_len;
+    /* the source code must be identical */
+    if (source_len > buf_len - pos ||
+        memcmp(buf + pos, source, source_len) != 0)
+        goto invalid;
+    pos += source_len;
+    if (hdr1.bytecode_len != buf_len - pos)
+        goto invalid;
+    /* the nested functions are read from the file on their first
+       call */
+    obj = JS_ReadObjectImage(ctx, buf + pos, hdr1.bytecode_len,
+                             JS_READ_OBJ_BYTECODE, bc_cache_free_image, buf);
+    if (JS_IsException(obj)) {
+        /* incompatible bytecode: ignore the file */
+        JS_FreeValue(ctx, JS_GetException(ctx));
+        obj = JS_UNDEFINED;
+    }
+    return obj;
+ invalid:
+    bc_cache_unmap_file(JS_GetRuntime(ctx), buf, buf_len);
+    return JS_UNDEFINED;
+}
+
+/* errors are ignored */
+static void bc_cache_store(JSContext *ctx, const char *path,
+                           JSBytecodeCacheHeader *hdr, const char *filename,
+                           const char *source, size_t source_len,
+                           JSValueConst obj)
+{
+    char tmp_path[PATH_MAX];
+    uint8_t *bc_buf;
+    size_t bc_len;
+    FILE *f;
+    BOOL ok;
+
+    bc_buf = JS_WriteObject(ctx, &bc_len, obj, JS_WRITE_OBJ_BYTECODE);
+    if (!bc_buf) {
+        JS_FreeValue(ctx, JS_GetException(ctx));
+        return;
+    }
+    hdr->bytecode_len = bc_len;
+    /* write then rename so that the other processes never read a
+       partial file */
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%d.tmp", path, (int)getpid());
+    f = fopen(tmp_path, "wb");
+    if (f) {
+        ok = (fwrite(hdr, 1, sizeof(*hdr), f) == sizeof(*hdr) &&
+              fwrite(filename, 1, hdr->filename_len, f) == hdr->filename_len &&
+              fwrite(source, 1, source_len, f) == source_len &&
+              fwrite(bc_buf, 1, bc_len, f) == bc_len);
+        if (fclose(f) != 0)
+            ok = FALSE;
+        if (!ok || rename(tmp_path, path) != 0)
+            unlink(tmp_path);
+    }
+    js_free(ctx, bc_buf);
+}
+
+/* Compile a script or a module as JS_Eval() with
+   JS_EVAL_FLAG_COMPILE_ONLY. The bytecode cache is used if it is
+   enabled. */
+JSValue js_std_compile(JSContext *ctx, const char *buf, size_t buf_len,
+                       const char *filename, int eval_flags)
+{
+    JSThreadState *ts = JS_GetRuntimeOpaque(JS_GetRuntime(ctx));
+    JSBytecodeCacheHeader hdr;
+    char path[PATH_MAX];
+    JSValue obj;
+
+    eval_flags |= JS_EVAL_FLAG_COMPILE_ONLY;
+    if (!ts || !ts->bytecode_cache_dir)
+        return JS_Eval(ctx, buf, buf_len, filename, eval_flags);
+
+    bc_cache_init_header(ctx, &hdr, buf_len, filename, eval_flags);
+    bc_cache_get_path(path, sizeof(path), ts->bytecode_cache_dir, &hdr,
+                      filename);
+    obj = bc_cache_load(ctx, path, &hdr, filename, buf, buf_len);
+    if (!JS_IsUndefined(obj)) {
+        if (JS_VALUE_GET_TAG(obj) == JS_TAG_MODULE &&
+            JS_ResolveModule(ctx, obj) < 0) {
+            JS_FreeValue(ctx, obj);
+            return JS_EXCEPTION;
+        }
+        return obj;
+    }
+    obj = JS_Eval(ctx, buf, buf_len, filename, eval_flags);
+    if (!JS_IsException(obj))
+        bc_cache_store(ctx, path, &hdr, filename, buf, buf_len, obj);
+    return obj;
+}
+
+/* Enable the bytecode cache in the directory 'dirname' or disable it
+   if 'dirname' is NULL. The directory is created if needed. Return
+   -1 if error. js_std_init_handlers() must have been called. */
+int js_std_set_bytecode_cache(JSRuntime *rt, const char *dirname)
+{
+    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
+    char *dir;
+
+    dir = NULL;
+    if (dirname) {
+#if defined(_WIN32)
+        mkdir(dirname);
+#else
+        /* the cached bytecode is executed, so the directory must
+           not be writable by the other users */
+        mkdir(dirname, 0700);
+#endif
+        if (access(dirname, W_OK) != 0)
+            return -1;
+        dir = strdup(dirname);
+        if (!dir)
+            return -1;
+    }
+    free(ts->bytecode_cache_dir);
+    ts->bytecode_cache_dir = dir;
+    return 0;
+}
+
 /* load and evaluate a file */
 static JSValue js_loadScript(JSContext *ctx, JSValueConst this_val,
                              int argc, JSValueConst *argv)
@@ -448,11 +743,13 @@ static JSValue js_loadScript(JSContext *ctx, JSValueConst this_val,
         JS_FreeCString(ctx, filename);
         return JS_EXCEPTION;
     }
-    ret = JS_Eval(ctx, (char *)buf, buf_len, filename,
-                  JS_EVAL_TYPE_GLOBAL);
+    ret = js_std_compile(ctx, (char *)buf, buf_len, filename,
+                         JS_EVAL_TYPE_GLOBAL);
     js_free(ctx, buf);
     JS_FreeCString(ctx, filename);
-    return ret;
+    if (JS_IsException(ret))
+        return ret;
+    return JS_EvalFunction(ctx, ret);
 }
 
 /* load a file as a UTF-8 encoded string */
@@ -712,8 +1009,8 @@ JSModuleDef *js_module_loader(JSContext *ctx,
         } else {
             JSValue func_val;
             /* compile the module */
-            func_val = JS_Eval(ctx, (char *)buf, buf_len, module_name,
-                               JS_EVAL_TYPE_MODULE | JS_EVAL_FLAG_COMPILE_ONLY);
+            func_val = js_std_compile(ctx, (char *)buf, buf_len, module_name,
+                                      JS_EVAL_TYPE_MODULE);
             js_free(ctx, buf);
             if (JS_IsException(func_val))
                 return NULL;
@@ -850,6 +1147,65 @@ static JSValue js_std_gc(JSContext *ctx, JSValueConst this_val,
     return JS_UNDEFINED;
 }
 
+static JSValue js_std_getMemoryUsage(JSContext *ctx, JSValueConst this_val,
+                                     int argc, JSValueConst *argv)
+{
+    static const struct {
+        char name[32];
+        uint16_t offset;
+    } fields[] = {
+#define DEF(x) { #x, offsetof(JSMemoryUsage, x) }
+        DEF(malloc_size), DEF(malloc_limit), DEF(memory_used_size),
+        DEF(malloc_count), DEF(memory_used_count),
+        DEF(atom_count), DEF(atom_size), DEF(str_count), DEF(str_size),
+        DEF(obj_count), DEF(obj_size), DEF(prop_count), DEF(prop_size),
+        DEF(inline_prop_count), DEF(inline_prop_size),
+        DEF(shape_count), DEF(shape_size),
+        DEF(shape_transition_count), DEF(shape_transition_max_fan_out),
+        DEF(js_func_count), DEF(js_func_size), DEF(js_func_code_size),
+        DEF(js_func_pc2line_count), DEF(js_func_pc2line_size),
+        DEF(js_func_lazy_count), DEF(js_func_lazy_compiled_count),
+        DEF(c_func_count), DEF(array_count),
+        DEF(fast_array_count), DEF(fast_array_elements), DEF(fast_array_size),
+        DEF(binary_object_count), DEF(binary_object_size),
+        DEF(regexp_cache_count), DEF(regexp_cache_size),
+        DEF(regexp_cache_hit_count), DEF(regexp_cache_miss_count),
+        DEF(regexp_nfa_count),
+        DEF(nursery_size), DEF(nursery_used_chunks),
+        DEF(slab_arena_count), DEF(slab_arena_size),
+        DEF(slab_used_count), DEF(slab_used_size),
+#undef DEF
+    };
+    JSMemoryUsage stats;
+    JSValue obj;
+    int i;
+
+    JS_ComputeMemoryUsage(JS_GetRuntime(ctx), &stats);
+    obj = JS_NewObject(ctx);
+    if (JS_IsException(obj))
+        return obj;
+    for(i = 0; i < countof(fields); i++) {
+        int64_t v = *(int64_t *)((uint8_t *)&stats + fields[i].offset);
+        if (JS_DefinePropertyValueStr(ctx, obj, fields[i].name,
+                                      JS_NewInt64(ctx, v),
+                                      JS_PROP_C_W_E) < 0) {
+            JS_FreeValue(ctx, obj);
+            return JS_EXCEPTION;
+        }
+    }
+    return obj;
+}
+
+static JSValue js_std_gcStep(JSContext *ctx, JSValueConst this_val,
+                             int argc, JSValueConst *argv)
+{
+    int64_t budget;
+    if (JS_ToInt64(ctx, &budget, argv[0]))
+        return JS_EXCEPTION;
+    JS_RunGCStep(JS_GetRuntime(ctx), budget);
+    return JS_UNDEFINED;
+}
+
 static int interrupt_handler(JSRuntime *rt, void *opaque)
 {
     return (os_pending_signals >> SIGINT) & 1;
@@ -972,6 +1328,161 @@ static JSValue js_std_parseExtJSON(JSContext *ctx, JSValueConst this_val,
     return obj;
 }
 
+/* JSONParser class */
+
+typedef struct {
+    JSJSONParser *parser;
+    JSValue func;
+} JSSTDJSONParser;
+
+static JSClassID js_std_json_parser_class_id;
+
+static void js_std_json_parser_finalizer(JSRuntime *rt, JSValue val)
+{
+    JSSTDJSONParser *s = JS_GetOpaque(val, js_std_json_parser_class_id);
+    if (s) {
+        if (s->parser)
+            JS_FreeJSONParser(s->parser);
+        JS_FreeValueRT(rt, s->func);
+        js_free_rt(rt, s);
+    }
+}
+
+static void js_std_json_parser_mark(JSRuntime *rt, JSValueConst val,
+                                    JS_MarkFunc *mark_func)
+{
+    JSSTDJSONParser *s = JS_GetOpaque(val, js_std_json_parser_class_id);
+    if (s) {
+        JS_MarkValue(rt, s->func, mark_func);
+    }
+}
+
+static int js_std_json_parser_func(JSContext *ctx, JSValueConst key,
+                                   JSValueConst val, void *opaque)
+{
+    JSSTDJSONParser *s = opaque;
+    JSValueConst args[2];
+    JSValue ret;
+
+    args[0] = val;
+    args[1] = key;
+    ret = JS_Call(ctx, s->func, JS_UNDEFINED, 2, args);
+    if (JS_IsException(ret))
+        return -1;
+    JS_FreeValue(ctx, ret);
+    return 0;
+}
+
+static JSValue js_std_json_parser_ctor(JSContext *ctx, JSValueConst new_target,
+                                       int argc, JSValueConst *argv)
+{
+    JSValue obj = JS_UNDEFINED, proto, val;
+    JSSTDJSONParser *s;
+    BOOL multi = FALSE;
+    int depth = 0;
+
+    if (!JS_IsFunction(ctx, argv[0]))
+        return JS_ThrowTypeError(ctx, "not a function");
+    if (argc >= 2 && !JS_IsUndefined(argv[1])) {
+        val = JS_GetPropertyStr(ctx, argv[1], "depth");
+        if (JS_IsException(val))
+            return JS_EXCEPTION;
+        if (!JS_IsUndefined(val)) {
+            if (JS_ToInt32(ctx, &depth, val)) {
+                JS_FreeValue(ctx, val);
+                return JS_EXCEPTION;
+            }
+        }
+        JS_FreeValue(ctx, val);
+        if (get_bool_option(ctx, &multi, argv[1], "multi"))
+            return JS_EXCEPTION;
+    }
+
+    proto = JS_GetPropertyStr(ctx, new_target, "prototype");
+    if (JS_IsException(proto))
+        goto fail;
+    obj = JS_NewObjectProtoClass(ctx, proto, js_std_json_parser_class_id);
+    JS_FreeValue(ctx, proto);
+    if (JS_IsException(obj))
+        goto fail;
+    s = js_mallocz(ctx, sizeof(*s));
+    if (!s)
+        goto fail;
+    s->func = JS_DupValue(ctx, argv[0]);
+    JS_SetOpaque(obj, s);
+    s->parser = JS_NewJSONParser(ctx, depth,
+                                 multi ? JS_JSON_PARSER_MULTI : 0,
+                                 js_std_json_parser_func, s);
+    if (!s->parser)
+        goto fail;
+    return obj;
+ fail:
+    JS_FreeValue(ctx, obj);
+    return JS_EXCEPTION;
+}
+
+/* feed(str) or feed(buffer, position = 0, length = buffer.byteLength - position) */
+static JSValue js_std_json_parser_feed(JSContext *ctx, JSValueConst this_val,
+                                       int argc, JSValueConst *argv)
+{
+    JSSTDJSONParser *s = JS_GetOpaque2(ctx, this_val, js_std_json_parser_class_id);
+    const char *str;
+    uint8_t *buf, *copy;
+    uint64_t pos, len;
+    size_t size;
+    int ret;
+    BOOL has_len;
+
+    if (!s)
+        return JS_EXCEPTION;
+    if (JS_IsString(argv[0])) {
+        str = JS_ToCStringLen(ctx, &size, argv[0]);
+        if (!str)
+            return JS_EXCEPTION;
+        ret = JS_JSONParserFeed(s->parser, (const uint8_t *)str, size);
+        JS_FreeCString(ctx, str);
+    } else {
+        /* the conversions may detach the buffer, so they are done
+           before getting its address */
+        pos = 0;
+        if (argc >= 2 && JS_ToIndex(ctx, &pos, argv[1]))
+            return JS_EXCEPTION;
+        has_len = (argc >= 3 && !JS_IsUndefined(argv[2]));
+        if (has_len && JS_ToIndex(ctx, &len, argv[2]))
+            return JS_EXCEPTION;
+        buf = JS_GetArrayBuffer(ctx, &size, argv[0]);
+        if (!buf)
+            return JS_EXCEPTION;
+        if (pos > size)
+            return JS_ThrowRangeError(ctx, "feed array buffer overflow");
+        if (!has_len)
+            len = size - pos;
+        if (pos + len > size)
+            return JS_ThrowRangeError(ctx, "feed array buffer overflow");
+        /* the callback may also detach the buffer while parsing */
+        copy = js_malloc(ctx, len + 1);
+        if (!copy)
+            return JS_EXCEPTION;
+        memcpy(copy, buf + pos, len);
+        ret = JS_JSONParserFeed(s->parser, copy, len);
+        js_free(ctx, copy);
+    }
+    if (ret < 0)
+        return JS_EXCEPTION;
+    return JS_UNDEFINED;
+}
+
+static JSValue js_std_json_parser_end(JSContext *ctx, JSValueConst this_val,
+                                      int argc, JSValueConst *argv)
+{
+    JSSTDJSONParser *s = JS_GetOpaque2(ctx, this_val, js_std_json_parser_class_id);
+    if (!s)
+        return JS_EXCEPTION;
+    if (JS_JSONParserEnd(s->parser) < 0)
+        return JS_EXCEPTION;
+    return JS_UNDEFINED;
+}
+
 static JSValue js_new_std_file(JSContext *ctx, FILE *f,
                                BOOL close_in_finalizer,
                                BOOL is_popen)
@@ -1620,6 +2131,12 @@ static JSClassDef js_std_file_class = {
     .finalizer = js_std_file_finalizer,
 };
 
+static JSClassDef js_std_json_parser_class = {
+    "JSONParser",
+    .finalizer = js_std_json_parser_finalizer,
+    .gc_mark = js_std_json_parser_mark,
+};
+
 static const JSCFunctionListEntry js_std_error_props[] = {
     /* various errno values */
 #define DEF(x) JS_PROP_INT32_DEF(#x, x, JS_PROP_CONFIGURABLE )
@@ -1640,6 +2157,8 @@ static const JSCFunctionListEntry js_std_error_props[] = {
 static const JSCFunctionListEntry js_std_funcs[] = {
     JS_CFUNC_DEF("exit", 1, js_std_exit ),
     JS_CFUNC_DEF("gc", 0, js_std_gc ),
+    JS_CFUNC_DEF("gcStep", 1, js_std_gcStep ),
+    JS_CFUNC_DEF("getMemoryUsage", 0, js_std_getMemoryUsage ),
     JS_CFUNC_DEF("evalScript", 1, js_evalScript ),
     JS_CFUNC_DEF("loadScript", 1, js_loadScript ),
     JS_CFUNC_DEF("getenv", 1, js_std_getenv ),
@@ -1687,9 +2206,15 @@ static const JSCFunctionListEntry js_std_file_proto_funcs[] = {
     /* setvbuf, ...  */
 };
 
+static const JSCFunctionListEntry js_std_json_parser_proto_funcs[] = {
+    JS_CFUNC_DEF("feed", 1, js_std_json_parser_feed ),
+    JS_CFUNC_DEF("end", 0, js_std_json_parser_end ),
+    JS_PROP_STRING_DEF("[Symbol.toStringTag]", "JSONParser", JS_PROP_CONFIGURABLE ),
+};
+
 static int js_std_init(JSContext *ctx, JSModuleDef *m)
 {
-    JSValue proto;
+    JSValue proto, obj;
 
     /* FILE class */
     /* the class ID is created once */
@@ -1701,6 +2226,19 @@ static int js_std_init(JSContext *ctx, JSModuleDef *m)
                                countof(js_std_file_proto_funcs));
     JS_SetClassProto(ctx, js_std_file_class_id, proto);
 
+    /* JSONParser class */
+    JS_NewClassID(&js_std_json_parser_class_id);
+    JS_NewClass(JS_GetRuntime(ctx), js_std_json_parser_class_id,
+                &js_std_json_parser_class);
+    proto = JS_NewObject(ctx);
+    JS_SetPropertyFunctionList(ctx, proto, js_std_json_parser_proto_funcs,
+                               countof(js_std_json_parser_proto_funcs));
+    obj = JS_NewCFunction2(ctx, js_std_json_parser_ctor, "JSONParser", 2,
+                           JS_CFUNC_constructor, 0);
+    JS_SetConstructor(ctx, obj, proto);
+    JS_SetClassProto(ctx, js_std_json_parser_class_id, proto);
+    JS_SetModuleExport(ctx, m, "JSONParser", obj);
+
     JS_SetModuleExportList(ctx, m, js_std_funcs,
                            countof(js_std_funcs));
     JS_SetModuleExport(ctx, m, "in", js_new_std_file(ctx, stdin, FALSE, FALSE));
@@ -1719,6 +2257,7 @@ JSModuleDef *js_init_module_std(JSContext *ctx, const char *module_name)
     JS_AddModuleExport(ctx, m, "in");
     JS_AddModuleExport(ctx, m, "out");
     JS_AddModuleExport(ctx, m, "err");
+    JS_AddModuleExport(ctx, m, "JSONParser");
     return m;
 }
 
@@ -1983,24 +2522,71 @@ static BOOL is_main_thread(JSRuntime *rt)
 
 static JSOSRWHandler *find_rh(JSThreadState *ts, int fd)
 {
-    JSOSRWHandler *rh;
-    struct list_head *el;
+    if (fd < 0 || fd >= ts->rw_handler_tab_size)
+        return NULL;
+    return ts->rw_handler_tab[fd];
+}
 
-    list_for_each(el, &ts->os_rw_handlers) {
-        rh = list_entry(el, JSOSRWHandler, link);
-        if (rh->fd == fd)
-            return rh;
+#ifdef USE_EPOLL
+/* update the epoll registration of 'rh' after its functions changed */
+static void js_os_epoll_update(JSThreadState *ts, JSOSRWHandler *rh)
+{
+    struct epoll_event ev;
+    int events, op, ret;
+
+    events = 0;
+    if (!JS_IsNull(rh->rw_func[0]))
+        events |= EPOLLIN;
+    if (!JS_IsNull(rh->rw_func[1]))
+        events |= EPOLLOUT;
+    if (rh->always_ready || events == rh->epoll_events)
+        return;
+    if (events == 0)
+        op = EPOLL_CTL_DEL;
+    else if (rh->epoll_events == 0)
+        op = EPOLL_CTL_ADD;
+    else
+        op = EPOLL_CTL_MOD;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.u64 = rh->fd;
+    ret = epoll_ctl(ts->epoll_fd, op, rh->fd, &ev);
+    if (ret < 0) {
+        /* the file descriptor may have been closed and reopened
+           since the last update */
+        if (errno == ENOENT && op == EPOLL_CTL_MOD)
+            ret = epoll_ctl(ts->epoll_fd, EPOLL_CTL_ADD, rh->fd, &ev);
+        else if (errno == EEXIST && op == EPOLL_CTL_ADD)
+            ret = epoll_ctl(ts->epoll_fd, EPOLL_CTL_MOD, rh->fd, &ev);
     }
-    return NULL;
+    if (ret < 0 && op != EPOLL_CTL_DEL) {
+        if (errno == EPERM) {
+            /* regular files are always ready, as with select() */
+            rh->always_ready = TRUE;
+            ts->rw_always_ready_count++;
+        }
+        events = 0;
+    }
+    rh->epoll_events = events;
 }
+#endif
 
 static void free_rw_handler(JSRuntime *rt, JSOSRWHandler *rh)
 {
+    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
     int i;
-    list_del(&rh->link);
+
     for(i = 0; i < 2; i++) {
         JS_FreeValueRT(rt, rh->rw_func[i]);
+        rh->rw_func[i] = JS_NULL;
     }
+#ifdef USE_EPOLL
+    js_os_epoll_update(ts, rh);
+    if (rh->always_ready)
+        ts->rw_always_ready_count--;
+#endif
+    ts->rw_handler_tab[rh->fd] = NULL;
+    list_del(&rh->link);
     js_free_rt(rt, rh);
 }
 
@@ -2025,13 +2611,32 @@ static JSValue js_os_setReadHandler(JSContext *ctx, JSValueConst this_val,
                 JS_IsNull(rh->rw_func[1])) {
                 /* remove the entry */
                 free_rw_handler(JS_GetRuntime(ctx), rh);
+            } else {
+#ifdef USE_EPOLL
+                js_os_epoll_update(ts, rh);
+#endif
             }
         }
     } else {
         if (!JS_IsFunction(ctx, func))
             return JS_ThrowTypeError(ctx, "not a function");
+        if (fd < 0)
+            return JS_ThrowRangeError(ctx, "invalid file descriptor");
         rh = find_rh(ts, fd);
         if (!rh) {
+            if (fd >= ts->rw_handler_tab_size) {
+                JSOSRWHandler **new_tab;
+                int new_size;
+                new_size = max_int(fd + 1, ts->rw_handler_tab_size * 3 / 2);
+                new_tab = js_realloc(ctx, ts->rw_handler_tab,
+                                     sizeof(new_tab[0]) * new_size);
+                if (!new_tab)
+                    return JS_EXCEPTION;
+                memset(new_tab + ts->rw_handler_tab_size, 0,
+                       sizeof(new_tab[0]) * (new_size - ts->rw_handler_tab_size));
+                ts->rw_handler_tab = new_tab;
+                ts->rw_handler_tab_size = new_size;
+            }
             rh = js_mallocz(ctx, sizeof(*rh));
             if (!rh)
                 return JS_EXCEPTION;
@@ -2039,9 +2644,13 @@ static JSValue js_os_setReadHandler(JSContext *ctx, JSValueConst this_val,
             rh->rw_func[0] = JS_NULL;
             rh->rw_func[1] = JS_NULL;
             list_add_tail(&rh->link, &ts->os_rw_handlers);
+            ts->rw_handler_tab[fd] = rh;
         }
         JS_FreeValue(ctx, rh->rw_func[magic]);
         rh->rw_func[magic] = JS_DupValue(ctx, func);
+#ifdef USE_EPOLL
+        js_os_epoll_update(ts, rh);
+#endif
     }
     return JS_UNDEFINED;
 }
@@ -2158,9 +2767,130 @@ static JSValue js_os_now(JSContext *ctx, JSValue this_val,
     return JS_NewFloat64(ctx, (double)get_time_ns() / 1e6);
 }
 
+static inline BOOL timer_lt(const JSOSTimer *a, const JSOSTimer *b)
+{
+    return a->timeout < b->timeout ||
+        (a->timeout == b->timeout && a->seq < b->seq);
+}
+
+static inline void timer_heap_set(JSThreadState *ts, int idx, JSOSTimer *th)
+{
+    ts->timer_heap[idx] = th;
+    th->heap_idx = idx;
+}
+
+static void timer_heap_up(JSThreadState *ts, int idx)
+{
+    JSOSTimer *th = ts->timer_heap[idx];
+    int parent;
+
+    while (idx > 0) {
+        parent = (idx - 1) / 2;
+        if (!timer_lt(th, ts->timer_heap[parent]))
+            break;
+        timer_heap_set(ts, idx, ts->timer_heap[parent]);
+        idx = parent;
+    }
+    timer_heap_set(ts, idx, th);
+}
+
+static void timer_heap_down(JSThreadState *ts, int idx)
+{
+    JSOSTimer *th = ts->timer_heap[idx];
+    int child;
+
+    for(;;) {
+        child = 2 * idx + 1;
+        if (child >= ts->timer_count)
+            break;
+        if (child + 1 < ts->timer_count &&
+            timer_lt(ts->timer_heap[child + 1], ts->timer_heap[child]))
+            child++;
+        if (!timer_lt(ts->timer_heap[child], th))
+            break;
+        timer_heap_set(ts, idx, ts->timer_heap[child]);
+        idx = child;
+    }
+    timer_heap_set(ts, idx, th);
+}
+
+static int timer_hash_resize(JSContext *ctx, JSThreadState *ts, int new_size)
+{
+    JSOSTimer **new_hash, *th, *th_next;
+    int i, h;
+
+    new_hash = js_mallocz(ctx, sizeof(new_hash[0]) * new_size);
+    if (!new_hash)
+        return -1;
+    for(i = 0; i < ts->timer_hash_size; i++) {
+        for(th = ts->timer_hash[i]; th != NULL; th = th_next) {
+            th_next = th->hash_next;
+            h = th->timer_id & (new_size - 1);
+            th->hash_next = new_hash[h];
+            new_hash[h] = th;
+        }
+    }
+    js_free(ctx, ts->timer_hash);
+    ts->timer_hash = new_hash;
+    ts->timer_hash_size = new_size;
+    return 0;
+}
+
+/* 'th' is freed in case of error */
+static int add_timer(JSContext *ctx, JSOSTimer *th, int64_t delay)
+{
+    JSThreadState *ts = JS_GetRuntimeOpaque(JS_GetRuntime(ctx));
+    int h;
+
+    if (ts->timer_count >= ts->timer_heap_size) {
+        JSOSTimer **new_heap;
+        int new_size;
+        new_size = max_int(16, ts->timer_heap_size * 3 / 2);
+        new_heap = js_realloc(ctx, ts->timer_heap,
+                              sizeof(new_heap[0]) * new_size);
+        if (!new_heap)
+            goto fail;
+        ts->timer_heap = new_heap;
+        ts->timer_heap_size = new_size;
+    }
+    if (th->timer_id > 0) {
+        if (ts->timer_count >= ts->timer_hash_size &&
+            timer_hash_resize(ctx, ts, max_int(16, ts->timer_hash_size * 2)))
+            goto fail;
+        h = th->timer_id & (ts->timer_hash_size - 1);
+        th->hash_next = ts->timer_hash[h];
+        ts->timer_hash[h] = th;
+    }
+    th->timeout = get_time_ms() + delay;
+    th->seq = ts->timer_seq++;
+    timer_heap_set(ts, ts->timer_count++, th);
+    timer_heap_up(ts, th->heap_idx);
+    return 0;
+ fail:
+    JS_FreeValue(ctx, th->func);
+    js_free(ctx, th);
+    return -1;
+}
+
 static void free_timer(JSRuntime *rt, JSOSTimer *th)
 {
-    list_del(&th->link);
+    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
+    JSOSTimer **pth, *last;
+    int idx;
+
+    if (th->timer_id > 0) {
+        pth = &ts->timer_hash[th->timer_id & (ts->timer_hash_size - 1)];
+        while (*pth != th)
+            pth = &(*pth)->hash_next;
+        *pth = th->hash_next;
+    }
+    idx = th->heap_idx;
+    last = ts->timer_heap[--ts->timer_count];
+    if (last != th) {
+        timer_heap_set(ts, idx, last);
+        timer_heap_up(ts, idx);
+        timer_heap_down(ts, last->heap_idx);
+    }
     JS_FreeValueRT(rt, th->func);
     js_free_rt(rt, th);
 }
@@ -2187,23 +2917,21 @@ static JSValue js_os_setTimeout(JSContext *ctx, JSValueConst this_val,
         ts->next_timer_id = 1;
     else
         ts->next_timer_id++;
-    th->timeout = get_time_ms() + delay;
     th->func = JS_DupValue(ctx, func);
-    list_add_tail(&th->link, &ts->os_timers);
+    if (add_timer(ctx, th, delay))
+        return JS_EXCEPTION;
     return JS_NewInt32(ctx, th->timer_id);
 }
 
 static JSOSTimer *find_timer_by_id(JSThreadState *ts, int timer_id)
 {
-    struct list_head *el;
-    if (timer_id <= 0)
+    JSOSTimer *th;
+    if (timer_id <= 0 || ts->timer_hash_size == 0)
         return NULL;
-    list_for_each(el, &ts->os_timers) {
-        JSOSTimer *th = list_entry(el, JSOSTimer, link);
-        if (th->timer_id == timer_id)
-            return th;
-    }
-    return NULL;
+    th = ts->timer_hash[timer_id & (ts->timer_hash_size - 1)];
+    while (th != NULL && th->timer_id != timer_id)
+        th = th->hash_next;
+    return th;
 }
 
 static JSValue js_os_clearTimeout(JSContext *ctx, JSValueConst this_val,
@@ -2227,8 +2955,6 @@ static JSValue js_os_clearTimeout(JSContext *ctx, JSValueConst this_val,
 static JSValue js_os_sleepAsync(JSContext *ctx, JSValueConst this_val,
                                 int argc, JSValueConst *argv)
 {
-    JSRuntime *rt = JS_GetRuntime(ctx);
-    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
     int64_t delay;
     JSOSTimer *th;
     JSValue promise, resolving_funcs[2];
@@ -2247,11 +2973,13 @@ static JSValue js_os_sleepAsync(JSContext *ctx, JSValueConst this_val,
         return JS_EXCEPTION;
     }
     th->timer_id = -1;
-    th->timeout = get_time_ms() + delay;
     th->func = JS_DupValue(ctx, resolving_funcs[0]);
-    list_add_tail(&th->link, &ts->os_timers);
     JS_FreeValue(ctx, resolving_funcs[0]);
     JS_FreeValue(ctx, resolving_funcs[1]);
+    if (add_timer(ctx, th, delay)) {
+        JS_FreeValue(ctx, promise);
+        return JS_EXCEPTION;
+    }
     return promise;
 }
 
@@ -2268,6 +2996,64 @@ static void call_handler(JSContext *ctx, JSValueConst func)
     JS_FreeValue(ctx, ret);
 }
 
+static void js_std_run_jobs(JSContext *ctx)
+{
+    int err;
+
+    for(;;) {
+        err = JS_ExecutePendingJob(JS_GetRuntime(ctx), NULL);
+        if (err <= 0) {
+            if (err < 0)
+                js_std_dump_error(ctx);
+            break;
+        }
+    }
+}
+
+/* Call all the expired timers. The pending jobs are executed between
+   two calls as if each timer was handled by a separate js_os_poll()
+   call. Return TRUE if at least one timer was called. '*pmin_delay'
+   is set to the delay in ms until the next timer or to -1 if none. */
+static BOOL js_os_run_timers(JSContext *ctx, int *pmin_delay)
+{
+    JSRuntime *rt = JS_GetRuntime(ctx);
+    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
+    int64_t cur_time, delay;
+    uint64_t seq_end;
+    JSOSTimer *th;
+    JSValue func;
+    BOOL called = FALSE;
+
+    if (ts->timer_count == 0) {
+        *pmin_delay = -1;
+        return FALSE;
+    }
+    cur_time = get_time_ms();
+    /* the timers added by the callbacks are called later */
+    seq_end = ts->timer_seq;
+    while (ts->timer_count != 0) {
+        th = ts->timer_heap[0];
+        if (th->timeout > cur_time || th->seq >= seq_end)
+            break;
+        /* the timer expired */
+        func = th->func;
+        th->func = JS_UNDEFINED;
+        free_timer(rt, th);
+        if (called)
+            js_std_run_jobs(ctx);
+        call_handler(ctx, func);
+        JS_FreeValue(ctx, func);
+        called = TRUE;
+    }
+    if (ts->timer_count == 0) {
+        *pmin_delay = -1;
+    } else {
+        delay = ts->timer_heap[0]->timeout - get_time_ms();
+        *pmin_delay = max_int(min_int(delay, INT32_MAX), 0);
+    }
+    return called;
+}
+
 #ifdef USE_WORKER
 
 #ifdef _WIN32
@@ -2346,6 +3132,39 @@ static void js_waker_close(JSWaker *w)
 
 static void js_free_message(JSWorkerMessage *msg);
 
+static JSValue js_read_message(JSContext *ctx, JSWorkerMessage *msg)
+{
+    JSValue *transfer_tab, obj;
+    size_t i, n;
+
+    n = msg->transfer_tab_len;
+    transfer_tab = NULL;
+    if (n > 0) {
+        transfer_tab = js_mallocz(ctx, sizeof(transfer_tab[0]) * n);
+        if (!transfer_tab)
+            return JS_EXCEPTION;
+        for(i = 0; i < n; i++) {
+            /* the receiving runtime takes the ownership of the data */
+            transfer_tab[i] =
+                JS_NewTransferredArrayBuffer(ctx, msg->transfer_tab[i].data,
+                                             msg->transfer_tab[i].len);
+            msg->transfer_tab[i].data = NULL;
+            if (JS_IsException(transfer_tab[i])) {
+                obj = JS_EXCEPTION;
+                goto done;
+            }
+        }
+    }
+    obj = JS_ReadObject2(ctx, msg->data, msg->data_len,
+                         JS_READ_OBJ_SAB | JS_READ_OBJ_REFERENCE,
+                         (JSValueConst *)transfer_tab, n);
+ done:
+    for(i = 0; i < n; i++)
+        JS_FreeValue(ctx, transfer_tab[i]);
+    js_free(ctx, transfer_tab);
+    return obj;
+}
+
 /* return 1 if a message was handled, 0 if no message */
 static int handle_posted_message(JSRuntime *rt, JSContext *ctx,
                                  JSWorkerMessageHandler *port)
@@ -2369,8 +3188,7 @@ static int handle_posted_message(JSRuntime *rt, JSContext *ctx,
 
         pthread_mutex_unlock(&ps->mutex);
 
-        data_obj = JS_ReadObject(ctx, msg->data, msg->data_len,
-                                 JS_READ_OBJ_SAB | JS_READ_OBJ_REFERENCE);
+        data_obj = js_read_message(ctx, msg);
 
         js_free_message(msg);
 
@@ -2417,40 +3235,19 @@ static int js_os_poll(JSContext *ctx)
     JSRuntime *rt = JS_GetRuntime(ctx);
     JSThreadState *ts = JS_GetRuntimeOpaque(rt);
     int min_delay, count;
-    int64_t cur_time, delay;
     JSOSRWHandler *rh;
     struct list_head *el;
     HANDLE handles[MAXIMUM_WAIT_OBJECTS]; // 64
 
     /* XXX: handle signals if useful */
 
-    if (list_empty(&ts->os_rw_handlers) && list_empty(&ts->os_timers) &&
+    if (list_empty(&ts->os_rw_handlers) && ts->timer_count == 0 &&
         list_empty(&ts->port_list)) {
         return -1; /* no more events */
     }
     
-    if (!list_empty(&ts->os_timers)) {
-        cur_time = get_time_ms();
-        min_delay = 10000;
-        list_for_each(el, &ts->os_timers) {
-            JSOSTimer *th = list_entry(el, JSOSTimer, link);
-            delay = th->timeout - cur_time;
-            if (delay <= 0) {
-                JSValue func;
-                /* the timer expired */
-                func = th->func;
-                th->func = JS_UNDEFINED;
-                free_timer(rt, th);
-                call_handler(ctx, func);
-                JS_FreeValue(ctx, func);
-                return 0;
-            } else if (delay < min_delay) {
-                min_delay = delay;
-            }
-        }
-    } else {
-        min_delay = -1;
-    }
+    if (js_os_run_timers(ctx, &min_delay))
+        return 0;
 
     count = 0;
     list_for_each(el, &ts->os_rw_handlers) {
@@ -2507,57 +3304,176 @@ static int js_os_poll(JSContext *ctx)
 
 #else
 
-static int js_os_poll(JSContext *ctx)
+/* return TRUE if a signal handler was called */
+static BOOL js_os_handle_signals(JSContext *ctx)
 {
     JSRuntime *rt = JS_GetRuntime(ctx);
     JSThreadState *ts = JS_GetRuntimeOpaque(rt);
-    int ret, fd_max, min_delay;
-    int64_t cur_time, delay;
-    fd_set rfds, wfds;
-    JSOSRWHandler *rh;
+    JSOSSignalHandler *sh;
     struct list_head *el;
-    struct timeval tv, *tvp;
+    uint64_t mask;
 
     /* only check signals in the main thread */
     if (!ts->recv_pipe &&
         unlikely(os_pending_signals != 0)) {
-        JSOSSignalHandler *sh;
-        uint64_t mask;
-
         list_for_each(el, &ts->os_signal_handlers) {
             sh = list_entry(el, JSOSSignalHandler, link);
             mask = (uint64_t)1 << sh->sig_num;
             if (os_pending_signals & mask) {
                 os_pending_signals &= ~mask;
                 call_handler(ctx, sh->func);
-                return 0;
+                return TRUE;
             }
         }
     }
+    return FALSE;
+}
+
+#if defined(USE_EPOLL)
+
+static JSWorkerMessageHandler *find_port(JSThreadState *ts, int fd)
+{
+    JSWorkerMessageHandler *port;
+    struct list_head *el;
+
+    list_for_each(el, &ts->port_list) {
+        port = list_entry(el, JSWorkerMessageHandler, link);
+        if (port->recv_pipe->waker.read_fd == fd)
+            return port;
+    }
+    return NULL;
+}
+
+/* the ports are identified by this bit in the epoll event data */
+#define JS_EPOLL_PORT ((uint64_t)1 << 32)
 
-    if (list_empty(&ts->os_rw_handlers) && list_empty(&ts->os_timers) &&
+#define JS_EPOLL_MAX_EVENTS 256
+
+/* All the ready events are handled. The pending jobs are executed
+   between two calls. */
+static int js_os_poll(JSContext *ctx)
+{
+    JSRuntime *rt = JS_GetRuntime(ctx);
+    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
+    struct epoll_event events[JS_EPOLL_MAX_EVENTS], ev;
+    int i, n, fd, timeout;
+    BOOL called;
+    JSOSRWHandler *rh;
+    JSWorkerMessageHandler *port;
+    struct list_head *el;
+    uint64_t data;
+
+    if (js_os_handle_signals(ctx))
+        return 0;
+
+    if (list_empty(&ts->os_rw_handlers) && ts->timer_count == 0 &&
         list_empty(&ts->port_list))
         return -1; /* no more events */
 
-    if (!list_empty(&ts->os_timers)) {
-        cur_time = get_time_ms();
-        min_delay = 10000;
-        list_for_each(el, &ts->os_timers) {
-            JSOSTimer *th = list_entry(el, JSOSTimer, link);
-            delay = th->timeout - cur_time;
-            if (delay <= 0) {
-                JSValue func;
-                /* the timer expired */
-                func = th->func;
-                th->func = JS_UNDEFINED;
-                free_timer(rt, th);
-                call_handler(ctx, func);
-                JS_FreeValue(ctx, func);
-                return 0;
-            } else if (delay < min_delay) {
-                min_delay = delay;
+    if (js_os_run_timers(ctx, &timeout))
+        return 0;
+
+    list_for_each(el, &ts->port_list) {
+        port = list_entry(el, JSWorkerMessageHandler, link);
+        if (!port->epoll_registered && !JS_IsNull(port->on_message_func)) {
+            memset(&ev, 0, sizeof(ev));
+            ev.events = EPOLLIN;
+            ev.data.u64 = JS_EPOLL_PORT | port->recv_pipe->waker.read_fd;
+            if (epoll_ctl(ts->epoll_fd, EPOLL_CTL_ADD,
+                          port->recv_pipe->waker.read_fd, &ev) == 0 ||
+                errno == EEXIST)
+                port->epoll_registered = TRUE;
+        }
+    }
+
+    if (ts->rw_always_ready_count != 0)
+        timeout = 0;
+
+    /* use the idle time for an incremental GC step */
+    if (JS_GetGCMaxPause(rt) != 0)
+        JS_RunGCStep(rt, JS_GetGCMaxPause(rt));
+
+    n = epoll_wait(ts->epoll_fd, events, countof(events), timeout);
+    called = FALSE;
+    for(i = 0; i < n; i++) {
+        data = events[i].data.u64;
+        fd = (int)(uint32_t)data;
+        /* the handlers may have been modified by the previous calls */
+        if (data & JS_EPOLL_PORT) {
+            port = find_port(ts, fd);
+            if (!port) {
+                epoll_ctl(ts->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+                continue;
+            }
+            if (called)
+                js_std_run_jobs(ctx);
+            if (handle_posted_message(rt, ctx, port))
+                called = TRUE;
+            continue;
+        }
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+            rh = find_rh(ts, fd);
+            if (rh && !JS_IsNull(rh->rw_func[0])) {
+                if (called)
+                    js_std_run_jobs(ctx);
+                call_handler(ctx, rh->rw_func[0]);
+                called = TRUE;
+            }
+        }
+        if (events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+            rh = find_rh(ts, fd);
+            if (rh && !JS_IsNull(rh->rw_func[1])) {
+                if (called)
+                    js_std_run_jobs(ctx);
+                call_handler(ctx, rh->rw_func[1]);
+                called = TRUE;
+            }
+        }
+    }
+
+    if (ts->rw_always_ready_count != 0) {
+        /* only the first handler is called because the list may be
+           modified. It is moved to the end for fairness. */
+        list_for_each(el, &ts->os_rw_handlers) {
+            rh = list_entry(el, JSOSRWHandler, link);
+            if (rh->always_ready) {
+                list_del(&rh->link);
+                list_add_tail(&rh->link, &ts->os_rw_handlers);
+                if (called)
+                    js_std_run_jobs(ctx);
+                if (!JS_IsNull(rh->rw_func[0]))
+                    call_handler(ctx, rh->rw_func[0]);
+                else
+                    call_handler(ctx, rh->rw_func[1]);
+                break;
             }
         }
+    }
+    return 0;
+}
+
+#else
+
+static int js_os_poll(JSContext *ctx)
+{
+    JSRuntime *rt = JS_GetRuntime(ctx);
+    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
+    int ret, fd_max, min_delay;
+    fd_set rfds, wfds;
+    JSOSRWHandler *rh;
+    struct list_head *el;
+    struct timeval tv, *tvp;
+
+    if (js_os_handle_signals(ctx))
+        return 0;
+
+    if (list_empty(&ts->os_rw_handlers) && ts->timer_count == 0 &&
+        list_empty(&ts->port_list))
+        return -1; /* no more events */
+
+    if (js_os_run_timers(ctx, &min_delay))
+        return 0;
+    if (min_delay >= 0) {
         tv.tv_sec = min_delay / 1000;
         tv.tv_usec = (min_delay % 1000) * 1000;
         tvp = &tv;
@@ -2586,6 +3502,10 @@ static int js_os_poll(JSContext *ctx)
         }
     }
 
+    /* use the idle time for an incremental GC step */
+    if (JS_GetGCMaxPause(rt) != 0)
+        JS_RunGCStep(rt, JS_GetGCMaxPause(rt));
+
     ret = select(fd_max + 1, &rfds, &wfds, NULL, tvp);
     if (ret > 0) {
         list_for_each(el, &ts->os_rw_handlers) {
@@ -2618,6 +3538,7 @@ static int js_os_poll(JSContext *ctx)
  done:
     return 0;
 }
+#endif /* !USE_EPOLL */
 #endif /* !_WIN32 */
 
 static JSValue make_obj_error(JSContext *ctx,
@@ -3436,6 +4357,7 @@ typedef struct {
     char *basename; /* module base name */
     JSWorkerMessagePipe *recv_pipe, *send_pipe;
     int strip_flags;
+    char *bytecode_cache_dir; /* NULL if no bytecode cache */
 } WorkerFuncArgs;
 
 typedef struct {
@@ -3512,6 +4434,10 @@ static void js_free_message(JSWorkerMessage *msg)
         js_sab_free(NULL, msg->sab_tab[i]);
     }
     free(msg->sab_tab);
+    for(i = 0; i < msg->transfer_tab_len; i++) {
+        free(msg->transfer_tab[i].data);
+    }
+    free(msg->transfer_tab);
     free(msg->data);
     free(msg);
 }
@@ -3541,6 +4467,13 @@ static void js_free_message_pipe(JSWorkerMessagePipe *ps)
 static void js_free_port(JSRuntime *rt, JSWorkerMessageHandler *port)
 {
     if (port) {
+#ifdef USE_EPOLL
+        JSThreadState *ts = JS_GetRuntimeOpaque(rt);
+        if (ts && port->epoll_registered) {
+            epoll_ctl(ts->epoll_fd, EPOLL_CTL_DEL,
+                      port->recv_pipe->waker.read_fd, NULL);
+        }
+#endif
         js_free_message_pipe(port->recv_pipe);
         JS_FreeValueRT(rt, port->on_message_func);
         list_del(&port->link);
@@ -3579,6 +4512,10 @@ static void *worker_func(void *opaque)
     }
     JS_SetStripInfo(rt, args->strip_flags);
     js_std_init_handlers(rt);
+    if (args->bytecode_cache_dir) {
+        js_std_set_bytecode_cache(rt, args->bytecode_cache_dir);
+        free(args->bytecode_cache_dir);
+    }
 
     JS_SetModuleLoaderFunc2(rt, NULL, js_module_loader, js_module_check_attributes, NULL);
 
@@ -3651,6 +4588,7 @@ static JSValue js_worker_ctor(JSContext *ctx, JSValueConst new_target,
                               int argc, JSValueConst *argv)
 {
     JSRuntime *rt = JS_GetRuntime(ctx);
+    JSThreadState *ts = JS_GetRuntimeOpaque(rt);
     WorkerFuncArgs *args = NULL;
     pthread_t tid;
     pthread_attr_t attr;
@@ -3696,7 +4634,12 @@ static JSValue js_worker_ctor(JSContext *ctx, JSValueConst new_target,
         goto oom_fail;
 
     args->strip_flags = JS_GetStripInfo(rt);
-    
+    if (ts->bytecode_cache_dir) {
+        args->bytecode_cache_dir = strdup(ts->bytecode_cache_dir);
+        if (!args->bytecode_cache_dir)
+            goto oom_fail;
+    }
+
     obj = js_worker_ctor_internal(ctx, new_target,
                                   args->send_pipe, args->recv_pipe);
     if (JS_IsException(obj))
@@ -3722,6 +4665,7 @@ static JSValue js_worker_ctor(JSContext *ctx, JSValueConst new_target,
     if (args) {
         free(args->filename);
         free(args->basename);
+        free(args->bytecode_cache_dir);
         js_free_message_pipe(args->recv_pipe);
         js_free_message_pipe(args->send_pipe);
         free(args);
@@ -3730,6 +4674,44 @@ static JSValue js_worker_ctor(JSContext *ctx, JSValueConst new_target,
     return JS_EXCEPTION;
 }
 
+/* get the transfer list of postMessage() */
+static int js_get_transfer_list(JSContext *ctx, JSValue **ptab,
+                                uint32_t *plen, JSValueConst list)
+{
+    JSValue val, *tab;
+    uint32_t i, len;
+
+    *ptab = NULL;
+    *plen = 0;
+    if (JS_IsUndefined(list))
+        return 0;
+    val = JS_GetPropertyStr(ctx, list, "length");
+    if (JS_IsException(val))
+        return -1;
+    if (JS_ToUint32(ctx, &len, val)) {
+        JS_FreeValue(ctx, val);
+        return -1;
+    }
+    JS_FreeValue(ctx, val);
+    if (len == 0)
+        return 0;
+    tab = js_mallocz(ctx, sizeof(tab[0]) * len);
+    if (!tab)
+        return -1;
+    for(i = 0; i < len; i++) {
+        tab[i] = JS_GetPropertyUint32(ctx, list, i);
+        if (JS_IsException(tab[i])) {
+            while (i-- > 0)
+                JS_FreeValue(ctx, tab[i]);
+            js_free(ctx, tab);
+            return -1;
+        }
+    }
+    *ptab = tab;
+    *plen = len;
+    return 0;
+}
+
 static JSValue js_worker_postMessage(JSContext *ctx, JSValueConst this_val,
                                      int argc, JSValueConst *argv)
 {
@@ -3739,45 +4721,78 @@ static JSValue js_worker_postMessage(JSContext *ctx, JSValueConst this_val,
     uint8_t *data;
     JSWorkerMessage *msg;
     uint8_t **sab_tab;
+    JSValue *transfer_tab;
+    uint32_t transfer_len;
+    uint8_t **data_tab;
+    size_t *len_tab;
 
     if (!worker)
         return JS_EXCEPTION;
 
-    data = JS_WriteObject2(ctx, &data_len, argv[0],
-                           JS_WRITE_OBJ_SAB | JS_WRITE_OBJ_REFERENCE,
-                           &sab_tab, &sab_tab_len);
-    if (!data)
+    if (js_get_transfer_list(ctx, &transfer_tab, &transfer_len,
+                             argc > 1 ? argv[1] : JS_UNDEFINED))
         return JS_EXCEPTION;
 
-    msg = malloc(sizeof(*msg));
-    if (!msg)
+    /* the message is directly allocated with malloc() because the
+       allocator of the receiving runtime may be different */
+    msg = NULL;
+    sab_tab = NULL;
+    data_tab = NULL;
+    len_tab = NULL;
+    data = JS_WriteObject3(ctx, &data_len, argv[0],
+                           JS_WRITE_OBJ_SAB | JS_WRITE_OBJ_REFERENCE |
+                           JS_WRITE_OBJ_MALLOC,
+                           &sab_tab, &sab_tab_len,
+                           (JSValueConst *)transfer_tab, transfer_len);
+    if (!data)
         goto fail;
-    msg->data = NULL;
-    msg->sab_tab = NULL;
 
-    /* must reallocate because the allocator may be different */
-    msg->data = malloc(data_len);
-    if (!msg->data)
+    msg = malloc(sizeof(*msg));
+    if (!msg)
         goto fail;
-    memcpy(msg->data, data, data_len);
+    memset(msg, 0, sizeof(*msg));
+    msg->data = data;
     msg->data_len = data_len;
+    data = NULL;
 
     if (sab_tab_len > 0) {
         msg->sab_tab = malloc(sizeof(msg->sab_tab[0]) * sab_tab_len);
         if (!msg->sab_tab)
             goto fail;
         memcpy(msg->sab_tab, sab_tab, sizeof(msg->sab_tab[0]) * sab_tab_len);
+        /* increment the SAB reference counts */
+        for(i = 0; i < sab_tab_len; i++) {
+            js_sab_dup(NULL, msg->sab_tab[i]);
+        }
+        msg->sab_tab_len = sab_tab_len;
     }
-    msg->sab_tab_len = sab_tab_len;
 
-    js_free(ctx, data);
-    js_free(ctx, sab_tab);
-
-    /* increment the SAB reference counts */
-    for(i = 0; i < msg->sab_tab_len; i++) {
-        js_sab_dup(NULL, msg->sab_tab[i]);
+    if (transfer_len > 0) {
+        msg->transfer_tab = malloc(sizeof(msg->transfer_tab[0]) * transfer_len);
+        data_tab = js_malloc(ctx, sizeof(data_tab[0]) * transfer_len);
+        len_tab = js_malloc(ctx, sizeof(len_tab[0]) * transfer_len);
+        if (!msg->transfer_tab || !data_tab || !len_tab)
+            goto fail;
+        /* detach the ArrayBuffers without copying their data. Nothing
+           is detached if one of them cannot be transferred. */
+        if (JS_TransferArrayBuffers(ctx, data_tab, len_tab,
+                                    (JSValueConst *)transfer_tab,
+                                    transfer_len))
+            goto fail;
+        for(i = 0; i < transfer_len; i++) {
+            msg->transfer_tab[i].data = data_tab[i];
+            msg->transfer_tab[i].len = len_tab[i];
+        }
+        msg->transfer_tab_len = transfer_len;
+        js_free(ctx, data_tab);
+        js_free(ctx, len_tab);
     }
 
+    js_free(ctx, sab_tab);
+    for(i = 0; i < transfer_len; i++)
+        JS_FreeValue(ctx, transfer_tab[i]);
+    js_free(ctx, transfer_tab);
+
     ps = worker->send_pipe;
     pthread_mutex_lock(&ps->mutex);
     /* indicate that data is present */
@@ -3787,15 +4802,16 @@ static JSValue js_worker_postMessage(JSContext *ctx, JSValueConst this_val,
     pthread_mutex_unlock(&ps->mutex);
     return JS_UNDEFINED;
  fail:
-    if (msg) {
-        free(msg->data);
-        free(msg->sab_tab);
-        free(msg);
-    }
-    js_free(ctx, data);
+    if (msg)
+        js_free_message(msg);
+    free(data);
     js_free(ctx, sab_tab);
+    js_free(ctx, data_tab);
+    js_free(ctx, len_tab);
+    for(i = 0; i < transfer_len; i++)
+        JS_FreeValue(ctx, transfer_tab[i]);
+    js_free(ctx, transfer_tab);
     return JS_EXCEPTION;
-
 }
 
 static JSValue js_worker_set_onmessage(JSContext *ctx, JSValueConst this_val,
@@ -4091,10 +5107,16 @@ void js_std_init_handlers(JSRuntime *rt)
     memset(ts, 0, sizeof(*ts));
     init_list_head(&ts->os_rw_handlers);
     init_list_head(&ts->os_signal_handlers);
-    init_list_head(&ts->os_timers);
     init_list_head(&ts->port_list);
     init_list_head(&ts->rejected_promise_list);
     ts->next_timer_id = 1;
+#ifdef USE_EPOLL
+    ts->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (ts->epoll_fd < 0) {
+        fprintf(stderr, "Could not create the epoll instance");
+        exit(1);
+    }
+#endif
 
     JS_SetRuntimeOpaque(rt, ts);
 
@@ -4126,10 +5148,14 @@ void js_std_free_handlers(JSRuntime *rt)
         free_sh(rt, sh);
     }
 
-    list_for_each_safe(el, el1, &ts->os_timers) {
-        JSOSTimer *th = list_entry(el, JSOSTimer, link);
-        free_timer(rt, th);
-    }
+    while (ts->timer_count != 0)
+        free_timer(rt, ts->timer_heap[ts->timer_count - 1]);
+    js_free_rt(rt, ts->timer_heap);
+    js_free_rt(rt, ts->timer_hash);
+    js_free_rt(rt, ts->rw_handler_tab);
+#ifdef USE_EPOLL
+    close(ts->epoll_fd);
+#endif
 
     list_for_each_safe(el, el1, &ts->rejected_promise_list) {
         JSRejectedPromiseEntry *rp = list_entry(el, JSRejectedPromiseEntry, link);
@@ -4144,6 +5170,7 @@ void js_std_free_handlers(JSRuntime *rt)
     js_free_message_pipe(ts->send_pipe);
 #endif
 
+    free(ts->bytecode_cache_dir);
     free(ts);
     JS_SetRuntimeOpaque(rt, NULL); /* fail safe */
 }
@@ -42,6 +42,9 @@ void js_std_init_handlers(JSRuntime *rt);
 void js_std_free_handlers(JSRuntime *rt);
 void js_std_dump_error(JSContext *ctx);
 uint8_t *js_load_file(JSContext *ctx, size_t *pbuf_len, const char *filename);
+JSValue js_std_compile(JSContext *ctx, const char *buf, size_t buf_len,
+                       const char *filename, int eval_flags);
+int js_std_set_bytecode_cache(JSRuntime *rt, const char *dirname);
 int js_module_set_import_meta(JSContext *ctx, JSValueConst func_val,
                               JS_BOOL use_realpath, JS_BOOL is_main);
 int js_module_test_json(JSContext *ctx, JSValueConst attributes);
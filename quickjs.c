@@ -77,6 +77,14 @@
 #define CONFIG_STACK_CHECK
 #endif
 
+/* the baseline JIT (CONFIG_JIT) only supports x86-64 Linux with the
+   default JSValue representation */
+#if defined(CONFIG_JIT) && \
+    !(defined(__x86_64__) && defined(__linux__) && \
+      !defined(JS_NAN_BOXING) && !defined(CONFIG_CHECK_JSVALUE))
+#undef CONFIG_JIT
+#endif
+
 
 /* dump object free */
 //#define DUMP_FREE
@@ -117,6 +125,11 @@
 #include <errno.h>
 #endif
 
+#ifdef CONFIG_JIT
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 enum {
     /* classid tag        */    /* union usage   | properties */
     JS_CLASS_OBJECT = 1,        /* must be first */
@@ -230,6 +243,99 @@ typedef enum {
 
 typedef enum OPCodeEnum OPCodeEnum;
 
+/* Optional nursery: bump allocation region for the objects, strings
+   and small arrays which usually die young. The region is split in
+   chunks. A chunk is reused as soon as all the blocks allocated in it
+   are freed. The blocks cannot be moved because the C code keeps
+   pointers to them, so when there is no empty chunk left, the
+   allocation continues in the free space between the surviving blocks
+   of the other chunks. */
+#define JS_NURSERY_CHUNK_BITS 16
+#define JS_NURSERY_CHUNK_SIZE (1 << JS_NURSERY_CHUNK_BITS)
+#define JS_NURSERY_MAX_ALLOC  512 /* larger blocks use malloc() */
+#define JS_NURSERY_UNIT_BITS  4 /* allocation granularity */
+/* minimum free range reused between the surviving blocks */
+#define JS_NURSERY_MIN_FREE   1024
+
+typedef struct JSNursery {
+    uint8_t *base; /* NULL if no nursery */
+    size_t size;
+    uint8_t *ptr; /* allocation pointer in the current chunk */
+    uint8_t *end;
+    int cur_chunk; /* -1 if none */
+    int chunk_count;
+    uint32_t *live_count; /* number of allocated blocks in each chunk */
+    int *free_chunks; /* stack of the empty chunks */
+    int free_chunk_count;
+    /* size in units of the allocated block starting at each unit, 0
+       if none */
+    uint8_t *block_size;
+    /* units freed since the last unsuccessful search of free space
+       in the used chunks */
+    size_t freed_units;
+    int scan_chunk; /* next chunk where free space is searched */
+} JSNursery;
+
+/* Slab allocator for the small fixed size blocks (objects, shapes,
+   closure variables, map records, short strings...). A slab holds the
+   blocks of a single size class. The slabs are carved from arenas
+   allocated with the JSMallocFunctions and are aligned on their size,
+   so the slab of a block is found by hashing its address. The
+   allocated blocks are counted in malloc_state with their size class,
+   so the memory limit and the GC threshold apply to them. The arenas
+   are counted in a separate JSMallocState. */
+#define JS_SLAB_BITS        14
+#define JS_SLAB_SIZE        (1 << JS_SLAB_BITS)
+#define JS_SLAB_ARENA_SLABS 64
+#define JS_SLAB_MAX_ALLOC   512 /* larger blocks use malloc() */
+#define JS_SLAB_CLASS_COUNT 20
+
+typedef struct JSSlabArena {
+    struct list_head link; /* list of JSSlabAllocator.arena_list */
+    void *mem; /* allocated memory */
+    uint8_t *first_slab;
+    int slab_count;
+    int free_slab_count;
+} JSSlabArena;
+
+typedef struct JSSlab {
+    /* in the partial list of its size class or in the free slab
+       list. Self linked if all the blocks are allocated */
+    struct list_head link;
+    JSSlabArena *arena;
+    void *free_list; /* freed blocks */
+    uint8_t *ptr; /* next never allocated block */
+    uint8_t *end;
+    int class_idx; /* -1 if not used */
+    int live_count;
+} JSSlab;
+
+#define JS_SLAB_HEADER_SIZE ((sizeof(JSSlab) + 15) & ~15)
+
+typedef struct JSSlabAllocator {
+    int flags; /* JS_SLAB_x */
+    /* slabs having free blocks for each size class */
+    struct list_head partial_list[JS_SLAB_CLASS_COUNT];
+    struct list_head free_slab_list; /* empty slabs */
+    int free_slab_count;
+    struct list_head arena_list;
+    int arena_count;
+    /* hash table of the slab addresses */
+    JSSlab **hash;
+    int hash_bits;
+    int hash_count;
+    JSMallocState arena_state; /* arenas and hash table */
+} JSSlabAllocator;
+
+#define JS_UTF8_CACHE_SIZE 64 /* must be a power of two */
+#define JS_UTF8_CACHE_MAX_LEN (16 * 1024) /* longer strings are not cached */
+
+typedef struct JSUTF8CacheEntry {
+    JSString *str; /* NULL if empty */
+    JSString *utf8; /* UTF-8 conversion of 'str' */
+    BOOL cesu8;
+} JSUTF8CacheEntry;
+
 struct JSRuntime {
     JSMallocFunctions mf;
     JSMallocState malloc_state;
@@ -255,6 +361,16 @@ struct JSRuntime {
     struct list_head tmp_obj_list; /* used during GC */
     JSGCPhaseEnum gc_phase : 8;
     size_t malloc_gc_threshold;
+    int gc_obj_count; /* number of GC objects */
+    /* incremental GC: objects examined by the current step */
+    struct list_head gc_step_list;
+    int gc_step_count;
+    int gc_step_obj_count; /* gc_obj_count after the last step */
+    int64_t gc_max_pause; /* in us, 0 if no incremental collection */
+    /* in incremental mode, a full collection is done above this size */
+    size_t malloc_gc_full_threshold;
+    JSNursery nursery;
+    JSSlabAllocator slab;
     struct list_head weakref_list; /* list of JSWeakRefHeader.link */
 #ifdef DUMP_LEAKS
     struct list_head string_list; /* list of JSString.link */
@@ -296,6 +412,32 @@ struct JSRuntime {
     JSSharedArrayBufferFunctions sab_funcs;
     /* see JS_SetStripInfo() */
     uint8_t strip_flags;
+    /* see JS_SetInlineCacheEnabled() */
+    BOOL ic_enabled : 8;
+    /* see JS_SetLazyCompilationEnabled() */
+    BOOL lazy_compile_enabled : 8;
+    /* number of lazy function stubs created and compiled since the
+       runtime creation */
+    int64_t lazy_func_count;
+    int64_t lazy_func_compiled_count;
+#ifdef CONFIG_JIT
+    /* see JS_SetJITEnabled() and JS_SetJITThreshold() */
+    BOOL jit_enabled : 8;
+    int jit_threshold;
+#endif
+    /* compiled regexps indexed by (pattern, flags), see
+       JS_SetRegExpCacheSize() */
+    struct JSRegExpCacheEntry **regexp_cache_hash;
+    int regexp_cache_hash_size; /* power of two, 0 if not allocated */
+    int regexp_cache_count;
+    int regexp_cache_max_count; /* 0 if no cache */
+    struct list_head regexp_cache_lru; /* most recently used first */
+    int64_t regexp_cache_hit_count;
+    int64_t regexp_cache_miss_count;
+    int64_t regexp_nfa_count; /* executions which used the linear time engine */
+    /* last strings converted by JS_ToCStringLen2() which needed an
+       allocation, indexed by their address */
+    JSUTF8CacheEntry utf8_cache[JS_UTF8_CACHE_SIZE];
     
     /* Shape hash table */
     int shape_hash_bits;
@@ -610,6 +752,47 @@ typedef enum JSFunctionKindEnum {
     JS_FUNC_ASYNC_GENERATOR = (JS_FUNC_GENERATOR | JS_FUNC_ASYNC),
 } JSFunctionKindEnum;
 
+/* copy of the source code of a script, shared by its lazily compiled
+   functions */
+typedef struct JSLazySource {
+    int ref_count;
+    uint32_t len;
+    BOOL is_module;
+    char buf[0]; /* zero terminated */
+} JSLazySource;
+
+/* binary object read by JS_ReadObjectImage(). It is kept until all
+   its functions are read. */
+typedef struct JSBytecodeImage {
+    int ref_count;
+    const uint8_t *buf;
+    size_t buf_len;
+    uint32_t first_atom;
+    uint32_t idx_to_atom_count;
+    JSAtom *idx_to_atom;
+    JSFreeBytecodeImageFunc *free_func;
+    void *opaque;
+} JSBytecodeImage;
+
+/* function whose bytecode is generated on its first call by parsing
+   its source code again (see js_create_lazy_function()) or by reading
+   it from a bytecode image (see JS_ReadObjectImage()) */
+typedef struct JSLazyFunction {
+    JSLazySource *source; /* NULL if the function is in 'image' */
+    JSBytecodeImage *image;
+    struct JSFunctionBytecode *compiled; /* NULL if not compiled yet */
+    uint32_t image_pos; /* position of the function in 'image' */
+    uint32_t parse_pos; /* first token read by js_parse_function_decl2() */
+    uint32_t source_pos; /* function source code, used by toString() */
+    uint32_t source_len;
+    uint8_t func_type; /* JSParseFunctionEnum */
+    uint8_t func_kind; /* func_kind argument of js_parse_function_decl2() */
+    /* state of the parent function needed to parse the function */
+    uint8_t parent_js_mode;
+    uint8_t parent_func_kind;
+    uint8_t parent_func_type;
+} JSLazyFunction;
+
 typedef struct JSFunctionBytecode {
     JSGCObjectHeader header; /* must come first */
     uint8_t js_mode;
@@ -626,7 +809,10 @@ typedef struct JSFunctionBytecode {
     uint8_t has_debug : 1;
     uint8_t read_only_bytecode : 1;
     uint8_t is_direct_or_indirect_eval : 1; /* used by JS_GetScriptOrModuleName() */
-    /* XXX: 10 bits available */
+#ifdef CONFIG_JIT
+    uint8_t jit_failed : 1; /* the function cannot be compiled */
+#endif
+    /* XXX: 9 bits available */
     uint8_t *byte_code_buf; /* (self pointer) */
     int byte_code_len;
     JSAtom func_name;
@@ -640,6 +826,12 @@ typedef struct JSFunctionBytecode {
     JSValue *cpool; /* constant pool (self pointer) */
     int cpool_count;
     int closure_var_count;
+    struct JSInlineCache *ic; /* property access caches, allocated on first use */
+    JSLazyFunction *lazy; /* != NULL if the bytecode is generated on the first call */
+#ifdef CONFIG_JIT
+    int jit_counter; /* calls and backward jumps, see JS_SetJITThreshold() */
+    struct JSJitCode *jit; /* native code, NULL if not compiled */
+#endif
     struct {
         /* debug info, move to separate structure to save memory? */
         JSAtom filename;
@@ -650,6 +842,75 @@ typedef struct JSFunctionBytecode {
     } debug;
 } JSFunctionBytecode;
 
+/* Inline caches of OP_get_field, OP_get_field2 and OP_put_field. A
+   reference is kept on the cached shapes so that they are never
+   modified in place (see js_shape_prepare_update()): a cached entry
+   stays valid as long as the object shapes are the same. */
+#define JS_IC_MAX_ENTRIES 4 /* maximum number of shapes of a polymorphic site */
+#define JS_IC_MAX_DEPTH   4 /* maximum prototype depth of a cached property */
+
+typedef enum {
+    JS_IC_STATE_UNINITIALIZED,
+    JS_IC_STATE_MONOMORPHIC,
+    JS_IC_STATE_POLYMORPHIC,
+    JS_IC_STATE_MEGAMORPHIC, /* too many shapes or not cacheable */
+} JSInlineCacheStateEnum;
+
+typedef struct JSInlineCacheEntry {
+    JSShape *shape; /* shape of the receiver */
+    /* shapes of the prototypes up to the object holding the property */
+    JSShape *proto_shape[JS_IC_MAX_DEPTH];
+    uint32_t prop_idx; /* property index in the holder shape */
+    uint32_t depth; /* 0 if own property */
+} JSInlineCacheEntry;
+
+typedef struct JSInlineCacheSite {
+    uint32_t pc_pos; /* position of the opcode in the bytecode */
+    uint8_t state; /* see JSInlineCacheStateEnum */
+    uint8_t count; /* number of used entries */
+    JSInlineCacheEntry entries[JS_IC_MAX_ENTRIES];
+} JSInlineCacheSite;
+
+typedef struct JSInlineCache {
+    int count; /* number of sites */
+    uint32_t hash_bits;
+    uint32_t *hash; /* site index + 1 indexed by a hash of the pc position */
+    JSInlineCacheSite sites[0];
+} JSInlineCache;
+
+#ifdef CONFIG_JIT
+#define JS_JIT_THRESHOLD_DEFAULT 1000
+
+/* Native code of a function compiled by the baseline JIT. It works on
+   the interpreter frame so that the execution can switch between the
+   native code and the interpreter at any instruction boundary. */
+typedef struct JSJitCode {
+    uint8_t *code; /* executable mapping */
+    size_t code_size;
+    /* native offset of the bytecode positions where the native code
+       can be entered, 0 otherwise */
+    uint32_t *entry_tab;
+} JSJitCode;
+
+/* interpreter state shared with the native code */
+typedef struct JSJitState {
+    JSValue *sp;
+    JSValue *var_buf;
+    JSValue *arg_buf;
+    JSStackFrame *sf;
+    JSFunctionBytecode *b;
+    uint32_t pos; /* bytecode position where the interpreter resumes */
+} JSJitState;
+
+typedef enum {
+    JS_JIT_EXIT_INTERP, /* continue in the interpreter at 'pos' */
+    JS_JIT_EXIT_EXCEPTION,
+} JSJitExitEnum;
+
+/* 'entry' is the native code address of the first instruction */
+typedef int JSJitFunc(JSContext *ctx, JSJitState *s, const uint8_t *entry);
+#endif
+
 typedef struct JSBoundFunction {
     JSValue func_obj;
     JSValue this_val;
@@ -672,11 +933,46 @@ typedef struct JSForInIterator {
     JSPropertyEnum *tab_atom; /* is_array = FALSE */
 } JSForInIterator;
 
+/* the regexp native code is generated after JS_REGEXP_JIT_THRESHOLD
+   executions on 8 bit strings */
+#define JS_REGEXP_JIT_THRESHOLD 3
+
+#ifdef CONFIG_REGEXP_JIT
+/* native code of a regexp bytecode. It is shared by the RegExp
+   objects and the cache entry of the bytecode. */
+typedef struct JSRegExpJit {
+    int ref_count;
+    LREJitCode *code; /* NULL if the regexp is not supported */
+} JSRegExpJit;
+#endif
+
 typedef struct JSRegExp {
     JSString *pattern;
     JSString *bytecode; /* also contains the flags */
+#ifdef CONFIG_REGEXP_JIT
+    /* < JS_REGEXP_JIT_THRESHOLD: execution count,
+       = JS_REGEXP_JIT_THRESHOLD: no native code,
+       otherwise: JSRegExpJit pointer */
+    uintptr_t jit;
+#endif
 } JSRegExp;
 
+#define JS_REGEXP_CACHE_SIZE_DEFAULT 256
+
+/* LRU cache of the regexp bytecode. The bytecode strings are immutable
+   so they are shared by the RegExp objects. */
+typedef struct JSRegExpCacheEntry {
+    struct list_head link; /* rt->regexp_cache_lru */
+    struct JSRegExpCacheEntry *hash_next;
+    uint32_t hash;
+    int re_flags;
+    JSString *pattern;
+    JSString *bytecode;
+#ifdef CONFIG_REGEXP_JIT
+    JSRegExpJit *jit; /* NULL if not compiled yet */
+#endif
+} JSRegExpCacheEntry;
+
 typedef struct JSProxyData {
     JSValue target;
     JSValue handler;
@@ -883,7 +1179,15 @@ typedef struct JSProperty {
 } JSProperty;
 
 #define JS_PROP_INITIAL_SIZE 2
+/* maximum number of property slots allocated after the JSObject
+   structure */
+#define JS_INLINE_PROP_MAX 8
 #define JS_PROP_INITIAL_HASH_SIZE 4 /* must be a power of two */
+/* shapes with more properties are modified in place instead of
+   creating new transitions */
+#define JS_SHAPE_TRANSITION_MAX_PROPS 16
+/* maximum number of transitions from a given shape */
+#define JS_SHAPE_TRANSITION_MAX_FAN_OUT 64
 #define JS_ARRAY_INITIAL_SIZE 2
 
 typedef struct JSShapeProperty {
@@ -903,16 +1207,37 @@ struct JSShape {
        <= n <= 2^31-1. If false, the shape is guaranteed not to have
        small array index properties */
     uint8_t has_small_array_index;
+    /* for the initial shapes (prop_count = 0): number of inline
+       property slots allocated for the new objects. It grows up to
+       JS_INLINE_PROP_MAX when the objects built from this shape run
+       out of inline slots. */
+    uint8_t inline_prop_hint;
     uint32_t hash; /* current hash value */
     uint32_t prop_hash_mask;
     int prop_size; /* allocated properties */
     int prop_count; /* include deleted properties */
     int deleted_prop_count;
     JSShape *shape_hash_next; /* in JSRuntime.shape_hash[h] list */
+    /* transition tree: a hashed shape obtained by adding one property
+       to 'transition_parent' holds a reference to it and is linked in
+       its list of children. Only hashed shapes are in the tree. A
+       shape is removed from the tree when it is freed, so the
+       intermediate shapes are freed with their last child. */
+    JSShape *transition_parent;
+    JSShape *transition_first_child;
+    JSShape *transition_next; /* next child of transition_parent */
     JSObject *proto;
     JSShapeProperty prop[0]; /* prop_size elements */
 };
 
+/* representation of the elements of the fast arrays. An array only
+   transitions to a more general kind. */
+typedef enum {
+    JS_ARRAY_KIND_INT32,   /* u.array.u.int32_ptr */
+    JS_ARRAY_KIND_FLOAT64, /* u.array.u.double_ptr */
+    JS_ARRAY_KIND_GENERIC, /* u.array.u.values */
+} JSArrayKindEnum;
+
 struct JSObject {
     union {
         JSGCObjectHeader header;
@@ -935,8 +1260,10 @@ struct JSObject {
        structure is freed only if header.ref_count = 0 and
        weakref_count = 0 */
     uint32_t weakref_count; 
+    uint8_t inline_prop_size; /* number of elements of inline_prop[] */
+    uint8_t array_kind; /* JS_CLASS_ARRAY, JS_CLASS_ARGUMENTS: JSArrayKindEnum */
     JSShape *shape; /* prototype and property names + flag */
-    JSProperty *prop; /* array of properties */
+    JSProperty *prop; /* array of properties (= inline_prop if they fit) */
     union {
         void *opaque;
         struct JSBoundFunction *bound_function; /* JS_CLASS_BOUND_FUNCTION */
@@ -994,6 +1321,7 @@ struct JSObject {
         JSRegExp regexp;    /* JS_CLASS_REGEXP: 8/16 bytes */
         JSValue object_data;    /* for JS_SetObjectData(): 8/16/16 bytes */
     } u;
+    JSProperty inline_prop[0]; /* inline_prop_size elements */
 };
 
 typedef struct JSMapRecord {
@@ -1068,6 +1396,16 @@ static JSAtom __JS_NewAtomInit(JSRuntime *rt, const char *str, int len,
                                int atom_type);
 static void JS_FreeAtomStruct(JSRuntime *rt, JSAtomStruct *p);
 static void free_function_bytecode(JSRuntime *rt, JSFunctionBytecode *b);
+static JSInlineCache *js_new_inline_cache(JSRuntime *rt, JSFunctionBytecode *b);
+static JSFunctionBytecode *js_lazy_compile(JSContext *ctx, JSFunctionBytecode *b);
+static JSFunctionBytecode *js_image_read_function(JSContext *ctx,
+                                                  JSFunctionBytecode *b);
+static void js_free_bytecode_image(JSRuntime *rt, JSBytecodeImage *img);
+static JSFunctionBytecode *js_lazy_function_compile(JSContext *ctx, JSObject *p);
+#ifdef CONFIG_JIT
+static int js_jit_compile(JSContext *ctx, JSFunctionBytecode *b);
+static void js_jit_free(JSRuntime *rt, JSJitCode *jit);
+#endif
 static JSValue js_call_c_function(JSContext *ctx, JSValueConst func_obj,
                                   JSValueConst this_obj,
                                   int argc, JSValueConst *argv, int flags);
@@ -1159,6 +1497,8 @@ static int JS_ToUint8ClampFree(JSContext *ctx, int32_t *pres, JSValue val);
 static JSValue js_new_string8_len(JSContext *ctx, const char *buf, int len);
 static JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
                                  JSValueConst flags);
+static void js_regexp_cache_free(JSRuntime *rt);
+static void js_utf8_cache_free(JSRuntime *rt);
 static JSValue js_regexp_constructor_internal(JSContext *ctx, JSValueConst ctor,
                                               JSValue pattern, JSValue bc);
 static void gc_decref(JSRuntime *rt);
@@ -1265,7 +1605,7 @@ static void free_arg_list(JSContext *ctx, JSValue *tab, uint32_t len);
 static JSValue *build_arg_list(JSContext *ctx, uint32_t *plen,
                                JSValueConst array_arg);
 static BOOL js_get_fast_array(JSContext *ctx, JSValueConst obj,
-                              JSValue **arrpp, uint32_t *countp);
+                              JSObject **pp, uint32_t *countp);
 static JSValue JS_CreateAsyncFromSyncIterator(JSContext *ctx,
                                               JSValueConst sync_iter);
 static void js_c_function_data_finalizer(JSRuntime *rt, JSValue val);
@@ -1277,7 +1617,8 @@ static JSValue js_c_function_data_call(JSContext *ctx, JSValueConst func_obj,
 static JSAtom js_symbol_to_atom(JSContext *ctx, JSValue val);
 static void add_gc_object(JSRuntime *rt, JSGCObjectHeader *h,
                           JSGCObjectTypeEnum type);
-static void remove_gc_object(JSGCObjectHeader *h);
+static void remove_gc_object(JSRuntime *rt, JSGCObjectHeader *h);
+static void gc_run_steps(JSRuntime *rt, int count, int64_t budget);
 static JSValue js_instantiate_prototype(JSContext *ctx, JSObject *p, JSAtom atom, void *opaque);
 static JSValue js_module_ns_autoinit(JSContext *ctx, JSObject *p, JSAtom atom,
                                  void *opaque);
@@ -1285,6 +1626,11 @@ static JSValue JS_InstantiateFunctionListItem2(JSContext *ctx, JSObject *p,
                                                JSAtom atom, void *opaque);
 static JSValue js_object_groupBy(JSContext *ctx, JSValueConst this_val,
                                  int argc, JSValueConst *argv, int is_map);
+static JSValue js_map_constructor(JSContext *ctx, JSValueConst new_target,
+                                  int argc, JSValueConst *argv, int magic);
+static JSValue js_map_set(JSContext *ctx, JSValueConst this_val,
+                          int argc, JSValueConst *argv, int magic);
+static void js_random_init(JSContext *ctx);
 static void map_delete_weakrefs(JSRuntime *rt, JSWeakRefHeader *wh);
 static void weakref_delete_weakref(JSRuntime *rt, JSWeakRefHeader *wh);
 static void finrec_delete_weakref(JSRuntime *rt, JSWeakRefHeader *wh);
@@ -1319,9 +1665,22 @@ static void js_trigger_gc(JSRuntime *rt, size_t size)
         printf("GC: size=%" PRIu64 "\n",
                (uint64_t)rt->malloc_state.malloc_size);
 #endif
-        JS_RunGC(rt);
-        rt->malloc_gc_threshold = rt->malloc_state.malloc_size +
-            (rt->malloc_state.malloc_size >> 1);
+        if (rt->gc_max_pause != 0 &&
+            (rt->malloc_state.malloc_size + size) <=
+            rt->malloc_gc_full_threshold) {
+            /* bounded pause: examine the new objects and as many old
+               ones. The garbage cycles larger than a step are only
+               freed by the full collection. */
+            gc_run_steps(rt, max_int(rt->gc_obj_count - rt->gc_step_obj_count, 0) * 2,
+                         rt->gc_max_pause);
+            rt->malloc_gc_threshold = rt->malloc_state.malloc_size +
+                max_int(rt->malloc_state.malloc_size >> 7, 256 * 1024);
+        } else {
+            JS_RunGC(rt);
+            rt->malloc_gc_threshold = rt->malloc_state.malloc_size +
+                (rt->malloc_state.malloc_size >> 1);
+            rt->malloc_gc_full_threshold = rt->malloc_state.malloc_size * 2;
+        }
     }
 }
 
@@ -1330,26 +1689,508 @@ static size_t js_malloc_usable_size_unknown(const void *ptr)
     return 0;
 }
 
+static inline BOOL js_nursery_contains(JSRuntime *rt, const void *ptr)
+{
+    /* always false if there is no nursery */
+    return ((uintptr_t)ptr - (uintptr_t)rt->nursery.base) < rt->nursery.size;
+}
+
+/* find a free range of at least 'size' bytes in the chunk 'idx'
+   starting from 'ptr' and use it for the next allocations */
+static BOOL js_nursery_find_free_space(JSNursery *n, int idx, uint8_t *ptr,
+                                       size_t size)
+{
+    size_t u, u_end, u_start;
+
+    u = (ptr - n->base) >> JS_NURSERY_UNIT_BITS;
+    u_end = ((size_t)(idx + 1) << JS_NURSERY_CHUNK_BITS) >> JS_NURSERY_UNIT_BITS;
+    while (u < u_end) {
+        if (n->block_size[u] != 0) {
+            u += n->block_size[u];
+        } else {
+            u_start = u;
+            while (u < u_end && n->block_size[u] == 0)
+                u++;
+            if (((u - u_start) << JS_NURSERY_UNIT_BITS) >= size) {
+                n->cur_chunk = idx;
+                n->ptr = n->base + (u_start << JS_NURSERY_UNIT_BITS);
+                n->end = n->base + (u << JS_NURSERY_UNIT_BITS);
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/* return FALSE if there is no space for 'size' bytes in the
+   nursery */
+static no_inline BOOL js_nursery_next_chunk(JSRuntime *rt, size_t size)
+{
+    JSNursery *n = &rt->nursery;
+    int idx, i;
+
+    /* next free range of the current chunk */
+    if (n->cur_chunk >= 0 &&
+        js_nursery_find_free_space(n, n->cur_chunk, n->end, size))
+        return TRUE;
+    if (n->free_chunk_count != 0) {
+        idx = n->free_chunks[--n->free_chunk_count];
+        n->cur_chunk = idx;
+        n->ptr = n->base + ((size_t)idx << JS_NURSERY_CHUNK_BITS);
+        n->end = n->ptr + JS_NURSERY_CHUNK_SIZE;
+        return TRUE;
+    }
+    /* reuse the space freed around the surviving blocks. After an
+       unsuccessful search, the chunks are only examined again when
+       enough memory was freed. */
+    if (n->freed_units >= (JS_NURSERY_CHUNK_SIZE >> JS_NURSERY_UNIT_BITS)) {
+        for(i = 0; i < n->chunk_count; i++) {
+            idx = n->scan_chunk;
+            n->scan_chunk = (idx + 1) % n->chunk_count;
+            if (idx != n->cur_chunk &&
+                js_nursery_find_free_space(n, idx, n->base +
+                                           ((size_t)idx << JS_NURSERY_CHUNK_BITS),
+                                           max_int(size, JS_NURSERY_MIN_FREE)))
+                return TRUE;
+        }
+        n->freed_units = 0;
+    }
+    n->cur_chunk = -1;
+    n->ptr = n->end = NULL;
+    return FALSE;
+}
+
+/* allocate in the nursery if possible */
+static inline void *js_malloc_nursery_rt(JSRuntime *rt, size_t size)
+{
+    JSNursery *n = &rt->nursery;
+    uint8_t *ptr;
+    size_t asize;
+
+    if (size <= JS_NURSERY_MAX_ALLOC) {
+        asize = (size + (1 << JS_NURSERY_UNIT_BITS) - 1) &
+            ~((1 << JS_NURSERY_UNIT_BITS) - 1);
+        if (likely((size_t)(n->end - n->ptr) >= asize) ||
+            (n->base && js_nursery_next_chunk(rt, asize))) {
+            ptr = n->ptr;
+            n->ptr += asize;
+            n->block_size[(ptr - n->base) >> JS_NURSERY_UNIT_BITS] =
+                asize >> JS_NURSERY_UNIT_BITS;
+            n->live_count[n->cur_chunk]++;
+            return ptr;
+        }
+    }
+    return js_malloc_rt(rt, size);
+}
+
+static void js_nursery_free(JSRuntime *rt, void *ptr)
+{
+    JSNursery *n = &rt->nursery;
+    size_t u;
+    int idx;
+
+    u = ((uint8_t *)ptr - n->base) >> JS_NURSERY_UNIT_BITS;
+    idx = ((uint8_t *)ptr - n->base) >> JS_NURSERY_CHUNK_BITS;
+    assert(n->live_count[idx] != 0 && n->block_size[u] != 0);
+    n->freed_units += n->block_size[u];
+    n->block_size[u] = 0;
+    if (--n->live_count[idx] == 0) {
+        if (idx == n->cur_chunk) {
+            /* all the blocks died: restart at the beginning */
+            n->ptr = n->base + ((size_t)idx << JS_NURSERY_CHUNK_BITS);
+            n->end = n->ptr + JS_NURSERY_CHUNK_SIZE;
+        } else {
+            n->free_chunks[n->free_chunk_count++] = idx;
+        }
+    }
+}
+
+/* the block is moved out of the nursery */
+static no_inline void *js_nursery_realloc(JSRuntime *rt, void *ptr, size_t size)
+{
+    JSNursery *n = &rt->nursery;
+    void *new_ptr;
+    size_t len;
+
+    if (size == 0) {
+        js_nursery_free(rt, ptr);
+        return NULL;
+    }
+    new_ptr = js_malloc_rt(rt, size);
+    if (!new_ptr)
+        return NULL;
+    len = (size_t)n->block_size[((uint8_t *)ptr - n->base) >>
+                                JS_NURSERY_UNIT_BITS] << JS_NURSERY_UNIT_BITS;
+    memcpy(new_ptr, ptr, min_int64(size, len));
+    js_nursery_free(rt, ptr);
+    return new_ptr;
+}
+
+static void js_nursery_free_region(JSRuntime *rt)
+{
+    JSNursery n = rt->nursery;
+    if (n.base) {
+        /* the nursery must be removed before freeing its region */
+        memset(&rt->nursery, 0, sizeof(rt->nursery));
+        js_free_rt(rt, n.base);
+        js_free_rt(rt, n.live_count);
+        js_free_rt(rt, n.free_chunks);
+        js_free_rt(rt, n.block_size);
+    }
+}
+
+static const uint16_t js_slab_class_size[JS_SLAB_CLASS_COUNT] = {
+    16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240, 256,
+    320, 384, 448, 512,
+};
+
+/* 1 <= size <= JS_SLAB_MAX_ALLOC */
+static inline int js_slab_class(size_t size)
+{
+    if (size <= 256)
+        return (size - 1) >> 4;
+    else
+        return 12 + ((size - 1) >> 6);
+}
+
+static inline uint32_t js_slab_hash(const JSSlab *s, int hash_bits)
+{
+    return ((uint32_t)((uintptr_t)s >> JS_SLAB_BITS) * 0x9e3779b1) >>
+        (32 - hash_bits);
+}
+
+/* return the slab containing 'ptr' or NULL */
+static inline JSSlab *js_slab_find(JSRuntime *rt, const void *ptr)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    JSSlab *s, *s1;
+    uint32_t h, mask;
+
+    if (sa->hash_count == 0)
+        return NULL;
+    s = (JSSlab *)((uintptr_t)ptr & ~(uintptr_t)(JS_SLAB_SIZE - 1));
+    h = js_slab_hash(s, sa->hash_bits);
+    mask = ((uint32_t)1 << sa->hash_bits) - 1;
+    for(;;) {
+        s1 = sa->hash[h];
+        if (s1 == s || !s1)
+            return s1;
+        h = (h + 1) & mask;
+    }
+}
+
+static void *js_slab_sys_malloc(JSRuntime *rt, size_t size)
+{
+    return rt->mf.js_malloc(&rt->slab.arena_state, size);
+}
+
+static void js_slab_sys_free(JSRuntime *rt, void *ptr)
+{
+    rt->mf.js_free(&rt->slab.arena_state, ptr);
+}
+
+static void js_slab_hash_add(JSSlabAllocator *sa, JSSlab *s)
+{
+    uint32_t h, mask;
+    mask = ((uint32_t)1 << sa->hash_bits) - 1;
+    h = js_slab_hash(s, sa->hash_bits);
+    while (sa->hash[h])
+        h = (h + 1) & mask;
+    sa->hash[h] = s;
+    sa->hash_count++;
+}
+
+static void js_slab_hash_remove(JSSlabAllocator *sa, JSSlab *s)
+{
+    uint32_t i, j, k, mask;
+
+    mask = ((uint32_t)1 << sa->hash_bits) - 1;
+    i = js_slab_hash(s, sa->hash_bits);
+    while (sa->hash[i] != s)
+        i = (i + 1) & mask;
+    /* move back the following entries of the cluster which are not
+       at their hash position */
+    j = i;
+    for(;;) {
+        j = (j + 1) & mask;
+        if (!sa->hash[j])
+            break;
+        k = js_slab_hash(sa->hash[j], sa->hash_bits);
+        if (((j - k) & mask) >= ((j - i) & mask)) {
+            sa->hash[i] = sa->hash[j];
+            i = j;
+        }
+    }
+    sa->hash[i] = NULL;
+    sa->hash_count--;
+}
+
+/* the hash table is kept at most half full */
+static int js_slab_hash_reserve(JSRuntime *rt, int count)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    JSSlab **old_hash;
+    int i, old_size, new_bits;
+
+    new_bits = max_int(sa->hash_bits, 8);
+    while (count * 2 > (1 << new_bits))
+        new_bits++;
+    if (new_bits == sa->hash_bits)
+        return 0;
+    old_hash = sa->hash;
+    old_size = sa->hash ? 1 << sa->hash_bits : 0;
+    sa->hash = js_slab_sys_malloc(rt, sizeof(sa->hash[0]) << new_bits);
+    if (!sa->hash) {
+        sa->hash = old_hash;
+        return -1;
+    }
+    memset(sa->hash, 0, sizeof(sa->hash[0]) << new_bits);
+    sa->hash_bits = new_bits;
+    sa->hash_count = 0;
+    for(i = 0; i < old_size; i++) {
+        if (old_hash[i])
+            js_slab_hash_add(sa, old_hash[i]);
+    }
+    if (old_hash)
+        js_slab_sys_free(rt, old_hash);
+    return 0;
+}
+
+static BOOL js_slab_new_arena(JSRuntime *rt)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    JSSlabArena *a;
+    JSSlab *s;
+    size_t size;
+    int i;
+
+    size = (size_t)JS_SLAB_ARENA_SLABS << JS_SLAB_BITS;
+    if (js_slab_hash_reserve(rt, sa->hash_count + JS_SLAB_ARENA_SLABS))
+        return FALSE;
+    a = js_slab_sys_malloc(rt, sizeof(*a));
+    if (!a)
+        return FALSE;
+    a->mem = js_slab_sys_malloc(rt, size);
+    if (!a->mem) {
+        js_slab_sys_free(rt, a);
+        return FALSE;
+    }
+    a->first_slab = (uint8_t *)(((uintptr_t)a->mem + JS_SLAB_SIZE - 1) &
+                                ~(uintptr_t)(JS_SLAB_SIZE - 1));
+    a->slab_count = ((uint8_t *)a->mem + size - a->first_slab) >> JS_SLAB_BITS;
+    a->free_slab_count = a->slab_count;
+    for(i = 0; i < a->slab_count; i++) {
+        s = (JSSlab *)(a->first_slab + ((size_t)i << JS_SLAB_BITS));
+        s->arena = a;
+        s->class_idx = -1;
+        s->live_count = 0;
+        list_add_tail(&s->link, &sa->free_slab_list);
+        js_slab_hash_add(sa, s);
+    }
+    sa->free_slab_count += a->slab_count;
+    list_add_tail(&a->link, &sa->arena_list);
+    sa->arena_count++;
+    return TRUE;
+}
+
+static void js_slab_free_arena(JSRuntime *rt, JSSlabArena *a)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    JSSlab *s;
+    int i;
+
+    for(i = 0; i < a->slab_count; i++) {
+        s = (JSSlab *)(a->first_slab + ((size_t)i << JS_SLAB_BITS));
+        if (s->class_idx < 0) {
+            list_del(&s->link);
+            sa->free_slab_count--;
+        }
+        js_slab_hash_remove(sa, s);
+    }
+    list_del(&a->link);
+    sa->arena_count--;
+    js_slab_sys_free(rt, a->mem);
+    js_slab_sys_free(rt, a);
+}
+
+/* return FALSE if no memory */
+static no_inline BOOL js_slab_new_slab(JSRuntime *rt, int class_idx)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    JSSlab *s;
+    size_t bsize;
+
+    if (list_empty(&sa->free_slab_list) && !js_slab_new_arena(rt))
+        return FALSE;
+    s = list_entry(sa->free_slab_list.next, JSSlab, link);
+    list_del(&s->link);
+    s->arena->free_slab_count--;
+    sa->free_slab_count--;
+    bsize = js_slab_class_size[class_idx];
+    s->class_idx = class_idx;
+    s->free_list = NULL;
+    s->ptr = (uint8_t *)s + JS_SLAB_HEADER_SIZE;
+    s->end = s->ptr + ((JS_SLAB_SIZE - JS_SLAB_HEADER_SIZE) / bsize) * bsize;
+    s->live_count = 0;
+    list_add(&s->link, &sa->partial_list[class_idx]);
+    return TRUE;
+}
+
+static no_inline void js_slab_free_slab(JSRuntime *rt, JSSlab *s)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    JSSlabArena *a = s->arena;
+
+    list_del(&s->link);
+    s->class_idx = -1;
+    /* the most recently used slabs are reused first */
+    list_add(&s->link, &sa->free_slab_list);
+    a->free_slab_count++;
+    sa->free_slab_count++;
+    /* keep some empty slabs to avoid allocating a new arena at once */
+    if ((sa->flags & JS_SLAB_RELEASE_EMPTY) &&
+        a->free_slab_count == a->slab_count &&
+        sa->free_slab_count - a->slab_count >= JS_SLAB_ARENA_SLABS / 2) {
+        js_slab_free_arena(rt, a);
+    }
+}
+
+/* 1 <= size <= JS_SLAB_MAX_ALLOC */
+static inline void *js_slab_malloc(JSRuntime *rt, size_t size)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    struct list_head *head;
+    JSSlab *s;
+    void *ptr;
+    int class_idx;
+    size_t bsize;
+
+    class_idx = js_slab_class(size);
+    bsize = js_slab_class_size[class_idx];
+    if (unlikely(rt->malloc_state.malloc_size + bsize >
+                 rt->malloc_state.malloc_limit))
+        return NULL;
+    head = &sa->partial_list[class_idx];
+    if (unlikely(list_empty(head))) {
+        if (!js_slab_new_slab(rt, class_idx))
+            return NULL;
+    }
+    s = list_entry(head->next, JSSlab, link);
+    ptr = s->free_list;
+    if (ptr) {
+        s->free_list = *(void **)ptr;
+    } else {
+        ptr = s->ptr;
+        s->ptr += bsize;
+    }
+    if (!s->free_list && s->ptr >= s->end) {
+        /* full slab */
+        list_del(&s->link);
+        init_list_head(&s->link);
+    }
+    s->live_count++;
+    rt->malloc_state.malloc_count++;
+    rt->malloc_state.malloc_size += bsize;
+    return ptr;
+}
+
+static inline void js_slab_free(JSRuntime *rt, JSSlab *s, void *ptr)
+{
+    rt->malloc_state.malloc_count--;
+    rt->malloc_state.malloc_size -= js_slab_class_size[s->class_idx];
+    if (list_empty(&s->link))
+        list_add(&s->link, &rt->slab.partial_list[s->class_idx]);
+    *(void **)ptr = s->free_list;
+    s->free_list = ptr;
+    if (--s->live_count == 0)
+        js_slab_free_slab(rt, s);
+}
+
+static no_inline void *js_slab_realloc(JSRuntime *rt, JSSlab *s, void *ptr,
+                                       size_t size)
+{
+    void *new_ptr;
+    size_t bsize;
+
+    if (size == 0) {
+        js_slab_free(rt, s, ptr);
+        return NULL;
+    }
+    bsize = js_slab_class_size[s->class_idx];
+    if (size <= bsize && js_slab_class(size) == s->class_idx)
+        return ptr;
+    new_ptr = js_malloc_rt(rt, size);
+    if (!new_ptr)
+        return NULL;
+    memcpy(new_ptr, ptr, min_int64(size, bsize));
+    js_slab_free(rt, s, ptr);
+    return new_ptr;
+}
+
+static void js_slab_free_all(JSRuntime *rt)
+{
+    JSSlabAllocator *sa = &rt->slab;
+    struct list_head *el, *el1;
+
+    list_for_each_safe(el, el1, &sa->arena_list) {
+        js_slab_free_arena(rt, list_entry(el, JSSlabArena, link));
+    }
+    if (sa->hash)
+        js_slab_sys_free(rt, sa->hash);
+    sa->hash = NULL;
+    sa->hash_bits = 0;
+}
+
 void *js_malloc_rt(JSRuntime *rt, size_t size)
 {
+    void *ptr;
+    if ((size - 1) < JS_SLAB_MAX_ALLOC && (rt->slab.flags & JS_SLAB_ENABLED)) {
+        ptr = js_slab_malloc(rt, size);
+        /* if no arena can be allocated, use malloc() */
+        if (likely(ptr))
+            return ptr;
+    }
     return rt->mf.js_malloc(&rt->malloc_state, size);
 }
 
 void js_free_rt(JSRuntime *rt, void *ptr)
 {
+    JSSlab *s;
+    if (unlikely(js_nursery_contains(rt, ptr))) {
+        js_nursery_free(rt, ptr);
+        return;
+    }
+    s = js_slab_find(rt, ptr);
+    if (s) {
+        js_slab_free(rt, s, ptr);
+        return;
+    }
     rt->mf.js_free(&rt->malloc_state, ptr);
 }
 
 void *js_realloc_rt(JSRuntime *rt, void *ptr, size_t size)
 {
+    JSSlab *s;
+    if (unlikely(js_nursery_contains(rt, ptr)))
+        return js_nursery_realloc(rt, ptr, size);
+    s = js_slab_find(rt, ptr);
+    if (s)
+        return js_slab_realloc(rt, s, ptr, size);
     return rt->mf.js_realloc(&rt->malloc_state, ptr, size);
 }
 
 size_t js_malloc_usable_size_rt(JSRuntime *rt, const void *ptr)
 {
+    JSSlab *s;
+    if (js_nursery_contains(rt, ptr))
+        return 0;
+    s = js_slab_find(rt, ptr);
+    if (s)
+        return js_slab_class_size[s->class_idx];
     return rt->mf.js_malloc_usable_size(ptr);
 }
 
+
 void *js_mallocz_rt(JSRuntime *rt, size_t size)
 {
     void *ptr;
@@ -1478,7 +2319,7 @@ static void *js_realloc_bytecode_rt(void *opaque, void *ptr, size_t size)
            avoid some overflows. */
         return NULL;
     } else {
-        return rt->mf.js_realloc(&rt->malloc_state, ptr, size);
+        return js_realloc_rt(rt, ptr, size);
     }
 }
 
@@ -1595,6 +2436,7 @@ JSRuntime *JS_NewRuntime2(const JSMallocFunctions *mf, void *opaque)
 {
     JSRuntime *rt;
     JSMallocState ms;
+    int i;
 
     memset(&ms, 0, sizeof(ms));
     ms.opaque = opaque;
@@ -1617,11 +2459,19 @@ JSRuntime *JS_NewRuntime2(const JSMallocFunctions *mf, void *opaque)
     init_list_head(&rt->gc_zero_ref_count_list);
     rt->gc_phase = JS_GC_PHASE_NONE;
     init_list_head(&rt->weakref_list);
+    for(i = 0; i < JS_SLAB_CLASS_COUNT; i++)
+        init_list_head(&rt->slab.partial_list[i]);
+    init_list_head(&rt->slab.free_slab_list);
+    init_list_head(&rt->slab.arena_list);
+    rt->slab.arena_state.opaque = opaque;
+    rt->slab.arena_state.malloc_limit = -1;
 
 #ifdef DUMP_LEAKS
     init_list_head(&rt->string_list);
 #endif
     init_list_head(&rt->job_list);
+    init_list_head(&rt->regexp_cache_lru);
+    rt->regexp_cache_max_count = JS_REGEXP_CACHE_SIZE_DEFAULT;
 
     if (JS_InitAtoms(rt))
         goto fail;
@@ -1645,6 +2495,12 @@ JSRuntime *JS_NewRuntime2(const JSMallocFunctions *mf, void *opaque)
     JS_UpdateStackTop(rt);
 
     rt->current_exception = JS_UNINITIALIZED;
+    rt->ic_enabled = TRUE;
+    rt->lazy_compile_enabled = TRUE;
+#ifdef CONFIG_JIT
+    rt->jit_enabled = TRUE;
+    rt->jit_threshold = JS_JIT_THRESHOLD_DEFAULT;
+#endif
 
     return rt;
  fail:
@@ -1742,6 +2598,18 @@ static const JSMallocFunctions def_malloc_funcs = {
     js_def_malloc_usable_size,
 };
 
+/* The data of the transferred ArrayBuffers is allocated with malloc()
+   so that it does not depend on a runtime. */
+static uint8_t *js_transfer_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void js_transfer_free(JSRuntime *rt, void *opaque, void *ptr)
+{
+    free(ptr);
+}
+
 JSRuntime *JS_NewRuntime(void)
 {
     return JS_NewRuntime2(&def_malloc_funcs, NULL);
@@ -1758,6 +2626,66 @@ void JS_SetGCThreshold(JSRuntime *rt, size_t gc_threshold)
     rt->malloc_gc_threshold = gc_threshold;
 }
 
+/* When 'max_pause' (in microseconds) is not zero, the automatic
+   collection is done with JS_RunGCStep() steps of at most
+   'max_pause'. A full collection is still done when the heap size
+   doubles since the previous one. */
+void JS_SetGCMaxPause(JSRuntime *rt, int64_t max_pause)
+{
+    rt->gc_max_pause = max_int64(max_pause, 0);
+    rt->malloc_gc_full_threshold =
+        max_int64(rt->malloc_state.malloc_size, rt->malloc_gc_threshold) * 2;
+}
+
+int64_t JS_GetGCMaxPause(JSRuntime *rt)
+{
+    return rt->gc_max_pause;
+}
+
+/* Allocate a nursery of 'size' bytes for the short lived objects,
+   strings and small arrays. It must be called before the first
+   context is created. Return -1 if error, if there is already a
+   nursery or if a context was created. */
+int JS_SetNurserySize(JSRuntime *rt, size_t size)
+{
+    JSNursery *n = &rt->nursery;
+    int i, count;
+
+    if (n->base || !list_empty(&rt->context_list))
+        return -1;
+    count = min_int64(size, INT32_MAX) >> JS_NURSERY_CHUNK_BITS;
+    if (count == 0)
+        return 0;
+    n->base = js_malloc_rt(rt, (size_t)count << JS_NURSERY_CHUNK_BITS);
+    n->live_count = js_mallocz_rt(rt, sizeof(n->live_count[0]) * count);
+    n->free_chunks = js_malloc_rt(rt, sizeof(n->free_chunks[0]) * count);
+    n->block_size = js_mallocz_rt(rt, ((size_t)count << JS_NURSERY_CHUNK_BITS) >>
+                                  JS_NURSERY_UNIT_BITS);
+    if (!n->base || !n->live_count || !n->free_chunks || !n->block_size) {
+        js_free_rt(rt, n->base);
+        js_free_rt(rt, n->live_count);
+        js_free_rt(rt, n->free_chunks);
+        js_free_rt(rt, n->block_size);
+        memset(n, 0, sizeof(*n));
+        return -1;
+    }
+    /* the first chunks are used first */
+    for(i = 0; i < count; i++)
+        n->free_chunks[i] = count - 1 - i;
+    n->free_chunk_count = count;
+    n->chunk_count = count;
+    n->cur_chunk = -1;
+    n->size = (size_t)count << JS_NURSERY_CHUNK_BITS;
+    return 0;
+}
+
+/* The slab allocator can be enabled or disabled at any time: the
+   blocks are always freed by the allocator which returned them. */
+void JS_SetSlabAllocator(JSRuntime *rt, int flags)
+{
+    rt->slab.flags = flags;
+}
+
 #define malloc(s) malloc_is_forbidden(s)
 #define free(p) free_is_forbidden(p)
 #define realloc(p,s) realloc_is_forbidden(p,s)
@@ -1789,6 +2717,47 @@ int JS_GetStripInfo(JSRuntime *rt)
     return rt->strip_flags;
 }
 
+/* set the maximum number of entries of the compiled regexp cache. 0
+   disables the cache. The cache is flushed. */
+void JS_SetRegExpCacheSize(JSRuntime *rt, int max_count)
+{
+    js_regexp_cache_free(rt);
+    rt->regexp_cache_max_count = max_int(max_count, 0);
+}
+
+/* enable or disable the property access inline caches. The existing
+   caches are kept but no longer used when disabled. */
+void JS_SetInlineCacheEnabled(JSRuntime *rt, BOOL enabled)
+{
+    rt->ic_enabled = enabled;
+}
+
+/* enable or disable the lazy compilation of the nested functions. It
+   only applies to the scripts evaluated after the call. */
+void JS_SetLazyCompilationEnabled(JSRuntime *rt, BOOL enabled)
+{
+    rt->lazy_compile_enabled = enabled;
+}
+
+/* enable or disable the baseline JIT. The already compiled functions
+   are no longer entered when disabled. No effect if the JIT is not
+   compiled in. */
+void JS_SetJITEnabled(JSRuntime *rt, BOOL enabled)
+{
+#ifdef CONFIG_JIT
+    rt->jit_enabled = enabled;
+#endif
+}
+
+/* set the number of calls and loop iterations after which a function
+   is compiled to native code */
+void JS_SetJITThreshold(JSRuntime *rt, int threshold)
+{
+#ifdef CONFIG_JIT
+    rt->jit_threshold = max_int(threshold, 1);
+#endif
+}
+
 /* return 0 if OK, < 0 if exception */
 int JS_EnqueueJob(JSContext *ctx, JSJobFunc *job_func,
                   int argc, JSValueConst *argv)
@@ -1875,7 +2844,7 @@ static inline JSAtomStruct *atom_set_free(uint32_t v)
 static JSString *js_alloc_string_rt(JSRuntime *rt, int max_len, int is_wide_char)
 {
     JSString *str;
-    str = js_malloc_rt(rt, sizeof(JSString) + (max_len << is_wide_char) + 1 - is_wide_char);
+    str = js_malloc_nursery_rt(rt, sizeof(JSString) + (max_len << is_wide_char) + 1 - is_wide_char);
     if (unlikely(!str))
         return NULL;
     str->header.ref_count = 1;
@@ -1942,6 +2911,9 @@ void JS_FreeRuntime(JSRuntime *rt)
        FinalizationRegistry */
     JS_RunGCInternal(rt, FALSE);
 
+    js_regexp_cache_free(rt);
+    js_utf8_cache_free(rt);
+
 #ifdef DUMP_LEAKS
     /* leaking objects */
     {
@@ -2092,6 +3064,12 @@ void JS_FreeRuntime(JSRuntime *rt)
         if (rt->rt_info)
             printf("\n");
     }
+#endif
+
+    js_nursery_free_region(rt);
+    js_slab_free_all(rt);
+
+#ifdef DUMP_LEAKS
     {
         JSMallocState *s = &rt->malloc_state;
         if (s->malloc_count > 1) {
@@ -2110,7 +3088,8 @@ void JS_FreeRuntime(JSRuntime *rt)
     }
 }
 
-JSContext *JS_NewContextRaw(JSRuntime *rt)
+/* create a context without any object */
+static JSContext *js_new_context(JSRuntime *rt)
 {
     JSContext *ctx;
     int i;
@@ -2135,7 +3114,16 @@ JSContext *JS_NewContextRaw(JSRuntime *rt)
     ctx->regexp_ctor = JS_NULL;
     ctx->promise_ctor = JS_NULL;
     init_list_head(&ctx->loaded_modules);
+    return ctx;
+}
+
+JSContext *JS_NewContextRaw(JSRuntime *rt)
+{
+    JSContext *ctx;
 
+    ctx = js_new_context(rt);
+    if (!ctx)
+        return NULL;
     JS_AddIntrinsicBasicObjects(ctx);
     return ctx;
 }
@@ -2326,7 +3314,7 @@ void JS_FreeContext(JSContext *ctx)
     js_free_shape_null(ctx->rt, ctx->array_shape);
 
     list_del(&ctx->link);
-    remove_gc_object(&ctx->header);
+    remove_gc_object(rt, &ctx->header);
     js_free_rt(ctx->rt, ctx);
 }
 
@@ -2945,12 +3933,7 @@ static JSAtom JS_NewAtomStr(JSContext *ctx, JSString *p)
 /* XXX: optimize */
 static size_t count_ascii(const uint8_t *buf, size_t len)
 {
-    const uint8_t *p, *p_end;
-    p = buf;
-    p_end = buf + len;
-    while (p < p_end && *p < 128)
-        p++;
-    return p - buf;
+    return mem_ascii_len_u8(buf, len);
 }
 
 /* str is UTF-8 encoded */
@@ -3671,16 +4654,12 @@ static int string_getc(const JSString *p, int *pidx)
 
 static int string_buffer_write8(StringBuffer *s, const uint8_t *p, int len)
 {
-    int i;
-
     if (s->len + len > s->size) {
         if (string_buffer_realloc(s, s->len + len, 0))
             return -1;
     }
     if (s->is_wide_char) {
-        for (i = 0; i < len; i++) {
-            s->str->u.str16[s->len + i] = p[i];
-        }
+        mem_widen_u8(s->str->u.str16 + s->len, p, len);
         s->len += len;
     } else {
         memcpy(&s->str->u.str8[s->len], p, len);
@@ -3830,62 +4809,179 @@ static JSValue string_buffer_end(StringBuffer *s)
     return JS_MKPTR(JS_TAG_STRING, str);
 }
 
+/* reduce the length of a string allocated with js_alloc_string() */
+static JSString *js_string_shrink(JSRuntime *rt, JSString *str, int len)
+{
+    JSString *str1;
+
+    if (len < str->len) {
+#ifdef DUMP_LEAKS
+        list_del(&str->link);
+#endif
+        /* smaller size so js_realloc should not fail, but OK if it does */
+        str1 = js_realloc_rt(rt, str, sizeof(JSString) +
+                             (len << str->is_wide_char) + 1 - str->is_wide_char);
+        if (str1)
+            str = str1;
+#ifdef DUMP_LEAKS
+        list_add_tail(&str->link, &rt->string_list);
+#endif
+    }
+    if (!str->is_wide_char)
+        str->u.str8[len] = '\0';
+    str->len = len;
+    return str;
+}
+
+/* after this number of consecutive ASCII chars, the rest of the ASCII
+   run is copied with mem_ascii_len_x() */
+#define ASCII_RUN_MIN 16
+
+/* decode a non ASCII UTF-8 sequence at *pp. An invalid sequence gives
+   0xfffd. */
+static inline uint32_t utf8_decode_char(const uint8_t **pp, const uint8_t *p_end)
+{
+    const uint8_t *p = *pp, *p_next;
+    uint32_t c;
+
+    c = *p;
+    if (c >= 0xc2 && c <= 0xdf && (p_end - p) >= 2 && (p[1] & 0xc0) == 0x80) {
+        *pp = p + 2;
+        return ((c & 0x1f) << 6) | (p[1] & 0x3f);
+    }
+    /* parse utf-8 sequence, return 0xFFFFFFFF for error */
+    c = unicode_from_utf8(p, p_end - p, &p_next);
+    if (c <= 0x10FFFF) {
+        *pp = p_next;
+        return c;
+    }
+    /* skip the invalid chars */
+    /* XXX: seems incorrect. Why not just use c = *p++; ? */
+    while (p < p_end && (*p >= 0x80 && *p < 0xc0))
+        p++;
+    if (p < p_end) {
+        p++;
+        while (p < p_end && (*p >= 0x80 && *p < 0xc0))
+            p++;
+    }
+    *pp = p;
+    return 0xfffd;
+}
+
+/* decode the UTF-8 buffer [*pp, p_end) to 8 bit chars. Stop before
+   the first char >= 0x100. Return the number of chars. */
+static size_t utf8_decode8(uint8_t *dst, const uint8_t **pp,
+                           const uint8_t *p_end)
+{
+    const uint8_t *p = *pp, *p1;
+    uint8_t *q = dst;
+    size_t n;
+    uint32_t c;
+    int ascii_count = 0;
+
+    while (p < p_end) {
+        c = *p;
+        if (c < 0x80) {
+            *q++ = c;
+            p++;
+            if (unlikely(++ascii_count >= ASCII_RUN_MIN)) {
+                n = mem_ascii_len_u8(p, p_end - p);
+                memcpy(q, p, n);
+                q += n;
+                p += n;
+                ascii_count = 0;
+            }
+        } else {
+            ascii_count = 0;
+            p1 = p;
+            c = utf8_decode_char(&p, p_end);
+            if (c >= 0x100) {
+                p = p1;
+                break;
+            }
+            *q++ = c;
+        }
+    }
+    *pp = p;
+    return q - dst;
+}
+
+/* decode the UTF-8 buffer [p, p_end) to 16 bit chars. Return the
+   number of chars. */
+static size_t utf8_decode16(uint16_t *dst, const uint8_t *p,
+                            const uint8_t *p_end)
+{
+    uint16_t *q = dst;
+    size_t n;
+    uint32_t c;
+    int ascii_count = 0;
+
+    while (p < p_end) {
+        c = *p;
+        if (c < 0x80) {
+            *q++ = c;
+            p++;
+            if (unlikely(++ascii_count >= ASCII_RUN_MIN)) {
+                n = mem_ascii_len_u8(p, p_end - p);
+                mem_widen_u8(q, p, n);
+                q += n;
+                p += n;
+                ascii_count = 0;
+            }
+        } else {
+            ascii_count = 0;
+            c = utf8_decode_char(&p, p_end);
+            if (c >= 0x10000) {
+                /* surrogate pair */
+                *q++ = get_hi_surrogate(c);
+                c = get_lo_surrogate(c);
+            }
+            *q++ = c;
+        }
+    }
+    return q - dst;
+}
+
 /* create a string from a UTF-8 buffer */
 JSValue JS_NewStringLen(JSContext *ctx, const char *buf, size_t buf_len)
 {
-    const uint8_t *p, *p_end, *p_start, *p_next;
-    uint32_t c;
-    StringBuffer b_s, *b = &b_s;
-    size_t len1;
+    JSRuntime *rt = ctx->rt;
+    const uint8_t *p, *p_end;
+    JSString *str, *str16;
+    size_t len;
 
-    p_start = (const uint8_t *)buf;
-    p_end = p_start + buf_len;
-    len1 = count_ascii(p_start, buf_len);
-    p = p_start + len1;
-    if (len1 > JS_STRING_LEN_MAX)
-        return JS_ThrowInternalError(ctx, "string too long");
-    if (p == p_end) {
+    p = (const uint8_t *)buf;
+    p_end = p + buf_len;
+    len = count_ascii(p, buf_len);
+    if (len == buf_len) {
         /* ASCII string */
+        if (len > JS_STRING_LEN_MAX)
+            return JS_ThrowInternalError(ctx, "string too long");
         return js_new_string8_len(ctx, buf, buf_len);
-    } else {
-        if (string_buffer_init(ctx, b, buf_len))
-            goto fail;
-        string_buffer_write8(b, p_start, len1);
-        while (p < p_end) {
-            if (*p < 128) {
-                string_buffer_putc8(b, *p++);
-            } else {
-                /* parse utf-8 sequence, return 0xFFFFFFFF for error */
-                c = unicode_from_utf8(p, p_end - p, &p_next);
-                if (c < 0x10000) {
-                    p = p_next;
-                } else if (c <= 0x10FFFF) {
-                    p = p_next;
-                    /* surrogate pair */
-                    string_buffer_putc16(b, get_hi_surrogate(c));
-                    c = get_lo_surrogate(c);
-                } else {
-                    /* invalid char */
-                    c = 0xfffd;
-                    /* skip the invalid chars */
-                    /* XXX: seems incorrect. Why not just use c = *p++; ? */
-                    while (p < p_end && (*p >= 0x80 && *p < 0xc0))
-                        p++;
-                    if (p < p_end) {
-                        p++;
-                        while (p < p_end && (*p >= 0x80 && *p < 0xc0))
-                            p++;
-                    }
-                }
-                string_buffer_putc16(b, c);
-            }
+    }
+    /* there are at most buf_len chars */
+    if (buf_len > JS_STRING_LEN_MAX)
+        return JS_ThrowInternalError(ctx, "string too long");
+    str = js_alloc_string(ctx, buf_len, 0);
+    if (!str)
+        return JS_EXCEPTION;
+    memcpy(str->u.str8, p, len);
+    p += len;
+    len += utf8_decode8(str->u.str8 + len, &p, p_end);
+    if (p < p_end) {
+        /* 16 bit chars are needed */
+        str16 = js_alloc_string(ctx, buf_len, 1);
+        if (!str16) {
+            js_free_string(rt, str);
+            return JS_EXCEPTION;
         }
+        mem_widen_u8(str16->u.str16, str->u.str8, len);
+        js_free_string(rt, str);
+        str = str16;
+        len += utf8_decode16(str->u.str16 + len, p, p_end);
     }
-    return string_buffer_end(b);
-
- fail:
-    string_buffer_free(b);
-    return JS_EXCEPTION;
+    str = js_string_shrink(rt, str, len);
+    return JS_MKPTR(JS_TAG_STRING, str);
 }
 
 static JSValue JS_ConcatString3(JSContext *ctx, const char *str1,
@@ -3929,14 +5025,39 @@ JSValue JS_NewAtomString(JSContext *ctx, const char *str)
     return val;
 }
 
+static void js_utf8_cache_free(JSRuntime *rt)
+{
+    JSUTF8CacheEntry *e;
+    int i;
+
+    for(i = 0; i < JS_UTF8_CACHE_SIZE; i++) {
+        e = &rt->utf8_cache[i];
+        if (e->str) {
+            js_free_string(rt, e->str);
+            js_free_string(rt, e->utf8);
+            e->str = NULL;
+            e->utf8 = NULL;
+        }
+    }
+}
+
+static JSUTF8CacheEntry *js_utf8_cache_get(JSRuntime *rt, JSString *str)
+{
+    uintptr_t h = (uintptr_t)str;
+    h = (h >> 4) ^ (h >> 10);
+    return &rt->utf8_cache[h & (JS_UTF8_CACHE_SIZE - 1)];
+}
+
 /* return (NULL, 0) if exception. */
 /* return pointer into a JSString with a live ref_count */
 /* cesu8 determines if non-BMP1 codepoints are encoded as 1 or 2 utf-8 sequences */
 const char *JS_ToCStringLen2(JSContext *ctx, size_t *plen, JSValueConst val1, BOOL cesu8)
 {
+    JSRuntime *rt = ctx->rt;
     JSValue val;
     JSString *str, *str_new;
-    int pos, len, c, c1;
+    JSUTF8CacheEntry *e;
+    int pos, len, c, c1, n, ascii_count;
     uint8_t *q;
 
     if (JS_VALUE_GET_TAG(val1) != JS_TAG_STRING) {
@@ -3949,34 +5070,52 @@ const char *JS_ToCStringLen2(JSContext *ctx, size_t *plen, JSValueConst val1, BO
 
     str = JS_VALUE_GET_STRING(val);
     len = str->len;
+    n = 0;
     if (!str->is_wide_char) {
-        const uint8_t *src = str->u.str8;
-        int count;
-
-        /* count the number of non-ASCII characters */
-        /* Scanning the whole string is required for ASCII strings,
-           and computing the number of non-ASCII bytes is less expensive
-           than testing each byte, hence this method is faster for ASCII
-           strings, which is the most common case.
-         */
-        count = 0;
-        for (pos = 0; pos < len; pos++) {
-            count += src[pos] >> 7;
-        }
-        if (count == 0) {
+        /* count the number of non-ASCII characters. An ASCII string
+           is returned as is. */
+        n = mem_count_non_ascii_u8(str->u.str8, len);
+        if (n == 0) {
             if (plen)
                 *plen = len;
-            return (const char *)src;
+            return (const char *)str->u.str8;
         }
-        str_new = js_alloc_string(ctx, len + count, 0);
+        n += len;
+    }
+
+    /* the same string is often converted several times */
+    e = NULL;
+    if (len <= JS_UTF8_CACHE_MAX_LEN) {
+        e = js_utf8_cache_get(rt, str);
+        if (e->str == str && e->cesu8 == cesu8) {
+            str_new = e->utf8;
+            str_new->header.ref_count++;
+            goto done;
+        }
+    }
+
+    if (!str->is_wide_char) {
+        const uint8_t *src = str->u.str8;
+
+        str_new = js_alloc_string(ctx, n, 0);
         if (!str_new)
             goto fail;
         q = str_new->u.str8;
-        for (pos = 0; pos < len; pos++) {
-            c = src[pos];
+        pos = 0;
+        ascii_count = 0;
+        while (pos < len) {
+            c = src[pos++];
             if (c < 0x80) {
                 *q++ = c;
+                if (unlikely(++ascii_count >= ASCII_RUN_MIN)) {
+                    n = mem_ascii_len_u8(src + pos, len - pos);
+                    memcpy(q, src + pos, n);
+                    q += n;
+                    pos += n;
+                    ascii_count = 0;
+                }
             } else {
+                ascii_count = 0;
                 *q++ = (c >> 6) | 0xc0;
                 *q++ = (c & 0x3f) | 0x80;
             }
@@ -3984,45 +5123,79 @@ const char *JS_ToCStringLen2(JSContext *ctx, size_t *plen, JSValueConst val1, BO
     } else {
         const uint16_t *src = str->u.str16;
         /* Allocate 3 bytes per 16 bit code point. Surrogate pairs may
-           produce 4 bytes but use 2 code points.
+           produce 4 bytes but use 2 code points. The string is
+           reallocated at the end.
          */
         str_new = js_alloc_string(ctx, len * 3, 0);
         if (!str_new)
             goto fail;
         q = str_new->u.str8;
         pos = 0;
+        ascii_count = 0;
         while (pos < len) {
             c = src[pos++];
             if (c < 0x80) {
                 *q++ = c;
-            } else {
-                if (is_hi_surrogate(c)) {
-                    if (pos < len && !cesu8) {
-                        c1 = src[pos];
-                        if (is_lo_surrogate(c1)) {
-                            pos++;
-                            c = from_surrogate(c, c1);
-                        } else {
-                            /* Keep unmatched surrogate code points */
-                            /* c = 0xfffd; */ /* error */
-                        }
+                if (unlikely(++ascii_count >= ASCII_RUN_MIN)) {
+                    n = mem_ascii_len_u16(src + pos, len - pos);
+                    mem_narrow_u16(q, src + pos, n);
+                    q += n;
+                    pos += n;
+                    ascii_count = 0;
+                }
+                continue;
+            }
+            ascii_count = 0;
+            if (c < 0x800) {
+                *q++ = (c >> 6) | 0xc0;
+                *q++ = (c & 0x3f) | 0x80;
+                continue;
+            }
+            if (is_hi_surrogate(c)) {
+                if (pos < len && !cesu8) {
+                    c1 = src[pos];
+                    if (is_lo_surrogate(c1)) {
+                        pos++;
+                        c = from_surrogate(c, c1);
                     } else {
                         /* Keep unmatched surrogate code points */
                         /* c = 0xfffd; */ /* error */
                     }
+                } else {
+                    /* Keep unmatched surrogate code points */
+                    /* c = 0xfffd; */ /* error */
                 }
-                q += unicode_to_utf8(q, c);
             }
+            q += unicode_to_utf8(q, c);
         }
     }
+    if (e) {
+        /* the cached strings should not waste memory */
+        str_new = js_string_shrink(rt, str_new, q - str_new->u.str8);
+    } else {
+        *q = '\0';
+        str_new->len = q - str_new->u.str8;
+    }
 
-    *q = '\0';
-    str_new->len = q - str_new->u.str8;
+    if (e) {
+        /* the cache keeps a reference to both strings */
+        if (e->str) {
+            js_free_string(rt, e->str);
+            js_free_string(rt, e->utf8);
+        }
+        e->str = str;
+        e->utf8 = str_new;
+        e->cesu8 = cesu8;
+        str_new->header.ref_count++;
+        val = JS_UNDEFINED;
+    }
+ done:
     JS_FreeValue(ctx, val);
     if (plen)
         *plen = str_new->len;
     return (const char *)str_new->u.str8;
  fail:
+    JS_FreeValue(ctx, val);
     if (plen)
         *plen = 0;
     return NULL;
@@ -4720,6 +5893,10 @@ static no_inline JSShape *js_new_shape2(JSContext *ctx, JSObject *proto,
     sh->prop_size = prop_size;
     sh->prop_count = 0;
     sh->deleted_prop_count = 0;
+    sh->transition_parent = NULL;
+    sh->transition_first_child = NULL;
+    sh->transition_next = NULL;
+    sh->inline_prop_hint = 0;
 
     /* insert in the hash table */
     sh->hash = shape_initial_hash(proto);
@@ -4756,6 +5933,9 @@ static JSShape *js_clone_shape(JSContext *ctx, JSShape *sh1)
     sh->header.ref_count = 1;
     add_gc_object(ctx->rt, &sh->header, JS_GC_OBJ_TYPE_SHAPE);
     sh->is_hashed = FALSE;
+    sh->transition_parent = NULL;
+    sh->transition_first_child = NULL;
+    sh->transition_next = NULL;
     if (sh->proto) {
         JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
     }
@@ -4771,14 +5951,44 @@ static JSShape *js_dup_shape(JSShape *sh)
     return sh;
 }
 
+static void js_free_shape(JSRuntime *rt, JSShape *sh);
+
+static void js_shape_transition_link(JSShape *parent, JSShape *sh)
+{
+    sh->transition_parent = js_dup_shape(parent);
+    sh->transition_next = parent->transition_first_child;
+    parent->transition_first_child = sh;
+}
+
+/* remove 'sh' from the children of its transition parent */
+static void js_shape_transition_unlink(JSRuntime *rt, JSShape *sh)
+{
+    JSShape *parent, **psh;
+
+    parent = sh->transition_parent;
+    if (!parent)
+        return;
+    psh = &parent->transition_first_child;
+    while (*psh != sh)
+        psh = &(*psh)->transition_next;
+    *psh = sh->transition_next;
+    sh->transition_parent = NULL;
+    sh->transition_next = NULL;
+    js_free_shape(rt, parent);
+}
+
 static void js_free_shape0(JSRuntime *rt, JSShape *sh)
 {
     uint32_t i;
     JSShapeProperty *pr;
 
     assert(sh->header.ref_count == 0);
+    /* the children hold a reference to their parent */
+    assert(sh->transition_first_child == NULL);
     if (sh->is_hashed)
         js_shape_hash_unlink(rt, sh);
+    /* may free the parent if it has no other reference */
+    js_shape_transition_unlink(rt, sh);
     if (sh->proto != NULL) {
         JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
     }
@@ -4787,7 +5997,7 @@ static void js_free_shape0(JSRuntime *rt, JSShape *sh)
         JS_FreeAtomRT(rt, pr->atom);
         pr++;
     }
-    remove_gc_object(&sh->header);
+    remove_gc_object(rt, &sh->header);
     js_free_rt(rt, get_alloc_from_shape(sh));
 }
 
@@ -4804,6 +6014,95 @@ static void js_free_shape_null(JSRuntime *rt, JSShape *sh)
         js_free_shape(rt, sh);
 }
 
+/* same multiplier as shape_hash() */
+static inline uint32_t js_ic_hash(uint32_t pc_pos, int hash_bits)
+{
+    return (pc_pos * 0x9e370001) >> (32 - hash_bits);
+}
+
+static void js_ic_free_entry(JSRuntime *rt, JSInlineCacheEntry *e)
+{
+    int i;
+    js_free_shape(rt, e->shape);
+    for(i = 0; i < e->depth; i++)
+        js_free_shape(rt, e->proto_shape[i]);
+}
+
+static void js_ic_free_site(JSRuntime *rt, JSInlineCacheSite *site)
+{
+    int i;
+    for(i = 0; i < site->count; i++)
+        js_ic_free_entry(rt, &site->entries[i]);
+    site->count = 0;
+}
+
+static void js_free_inline_cache(JSRuntime *rt, JSInlineCache *ic)
+{
+    int i;
+    for(i = 0; i < ic->count; i++)
+        js_ic_free_site(rt, &ic->sites[i]);
+    js_free_rt(rt, ic);
+}
+
+static void js_mark_inline_cache(JSRuntime *rt, JSInlineCache *ic,
+                                 JS_MarkFunc *mark_func)
+{
+    JSInlineCacheSite *site;
+    JSInlineCacheEntry *e;
+    int i, j, k;
+
+    for(i = 0; i < ic->count; i++) {
+        site = &ic->sites[i];
+        for(j = 0; j < site->count; j++) {
+            e = &site->entries[j];
+            mark_func(rt, &e->shape->header);
+            for(k = 0; k < e->depth; k++)
+                mark_func(rt, &e->proto_shape[k]->header);
+        }
+    }
+}
+
+/* the objects built from the initial shape of 'p' will have at
+   least 'count' inline property slots */
+static void js_update_inline_prop_hint(JSObject *p, uint32_t count)
+{
+    JSShape *sh;
+
+    /* find the initial shape */
+    for(sh = p->shape; sh->transition_parent != NULL;
+        sh = sh->transition_parent)
+        continue;
+    if (sh->is_hashed && sh->prop_count == 0 &&
+        count > sh->inline_prop_hint) {
+        sh->inline_prop_hint = min_uint32(count, JS_INLINE_PROP_MAX);
+    }
+}
+
+/* resize the property array of 'p' to 'size' elements. 'count' is
+   the number of used elements. */
+static int js_resize_object_prop(JSContext *ctx, JSObject *p,
+                                 uint32_t count, uint32_t size)
+{
+    JSProperty *new_prop;
+
+    if (p->prop == p->inline_prop) {
+        if (size <= p->inline_prop_size)
+            return 0;
+        /* move the properties out of the object */
+        new_prop = js_malloc(ctx, sizeof(new_prop[0]) * size);
+        if (unlikely(!new_prop))
+            return -1;
+        memcpy(new_prop, p->prop, sizeof(new_prop[0]) * count);
+        js_update_inline_prop_hint(p, count + 1);
+    } else {
+        new_prop = js_realloc(ctx, p->prop, sizeof(new_prop[0]) * size);
+        if (unlikely(!new_prop))
+            return -1;
+    }
+    p->prop = new_prop;
+    return 0;
+}
+
 /* make space to hold at least 'count' properties */
 static no_inline int resize_properties(JSContext *ctx, JSShape **psh,
                                        JSObject *p, uint32_t count)
@@ -4820,11 +6119,8 @@ static no_inline int resize_properties(JSContext *ctx, JSShape **psh,
     /* Reallocate prop array first to avoid crash or size inconsistency
        in case of memory allocation failure */
     if (p) {
-        JSProperty *new_prop;
-        new_prop = js_realloc(ctx, p->prop, sizeof(new_prop[0]) * new_size);
-        if (unlikely(!new_prop))
+        if (unlikely(js_resize_object_prop(ctx, p, sh->prop_count, new_size)))
             return -1;
-        p->prop = new_prop;
     }
     new_hash_size = sh->prop_hash_mask + 1;
     while (new_hash_size < new_size)
@@ -4832,6 +6128,8 @@ static no_inline int resize_properties(JSContext *ctx, JSShape **psh,
     /* resize the property shapes. Using js_realloc() is not possible in
        case the GC runs during the allocation */
     old_sh = sh;
+    /* the shape is moved, so it must not be in the transition tree */
+    assert(!old_sh->transition_parent && !old_sh->transition_first_child);
     sh_alloc = js_malloc(ctx, get_shape_size(new_hash_size, new_size));
     if (!sh_alloc)
         return -1;
@@ -4874,7 +6172,7 @@ static int compact_properties(JSContext *ctx, JSObject *p)
     intptr_t h;
     uint32_t new_hash_size, i, j, new_hash_mask, new_size;
     JSShapeProperty *old_pr, *pr;
-    JSProperty *prop, *new_prop;
+    JSProperty *prop;
 
     sh = p->shape;
     assert(!sh->is_hashed);
@@ -4927,10 +6225,9 @@ static int compact_properties(JSContext *ctx, JSObject *p)
     p->shape = sh;
     js_free(ctx, get_alloc_from_shape(old_sh));
 
-    /* reduce the size of the object properties */
-    new_prop = js_realloc(ctx, p->prop, sizeof(new_prop[0]) * new_size);
-    if (new_prop)
-        p->prop = new_prop;
+    /* reduce the size of the object properties (failure is not an
+       error) */
+    js_resize_object_prop(ctx, p, j, new_size);
     return 0;
 }
 
@@ -4945,6 +6242,8 @@ static int add_shape_property(JSContext *ctx, JSShape **psh,
 
     /* update the shape hash */
     if (sh->is_hashed) {
+        /* the shape no longer matches its transition */
+        js_shape_transition_unlink(rt, sh);
         js_shape_hash_unlink(rt, sh);
         new_shape_hash = shape_hash(shape_hash(sh->hash, atom), prop_flags);
     }
@@ -4997,6 +6296,28 @@ static JSShape *find_hashed_shape_proto(JSRuntime *rt, JSObject *proto)
     return NULL;
 }
 
+/* find the transition of 'sh' adding (atom, prop_flags). Return NULL
+   if not found. '*pfan_out' is set to the number of transitions of
+   'sh'. */
+static inline JSShape *find_shape_transition(JSShape *sh, JSAtom atom,
+                                             int prop_flags, int *pfan_out)
+{
+    JSShape *sh1;
+    JSShapeProperty *pr;
+    int n;
+
+    n = 0;
+    for(sh1 = sh->transition_first_child; sh1 != NULL;
+        sh1 = sh1->transition_next) {
+        pr = &sh1->prop[sh1->prop_count - 1];
+        if (pr->atom == atom && pr->flags == prop_flags)
+            return sh1;
+        n++;
+    }
+    *pfan_out = n;
+    return NULL;
+}
+
 /* find a hashed shape matching sh + (prop, prop_flags). Return NULL if
    not found */
 static JSShape *find_hashed_shape_prop(JSRuntime *rt, JSShape *sh,
@@ -5078,11 +6399,21 @@ static __maybe_unused void JS_DumpShapes(JSRuntime *rt)
 static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID class_id)
 {
     JSObject *p;
+    int inline_size;
 
-    js_trigger_gc(ctx->rt, sizeof(JSObject));
-    p = js_malloc(ctx, sizeof(JSObject));
-    if (unlikely(!p))
+    /* the properties are stored after the object if they fit */
+    inline_size = 0;
+    if (sh->prop_size <= JS_INLINE_PROP_MAX) {
+        inline_size = sh->prop_size;
+        if (sh->prop_count == 0)
+            inline_size = max_int(inline_size, sh->inline_prop_hint);
+    }
+    js_trigger_gc(ctx->rt, sizeof(JSObject) + sizeof(JSProperty) * inline_size);
+    p = js_malloc_nursery_rt(ctx->rt, sizeof(JSObject) + sizeof(JSProperty) * inline_size);
+    if (unlikely(!p)) {
+        JS_ThrowOutOfMemory(ctx);
         goto fail;
+    }
     p->class_id = class_id;
     p->extensible = TRUE;
     p->free_mark = 0;
@@ -5095,12 +6426,18 @@ static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID clas
     p->weakref_count = 0;
     p->u.opaque = NULL;
     p->shape = sh;
-    p->prop = js_malloc(ctx, sizeof(JSProperty) * sh->prop_size);
-    if (unlikely(!p->prop)) {
-        js_free(ctx, p);
-    fail:
-        js_free_shape(ctx->rt, sh);
-        return JS_EXCEPTION;
+    p->inline_prop_size = inline_size;
+    p->array_kind = JS_ARRAY_KIND_GENERIC;
+    if (inline_size != 0) {
+        p->prop = p->inline_prop;
+    } else {
+        p->prop = js_malloc(ctx, sizeof(JSProperty) * sh->prop_size);
+        if (unlikely(!p->prop)) {
+            js_free(ctx, p);
+        fail:
+            js_free_shape(ctx->rt, sh);
+            return JS_EXCEPTION;
+        }
     }
 
     switch(class_id) {
@@ -5111,6 +6448,7 @@ static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID clas
             JSProperty *pr;
             p->is_exotic = 1;
             p->fast_array = 1;
+            p->array_kind = JS_ARRAY_KIND_INT32;
             p->u.array.u.values = NULL;
             p->u.array.count = 0;
             p->u.array.u1.size = 0;
@@ -5162,6 +6500,9 @@ static JSValue JS_NewObjectFromShape(JSContext *ctx, JSShape *sh, JSClassID clas
     case JS_CLASS_REGEXP:
         p->u.regexp.pattern = NULL;
         p->u.regexp.bytecode = NULL;
+#ifdef CONFIG_REGEXP_JIT
+        p->u.regexp.jit = 0;
+#endif
         goto set_exotic;
     default:
     set_exotic:
@@ -5590,19 +6931,125 @@ static void free_var_ref(JSRuntime *rt, JSVarRef *var_ref)
                 if (var_ref->async_func)
                     async_func_free(rt, var_ref->async_func);
             }
-            remove_gc_object(&var_ref->header);
+            remove_gc_object(rt, &var_ref->header);
             js_free_rt(rt, var_ref);
         }
     }
 }
 
+static inline int js_array_elem_size(int kind)
+{
+    static const uint8_t elem_size[] = {
+        sizeof(int32_t), sizeof(double), sizeof(JSValue)
+    };
+    return elem_size[kind];
+}
+
+/* return the most specific element kind which can hold 'val' */
+static inline int js_array_value_kind(JSValueConst val)
+{
+    uint32_t tag = JS_VALUE_GET_TAG(val);
+    if (tag == JS_TAG_INT)
+        return JS_ARRAY_KIND_INT32;
+    else if (JS_TAG_IS_FLOAT64(tag))
+        return JS_ARRAY_KIND_FLOAT64;
+    else
+        return JS_ARRAY_KIND_GENERIC;
+}
+
+/* return the element 'idx' of the fast array 'p' (idx < p->u.array.count) */
+static inline JSValue js_array_get_element(JSContext *ctx, JSObject *p,
+                                           uint32_t idx)
+{
+    switch(p->array_kind) {
+    case JS_ARRAY_KIND_INT32:
+        return JS_NewInt32(ctx, p->u.array.u.int32_ptr[idx]);
+    case JS_ARRAY_KIND_FLOAT64:
+        return JS_NewFloat64(ctx, p->u.array.u.double_ptr[idx]);
+    default:
+        return JS_DupValue(ctx, p->u.array.u.values[idx]);
+    }
+}
+
+/* convert the elements of the fast array 'p' to the more general kind
+   'kind'. The conversion is done in place from the last element
+   because the new elements are larger. */
+static no_inline int js_array_convert_kind(JSContext *ctx, JSObject *p,
+                                           int kind)
+{
+    uint32_t i, size;
+    void *ptr;
+
+    assert(kind > p->array_kind);
+    size = p->u.array.u1.size;
+    if (size != 0) {
+        ptr = js_realloc(ctx, p->u.array.u.ptr, size * js_array_elem_size(kind));
+        if (!ptr)
+            return -1;
+        p->u.array.u.ptr = ptr;
+    }
+    i = p->u.array.count;
+    if (p->array_kind == JS_ARRAY_KIND_INT32) {
+        int32_t *tab = p->u.array.u.int32_ptr;
+        if (kind == JS_ARRAY_KIND_FLOAT64) {
+            while (i-- > 0)
+                p->u.array.u.double_ptr[i] = tab[i];
+        } else {
+            while (i-- > 0)
+                p->u.array.u.values[i] = JS_NewInt32(ctx, tab[i]);
+        }
+    } else {
+        double *tab = p->u.array.u.double_ptr;
+        while (i-- > 0)
+            p->u.array.u.values[i] = JS_NewFloat64(ctx, tab[i]);
+    }
+    p->array_kind = kind;
+    return 0;
+}
+
+/* set the element 'idx' of the fast array 'p' (idx <
+   p->u.array.count). 'val' is freed. Return -1 if memory error. */
+static int js_array_set_element(JSContext *ctx, JSObject *p, uint32_t idx,
+                                JSValue val)
+{
+    uint32_t tag = JS_VALUE_GET_TAG(val);
+
+    switch(p->array_kind) {
+    case JS_ARRAY_KIND_INT32:
+        if (likely(tag == JS_TAG_INT)) {
+            p->u.array.u.int32_ptr[idx] = JS_VALUE_GET_INT(val);
+            return 0;
+        }
+        break;
+    case JS_ARRAY_KIND_FLOAT64:
+        if (tag == JS_TAG_INT) {
+            p->u.array.u.double_ptr[idx] = JS_VALUE_GET_INT(val);
+            return 0;
+        } else if (JS_TAG_IS_FLOAT64(tag)) {
+            p->u.array.u.double_ptr[idx] = JS_VALUE_GET_FLOAT64(val);
+            return 0;
+        }
+        break;
+    default:
+        set_value(ctx, &p->u.array.u.values[idx], val);
+        return 0;
+    }
+    if (js_array_convert_kind(ctx, p, js_array_value_kind(val))) {
+        JS_FreeValue(ctx, val);
+        return -1;
+    }
+    return js_array_set_element(ctx, p, idx, val);
+}
+
 static void js_array_finalizer(JSRuntime *rt, JSValue val)
 {
     JSObject *p = JS_VALUE_GET_OBJ(val);
     int i;
 
-    for(i = 0; i < p->u.array.count; i++) {
-        JS_FreeValueRT(rt, p->u.array.u.values[i]);
+    if (p->array_kind == JS_ARRAY_KIND_GENERIC) {
+        for(i = 0; i < p->u.array.count; i++) {
+            JS_FreeValueRT(rt, p->u.array.u.values[i]);
+        }
     }
     js_free_rt(rt, p->u.array.u.values);
 }
@@ -5613,8 +7060,10 @@ static void js_array_mark(JSRuntime *rt, JSValueConst val,
     JSObject *p = JS_VALUE_GET_OBJ(val);
     int i;
 
-    for(i = 0; i < p->u.array.count; i++) {
-        JS_MarkValue(rt, p->u.array.u.values[i], mark_func);
+    if (p->array_kind == JS_ARRAY_KIND_GENERIC) {
+        for(i = 0; i < p->u.array.count; i++) {
+            JS_MarkValue(rt, p->u.array.u.values[i], mark_func);
+        }
     }
 }
 
@@ -5766,7 +7215,8 @@ static void free_object(JSRuntime *rt, JSObject *p)
         free_property(rt, &p->prop[i], pr->flags);
         pr++;
     }
-    js_free_rt(rt, p->prop);
+    if (p->prop != p->inline_prop)
+        js_free_rt(rt, p->prop);
     /* as an optimization we destroy the shape immediately without
        putting it in gc_zero_ref_count_list */
     js_free_shape(rt, sh);
@@ -5785,7 +7235,7 @@ static void free_object(JSRuntime *rt, JSObject *p)
     p->u.func.var_refs = NULL;
     p->u.func.home_object = NULL;
 
-    remove_gc_object(&p->header);
+    remove_gc_object(rt, &p->header);
     if (rt->gc_phase == JS_GC_PHASE_REMOVE_CYCLES) {
         if (p->header.ref_count == 0 && p->weakref_count == 0) {
             js_free_rt(rt, p);
@@ -5824,6 +7274,17 @@ static void free_gc_object(JSRuntime *rt, JSGCObjectHeader *gp)
     }
 }
 
+/* Called when a GC object which is not part of the freed cycles
+   reaches a zero reference count while the cycles are freed. It
+   happens after an incremental step because only a subset of the
+   objects is examined. The object is freed with the cycles. */
+static void gc_free_cycles_add(JSRuntime *rt, JSGCObjectHeader *p)
+{
+    list_del(&p->link);
+    list_add_tail(&p->link, &rt->tmp_obj_list);
+    p->mark = 1;
+}
+
 static void free_zero_refcount(JSRuntime *rt)
 {
     struct list_head *el;
@@ -5893,6 +7354,8 @@ void __JS_FreeValueRT(JSRuntime *rt, JSValue v)
                 if (rt->gc_phase == JS_GC_PHASE_NONE) {
                     free_zero_refcount(rt);
                 }
+            } else if (p->mark == 0) {
+                gc_free_cycles_add(rt, p);
             }
         }
         break;
@@ -5920,6 +7383,13 @@ void __JS_FreeValue(JSContext *ctx, JSValue v)
 
 /* garbage collection */
 
+static int64_t gc_get_time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
 static void gc_remove_weak_objects(JSRuntime *rt)
 {
     struct list_head *el;
@@ -5956,11 +7426,13 @@ static void add_gc_object(JSRuntime *rt, JSGCObjectHeader *h,
     h->mark = 0;
     h->gc_obj_type = type;
     list_add_tail(&h->link, &rt->gc_obj_list);
+    rt->gc_obj_count++;
 }
 
-static void remove_gc_object(JSGCObjectHeader *h)
+static void remove_gc_object(JSRuntime *rt, JSGCObjectHeader *h)
 {
     list_del(&h->link);
+    rt->gc_obj_count--;
 }
 
 void JS_MarkValue(JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark_func)
@@ -6033,6 +7505,10 @@ static void mark_children(JSRuntime *rt, JSGCObjectHeader *gp,
             }
             if (b->realm)
                 mark_func(rt, &b->realm->header);
+            if (b->ic)
+                js_mark_inline_cache(rt, b->ic, mark_func);
+            if (b->lazy && b->lazy->compiled)
+                mark_func(rt, &b->lazy->compiled->header);
         }
         break;
     case JS_GC_OBJ_TYPE_VAR_REF:
@@ -6074,6 +7550,9 @@ static void mark_children(JSRuntime *rt, JSGCObjectHeader *gp,
             if (sh->proto != NULL) {
                 mark_func(rt, &sh->proto->header);
             }
+            if (sh->transition_parent != NULL) {
+                mark_func(rt, &sh->transition_parent->header);
+            }
         }
         break;
     case JS_GC_OBJ_TYPE_JS_CONTEXT:
@@ -6221,6 +7700,17 @@ static void gc_free_cycles(JSRuntime *rt)
     init_list_head(&rt->gc_zero_ref_count_list);
 }
 
+static int js_shape_transition_fan_out(JSShape *sh)
+{
+    JSShape *sh1;
+    int n = 0;
+    for(sh1 = sh->transition_first_child; sh1 != NULL;
+        sh1 = sh1->transition_next) {
+        n++;
+    }
+    return n;
+}
+
 static void JS_RunGCInternal(JSRuntime *rt, BOOL remove_weak_objects)
 {
     if (remove_weak_objects) {
@@ -6246,6 +7736,159 @@ void JS_RunGC(JSRuntime *rt)
     JS_RunGCInternal(rt, TRUE);
 }
 
+/* Incremental collection: each step runs the cycle removal algorithm
+   on a bounded subset of the GC objects: the objects at the end of
+   gc_obj_list, i.e. the most recently allocated ones, and the objects
+   they reference. Since the references coming from outside the
+   subset are not decremented, the objects found dead are really
+   unreachable. A step is done atomically, so no write barrier is
+   needed. The surviving objects are moved to the head of gc_obj_list
+   so that the next steps examine the other objects. The weak
+   references are only cleared by JS_RunGC(). */
+
+#define JS_GC_STEP_SEEDS       256  /* objects taken from gc_obj_list */
+#define JS_GC_STEP_MAX_OBJECTS 4096 /* maximum size of the subset */
+
+/* mark = 2 for the objects of the subset */
+static void gc_step_add(JSRuntime *rt, JSGCObjectHeader *p)
+{
+    p->mark = 2;
+    list_del(&p->link);
+    list_add_tail(&p->link, &rt->gc_step_list);
+    rt->gc_step_count++;
+}
+
+/* The contexts and the shapes are not followed because they lead to
+   the prototypes and global objects which are large and seldom part
+   of garbage cycles. */
+static void gc_step_add_child(JSRuntime *rt, JSGCObjectHeader *p)
+{
+    if (p->mark == 0 && rt->gc_step_count < JS_GC_STEP_MAX_OBJECTS &&
+        p->gc_obj_type != JS_GC_OBJ_TYPE_JS_CONTEXT &&
+        p->gc_obj_type != JS_GC_OBJ_TYPE_SHAPE)
+        gc_step_add(rt, p);
+}
+
+static void gc_step_decref_child(JSRuntime *rt, JSGCObjectHeader *p)
+{
+    if (p->mark == 2) {
+        assert(p->ref_count > 0);
+        p->ref_count--;
+    }
+}
+
+static void gc_step_incref_child(JSRuntime *rt, JSGCObjectHeader *p)
+{
+    if (p->mark == 2) {
+        p->ref_count++;
+        if (p->ref_count == 1) {
+            /* ref_count was 0: the object is alive */
+            list_del(&p->link);
+            list_add_tail(&p->link, &rt->gc_step_list);
+        }
+    }
+}
+
+static void gc_step_incref_child2(JSRuntime *rt, JSGCObjectHeader *p)
+{
+    if (p->mark == 2)
+        p->ref_count++;
+}
+
+/* return the number of objects taken from the end of gc_obj_list */
+static int gc_step(JSRuntime *rt)
+{
+    struct list_head *el, *el1;
+    JSGCObjectHeader *p;
+    int n;
+
+    init_list_head(&rt->gc_step_list);
+    init_list_head(&rt->tmp_obj_list);
+    rt->gc_step_count = 0;
+    for(n = 0; n < JS_GC_STEP_SEEDS; n++) {
+        el = rt->gc_obj_list.prev;
+        if (el == &rt->gc_obj_list)
+            break;
+        p = list_entry(el, JSGCObjectHeader, link);
+        assert(p->mark == 0);
+        gc_step_add(rt, p);
+    }
+    /* add the referenced objects so that the cycles are found */
+    list_for_each(el, &rt->gc_step_list) {
+        if (rt->gc_step_count >= JS_GC_STEP_MAX_OBJECTS)
+            break;
+        p = list_entry(el, JSGCObjectHeader, link);
+        mark_children(rt, p, gc_step_add_child);
+    }
+
+    /* decrement the references inside the subset */
+    list_for_each(el, &rt->gc_step_list) {
+        p = list_entry(el, JSGCObjectHeader, link);
+        mark_children(rt, p, gc_step_decref_child);
+    }
+    list_for_each_safe(el, el1, &rt->gc_step_list) {
+        p = list_entry(el, JSGCObjectHeader, link);
+        if (p->ref_count == 0) {
+            list_del(&p->link);
+            list_add_tail(&p->link, &rt->tmp_obj_list);
+        }
+    }
+
+    /* keep the objects with a refcount > 0 and their children */
+    list_for_each(el, &rt->gc_step_list) {
+        p = list_entry(el, JSGCObjectHeader, link);
+        mark_children(rt, p, gc_step_incref_child);
+    }
+    list_for_each(el, &rt->tmp_obj_list) {
+        p = list_entry(el, JSGCObjectHeader, link);
+        mark_children(rt, p, gc_step_incref_child2);
+    }
+
+    /* move the live objects to the head of gc_obj_list */
+    for(;;) {
+        el = rt->gc_step_list.next;
+        if (el == &rt->gc_step_list)
+            break;
+        p = list_entry(el, JSGCObjectHeader, link);
+        p->mark = 0;
+        list_del(&p->link);
+        list_add(&p->link, &rt->gc_obj_list);
+    }
+
+    if (!list_empty(&rt->tmp_obj_list)) {
+        list_for_each(el, &rt->tmp_obj_list) {
+            p = list_entry(el, JSGCObjectHeader, link);
+            p->mark = 1;
+        }
+        gc_free_cycles(rt);
+    }
+    return n;
+}
+
+/* run steps until 'count' objects are examined or 'budget'
+   microseconds are elapsed (at least one step is done) */
+static void gc_run_steps(JSRuntime *rt, int count, int64_t budget)
+{
+    int64_t end_time;
+
+    if (rt->gc_phase != JS_GC_PHASE_NONE)
+        return;
+    end_time = gc_get_time_us() + budget;
+    for(;;) {
+        count -= gc_step(rt);
+        if (count <= 0 || gc_get_time_us() >= end_time)
+            break;
+    }
+    rt->gc_step_obj_count = rt->gc_obj_count;
+}
+
+/* Run incremental collection steps during about 'budget'
+   microseconds. At most one pass over the GC objects is done. */
+void JS_RunGCStep(JSRuntime *rt, int64_t budget)
+{
+    gc_run_steps(rt, rt->gc_obj_count, budget);
+}
+
 /* Return false if not an object or if the object has already been
    freed (zombie objects are visible in finalizers when freeing
    cycles). */
@@ -6302,9 +7945,25 @@ static void compute_bytecode_size(JSFunctionBytecode *b, JSMemoryUsage_helper *h
     if (b->closure_var) {
         js_func_size += b->closure_var_count * sizeof(*b->closure_var);
     }
+    if (b->ic) {
+        memory_used_count++;
+        js_func_size += sizeof(*b->ic) + b->ic->count * sizeof(b->ic->sites[0]) +
+            (sizeof(b->ic->hash[0]) << b->ic->hash_bits);
+    }
+#ifdef CONFIG_JIT
+    if (b->jit) {
+        memory_used_count += 2;
+        js_func_size += sizeof(*b->jit) + b->byte_code_len * sizeof(b->jit->entry_tab[0]);
+        hp->js_func_code_size += b->jit->code_size;
+    }
+#endif
     if (!b->read_only_bytecode && b->byte_code_buf) {
         hp->js_func_code_size += b->byte_code_len;
     }
+    if (b->lazy) {
+        /* the compiled function is counted separately */
+        js_func_size += sizeof(*b->lazy);
+    }
     if (b->has_debug) {
         js_func_size += sizeof(*b) - offsetof(JSFunctionBytecode, debug);
         if (b->debug.source) {
@@ -6412,9 +8071,15 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
         p = (JSObject *)gp;
         sh = p->shape;
         s->obj_count++;
-        if (p->prop) {
+        s->obj_size += p->inline_prop_size * sizeof(*p->prop);
+        s->inline_prop_size += p->inline_prop_size * sizeof(*p->prop);
+        if (p->prop == p->inline_prop) {
+            s->inline_prop_count += sh->prop_count;
+        } else if (p->prop) {
             s->memory_used_count++;
             s->prop_size += sh->prop_size * sizeof(*p->prop);
+        }
+        if (p->prop) {
             s->prop_count += sh->prop_count;
             prs = get_shape_prop(sh);
             for(i = 0; i < sh->prop_count; i++) {
@@ -6439,12 +8104,15 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
             if (p->fast_array) {
                 s->fast_array_count++;
                 if (p->u.array.u.values) {
+                    int elem_size = js_array_elem_size(p->array_kind);
                     s->memory_used_count++;
-                    s->memory_used_size += p->u.array.count *
-                        sizeof(*p->u.array.u.values);
+                    s->memory_used_size += p->u.array.count * elem_size;
                     s->fast_array_elements += p->u.array.count;
-                    for (i = 0; i < p->u.array.count; i++) {
-                        compute_value_size(p->u.array.u.values[i], hp);
+                    s->fast_array_size += p->u.array.count * elem_size;
+                    if (p->array_kind == JS_ARRAY_KIND_GENERIC) {
+                        for (i = 0; i < p->u.array.count; i++) {
+                            compute_value_size(p->u.array.u.values[i], hp);
+                        }
                     }
                 }
             }
@@ -6574,7 +8242,41 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
             break;
         }
     }
-    s->obj_size += s->obj_count * sizeof(JSObject);
+    s->obj_size += s->obj_count * sizeof(JSObject); /* + inline properties */
+
+    /* regexp cache */
+    s->regexp_cache_count = rt->regexp_cache_count;
+    s->regexp_cache_size = rt->regexp_cache_count * sizeof(JSRegExpCacheEntry) +
+        rt->regexp_cache_hash_size * sizeof(rt->regexp_cache_hash[0]);
+    list_for_each(el, &rt->regexp_cache_lru) {
+        JSRegExpCacheEntry *e = list_entry(el, JSRegExpCacheEntry, link);
+        s->regexp_cache_size += sizeof(JSString) + e->bytecode->len;
+    }
+    s->regexp_cache_hit_count = rt->regexp_cache_hit_count;
+    s->regexp_cache_miss_count = rt->regexp_cache_miss_count;
+    s->regexp_nfa_count = rt->regexp_nfa_count;
+
+    /* nursery */
+    s->nursery_size = rt->nursery.size;
+    for(i = 0; i < rt->nursery.chunk_count; i++) {
+        if (rt->nursery.live_count[i] != 0)
+            s->nursery_used_chunks++;
+    }
+
+    /* slab allocator */
+    list_for_each(el, &rt->slab.arena_list) {
+        JSSlabArena *a = list_entry(el, JSSlabArena, link);
+        s->slab_arena_count++;
+        s->slab_arena_size += (int64_t)JS_SLAB_ARENA_SLABS << JS_SLAB_BITS;
+        for(i = 0; i < a->slab_count; i++) {
+            JSSlab *sl = (JSSlab *)(a->first_slab + ((size_t)i << JS_SLAB_BITS));
+            if (sl->class_idx >= 0) {
+                s->slab_used_count += sl->live_count;
+                s->slab_used_size += (int64_t)sl->live_count *
+                    js_slab_class_size[sl->class_idx];
+            }
+        }
+    }
 
     /* hashed shapes */
     s->memory_used_count++; /* rt->shape_hash */
@@ -6583,8 +8285,12 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
         JSShape *sh;
         for(sh = rt->shape_hash[i]; sh != NULL; sh = sh->shape_hash_next) {
             int hash_size = sh->prop_hash_mask + 1;
+            int fan_out = js_shape_transition_fan_out(sh);
             s->shape_count++;
             s->shape_size += get_shape_size(hash_size, sh->prop_size);
+            s->shape_transition_count += fan_out;
+            if (fan_out > s->shape_transition_max_fan_out)
+                s->shape_transition_max_fan_out = fan_out;
         }
     }
 
@@ -6607,6 +8313,8 @@ void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s)
     s->js_func_code_size = mem.js_func_code_size;
     s->js_func_pc2line_count = mem.js_func_pc2line_count;
     s->js_func_pc2line_size = mem.js_func_pc2line_size;
+    s->js_func_lazy_count = rt->lazy_func_count;
+    s->js_func_lazy_compiled_count = rt->lazy_func_compiled_count;
     s->memory_used_count += round(mem.memory_used_count) +
         s->atom_count + s->str_count +
         s->obj_count + s->shape_count +
@@ -6705,9 +8413,18 @@ void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt)
         fprintf(fp, "%-20s %8"PRId64" %8"PRId64"  (%0.1f per object)\n",
                 "  properties", s->prop_count, s->prop_size,
                 (double)s->prop_count / s->obj_count);
+        fprintf(fp, "%-20s %8"PRId64" %8"PRId64"  (%0.1f%% of properties)\n",
+                "  inline properties", s->inline_prop_count,
+                s->inline_prop_size,
+                s->prop_count ? 100.0 * s->inline_prop_count / s->prop_count : 0.0);
         fprintf(fp, "%-20s %8"PRId64" %8"PRId64"  (%0.1f per shape)\n",
                 "  shapes", s->shape_count, s->shape_size,
                 (double)s->shape_size / s->shape_count);
+        if (s->shape_transition_count) {
+            fprintf(fp, "%-20s %8"PRId64"           (%"PRId64" max fan-out)\n",
+                    "  transitions", s->shape_transition_count,
+                    s->shape_transition_max_fan_out);
+        }
     }
     if (s->js_func_count) {
         fprintf(fp, "%-20s %8"PRId64" %8"PRId64"\n",
@@ -6721,6 +8438,11 @@ void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt)
                     s->js_func_pc2line_size,
                     (double)s->js_func_pc2line_size / s->js_func_pc2line_count);
         }
+        if (s->js_func_lazy_count) {
+            fprintf(fp, "%-20s %8"PRId64"           (%"PRId64" compiled)\n",
+                    "  lazy", s->js_func_lazy_count,
+                    s->js_func_lazy_compiled_count);
+        }
     }
     if (s->c_func_count) {
         fprintf(fp, "%-20s %8"PRId64"\n", "C functions", s->c_func_count);
@@ -6731,7 +8453,7 @@ void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt)
             fprintf(fp, "%-20s %8"PRId64"\n", "  fast arrays", s->fast_array_count);
             fprintf(fp, "%-20s %8"PRId64" %8"PRId64"  (%0.1f per fast array)\n",
                     "  elements", s->fast_array_elements,
-                    s->fast_array_elements * (int)sizeof(JSValue),
+                    s->fast_array_size,
                     (double)s->fast_array_elements / s->fast_array_count);
         }
     }
@@ -6739,6 +8461,26 @@ void JS_DumpMemoryUsage(FILE *fp, const JSMemoryUsage *s, JSRuntime *rt)
         fprintf(fp, "%-20s %8"PRId64" %8"PRId64"\n",
                 "binary objects", s->binary_object_count, s->binary_object_size);
     }
+    if (s->regexp_cache_count) {
+        fprintf(fp, "%-20s %8"PRId64" %8"PRId64"  (%"PRId64" hits, %"PRId64" misses)\n",
+                "regexp cache", s->regexp_cache_count, s->regexp_cache_size,
+                s->regexp_cache_hit_count, s->regexp_cache_miss_count);
+    }
+    if (s->regexp_nfa_count) {
+        fprintf(fp, "%-20s %8"PRId64"\n",
+                "regexp NFA execs", s->regexp_nfa_count);
+    }
+    if (s->nursery_size) {
+        fprintf(fp, "%-20s %8"PRId64" %8"PRId64"  (%"PRId64" chunks)\n",
+                "nursery used chunks", s->nursery_used_chunks, s->nursery_size,
+                s->nursery_size >> JS_NURSERY_CHUNK_BITS);
+    }
+    if (s->slab_arena_count) {
+        fprintf(fp, "%-20s %8"PRId64" %8"PRId64"  (%"PRId64" arenas of %d bytes, %0.1f%% used)\n",
+                "slab blocks", s->slab_used_count, s->slab_used_size,
+                s->slab_arena_count, JS_SLAB_ARENA_SLABS << JS_SLAB_BITS,
+                100.0 * s->slab_used_size / s->slab_arena_size);
+    }
 }
 
 JSValue JS_GetGlobalObject(JSContext *ctx)
@@ -8397,6 +10139,8 @@ static JSValue JS_GetPropertyValue(JSContext *ctx, JSValueConst this_obj,
         idx = JS_VALUE_GET_INT(prop);
         switch(p->class_id) {
         case JS_CLASS_ARRAY:
+            if (unlikely(idx >= p->u.array.count)) goto slow_path;
+            return js_array_get_element(ctx, p, idx);
         case JS_CLASS_ARGUMENTS:
             if (unlikely(idx >= p->u.array.count)) goto slow_path;
             return JS_DupValue(ctx, p->u.array.u.values[idx]);
@@ -8471,6 +10215,15 @@ static int JS_TryGetPropertyInt64(JSContext *ctx, JSValueConst obj, int64_t idx,
     JSAtom prop;
     int present;
 
+    if (JS_VALUE_GET_TAG(obj) == JS_TAG_OBJECT) {
+        JSObject *p = JS_VALUE_GET_OBJ(obj);
+        if (p->class_id == JS_CLASS_ARRAY && p->fast_array &&
+            (uint64_t)idx < p->u.array.count) {
+            /* fast path for fast arrays: the element is always present */
+            *pval = js_array_get_element(ctx, p, idx);
+            return TRUE;
+        }
+    }
     if (likely((uint64_t)idx <= JS_ATOM_MAX_INT)) {
         /* fast path */
         present = JS_HasProperty(ctx, obj, __JS_AtomFromUInt32(idx));
@@ -8533,25 +10286,54 @@ static JSProperty *add_property(JSContext *ctx,
                                 JSObject *p, JSAtom prop, int prop_flags)
 {
     JSShape *sh, *new_sh;
+    int fan_out;
 
     sh = p->shape;
     if (sh->is_hashed) {
-        /* try to find an existing shape */
-        new_sh = find_hashed_shape_prop(ctx->rt, sh, prop, prop_flags);
+        /* try to follow an existing transition, then to find an
+           existing shape */
+        new_sh = find_shape_transition(sh, prop, prop_flags, &fan_out);
+        if (!new_sh) {
+            new_sh = find_hashed_shape_prop(ctx->rt, sh, prop, prop_flags);
+            if (new_sh && !new_sh->transition_parent &&
+                fan_out < JS_SHAPE_TRANSITION_MAX_FAN_OUT) {
+                /* record it as a transition of 'sh' */
+                js_shape_transition_link(sh, new_sh);
+            }
+        }
         if (new_sh) {
             /* matching shape found: use it */
             /*  the property array may need to be resized */
             if (new_sh->prop_size != sh->prop_size) {
-                JSProperty *new_prop;
-                new_prop = js_realloc(ctx, p->prop, sizeof(p->prop[0]) *
-                                      new_sh->prop_size);
-                if (!new_prop)
+                if (js_resize_object_prop(ctx, p, sh->prop_count,
+                                          new_sh->prop_size))
                     return NULL;
-                p->prop = new_prop;
             }
             p->shape = js_dup_shape(new_sh);
             js_free_shape(ctx->rt, sh);
             return &p->prop[new_sh->prop_count - 1];
+        } else if ((prop_flags & JS_PROP_TMASK) == 0 &&
+                   (sh->header.ref_count != 1 || sh->transition_first_child) &&
+                   sh->prop_count < JS_SHAPE_TRANSITION_MAX_PROPS &&
+                   fan_out < JS_SHAPE_TRANSITION_MAX_FAN_OUT) {
+            /* create a new transition. 'sh' is shared, so it is kept
+               unmodified so that the next objects built the same way
+               reuse it. Only plain data properties are considered so
+               that the builtin objects (autoinit properties and
+               accessors) are modified in place. */
+            new_sh = js_clone_shape(ctx, sh);
+            if (!new_sh)
+                return NULL;
+            new_sh->is_hashed = TRUE;
+            js_shape_hash_link(ctx->rt, new_sh);
+            if (add_shape_property(ctx, &new_sh, p, prop, prop_flags)) {
+                js_free_shape(ctx->rt, new_sh);
+                return NULL;
+            }
+            js_shape_transition_link(sh, new_sh);
+            p->shape = new_sh;
+            js_free_shape(ctx->rt, sh);
+            return &p->prop[new_sh->prop_count - 1];
         } else if (sh->header.ref_count != 1) {
             /* if the shape is shared, clone it */
             new_sh = js_clone_shape(ctx, sh);
@@ -8563,6 +10345,14 @@ static JSProperty *add_property(JSContext *ctx,
             js_free_shape(ctx->rt, p->shape);
             p->shape = new_sh;
         }
+    } else if (sh->header.ref_count != 1) {
+        /* the shape is referenced by an inline cache: it must not be
+           modified */
+        new_sh = js_clone_shape(ctx, sh);
+        if (!new_sh)
+            return NULL;
+        js_free_shape(ctx->rt, p->shape);
+        p->shape = new_sh;
     }
     assert(p->shape->header.ref_count == 1);
     if (add_shape_property(ctx, &p->shape, p, prop, prop_flags))
@@ -8580,6 +10370,9 @@ static no_inline __exception int convert_fast_array_to_array(JSContext *ctx,
     JSValue *tab;
     uint32_t i, len, new_count;
 
+    if (p->array_kind != JS_ARRAY_KIND_GENERIC &&
+        js_array_convert_kind(ctx, p, JS_ARRAY_KIND_GENERIC))
+        return -1;
     if (js_shape_prepare_update(ctx, p, NULL))
         return -1;
     len = p->u.array.count;
@@ -8670,7 +10463,8 @@ static int delete_property(JSContext *ctx, JSObject *p, JSAtom atom)
                     p->class_id == JS_CLASS_ARGUMENTS) {
                     /* Special case deleting the last element of a fast Array */
                     if (idx == p->u.array.count - 1) {
-                        JS_FreeValue(ctx, p->u.array.u.values[idx]);
+                        if (p->array_kind == JS_ARRAY_KIND_GENERIC)
+                            JS_FreeValue(ctx, p->u.array.u.values[idx]);
                         p->u.array.count = idx;
                         return TRUE;
                     }
@@ -8735,8 +10529,10 @@ static int set_array_length(JSContext *ctx, JSObject *p, JSValue val,
     if (likely(p->fast_array)) {
         uint32_t old_len = p->u.array.count;
         if (len < old_len) {
-            for(i = len; i < old_len; i++) {
-                JS_FreeValue(ctx, p->u.array.u.values[i]);
+            if (p->array_kind == JS_ARRAY_KIND_GENERIC) {
+                for(i = len; i < old_len; i++) {
+                    JS_FreeValue(ctx, p->u.array.u.values[i]);
+                }
             }
             p->u.array.count = len;
         }
@@ -8813,14 +10609,27 @@ static int expand_fast_array(JSContext *ctx, JSObject *p, uint32_t new_len)
 {
     uint32_t new_size;
     size_t slack;
-    JSValue *new_array_prop;
+    void *new_array_prop;
+    int elem_size;
+
     /* XXX: potential arithmetic overflow */
     new_size = max_int(new_len, p->u.array.u1.size * 3 / 2);
-    new_array_prop = js_realloc2(ctx, p->u.array.u.values, sizeof(JSValue) * new_size, &slack);
-    if (!new_array_prop)
-        return -1;
-    new_size += slack / sizeof(*new_array_prop);
-    p->u.array.u.values = new_array_prop;
+    elem_size = js_array_elem_size(p->array_kind);
+    if (!p->u.array.u.ptr) {
+        /* small arrays are allocated in the nursery */
+        new_array_prop = js_malloc_nursery_rt(ctx->rt, elem_size * new_size);
+        slack = 0;
+        if (!new_array_prop) {
+            JS_ThrowOutOfMemory(ctx);
+            return -1;
+        }
+    } else {
+        new_array_prop = js_realloc2(ctx, p->u.array.u.ptr, elem_size * new_size, &slack);
+        if (!new_array_prop)
+            return -1;
+    }
+    new_size += slack / elem_size;
+    p->u.array.u.ptr = new_array_prop;
     p->u.array.u1.size = new_size;
     return 0;
 }
@@ -8831,6 +10640,7 @@ static int add_fast_array_element(JSContext *ctx, JSObject *p,
                                   JSValue val, int flags)
 {
     uint32_t new_len, array_len;
+    int kind;
     /* extend the array by one */
     /* XXX: convert to slow array if new_len > 2^31-1 elements */
     new_len = p->u.array.count + 1;
@@ -8846,13 +10656,33 @@ static int add_fast_array_element(JSContext *ctx, JSObject *p,
             p->prop[0].u.value = JS_NewInt32(ctx, new_len);
         }
     }
+    kind = js_array_value_kind(val);
+    if (unlikely(kind > p->array_kind)) {
+        if (js_array_convert_kind(ctx, p, kind)) {
+            JS_FreeValue(ctx, val);
+            return -1;
+        }
+    }
     if (unlikely(new_len > p->u.array.u1.size)) {
         if (expand_fast_array(ctx, p, new_len)) {
             JS_FreeValue(ctx, val);
             return -1;
         }
     }
-    p->u.array.u.values[new_len - 1] = val;
+    switch(p->array_kind) {
+    case JS_ARRAY_KIND_INT32:
+        p->u.array.u.int32_ptr[new_len - 1] = JS_VALUE_GET_INT(val);
+        break;
+    case JS_ARRAY_KIND_FLOAT64:
+        if (kind == JS_ARRAY_KIND_INT32)
+            p->u.array.u.double_ptr[new_len - 1] = JS_VALUE_GET_INT(val);
+        else
+            p->u.array.u.double_ptr[new_len - 1] = JS_VALUE_GET_FLOAT64(val);
+        break;
+    default:
+        p->u.array.u.values[new_len - 1] = val;
+        break;
+    }
     p->u.array.count = new_len;
     return TRUE;
 }
@@ -8870,8 +10700,10 @@ static JSValue js_allocate_fast_array(JSContext *ctx, int64_t len)
     arr = JS_NewArray(ctx);
     if (JS_IsException(arr))
         return arr;
+    p = JS_VALUE_GET_OBJ(arr);
+    /* the caller initializes u.array.u.values */
+    p->array_kind = JS_ARRAY_KIND_GENERIC;
     if (len > 0) {
-        p = JS_VALUE_GET_OBJ(arr);
         if (expand_fast_array(ctx, p, len) < 0) {
             JS_FreeValue(ctx, arr);
             return JS_EXCEPTION;
@@ -9212,7 +11044,8 @@ static int JS_SetPropertyValue(JSContext *ctx, JSValueConst this_obj,
                 /* add element */
                 return add_fast_array_element(ctx, p, val, flags);
             }
-            set_value(ctx, &p->u.array.u.values[idx], val);
+            if (unlikely(js_array_set_element(ctx, p, idx, val)))
+                return -1;
             break;
         case JS_CLASS_ARGUMENTS:
             if (unlikely(idx >= (uint32_t)p->u.array.count))
@@ -9511,22 +11344,23 @@ static int js_shape_prepare_update(JSContext *ctx, JSObject *p,
     uint32_t idx = 0;    /* prevent warning */
 
     sh = p->shape;
-    if (sh->is_hashed) {
-        if (sh->header.ref_count != 1) {
-            if (pprs)
-                idx = *pprs - get_shape_prop(sh);
-            /* clone the shape (the resulting one is no longer hashed) */
-            sh = js_clone_shape(ctx, sh);
-            if (!sh)
-                return -1;
-            js_free_shape(ctx->rt, p->shape);
-            p->shape = sh;
-            if (pprs)
-                *pprs = get_shape_prop(sh) + idx;
-        } else {
-            js_shape_hash_unlink(ctx->rt, sh);
-            sh->is_hashed = FALSE;
-        }
+    if (sh->header.ref_count != 1) {
+        /* the shape is shared with other objects or referenced by
+           an inline cache */
+        if (pprs)
+            idx = *pprs - get_shape_prop(sh);
+        /* clone the shape (the resulting one is no longer hashed) */
+        sh = js_clone_shape(ctx, sh);
+        if (!sh)
+            return -1;
+        js_free_shape(ctx->rt, p->shape);
+        p->shape = sh;
+        if (pprs)
+            *pprs = get_shape_prop(sh) + idx;
+    } else if (sh->is_hashed) {
+        js_shape_transition_unlink(ctx->rt, sh);
+        js_shape_hash_unlink(ctx->rt, sh);
+        sh->is_hashed = FALSE;
     }
     return 0;
 }
@@ -9768,7 +11602,8 @@ int JS_DefineProperty(JSContext *ctx, JSValueConst this_obj,
                             goto redo_prop_update;
                     }
                     if (flags & JS_PROP_HAS_VALUE) {
-                        set_value(ctx, &p->u.array.u.values[idx], JS_DupValue(ctx, val));
+                        if (js_array_set_element(ctx, p, idx, JS_DupValue(ctx, val)))
+                            return -1;
                     }
                     return TRUE;
                 }
@@ -13369,8 +15204,10 @@ static void js_print_object(JSPrintValueState *s, JSObject *p)
 
             len1 = min_uint32(p->u.array.count, s->options.max_item_count);
             for(i = 0; i < len1; i++) {
+                JSValue val = js_array_get_element(s->ctx, p, i);
                 js_print_comma(s, &comma_state);
-                js_print_value(s, p->u.array.u.values[i]);
+                js_print_value(s, val);
+                JS_FreeValueRT(s->rt, val);
             }
             if (len1 < p->u.array.count)
                 js_print_more_items(s, &comma_state, p->u.array.count - len1);
@@ -16149,16 +17986,17 @@ static BOOL js_is_fast_array(JSContext *ctx, JSValueConst obj)
     return FALSE;
 }
 
-/* Access an Array's internal JSValue array if available */
+/* Access an Array's internal elements if available. They are read
+   with js_array_get_element(). */
 static BOOL js_get_fast_array(JSContext *ctx, JSValueConst obj,
-                              JSValue **arrpp, uint32_t *countp)
+                              JSObject **pp, uint32_t *countp)
 {
     /* Try and handle fast arrays explicitly */
     if (JS_VALUE_GET_TAG(obj) == JS_TAG_OBJECT) {
         JSObject *p = JS_VALUE_GET_OBJ(obj);
         if (p->class_id == JS_CLASS_ARRAY && p->fast_array) {
             *countp = p->u.array.count;
-            *arrpp = p->u.array.u.values;
+            *pp = p;
             return TRUE;
         }
     }
@@ -16169,7 +18007,7 @@ static __exception int js_append_enumerate(JSContext *ctx, JSValue *sp)
 {
     JSValue iterator, enumobj, method, value;
     int is_array_iterator;
-    JSValue *arrp;
+    JSObject *arrp;
     uint32_t i, count32, pos;
     JSCFunctionType ft;
 
@@ -16217,7 +18055,7 @@ static __exception int js_append_enumerate(JSContext *ctx, JSValue *sp)
         /* Handle fast arrays explicitly */
         for (i = 0; i < count32; i++) {
             if (JS_DefinePropertyValueUint32(ctx, sp[-3], pos++,
-                                             JS_DupValue(ctx, arrp[i]), JS_PROP_C_W_E) < 0)
+                                             js_array_get_element(ctx, arrp, i), JS_PROP_C_W_E) < 0)
                 goto exception;
         }
     } else {
@@ -16451,6 +18289,13 @@ static JSValue js_closure(JSContext *ctx, JSValue bfunc,
     JSAtom name_atom;
 
     b = JS_VALUE_GET_PTR(bfunc);
+    if (b->lazy && b->lazy->compiled) {
+        /* already compiled by another instance of the function */
+        b = b->lazy->compiled;
+        b->header.ref_count++;
+        JS_FreeValue(ctx, bfunc);
+        bfunc = JS_MKPTR(JS_TAG_FUNCTION_BYTECODE, b);
+    }
     func_obj = JS_NewObjectClass(ctx, func_kind_to_class_id[b->func_kind]);
     if (JS_IsException(func_obj)) {
         JS_FreeValue(ctx, bfunc);
@@ -16797,6 +18642,224 @@ static JSValue js_call_bound_function(JSContext *ctx, JSValueConst func_obj,
     }
 }
 
+/* Inline caches */
+
+static force_inline JSInlineCacheSite *js_ic_get_site(JSRuntime *rt,
+                                                      JSFunctionBytecode *b,
+                                                      uint32_t pc_pos)
+{
+    JSInlineCache *ic;
+    JSInlineCacheSite *site;
+    uint32_t h, hash_mask, idx;
+
+    ic = b->ic;
+    if (unlikely(!ic)) {
+        ic = js_new_inline_cache(rt, b);
+        if (!ic)
+            return NULL;
+        b->ic = ic;
+    }
+    hash_mask = (1 << ic->hash_bits) - 1;
+    h = js_ic_hash(pc_pos, ic->hash_bits);
+    for(;;) {
+        idx = ic->hash[h];
+        if (unlikely(idx == 0))
+            return NULL;
+        site = &ic->sites[idx - 1];
+        if (likely(site->pc_pos == pc_pos))
+            return site;
+        h = (h + 1) & hash_mask;
+    }
+}
+
+/* Return TRUE if the lookup of a non array index property in 'p'
+   only depends on its shape. */
+static inline BOOL js_ic_is_ordinary(JSObject *p)
+{
+    /* the exotic behavior of the Array objects only concerns the
+       array indexes */
+    return !p->is_exotic || p->class_id == JS_CLASS_ARRAY;
+}
+
+/* return the object holding the property of a cache entry or NULL if
+   the prototype chain has changed */
+static inline JSObject *js_ic_get_holder(JSObject *p, JSInlineCacheEntry *e)
+{
+    int i;
+
+    if (e->depth == 0)
+        return p;
+    if (!js_ic_is_ordinary(p))
+        return NULL;
+    for(i = 0;; i++) {
+        p = p->shape->proto;
+        if (p->shape != e->proto_shape[i])
+            return NULL;
+        if (i == e->depth - 1)
+            return p;
+    }
+}
+
+static void js_ic_add_entry(JSRuntime *rt, JSInlineCacheSite *site,
+                            JSShape *sh, JSShape **proto_shape, int depth,
+                            uint32_t prop_idx)
+{
+    JSInlineCacheEntry *e;
+    int i;
+
+    for(i = 0; i < site->count; i++) {
+        e = &site->entries[i];
+        if (e->shape == sh) {
+            /* the prototype chain has changed */
+            js_ic_free_entry(rt, e);
+            goto set_entry;
+        }
+    }
+    if (site->count >= JS_IC_MAX_ENTRIES) {
+        js_ic_free_site(rt, site);
+        site->state = JS_IC_STATE_MEGAMORPHIC;
+        return;
+    }
+    e = &site->entries[site->count++];
+    if (site->count == 1)
+        site->state = JS_IC_STATE_MONOMORPHIC;
+    else
+        site->state = JS_IC_STATE_POLYMORPHIC;
+ set_entry:
+    e->shape = js_dup_shape(sh);
+    for(i = 0; i < depth; i++)
+        e->proto_shape[i] = js_dup_shape(proto_shape[i]);
+    e->depth = depth;
+    e->prop_idx = prop_idx;
+}
+
+static no_inline JSValue js_get_field_ic_miss(JSContext *ctx,
+                                              JSInlineCacheSite *site,
+                                              JSValueConst obj, JSAtom atom)
+{
+    JSObject *p, *p1;
+    JSShapeProperty *prs;
+    JSProperty *pr;
+    JSShape *proto_shape[JS_IC_MAX_DEPTH];
+    int depth;
+
+    p = JS_VALUE_GET_OBJ(obj);
+    if (__JS_AtomIsTaggedInt(atom))
+        goto not_cacheable;
+    /* the non hashed shapes are specific to one object: they are not
+       cached but the other receivers of the site may be */
+    if (!p->shape->is_hashed)
+        goto generic;
+    p1 = p;
+    depth = 0;
+    for(;;) {
+        prs = find_own_property(&pr, p1, atom);
+        if (prs) {
+            /* only the plain data properties are cached */
+            if ((prs->flags & JS_PROP_TMASK) == JS_PROP_AUTOINIT)
+                goto generic; /* may be cached once instantiated */
+            else if (prs->flags & JS_PROP_TMASK)
+                goto not_cacheable;
+            break;
+        }
+        if (!js_ic_is_ordinary(p1) || depth >= JS_IC_MAX_DEPTH)
+            goto not_cacheable;
+        p1 = p1->shape->proto;
+        if (!p1)
+            goto not_cacheable;
+        proto_shape[depth++] = p1->shape;
+    }
+    js_ic_add_entry(ctx->rt, site, p->shape, proto_shape, depth,
+                    prs - get_shape_prop(p1->shape));
+    return JS_DupValue(ctx, pr->u.value);
+ not_cacheable:
+    /* avoid redoing the lookup at each access */
+    js_ic_free_site(ctx->rt, site);
+    site->state = JS_IC_STATE_MEGAMORPHIC;
+ generic:
+    return JS_GetProperty(ctx, obj, atom);
+}
+
+/* JS_GetProperty() for OP_get_field and OP_get_field2 at position
+   'pc_pos' of 'b' */
+static force_inline JSValue JS_GetFieldIC(JSContext *ctx, JSFunctionBytecode *b,
+                                          uint32_t pc_pos, JSValueConst obj,
+                                          JSAtom atom)
+{
+    JSInlineCacheSite *site;
+    JSInlineCacheEntry *e;
+    JSObject *p, *p1;
+    int i;
+
+    if (unlikely(JS_VALUE_GET_TAG(obj) != JS_TAG_OBJECT))
+        goto generic;
+    site = js_ic_get_site(ctx->rt, b, pc_pos);
+    if (unlikely(!site) || site->state == JS_IC_STATE_MEGAMORPHIC)
+        goto generic;
+    p = JS_VALUE_GET_OBJ(obj);
+    for(i = 0; i < site->count; i++) {
+        e = &site->entries[i];
+        if (e->shape == p->shape) {
+            p1 = js_ic_get_holder(p, e);
+            if (!p1)
+                break;
+            return JS_DupValue(ctx, p1->prop[e->prop_idx].u.value);
+        }
+    }
+    return js_get_field_ic_miss(ctx, site, obj, atom);
+ generic:
+    return JS_GetProperty(ctx, obj, atom);
+}
+
+/* JS_SetPropertyInternal() for OP_put_field at position 'pc_pos' of
+   'b'. Only the writable own properties are cached. */
+static force_inline int JS_SetFieldIC(JSContext *ctx, JSFunctionBytecode *b,
+                                      uint32_t pc_pos, JSValueConst obj,
+                                      JSAtom atom, JSValue val)
+{
+    JSInlineCacheSite *site;
+    JSInlineCacheEntry *e;
+    JSObject *p;
+    JSShapeProperty *prs;
+    JSProperty *pr;
+    int i;
+
+    if (unlikely(JS_VALUE_GET_TAG(obj) != JS_TAG_OBJECT))
+        goto generic;
+    site = js_ic_get_site(ctx->rt, b, pc_pos);
+    if (unlikely(!site) || site->state == JS_IC_STATE_MEGAMORPHIC)
+        goto generic;
+    p = JS_VALUE_GET_OBJ(obj);
+    for(i = 0; i < site->count; i++) {
+        e = &site->entries[i];
+        if (e->shape == p->shape) {
+            set_value(ctx, &p->prop[e->prop_idx].u.value, val);
+            return TRUE;
+        }
+    }
+    /* the non hashed shapes are not cached (see js_get_field_ic_miss()) */
+    if (!p->shape->is_hashed)
+        goto generic;
+    if (!__JS_AtomIsTaggedInt(atom)) {
+        prs = find_own_property(&pr, p, atom);
+        if (prs && (prs->flags & (JS_PROP_TMASK | JS_PROP_WRITABLE |
+                                  JS_PROP_LENGTH)) == JS_PROP_WRITABLE) {
+            js_ic_add_entry(ctx->rt, site, p->shape, NULL, 0,
+                            prs - get_shape_prop(p->shape));
+            set_value(ctx, &pr->u.value, val);
+            return TRUE;
+        }
+        if (prs && (prs->flags & JS_PROP_TMASK) == JS_PROP_AUTOINIT)
+            goto generic;
+    }
+    /* property creation, setter or read-only property */
+    js_ic_free_site(ctx->rt, site);
+    site->state = JS_IC_STATE_MEGAMORPHIC;
+ generic:
+    return JS_SetPropertyInternal(ctx, obj, atom, val, obj,
+                                  JS_PROP_THROW_STRICT);
+}
+
 /* argument of OP_special_object */
 typedef enum {
     OP_SPECIAL_OBJECT_ARGUMENTS,
@@ -16849,6 +18912,14 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
 #define CASE(op)        case_ ## op
 #define DEFAULT         case_default
 #define BREAK           SWITCH(pc)
+#endif
+#ifdef CONFIG_JIT
+    /* count the backward jumps to find the hot loops */
+#define JIT_BACK_EDGE(diff)                                             \
+    if (unlikely((diff) < 0 && ++b->jit_counter >= rt->jit_threshold))  \
+        goto jit_enter
+#else
+#define JIT_BACK_EDGE(diff)
 #endif
 
     if (js_poll_interrupts(caller_ctx))
@@ -16891,6 +18962,11 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                          (JSValueConst *)argv, flags);
     }
     b = p->u.func.function_bytecode;
+    if (unlikely(b->lazy)) {
+        b = js_lazy_function_compile(caller_ctx, p);
+        if (!b)
+            return JS_EXCEPTION;
+    }
 
     if (unlikely(argc < b->arg_count || (flags & JS_CALL_FLAG_COPY_ARGV))) {
         arg_allocated_size = b->arg_count;
@@ -16933,6 +19009,10 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
     sf->prev_frame = rt->current_stack_frame;
     rt->current_stack_frame = sf;
     ctx = b->realm; /* set the current realm */
+#ifdef CONFIG_JIT
+    if (unlikely(++b->jit_counter >= rt->jit_threshold))
+        goto jit_enter;
+#endif
 
  restart:
     for(;;) {
@@ -17932,20 +20012,32 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
             BREAK;
 
         CASE(OP_goto):
-            pc += (int32_t)get_u32(pc);
-            if (unlikely(js_poll_interrupts(ctx)))
-                goto exception;
+            {
+                int32_t diff = get_u32(pc);
+                pc += diff;
+                if (unlikely(js_poll_interrupts(ctx)))
+                    goto exception;
+                JIT_BACK_EDGE(diff);
+            }
             BREAK;
 #if SHORT_OPCODES
         CASE(OP_goto16):
-            pc += (int16_t)get_u16(pc);
-            if (unlikely(js_poll_interrupts(ctx)))
-                goto exception;
+            {
+                int diff = (int16_t)get_u16(pc);
+                pc += diff;
+                if (unlikely(js_poll_interrupts(ctx)))
+                    goto exception;
+                JIT_BACK_EDGE(diff);
+            }
             BREAK;
         CASE(OP_goto8):
-            pc += (int8_t)pc[0];
-            if (unlikely(js_poll_interrupts(ctx)))
-                goto exception;
+            {
+                int diff = (int8_t)pc[0];
+                pc += diff;
+                if (unlikely(js_poll_interrupts(ctx)))
+                    goto exception;
+                JIT_BACK_EDGE(diff);
+            }
             BREAK;
 #endif
         CASE(OP_if_true):
@@ -17962,7 +20054,9 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                 }
                 sp--;
                 if (res) {
-                    pc += (int32_t)get_u32(pc - 4) - 4;
+                    int32_t diff = get_u32(pc - 4);
+                    pc += diff - 4;
+                    JIT_BACK_EDGE(diff);
                 }
                 if (unlikely(js_poll_interrupts(ctx)))
                     goto exception;
@@ -17983,7 +20077,9 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                 }
                 sp--;
                 if (!res) {
-                    pc += (int32_t)get_u32(pc - 4) - 4;
+                    int32_t diff = get_u32(pc - 4);
+                    pc += diff - 4;
+                    JIT_BACK_EDGE(diff);
                 }
                 if (unlikely(js_poll_interrupts(ctx)))
                     goto exception;
@@ -18004,7 +20100,9 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                 }
                 sp--;
                 if (res) {
-                    pc += (int8_t)pc[-1] - 1;
+                    int diff = (int8_t)pc[-1];
+                    pc += diff - 1;
+                    JIT_BACK_EDGE(diff);
                 }
                 if (unlikely(js_poll_interrupts(ctx)))
                     goto exception;
@@ -18024,7 +20122,9 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                 }
                 sp--;
                 if (!res) {
-                    pc += (int8_t)pc[-1] - 1;
+                    int diff = (int8_t)pc[-1];
+                    pc += diff - 1;
+                    JIT_BACK_EDGE(diff);
                 }
                 if (unlikely(js_poll_interrupts(ctx)))
                     goto exception;
@@ -18224,7 +20324,11 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                 pc += 4;
 
                 sf->cur_pc = pc;
-                val = JS_GetProperty(ctx, sp[-1], atom);
+                if (rt->ic_enabled)
+                    val = JS_GetFieldIC(ctx, b, pc - 5 - b->byte_code_buf,
+                                        sp[-1], atom);
+                else
+                    val = JS_GetProperty(ctx, sp[-1], atom);
                 if (unlikely(JS_IsException(val)))
                     goto exception;
                 JS_FreeValue(ctx, sp[-1]);
@@ -18240,7 +20344,11 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                 pc += 4;
 
                 sf->cur_pc = pc;
-                val = JS_GetProperty(ctx, sp[-1], atom);
+                if (rt->ic_enabled)
+                    val = JS_GetFieldIC(ctx, b, pc - 5 - b->byte_code_buf,
+                                        sp[-1], atom);
+                else
+                    val = JS_GetProperty(ctx, sp[-1], atom);
                 if (unlikely(JS_IsException(val)))
                     goto exception;
                 *sp++ = val;
@@ -18255,8 +20363,12 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
                 pc += 4;
                 sf->cur_pc = pc;
 
-                ret = JS_SetPropertyInternal(ctx, sp[-2], atom, sp[-1], sp[-2],
-                                             JS_PROP_THROW_STRICT);
+                if (rt->ic_enabled)
+                    ret = JS_SetFieldIC(ctx, b, pc - 5 - b->byte_code_buf,
+                                        sp[-2], atom, sp[-1]);
+                else
+                    ret = JS_SetPropertyInternal(ctx, sp[-2], atom, sp[-1], sp[-2],
+                                                 JS_PROP_THROW_STRICT);
                 JS_FreeValue(ctx, sp[-2]);
                 sp -= 2;
                 if (unlikely(ret < 0))
@@ -19408,6 +21520,42 @@ static JSValue JS_CallInternal(JSContext *caller_ctx, JSValueConst func_obj,
             goto exception;
         }
     }
+#ifdef CONFIG_JIT
+ jit_enter:
+    {
+        JSJitState js;
+        uint32_t ofs;
+        int ret;
+
+        if (!rt->jit_enabled) {
+            b->jit_counter = 0;
+            goto restart;
+        }
+        if (!b->jit) {
+            if (b->jit_failed || js_jit_compile(ctx, b) < 0) {
+                b->jit_failed = TRUE;
+                b->jit_counter = INT32_MIN;
+                goto restart;
+            }
+        }
+        ofs = b->jit->entry_tab[pc - b->byte_code_buf];
+        if (ofs == 0)
+            goto restart;
+        js.sp = sp;
+        js.var_buf = var_buf;
+        js.arg_buf = arg_buf;
+        js.sf = sf;
+        js.b = b;
+        ret = ((JSJitFunc *)b->jit->code)(ctx, &js, b->jit->code + ofs);
+        sp = js.sp;
+        if (ret == JS_JIT_EXIT_EXCEPTION) {
+            pc = sf->cur_pc;
+            goto exception;
+        }
+        pc = b->byte_code_buf + js.pos;
+        goto restart;
+    }
+#endif
  exception:
     if (is_backtrace_needed(ctx, rt->current_exception)) {
         /* add the backtrace information now (it is not done
@@ -19645,6 +21793,14 @@ static JSAsyncFunctionState *async_func_init(JSContext *ctx,
     JSStackFrame *sf;
     int local_count, i, arg_buf_len, n;
 
+    p = JS_VALUE_GET_OBJ(func_obj);
+    b = p->u.func.function_bytecode;
+    if (unlikely(b->lazy)) {
+        b = js_lazy_function_compile(ctx, p);
+        if (!b)
+            return NULL;
+    }
+
     s = js_mallocz(ctx, sizeof(*s));
     if (!s)
         return NULL;
@@ -19653,8 +21809,6 @@ static JSAsyncFunctionState *async_func_init(JSContext *ctx,
 
     sf = &s->frame;
     init_list_head(&sf->var_ref_list);
-    p = JS_VALUE_GET_OBJ(func_obj);
-    b = p->u.func.function_bytecode;
     sf->js_mode = b->js_mode | JS_MODE_ASYNC;
     sf->cur_pc = b->byte_code_buf;
     arg_buf_len = max_int(b->arg_count, argc);
@@ -19741,7 +21895,7 @@ static void __async_func_free(JSRuntime *rt, JSAsyncFunctionState *s)
     JS_FreeValueRT(rt, s->resolving_funcs[0]);
     JS_FreeValueRT(rt, s->resolving_funcs[1]);
 
-    remove_gc_object(&s->header);
+    remove_gc_object(rt, &s->header);
     if (rt->gc_phase == JS_GC_PHASE_REMOVE_CYCLES && s->header.ref_count != 0) {
         list_add_tail(&s->header.link, &rt->gc_zero_ref_count_list);
     } else {
@@ -19758,6 +21912,8 @@ static void async_func_free(JSRuntime *rt, JSAsyncFunctionState *s)
             if (rt->gc_phase == JS_GC_PHASE_NONE) {
                 free_zero_refcount(rt);
             }
+        } else if (s->header.mark == 0) {
+            gc_free_cycles_add(rt, &s->header);
         }
     }
 }
@@ -20822,6 +22978,18 @@ typedef struct JSFunctionDef {
 
     JSModuleDef *module; /* != NULL when parsing a module */
     BOOL has_await; /* TRUE if await is used (used in module eval) */
+
+    /* lazy compilation (see js_create_lazy_function()) */
+    JSLazySource *lazy_source; /* NULL if disabled. Owned by the top
+                                  level function */
+    int lazy_parse_pos; /* position of the first token parsed by
+                           js_parse_function_decl2(), -1 if none */
+    JSFunctionKindEnum lazy_func_kind : 8; /* func_kind argument of
+                                              js_parse_function_decl2() */
+    BOOL is_lazy : 1; /* TRUE if lazily compiled: the free variables
+                         are in the closure */
+    BOOL lazy_children : 1; /* TRUE if the child functions can be
+                               lazily compiled */
 } JSFunctionDef;
 
 typedef struct JSToken {
@@ -28424,7 +30592,7 @@ static void js_free_module_def(JSRuntime *rt, JSModuleDef *m)
     if (m->link.next) {
         list_del(&m->link);
     }
-    remove_gc_object(&m->header);
+    remove_gc_object(rt, &m->header);
     if (rt->gc_phase == JS_GC_PHASE_REMOVE_CYCLES && m->header.ref_count != 0) {
         list_add_tail(&m->header.link, &rt->gc_zero_ref_count_list);
     } else {
@@ -30771,6 +32939,28 @@ static __exception int js_parse_source_element(JSParseState *s)
     return 0;
 }
 
+static JSLazySource *js_new_lazy_source(JSContext *ctx, const char *input,
+                                        size_t input_len, BOOL is_module)
+{
+    JSLazySource *ls;
+
+    ls = js_malloc(ctx, sizeof(*ls) + input_len + 1);
+    if (!ls)
+        return NULL;
+    ls->ref_count = 1;
+    ls->len = input_len;
+    ls->is_module = is_module;
+    memcpy(ls->buf, input, input_len);
+    ls->buf[input_len] = '\0';
+    return ls;
+}
+
+static void js_free_lazy_source(JSRuntime *rt, JSLazySource *ls)
+{
+    if (--ls->ref_count == 0)
+        js_free_rt(rt, ls);
+}
+
 static JSFunctionDef *js_new_function_def(JSContext *ctx,
                                           JSFunctionDef *parent,
                                           BOOL is_eval,
@@ -30795,7 +32985,9 @@ static JSFunctionDef *js_new_function_def(JSContext *ctx,
         list_add_tail(&fd->link, &parent->child_list);
         fd->js_mode = parent->js_mode;
         fd->parent_scope_level = parent->scope_level;
+        fd->lazy_source = parent->lazy_source;
     }
+    fd->lazy_parse_pos = -1;
     fd->strip_debug = ((ctx->rt->strip_flags & JS_STRIP_DEBUG) != 0);
     fd->strip_source = ((ctx->rt->strip_flags & (JS_STRIP_DEBUG | JS_STRIP_SOURCE)) != 0);
 
@@ -30871,6 +33063,1143 @@ static void free_bytecode_atoms(JSRuntime *rt,
     }
 }
 
+static inline BOOL js_ic_is_site(int op)
+{
+    return op == OP_get_field || op == OP_get_field2 || op == OP_put_field;
+}
+
+/* allocate the inline caches of the property access opcodes of
+   'b'. Return NULL if memory error. */
+static JSInlineCache *js_new_inline_cache(JSRuntime *rt, JSFunctionBytecode *b)
+{
+    const uint8_t *bc_buf = b->byte_code_buf;
+    int pos, op, count, idx;
+    uint32_t hash_bits, h, hash_mask;
+    JSInlineCache *ic;
+
+    count = 0;
+    for(pos = 0; pos < b->byte_code_len; pos += short_opcode_info(op).size) {
+        op = bc_buf[pos];
+        if (js_ic_is_site(op))
+            count++;
+    }
+    /* load factor <= 0.5 */
+    hash_bits = 1;
+    while ((1 << hash_bits) < 2 * count)
+        hash_bits++;
+    ic = js_mallocz_rt(rt, sizeof(*ic) + count * sizeof(ic->sites[0]) +
+                       (sizeof(ic->hash[0]) << hash_bits));
+    if (!ic)
+        return NULL;
+    ic->count = count;
+    ic->hash_bits = hash_bits;
+    ic->hash = (uint32_t *)&ic->sites[count];
+    hash_mask = (1 << hash_bits) - 1;
+    idx = 0;
+    for(pos = 0; pos < b->byte_code_len; pos += short_opcode_info(op).size) {
+        op = bc_buf[pos];
+        if (js_ic_is_site(op)) {
+            ic->sites[idx].pc_pos = pos;
+            h = js_ic_hash(pos, hash_bits);
+            while (ic->hash[h] != 0)
+                h = (h + 1) & hash_mask;
+            ic->hash[h] = ++idx;
+        }
+    }
+    return ic;
+}
+
+#ifdef CONFIG_JIT
+
+/* Baseline JIT for x86-64. Each opcode is translated to a machine code
+   template working on the interpreter frame: the value stack, the
+   local variables and the arguments stay in memory, so no register
+   allocation is done and the interpreter can resume at any
+   instruction boundary. The int32 arithmetic, the comparisons, the
+   local variable accesses and the branches are inlined. The slow
+   paths and the property accesses call C helpers. The other opcodes
+   return to the interpreter, which executes them and enters the
+   native code again at the next backward jump. */
+
+/* fixed register assignment in the native code */
+enum {
+    JIT_RAX, JIT_RCX, JIT_RDX, JIT_RBX, JIT_RSP, JIT_RBP, JIT_RSI, JIT_RDI,
+    JIT_R8, JIT_R9, JIT_R10, JIT_R11, JIT_R12, JIT_R13, JIT_R14, JIT_R15,
+};
+
+#define JIT_SP    JIT_RBX /* value stack pointer */
+#define JIT_VARS  JIT_R12 /* var_buf */
+#define JIT_ARGS  JIT_R13 /* arg_buf */
+#define JIT_STATE JIT_R14 /* JSJitState */
+#define JIT_CTX   JIT_R15
+
+/* condition codes */
+enum {
+    JIT_CC_O = 0x0,
+    JIT_CC_B = 0x2,
+    JIT_CC_E = 0x4,
+    JIT_CC_NE = 0x5,
+    JIT_CC_A = 0x7,
+    JIT_CC_S = 0x8,
+    JIT_CC_L = 0xc,
+    JIT_CC_GE = 0xd,
+    JIT_CC_LE = 0xe,
+    JIT_CC_G = 0xf,
+};
+
+#define JIT_CC_JMP (-1) /* unconditional jump */
+
+/* offset of sp[-n] */
+#define JIT_SP_OFS(n) (-(n) * (int)sizeof(JSValue))
+#define JIT_TAG_OFS   ((int)offsetof(JSValue, tag))
+
+typedef struct JSJitLabelRef {
+    uint32_t offset; /* position of the rel32 field */
+    uint32_t target; /* target bytecode position */
+} JSJitLabelRef;
+
+typedef struct JSJitCompiler {
+    JSContext *ctx;
+    JSFunctionBytecode *b;
+    DynBuf code;
+    uint32_t *native_tab; /* native offset of each bytecode position */
+    JSJitLabelRef *label_refs;
+    int label_ref_count;
+    int label_ref_size;
+    uint32_t exit_offset; /* save sp, restore the registers and return */
+    uint32_t exception_offset; /* return JS_JIT_EXIT_EXCEPTION */
+} JSJitCompiler;
+
+static void jit_u8(JSJitCompiler *s, int v)
+{
+    dbuf_putc(&s->code, v);
+}
+
+static void jit_u32(JSJitCompiler *s, uint32_t v)
+{
+    dbuf_put_u32(&s->code, v);
+}
+
+static void jit_modrm_mem(JSJitCompiler *s, int reg, int base, int32_t disp)
+{
+    int mod;
+    if (disp == 0 && (base & 7) != JIT_RBP)
+        mod = 0;
+    else if (disp == (int8_t)disp)
+        mod = 1;
+    else
+        mod = 2;
+    jit_u8(s, (mod << 6) | ((reg & 7) << 3) | (base & 7));
+    if ((base & 7) == JIT_RSP)
+        jit_u8(s, 0x24); /* SIB without index */
+    if (mod == 1)
+        jit_u8(s, disp);
+    else if (mod == 2)
+        jit_u32(s, disp);
+}
+
+/* 'op' is a one byte opcode or 0x0fXX. 'prefix' is emitted before the
+   REX prefix if not zero. */
+static void jit_op_mem(JSJitCompiler *s, int prefix, int w, int op,
+                       int reg, int base, int32_t disp)
+{
+    int rex;
+    if (prefix)
+        jit_u8(s, prefix);
+    rex = (w << 3) | ((reg & 8) >> 1) | ((base & 8) >> 3);
+    if (rex)
+        jit_u8(s, 0x40 | rex);
+    if (op > 0xff)
+        jit_u8(s, op >> 8);
+    jit_u8(s, op);
+    jit_modrm_mem(s, reg, base, disp);
+}
+
+static void jit_op_reg(JSJitCompiler *s, int w, int op, int reg, int rm)
+{
+    int rex;
+    rex = (w << 3) | ((reg & 8) >> 1) | ((rm & 8) >> 3);
+    if (rex)
+        jit_u8(s, 0x40 | rex);
+    if (op > 0xff)
+        jit_u8(s, op >> 8);
+    jit_u8(s, op);
+    jit_u8(s, 0xc0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+static void jit_load(JSJitCompiler *s, int w, int reg, int base, int32_t disp)
+{
+    jit_op_mem(s, 0, w, 0x8b, reg, base, disp);
+}
+
+static void jit_store(JSJitCompiler *s, int w, int base, int32_t disp, int reg)
+{
+    jit_op_mem(s, 0, w, 0x89, reg, base, disp);
+}
+
+static void jit_store_imm(JSJitCompiler *s, int w, int base, int32_t disp,
+                          int32_t val)
+{
+    jit_op_mem(s, 0, w, 0xc7, 0, base, disp);
+    jit_u32(s, val);
+}
+
+/* cmp dword [base + disp], imm8 */
+static void jit_cmp_imm(JSJitCompiler *s, int base, int32_t disp, int val)
+{
+    jit_op_mem(s, 0, 0, 0x83, 7, base, disp);
+    jit_u8(s, val);
+}
+
+static void jit_mov_reg(JSJitCompiler *s, int dst, int src)
+{
+    jit_op_reg(s, 1, 0x89, src, dst);
+}
+
+static void jit_mov_imm(JSJitCompiler *s, int reg, uint32_t val)
+{
+    jit_u8(s, 0xb8 + reg);
+    jit_u32(s, val);
+}
+
+/* add rbx, n * sizeof(JSValue) */
+static void jit_add_sp(JSJitCompiler *s, int n)
+{
+    jit_op_reg(s, 1, 0x83, 0, JIT_SP);
+    jit_u8(s, n * (int)sizeof(JSValue));
+}
+
+static void jit_test_eax(JSJitCompiler *s)
+{
+    jit_u8(s, 0x85);
+    jit_u8(s, 0xc0);
+}
+
+static void jit_call(JSJitCompiler *s, const void *func)
+{
+    jit_u8(s, 0x48); /* movabs rax, func */
+    jit_u8(s, 0xb8);
+    dbuf_put_u64(&s->code, (uintptr_t)func);
+    jit_u8(s, 0xff); /* call rax */
+    jit_u8(s, 0xd0);
+}
+
+/* forward jump: return the label to give to jit_bind() */
+static uint32_t jit_jcc(JSJitCompiler *s, int cc)
+{
+    if (cc == JIT_CC_JMP) {
+        jit_u8(s, 0xe9);
+    } else {
+        jit_u8(s, 0x0f);
+        jit_u8(s, 0x80 + cc);
+    }
+    jit_u32(s, 0);
+    return s->code.size - 4;
+}
+
+static void jit_bind(JSJitCompiler *s, uint32_t label)
+{
+    if (dbuf_error(&s->code))
+        return;
+    put_u32(s->code.buf + label, s->code.size - (label + 4));
+}
+
+/* jump to an already emitted native code offset */
+static void jit_jcc_back(JSJitCompiler *s, int cc, uint32_t target)
+{
+    uint32_t label = jit_jcc(s, cc);
+    if (dbuf_error(&s->code))
+        return;
+    put_u32(s->code.buf + label, target - (label + 4));
+}
+
+/* jump to the native code of a bytecode position */
+static int jit_jcc_pos(JSJitCompiler *s, int cc, uint32_t target)
+{
+    JSJitLabelRef *ref;
+    if (s->label_ref_count >= s->label_ref_size) {
+        int new_size = max_int(16, s->label_ref_size * 3 / 2);
+        ref = js_realloc_rt(s->ctx->rt, s->label_refs,
+                            sizeof(s->label_refs[0]) * new_size);
+        if (!ref)
+            return -1;
+        s->label_refs = ref;
+        s->label_ref_size = new_size;
+    }
+    ref = &s->label_refs[s->label_ref_count++];
+    ref->offset = jit_jcc(s, cc);
+    ref->target = target;
+    return 0;
+}
+
+/* JS_DupValue() of the value in rax, rdx */
+static void jit_dup(JSJitCompiler *s)
+{
+    uint32_t l;
+    jit_op_reg(s, 0, 0x83, 7, JIT_RDX); /* cmp edx, JS_TAG_FIRST */
+    jit_u8(s, JS_TAG_FIRST);
+    l = jit_jcc(s, JIT_CC_B);
+    jit_op_mem(s, 0, 0, 0xff, 0, JIT_RAX, 0); /* inc dword [rax] */
+    jit_bind(s, l);
+}
+
+/* JS_FreeValue() of the value in rax, rdx */
+static void jit_free(JSJitCompiler *s)
+{
+    uint32_t l1, l2;
+    jit_op_reg(s, 0, 0x83, 7, JIT_RDX); /* cmp edx, JS_TAG_FIRST */
+    jit_u8(s, JS_TAG_FIRST);
+    l1 = jit_jcc(s, JIT_CC_B);
+    jit_op_mem(s, 0, 0, 0xff, 1, JIT_RAX, 0); /* dec dword [rax] */
+    l2 = jit_jcc(s, JIT_CC_G);
+    jit_mov_reg(s, JIT_RDI, JIT_CTX);
+    jit_mov_reg(s, JIT_RSI, JIT_RAX);
+    jit_call(s, __JS_FreeValue);
+    jit_bind(s, l1);
+    jit_bind(s, l2);
+}
+
+/* push a copy of the value at [base + disp] */
+static void jit_push_mem(JSJitCompiler *s, int base, int32_t disp)
+{
+    jit_load(s, 1, JIT_RAX, base, disp);
+    jit_load(s, 1, JIT_RDX, base, disp + JIT_TAG_OFS);
+    jit_store(s, 1, JIT_SP, 0, JIT_RAX);
+    jit_store(s, 1, JIT_SP, JIT_TAG_OFS, JIT_RDX);
+    jit_dup(s);
+    jit_add_sp(s, 1);
+}
+
+static void jit_push_imm(JSJitCompiler *s, int tag, int32_t val)
+{
+    jit_store_imm(s, 1, JIT_SP, 0, val);
+    jit_store_imm(s, 1, JIT_SP, JIT_TAG_OFS, tag);
+    jit_add_sp(s, 1);
+}
+
+/* set_value() of [base + disp] with sp[-1]. sp[-1] is popped if 'pop'
+   is true, otherwise it is duplicated. */
+static void jit_put_mem(JSJitCompiler *s, int base, int32_t disp, BOOL pop)
+{
+    if (!pop) {
+        jit_load(s, 1, JIT_RAX, JIT_SP, JIT_SP_OFS(1));
+        jit_load(s, 1, JIT_RDX, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS);
+        jit_dup(s);
+    }
+    jit_load(s, 1, JIT_RAX, base, disp);
+    jit_load(s, 1, JIT_RDX, base, disp + JIT_TAG_OFS);
+    jit_load(s, 1, JIT_RCX, JIT_SP, JIT_SP_OFS(1));
+    jit_store(s, 1, base, disp, JIT_RCX);
+    jit_load(s, 1, JIT_RCX, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS);
+    jit_store(s, 1, base, disp + JIT_TAG_OFS, JIT_RCX);
+    if (pop)
+        jit_add_sp(s, -1);
+    jit_free(s);
+}
+
+/* return to the interpreter which executes the instruction at 'pos' */
+static void jit_exit(JSJitCompiler *s, uint32_t pos)
+{
+    jit_store_imm(s, 0, JIT_STATE, offsetof(JSJitState, pos), pos);
+    jit_mov_imm(s, JIT_RAX, JS_JIT_EXIT_INTERP);
+    jit_jcc_back(s, JIT_CC_JMP, s->exit_offset);
+}
+
+/* call 'func(ctx, s, pos)' which returns < 0 if exception. The helper
+   updates s->sp. */
+static void jit_call_helper(JSJitCompiler *s, const void *func, uint32_t pos)
+{
+    jit_store(s, 1, JIT_STATE, offsetof(JSJitState, sp), JIT_SP);
+    jit_mov_reg(s, JIT_RDI, JIT_CTX);
+    jit_mov_reg(s, JIT_RSI, JIT_STATE);
+    jit_mov_imm(s, JIT_RDX, pos);
+    jit_call(s, func);
+    jit_load(s, 1, JIT_SP, JIT_STATE, offsetof(JSJitState, sp));
+    jit_test_eax(s);
+    jit_jcc_back(s, JIT_CC_NE, s->exception_offset);
+}
+
+/* jump to 'l' if sp[-1] and sp[-2] are not both int32. Clobber eax. */
+static uint32_t jit_check_both_int(JSJitCompiler *s)
+{
+    /* JS_TAG_INT is zero */
+    jit_load(s, 0, JIT_RAX, JIT_SP, JIT_SP_OFS(2) + JIT_TAG_OFS);
+    jit_op_mem(s, 0, 0, 0x0b, JIT_RAX, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS);
+    return jit_jcc(s, JIT_CC_NE);
+}
+
+static int js_jit_poll_interrupts(JSContext *ctx, JSJitState *s, uint32_t pos)
+{
+    s->sf->cur_pc = s->b->byte_code_buf + pos + 1;
+    return __js_poll_interrupts(ctx);
+}
+
+/* same as js_poll_interrupts() */
+static void jit_poll_interrupts(JSJitCompiler *s, uint32_t pos)
+{
+    uint32_t l;
+    /* sub dword [ctx + interrupt_counter], 1 */
+    jit_op_mem(s, 0, 0, 0x83, 5, JIT_CTX,
+               offsetof(JSContext, interrupt_counter));
+    jit_u8(s, 1);
+    l = jit_jcc(s, JIT_CC_G);
+    jit_call_helper(s, js_jit_poll_interrupts, pos);
+    jit_bind(s, l);
+}
+
+static int jit_goto(JSJitCompiler *s, int cc, uint32_t pos, uint32_t target)
+{
+    uint32_t l;
+    if (target > pos)
+        return jit_jcc_pos(s, cc, target);
+    /* backward jump: poll the interrupts */
+    l = 0;
+    if (cc != JIT_CC_JMP)
+        l = jit_jcc(s, cc ^ 1);
+    jit_poll_interrupts(s, pos);
+    if (jit_jcc_pos(s, JIT_CC_JMP, target))
+        return -1;
+    if (cc != JIT_CC_JMP)
+        jit_bind(s, l);
+    return 0;
+}
+
+static int js_jit_binary_slow(JSContext *ctx, JSJitState *s, uint32_t pos)
+{
+    const uint8_t *pc = s->b->byte_code_buf + pos;
+    JSValue *sp = s->sp;
+    int op = pc[0], ret;
+
+    s->sf->cur_pc = pc + 1;
+    switch(op) {
+    case OP_add:
+        ret = js_add_slow(ctx, sp);
+        break;
+    case OP_sub:
+    case OP_mul:
+    case OP_div:
+    case OP_mod:
+    case OP_pow:
+        ret = js_binary_arith_slow(ctx, sp, op);
+        break;
+    case OP_shl:
+    case OP_sar:
+    case OP_and:
+    case OP_or:
+    case OP_xor:
+        ret = js_binary_logic_slow(ctx, sp, op);
+        break;
+    case OP_shr:
+        ret = js_shr_slow(ctx, sp);
+        break;
+    case OP_lt:
+    case OP_lte:
+    case OP_gt:
+    case OP_gte:
+        ret = js_relational_slow(ctx, sp, op);
+        break;
+    case OP_eq:
+    case OP_neq:
+        ret = js_eq_slow(ctx, sp, op == OP_neq);
+        break;
+    case OP_strict_eq:
+    case OP_strict_neq:
+        ret = js_strict_eq_slow(ctx, sp, op == OP_strict_neq);
+        break;
+    default:
+        abort();
+    }
+    if (ret)
+        return -1;
+    s->sp = sp - 1;
+    return 0;
+}
+
+static int js_jit_unary_slow(JSContext *ctx, JSJitState *s, uint32_t pos)
+{
+    const uint8_t *pc = s->b->byte_code_buf + pos;
+
+    s->sf->cur_pc = pc + 1;
+    if (pc[0] == OP_not)
+        return js_not_slow(ctx, s->sp);
+    else
+        return js_unary_arith_slow(ctx, s->sp, pc[0]);
+}
+
+/* slow path of OP_inc_loc, OP_dec_loc and OP_add_loc */
+static int js_jit_loc_slow(JSContext *ctx, JSJitState *s, uint32_t pos)
+{
+    const uint8_t *pc = s->b->byte_code_buf + pos;
+    JSValue *pv = &s->var_buf[pc[1]];
+    JSValue op1, op2;
+
+    s->sf->cur_pc = pc + 2;
+    if (pc[0] == OP_add_loc) {
+        op2 = *--s->sp;
+        if (JS_VALUE_GET_TAG(*pv) == JS_TAG_STRING &&
+            JS_VALUE_GET_TAG(op2) == JS_TAG_STRING) {
+            if (JS_ConcatStringInPlace(ctx, JS_VALUE_GET_STRING(*pv), op2)) {
+                JS_FreeValue(ctx, op2);
+            } else {
+                op2 = JS_ConcatString(ctx, JS_DupValue(ctx, *pv), op2);
+                if (JS_IsException(op2))
+                    return -1;
+                set_value(ctx, pv, op2);
+            }
+        } else {
+            JSValue ops[2];
+            /* js_add_slow() frees the operands in case of exception */
+            ops[0] = JS_DupValue(ctx, *pv);
+            ops[1] = op2;
+            if (js_add_slow(ctx, ops + 2))
+                return -1;
+            set_value(ctx, pv, ops[0]);
+        }
+    } else {
+        /* must duplicate otherwise the variable value may be
+           destroyed before JS code accesses it */
+        op1 = JS_DupValue(ctx, *pv);
+        if (js_unary_arith_slow(ctx, &op1 + 1,
+                                pc[0] == OP_inc_loc ? OP_inc : OP_dec))
+            return -1;
+        set_value(ctx, pv, op1);
+    }
+    return 0;
+}
+
+/* same as the corresponding interpreter opcodes */
+static int js_jit_property(JSContext *ctx, JSJitState *s, uint32_t pos)
+{
+    JSFunctionBytecode *b = s->b;
+    const uint8_t *pc = b->byte_code_buf + pos;
+    JSValue *sp = s->sp;
+    JSValue val;
+    JSAtom atom;
+    int ret;
+
+    switch(pc[0]) {
+    case OP_get_length:
+        s->sf->cur_pc = pc + 1;
+        val = JS_GetProperty(ctx, sp[-1], JS_ATOM_length);
+        if (unlikely(JS_IsException(val)))
+            return -1;
+        JS_FreeValue(ctx, sp[-1]);
+        sp[-1] = val;
+        break;
+    case OP_get_field:
+    case OP_get_field2:
+        atom = get_u32(pc + 1);
+        s->sf->cur_pc = pc + 5;
+        if (ctx->rt->ic_enabled)
+            val = JS_GetFieldIC(ctx, b, pos, sp[-1], atom);
+        else
+            val = JS_GetProperty(ctx, sp[-1], atom);
+        if (unlikely(JS_IsException(val)))
+            return -1;
+        if (pc[0] == OP_get_field) {
+            JS_FreeValue(ctx, sp[-1]);
+            sp[-1] = val;
+        } else {
+            *sp++ = val;
+        }
+        break;
+    case OP_put_field:
+        atom = get_u32(pc + 1);
+        s->sf->cur_pc = pc + 5;
+        if (ctx->rt->ic_enabled)
+            ret = JS_SetFieldIC(ctx, b, pos, sp[-2], atom, sp[-1]);
+        else
+            ret = JS_SetPropertyInternal(ctx, sp[-2], atom, sp[-1], sp[-2],
+                                         JS_PROP_THROW_STRICT);
+        JS_FreeValue(ctx, sp[-2]);
+        sp -= 2;
+        s->sp = sp;
+        if (unlikely(ret < 0))
+            return -1;
+        break;
+    case OP_get_array_el:
+        s->sf->cur_pc = pc + 1;
+        val = JS_GetPropertyValue(ctx, sp[-2], sp[-1]);
+        JS_FreeValue(ctx, sp[-2]);
+        sp[-2] = val;
+        sp--;
+        s->sp = sp;
+        if (unlikely(JS_IsException(val)))
+            return -1;
+        break;
+    case OP_get_array_el2:
+        s->sf->cur_pc = pc + 1;
+        val = JS_GetPropertyValue(ctx, sp[-2], sp[-1]);
+        sp[-1] = val;
+        if (unlikely(JS_IsException(val)))
+            return -1;
+        break;
+    case OP_put_array_el:
+        s->sf->cur_pc = pc + 1;
+        ret = JS_SetPropertyValue(ctx, sp[-3], sp[-2], sp[-1],
+                                  JS_PROP_THROW_STRICT);
+        JS_FreeValue(ctx, sp[-3]);
+        sp -= 3;
+        s->sp = sp;
+        if (unlikely(ret < 0))
+            return -1;
+        break;
+    default:
+        abort();
+    }
+    s->sp = sp;
+    return 0;
+}
+
+/* binary operator with an inline int32 path (and float64 path for
+   add, sub and mul) */
+static void jit_binary_arith(JSJitCompiler *s, int op, uint32_t pos)
+{
+    uint32_t l_slow, l_ovf, l_neg, l_nz, l_done, l_done2, l_s1, l_s2;
+    int alu;
+
+    l_slow = jit_check_both_int(s);
+    jit_load(s, 0, JIT_RAX, JIT_SP, JIT_SP_OFS(2));
+    l_ovf = l_neg = 0;
+    switch(op) {
+    case OP_add:
+    case OP_sub:
+    case OP_mul:
+        alu = (op == OP_add) ? 0x03 : (op == OP_sub) ? 0x2b : 0x0faf;
+        jit_op_mem(s, 0, 0, alu, JIT_RAX, JIT_SP, JIT_SP_OFS(1));
+        l_ovf = jit_jcc(s, JIT_CC_O);
+        if (op == OP_mul) {
+            /* a zero result with a negative operand is -0 */
+            jit_test_eax(s);
+            l_nz = jit_jcc(s, JIT_CC_NE);
+            jit_load(s, 0, JIT_RCX, JIT_SP, JIT_SP_OFS(2));
+            jit_op_mem(s, 0, 0, 0x0b, JIT_RCX, JIT_SP, JIT_SP_OFS(1));
+            l_neg = jit_jcc(s, JIT_CC_S);
+            jit_bind(s, l_nz);
+        }
+        break;
+    case OP_and:
+        jit_op_mem(s, 0, 0, 0x23, JIT_RAX, JIT_SP, JIT_SP_OFS(1));
+        break;
+    case OP_or:
+        jit_op_mem(s, 0, 0, 0x0b, JIT_RAX, JIT_SP, JIT_SP_OFS(1));
+        break;
+    case OP_xor:
+        jit_op_mem(s, 0, 0, 0x33, JIT_RAX, JIT_SP, JIT_SP_OFS(1));
+        break;
+    case OP_shl:
+    case OP_sar:
+    case OP_shr:
+        /* the shift count is masked by the CPU as in JS */
+        jit_load(s, 0, JIT_RCX, JIT_SP, JIT_SP_OFS(1));
+        jit_u8(s, 0xd3);
+        jit_u8(s, op == OP_shl ? 0xe0 : op == OP_sar ? 0xf8 : 0xe8);
+        if (op == OP_shr) {
+            /* not representable as int32 */
+            jit_test_eax(s);
+            l_neg = jit_jcc(s, JIT_CC_S);
+        }
+        break;
+    default:
+        abort();
+    }
+    jit_store(s, 0, JIT_SP, JIT_SP_OFS(2), JIT_RAX);
+    jit_add_sp(s, -1);
+    l_done = jit_jcc(s, JIT_CC_JMP);
+
+    jit_bind(s, l_slow);
+    l_done2 = l_s1 = l_s2 = 0;
+    if (op == OP_add || op == OP_sub || op == OP_mul) {
+        jit_cmp_imm(s, JIT_SP, JIT_SP_OFS(2) + JIT_TAG_OFS, JS_TAG_FLOAT64);
+        l_s1 = jit_jcc(s, JIT_CC_NE);
+        jit_cmp_imm(s, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS, JS_TAG_FLOAT64);
+        l_s2 = jit_jcc(s, JIT_CC_NE);
+        /* movsd xmm0, sp[-2]; addsd/subsd/mulsd xmm0, sp[-1] */
+        jit_op_mem(s, 0xf2, 0, 0x0f10, 0, JIT_SP, JIT_SP_OFS(2));
+        jit_op_mem(s, 0xf2, 0, op == OP_add ? 0x0f58 :
+                   op == OP_sub ? 0x0f5c : 0x0f59, 0, JIT_SP, JIT_SP_OFS(1));
+        jit_op_mem(s, 0xf2, 0, 0x0f11, 0, JIT_SP, JIT_SP_OFS(2));
+        jit_add_sp(s, -1);
+        l_done2 = jit_jcc(s, JIT_CC_JMP);
+        jit_bind(s, l_s1);
+        jit_bind(s, l_s2);
+    }
+    if (l_ovf)
+        jit_bind(s, l_ovf);
+    if (l_neg)
+        jit_bind(s, l_neg);
+    jit_call_helper(s, js_jit_binary_slow, pos);
+    jit_bind(s, l_done);
+    if (l_done2)
+        jit_bind(s, l_done2);
+}
+
+static int jit_compare(JSJitCompiler *s, int cc, uint32_t pos)
+{
+    JSFunctionBytecode *b = s->b;
+    const uint8_t *pc = b->byte_code_buf + pos;
+    uint32_t l_slow, l_done, next_pos, target;
+    int next_op;
+
+    l_slow = jit_check_both_int(s);
+    next_pos = pos + 1;
+    next_op = next_pos < b->byte_code_len ? pc[1] : OP_invalid;
+    if (next_op == OP_if_true || next_op == OP_if_false ||
+        next_op == OP_if_true8 || next_op == OP_if_false8) {
+        /* compare and branch without creating the boolean. The slow
+           path continues with the code of the branch instruction. */
+        if (next_op == OP_if_true || next_op == OP_if_false)
+            target = next_pos + 1 + (int32_t)get_u32(pc + 2);
+        else
+            target = next_pos + 1 + get_i8(pc + 2);
+        if (next_op == OP_if_false || next_op == OP_if_false8)
+            cc ^= 1;
+        jit_add_sp(s, -2);
+        jit_load(s, 0, JIT_RAX, JIT_SP, 0);
+        jit_op_mem(s, 0, 0, 0x3b, JIT_RAX, JIT_SP, sizeof(JSValue));
+        if (jit_goto(s, cc, next_pos, target))
+            return -1;
+        if (jit_jcc_pos(s, JIT_CC_JMP,
+                        next_pos + short_opcode_info(next_op).size))
+            return -1;
+        jit_bind(s, l_slow);
+        jit_call_helper(s, js_jit_binary_slow, pos);
+        return 0;
+    }
+    jit_load(s, 0, JIT_RAX, JIT_SP, JIT_SP_OFS(2));
+    jit_op_mem(s, 0, 0, 0x3b, JIT_RAX, JIT_SP, JIT_SP_OFS(1));
+    jit_op_reg(s, 0, 0x0f90 + cc, 0, JIT_RAX); /* setcc al */
+    jit_op_reg(s, 0, 0x0fb6, JIT_RAX, JIT_RAX); /* movzx eax, al */
+    jit_store(s, 0, JIT_SP, JIT_SP_OFS(2), JIT_RAX);
+    jit_store_imm(s, 1, JIT_SP, JIT_SP_OFS(2) + JIT_TAG_OFS, JS_TAG_BOOL);
+    jit_add_sp(s, -1);
+    l_done = jit_jcc(s, JIT_CC_JMP);
+    jit_bind(s, l_slow);
+    jit_call_helper(s, js_jit_binary_slow, pos);
+    jit_bind(s, l_done);
+    return 0;
+}
+
+/* inc, dec or add to the int32 at [base + disp]. The slow path calls
+   'func'. */
+static void jit_inc_mem(JSJitCompiler *s, int base, int32_t disp, int op,
+                        const void *func, uint32_t pos)
+{
+    uint32_t l_slow, l_ovf, l_done;
+
+    if (op == OP_add_loc) {
+        jit_load(s, 0, JIT_RAX, base, disp + JIT_TAG_OFS);
+        jit_op_mem(s, 0, 0, 0x0b, JIT_RAX, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS);
+        l_slow = jit_jcc(s, JIT_CC_NE);
+        jit_load(s, 0, JIT_RAX, base, disp);
+        jit_op_mem(s, 0, 0, 0x03, JIT_RAX, JIT_SP, JIT_SP_OFS(1));
+    } else {
+        jit_cmp_imm(s, base, disp + JIT_TAG_OFS, JS_TAG_INT);
+        l_slow = jit_jcc(s, JIT_CC_NE);
+        jit_load(s, 0, JIT_RAX, base, disp);
+        jit_op_reg(s, 0, 0x83, op == OP_dec || op == OP_dec_loc ? 5 : 0,
+                   JIT_RAX);
+        jit_u8(s, 1);
+    }
+    l_ovf = jit_jcc(s, JIT_CC_O);
+    jit_store(s, 0, base, disp, JIT_RAX);
+    if (op == OP_add_loc)
+        jit_add_sp(s, -1);
+    l_done = jit_jcc(s, JIT_CC_JMP);
+    jit_bind(s, l_slow);
+    jit_bind(s, l_ovf);
+    jit_call_helper(s, func, pos);
+    jit_bind(s, l_done);
+}
+
+/* pop a value and test it as a boolean */
+static void jit_to_bool(JSJitCompiler *s)
+{
+    uint32_t l_slow, l_done;
+
+    jit_add_sp(s, -1);
+    /* JS_TAG_INT, JS_TAG_BOOL, JS_TAG_NULL and JS_TAG_UNDEFINED */
+    jit_cmp_imm(s, JIT_SP, JIT_TAG_OFS, JS_TAG_UNDEFINED);
+    l_slow = jit_jcc(s, JIT_CC_A);
+    jit_load(s, 0, JIT_RAX, JIT_SP, 0);
+    l_done = jit_jcc(s, JIT_CC_JMP);
+    jit_bind(s, l_slow);
+    jit_mov_reg(s, JIT_RDI, JIT_CTX);
+    jit_load(s, 1, JIT_RSI, JIT_SP, 0);
+    jit_load(s, 1, JIT_RDX, JIT_SP, JIT_TAG_OFS);
+    jit_call(s, JS_ToBoolFree);
+    jit_bind(s, l_done);
+    jit_test_eax(s);
+}
+
+/* emit the native code of the instruction at 'pos'. Return 1 if it is
+   not supported, -1 if memory error. */
+static int jit_emit_op(JSJitCompiler *s, uint32_t pos)
+{
+    JSFunctionBytecode *b = s->b;
+    const uint8_t *pc = b->byte_code_buf + pos;
+    int op = pc[0], idx;
+    uint32_t l;
+
+    switch(op) {
+    case OP_push_i32:
+        jit_push_imm(s, JS_TAG_INT, get_u32(pc + 1));
+        break;
+    case OP_push_minus1:
+    case OP_push_0:
+    case OP_push_1:
+    case OP_push_2:
+    case OP_push_3:
+    case OP_push_4:
+    case OP_push_5:
+    case OP_push_6:
+    case OP_push_7:
+        jit_push_imm(s, JS_TAG_INT, op - OP_push_0);
+        break;
+    case OP_push_i8:
+        jit_push_imm(s, JS_TAG_INT, get_i8(pc + 1));
+        break;
+    case OP_push_i16:
+        jit_push_imm(s, JS_TAG_INT, get_i16(pc + 1));
+        break;
+    case OP_push_const:
+    case OP_push_const8:
+        idx = (op == OP_push_const) ? get_u32(pc + 1) : pc[1];
+        jit_u8(s, 0x48); /* movabs rcx, &cpool[idx] */
+        jit_u8(s, 0xb9);
+        dbuf_put_u64(&s->code, (uintptr_t)&b->cpool[idx]);
+        jit_push_mem(s, JIT_RCX, 0);
+        break;
+    case OP_undefined:
+        jit_push_imm(s, JS_TAG_UNDEFINED, 0);
+        break;
+    case OP_null:
+        jit_push_imm(s, JS_TAG_NULL, 0);
+        break;
+    case OP_push_false:
+    case OP_push_true:
+        jit_push_imm(s, JS_TAG_BOOL, op == OP_push_true);
+        break;
+
+    case OP_drop:
+        jit_add_sp(s, -1);
+        jit_load(s, 1, JIT_RAX, JIT_SP, 0);
+        jit_load(s, 1, JIT_RDX, JIT_SP, JIT_TAG_OFS);
+        jit_free(s);
+        break;
+    case OP_nip:
+        jit_load(s, 1, JIT_RAX, JIT_SP, JIT_SP_OFS(2));
+        jit_load(s, 1, JIT_RDX, JIT_SP, JIT_SP_OFS(2) + JIT_TAG_OFS);
+        jit_load(s, 1, JIT_RCX, JIT_SP, JIT_SP_OFS(1));
+        jit_store(s, 1, JIT_SP, JIT_SP_OFS(2), JIT_RCX);
+        jit_load(s, 1, JIT_RCX, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS);
+        jit_store(s, 1, JIT_SP, JIT_SP_OFS(2) + JIT_TAG_OFS, JIT_RCX);
+        jit_add_sp(s, -1);
+        jit_free(s);
+        break;
+    case OP_dup:
+        jit_push_mem(s, JIT_SP, JIT_SP_OFS(1));
+        break;
+    case OP_swap:
+        jit_load(s, 1, JIT_RAX, JIT_SP, JIT_SP_OFS(2));
+        jit_load(s, 1, JIT_RCX, JIT_SP, JIT_SP_OFS(1));
+        jit_store(s, 1, JIT_SP, JIT_SP_OFS(2), JIT_RCX);
+        jit_store(s, 1, JIT_SP, JIT_SP_OFS(1), JIT_RAX);
+        jit_load(s, 1, JIT_RAX, JIT_SP, JIT_SP_OFS(2) + JIT_TAG_OFS);
+        jit_load(s, 1, JIT_RCX, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS);
+        jit_store(s, 1, JIT_SP, JIT_SP_OFS(2) + JIT_TAG_OFS, JIT_RCX);
+        jit_store(s, 1, JIT_SP, JIT_SP_OFS(1) + JIT_TAG_OFS, JIT_RAX);
+        break;
+
+    case OP_get_loc:
+    case OP_put_loc:
+    case OP_set_loc:
+        idx = get_u16(pc + 1);
+        goto loc;
+    case OP_get_loc8:
+    case OP_put_loc8:
+    case OP_set_loc8:
+        idx = pc[1];
+        op = op - OP_get_loc8 + OP_get_loc;
+        goto loc;
+    case OP_get_loc0:
+    case OP_get_loc1:
+    case OP_get_loc2:
+    case OP_get_loc3:
+        idx = op - OP_get_loc0;
+        op = OP_get_loc;
+        goto loc;
+    case OP_put_loc0:
+    case OP_put_loc1:
+    case OP_put_loc2:
+    case OP_put_loc3:
+        idx = op - OP_put_loc0;
+        op = OP_put_loc;
+        goto loc;
+    case OP_set_loc0:
+    case OP_set_loc1:
+    case OP_set_loc2:
+    case OP_set_loc3:
+        idx = op - OP_set_loc0;
+        op = OP_set_loc;
+    loc:
+        if (op == OP_get_loc)
+            jit_push_mem(s, JIT_VARS, idx * sizeof(JSValue));
+        else
+            jit_put_mem(s, JIT_VARS, idx * sizeof(JSValue), op == OP_put_loc);
+        break;
+    case OP_get_arg:
+    case OP_put_arg:
+    case OP_set_arg:
+        idx = get_u16(pc + 1);
+        goto arg;
+    case OP_get_arg0:
+    case OP_get_arg1:
+    case OP_get_arg2:
+    case OP_get_arg3:
+        idx = op - OP_get_arg0;
+        op = OP_get_arg;
+        goto arg;
+    case OP_put_arg0:
+    case OP_put_arg1:
+    case OP_put_arg2:
+    case OP_put_arg3:
+        idx = op - OP_put_arg0;
+        op = OP_put_arg;
+        goto arg;
+    case OP_set_arg0:
+    case OP_set_arg1:
+    case OP_set_arg2:
+    case OP_set_arg3:
+        idx = op - OP_set_arg0;
+        op = OP_set_arg;
+    arg:
+        if (op == OP_get_arg)
+            jit_push_mem(s, JIT_ARGS, idx * sizeof(JSValue));
+        else
+            jit_put_mem(s, JIT_ARGS, idx * sizeof(JSValue), op == OP_put_arg);
+        break;
+    case OP_get_loc_check:
+    case OP_put_loc_check:
+        /* the interpreter throws the exception */
+        idx = get_u16(pc + 1);
+        jit_cmp_imm(s, JIT_VARS, idx * sizeof(JSValue) + JIT_TAG_OFS,
+                    JS_TAG_UNINITIALIZED);
+        l = jit_jcc(s, JIT_CC_NE);
+        jit_exit(s, pos);
+        jit_bind(s, l);
+        if (op == OP_get_loc_check)
+            jit_push_mem(s, JIT_VARS, idx * sizeof(JSValue));
+        else
+            jit_put_mem(s, JIT_VARS, idx * sizeof(JSValue), TRUE);
+        break;
+    case OP_set_loc_uninitialized:
+        idx = get_u16(pc + 1);
+        jit_load(s, 1, JIT_RAX, JIT_VARS, idx * sizeof(JSValue));
+        jit_load(s, 1, JIT_RDX, JIT_VARS, idx * sizeof(JSValue) + JIT_TAG_OFS);
+        jit_store_imm(s, 1, JIT_VARS, idx * sizeof(JSValue), 0);
+        jit_store_imm(s, 1, JIT_VARS, idx * sizeof(JSValue) + JIT_TAG_OFS,
+                      JS_TAG_UNINITIALIZED);
+        jit_free(s);
+        break;
+
+    case OP_add:
+    case OP_sub:
+    case OP_mul:
+    case OP_and:
+    case OP_or:
+    case OP_xor:
+    case OP_shl:
+    case OP_sar:
+    case OP_shr:
+        jit_binary_arith(s, op, pos);
+        break;
+    case OP_div:
+    case OP_mod:
+    case OP_pow:
+        jit_call_helper(s, js_jit_binary_slow, pos);
+        break;
+    case OP_lt:
+        return jit_compare(s, JIT_CC_L, pos);
+    case OP_lte:
+        return jit_compare(s, JIT_CC_LE, pos);
+    case OP_gt:
+        return jit_compare(s, JIT_CC_G, pos);
+    case OP_gte:
+        return jit_compare(s, JIT_CC_GE, pos);
+    case OP_eq:
+    case OP_strict_eq:
+        return jit_compare(s, JIT_CC_E, pos);
+    case OP_neq:
+    case OP_strict_neq:
+        return jit_compare(s, JIT_CC_NE, pos);
+    case OP_inc:
+    case OP_dec:
+        jit_inc_mem(s, JIT_SP, JIT_SP_OFS(1), op, js_jit_unary_slow, pos);
+        break;
+    case OP_inc_loc:
+    case OP_dec_loc:
+    case OP_add_loc:
+        jit_inc_mem(s, JIT_VARS, pc[1] * sizeof(JSValue), op,
+                    js_jit_loc_slow, pos);
+        break;
+    case OP_neg:
+    case OP_plus:
+    case OP_not:
+        jit_call_helper(s, js_jit_unary_slow, pos);
+        break;
+
+    case OP_get_length:
+    case OP_get_field:
+    case OP_get_field2:
+    case OP_put_field:
+    case OP_get_array_el:
+    case OP_get_array_el2:
+    case OP_put_array_el:
+        jit_call_helper(s, js_jit_property, pos);
+        break;
+
+    case OP_goto:
+        return jit_goto(s, JIT_CC_JMP, pos, pos + 1 + (int32_t)get_u32(pc + 1));
+    case OP_goto16:
+        return jit_goto(s, JIT_CC_JMP, pos, pos + 1 + get_i16(pc + 1));
+    case OP_goto8:
+        return jit_goto(s, JIT_CC_JMP, pos, pos + 1 + get_i8(pc + 1));
+    case OP_if_true:
+    case OP_if_false:
+        jit_to_bool(s);
+        return jit_goto(s, op == OP_if_true ? JIT_CC_NE : JIT_CC_E, pos,
+                        pos + 1 + (int32_t)get_u32(pc + 1));
+    case OP_if_true8:
+    case OP_if_false8:
+        jit_to_bool(s);
+        return jit_goto(s, op == OP_if_true8 ? JIT_CC_NE : JIT_CC_E, pos,
+                        pos + 1 + get_i8(pc + 1));
+    default:
+        jit_exit(s, pos);
+        return 1;
+    }
+    return 0;
+}
+
+static void jit_prologue(JSJitCompiler *s)
+{
+    static const uint8_t push_regs[] = {
+        0x55, /* push rbp */
+        0x53, /* push rbx */
+        0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57, /* push r12-r15 */
+        0x48, 0x83, 0xec, 0x08, /* sub rsp, 8: align the stack */
+    };
+    static const uint8_t pop_regs[] = {
+        0x48, 0x83, 0xc4, 0x08, /* add rsp, 8 */
+        0x41, 0x5f, 0x41, 0x5e, 0x41, 0x5d, 0x41, 0x5c, /* pop r15-r12 */
+        0x5b, /* pop rbx */
+        0x5d, /* pop rbp */
+        0xc3, /* ret */
+    };
+    dbuf_put(&s->code, push_regs, sizeof(push_regs));
+    jit_mov_reg(s, JIT_CTX, JIT_RDI);
+    jit_mov_reg(s, JIT_STATE, JIT_RSI);
+    jit_load(s, 1, JIT_SP, JIT_STATE, offsetof(JSJitState, sp));
+    jit_load(s, 1, JIT_VARS, JIT_STATE, offsetof(JSJitState, var_buf));
+    jit_load(s, 1, JIT_ARGS, JIT_STATE, offsetof(JSJitState, arg_buf));
+    jit_u8(s, 0xff); /* jmp rdx */
+    jit_u8(s, 0xe2);
+
+    s->exit_offset = s->code.size;
+    jit_store(s, 1, JIT_STATE, offsetof(JSJitState, sp), JIT_SP);
+    dbuf_put(&s->code, pop_regs, sizeof(pop_regs));
+
+    s->exception_offset = s->code.size;
+    jit_mov_imm(s, JIT_RAX, JS_JIT_EXIT_EXCEPTION);
+    jit_jcc_back(s, JIT_CC_JMP, s->exit_offset);
+}
+
+/* compile 'b' to native code. Return -1 if it is not possible. No
+   exception is raised. */
+static int js_jit_compile(JSContext *ctx, JSFunctionBytecode *b)
+{
+    JSRuntime *rt = ctx->rt;
+    JSJitCompiler s_s, *s = &s_s;
+    JSJitCode *jit;
+    uint8_t *code;
+    size_t code_size, page_size;
+    uint32_t pos, *entry_tab;
+    int i, op, ret;
+
+    if (b->func_kind != JS_FUNC_NORMAL)
+        return -1;
+    memset(s, 0, sizeof(*s));
+    s->ctx = ctx;
+    s->b = b;
+    js_dbuf_init(ctx, &s->code);
+    entry_tab = js_mallocz_rt(rt, sizeof(entry_tab[0]) * max_int(b->byte_code_len, 1));
+    if (!entry_tab)
+        goto fail;
+    s->native_tab = js_malloc_rt(rt, sizeof(s->native_tab[0]) * max_int(b->byte_code_len, 1));
+    if (!s->native_tab)
+        goto fail;
+    jit_prologue(s);
+    for(pos = 0; pos < b->byte_code_len; pos += short_opcode_info(op).size) {
+        op = b->byte_code_buf[pos];
+        s->native_tab[pos] = s->code.size;
+        ret = jit_emit_op(s, pos);
+        if (ret < 0)
+            goto fail;
+        /* the unsupported instructions just exit to the interpreter */
+        if (ret == 0)
+            entry_tab[pos] = s->native_tab[pos];
+    }
+    if (dbuf_error(&s->code))
+        goto fail;
+    /* resolve the jumps. The targets are instruction starts. */
+    for(i = 0; i < s->label_ref_count; i++) {
+        JSJitLabelRef *ref = &s->label_refs[i];
+        put_u32(s->code.buf + ref->offset,
+                s->native_tab[ref->target] - (ref->offset + 4));
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+    code_size = (s->code.size + page_size - 1) & ~(page_size - 1);
+    code = mmap(NULL, code_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED)
+        goto fail;
+    memcpy(code, s->code.buf, s->code.size);
+    if (mprotect(code, code_size, PROT_READ | PROT_EXEC) < 0) {
+        munmap(code, code_size);
+        goto fail;
+    }
+    jit = js_malloc_rt(rt, sizeof(*jit));
+    if (!jit) {
+        munmap(code, code_size);
+        goto fail;
+    }
+    jit->code = code;
+    jit->code_size = code_size;
+    jit->entry_tab = entry_tab;
+    b->jit = jit;
+    dbuf_free(&s->code);
+    js_free_rt(rt, s->native_tab);
+    js_free_rt(rt, s->label_refs);
+    return 0;
+ fail:
+    dbuf_free(&s->code);
+    js_free_rt(rt, s->native_tab);
+    js_free_rt(rt, s->label_refs);
+    js_free_rt(rt, entry_tab);
+    return -1;
+}
+
+static void js_jit_free(JSRuntime *rt, JSJitCode *jit)
+{
+    munmap(jit->code, jit->code_size);
+    js_free_rt(rt, jit->entry_tab);
+    js_free_rt(rt, jit);
+}
+
+#endif /* CONFIG_JIT */
+
 static void js_free_function_def(JSContext *ctx, JSFunctionDef *fd)
 {
     int i;
@@ -30928,6 +34257,8 @@ static void js_free_function_def(JSContext *ctx, JSFunctionDef *fd)
     if (fd->parent) {
         /* remove in parent list */
         list_del(&fd->link);
+    } else if (fd->lazy_source) {
+        js_free_lazy_source(ctx->rt, fd->lazy_source);
     }
     js_free(ctx, fd);
 }
@@ -31924,10 +35255,11 @@ static int resolve_scope_var(JSContext *ctx, JSFunctionDef *s,
     }
 
     /* check direct eval scope (in the closure of the eval function
-       which is necessarily at the top level) */
+       which is necessarily at the top level). The closure of a lazily
+       compiled function is handled the same way. */
     if (!fd)
         fd = s;
-    if (var_idx < 0 && fd->is_eval) {
+    if (var_idx < 0 && (fd->is_eval || fd->is_lazy)) {
         int idx1;
         for (idx1 = 0; idx1 < fd->closure_var_count; idx1++) {
             JSClosureVar *cv = &fd->closure_var[idx1];
@@ -34688,6 +38020,432 @@ static int add_module_variables(JSContext *ctx, JSFunctionDef *fd)
 /* create a function object from a function definition. The function
    definition is freed. All the child functions are also created. It
    must be done this way to resolve all the variables. */
+/* Lazy compilation: when its parent function is compiled, no
+   bytecode is generated for a nested function. A stub is created
+   instead, holding the closure variables needed by the function and
+   by all its nested functions. On the first call, the function is
+   parsed again from the saved source code and compiled as a top
+   level function whose free variables are resolved by name in the
+   closure of the stub, as in a direct eval. */
+
+/* minimum phase 1 bytecode size of a lazily compiled function,
+   including its nested functions */
+#define JS_LAZY_FUNC_MIN_SIZE 128
+
+typedef struct {
+    JSAtom atom; /* JS_ATOM_NULL if free entry */
+    BOOL is_free;
+    JSFunctionDef *fd; /* last function where 'atom' was tested */
+} JSLazyNameEntry;
+
+typedef struct {
+    JSLazyNameEntry *hash; /* open addressing */
+    int hash_size; /* power of two */
+    int count;
+    JSAtom *free_names; /* variables not defined in the function */
+    int free_name_count;
+    int free_name_size;
+    BOOL need_home_object;
+} JSLazyNameSet;
+
+static void lazy_name_set_free(JSContext *ctx, JSLazyNameSet *ns)
+{
+    js_free(ctx, ns->hash);
+    js_free(ctx, ns->free_names);
+}
+
+static JSLazyNameEntry *lazy_name_set_find(JSContext *ctx, JSLazyNameSet *ns,
+                                           JSAtom atom)
+{
+    JSLazyNameEntry *e, *new_hash;
+    int i, new_size;
+
+    if (2 * (ns->count + 1) > ns->hash_size) {
+        new_size = max_int(ns->hash_size * 2, 64);
+        new_hash = js_mallocz(ctx, sizeof(new_hash[0]) * new_size);
+        if (!new_hash)
+            return NULL;
+        for(i = 0; i < ns->hash_size; i++) {
+            e = &ns->hash[i];
+            if (e->atom != JS_ATOM_NULL) {
+                uint32_t h = e->atom & (new_size - 1);
+                while (new_hash[h].atom != JS_ATOM_NULL)
+                    h = (h + 1) & (new_size - 1);
+                new_hash[h] = *e;
+            }
+        }
+        js_free(ctx, ns->hash);
+        ns->hash = new_hash;
+        ns->hash_size = new_size;
+    }
+    i = atom & (ns->hash_size - 1);
+    for(;;) {
+        e = &ns->hash[i];
+        if (e->atom == atom)
+            return e;
+        if (e->atom == JS_ATOM_NULL)
+            break;
+        i = (i + 1) & (ns->hash_size - 1);
+    }
+    e->atom = atom;
+    ns->count++;
+    return e;
+}
+
+/* return TRUE if 'var_name' is defined in all the scopes of 'fd'
+   (its body and the argument scope) */
+static BOOL js_lazy_has_var(JSContext *ctx, JSFunctionDef *fd,
+                            JSAtom var_name)
+{
+    if (var_name == JS_ATOM_home_object ||
+        var_name == JS_ATOM_this_active_func ||
+        var_name == JS_ATOM_new_target ||
+        var_name == JS_ATOM_this)
+        return fd->has_this_binding;
+    if (var_name == JS_ATOM_arguments && fd->has_arguments_binding)
+        return TRUE;
+    if (fd->is_func_expr && var_name == fd->func_name)
+        return TRUE;
+    /* the variables are not visible in the argument scope */
+    if (fd->has_parameter_expressions)
+        return FALSE;
+    return find_var(ctx, fd, var_name) >= 0;
+}
+
+static BOOL js_lazy_has_private_field(JSFunctionDef *fd, JSAtom var_name)
+{
+    int i;
+    for(i = 0; i < fd->var_count; i++) {
+        if (fd->vars[i].var_name == var_name)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* add to 'ns' the variables of 'fd' which are not defined in 'fd' or
+   in its parents up to 'root'. Return -1 if exception, 0 if the
+   function cannot be lazily compiled. */
+static int js_lazy_collect_names(JSContext *ctx, JSLazyNameSet *ns,
+                                 JSFunctionDef *root, JSFunctionDef *fd)
+{
+    const uint8_t *bc_buf = fd->byte_code.buf;
+    int pos, op, bc_len = fd->byte_code.size, ret;
+    struct list_head *el;
+    JSLazyNameEntry *e;
+    JSFunctionDef *fd1;
+    JSAtom var_name;
+
+    /* the direct eval needs all the variables of the parent scopes */
+    if (fd->has_eval_call)
+        return 0;
+    for(pos = 0; pos < bc_len; pos += opcode_info[op].size) {
+        op = bc_buf[pos];
+        switch(op) {
+        case OP_scope_get_var_checkthis:
+        case OP_scope_get_var_undef:
+        case OP_scope_get_var:
+        case OP_scope_put_var:
+        case OP_scope_delete_var:
+        case OP_scope_make_ref:
+        case OP_scope_get_ref:
+        case OP_scope_put_var_init:
+            var_name = get_u32(bc_buf + pos + 1);
+            e = lazy_name_set_find(ctx, ns, var_name);
+            if (!e)
+                return -1;
+            if (e->is_free || e->fd == fd)
+                break;
+            e->fd = fd;
+            for(fd1 = fd;; fd1 = fd1->parent) {
+                if (js_lazy_has_var(ctx, fd1, var_name)) {
+                    if (var_name == JS_ATOM_home_object && fd1 == root)
+                        ns->need_home_object = TRUE;
+                    break;
+                }
+                if (fd1 == root) {
+                    if (js_resize_array(ctx, (void **)&ns->free_names,
+                                        sizeof(ns->free_names[0]),
+                                        &ns->free_name_size,
+                                        ns->free_name_count + 1))
+                        return -1;
+                    ns->free_names[ns->free_name_count++] = var_name;
+                    e->is_free = TRUE;
+                    break;
+                }
+            }
+            break;
+        case OP_scope_get_private_field:
+        case OP_scope_get_private_field2:
+        case OP_scope_put_private_field:
+        case OP_scope_in_private_field:
+            /* the class must be compiled with the function */
+            var_name = get_u32(bc_buf + pos + 1);
+            for(fd1 = fd; !js_lazy_has_private_field(fd1, var_name);
+                fd1 = fd1->parent) {
+                if (fd1 == root)
+                    return 0;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    list_for_each(el, &fd->child_list) {
+        fd1 = list_entry(el, JSFunctionDef, link);
+        ret = js_lazy_collect_names(ctx, ns, root, fd1);
+        if (ret <= 0)
+            return ret;
+    }
+    return 1;
+}
+
+/* create in 's' the closure variable referencing 'var_name' in the
+   parent functions, as resolve_scope_var() does. Return < 0 if
+   exception. */
+static int js_lazy_capture_var(JSContext *ctx, JSFunctionDef *s,
+                               JSAtom var_name)
+{
+    JSFunctionDef *fd;
+    JSVarDef *vd;
+    int idx, var_idx, scope_level;
+    BOOL is_pseudo_var, is_arg_scope;
+
+    is_pseudo_var = (var_name == JS_ATOM_home_object ||
+                     var_name == JS_ATOM_this_active_func ||
+                     var_name == JS_ATOM_new_target ||
+                     var_name == JS_ATOM_this);
+    var_idx = -1;
+    for (fd = s; fd->parent;) {
+        scope_level = fd->parent_scope_level;
+        fd = fd->parent;
+        for (idx = fd->scopes[scope_level].first; idx >= 0;) {
+            vd = &fd->vars[idx];
+            if (vd->var_name == var_name) {
+                var_idx = idx;
+                break;
+            }
+            idx = vd->scope_next;
+        }
+        is_arg_scope = (idx == ARG_SCOPE_END);
+        if (var_idx >= 0)
+            break;
+        if (!is_arg_scope) {
+            var_idx = find_var(ctx, fd, var_name);
+            if (var_idx >= 0)
+                break;
+        }
+        if (is_pseudo_var) {
+            var_idx = resolve_pseudo_var(ctx, fd, var_name);
+            if (var_idx >= 0)
+                break;
+        }
+        if (var_name == JS_ATOM_arguments && fd->has_arguments_binding) {
+            var_idx = add_arguments_var(ctx, fd);
+            if (var_idx < 0)
+                return -1;
+            break;
+        }
+        if (fd->is_func_expr && fd->func_name == var_name) {
+            var_idx = add_func_var(ctx, fd, var_name);
+            if (var_idx < 0)
+                return -1;
+            break;
+        }
+        if (fd->is_eval)
+            break;
+    }
+
+    if (var_idx < 0) {
+        /* closure of the top level function */
+        if (fd->is_eval || fd->is_lazy) {
+            for (idx = 0; idx < fd->closure_var_count; idx++) {
+                JSClosureVar *cv = &fd->closure_var[idx];
+                if (cv->var_name == var_name) {
+                    return get_closure_var2(ctx, s, fd, FALSE, cv->is_arg,
+                                            idx, cv->var_name, cv->is_const,
+                                            cv->is_lexical, cv->var_kind);
+                }
+            }
+        }
+        return 0; /* global variable */
+    } else if (var_idx & ARGUMENT_VAR_OFFSET) {
+        var_idx -= ARGUMENT_VAR_OFFSET;
+        fd->args[var_idx].is_captured = 1;
+        return get_closure_var(ctx, s, fd, TRUE, var_idx, var_name,
+                               FALSE, FALSE, JS_VAR_NORMAL);
+    } else {
+        vd = &fd->vars[var_idx];
+        vd->is_captured = 1;
+        return get_closure_var(ctx, s, fd, FALSE, var_idx, var_name,
+                               vd->is_const, vd->is_lexical, vd->var_kind);
+    }
+}
+
+/* return TRUE if the variables of 'fd' can be resolved from the
+   closure of a lazily compiled function */
+static BOOL js_lazy_scope_ok(JSFunctionDef *fd)
+{
+    int i;
+
+    if (fd->has_eval_call || fd->var_object_idx >= 0 ||
+        fd->arg_var_object_idx >= 0 ||
+        (fd->is_eval && fd->eval_type == JS_EVAL_TYPE_DIRECT))
+        return FALSE;
+    for(i = 0; i < fd->var_count; i++) {
+        if (fd->vars[i].var_name == JS_ATOM__with_)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/* return the phase 1 bytecode size of 'fd' and its nested functions
+   or a value >= max_size */
+static int js_lazy_code_size(JSFunctionDef *fd, int max_size)
+{
+    struct list_head *el;
+    int size;
+
+    size = fd->byte_code.size;
+    list_for_each(el, &fd->child_list) {
+        if (size >= max_size)
+            break;
+        size += js_lazy_code_size(list_entry(el, JSFunctionDef, link),
+                                  max_size - size);
+    }
+    return size;
+}
+
+/* create a function whose bytecode is generated on its first
+   call. Return JS_UNDEFINED if the function must be compiled now. */
+static JSValue js_create_lazy_function(JSContext *ctx, JSFunctionDef *fd)
+{
+    JSFunctionDef *parent = fd->parent;
+    JSLazyNameSet ns_s, *ns = &ns_s;
+    JSFunctionBytecode *b;
+    JSLazyFunction *lf;
+    int i, ret, function_size, closure_var_offset, lazy_offset;
+    int line_num, col_num;
+    const uint8_t *p, *buf_start;
+
+    if (fd->lazy_parse_pos < 0)
+        return JS_UNDEFINED;
+    switch(fd->func_type) {
+    case JS_PARSE_FUNC_STATEMENT:
+    case JS_PARSE_FUNC_VAR:
+        /* the name is parsed again in the parent context */
+        if (fd->func_name == JS_ATOM_NULL ||
+            fd->func_name == JS_ATOM_yield ||
+            fd->func_name == JS_ATOM_await)
+            return JS_UNDEFINED;
+        break;
+    case JS_PARSE_FUNC_EXPR:
+        /* the function is likely to be called immediately:
+           "(function() { ... })()" or "!function() { ... }()" */
+        buf_start = (const uint8_t *)fd->lazy_source->buf;
+        p = buf_start + fd->source_pos;
+        while (p > buf_start && (p[-1] == ' ' || p[-1] == '\t' ||
+                                 p[-1] == '\n' || p[-1] == '\r'))
+            p--;
+        if (p > buf_start && (p[-1] == '(' || p[-1] == '!'))
+            return JS_UNDEFINED;
+        break;
+    case JS_PARSE_FUNC_ARROW:
+    case JS_PARSE_FUNC_GETTER:
+    case JS_PARSE_FUNC_SETTER:
+    case JS_PARSE_FUNC_METHOD:
+        break;
+    default:
+        return JS_UNDEFINED;
+    }
+    if (js_lazy_code_size(fd, JS_LAZY_FUNC_MIN_SIZE) < JS_LAZY_FUNC_MIN_SIZE)
+        return JS_UNDEFINED;
+
+    memset(ns, 0, sizeof(*ns));
+    ret = js_lazy_collect_names(ctx, ns, fd, fd);
+    if (ret <= 0) {
+        lazy_name_set_free(ctx, ns);
+        return ret < 0 ? JS_EXCEPTION : JS_UNDEFINED;
+    }
+    for(i = 0; i < ns->free_name_count; i++) {
+        if (js_lazy_capture_var(ctx, fd, ns->free_names[i]) < 0) {
+            lazy_name_set_free(ctx, ns);
+            return JS_EXCEPTION;
+        }
+    }
+    lazy_name_set_free(ctx, ns);
+
+    function_size = sizeof(*b);
+    closure_var_offset = function_size;
+    function_size += fd->closure_var_count * sizeof(*fd->closure_var);
+    function_size = (function_size + 7) & ~7;
+    lazy_offset = function_size;
+    function_size += sizeof(*lf);
+
+    b = js_mallocz(ctx, function_size);
+    if (!b)
+        return JS_EXCEPTION;
+    b->header.ref_count = 1;
+
+    line_num = get_line_col_cached(fd->get_line_col_cache, &col_num,
+                                   fd->get_line_col_cache->buf_start +
+                                   fd->source_pos);
+    dbuf_put_leb128(&fd->pc2line, line_num);
+    dbuf_put_leb128(&fd->pc2line, col_num);
+    b->debug.pc2line_buf = js_malloc(ctx, fd->pc2line.size);
+    if (!b->debug.pc2line_buf || dbuf_error(&fd->pc2line)) {
+        js_free(ctx, b->debug.pc2line_buf);
+        js_free(ctx, b);
+        return JS_EXCEPTION;
+    }
+    memcpy(b->debug.pc2line_buf, fd->pc2line.buf, fd->pc2line.size);
+    b->debug.pc2line_len = fd->pc2line.size;
+    b->has_debug = 1;
+    b->debug.filename = fd->filename;
+    fd->filename = JS_ATOM_NULL;
+
+    lf = (void *)((uint8_t*)b + lazy_offset);
+    lf->source = fd->lazy_source;
+    lf->source->ref_count++;
+    lf->parse_pos = fd->lazy_parse_pos;
+    lf->source_pos = fd->source_pos;
+    lf->source_len = fd->source_len;
+    lf->func_type = fd->func_type;
+    lf->func_kind = fd->lazy_func_kind;
+    lf->parent_js_mode = parent->js_mode;
+    lf->parent_func_kind = parent->func_kind;
+    lf->parent_func_type = parent->func_type;
+    b->lazy = lf;
+
+    b->func_name = fd->func_name;
+    fd->func_name = JS_ATOM_NULL;
+    b->defined_arg_count = fd->defined_arg_count;
+    b->closure_var_count = fd->closure_var_count;
+    if (b->closure_var_count) {
+        b->closure_var = (void *)((uint8_t*)b + closure_var_offset);
+        memcpy(b->closure_var, fd->closure_var,
+               b->closure_var_count * sizeof(*b->closure_var));
+    }
+    fd->closure_var_count = 0;
+
+    b->has_prototype = fd->has_prototype;
+    b->has_simple_parameter_list = fd->has_simple_parameter_list;
+    b->js_mode = fd->js_mode;
+    b->func_kind = fd->func_kind;
+    b->need_home_object = (fd->need_home_object || ns->need_home_object);
+    b->new_target_allowed = fd->new_target_allowed;
+    b->super_call_allowed = fd->super_call_allowed;
+    b->super_allowed = fd->super_allowed;
+    b->arguments_allowed = fd->arguments_allowed;
+    b->realm = JS_DupContext(ctx);
+
+    add_gc_object(ctx->rt, &b->header, JS_GC_OBJ_TYPE_FUNCTION_BYTECODE);
+    ctx->rt->lazy_func_count++;
+
+    /* the nested functions are freed without being compiled */
+    js_free_function_def(ctx, fd);
+    return JS_MKPTR(JS_TAG_FUNCTION_BYTECODE, b);
+}
+
 static JSValue js_create_function(JSContext *ctx, JSFunctionDef *fd)
 {
     JSValue func_obj;
@@ -34736,6 +38494,10 @@ static JSValue js_create_function(JSContext *ctx, JSFunctionDef *fd)
             goto fail;
     }
 
+    fd->lazy_children = (fd->lazy_source &&
+                         (!fd->parent || fd->parent->lazy_children) &&
+                         js_lazy_scope_ok(fd));
+
     /* first create all the child functions */
     list_for_each_safe(el, el1, &fd->child_list) {
         JSFunctionDef *fd1;
@@ -34743,7 +38505,11 @@ static JSValue js_create_function(JSContext *ctx, JSFunctionDef *fd)
 
         fd1 = list_entry(el, JSFunctionDef, link);
         cpool_idx = fd1->parent_cpool_idx;
-        func_obj = js_create_function(ctx, fd1);
+        func_obj = JS_UNDEFINED;
+        if (fd->lazy_children)
+            func_obj = js_create_lazy_function(ctx, fd1);
+        if (JS_IsUndefined(func_obj))
+            func_obj = js_create_function(ctx, fd1);
         if (JS_IsException(func_obj))
             goto fail;
         /* save it in the constant pool */
@@ -34904,6 +38670,8 @@ static JSValue js_create_function(JSContext *ctx, JSFunctionDef *fd)
     if (fd->parent) {
         /* remove from parent list */
         list_del(&fd->link);
+    } else if (fd->lazy_source) {
+        js_free_lazy_source(ctx->rt, fd->lazy_source);
     }
 
     js_free(ctx, fd);
@@ -34941,6 +38709,23 @@ static void free_function_bytecode(JSRuntime *rt, JSFunctionBytecode *b)
     }
     if (b->realm)
         JS_FreeContext(b->realm);
+    if (b->ic)
+        js_free_inline_cache(rt, b->ic);
+#ifdef CONFIG_JIT
+    if (b->jit)
+        js_jit_free(rt, b->jit);
+#endif
+
+    if (b->lazy) {
+        if (b->lazy->source)
+            js_free_lazy_source(rt, b->lazy->source);
+        else
+            js_free_bytecode_image(rt, b->lazy->image);
+        if (b->lazy->compiled) {
+            JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_FUNCTION_BYTECODE,
+                                        b->lazy->compiled));
+        }
+    }
 
     JS_FreeAtomRT(rt, b->func_name);
     if (b->has_debug) {
@@ -34949,7 +38734,7 @@ static void free_function_bytecode(JSRuntime *rt, JSFunctionBytecode *b)
         js_free_rt(rt, b->debug.source);
     }
 
-    remove_gc_object(&b->header);
+    remove_gc_object(rt, &b->header);
     if (rt->gc_phase == JS_GC_PHASE_REMOVE_CYCLES && b->header.ref_count != 0) {
         list_add_tail(&b->header.link, &rt->gc_zero_ref_count_list);
     } else {
@@ -35144,6 +38929,8 @@ static __exception int js_parse_function_decl2(JSParseState *s,
     int func_idx, lexical_func_idx = -1;
     BOOL has_opt_arg;
     BOOL create_func_var = FALSE;
+    const uint8_t *parse_ptr = s->token.ptr;
+    JSFunctionKindEnum parse_func_kind = func_kind;
 
     is_expr = (func_type != JS_PARSE_FUNC_STATEMENT &&
                func_type != JS_PARSE_FUNC_VAR);
@@ -35259,6 +39046,9 @@ static __exception int js_parse_function_decl2(JSParseState *s,
         *pfd = fd;
     s->cur_func = fd;
     fd->func_name = func_name;
+    /* needed to parse the function again if it is lazily compiled */
+    fd->lazy_parse_pos = parse_ptr - s->buf_start;
+    fd->lazy_func_kind = parse_func_kind;
     /* XXX: test !fd->is_generator is always false */
     fd->has_prototype = (func_type == JS_PARSE_FUNC_STATEMENT ||
                          func_type == JS_PARSE_FUNC_VAR ||
@@ -35778,6 +39568,129 @@ static void js_parse_init(JSContext *ctx, JSParseState *s,
     s->get_line_col_cache.col_num = 0;
 }
 
+/* generate the bytecode of the lazily compiled function 'b'. The
+   result is cached so that all the closures created from 'b' share
+   it. */
+static JSFunctionBytecode *js_lazy_compile(JSContext *ctx, JSFunctionBytecode *b)
+{
+    JSLazyFunction *lf = b->lazy;
+    JSParseState s1, *s = &s1;
+    JSFunctionDef *outer, *fd;
+    JSFunctionBytecode *b1;
+    JSValue func_obj;
+    JSAtom func_name;
+    const char *filename;
+    int i, ret;
+
+    if (lf->compiled)
+        return lf->compiled;
+    if (lf->image) {
+        b1 = js_image_read_function(ctx, b);
+        if (b1)
+            ctx->rt->lazy_func_compiled_count++;
+        return b1;
+    }
+    filename = JS_AtomToCString(ctx, b->debug.filename);
+    if (!filename)
+        return NULL;
+    js_parse_init(ctx, s, lf->source->buf, lf->source->len, filename);
+    s->is_module = lf->source->is_module;
+    s->allow_html_comments = !s->is_module;
+
+    /* the parent function is only used to give the parsing context */
+    outer = js_new_function_def(ctx, NULL, FALSE, FALSE, filename,
+                                s->buf_start, &s->get_line_col_cache);
+    if (!outer)
+        goto fail1;
+    outer->lazy_source = lf->source;
+    lf->source->ref_count++;
+    outer->js_mode = lf->parent_js_mode;
+    outer->func_kind = lf->parent_func_kind;
+    outer->func_type = lf->parent_func_type;
+    outer->new_target_allowed = b->new_target_allowed;
+    outer->super_call_allowed = b->super_call_allowed;
+    outer->super_allowed = b->super_allowed;
+    outer->arguments_allowed = b->arguments_allowed;
+    outer->in_function_body = TRUE;
+    s->cur_func = outer;
+    push_scope(s);
+    outer->body_scope = outer->scope_level;
+
+    s->buf_ptr = s->buf_start + lf->parse_pos;
+    if (next_token(s))
+        goto fail;
+    switch(lf->func_type) {
+    case JS_PARSE_FUNC_STATEMENT:
+    case JS_PARSE_FUNC_VAR:
+    case JS_PARSE_FUNC_EXPR:
+    case JS_PARSE_FUNC_ARROW:
+        func_name = JS_ATOM_NULL;
+        break;
+    default:
+        func_name = b->func_name;
+        break;
+    }
+    fd = NULL;
+    ret = js_parse_function_decl2(s, lf->func_type, lf->func_kind, func_name,
+                                  s->buf_start + lf->source_pos,
+                                  JS_PARSE_EXPORT_NONE, &fd);
+    free_token(s, &s->token);
+    if (ret)
+        goto fail;
+
+    /* compile the function as a top level function whose closure
+       variables are the ones of 'b' */
+    list_del(&fd->link);
+    fd->parent = NULL;
+    fd->lazy_source->ref_count++;
+    fd->is_lazy = TRUE;
+    fd->need_home_object = b->need_home_object;
+    for(i = 0; i < b->closure_var_count; i++) {
+        JSClosureVar *cv = &b->closure_var[i];
+        if (add_closure_var(ctx, fd, cv->is_local, cv->is_arg, cv->var_idx,
+                            cv->var_name, cv->is_const, cv->is_lexical,
+                            cv->var_kind) < 0) {
+            js_free_function_def(ctx, fd);
+            goto fail;
+        }
+    }
+    func_obj = js_create_function(ctx, fd);
+    if (JS_IsException(func_obj))
+        goto fail;
+    if (((JSFunctionBytecode *)JS_VALUE_GET_PTR(func_obj))->closure_var_count !=
+        b->closure_var_count) {
+        JS_FreeValue(ctx, func_obj);
+        JS_ThrowInternalError(ctx, "lazy compilation: inconsistent closure");
+        goto fail;
+    }
+    lf->compiled = JS_VALUE_GET_PTR(func_obj);
+    ctx->rt->lazy_func_compiled_count++;
+    js_free_function_def(ctx, outer);
+    JS_FreeCString(ctx, filename);
+    return lf->compiled;
+ fail:
+    js_free_function_def(ctx, outer);
+ fail1:
+    JS_FreeCString(ctx, filename);
+    return NULL;
+}
+
+/* replace the bytecode of the function object 'p' by the compiled
+   bytecode */
+static JSFunctionBytecode *js_lazy_function_compile(JSContext *ctx, JSObject *p)
+{
+    JSFunctionBytecode *b = p->u.func.function_bytecode;
+    JSFunctionBytecode *b1;
+
+    b1 = js_lazy_compile(b->realm, b);
+    if (!b1)
+        return NULL;
+    b1->header.ref_count++;
+    p->u.func.function_bytecode = b1;
+    JS_FreeValueRT(ctx->rt, JS_MKPTR(JS_TAG_FUNCTION_BYTECODE, b));
+    return b1;
+}
+
 static JSValue JS_EvalFunctionInternal(JSContext *ctx, JSValue fun_obj,
                                        JSValueConst this_obj,
                                        JSVarRef **var_refs, JSStackFrame *sf)
@@ -35866,6 +39779,12 @@ static JSValue __JS_EvalInternal(JSContext *ctx, JSValueConst this_obj,
     if (!fd)
         goto fail1;
     s->cur_func = fd;
+    if (ctx->rt->lazy_compile_enabled && eval_type != JS_EVAL_TYPE_DIRECT &&
+        !fd->strip_source && input_len <= INT32_MAX) {
+        fd->lazy_source = js_new_lazy_source(ctx, input, input_len, m != NULL);
+        if (!fd->lazy_source)
+            goto fail;
+    }
     fd->eval_type = eval_type;
     fd->has_this_binding = (eval_type != JS_EVAL_TYPE_DIRECT);
     if (eval_type == JS_EVAL_TYPE_DIRECT) {
@@ -36132,9 +40051,13 @@ typedef enum BCTagEnum {
     BC_TAG_DATE,
     BC_TAG_OBJECT_VALUE,
     BC_TAG_OBJECT_REFERENCE,
+    BC_TAG_ARRAY_BUFFER_TRANSFER,
+    BC_TAG_BUILTIN_REFERENCE, /* only used in snapshots */
+    BC_TAG_SNAPSHOT_OBJECT,
+    BC_TAG_SYMBOL,
 } BCTagEnum;
 
-#define BC_VERSION 5
+#define BC_VERSION 7
 
 typedef struct BCWriterState {
     JSContext *ctx;
@@ -36151,6 +40074,9 @@ typedef struct BCWriterState {
     uint8_t **sab_tab;
     int sab_tab_len;
     int sab_tab_size;
+    /* ArrayBuffers written as an index in this table */
+    JSValueConst *transfer_tab;
+    int transfer_len;
     /* list of referenced objects (used if allow_reference = TRUE) */
     JSObjectList object_list;
 } BCWriterState;
@@ -36177,6 +40103,10 @@ static const char * const bc_tag_str[] = {
     "Date",
     "ObjectValue",
     "ObjectReference",
+    "ArrayBufferTransfer",
+    "BuiltinReference",
+    "SnapshotObject",
+    "Symbol",
 };
 #endif
 
@@ -36458,10 +40388,20 @@ static int JS_WriteObjectRec(BCWriterState *s, JSValueConst obj);
 static int JS_WriteFunctionTag(BCWriterState *s, JSValueConst obj)
 {
     JSFunctionBytecode *b = JS_VALUE_GET_PTR(obj);
-    uint32_t flags;
+    uint32_t flags, size;
+    size_t size_pos;
     int idx, i;
 
+    if (b->lazy) {
+        b = js_lazy_compile(b->realm, b);
+        if (!b)
+            goto fail;
+    }
     bc_put_u8(s, BC_TAG_FUNCTION_BYTECODE);
+    /* size of the function, patched at the end (used by
+       JS_ReadObjectImage() to skip the nested functions) */
+    size_pos = s->dbuf.size;
+    bc_put_u32(s, 0);
     flags = idx = 0;
     bc_set_flags(&flags, &idx, b->has_prototype, 1);
     bc_set_flags(&flags, &idx, b->has_simple_parameter_list, 1);
@@ -36539,6 +40479,12 @@ static int JS_WriteFunctionTag(BCWriterState *s, JSValueConst obj)
         if (JS_WriteObjectRec(s, b->cpool[i]))
             goto fail;
     }
+    if (s->dbuf.error)
+        goto fail;
+    size = s->dbuf.size - size_pos - 4;
+    if (is_be())
+        size = bswap32(size);
+    put_u32(s->dbuf.buf + size_pos, size);
     return 0;
  fail:
     return -1;
@@ -36697,10 +40643,20 @@ static int JS_WriteArrayBuffer(BCWriterState *s, JSValueConst obj)
 {
     JSObject *p = JS_VALUE_GET_OBJ(obj);
     JSArrayBuffer *abuf = p->u.array_buffer;
+    int i;
+
     if (abuf->detached) {
         JS_ThrowTypeErrorDetachedArrayBuffer(s->ctx);
         return -1;
     }
+    for(i = 0; i < s->transfer_len; i++) {
+        if (JS_VALUE_GET_OBJ(s->transfer_tab[i]) == p) {
+            /* the data is transferred separately */
+            bc_put_u8(s, BC_TAG_ARRAY_BUFFER_TRANSFER);
+            bc_put_leb128(s, i);
+            return 0;
+        }
+    }
     bc_put_u8(s, BC_TAG_ARRAY_BUFFER);
     bc_put_leb128(s, abuf->byte_length);
     dbuf_put(&s->dbuf, abuf->data, abuf->byte_length);
@@ -36898,13 +40854,56 @@ static int JS_WriteObjectAtoms(BCWriterState *s)
     return -1;
 }
 
-uint8_t *JS_WriteObject2(JSContext *ctx, size_t *psize, JSValueConst obj,
-                         int flags, uint8_t ***psab_tab, size_t *psab_tab_len)
+/* check that 'transfer_tab' contains distinct and not detached
+   ArrayBuffers */
+static int js_check_transfer_tab(JSContext *ctx, JSValueConst *transfer_tab,
+                                 int transfer_len)
+{
+    JSArrayBuffer *abuf;
+    int i, j;
+
+    for(i = 0; i < transfer_len; i++) {
+        abuf = JS_GetOpaque(transfer_tab[i], JS_CLASS_ARRAY_BUFFER);
+        if (!abuf) {
+            JS_ThrowTypeError(ctx, "only ArrayBuffer objects can be transferred");
+            return -1;
+        }
+        if (abuf->detached) {
+            JS_ThrowTypeErrorDetachedArrayBuffer(ctx);
+            return -1;
+        }
+        for(j = 0; j < i; j++) {
+            if (JS_VALUE_GET_OBJ(transfer_tab[j]) ==
+                JS_VALUE_GET_OBJ(transfer_tab[i])) {
+                JS_ThrowTypeError(ctx, "duplicate transferred object");
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* The ArrayBuffers of 'transfer_tab' are written as their index in
+   the table. Their data must be given to the reader with
+   JS_TransferArrayBuffer(). */
+uint8_t *JS_WriteObject3(JSContext *ctx, size_t *psize, JSValueConst obj,
+                         int flags, uint8_t ***psab_tab, size_t *psab_tab_len,
+                         JSValueConst *transfer_tab, int transfer_len)
 {
     BCWriterState ss, *s = &ss;
 
+    if (js_check_transfer_tab(ctx, transfer_tab, transfer_len)) {
+        *psize = 0;
+        if (psab_tab)
+            *psab_tab = NULL;
+        if (psab_tab_len)
+            *psab_tab_len = 0;
+        return NULL;
+    }
     memset(s, 0, sizeof(*s));
     s->ctx = ctx;
+    s->transfer_tab = transfer_tab;
+    s->transfer_len = transfer_len;
     s->allow_bytecode = ((flags & JS_WRITE_OBJ_BYTECODE) != 0);
     s->allow_sab = ((flags & JS_WRITE_OBJ_SAB) != 0);
     s->allow_reference = ((flags & JS_WRITE_OBJ_REFERENCE) != 0);
@@ -36913,7 +40912,10 @@ uint8_t *JS_WriteObject2(JSContext *ctx, size_t *psize, JSValueConst obj,
         s->first_atom = JS_ATOM_END;
     else
         s->first_atom = 1;
-    js_dbuf_init(ctx, &s->dbuf);
+    if (flags & JS_WRITE_OBJ_MALLOC)
+        dbuf_init(&s->dbuf);
+    else
+        js_dbuf_init(ctx, &s->dbuf);
     js_object_list_init(&s->object_list);
 
     if (JS_WriteObjectRec(s, obj))
@@ -36942,10 +40944,17 @@ uint8_t *JS_WriteObject2(JSContext *ctx, size_t *psize, JSValueConst obj,
     return NULL;
 }
 
+uint8_t *JS_WriteObject2(JSContext *ctx, size_t *psize, JSValueConst obj,
+                         int flags, uint8_t ***psab_tab, size_t *psab_tab_len)
+{
+    return JS_WriteObject3(ctx, psize, obj, flags, psab_tab, psab_tab_len,
+                           NULL, 0);
+}
+
 uint8_t *JS_WriteObject(JSContext *ctx, size_t *psize, JSValueConst obj,
                         int flags)
 {
-    return JS_WriteObject2(ctx, psize, obj, flags, NULL, NULL);
+    return JS_WriteObject3(ctx, psize, obj, flags, NULL, NULL, NULL, 0);
 }
 
 typedef struct BCReaderState {
@@ -36959,6 +40968,11 @@ typedef struct BCReaderState {
     BOOL allow_bytecode : 8;
     BOOL is_rom_data : 8;
     BOOL allow_reference : 8;
+    JSValueConst *transfer_tab;
+    int transfer_len;
+    /* if not NULL, the nested functions are read on their first call */
+    JSBytecodeImage *image;
+    int func_level; /* number of functions being read */
     /* object references */
     JSObject **objects;
     int objects_count;
@@ -37332,6 +41346,121 @@ static int BC_add_object_ref(BCReaderState *s, JSValueConst obj)
     return BC_add_object_ref1(s, JS_VALUE_GET_OBJ(obj));
 }
 
+static int JS_ReadClosureVars(BCReaderState *s, JSFunctionBytecode *b)
+{
+    uint8_t v8;
+    int idx, i;
+
+    if (b->closure_var_count != 0) {
+        bc_read_trace(s, "closure vars {\n");
+        for(i = 0; i < b->closure_var_count; i++) {
+            JSClosureVar *cv = &b->closure_var[i];
+            int var_idx;
+            if (bc_get_atom(s, &cv->var_name))
+                return -1;
+            if (bc_get_leb128_int(s, &var_idx))
+                return -1;
+            cv->var_idx = var_idx;
+            if (bc_get_u8(s, &v8))
+                return -1;
+            idx = 0;
+            cv->is_local = bc_get_flags(v8, &idx, 1);
+            cv->is_arg = bc_get_flags(v8, &idx, 1);
+            cv->is_const = bc_get_flags(v8, &idx, 1);
+            cv->is_lexical = bc_get_flags(v8, &idx, 1);
+            cv->var_kind = bc_get_flags(v8, &idx, 4);
+#ifdef DUMP_READ_OBJECT
+            bc_read_trace(s, "name: "); print_atom(s->ctx, cv->var_name); printf("\n");
+#endif
+        }
+        bc_read_trace(s, "}\n");
+    }
+    return 0;
+}
+
+/* Create a function whose bytecode is read from the image on its
+   first call. Only the data needed to create the closures and the
+   debug information are read. 's->ptr' is after the function header
+   read in 'bc'. */
+static JSValue JS_ReadLazyFunction(BCReaderState *s, JSFunctionBytecode *bc,
+                                   int local_count, const uint8_t *func_start,
+                                   const uint8_t *func_end)
+{
+    JSContext *ctx = s->ctx;
+    JSFunctionBytecode *b;
+    JSLazyFunction *lf;
+    JSValue obj;
+    int i, function_size, closure_var_offset, lazy_offset, len;
+    uint32_t v;
+    uint8_t v8;
+
+    function_size = sizeof(*b);
+    closure_var_offset = function_size;
+    function_size += bc->closure_var_count * sizeof(*bc->closure_var);
+    function_size = (function_size + 7) & ~7;
+    lazy_offset = function_size;
+    function_size += sizeof(*lf);
+
+    b = js_mallocz(ctx, function_size);
+    if (!b) {
+        JS_FreeAtom(ctx, bc->func_name);
+        return JS_EXCEPTION;
+    }
+    memcpy(b, bc, offsetof(JSFunctionBytecode, debug));
+    b->header.ref_count = 1;
+    b->arg_count = 0;
+    b->var_count = 0;
+    b->stack_size = 0;
+    b->cpool_count = 0;
+    b->byte_code_len = 0;
+    if (b->closure_var_count != 0) {
+        b->closure_var = (void *)((uint8_t*)b + closure_var_offset);
+    }
+    lf = (void *)((uint8_t*)b + lazy_offset);
+    lf->image = s->image;
+    lf->image->ref_count++;
+    lf->image_pos = func_start - s->buf_start;
+    b->lazy = lf;
+    add_gc_object(ctx->rt, &b->header, JS_GC_OBJ_TYPE_FUNCTION_BYTECODE);
+    ctx->rt->lazy_func_count++;
+    obj = JS_MKPTR(JS_TAG_FUNCTION_BYTECODE, b);
+
+    /* skip the variable definitions */
+    for(i = 0; i < local_count; i++) {
+        if (bc_get_leb128(s, &v) || bc_get_leb128(s, &v) ||
+            bc_get_leb128(s, &v) || bc_get_u8(s, &v8))
+            goto fail;
+    }
+    if (JS_ReadClosureVars(s, b))
+        goto fail;
+    if (s->buf_end - s->ptr < bc->byte_code_len) {
+        bc_read_error_end(s);
+        goto fail;
+    }
+    s->ptr += bc->byte_code_len;
+    if (b->has_debug) {
+        if (bc_get_atom(s, &b->debug.filename))
+            goto fail;
+        if (bc_get_leb128_int(s, &len))
+            goto fail;
+        if (len) {
+            b->debug.pc2line_buf = js_mallocz(ctx, len);
+            if (!b->debug.pc2line_buf)
+                goto fail;
+            b->debug.pc2line_len = len;
+            if (bc_get_buf(s, b->debug.pc2line_buf, len))
+                goto fail;
+        }
+    }
+    /* the source code and the constant pool are not read */
+    s->ptr = func_end;
+    b->realm = JS_DupContext(ctx);
+    return obj;
+ fail:
+    JS_FreeValue(ctx, obj);
+    return JS_EXCEPTION;
+}
+
 static JSValue JS_ReadFunctionTag(BCReaderState *s)
 {
     JSContext *ctx = s->ctx;
@@ -37342,11 +41471,18 @@ static JSValue JS_ReadFunctionTag(BCReaderState *s)
     int idx, i, local_count;
     int function_size, cpool_offset, byte_code_offset;
     int closure_var_offset, vardefs_offset;
+    const uint8_t *func_start;
+    uint32_t func_size;
 
     memset(&bc, 0, sizeof(bc));
     bc.header.ref_count = 1;
     //bc.gc_header.mark = 0;
 
+    func_start = s->ptr;
+    if (bc_get_u32(s, &func_size))
+        goto fail;
+    if (func_size > s->buf_end - s->ptr)
+        return JS_ThrowSyntaxError(ctx, "invalid function size");
     if (bc_get_u16(s, &v16))
         goto fail;
     idx = 0;
@@ -37384,6 +41520,11 @@ static JSValue JS_ReadFunctionTag(BCReaderState *s)
     if (bc_get_leb128_int(s, &local_count))
         goto fail;
 
+    if (s->image && s->func_level > 0) {
+        return JS_ReadLazyFunction(s, &bc, local_count, func_start,
+                                   func_start + 4 + func_size);
+    }
+
     if (bc.has_debug) {
         function_size = sizeof(*b);
     } else {
@@ -37453,30 +41594,8 @@ static JSValue JS_ReadFunctionTag(BCReaderState *s)
         }
         bc_read_trace(s, "}\n");
     }
-    if (b->closure_var_count != 0) {
-        bc_read_trace(s, "closure vars {\n");
-        for(i = 0; i < b->closure_var_count; i++) {
-            JSClosureVar *cv = &b->closure_var[i];
-            int var_idx;
-            if (bc_get_atom(s, &cv->var_name))
-                goto fail;
-            if (bc_get_leb128_int(s, &var_idx))
-                goto fail;
-            cv->var_idx = var_idx;
-            if (bc_get_u8(s, &v8))
-                goto fail;
-            idx = 0;
-            cv->is_local = bc_get_flags(v8, &idx, 1);
-            cv->is_arg = bc_get_flags(v8, &idx, 1);
-            cv->is_const = bc_get_flags(v8, &idx, 1);
-            cv->is_lexical = bc_get_flags(v8, &idx, 1);
-            cv->var_kind = bc_get_flags(v8, &idx, 4);
-#ifdef DUMP_READ_OBJECT
-            bc_read_trace(s, "name: "); print_atom(s->ctx, cv->var_name); printf("\n");
-#endif
-        }
-        bc_read_trace(s, "}\n");
-    }
+    if (JS_ReadClosureVars(s, b))
+        goto fail;
     {
         bc_read_trace(s, "bytecode {\n");
         if (JS_ReadFunctionBytecode(s, b, byte_code_offset, b->byte_code_len))
@@ -37514,13 +41633,17 @@ static JSValue JS_ReadFunctionTag(BCReaderState *s)
     }
     if (b->cpool_count != 0) {
         bc_read_trace(s, "cpool {\n");
+        s->func_level++;
         for(i = 0; i < b->cpool_count; i++) {
             JSValue val;
             val = JS_ReadObjectRec(s);
-            if (JS_IsException(val))
+            if (JS_IsException(val)) {
+                s->func_level--;
                 goto fail;
+            }
             b->cpool[i] = val;
         }
+        s->func_level--;
         bc_read_trace(s, "}\n");
     }
     b->realm = JS_DupContext(ctx);
@@ -37796,6 +41919,26 @@ static JSValue JS_ReadArrayBuffer(BCReaderState *s)
     return JS_EXCEPTION;
 }
 
+static JSValue JS_ReadTransferredArrayBuffer(BCReaderState *s)
+{
+    JSContext *ctx = s->ctx;
+    uint32_t idx;
+    JSValue obj;
+
+    if (bc_get_leb128(s, &idx))
+        return JS_EXCEPTION;
+    if (idx >= s->transfer_len) {
+        JS_ThrowSyntaxError(ctx, "invalid transferred object index");
+        return JS_EXCEPTION;
+    }
+    obj = JS_DupValue(ctx, s->transfer_tab[idx]);
+    if (BC_add_object_ref(s, obj)) {
+        JS_FreeValue(ctx, obj);
+        return JS_EXCEPTION;
+    }
+    return obj;
+}
+
 static JSValue JS_ReadSharedArrayBuffer(BCReaderState *s)
 {
     JSContext *ctx = s->ctx;
@@ -37951,6 +42094,9 @@ static JSValue JS_ReadObjectRec(BCReaderState *s)
             goto invalid_tag;
         obj = JS_ReadSharedArrayBuffer(s);
         break;
+    case BC_TAG_ARRAY_BUFFER_TRANSFER:
+        obj = JS_ReadTransferredArrayBuffer(s);
+        break;
     case BC_TAG_DATE:
         obj = JS_ReadDate(s);
         break;
@@ -37976,95 +42122,1900 @@ static JSValue JS_ReadObjectRec(BCReaderState *s)
         }
         break;
     default:
-    invalid_tag:
-        return JS_ThrowSyntaxError(ctx, "invalid tag (tag=%d pos=%u)",
-                                   tag, (unsigned int)(s->ptr - s->buf_start));
+    invalid_tag:
+        return JS_ThrowSyntaxError(ctx, "invalid tag (tag=%d pos=%u)",
+                                   tag, (unsigned int)(s->ptr - s->buf_start));
+    }
+    bc_read_trace(s, "}\n");
+    return obj;
+}
+
+static int JS_ReadObjectAtoms(BCReaderState *s)
+{
+    uint8_t v8;
+    JSString *p;
+    int i;
+    JSAtom atom;
+
+    if (bc_get_u8(s, &v8))
+        return -1;
+    if (v8 != BC_VERSION) {
+        JS_ThrowSyntaxError(s->ctx, "invalid version (%d expected=%d)",
+                            v8, BC_VERSION);
+        return -1;
+    }
+    if (bc_get_leb128(s, &s->idx_to_atom_count))
+        return -1;
+
+    bc_read_trace(s, "%d atom indexes {\n", s->idx_to_atom_count);
+
+    if (s->idx_to_atom_count != 0) {
+        s->idx_to_atom = js_mallocz(s->ctx, s->idx_to_atom_count *
+                                    sizeof(s->idx_to_atom[0]));
+        if (!s->idx_to_atom)
+            return s->error_state = -1;
+    }
+    for(i = 0; i < s->idx_to_atom_count; i++) {
+        p = JS_ReadString(s);
+        if (!p)
+            return -1;
+        atom = JS_NewAtomStr(s->ctx, p);
+        if (atom == JS_ATOM_NULL)
+            return s->error_state = -1;
+        s->idx_to_atom[i] = atom;
+        if (s->is_rom_data && (atom != (i + s->first_atom)))
+            s->is_rom_data = FALSE; /* atoms must be relocated */
+    }
+    bc_read_trace(s, "}\n");
+    return 0;
+}
+
+static void bc_reader_free(BCReaderState *s)
+{
+    int i;
+    if (s->idx_to_atom) {
+        for(i = 0; i < s->idx_to_atom_count; i++) {
+            JS_FreeAtom(s->ctx, s->idx_to_atom[i]);
+        }
+        js_free(s->ctx, s->idx_to_atom);
+    }
+    js_free(s->ctx, s->objects);
+}
+
+/* 'transfer_tab' contains the ArrayBuffers given to JS_WriteObject3() */
+JSValue JS_ReadObject2(JSContext *ctx, const uint8_t *buf, size_t buf_len,
+                       int flags, JSValueConst *transfer_tab, int transfer_len)
+{
+    BCReaderState ss, *s = &ss;
+    JSValue obj;
+
+    ctx->binary_object_count += 1;
+    ctx->binary_object_size += buf_len;
+
+    memset(s, 0, sizeof(*s));
+    s->ctx = ctx;
+    s->buf_start = buf;
+    s->buf_end = buf + buf_len;
+    s->ptr = buf;
+    s->allow_bytecode = ((flags & JS_READ_OBJ_BYTECODE) != 0);
+    s->is_rom_data = ((flags & JS_READ_OBJ_ROM_DATA) != 0);
+    s->allow_sab = ((flags & JS_READ_OBJ_SAB) != 0);
+    s->allow_reference = ((flags & JS_READ_OBJ_REFERENCE) != 0);
+    s->transfer_tab = transfer_tab;
+    s->transfer_len = transfer_len;
+    if (s->allow_bytecode)
+        s->first_atom = JS_ATOM_END;
+    else
+        s->first_atom = 1;
+    if (JS_ReadObjectAtoms(s)) {
+        obj = JS_EXCEPTION;
+    } else {
+        obj = JS_ReadObjectRec(s);
+    }
+    bc_reader_free(s);
+    return obj;
+}
+
+JSValue JS_ReadObject(JSContext *ctx, const uint8_t *buf, size_t buf_len,
+                       int flags)
+{
+    return JS_ReadObject2(ctx, buf, buf_len, flags, NULL, 0);
+}
+
+static void js_free_bytecode_image(JSRuntime *rt, JSBytecodeImage *img)
+{
+    int i;
+
+    if (--img->ref_count > 0)
+        return;
+    if (img->idx_to_atom) {
+        for(i = 0; i < img->idx_to_atom_count; i++)
+            JS_FreeAtomRT(rt, img->idx_to_atom[i]);
+        js_free_rt(rt, img->idx_to_atom);
+    }
+    if (img->free_func)
+        img->free_func(rt, img->opaque, img->buf, img->buf_len);
+    js_free_rt(rt, img);
+}
+
+/* The image keeps the atom table so that the functions can be read
+   later. JS_READ_OBJ_ROM_DATA and JS_READ_OBJ_REFERENCE are not
+   supported. */
+JSValue JS_ReadObjectImage(JSContext *ctx, const uint8_t *buf, size_t buf_len,
+                           int flags, JSFreeBytecodeImageFunc *free_func,
+                           void *opaque)
+{
+    BCReaderState ss, *s = &ss;
+    JSBytecodeImage *img;
+    JSValue obj;
+
+    img = js_mallocz(ctx, sizeof(*img));
+    if (!img) {
+        if (free_func)
+            free_func(ctx->rt, opaque, buf, buf_len);
+        return JS_EXCEPTION;
+    }
+    img->ref_count = 1;
+    img->buf = buf;
+    img->buf_len = buf_len;
+    img->free_func = free_func;
+    img->opaque = opaque;
+
+    ctx->binary_object_count += 1;
+    ctx->binary_object_size += buf_len;
+
+    memset(s, 0, sizeof(*s));
+    s->ctx = ctx;
+    s->buf_start = buf;
+    s->buf_end = buf + buf_len;
+    s->ptr = buf;
+    s->allow_bytecode = ((flags & JS_READ_OBJ_BYTECODE) != 0);
+    s->allow_sab = ((flags & JS_READ_OBJ_SAB) != 0);
+    /* the function positions are stored on 32 bits */
+    if (buf_len <= UINT32_MAX)
+        s->image = img;
+    if (s->allow_bytecode)
+        s->first_atom = JS_ATOM_END;
+    else
+        s->first_atom = 1;
+    if (JS_ReadObjectAtoms(s)) {
+        obj = JS_EXCEPTION;
+    } else {
+        obj = JS_ReadObjectRec(s);
+    }
+    img->first_atom = s->first_atom;
+    img->idx_to_atom = s->idx_to_atom;
+    img->idx_to_atom_count = s->idx_to_atom_count;
+    s->idx_to_atom = NULL;
+    bc_reader_free(s);
+    js_free_bytecode_image(ctx->rt, img);
+    return obj;
+}
+
+/* read the function 'b' created by JS_ReadLazyFunction() */
+static JSFunctionBytecode *js_image_read_function(JSContext *ctx,
+                                                  JSFunctionBytecode *b)
+{
+    JSLazyFunction *lf = b->lazy;
+    JSBytecodeImage *img = lf->image;
+    BCReaderState ss, *s = &ss;
+    JSFunctionBytecode *b1;
+    JSValue obj;
+
+    memset(s, 0, sizeof(*s));
+    s->ctx = ctx;
+    s->buf_start = img->buf;
+    s->buf_end = img->buf + img->buf_len;
+    s->ptr = img->buf + lf->image_pos;
+    s->allow_bytecode = TRUE;
+    s->first_atom = img->first_atom;
+    s->idx_to_atom = img->idx_to_atom;
+    s->idx_to_atom_count = img->idx_to_atom_count;
+    s->image = img;
+    obj = JS_ReadFunctionTag(s);
+    js_free(ctx, s->objects);
+    if (JS_IsException(obj))
+        return NULL;
+    b1 = JS_VALUE_GET_PTR(obj);
+    if (b1->closure_var_count != b->closure_var_count) {
+        JS_FreeValue(ctx, obj);
+        JS_ThrowSyntaxError(ctx, "invalid lazy function");
+        return NULL;
+    }
+    lf->compiled = b1;
+    return b1;
+}
+
+/*******************************************************************/
+/* context snapshots */
+
+/* A snapshot contains the objects of a context which differ from a
+   newly created context (the "base" context). The objects which exist
+   in the base context (builtins, modules and objects created by the
+   embedder) are referenced by a path from the context roots so that
+   only the referenced lazily created builtins are instantiated when
+   reading. */
+
+enum {
+    JS_SNAP_REF_ROOT,
+    JS_SNAP_REF_VALUE,
+    JS_SNAP_REF_GETTER,
+    JS_SNAP_REF_SETTER,
+    JS_SNAP_REF_PROTO,
+};
+
+/* property record flags (the low bits are the JS_PROP_C_W_E flags) */
+#define JS_SNAP_PROP_SYMBOL    (1 << 3) /* the key is a symbol value */
+#define JS_SNAP_PROP_GETSET    (1 << 4)
+#define JS_SNAP_PROP_PROTOTYPE (1 << 5) /* not yet created 'prototype' */
+
+typedef struct {
+    JSObject *obj; /* object of the saved context */
+    JSObject *base_obj; /* same object in the base context */
+    int parent; /* -1 for a root */
+    uint8_t kind; /* JS_SNAP_REF_x */
+    uint32_t idx; /* root index or property name */
+    int used_idx; /* index in the saved reference table or -1 */
+} JSSnapshotRef;
+
+typedef struct {
+    BCWriterState bc;
+    JSContext *base_ctx;
+    JSSnapshotRef *refs;
+    int ref_count;
+    int ref_size;
+    JSObjectList ref_list; /* index in 'refs' of each object */
+    int *used_tab; /* saved references */
+    int used_count;
+    int used_size;
+    /* the following lists are used as pointer sets */
+    JSObjectList symbol_list;
+    JSObjectList var_ref_list;
+    JSObjectList func_list;
+} JSSnapshotWriter;
+
+static const uint16_t js_snapshot_root_offsets[] = {
+    offsetof(JSContext, global_obj),
+    offsetof(JSContext, global_var_obj),
+    offsetof(JSContext, function_proto),
+    offsetof(JSContext, function_ctor),
+    offsetof(JSContext, array_ctor),
+    offsetof(JSContext, regexp_ctor),
+    offsetof(JSContext, promise_ctor),
+    offsetof(JSContext, iterator_proto),
+    offsetof(JSContext, async_iterator_proto),
+    offsetof(JSContext, array_proto_values),
+    offsetof(JSContext, throw_type_error),
+    offsetof(JSContext, eval_obj),
+};
+
+static uint32_t js_snapshot_root_count(JSContext *ctx)
+{
+    return countof(js_snapshot_root_offsets) + JS_NATIVE_ERROR_COUNT +
+        ctx->rt->class_count;
+}
+
+static JSValue *js_snapshot_get_root_ptr(JSContext *ctx, uint32_t idx)
+{
+    if (idx < countof(js_snapshot_root_offsets))
+        return (JSValue *)((uint8_t *)ctx + js_snapshot_root_offsets[idx]);
+    idx -= countof(js_snapshot_root_offsets);
+    if (idx < JS_NATIVE_ERROR_COUNT)
+        return &ctx->native_error_proto[idx];
+    idx -= JS_NATIVE_ERROR_COUNT;
+    if (idx < ctx->rt->class_count)
+        return &ctx->class_proto[idx];
+    return NULL;
+}
+
+static JSValueConst js_snapshot_get_root(JSContext *ctx, uint32_t idx)
+{
+    JSValue *pval = js_snapshot_get_root_ptr(ctx, idx);
+    return pval ? *pval : JS_UNDEFINED;
+}
+
+/* 'p' is considered as the same object as 'base_p' if it has the same
+   class and the same native function */
+static int js_snapshot_add_ref(JSSnapshotWriter *w, JSObject *p,
+                               JSObject *base_p, int parent, int kind,
+                               uint32_t idx)
+{
+    JSContext *ctx = w->bc.ctx;
+    JSSnapshotRef *r;
+
+    if (p->class_id != base_p->class_id ||
+        js_object_list_find(ctx, &w->ref_list, p) >= 0)
+        return 0;
+    switch(p->class_id) {
+    case JS_CLASS_C_FUNCTION:
+        if (p->u.cfunc.c_function.generic != base_p->u.cfunc.c_function.generic ||
+            p->u.cfunc.magic != base_p->u.cfunc.magic ||
+            p->u.cfunc.cproto != base_p->u.cfunc.cproto)
+            return 0;
+        break;
+    case JS_CLASS_C_FUNCTION_DATA:
+        if (p->u.c_function_data_record->func != base_p->u.c_function_data_record->func ||
+            p->u.c_function_data_record->magic != base_p->u.c_function_data_record->magic)
+            return 0;
+        break;
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+    case JS_CLASS_BOUND_FUNCTION:
+        /* cannot be compared */
+        return 0;
+    default:
+        break;
+    }
+    if (js_resize_array(ctx, (void **)&w->refs, sizeof(w->refs[0]),
+                        &w->ref_size, w->ref_count + 1))
+        return -1;
+    if (js_object_list_add(ctx, &w->ref_list, p))
+        return -1;
+    r = &w->refs[w->ref_count++];
+    r->obj = p;
+    r->base_obj = base_p;
+    r->parent = parent;
+    r->kind = kind;
+    r->idx = idx;
+    r->used_idx = -1;
+    return 0;
+}
+
+/* find the objects reachable from the reference 'ref_idx' which also
+   exist in the base context */
+static int js_snapshot_find_refs(JSSnapshotWriter *w, int ref_idx)
+{
+    JSObject *p = w->refs[ref_idx].obj;
+    JSObject *base_p = w->refs[ref_idx].base_obj;
+    JSShapeProperty *prs, *base_prs;
+    JSProperty *pr, *base_pr;
+    JSPropertyDescriptor desc;
+    JSAtom atom;
+    uint32_t i;
+    int ret;
+
+    if (p->shape->proto && base_p->shape->proto) {
+        if (js_snapshot_add_ref(w, p->shape->proto, base_p->shape->proto,
+                                ref_idx, JS_SNAP_REF_PROTO, 0))
+            return -1;
+    }
+    /* the base object shape may be modified in the loop */
+    for(i = 0; i < base_p->shape->prop_count; i++) {
+        base_prs = &get_shape_prop(base_p->shape)[i];
+        atom = base_prs->atom;
+        if (atom == JS_ATOM_NULL)
+            continue;
+        prs = find_own_property(&pr, p, atom);
+        if (!prs || (prs->flags & JS_PROP_TMASK) == JS_PROP_AUTOINIT)
+            continue;
+        if ((base_prs->flags & JS_PROP_TMASK) == JS_PROP_AUTOINIT) {
+            /* the property was used in the saved context: instantiate it
+               in the base context to compare it */
+            ret = JS_GetOwnPropertyInternal(w->base_ctx, &desc, base_p, atom);
+            if (ret < 0)
+                return -1;
+            if (ret)
+                js_free_desc(w->base_ctx, &desc);
+        }
+        base_prs = find_own_property(&base_pr, base_p, atom);
+        if ((prs->flags & JS_PROP_TMASK) != (base_prs->flags & JS_PROP_TMASK))
+            continue;
+        if ((prs->flags & JS_PROP_TMASK) == JS_PROP_GETSET) {
+            if (pr->u.getset.getter && base_pr->u.getset.getter &&
+                js_snapshot_add_ref(w, pr->u.getset.getter,
+                                    base_pr->u.getset.getter, ref_idx,
+                                    JS_SNAP_REF_GETTER, atom))
+                return -1;
+            if (pr->u.getset.setter && base_pr->u.getset.setter &&
+                js_snapshot_add_ref(w, pr->u.getset.setter,
+                                    base_pr->u.getset.setter, ref_idx,
+                                    JS_SNAP_REF_SETTER, atom))
+                return -1;
+        } else if ((prs->flags & JS_PROP_TMASK) == JS_PROP_VARREF) {
+            JSValue val = *pr->u.var_ref->pvalue;
+            JSValue base_val = *base_pr->u.var_ref->pvalue;
+            if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT &&
+                JS_VALUE_GET_TAG(base_val) == JS_TAG_OBJECT &&
+                js_snapshot_add_ref(w, JS_VALUE_GET_OBJ(val),
+                                    JS_VALUE_GET_OBJ(base_val),
+                                    ref_idx, JS_SNAP_REF_VALUE, atom))
+                return -1;
+        } else if ((prs->flags & JS_PROP_TMASK) == 0) {
+            if (JS_VALUE_GET_TAG(pr->u.value) == JS_TAG_OBJECT &&
+                JS_VALUE_GET_TAG(base_pr->u.value) == JS_TAG_OBJECT &&
+                js_snapshot_add_ref(w, JS_VALUE_GET_OBJ(pr->u.value),
+                                    JS_VALUE_GET_OBJ(base_pr->u.value),
+                                    ref_idx, JS_SNAP_REF_VALUE, atom))
+                return -1;
+        }
+    }
+    return 0;
+}
+
+static BOOL js_snapshot_same_obj(JSSnapshotWriter *w, JSObject *p,
+                                 JSObject *base_p)
+{
+    int idx;
+    if (!p || !base_p)
+        return (p == base_p);
+    idx = js_object_list_find(w->bc.ctx, &w->ref_list, p);
+    return (idx >= 0 && w->refs[idx].base_obj == base_p);
+}
+
+static BOOL js_snapshot_same_value(JSSnapshotWriter *w, JSValueConst val,
+                                   JSValueConst base_val)
+{
+    if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT) {
+        return (JS_VALUE_GET_TAG(base_val) == JS_TAG_OBJECT &&
+                js_snapshot_same_obj(w, JS_VALUE_GET_OBJ(val),
+                                     JS_VALUE_GET_OBJ(base_val)));
+    }
+    return js_same_value(w->bc.ctx, val, base_val);
+}
+
+/* return TRUE if the property 'prs' of 'p' is the same as in 'base_p' */
+static BOOL js_snapshot_same_prop(JSSnapshotWriter *w, JSShapeProperty *prs,
+                                  JSProperty *pr, JSObject *base_p)
+{
+    JSShapeProperty *base_prs;
+    JSProperty *base_pr;
+
+    if (!base_p)
+        return FALSE;
+    base_prs = find_own_property(&base_pr, base_p, prs->atom);
+    if (!base_prs || base_prs->flags != prs->flags)
+        return FALSE;
+    switch(prs->flags & JS_PROP_TMASK) {
+    case JS_PROP_GETSET:
+        return (js_snapshot_same_obj(w, pr->u.getset.getter,
+                                     base_pr->u.getset.getter) &&
+                js_snapshot_same_obj(w, pr->u.getset.setter,
+                                     base_pr->u.getset.setter));
+    case JS_PROP_VARREF:
+        /* module namespaces cannot be modified */
+        return TRUE;
+    case JS_PROP_AUTOINIT:
+        return (js_autoinit_get_id(pr) == js_autoinit_get_id(base_pr) &&
+                pr->u.init.opaque == base_pr->u.init.opaque);
+    default:
+        return js_snapshot_same_value(w, pr->u.value, base_pr->u.value);
+    }
+}
+
+static BOOL js_snapshot_is_modified(JSSnapshotWriter *w, JSSnapshotRef *r)
+{
+    JSObject *p = r->obj, *base_p = r->base_obj;
+    JSShapeProperty *prs;
+    JSProperty *pr;
+    uint32_t i;
+
+    if (p->extensible != base_p->extensible ||
+        !js_snapshot_same_obj(w, p->shape->proto, base_p->shape->proto))
+        return TRUE;
+    if (p->class_id == JS_CLASS_ARRAY) {
+        if (p->fast_array != base_p->fast_array)
+            return TRUE;
+        if (p->fast_array) {
+            if (p->u.array.count != base_p->u.array.count)
+                return TRUE;
+            for(i = 0; i < p->u.array.count; i++) {
+                JSValue v1, v2;
+                BOOL same;
+                v1 = js_array_get_element(w->bc.ctx, p, i);
+                v2 = js_array_get_element(w->bc.ctx, base_p, i);
+                same = js_snapshot_same_value(w, v1, v2);
+                JS_FreeValue(w->bc.ctx, v1);
+                JS_FreeValue(w->bc.ctx, v2);
+                if (!same)
+                    return TRUE;
+            }
+        }
+    }
+    for(i = 0, prs = get_shape_prop(p->shape); i < p->shape->prop_count;
+        i++, prs++) {
+        if (prs->atom != JS_ATOM_NULL &&
+            !js_snapshot_same_prop(w, prs, &p->prop[i], base_p))
+            return TRUE;
+    }
+    /* deleted properties */
+    for(i = 0, prs = get_shape_prop(base_p->shape);
+        i < base_p->shape->prop_count; i++, prs++) {
+        if (prs->atom != JS_ATOM_NULL && !find_own_property(&pr, p, prs->atom))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* return the index of the reference in the saved table */
+static int js_snapshot_use_ref(JSSnapshotWriter *w, int ref_idx)
+{
+    JSSnapshotRef *r = &w->refs[ref_idx];
+    int idx;
+
+    if (r->used_idx < 0) {
+        if (r->parent >= 0 && js_snapshot_use_ref(w, r->parent) < 0)
+            return -1;
+        if (js_resize_array(w->bc.ctx, (void **)&w->used_tab,
+                            sizeof(w->used_tab[0]),
+                            &w->used_size, w->used_count + 1))
+            return -1;
+        idx = w->used_count++;
+        w->used_tab[idx] = ref_idx;
+        /* 'r' may have been reallocated */
+        w->refs[ref_idx].used_idx = idx;
+    }
+    return w->refs[ref_idx].used_idx;
+}
+
+static int js_snapshot_write_value(JSSnapshotWriter *w, JSValueConst val);
+
+static BOOL js_snapshot_is_symbol_atom(JSRuntime *rt, JSAtom atom)
+{
+    return (atom >= JS_ATOM_END && !__JS_AtomIsTaggedInt(atom) &&
+            rt->atom_array[atom]->atom_type != JS_ATOM_TYPE_STRING);
+}
+
+static int js_snapshot_write_symbol(JSSnapshotWriter *w, JSAtomStruct *p)
+{
+    BCWriterState *s = &w->bc;
+    JSAtom atom = js_get_atom_index(s->ctx->rt, p);
+    int idx;
+
+    bc_put_u8(s, BC_TAG_SYMBOL);
+    if (atom < JS_ATOM_END) {
+        /* well-known symbol */
+        bc_put_u8(s, 0);
+        bc_put_leb128(s, atom);
+        return 0;
+    }
+    idx = js_object_list_find(s->ctx, &w->symbol_list, (JSObject *)p);
+    if (idx >= 0) {
+        bc_put_u8(s, 1);
+        bc_put_leb128(s, idx);
+        return 0;
+    }
+    if (js_object_list_add(s->ctx, &w->symbol_list, (JSObject *)p))
+        return -1;
+    bc_put_u8(s, 2);
+    bc_put_u8(s, p->atom_type);
+    JS_WriteString(s, p);
+    return 0;
+}
+
+static int js_snapshot_write_prop(JSSnapshotWriter *w, JSShapeProperty *prs,
+                                  JSProperty *pr)
+{
+    BCWriterState *s = &w->bc;
+    JSAtom atom = prs->atom;
+    int flags;
+
+    flags = prs->flags & JS_PROP_C_W_E;
+    switch(prs->flags & JS_PROP_TMASK) {
+    case JS_PROP_GETSET:
+        flags |= JS_SNAP_PROP_GETSET;
+        break;
+    case JS_PROP_AUTOINIT:
+        if (js_autoinit_get_id(pr) != JS_AUTOINIT_ID_PROTOTYPE)
+            goto unsupported;
+        flags |= JS_SNAP_PROP_PROTOTYPE;
+        break;
+    case JS_PROP_VARREF:
+    unsupported:
+        JS_ThrowTypeError(s->ctx, "unsupported property in snapshot");
+        return -1;
+    default:
+        break;
+    }
+    if (js_snapshot_is_symbol_atom(s->ctx->rt, atom)) {
+        bc_put_u8(s, flags | JS_SNAP_PROP_SYMBOL);
+        if (js_snapshot_write_symbol(w, s->ctx->rt->atom_array[atom]))
+            return -1;
+    } else {
+        bc_put_u8(s, flags);
+        if (bc_put_atom(s, atom))
+            return -1;
+    }
+    if (flags & JS_SNAP_PROP_GETSET) {
+        if (js_snapshot_write_value(w, pr->u.getset.getter ?
+                                    JS_MKPTR(JS_TAG_OBJECT, pr->u.getset.getter) : JS_UNDEFINED))
+            return -1;
+        if (js_snapshot_write_value(w, pr->u.getset.setter ?
+                                    JS_MKPTR(JS_TAG_OBJECT, pr->u.getset.setter) : JS_UNDEFINED))
+            return -1;
+    } else if (!(flags & JS_SNAP_PROP_PROTOTYPE)) {
+        if (js_snapshot_write_value(w, pr->u.value))
+            return -1;
+    }
+    return 0;
+}
+
+/* write the elements and the properties of 'p'. If 'base_p' is not
+   NULL, only the differences with 'base_p' are written. */
+static int js_snapshot_write_props(JSSnapshotWriter *w, JSObject *p,
+                                   JSObject *base_p)
+{
+    BCWriterState *s = &w->bc;
+    JSShapeProperty *prs;
+    JSProperty *pr;
+    uint32_t i, count;
+
+    if (p->class_id == JS_CLASS_ARRAY) {
+        count = p->fast_array ? p->u.array.count : 0;
+        bc_put_leb128(s, count);
+        for(i = 0; i < count; i++) {
+            JSValue val;
+            int ret;
+            val = js_array_get_element(s->ctx, p, i);
+            ret = js_snapshot_write_value(w, val);
+            JS_FreeValue(s->ctx, val);
+            if (ret)
+                return -1;
+        }
+    }
+    if (base_p) {
+        count = 0;
+        for(i = 0, prs = get_shape_prop(base_p->shape);
+            i < base_p->shape->prop_count; i++, prs++) {
+            if (prs->atom != JS_ATOM_NULL &&
+                !find_own_property(&pr, p, prs->atom))
+                count++;
+        }
+        bc_put_leb128(s, count);
+        for(i = 0, prs = get_shape_prop(base_p->shape);
+            i < base_p->shape->prop_count; i++, prs++) {
+            if (prs->atom != JS_ATOM_NULL &&
+                !find_own_property(&pr, p, prs->atom)) {
+                if (bc_put_atom(s, prs->atom))
+                    return -1;
+            }
+        }
+    }
+    count = 0;
+    for(i = 0, prs = get_shape_prop(p->shape); i < p->shape->prop_count;
+        i++, prs++) {
+        if (prs->atom != JS_ATOM_NULL &&
+            !js_snapshot_same_prop(w, prs, &p->prop[i], base_p))
+            count++;
+    }
+    bc_put_leb128(s, count);
+    /* the shape cannot be modified while writing */
+    for(i = 0, prs = get_shape_prop(p->shape); i < p->shape->prop_count;
+        i++, prs++) {
+        if (prs->atom != JS_ATOM_NULL &&
+            !js_snapshot_same_prop(w, prs, &p->prop[i], base_p)) {
+            if (js_snapshot_write_prop(w, prs, &p->prop[i]))
+                return -1;
+        }
+    }
+    bc_put_u8(s, p->extensible);
+    return 0;
+}
+
+static int js_snapshot_write_function(JSSnapshotWriter *w, JSObject *p)
+{
+    BCWriterState *s = &w->bc;
+    JSFunctionBytecode *b = p->u.func.function_bytecode;
+    JSVarRef *var_ref;
+    int i, idx;
+
+    for(i = 0; i < b->closure_var_count; i++) {
+        var_ref = p->u.func.var_refs[i];
+        idx = js_object_list_find(s->ctx, &w->var_ref_list, (JSObject *)var_ref);
+        if (idx >= 0) {
+            bc_put_leb128(s, idx);
+            continue;
+        }
+        if (!var_ref->is_detached) {
+            JS_ThrowTypeError(s->ctx, "cannot save the variables of a running function");
+            return -1;
+        }
+        bc_put_leb128(s, w->var_ref_list.object_count);
+        if (js_object_list_add(s->ctx, &w->var_ref_list, (JSObject *)var_ref))
+            return -1;
+        if (js_snapshot_write_value(w, var_ref->value))
+            return -1;
+    }
+    if (js_snapshot_write_value(w, p->u.func.home_object ?
+                                JS_MKPTR(JS_TAG_OBJECT, p->u.func.home_object) : JS_NULL))
+        return -1;
+    bc_put_u8(s, p->is_constructor);
+    return 0;
+}
+
+static int js_snapshot_write_object(JSSnapshotWriter *w, JSObject *p)
+{
+    BCWriterState *s = &w->bc;
+    JSFunctionBytecode *b;
+    JSMapState *ms;
+    JSMapRecord *mr;
+    struct list_head *el;
+    int idx;
+
+    idx = js_object_list_find(s->ctx, &w->ref_list, p);
+    if (idx >= 0) {
+        idx = js_snapshot_use_ref(w, idx);
+        if (idx < 0)
+            return -1;
+        bc_put_u8(s, BC_TAG_BUILTIN_REFERENCE);
+        bc_put_leb128(s, idx);
+        return 0;
+    }
+    idx = js_object_list_find(s->ctx, &s->object_list, p);
+    if (idx >= 0) {
+        bc_put_u8(s, BC_TAG_OBJECT_REFERENCE);
+        bc_put_leb128(s, idx);
+        return 0;
+    }
+    switch(p->class_id) {
+    case JS_CLASS_OBJECT:
+    case JS_CLASS_ARRAY:
+    case JS_CLASS_ERROR:
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+    case JS_CLASS_REGEXP:
+    case JS_CLASS_MAP:
+    case JS_CLASS_SET:
+        break;
+    default:
+        /* Date, ArrayBuffer, typed arrays... */
+        return JS_WriteObjectRec(s, JS_MKPTR(JS_TAG_OBJECT, p));
+    }
+    if (js_object_list_add(s->ctx, &s->object_list, p))
+        return -1;
+    bc_put_u8(s, BC_TAG_SNAPSHOT_OBJECT);
+    bc_put_leb128(s, p->class_id);
+    /* data needed to create the object */
+    switch(p->class_id) {
+    case JS_CLASS_REGEXP:
+        JS_WriteString(s, p->u.regexp.pattern);
+        JS_WriteString(s, p->u.regexp.bytecode);
+        break;
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+        b = p->u.func.function_bytecode;
+        idx = js_object_list_find(s->ctx, &w->func_list, (JSObject *)b);
+        if (idx >= 0) {
+            bc_put_leb128(s, idx);
+        } else {
+            bc_put_leb128(s, w->func_list.object_count);
+            if (js_object_list_add(s->ctx, &w->func_list, (JSObject *)b))
+                return -1;
+            if (JS_WriteFunctionTag(s, JS_MKPTR(JS_TAG_FUNCTION_BYTECODE, b)))
+                return -1;
+        }
+        break;
+    default:
+        break;
+    }
+    if (js_snapshot_write_value(w, p->shape->proto ?
+                                JS_MKPTR(JS_TAG_OBJECT, p->shape->proto) : JS_NULL))
+        return -1;
+    switch(p->class_id) {
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+        if (js_snapshot_write_function(w, p))
+            return -1;
+        break;
+    case JS_CLASS_MAP:
+    case JS_CLASS_SET:
+        ms = p->u.map_state;
+        bc_put_leb128(s, ms->record_count);
+        list_for_each(el, &ms->records) {
+            mr = list_entry(el, JSMapRecord, link);
+            if (mr->empty)
+                continue;
+            if (js_snapshot_write_value(w, mr->key))
+                return -1;
+            if (p->class_id == JS_CLASS_MAP &&
+                js_snapshot_write_value(w, mr->value))
+                return -1;
+        }
+        break;
+    default:
+        break;
+    }
+    return js_snapshot_write_props(w, p, NULL);
+}
+
+static int js_snapshot_write_value(JSSnapshotWriter *w, JSValueConst val)
+{
+    if (js_check_stack_overflow(w->bc.ctx->rt, 0)) {
+        JS_ThrowStackOverflow(w->bc.ctx);
+        return -1;
+    }
+    switch(JS_VALUE_GET_TAG(val)) {
+    case JS_TAG_OBJECT:
+        return js_snapshot_write_object(w, JS_VALUE_GET_OBJ(val));
+    case JS_TAG_SYMBOL:
+        return js_snapshot_write_symbol(w, JS_VALUE_GET_PTR(val));
+    default:
+        return JS_WriteObjectRec(&w->bc, val);
+    }
+}
+
+/* write the references and move them before the data */
+static int js_snapshot_write_refs(JSSnapshotWriter *w)
+{
+    BCWriterState *s = &w->bc;
+    DynBuf dbuf1;
+    JSSnapshotRef *r;
+    int i;
+
+    dbuf1 = s->dbuf;
+    js_dbuf_init(s->ctx, &s->dbuf);
+    bc_put_leb128(s, js_snapshot_root_count(s->ctx));
+    bc_put_leb128(s, w->used_count);
+    for(i = 0; i < w->used_count; i++) {
+        r = &w->refs[w->used_tab[i]];
+        bc_put_u8(s, r->kind);
+        if (r->kind == JS_SNAP_REF_ROOT) {
+            bc_put_leb128(s, r->idx);
+        } else {
+            bc_put_leb128(s, w->refs[r->parent].used_idx);
+            if (r->kind != JS_SNAP_REF_PROTO && bc_put_atom(s, r->idx))
+                goto fail;
+        }
+    }
+    if (dbuf_put(&s->dbuf, dbuf1.buf, dbuf1.size))
+        goto fail;
+    dbuf_free(&dbuf1);
+    return 0;
+ fail:
+    dbuf_free(&dbuf1);
+    return -1;
+}
+
+/* Save the state of 'ctx'. 'base_ctx' must be a new context of the
+   same runtime created the same way as the context given to
+   JS_ReadSnapshot(). */
+uint8_t *JS_WriteSnapshot(JSContext *ctx, JSContext *base_ctx, size_t *psize)
+{
+    JSSnapshotWriter ws, *w = &ws;
+    BCWriterState *s = &w->bc;
+    JSValueConst val, base_val;
+    uint32_t i, root_count;
+    int *patch_tab = NULL, patch_count = 0, patch_size = 0;
+
+    memset(w, 0, sizeof(*w));
+    s->ctx = ctx;
+    s->allow_bytecode = TRUE;
+    s->allow_reference = TRUE;
+    s->first_atom = JS_ATOM_END;
+    js_dbuf_init(ctx, &s->dbuf);
+    js_object_list_init(&s->object_list);
+    w->base_ctx = base_ctx;
+    js_object_list_init(&w->ref_list);
+    js_object_list_init(&w->symbol_list);
+    js_object_list_init(&w->var_ref_list);
+    js_object_list_init(&w->func_list);
+
+    if (ctx->rt != base_ctx->rt || ctx == base_ctx) {
+        JS_ThrowTypeError(ctx, "invalid base context");
+        goto fail;
+    }
+    root_count = js_snapshot_root_count(ctx);
+    for(i = 0; i < root_count; i++) {
+        val = js_snapshot_get_root(ctx, i);
+        base_val = js_snapshot_get_root(base_ctx, i);
+        if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT &&
+            JS_VALUE_GET_TAG(base_val) == JS_TAG_OBJECT &&
+            js_snapshot_add_ref(w, JS_VALUE_GET_OBJ(val),
+                                JS_VALUE_GET_OBJ(base_val), -1,
+                                JS_SNAP_REF_ROOT, i))
+            goto fail;
+    }
+    /* breadth first so that the paths are short */
+    for(i = 0; i < w->ref_count; i++) {
+        if (js_snapshot_find_refs(w, i))
+            goto fail;
+    }
+    for(i = 0; i < w->ref_count; i++) {
+        if (w->refs[i].obj->class_id != JS_CLASS_MODULE_NS &&
+            js_snapshot_is_modified(w, &w->refs[i])) {
+            if (js_resize_array(ctx, (void **)&patch_tab, sizeof(patch_tab[0]),
+                                &patch_size, patch_count + 1))
+                goto fail;
+            patch_tab[patch_count++] = i;
+        }
+    }
+
+    bc_put_leb128(s, patch_count);
+    for(i = 0; i < patch_count; i++) {
+        JSSnapshotRef *r = &w->refs[patch_tab[i]];
+        JSObject *p = r->obj;
+        int idx = js_snapshot_use_ref(w, patch_tab[i]);
+        if (idx < 0)
+            goto fail;
+        bc_put_leb128(s, idx);
+        if (js_snapshot_write_value(w, p->shape->proto ?
+                                    JS_MKPTR(JS_TAG_OBJECT, p->shape->proto) : JS_NULL))
+            goto fail;
+        /* 'r' may have been reallocated */
+        r = &w->refs[patch_tab[i]];
+        if (js_snapshot_write_props(w, p, r->base_obj))
+            goto fail;
+    }
+    if (js_snapshot_write_refs(w))
+        goto fail;
+    if (JS_WriteObjectAtoms(s))
+        goto fail;
+    *psize = s->dbuf.size;
+ done:
+    js_free(ctx, patch_tab);
+    js_free(ctx, w->refs);
+    js_free(ctx, w->used_tab);
+    js_object_list_end(ctx, &w->ref_list);
+    js_object_list_end(ctx, &w->symbol_list);
+    js_object_list_end(ctx, &w->var_ref_list);
+    js_object_list_end(ctx, &w->func_list);
+    js_object_list_end(ctx, &s->object_list);
+    js_free(ctx, s->atom_to_idx);
+    js_free(ctx, s->idx_to_atom);
+    return s->dbuf.buf;
+ fail:
+    dbuf_free(&s->dbuf);
+    s->dbuf.buf = NULL;
+    *psize = 0;
+    goto done;
+}
+
+typedef struct {
+    BCReaderState bc;
+    JSValue *refs;
+    int ref_count;
+    JSValue *symbols;
+    int symbol_count;
+    int symbol_size;
+    JSVarRef **var_refs;
+    int var_ref_count;
+    int var_ref_size;
+    JSValue *funcs;
+    int func_count;
+    int func_size;
+} JSSnapshotReader;
+
+static JSValue js_snapshot_read_value(JSSnapshotReader *r);
+
+static JSValue js_snapshot_read_symbol(JSSnapshotReader *r)
+{
+    BCReaderState *s = &r->bc;
+    JSContext *ctx = s->ctx;
+    JSString *p;
+    JSValue val;
+    uint32_t idx;
+    uint8_t kind, atom_type;
+
+    if (bc_get_u8(s, &kind))
+        return JS_EXCEPTION;
+    switch(kind) {
+    case 0:
+        if (bc_get_leb128(s, &idx))
+            return JS_EXCEPTION;
+        if (idx >= JS_ATOM_END || __JS_AtomIsTaggedInt(idx) ||
+            ctx->rt->atom_array[idx]->atom_type != JS_ATOM_TYPE_SYMBOL)
+            goto invalid;
+        return JS_AtomToValue(ctx, idx);
+    case 1:
+        if (bc_get_leb128(s, &idx))
+            return JS_EXCEPTION;
+        if (idx >= r->symbol_count)
+            goto invalid;
+        return JS_DupValue(ctx, r->symbols[idx]);
+    case 2:
+        if (bc_get_u8(s, &atom_type))
+            return JS_EXCEPTION;
+        if (atom_type != JS_ATOM_TYPE_GLOBAL_SYMBOL &&
+            atom_type != JS_ATOM_TYPE_SYMBOL &&
+            atom_type != JS_ATOM_TYPE_PRIVATE)
+            goto invalid;
+        p = JS_ReadString(s);
+        if (!p)
+            return JS_EXCEPTION;
+        if (js_resize_array(ctx, (void **)&r->symbols, sizeof(r->symbols[0]),
+                            &r->symbol_size, r->symbol_count + 1)) {
+            js_free_string(ctx->rt, p);
+            return JS_EXCEPTION;
+        }
+        val = JS_NewSymbol(ctx, p, atom_type);
+        if (JS_IsException(val))
+            return val;
+        r->symbols[r->symbol_count++] = JS_DupValue(ctx, val);
+        return val;
+    default:
+    invalid:
+        return JS_ThrowSyntaxError(ctx, "invalid symbol in snapshot");
+    }
+}
+
+static int js_snapshot_read_props(JSSnapshotReader *r, JSValueConst obj,
+                                  BOOL is_patch)
+{
+    BCReaderState *s = &r->bc;
+    JSContext *ctx = s->ctx;
+    JSObject *p = JS_VALUE_GET_OBJ(obj);
+    JSValue val, getter, setter;
+    JSProperty *pr;
+    JSAtom atom;
+    uint32_t i, count;
+    uint8_t flags, extensible;
+    int ret;
+
+    if (p->class_id == JS_CLASS_ARRAY) {
+        if (bc_get_leb128(s, &count))
+            return -1;
+        /* the elements of a patched array are all rewritten */
+        if (is_patch && p->fast_array && p->u.array.count > count) {
+            if (JS_SetProperty(ctx, obj, JS_ATOM_length,
+                               JS_NewUint32(ctx, count)) < 0)
+                return -1;
+        }
+        for(i = 0; i < count; i++) {
+            val = js_snapshot_read_value(r);
+            if (JS_IsException(val))
+                return -1;
+            if (JS_DefinePropertyValueUint32(ctx, obj, i, val,
+                                             JS_PROP_C_W_E | JS_PROP_THROW) < 0)
+                return -1;
+        }
+    }
+    if (is_patch) {
+        if (bc_get_leb128(s, &count))
+            return -1;
+        for(i = 0; i < count; i++) {
+            if (bc_get_atom(s, &atom))
+                return -1;
+            ret = JS_DeleteProperty(ctx, obj, atom, JS_PROP_THROW);
+            JS_FreeAtom(ctx, atom);
+            if (ret < 0)
+                return -1;
+        }
+    }
+    if (bc_get_leb128(s, &count))
+        return -1;
+    for(i = 0; i < count; i++) {
+        if (bc_get_u8(s, &flags))
+            return -1;
+        if (flags & JS_SNAP_PROP_SYMBOL) {
+            val = js_snapshot_read_value(r);
+            if (JS_IsException(val))
+                return -1;
+            if (JS_VALUE_GET_TAG(val) != JS_TAG_SYMBOL) {
+                JS_FreeValue(ctx, val);
+                JS_ThrowSyntaxError(ctx, "invalid property in snapshot");
+                return -1;
+            }
+            atom = js_symbol_to_atom(ctx, val);
+        } else {
+            if (bc_get_atom(s, &atom))
+                return -1;
+        }
+        if (flags & JS_SNAP_PROP_GETSET) {
+            getter = js_snapshot_read_value(r);
+            if (JS_IsException(getter))
+                goto fail;
+            setter = js_snapshot_read_value(r);
+            if (JS_IsException(setter)) {
+                JS_FreeValue(ctx, getter);
+                goto fail;
+            }
+            ret = JS_DefinePropertyGetSet(ctx, obj, atom, getter, setter,
+                                          (flags & JS_PROP_C_W_E) | JS_PROP_THROW);
+        } else if (flags & JS_SNAP_PROP_PROTOTYPE) {
+            if (find_own_property(&pr, p, atom) && delete_property(ctx, p, atom) < 0)
+                goto fail;
+            ret = JS_DefineAutoInitProperty(ctx, obj, atom,
+                                            JS_AUTOINIT_ID_PROTOTYPE, NULL,
+                                            flags & JS_PROP_C_W_E);
+        } else {
+            val = js_snapshot_read_value(r);
+            if (JS_IsException(val))
+                goto fail;
+            ret = JS_DefinePropertyValue(ctx, obj, atom, val,
+                                         (flags & JS_PROP_C_W_E) | JS_PROP_THROW);
+        }
+        JS_FreeAtom(ctx, atom);
+        if (ret < 0)
+            return -1;
+    }
+    if (bc_get_u8(s, &extensible))
+        return -1;
+    if (!extensible && JS_PreventExtensions(ctx, obj) < 0)
+        return -1;
+    return 0;
+ fail:
+    JS_FreeAtom(ctx, atom);
+    return -1;
+}
+
+static int js_snapshot_set_proto(JSSnapshotReader *r, JSValueConst obj)
+{
+    JSContext *ctx = r->bc.ctx;
+    JSObject *p = JS_VALUE_GET_OBJ(obj);
+    JSValue proto;
+    int ret;
+
+    proto = js_snapshot_read_value(r);
+    if (JS_IsException(proto))
+        return -1;
+    if (!JS_IsNull(proto) && !JS_IsObject(proto)) {
+        JS_FreeValue(ctx, proto);
+        JS_ThrowSyntaxError(ctx, "invalid prototype in snapshot");
+        return -1;
+    }
+    ret = 0;
+    if ((JS_IsNull(proto) && p->shape->proto) ||
+        (JS_IsObject(proto) && p->shape->proto != JS_VALUE_GET_OBJ(proto)))
+        ret = JS_SetPrototypeInternal(ctx, obj, proto, TRUE);
+    JS_FreeValue(ctx, proto);
+    return ret < 0 ? -1 : 0;
+}
+
+static int js_snapshot_read_function(JSSnapshotReader *r, JSValueConst obj)
+{
+    BCReaderState *s = &r->bc;
+    JSContext *ctx = s->ctx;
+    JSObject *p = JS_VALUE_GET_OBJ(obj);
+    JSFunctionBytecode *b = p->u.func.function_bytecode;
+    JSVarRef *var_ref;
+    JSValue val;
+    uint32_t idx;
+    uint8_t v8;
+    int i;
+
+    for(i = 0; i < b->closure_var_count; i++) {
+        if (bc_get_leb128(s, &idx))
+            return -1;
+        if (idx == r->var_ref_count) {
+            if (js_resize_array(ctx, (void **)&r->var_refs,
+                                sizeof(r->var_refs[0]),
+                                &r->var_ref_size, r->var_ref_count + 1))
+                return -1;
+            var_ref = js_create_module_var(ctx, FALSE);
+            if (!var_ref)
+                return -1;
+            r->var_refs[r->var_ref_count++] = var_ref;
+            var_ref->header.ref_count++;
+            p->u.func.var_refs[i] = var_ref;
+            val = js_snapshot_read_value(r);
+            if (JS_IsException(val))
+                return -1;
+            set_value(ctx, &var_ref->value, val);
+        } else if (idx < r->var_ref_count) {
+            var_ref = r->var_refs[idx];
+            var_ref->header.ref_count++;
+            p->u.func.var_refs[i] = var_ref;
+        } else {
+            JS_ThrowSyntaxError(ctx, "invalid variable reference in snapshot");
+            return -1;
+        }
+    }
+    val = js_snapshot_read_value(r);
+    if (JS_IsException(val))
+        return -1;
+    if (JS_IsObject(val))
+        p->u.func.home_object = JS_VALUE_GET_OBJ(val);
+    else
+        JS_FreeValue(ctx, val);
+    if (bc_get_u8(s, &v8))
+        return -1;
+    p->is_constructor = (v8 != 0);
+    return 0;
+}
+
+static JSValue js_snapshot_read_object(JSSnapshotReader *r)
+{
+    BCReaderState *s = &r->bc;
+    JSContext *ctx = s->ctx;
+    JSValue obj, func, pattern, bc, args[2];
+    JSFunctionBytecode *b;
+    JSObject *p;
+    JSString *str;
+    uint32_t class_id, idx, i, count;
+    int magic;
+
+    if (bc_get_leb128(s, &class_id))
+        return JS_EXCEPTION;
+    switch(class_id) {
+    case JS_CLASS_OBJECT:
+    case JS_CLASS_ERROR:
+        obj = JS_NewObjectProtoClass(ctx, JS_NULL, class_id);
+        break;
+    case JS_CLASS_ARRAY:
+        obj = JS_NewArray(ctx);
+        break;
+    case JS_CLASS_REGEXP:
+        str = JS_ReadString(s);
+        if (!str)
+            return JS_EXCEPTION;
+        pattern = JS_MKPTR(JS_TAG_STRING, str);
+        str = JS_ReadString(s);
+        if (!str) {
+            JS_FreeValue(ctx, pattern);
+            return JS_EXCEPTION;
+        }
+        bc = JS_MKPTR(JS_TAG_STRING, str);
+        obj = js_regexp_constructor_internal(ctx, JS_UNDEFINED, pattern, bc);
+        break;
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+        if (bc_get_leb128(s, &idx))
+            return JS_EXCEPTION;
+        if (idx == r->func_count) {
+            if (js_resize_array(ctx, (void **)&r->funcs, sizeof(r->funcs[0]),
+                                &r->func_size, r->func_count + 1))
+                return JS_EXCEPTION;
+            func = JS_ReadObjectRec(s);
+            if (JS_IsException(func))
+                return JS_EXCEPTION;
+            r->funcs[r->func_count++] = func;
+            if (JS_VALUE_GET_TAG(func) != JS_TAG_FUNCTION_BYTECODE)
+                goto invalid;
+        } else if (idx < r->func_count) {
+            func = r->funcs[idx];
+        } else {
+            goto invalid;
+        }
+        b = JS_VALUE_GET_PTR(func);
+        if (func_kind_to_class_id[b->func_kind] != class_id)
+            goto invalid;
+        obj = JS_NewObjectProtoClass(ctx, JS_NULL, class_id);
+        if (JS_IsException(obj))
+            return obj;
+        p = JS_VALUE_GET_OBJ(obj);
+        p->u.func.home_object = NULL;
+        p->u.func.var_refs = NULL;
+        if (b->closure_var_count != 0) {
+            p->u.func.var_refs = js_mallocz(ctx, sizeof(p->u.func.var_refs[0]) *
+                                            b->closure_var_count);
+            if (!p->u.func.var_refs) {
+                JS_FreeValue(ctx, obj);
+                return JS_EXCEPTION;
+            }
+        }
+        p->u.func.function_bytecode = b;
+        b->header.ref_count++;
+        break;
+    case JS_CLASS_MAP:
+    case JS_CLASS_SET:
+        obj = js_map_constructor(ctx, JS_UNDEFINED, 0, NULL,
+                                 class_id - JS_CLASS_MAP);
+        break;
+    default:
+    invalid:
+        return JS_ThrowSyntaxError(ctx, "invalid object in snapshot");
+    }
+    if (JS_IsException(obj))
+        return obj;
+    if (BC_add_object_ref(s, obj))
+        goto fail;
+    if (js_snapshot_set_proto(r, obj))
+        goto fail;
+    switch(class_id) {
+    case JS_CLASS_BYTECODE_FUNCTION:
+    case JS_CLASS_GENERATOR_FUNCTION:
+    case JS_CLASS_ASYNC_FUNCTION:
+    case JS_CLASS_ASYNC_GENERATOR_FUNCTION:
+        if (js_snapshot_read_function(r, obj))
+            goto fail;
+        break;
+    case JS_CLASS_MAP:
+    case JS_CLASS_SET:
+        magic = class_id - JS_CLASS_MAP;
+        if (bc_get_leb128(s, &count))
+            goto fail;
+        for(i = 0; i < count; i++) {
+            args[0] = js_snapshot_read_value(r);
+            if (JS_IsException(args[0]))
+                goto fail;
+            args[1] = JS_UNDEFINED;
+            if (class_id == JS_CLASS_MAP) {
+                args[1] = js_snapshot_read_value(r);
+                if (JS_IsException(args[1])) {
+                    JS_FreeValue(ctx, args[0]);
+                    goto fail;
+                }
+            }
+            func = js_map_set(ctx, obj, 2, (JSValueConst *)args, magic);
+            JS_FreeValue(ctx, args[0]);
+            JS_FreeValue(ctx, args[1]);
+            if (JS_IsException(func))
+                goto fail;
+            JS_FreeValue(ctx, func);
+        }
+        break;
+    default:
+        break;
+    }
+    if (js_snapshot_read_props(r, obj, FALSE))
+        goto fail;
+    return obj;
+ fail:
+    JS_FreeValue(ctx, obj);
+    return JS_EXCEPTION;
+}
+
+static JSValue js_snapshot_read_value(JSSnapshotReader *r)
+{
+    BCReaderState *s = &r->bc;
+    JSContext *ctx = s->ctx;
+    uint32_t idx;
+
+    if (js_check_stack_overflow(ctx->rt, 0))
+        return JS_ThrowStackOverflow(ctx);
+    if (s->ptr >= s->buf_end)
+        return JS_ThrowSyntaxError(ctx, "read after the end of the buffer");
+    switch(*s->ptr) {
+    case BC_TAG_BUILTIN_REFERENCE:
+        s->ptr++;
+        if (bc_get_leb128(s, &idx))
+            return JS_EXCEPTION;
+        if (idx >= r->ref_count)
+            return JS_ThrowSyntaxError(ctx, "invalid reference in snapshot");
+        return JS_DupValue(ctx, r->refs[idx]);
+    case BC_TAG_SNAPSHOT_OBJECT:
+        s->ptr++;
+        return js_snapshot_read_object(r);
+    case BC_TAG_SYMBOL:
+        s->ptr++;
+        return js_snapshot_read_symbol(r);
+    default:
+        return JS_ReadObjectRec(s);
     }
-    bc_read_trace(s, "}\n");
-    return obj;
 }
 
-static int JS_ReadObjectAtoms(BCReaderState *s)
+/* resolve the references to the objects of the context */
+static int js_snapshot_read_refs(JSSnapshotReader *r)
 {
-    uint8_t v8;
-    JSString *p;
-    int i;
+    BCReaderState *s = &r->bc;
+    JSContext *ctx = s->ctx;
+    JSPropertyDescriptor desc;
+    JSValue val;
+    JSObject *p;
+    uint32_t i, count, idx;
     JSAtom atom;
+    uint8_t kind;
+    int ret;
 
-    if (bc_get_u8(s, &v8))
+    if (bc_get_leb128(s, &count))
         return -1;
-    if (v8 != BC_VERSION) {
-        JS_ThrowSyntaxError(s->ctx, "invalid version (%d expected=%d)",
-                            v8, BC_VERSION);
+    if (count != js_snapshot_root_count(ctx)) {
+        JS_ThrowSyntaxError(ctx, "the snapshot does not match the context");
         return -1;
     }
-    if (bc_get_leb128(s, &s->idx_to_atom_count))
+    if (bc_get_leb128(s, &count))
         return -1;
+    if (count != 0) {
+        r->refs = js_mallocz(ctx, sizeof(r->refs[0]) * count);
+        if (!r->refs)
+            return -1;
+    }
+    for(i = 0; i < count; i++) {
+        if (bc_get_u8(s, &kind) || bc_get_leb128(s, &idx))
+            return -1;
+        if (kind == JS_SNAP_REF_ROOT) {
+            val = JS_DupValue(ctx, js_snapshot_get_root(ctx, idx));
+        } else {
+            if (idx >= i)
+                goto invalid;
+            p = JS_VALUE_GET_OBJ(r->refs[idx]);
+            if (kind == JS_SNAP_REF_PROTO) {
+                val = p->shape->proto ?
+                    JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, p->shape->proto)) : JS_NULL;
+            } else {
+                if (bc_get_atom(s, &atom))
+                    return -1;
+                ret = JS_GetOwnPropertyInternal(ctx, &desc, p, atom);
+                JS_FreeAtom(ctx, atom);
+                if (ret < 0)
+                    return -1;
+                if (!ret)
+                    goto invalid;
+                if (kind == JS_SNAP_REF_GETTER)
+                    val = JS_DupValue(ctx, desc.getter);
+                else if (kind == JS_SNAP_REF_SETTER)
+                    val = JS_DupValue(ctx, desc.setter);
+                else
+                    val = JS_DupValue(ctx, desc.value);
+                js_free_desc(ctx, &desc);
+            }
+        }
+        r->refs[r->ref_count++] = val;
+        if (!JS_IsObject(val))
+            goto invalid;
+    }
+    return 0;
+ invalid:
+    JS_ThrowSyntaxError(ctx, "snapshot reference not found");
+    return -1;
+}
 
-    bc_read_trace(s, "%d atom indexes {\n", s->idx_to_atom_count);
+/* Restore the state saved with JS_WriteSnapshot() in 'ctx'. 'ctx' must
+   have been created the same way as the base context given to
+   JS_WriteSnapshot(). */
+int JS_ReadSnapshot(JSContext *ctx, const uint8_t *buf, size_t buf_len)
+{
+    JSSnapshotReader rs, *r = &rs;
+    BCReaderState *s = &r->bc;
+    uint32_t i, count, idx;
+    int ret = -1;
 
-    if (s->idx_to_atom_count != 0) {
-        s->idx_to_atom = js_mallocz(s->ctx, s->idx_to_atom_count *
-                                    sizeof(s->idx_to_atom[0]));
-        if (!s->idx_to_atom)
-            return s->error_state = -1;
+    memset(r, 0, sizeof(*r));
+    s->ctx = ctx;
+    s->buf_start = buf;
+    s->buf_end = buf + buf_len;
+    s->ptr = buf;
+    s->allow_bytecode = TRUE;
+    s->allow_reference = TRUE;
+    s->first_atom = JS_ATOM_END;
+    if (JS_ReadObjectAtoms(s))
+        goto done;
+    if (js_snapshot_read_refs(r))
+        goto done;
+    if (bc_get_leb128(s, &count))
+        goto done;
+    for(i = 0; i < count; i++) {
+        if (bc_get_leb128(s, &idx))
+            goto done;
+        if (idx >= r->ref_count) {
+            JS_ThrowSyntaxError(ctx, "invalid reference in snapshot");
+            goto done;
+        }
+        if (js_snapshot_set_proto(r, r->refs[idx]) ||
+            js_snapshot_read_props(r, r->refs[idx], TRUE))
+            goto done;
     }
-    for(i = 0; i < s->idx_to_atom_count; i++) {
-        p = JS_ReadString(s);
-        if (!p)
+    ret = 0;
+ done:
+    for(i = 0; i < r->ref_count; i++)
+        JS_FreeValue(ctx, r->refs[i]);
+    js_free(ctx, r->refs);
+    for(i = 0; i < r->symbol_count; i++)
+        JS_FreeValue(ctx, r->symbols[i]);
+    js_free(ctx, r->symbols);
+    for(i = 0; i < r->var_ref_count; i++)
+        free_var_ref(ctx->rt, r->var_refs[i]);
+    js_free(ctx, r->var_refs);
+    for(i = 0; i < r->func_count; i++)
+        JS_FreeValue(ctx, r->funcs[i]);
+    js_free(ctx, r->funcs);
+    bc_reader_free(s);
+    return ret;
+}
+
+/*******************************************************************/
+/* context templates */
+
+/* A context created from a template is a copy of the objects
+   reachable from the roots of the template context, so that no
+   initialization code is run. The shapes are copied with the copy of
+   their prototype. The atoms, the primitive values and the native
+   functions are shared with the template. */
+
+typedef struct JSContextCloner {
+    JSContext *ctx; /* new context */
+    JSContext *tmpl; /* template context */
+    JSObjectList obj_list; /* objects of the template */
+    JSObject **objs; /* copy of each object, NULL if not created yet */
+    JSObjectList shape_list; /* copied shapes of the template */
+    JSShape **shapes;
+} JSContextCloner;
+
+static int js_clone_add_object(JSContextCloner *c, JSObject *p)
+{
+    if (!p || js_object_list_find(c->tmpl, &c->obj_list, p) >= 0)
+        return 0;
+    return js_object_list_add(c->tmpl, &c->obj_list, p);
+}
+
+static int js_clone_add_value(JSContextCloner *c, JSValueConst val)
+{
+    if (JS_VALUE_GET_TAG(val) != JS_TAG_OBJECT)
+        return 0;
+    return js_clone_add_object(c, JS_VALUE_GET_OBJ(val));
+}
+
+/* list the objects reachable from the roots of the template */
+static int js_clone_find_objects(JSContextCloner *c)
+{
+    JSContext *tmpl = c->tmpl;
+    JSObject *p;
+    JSShapeProperty *prs;
+    JSProperty *pr;
+    uint32_t i, j, count;
+
+    count = js_snapshot_root_count(tmpl);
+    for(i = 0; i < count; i++) {
+        if (js_clone_add_value(c, js_snapshot_get_root(tmpl, i)))
             return -1;
-        atom = JS_NewAtomStr(s->ctx, p);
-        if (atom == JS_ATOM_NULL)
-            return s->error_state = -1;
-        s->idx_to_atom[i] = atom;
-        if (s->is_rom_data && (atom != (i + s->first_atom)))
-            s->is_rom_data = FALSE; /* atoms must be relocated */
     }
-    bc_read_trace(s, "}\n");
+    if (js_clone_add_object(c, tmpl->array_shape->proto))
+        return -1;
+    for(i = 0; i < c->obj_list.object_count; i++) {
+        p = c->obj_list.object_tab[i].obj;
+        switch(p->class_id) {
+        case JS_CLASS_OBJECT:
+        case JS_CLASS_ERROR:
+        case JS_CLASS_C_FUNCTION:
+            break;
+        case JS_CLASS_ARRAY:
+            if (p->fast_array && p->array_kind == JS_ARRAY_KIND_GENERIC) {
+                for(j = 0; j < p->u.array.count; j++) {
+                    if (js_clone_add_value(c, p->u.array.u.values[j]))
+                        return -1;
+                }
+            }
+            break;
+        case JS_CLASS_C_FUNCTION_DATA:
+            {
+                JSCFunctionDataRecord *s = p->u.c_function_data_record;
+                for(j = 0; j < s->data_len; j++) {
+                    if (js_clone_add_value(c, s->data[j]))
+                        return -1;
+                }
+            }
+            break;
+        case JS_CLASS_NUMBER:
+        case JS_CLASS_STRING:
+        case JS_CLASS_BOOLEAN:
+        case JS_CLASS_SYMBOL:
+        case JS_CLASS_DATE:
+        case JS_CLASS_BIG_INT:
+            if (js_clone_add_value(c, p->u.object_data))
+                return -1;
+            break;
+        default:
+            goto unsupported;
+        }
+        if (js_clone_add_object(c, p->shape->proto))
+            return -1;
+        for(j = 0, prs = get_shape_prop(p->shape); j < p->shape->prop_count;
+            j++, prs++) {
+            pr = &p->prop[j];
+            if (prs->atom == JS_ATOM_NULL)
+                continue;
+            switch(prs->flags & JS_PROP_TMASK) {
+            case JS_PROP_NORMAL:
+                if (js_clone_add_value(c, pr->u.value))
+                    return -1;
+                break;
+            case JS_PROP_GETSET:
+                if (js_clone_add_object(c, pr->u.getset.getter) ||
+                    js_clone_add_object(c, pr->u.getset.setter))
+                    return -1;
+                break;
+            case JS_PROP_AUTOINIT:
+                /* the opaque value of the module namespaces depends
+                   on the context */
+                if (js_autoinit_get_id(pr) == JS_AUTOINIT_ID_MODULE_NS)
+                    goto unsupported;
+                break;
+            default:
+                goto unsupported;
+            }
+        }
+    }
     return 0;
+ unsupported:
+    JS_ThrowTypeError(tmpl, "unsupported object in the context template");
+    return -1;
 }
 
-static void bc_reader_free(BCReaderState *s)
+static JSObject *js_clone_object(JSContextCloner *c, JSObject *p1);
+
+/* return the copy of the template shape 'sh1' */
+static JSShape *js_clone_get_shape(JSContextCloner *c, JSShape *sh1)
 {
-    int i;
-    if (s->idx_to_atom) {
-        for(i = 0; i < s->idx_to_atom_count; i++) {
-            JS_FreeAtom(s->ctx, s->idx_to_atom[i]);
+    JSContext *ctx = c->ctx;
+    JSRuntime *rt = ctx->rt;
+    JSShape *sh;
+    JSShapeProperty *prs;
+    JSObject *proto;
+    uint32_t h, i;
+    int idx;
+
+    idx = js_object_list_find(c->tmpl, &c->shape_list, (JSObject *)sh1);
+    if (idx >= 0)
+        return c->shapes[idx];
+    proto = NULL;
+    if (sh1->proto) {
+        proto = js_clone_object(c, sh1->proto);
+        if (!proto)
+            return NULL;
+    }
+    sh = js_clone_shape(ctx, sh1);
+    if (!sh)
+        return NULL;
+    if (sh->proto)
+        JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_OBJECT, sh->proto));
+    if (proto)
+        JS_DupValue(ctx, JS_MKPTR(JS_TAG_OBJECT, proto));
+    sh->proto = proto;
+    /* the copy of a hashed shape is hashed too so that it is shared
+       with the objects later created with the same properties */
+    if (sh1->is_hashed && sh1->deleted_prop_count == 0) {
+        h = shape_initial_hash(proto);
+        for(i = 0, prs = get_shape_prop(sh); i < sh->prop_count; i++, prs++)
+            h = shape_hash(shape_hash(h, prs->atom), prs->flags);
+        if (2 * (rt->shape_hash_count + 1) > rt->shape_hash_size)
+            resize_shape_hash(rt, rt->shape_hash_bits + 1);
+        sh->hash = h;
+        sh->is_hashed = TRUE;
+        js_shape_hash_link(rt, sh);
+    }
+    if (js_object_list_add(c->tmpl, &c->shape_list, (JSObject *)sh1)) {
+        js_free_shape(rt, sh);
+        return NULL;
+    }
+    c->shapes[c->shape_list.object_count - 1] = sh;
+    return sh;
+}
+
+/* return the copy of the template object 'p1'. The values of its
+   properties are set later by js_clone_set_values(). */
+static JSObject *js_clone_object(JSContextCloner *c, JSObject *p1)
+{
+    JSContext *ctx = c->ctx;
+    JSObject *p;
+    JSShape *sh;
+    JSShapeProperty *prs;
+    JSProperty *pr;
+    JSCFunctionDataRecord *s, *s1;
+    int idx, inline_size, i;
+
+    idx = js_object_list_find(c->tmpl, &c->obj_list, p1);
+    assert(idx >= 0);
+    if (c->objs[idx])
+        return c->objs[idx];
+    sh = js_clone_get_shape(c, p1->shape);
+    if (!sh)
+        return NULL;
+    s = NULL;
+    if (p1->class_id == JS_CLASS_C_FUNCTION_DATA) {
+        s1 = p1->u.c_function_data_record;
+        s = js_malloc(ctx, sizeof(*s) + s1->data_len * sizeof(JSValue));
+        if (!s)
+            return NULL;
+        *s = *s1;
+        for(i = 0; i < s->data_len; i++)
+            s->data[i] = JS_UNDEFINED;
+    }
+    inline_size = 0;
+    if (p1->prop == p1->inline_prop)
+        inline_size = p1->inline_prop_size;
+    p = js_malloc_nursery_rt(ctx->rt, sizeof(JSObject) +
+                             sizeof(JSProperty) * inline_size);
+    if (!p) {
+        JS_ThrowOutOfMemory(ctx);
+        goto fail;
+    }
+    /* copy the flags and the native function fields */
+    memcpy(p, p1, sizeof(JSObject));
+    p->header.ref_count = 1;
+    p->free_mark = 0;
+    p->tmp_mark = 0;
+    p->weakref_count = 0;
+    p->inline_prop_size = inline_size;
+    if (inline_size != 0) {
+        p->prop = p->inline_prop;
+    } else {
+        p->prop = js_malloc(ctx, sizeof(JSProperty) * sh->prop_size);
+        if (!p->prop) {
+            js_free(ctx, p);
+            goto fail;
         }
-        js_free(s->ctx, s->idx_to_atom);
     }
-    js_free(s->ctx, s->objects);
+    for(i = 0, prs = get_shape_prop(sh); i < sh->prop_count; i++, prs++) {
+        pr = &p->prop[i];
+        switch(prs->flags & JS_PROP_TMASK) {
+        case JS_PROP_GETSET:
+            pr->u.getset.getter = NULL;
+            pr->u.getset.setter = NULL;
+            break;
+        case JS_PROP_AUTOINIT:
+            pr->u.init.realm_and_id = (uintptr_t)JS_DupContext(ctx) |
+                js_autoinit_get_id(&p1->prop[i]);
+            pr->u.init.opaque = p1->prop[i].u.init.opaque;
+            break;
+        default:
+            pr->u.value = JS_UNDEFINED;
+            break;
+        }
+    }
+    switch(p->class_id) {
+    case JS_CLASS_ARRAY:
+        p->u.array.u.values = NULL;
+        p->u.array.count = 0;
+        p->u.array.u1.size = 0;
+        break;
+    case JS_CLASS_C_FUNCTION:
+        p->u.cfunc.realm = JS_DupContext(ctx);
+        break;
+    case JS_CLASS_C_FUNCTION_DATA:
+        p->u.c_function_data_record = s;
+        break;
+    case JS_CLASS_NUMBER:
+    case JS_CLASS_STRING:
+    case JS_CLASS_BOOLEAN:
+    case JS_CLASS_SYMBOL:
+    case JS_CLASS_DATE:
+    case JS_CLASS_BIG_INT:
+        p->u.object_data = JS_UNDEFINED;
+        break;
+    default:
+        p->u.opaque = NULL;
+        break;
+    }
+    p->shape = js_dup_shape(sh);
+    add_gc_object(ctx->rt, &p->header, JS_GC_OBJ_TYPE_JS_OBJECT);
+    c->objs[idx] = p;
+    return p;
+ fail:
+    js_free(ctx, s);
+    return NULL;
 }
 
-JSValue JS_ReadObject(JSContext *ctx, const uint8_t *buf, size_t buf_len,
-                       int flags)
+/* all the objects must have been copied */
+static JSValue js_clone_value(JSContextCloner *c, JSValueConst val)
 {
-    BCReaderState ss, *s = &ss;
-    JSValue obj;
+    if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT)
+        val = JS_MKPTR(JS_TAG_OBJECT, js_clone_object(c, JS_VALUE_GET_OBJ(val)));
+    return JS_DupValue(c->ctx, val);
+}
 
-    ctx->binary_object_count += 1;
-    ctx->binary_object_size += buf_len;
+static JSObject *js_clone_getset(JSContextCloner *c, JSObject *p1)
+{
+    if (!p1)
+        return NULL;
+    return JS_VALUE_GET_OBJ(js_clone_value(c, JS_MKPTR(JS_TAG_OBJECT, p1)));
+}
 
-    memset(s, 0, sizeof(*s));
-    s->ctx = ctx;
-    s->buf_start = buf;
-    s->buf_end = buf + buf_len;
-    s->ptr = buf;
-    s->allow_bytecode = ((flags & JS_READ_OBJ_BYTECODE) != 0);
-    s->is_rom_data = ((flags & JS_READ_OBJ_ROM_DATA) != 0);
-    s->allow_sab = ((flags & JS_READ_OBJ_SAB) != 0);
-    s->allow_reference = ((flags & JS_READ_OBJ_REFERENCE) != 0);
-    if (s->allow_bytecode)
-        s->first_atom = JS_ATOM_END;
-    else
-        s->first_atom = 1;
-    if (JS_ReadObjectAtoms(s)) {
-        obj = JS_EXCEPTION;
-    } else {
-        obj = JS_ReadObjectRec(s);
+static int js_clone_set_values(JSContextCloner *c, JSObject *p, JSObject *p1)
+{
+    JSContext *ctx = c->ctx;
+    JSShapeProperty *prs;
+    JSProperty *pr, *pr1;
+    uint32_t i, count;
+
+    for(i = 0, prs = get_shape_prop(p->shape); i < p->shape->prop_count;
+        i++, prs++) {
+        pr = &p->prop[i];
+        pr1 = &p1->prop[i];
+        if (prs->atom == JS_ATOM_NULL)
+            continue;
+        switch(prs->flags & JS_PROP_TMASK) {
+        case JS_PROP_NORMAL:
+            pr->u.value = js_clone_value(c, pr1->u.value);
+            break;
+        case JS_PROP_GETSET:
+            pr->u.getset.getter = js_clone_getset(c, pr1->u.getset.getter);
+            pr->u.getset.setter = js_clone_getset(c, pr1->u.getset.setter);
+            break;
+        }
     }
-    bc_reader_free(s);
-    return obj;
+    switch(p->class_id) {
+    case JS_CLASS_ARRAY:
+        count = p1->fast_array ? p1->u.array.count : 0;
+        if (count != 0) {
+            JSValue *values;
+            values = js_malloc(ctx, js_array_elem_size(p1->array_kind) * count);
+            if (!values)
+                return -1;
+            if (p1->array_kind == JS_ARRAY_KIND_GENERIC) {
+                for(i = 0; i < count; i++)
+                    values[i] = js_clone_value(c, p1->u.array.u.values[i]);
+            } else {
+                memcpy(values, p1->u.array.u.values,
+                       js_array_elem_size(p1->array_kind) * count);
+            }
+            p->u.array.u.values = values;
+            p->u.array.count = count;
+            p->u.array.u1.size = count;
+        }
+        break;
+    case JS_CLASS_C_FUNCTION_DATA:
+        {
+            JSCFunctionDataRecord *s = p->u.c_function_data_record;
+            JSCFunctionDataRecord *s1 = p1->u.c_function_data_record;
+            for(i = 0; i < s->data_len; i++)
+                s->data[i] = js_clone_value(c, s1->data[i]);
+        }
+        break;
+    case JS_CLASS_NUMBER:
+    case JS_CLASS_STRING:
+    case JS_CLASS_BOOLEAN:
+    case JS_CLASS_SYMBOL:
+    case JS_CLASS_DATE:
+    case JS_CLASS_BIG_INT:
+        p->u.object_data = js_clone_value(c, p1->u.object_data);
+        break;
+    }
+    return 0;
+}
+
+JSContext *JS_NewContextFromTemplate(JSRuntime *rt, JSContext *tmpl)
+{
+    JSContextCloner cs, *c = &cs;
+    JSContext *ctx;
+    JSShape *sh;
+    JSValue *pval;
+    uint32_t i, count;
+
+    assert(tmpl->rt == rt);
+    js_trigger_gc(rt, 0);
+    memset(c, 0, sizeof(*c));
+    c->tmpl = tmpl;
+    js_object_list_init(&c->obj_list);
+    js_object_list_init(&c->shape_list);
+    ctx = NULL;
+    if (js_clone_find_objects(c))
+        goto fail;
+    /* at most one shape per object and the initial array shape */
+    count = c->obj_list.object_count;
+    c->objs = js_mallocz(tmpl, sizeof(c->objs[0]) * count);
+    c->shapes = js_mallocz(tmpl, sizeof(c->shapes[0]) * (count + 1));
+    if (!c->objs || !c->shapes)
+        goto fail;
+    ctx = js_new_context(rt);
+    if (!ctx) {
+        JS_ThrowOutOfMemory(tmpl);
+        goto fail;
+    }
+    c->ctx = ctx;
+
+    /* the objects are created before setting the property values so
+       that no object is referenced before it exists */
+    for(i = 0; i < count; i++) {
+        if (!js_clone_object(c, c->obj_list.object_tab[i].obj))
+            goto fail;
+    }
+    sh = js_clone_get_shape(c, tmpl->array_shape);
+    if (!sh)
+        goto fail;
+    ctx->array_shape = js_dup_shape(sh);
+    for(i = 0; i < count; i++) {
+        if (js_clone_set_values(c, c->objs[i], c->obj_list.object_tab[i].obj))
+            goto fail;
+    }
+    count = js_snapshot_root_count(ctx);
+    for(i = 0; i < count; i++) {
+        pval = js_snapshot_get_root_ptr(ctx, i);
+        *pval = js_clone_value(c, js_snapshot_get_root(tmpl, i));
+    }
+    ctx->binary_object_count = tmpl->binary_object_count;
+    ctx->binary_object_size = tmpl->binary_object_size;
+    ctx->compile_regexp = tmpl->compile_regexp;
+    ctx->eval_internal = tmpl->eval_internal;
+    js_random_init(ctx);
+ done:
+    if (c->objs) {
+        for(i = 0; i < c->obj_list.object_count; i++) {
+            if (c->objs[i])
+                JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_OBJECT, c->objs[i]));
+        }
+    }
+    for(i = 0; i < c->shape_list.object_count; i++)
+        js_free_shape(rt, c->shapes[i]);
+    js_free_rt(rt, c->objs);
+    js_free_rt(rt, c->shapes);
+    js_object_list_end(tmpl, &c->obj_list);
+    js_object_list_end(tmpl, &c->shape_list);
+    return ctx;
+ fail:
+    if (ctx) {
+        JS_FreeContext(ctx);
+        ctx = NULL;
+    }
+    goto done;
 }
 
 /*******************************************************************/
@@ -39774,7 +45725,7 @@ static JSValue *build_arg_list(JSContext *ctx, uint32_t *plen,
         p->fast_array &&
         len == p->u.array.count) {
         for(i = 0; i < len; i++) {
-            tab[i] = JS_DupValue(ctx, p->u.array.u.values[i]);
+            tab[i] = js_array_get_element(ctx, p, i);
         }
     } else {
         for(i = 0; i < len; i++) {
@@ -39926,6 +45877,16 @@ static JSValue js_function_toString(JSContext *ctx, JSValueConst this_val,
     p = JS_VALUE_GET_OBJ(this_val);
     if (js_class_has_bytecode(p->class_id)) {
         JSFunctionBytecode *b = p->u.func.function_bytecode;
+        if (b->lazy) {
+            JSLazyFunction *lf = b->lazy;
+            if (lf->source) {
+                return JS_NewStringLen(ctx, lf->source->buf + lf->source_pos,
+                                       lf->source_len);
+            }
+            b = js_lazy_function_compile(ctx, p);
+            if (!b)
+                return JS_EXCEPTION;
+        }
         if (b->has_debug && b->debug.source) {
             return JS_NewStringLen(ctx, b->debug.source, b->debug.source_len);
         }
@@ -40192,7 +46153,22 @@ static int JS_CopySubArray(JSContext *ctx,
                prototype chain, we can optimize only the cases where
                all the elements are present in the array. */
             l = count - i;
-            if (dir < 0) {
+            if (p->array_kind != JS_ARRAY_KIND_GENERIC) {
+                /* no reference counts: the elements are moved at once */
+                int elem_size = js_array_elem_size(p->array_kind);
+                uint8_t *ptr = p->u.array.u.ptr;
+                if (dir < 0) {
+                    l = min_int64(l, from + 1);
+                    l = min_int64(l, to + 1);
+                    memmove(ptr + (to - l + 1) * elem_size,
+                            ptr + (from - l + 1) * elem_size, l * elem_size);
+                } else {
+                    l = min_int64(l, len - from);
+                    l = min_int64(l, len - to);
+                    memmove(ptr + to * elem_size, ptr + from * elem_size,
+                            l * elem_size);
+                }
+            } else if (dir < 0) {
                 l = min_int64(l, from + 1);
                 l = min_int64(l, to + 1);
                 for(j = 0; j < l; j++) {
@@ -40492,7 +46468,7 @@ static JSValue js_array_at(JSContext *ctx, JSValueConst this_val,
 {
     JSValue obj, ret;
     int64_t len, idx;
-    JSValue *arrp;
+    JSObject *arrp;
     uint32_t count;
 
     obj = JS_ToObject(ctx, this_val);
@@ -40507,7 +46483,7 @@ static JSValue js_array_at(JSContext *ctx, JSValueConst this_val,
     if (idx < 0 || idx >= len) {
         ret = JS_UNDEFINED;
     } else if (js_get_fast_array(ctx, obj, &arrp, &count) && idx < count) {
-        ret = JS_DupValue(ctx, arrp[idx]);
+        ret = js_array_get_element(ctx, arrp, idx);
     } else {
         int present = JS_TryGetPropertyInt64(ctx, obj, idx, &ret);
         if (present < 0)
@@ -40525,8 +46501,8 @@ static JSValue js_array_at(JSContext *ctx, JSValueConst this_val,
 static JSValue js_array_with(JSContext *ctx, JSValueConst this_val,
                              int argc, JSValueConst *argv)
 {
-    JSValue arr, obj, ret, *arrp, *pval;
-    JSObject *p;
+    JSValue arr, obj, ret, *pval;
+    JSObject *p, *arrp;
     int64_t i, len, idx;
     uint32_t count32;
 
@@ -40556,10 +46532,10 @@ static JSValue js_array_with(JSContext *ctx, JSValueConst this_val,
     pval = p->u.array.u.values;
     if (js_get_fast_array(ctx, obj, &arrp, &count32) && count32 == len) {
         for (; i < idx; i++, pval++)
-            *pval = JS_DupValue(ctx, arrp[i]);
+            *pval = js_array_get_element(ctx, arrp, i);
         *pval = JS_DupValue(ctx, argv[1]);
         for (i++, pval++; i < len; i++, pval++)
-            *pval = JS_DupValue(ctx, arrp[i]);
+            *pval = js_array_get_element(ctx, arrp, i);
     } else {
         for (; i < idx; i++, pval++)
             if (-1 == JS_TryGetPropertyInt64(ctx, obj, i, pval))
@@ -40666,6 +46642,42 @@ static JSValue js_typed_array___speciesCreate(JSContext *ctx,
                                               JSValueConst this_val,
                                               int argc, JSValueConst *argv);
 
+/* Return TRUE and the element 'idx' in '*pval' if 'obj' is a fast
+   array containing it. The callbacks may modify the array, so it must
+   be tested at each iteration. */
+static inline BOOL js_array_get_fast_element(JSContext *ctx, JSValueConst obj,
+                                             int64_t idx, JSValue *pval)
+{
+    JSObject *p;
+
+    if (JS_VALUE_GET_TAG(obj) != JS_TAG_OBJECT)
+        return FALSE;
+    p = JS_VALUE_GET_OBJ(obj);
+    if (p->class_id != JS_CLASS_ARRAY || !p->fast_array ||
+        (uint64_t)idx >= p->u.array.count)
+        return FALSE;
+    *pval = js_array_get_element(ctx, p, idx);
+    return TRUE;
+}
+
+/* same as JS_DefinePropertyValueInt64(ctx, obj, idx, val,
+   JS_PROP_C_W_E | JS_PROP_THROW). The elements appended to an
+   extensible fast array are stored with its element kind. */
+static int js_array_define_element(JSContext *ctx, JSValueConst obj,
+                                   int64_t idx, JSValue val)
+{
+    JSObject *p;
+
+    if (JS_VALUE_GET_TAG(obj) == JS_TAG_OBJECT) {
+        p = JS_VALUE_GET_OBJ(obj);
+        if (p->class_id == JS_CLASS_ARRAY && p->fast_array &&
+            p->extensible && idx == p->u.array.count)
+            return add_fast_array_element(ctx, p, val, JS_PROP_THROW);
+    }
+    return JS_DefinePropertyValueInt64(ctx, obj, idx, val,
+                                       JS_PROP_C_W_E | JS_PROP_THROW);
+}
+
 static JSValue js_array_every(JSContext *ctx, JSValueConst this_val,
                               int argc, JSValueConst *argv, int special)
 {
@@ -40736,6 +46748,8 @@ static JSValue js_array_every(JSContext *ctx, JSValueConst this_val,
             if (JS_IsException(val))
                 goto exception;
             present = TRUE;
+        } else if (js_array_get_fast_element(ctx, obj, k, &val)) {
+            present = TRUE;
         } else {
             present = JS_TryGetPropertyInt64(ctx, obj, k, &val);
             if (present < 0)
@@ -40768,8 +46782,7 @@ static JSValue js_array_every(JSContext *ctx, JSValueConst this_val,
                 }
                 break;
             case special_map:
-                if (JS_DefinePropertyValueInt64(ctx, ret, k, res,
-                                                JS_PROP_C_W_E | JS_PROP_THROW) < 0)
+                if (js_array_define_element(ctx, ret, k, res) < 0)
                     goto exception;
                 break;
             case special_map | special_TA:
@@ -40779,8 +46792,8 @@ static JSValue js_array_every(JSContext *ctx, JSValueConst this_val,
             case special_filter:
             case special_filter | special_TA:
                 if (JS_ToBoolFree(ctx, res)) {
-                    if (JS_DefinePropertyValueInt64(ctx, ret, n++, JS_DupValue(ctx, val),
-                                                    JS_PROP_C_W_E | JS_PROP_THROW) < 0)
+                    if (js_array_define_element(ctx, ret, n++,
+                                                JS_DupValue(ctx, val)) < 0)
                         goto exception;
                 }
                 break;
@@ -40879,6 +46892,8 @@ static JSValue js_array_reduce(JSContext *ctx, JSValueConst this_val,
             if (JS_IsException(val))
                 goto exception;
             present = TRUE;
+        } else if (js_array_get_fast_element(ctx, obj, k1, &val)) {
+            present = TRUE;
         } else {
             present = JS_TryGetPropertyInt64(ctx, obj, k1, &val);
             if (present < 0)
@@ -40917,6 +46932,8 @@ static JSValue js_array_fill(JSContext *ctx, JSValueConst this_val,
 {
     JSValue obj;
     int64_t len, start, end;
+    JSObject *arrp;
+    uint32_t count32;
 
     obj = JS_ToObject(ctx, this_val);
     if (js_get_length64(ctx, &len, obj))
@@ -40934,7 +46951,13 @@ static JSValue js_array_fill(JSContext *ctx, JSValueConst this_val,
             goto exception;
     }
 
-    /* XXX: should special case fast arrays */
+    if (js_get_fast_array(ctx, obj, &arrp, &count32) && end <= count32) {
+        for (; start < end; start++) {
+            if (js_array_set_element(ctx, arrp, start,
+                                     JS_DupValue(ctx, argv[0])))
+                goto exception;
+        }
+    }
     while (start < end) {
         if (JS_SetPropertyInt64(ctx, obj, start,
                                 JS_DupValue(ctx, argv[0])) < 0)
@@ -40948,12 +46971,59 @@ static JSValue js_array_fill(JSContext *ctx, JSValueConst this_val,
     return JS_EXCEPTION;
 }
 
+/* Search the number 'val' in the elements [from, count) of a fast
+   array of int32 or float64 kind. Return the index or -1. A non number
+   value never matches. */
+static int64_t js_array_find_number(JSObject *p, uint32_t from, uint32_t count,
+                                    JSValueConst val, BOOL nan_equal)
+{
+    uint32_t i;
+    double d;
+    int tag;
+
+    tag = JS_VALUE_GET_NORM_TAG(val);
+    if (tag == JS_TAG_INT)
+        d = JS_VALUE_GET_INT(val);
+    else if (tag == JS_TAG_FLOAT64)
+        d = JS_VALUE_GET_FLOAT64(val);
+    else
+        return -1;
+    if (p->array_kind == JS_ARRAY_KIND_INT32) {
+        int32_t v, *tab = p->u.array.u.int32_ptr;
+        if (!(d >= INT32_MIN && d <= INT32_MAX))
+            return -1;
+        v = (int32_t)d;
+        if (v != d)
+            return -1;
+        for(i = from; i < count; i++) {
+            if (tab[i] == v)
+                return i;
+        }
+    } else {
+        double *tab = p->u.array.u.double_ptr;
+        if (isnan(d)) {
+            if (nan_equal) {
+                for(i = from; i < count; i++) {
+                    if (isnan(tab[i]))
+                        return i;
+                }
+            }
+        } else {
+            for(i = from; i < count; i++) {
+                if (tab[i] == d)
+                    return i;
+            }
+        }
+    }
+    return -1;
+}
+
 static JSValue js_array_includes(JSContext *ctx, JSValueConst this_val,
                                  int argc, JSValueConst *argv)
 {
     JSValue obj, val;
     int64_t len, n;
-    JSValue *arrp;
+    JSObject *arrp;
     uint32_t count;
     int res;
 
@@ -40969,12 +47039,22 @@ static JSValue js_array_includes(JSContext *ctx, JSValueConst this_val,
                 goto exception;
         }
         if (js_get_fast_array(ctx, obj, &arrp, &count)) {
-            for (; n < count; n++) {
-                if (js_strict_eq2(ctx, JS_DupValue(ctx, argv[0]),
-                                  JS_DupValue(ctx, arrp[n]),
-                                  JS_EQ_SAME_VALUE_ZERO)) {
-                    res = TRUE;
-                    goto done;
+            if (arrp->array_kind != JS_ARRAY_KIND_GENERIC) {
+                if (n < count) {
+                    if (js_array_find_number(arrp, n, count, argv[0], TRUE) >= 0) {
+                        res = TRUE;
+                        goto done;
+                    }
+                    n = count;
+                }
+            } else {
+                for (; n < count; n++) {
+                    if (js_strict_eq2(ctx, JS_DupValue(ctx, argv[0]),
+                                      js_array_get_element(ctx, arrp, n),
+                                      JS_EQ_SAME_VALUE_ZERO)) {
+                        res = TRUE;
+                        goto done;
+                    }
                 }
             }
         }
@@ -41003,7 +47083,7 @@ static JSValue js_array_indexOf(JSContext *ctx, JSValueConst this_val,
 {
     JSValue obj, val;
     int64_t len, n, res;
-    JSValue *arrp;
+    JSObject *arrp;
     uint32_t count;
 
     obj = JS_ToObject(ctx, this_val);
@@ -41018,11 +47098,20 @@ static JSValue js_array_indexOf(JSContext *ctx, JSValueConst this_val,
                 goto exception;
         }
         if (js_get_fast_array(ctx, obj, &arrp, &count)) {
-            for (; n < count; n++) {
-                if (js_strict_eq2(ctx, JS_DupValue(ctx, argv[0]),
-                                  JS_DupValue(ctx, arrp[n]), JS_EQ_STRICT)) {
-                    res = n;
-                    goto done;
+            if (arrp->array_kind != JS_ARRAY_KIND_GENERIC) {
+                if (n < count) {
+                    res = js_array_find_number(arrp, n, count, argv[0], FALSE);
+                    if (res >= 0)
+                        goto done;
+                    n = count;
+                }
+            } else {
+                for (; n < count; n++) {
+                    if (js_strict_eq2(ctx, JS_DupValue(ctx, argv[0]),
+                                      js_array_get_element(ctx, arrp, n), JS_EQ_STRICT)) {
+                        res = n;
+                        goto done;
+                    }
                 }
             }
         }
@@ -41251,7 +47340,7 @@ static JSValue js_array_pop(JSContext *ctx, JSValueConst this_val,
 {
     JSValue obj, res = JS_UNDEFINED;
     int64_t len, newLen;
-    JSValue *arrp;
+    JSObject *arrp;
     uint32_t count32;
 
     obj = JS_ToObject(ctx, this_val);
@@ -41262,15 +47351,18 @@ static JSValue js_array_pop(JSContext *ctx, JSValueConst this_val,
         newLen = len - 1;
         /* Special case fast arrays */
         if (js_get_fast_array(ctx, obj, &arrp, &count32) && count32 == len) {
-            JSObject *p = JS_VALUE_GET_OBJ(obj);
+            uint32_t idx = shift ? 0 : count32 - 1;
+            /* the reference of the removed element is transferred */
+            if (arrp->array_kind == JS_ARRAY_KIND_GENERIC)
+                res = arrp->u.array.u.values[idx];
+            else
+                res = js_array_get_element(ctx, arrp, idx);
             if (shift) {
-                res = arrp[0];
-                memmove(arrp, arrp + 1, (count32 - 1) * sizeof(*arrp));
-                p->u.array.count--;
-            } else {
-                res = arrp[count32 - 1];
-                p->u.array.count--;
+                int elem_size = js_array_elem_size(arrp->array_kind);
+                uint8_t *ptr = arrp->u.array.u.ptr;
+                memmove(ptr, ptr + elem_size, (count32 - 1) * elem_size);
             }
+            arrp->u.array.count--;
         } else {
             if (shift) {
                 res = JS_GetPropertyInt64(ctx, obj, 0);
@@ -41340,7 +47432,7 @@ static JSValue js_array_reverse(JSContext *ctx, JSValueConst this_val,
                                 int argc, JSValueConst *argv)
 {
     JSValue obj, lval, hval;
-    JSValue *arrp;
+    JSObject *arrp;
     int64_t len, l, h;
     int l_present, h_present;
     uint32_t count32;
@@ -41355,10 +47447,37 @@ static JSValue js_array_reverse(JSContext *ctx, JSValueConst this_val,
         uint32_t ll, hh;
 
         if (count32 > 1) {
-            for (ll = 0, hh = count32 - 1; ll < hh; ll++, hh--) {
-                lval = arrp[ll];
-                arrp[ll] = arrp[hh];
-                arrp[hh] = lval;
+            switch(arrp->array_kind) {
+            case JS_ARRAY_KIND_INT32:
+                {
+                    int32_t *tab = arrp->u.array.u.int32_ptr, v;
+                    for (ll = 0, hh = count32 - 1; ll < hh; ll++, hh--) {
+                        v = tab[ll];
+                        tab[ll] = tab[hh];
+                        tab[hh] = v;
+                    }
+                }
+                break;
+            case JS_ARRAY_KIND_FLOAT64:
+                {
+                    double *tab = arrp->u.array.u.double_ptr, d;
+                    for (ll = 0, hh = count32 - 1; ll < hh; ll++, hh--) {
+                        d = tab[ll];
+                        tab[ll] = tab[hh];
+                        tab[hh] = d;
+                    }
+                }
+                break;
+            default:
+                {
+                    JSValue *tab = arrp->u.array.u.values;
+                    for (ll = 0, hh = count32 - 1; ll < hh; ll++, hh--) {
+                        lval = tab[ll];
+                        tab[ll] = tab[hh];
+                        tab[hh] = lval;
+                    }
+                }
+                break;
             }
         }
         return obj;
@@ -41412,8 +47531,8 @@ static JSValue js_array_reverse(JSContext *ctx, JSValueConst this_val,
 static JSValue js_array_toReversed(JSContext *ctx, JSValueConst this_val,
                                    int argc, JSValueConst *argv)
 {
-    JSValue arr, obj, ret, *arrp, *pval;
-    JSObject *p;
+    JSValue arr, obj, ret, *pval;
+    JSObject *p, *arrp;
     int64_t i, len;
     uint32_t count32;
 
@@ -41434,7 +47553,7 @@ static JSValue js_array_toReversed(JSContext *ctx, JSValueConst this_val,
         pval = p->u.array.u.values;
         if (js_get_fast_array(ctx, obj, &arrp, &count32) && count32 == len) {
             for (; i >= 0; i--, pval++)
-                *pval = JS_DupValue(ctx, arrp[i]);
+                *pval = js_array_get_element(ctx, arrp, i);
         } else {
             // Query order is observable; test262 expects descending order.
             for (; i >= 0; i--, pval++) {
@@ -41466,7 +47585,7 @@ static JSValue js_array_slice(JSContext *ctx, JSValueConst this_val,
     JSValue obj, arr, val, len_val;
     int64_t len, start, k, final, n, count, del_count, new_len;
     int kPresent;
-    JSValue *arrp;
+    JSObject *arrp;
     uint32_t count32, i, item_count;
 
     arr = JS_UNDEFINED;
@@ -41521,7 +47640,7 @@ static JSValue js_array_slice(JSContext *ctx, JSValueConst this_val,
         js_is_fast_array(ctx, arr)) {
         /* XXX: should share code with fast array constructor */
         for (; k < final && k < count32; k++, n++) {
-            if (JS_CreateDataPropertyUint32(ctx, arr, n, JS_DupValue(ctx, arrp[k]), JS_PROP_THROW) < 0)
+            if (JS_CreateDataPropertyUint32(ctx, arr, n, js_array_get_element(ctx, arrp, k), JS_PROP_THROW) < 0)
                 goto exception;
         }
     }
@@ -41570,8 +47689,8 @@ static JSValue js_array_slice(JSContext *ctx, JSValueConst this_val,
 static JSValue js_array_toSpliced(JSContext *ctx, JSValueConst this_val,
                                   int argc, JSValueConst *argv)
 {
-    JSValue arr, obj, ret, *arrp, *pval, *last;
-    JSObject *p;
+    JSValue arr, obj, ret, *pval, *last;
+    JSObject *p, *arrp;
     int64_t i, j, len, newlen, start, add, del;
     uint32_t count32;
 
@@ -41619,11 +47738,11 @@ static JSValue js_array_toSpliced(JSContext *ctx, JSValueConst this_val,
 
     if (js_get_fast_array(ctx, obj, &arrp, &count32) && count32 == len) {
         for (i = 0; i < start; i++, pval++)
-            *pval = JS_DupValue(ctx, arrp[i]);
+            *pval = js_array_get_element(ctx, arrp, i);
         for (j = 0; j < add; j++, pval++)
             *pval = JS_DupValue(ctx, argv[2 + j]);
         for (i += del; i < len; i++, pval++)
-            *pval = JS_DupValue(ctx, arrp[i]);
+            *pval = js_array_get_element(ctx, arrp, i);
     } else {
         for (i = 0; i < start; i++, pval++)
             if (-1 == JS_TryGetPropertyInt64(ctx, obj, i, pval))
@@ -41870,6 +47989,40 @@ exception:
     return 0;
 }
 
+static int js_u32_digit_count(uint32_t a)
+{
+    int n = 1;
+    while (a >= 10) {
+        a /= 10;
+        n++;
+    }
+    return n;
+}
+
+/* compare the decimal strings of two int32 values without converting
+   them: '-' sorts before the digits */
+static int js_array_cmp_int32(const void *a, const void *b, void *opaque)
+{
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    uint64_t x1, y1;
+    int lx, ly, l;
+
+    if ((x < 0) != (y < 0))
+        return (x < 0) ? -1 : 1;
+    x1 = x < 0 ? -(uint32_t)x : (uint32_t)x;
+    y1 = y < 0 ? -(uint32_t)y : (uint32_t)y;
+    lx = js_u32_digit_count(x1);
+    ly = js_u32_digit_count(y1);
+    for(l = lx; l < ly; l++)
+        x1 *= 10;
+    for(l = ly; l < lx; l++)
+        y1 *= 10;
+    if (x1 != y1)
+        return (x1 < y1) ? -1 : 1;
+    return (lx > ly) - (lx < ly);
+}
+
 static JSValue js_array_sort(JSContext *ctx, JSValueConst this_val,
                              int argc, JSValueConst *argv)
 {
@@ -41879,6 +48032,8 @@ static JSValue js_array_sort(JSContext *ctx, JSValueConst this_val,
     size_t array_size = 0, pos = 0, n = 0;
     int64_t i, len, undefined_count = 0;
     int present;
+    JSObject *arrp;
+    uint32_t count32;
 
     if (!JS_IsUndefined(asc.method)) {
         if (check_function(ctx, asc.method))
@@ -41889,6 +48044,14 @@ static JSValue js_array_sort(JSContext *ctx, JSValueConst this_val,
     if (js_get_length64(ctx, &len, obj))
         goto exception;
 
+    if (!asc.has_method && js_get_fast_array(ctx, obj, &arrp, &count32) &&
+        count32 == len && arrp->array_kind == JS_ARRAY_KIND_INT32) {
+        /* the comparison cannot have side effects: sort in place */
+        rqsort(arrp->u.array.u.int32_ptr, count32, sizeof(int32_t),
+               js_array_cmp_int32, NULL);
+        return obj;
+    }
+
     /* XXX: should special case fast arrays */
     for (i = 0; i < len; i++) {
         if (pos >= array_size) {
@@ -41963,8 +48126,8 @@ fail:
 static JSValue js_array_toSorted(JSContext *ctx, JSValueConst this_val,
                                  int argc, JSValueConst *argv)
 {
-    JSValue arr, obj, ret, *arrp, *pval;
-    JSObject *p;
+    JSValue arr, obj, ret, *pval;
+    JSObject *p, *arrp;
     int64_t i, len;
     uint32_t count32;
     int ok;
@@ -41989,7 +48152,7 @@ static JSValue js_array_toSorted(JSContext *ctx, JSValueConst this_val,
         pval = p->u.array.u.values;
         if (js_get_fast_array(ctx, obj, &arrp, &count32) && count32 == len) {
             for (; i < len; i++, pval++)
-                *pval = JS_DupValue(ctx, arrp[i]);
+                *pval = js_array_get_element(ctx, arrp, i);
         } else {
             for (; i < len; i++, pval++) {
                 if (-1 == JS_TryGetPropertyInt64(ctx, obj, i, pval)) {
@@ -42946,48 +49109,94 @@ static JSValue js_string_concat(JSContext *ctx, JSValueConst this_val,
     return r;
 }
 
-static int string_cmp(JSString *p1, JSString *p2, int x1, int x2, int len)
-{
-    int i, c1, c2;
-    for (i = 0; i < len; i++) {
-        if ((c1 = string_get(p1, x1 + i)) != (c2 = string_get(p2, x2 + i)))
-            return c1 - c2;
-    }
-    return 0;
-}
-
 static int string_indexof_char(JSString *p, int c, int from)
 {
     /* assuming 0 <= from <= p->len */
-    int i, len = p->len;
+    int len = p->len;
     if (p->is_wide_char) {
-        for (i = from; i < len; i++) {
-            if (p->u.str16[i] == c)
-                return i;
+        const uint16_t *q;
+        if ((c & ~0xffff) == 0) {
+            q = mem_find2_u16(p->u.str16 + from, len - from, c, c, 0);
+            if (q)
+                return q - p->u.str16;
         }
     } else {
+        const uint8_t *q;
         if ((c & ~0xff) == 0) {
-            for (i = from; i < len; i++) {
-                if (p->u.str8[i] == (uint8_t)c)
-                    return i;
-            }
+            q = memchr(p->u.str8 + from, c, len - from);
+            if (q)
+                return q - p->u.str8;
         }
     }
     return -1;
 }
 
+/* return the first (or last if 'rev' is TRUE) position i in [from, end)
+   such that p[i] = c0 and p[i + d] = c1 or -1 if none */
+static int string_find2(JSString *p, int from, int end, int c0, int c1,
+                        int d, BOOL rev)
+{
+    if (p->is_wide_char) {
+        const uint16_t *q;
+        if (rev)
+            q = mem_rfind2_u16(p->u.str16 + from, end - from, c0, c1, d);
+        else
+            q = mem_find2_u16(p->u.str16 + from, end - from, c0, c1, d);
+        if (q)
+            return q - p->u.str16;
+    } else {
+        const uint8_t *q;
+        if ((c0 | c1) > 0xff)
+            return -1;
+        if (rev)
+            q = mem_rfind2_u8(p->u.str8 + from, end - from, c0, c1, d);
+        else
+            q = mem_find2_u8(p->u.str8 + from, end - from, c0, c1, d);
+        if (q)
+            return q - p->u.str8;
+    }
+    return -1;
+}
+
+/* return the first position >= from of p2 in p1 or -1 if none */
 static int string_indexof(JSString *p1, JSString *p2, int from)
 {
     /* assuming 0 <= from <= p1->len */
-    int c, i, j, len1 = p1->len, len2 = p2->len;
+    int c0, c1, j, end, len2 = p2->len;
     if (len2 == 0)
         return from;
-    for (i = from, c = string_get(p2, 0); i + len2 <= len1; i = j + 1) {
-        j = string_indexof_char(p1, c, i);
-        if (j < 0 || j + len2 > len1)
-            break;
-        if (!string_cmp(p1, p2, j + 1, 1, len2 - 1))
+    /* candidate positions are in [from, end) */
+    end = p1->len - len2 + 1;
+    c0 = string_get(p2, 0);
+    c1 = string_get(p2, len2 - 1);
+    while (from < end) {
+        j = string_find2(p1, from, end, c0, c1, len2 - 1, FALSE);
+        if (j < 0)
+            break;
+        if (len2 <= 2 || !js_string_memcmp(p1, j + 1, p2, 1, len2 - 2))
             return j;
+        from = j + 1;
+    }
+    return -1;
+}
+
+/* return the last position <= from of p2 in p1 or -1 if none */
+static int string_lastindexof(JSString *p1, JSString *p2, int from)
+{
+    /* assuming 0 <= from <= p1->len - p2->len */
+    int c0, c1, j, end, len2 = p2->len;
+    if (len2 == 0)
+        return from;
+    end = from + 1;
+    c0 = string_get(p2, 0);
+    c1 = string_get(p2, len2 - 1);
+    while (end > 0) {
+        j = string_find2(p1, 0, end, c0, c1, len2 - 1, TRUE);
+        if (j < 0)
+            break;
+        if (len2 <= 2 || !js_string_memcmp(p1, j + 1, p2, 1, len2 - 2))
+            return j;
+        end = j;
     }
     return -1;
 }
@@ -43082,7 +49291,7 @@ static JSValue js_string_indexOf(JSContext *ctx, JSValueConst this_val,
                                  int argc, JSValueConst *argv, int lastIndexOf)
 {
     JSValue str, v;
-    int i, len, v_len, pos, start, stop, ret, inc;
+    int len, v_len, pos, ret;
     JSString *p;
     JSString *p1;
 
@@ -43109,29 +49318,18 @@ static JSValue js_string_indexOf(JSContext *ctx, JSValueConst this_val,
                     pos = d;
             }
         }
-        start = pos;
-        stop = 0;
-        inc = -1;
+        ret = -1;
+        if (len >= v_len)
+            ret = string_lastindexof(p, p1, pos);
     } else {
         pos = 0;
         if (argc > 1) {
             if (JS_ToInt32Clamp(ctx, &pos, argv[1], 0, len, 0))
                 goto fail;
         }
-        start = pos;
-        stop = len - v_len;
-        inc = 1;
-    }
-    ret = -1;
-    if (len >= v_len && inc * (stop - start) >= 0) {
-        for (i = start;; i += inc) {
-            if (!string_cmp(p, p1, i, 0, v_len)) {
-                ret = i;
-                break;
-            }
-            if (i == stop)
-                break;
-        }
+        ret = -1;
+        if (len - v_len >= pos)
+            ret = string_indexof(p, p1, pos);
     }
     JS_FreeValue(ctx, str);
     JS_FreeValue(ctx, v);
@@ -43150,7 +49348,7 @@ static JSValue js_string_includes(JSContext *ctx, JSValueConst this_val,
                                   int argc, JSValueConst *argv, int magic)
 {
     JSValue str, v = JS_UNDEFINED;
-    int i, len, v_len, pos, start, stop, ret;
+    int len, v_len, pos, start, stop, ret;
     JSString *p;
     JSString *p1;
 
@@ -43190,14 +49388,10 @@ static JSValue js_string_includes(JSContext *ctx, JSValueConst this_val,
         start = stop = pos;
     }
     if (start >= 0 && start <= stop) {
-        for (i = start;; i++) {
-            if (!string_cmp(p, p1, i, 0, v_len)) {
-                ret = 1;
-                break;
-            }
-            if (i == stop)
-                break;
-        }
+        if (magic == 0)
+            ret = (string_indexof(p, p1, start) >= 0);
+        else
+            ret = !js_string_memcmp(p, start, p1, 0, v_len);
     }
  done:
     JS_FreeValue(ctx, str);
@@ -44734,18 +50928,212 @@ static JSValue js___date_create(JSContext *ctx, JSValueConst this_val,
 
 /* RegExp */
 
+#ifdef CONFIG_REGEXP_JIT
+static void js_regexp_jit_unref(JSRuntime *rt, JSRegExpJit *jit)
+{
+    if (--jit->ref_count == 0) {
+        if (jit->code)
+            lre_jit_free(jit->code);
+        js_free_rt(rt, jit);
+    }
+}
+
+static void js_regexp_free_jit(JSRuntime *rt, JSRegExp *re)
+{
+    if (re->jit > JS_REGEXP_JIT_THRESHOLD)
+        js_regexp_jit_unref(rt, (JSRegExpJit *)re->jit);
+    re->jit = 0;
+}
+
+static JSRegExpCacheEntry *js_regexp_cache_lookup(JSRuntime *rt,
+                                                  JSString *pattern,
+                                                  int re_flags, uint32_t h);
+
+/* return the native code of the bytecode of 're' with an additional
+   reference, or NULL if memory error. The code is compiled once per
+   cached bytecode. */
+static JSRegExpJit *js_regexp_get_jit(JSContext *ctx, JSRegExp *re)
+{
+    JSRuntime *rt = ctx->rt;
+    JSRegExpCacheEntry *e;
+    JSRegExpJit *jit;
+    int re_flags;
+
+    re_flags = lre_get_flags(re->bytecode->u.str8) & ~LRE_FLAG_NAMED_GROUPS;
+    e = js_regexp_cache_lookup(rt, re->pattern, re_flags,
+                               hash_string(re->pattern, re_flags));
+    if (e && e->bytecode != re->bytecode)
+        e = NULL;
+    if (e && e->jit) {
+        jit = e->jit;
+    } else {
+        jit = js_malloc_rt(rt, sizeof(*jit));
+        if (!jit)
+            return NULL;
+        jit->ref_count = 0;
+        jit->code = lre_jit_compile(re->bytecode->u.str8, ctx);
+        if (e) {
+            e->jit = jit;
+            jit->ref_count++;
+        }
+    }
+    jit->ref_count++;
+    return jit;
+}
+#endif
+
 static void js_regexp_finalizer(JSRuntime *rt, JSValue val)
 {
     JSObject *p = JS_VALUE_GET_OBJ(val);
     JSRegExp *re = &p->u.regexp;
+#ifdef CONFIG_REGEXP_JIT
+    js_regexp_free_jit(rt, re);
+#endif
     JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_STRING, re->bytecode));
     JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_STRING, re->pattern));
 }
 
+/* same as lre_exec() but may use the native code of the regexp */
+static int js_regexp_exec_internal(JSContext *ctx, JSRegExp *re,
+                                   uint8_t **capture, const uint8_t *cbuf,
+                                   int cindex, int clen, int cbuf_type)
+{
+#ifdef CONFIG_REGEXP_JIT
+    JSRegExpJit *jit;
+    /* only the 8 bit strings are supported */
+    if (cbuf_type == 0 && re->jit != JS_REGEXP_JIT_THRESHOLD) {
+        if (re->jit < JS_REGEXP_JIT_THRESHOLD) {
+            if (++re->jit == JS_REGEXP_JIT_THRESHOLD) {
+                jit = js_regexp_get_jit(ctx, re);
+                if (jit) {
+                    if (jit->code)
+                        re->jit = (uintptr_t)jit;
+                    else
+                        js_regexp_jit_unref(ctx->rt, jit);
+                }
+            }
+        }
+        if (re->jit > JS_REGEXP_JIT_THRESHOLD) {
+            return lre_exec_jit(capture, re->bytecode->u.str8,
+                                ((JSRegExpJit *)re->jit)->code,
+                                cbuf, cindex, clen, cbuf_type, ctx);
+        }
+    }
+#endif
+    return lre_exec(capture, re->bytecode->u.str8, cbuf, cindex, clen,
+                    cbuf_type, ctx);
+}
+
 /* create a string containing the RegExp bytecode */
+static void js_regexp_cache_remove(JSRuntime *rt, JSRegExpCacheEntry *e)
+{
+    JSRegExpCacheEntry **pe;
+
+    pe = &rt->regexp_cache_hash[e->hash & (rt->regexp_cache_hash_size - 1)];
+    while (*pe != e)
+        pe = &(*pe)->hash_next;
+    *pe = e->hash_next;
+    list_del(&e->link);
+    JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_STRING, e->pattern));
+    JS_FreeValueRT(rt, JS_MKPTR(JS_TAG_STRING, e->bytecode));
+#ifdef CONFIG_REGEXP_JIT
+    if (e->jit)
+        js_regexp_jit_unref(rt, e->jit);
+#endif
+    js_free_rt(rt, e);
+    rt->regexp_cache_count--;
+}
+
+static void js_regexp_cache_free(JSRuntime *rt)
+{
+    while (!list_empty(&rt->regexp_cache_lru)) {
+        js_regexp_cache_remove(rt, list_entry(rt->regexp_cache_lru.next,
+                                              JSRegExpCacheEntry, link));
+    }
+    js_free_rt(rt, rt->regexp_cache_hash);
+    rt->regexp_cache_hash = NULL;
+    rt->regexp_cache_hash_size = 0;
+}
+
+static JSRegExpCacheEntry *js_regexp_cache_lookup(JSRuntime *rt,
+                                                  JSString *pattern,
+                                                  int re_flags, uint32_t h)
+{
+    JSRegExpCacheEntry *e;
+
+    if (rt->regexp_cache_hash_size != 0) {
+        for(e = rt->regexp_cache_hash[h & (rt->regexp_cache_hash_size - 1)];
+            e != NULL; e = e->hash_next) {
+            if (e->hash == h && e->re_flags == re_flags &&
+                e->pattern->len == pattern->len &&
+                js_string_memcmp(e->pattern, 0, pattern, 0, pattern->len) == 0)
+                return e;
+        }
+    }
+    return NULL;
+}
+
+/* return the cached bytecode or JS_UNDEFINED if none */
+static JSValue js_regexp_cache_find(JSRuntime *rt, JSString *pattern,
+                                    int re_flags, uint32_t h)
+{
+    JSRegExpCacheEntry *e;
+
+    e = js_regexp_cache_lookup(rt, pattern, re_flags, h);
+    if (!e) {
+        rt->regexp_cache_miss_count++;
+        return JS_UNDEFINED;
+    }
+    list_del(&e->link);
+    list_add(&e->link, &rt->regexp_cache_lru);
+    rt->regexp_cache_hit_count++;
+    return JS_DupValueRT(rt, JS_MKPTR(JS_TAG_STRING, e->bytecode));
+}
+
+/* the cache is not modified in case of memory error */
+static void js_regexp_cache_add(JSRuntime *rt, JSString *pattern,
+                                int re_flags, uint32_t h, JSValueConst bc)
+{
+    JSRegExpCacheEntry *e, **pe;
+    int size;
+
+    if (rt->regexp_cache_max_count == 0)
+        return;
+    if (rt->regexp_cache_hash_size == 0) {
+        size = 1;
+        while (size < rt->regexp_cache_max_count)
+            size <<= 1;
+        rt->regexp_cache_hash = js_mallocz_rt(rt, sizeof(rt->regexp_cache_hash[0]) * size);
+        if (!rt->regexp_cache_hash)
+            return;
+        rt->regexp_cache_hash_size = size;
+    }
+    if (rt->regexp_cache_count >= rt->regexp_cache_max_count) {
+        /* remove the least recently used entry */
+        js_regexp_cache_remove(rt, list_entry(rt->regexp_cache_lru.prev,
+                                              JSRegExpCacheEntry, link));
+    }
+    e = js_malloc_rt(rt, sizeof(*e));
+    if (!e)
+        return;
+    e->hash = h;
+    e->re_flags = re_flags;
+    e->pattern = JS_VALUE_GET_STRING(JS_DupValueRT(rt, JS_MKPTR(JS_TAG_STRING, pattern)));
+    e->bytecode = JS_VALUE_GET_STRING(JS_DupValueRT(rt, bc));
+#ifdef CONFIG_REGEXP_JIT
+    e->jit = NULL;
+#endif
+    list_add(&e->link, &rt->regexp_cache_lru);
+    pe = &rt->regexp_cache_hash[h & (rt->regexp_cache_hash_size - 1)];
+    e->hash_next = *pe;
+    *pe = e;
+    rt->regexp_cache_count++;
+}
+
 static JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
                                  JSValueConst flags)
 {
+    JSRuntime *rt = ctx->rt;
     const char *str;
     int re_flags, mask;
     uint8_t *re_bytecode_buf;
@@ -44753,6 +51141,8 @@ static JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
     int re_bytecode_len;
     JSValue ret;
     char error_msg[64];
+    JSString *p;
+    uint32_t h;
 
     re_flags = 0;
     if (!JS_IsUndefined(flags)) {
@@ -44804,7 +51194,17 @@ static JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
     bad_flags1:
         return JS_ThrowSyntaxError(ctx, "invalid regular expression flags");
     }
-    
+
+    p = NULL;
+    h = 0;
+    if (JS_VALUE_GET_TAG(pattern) == JS_TAG_STRING) {
+        p = JS_VALUE_GET_STRING(pattern);
+        h = hash_string(p, re_flags);
+        ret = js_regexp_cache_find(rt, p, re_flags, h);
+        if (!JS_IsUndefined(ret))
+            return ret;
+    }
+
     str = JS_ToCStringLen2(ctx, &len, pattern, !(re_flags & (LRE_FLAG_UNICODE | LRE_FLAG_UNICODE_SETS)));
     if (!str)
         return JS_EXCEPTION;
@@ -44818,6 +51218,8 @@ static JSValue js_compile_regexp(JSContext *ctx, JSValueConst pattern,
 
     ret = js_new_string8_len(ctx, (const char *)re_bytecode_buf, re_bytecode_len);
     js_free(ctx, re_bytecode_buf);
+    if (p && !JS_IsException(ret))
+        js_regexp_cache_add(rt, p, re_flags, h, ret);
     return ret;
 }
 
@@ -44990,6 +51392,9 @@ static JSValue js_regexp_compile(JSContext *ctx, JSValueConst this_val,
     }
     JS_FreeValue(ctx, JS_MKPTR(JS_TAG_STRING, re->pattern));
     JS_FreeValue(ctx, JS_MKPTR(JS_TAG_STRING, re->bytecode));
+#ifdef CONFIG_REGEXP_JIT
+    js_regexp_free_jit(ctx->rt, re);
+#endif
     re->pattern = JS_VALUE_GET_STRING(pattern);
     re->bytecode = JS_VALUE_GET_STRING(bc);
     if (JS_SetProperty(ctx, this_val, JS_ATOM_lastIndex,
@@ -45189,6 +51594,12 @@ void *lre_realloc(void *opaque, void *ptr, size_t size)
     return js_realloc_rt(ctx->rt, ptr, size);
 }
 
+void lre_nfa_fallback(void *opaque)
+{
+    JSContext *ctx = opaque;
+    ctx->rt->regexp_nfa_count++;
+}
+
 static JSValue js_regexp_escape(JSContext *ctx, JSValueConst this_val,
                                 int argc, JSValueConst *argv)
 {
@@ -45289,9 +51700,8 @@ static JSValue js_regexp_exec(JSContext *ctx, JSValueConst this_val,
     if (last_index > str->len) {
         rc = 2;
     } else {
-        rc = lre_exec(capture, re_bytecode,
-                      str_buf, last_index, str->len,
-                      shift, ctx);
+        rc = js_regexp_exec_internal(ctx, re, capture,
+                                     str_buf, last_index, str->len, shift);
     }
     if (rc != 1) {
         if (rc >= 0) {
@@ -45445,106 +51855,495 @@ fail:
     return ret;
 }
 
-/* delete portions of a string that match a given regex */
-static JSValue JS_RegExpDelete(JSContext *ctx, JSValueConst this_val, JSValueConst arg)
+static int js_is_standard_regexp(JSContext *ctx, JSValueConst rx)
+{
+    JSValue val;
+    int res;
+
+    val = JS_GetProperty(ctx, rx, JS_ATOM_constructor);
+    if (JS_IsException(val))
+        return -1;
+    // rx.constructor === RegExp
+    res = js_same_value(ctx, val, ctx->regexp_ctor);
+    JS_FreeValue(ctx, val);
+    if (res) {
+        val = JS_GetProperty(ctx, rx, JS_ATOM_exec);
+        if (JS_IsException(val))
+            return -1;
+        // rx.exec === RE_exec
+        res = JS_IsCFunction(ctx, val, js_regexp_exec, 0);
+        JS_FreeValue(ctx, val);
+    }
+    return res;
+}
+
+/* execute 're' on 'str' from 'last_index' <= str->len. Return 1 if
+   match, 0 if no match or -1 if exception. */
+static int js_regexp_exec_raw(JSContext *ctx, JSRegExp *re, uint8_t **capture,
+                              JSString *str, int last_index)
+{
+    int rc;
+
+    rc = js_regexp_exec_internal(ctx, re, capture, str->u.str8, last_index,
+                                 str->len, str->is_wide_char);
+    if (rc < 0) {
+        if (rc == LRE_RET_TIMEOUT)
+            JS_ThrowInterrupted(ctx);
+        else
+            JS_ThrowInternalError(ctx, "out of memory in regexp execution");
+        return -1;
+    }
+    return rc;
+}
+
+/* store the start and end positions of the captures in 'indexes' (-1
+   if undefined) */
+static void js_regexp_get_indexes(int *indexes, uint8_t **capture,
+                                  int capture_count, JSString *str)
+{
+    int i, shift = str->is_wide_char;
+
+    for(i = 0; i < capture_count; i++) {
+        if (capture[2 * i] && capture[2 * i + 1]) {
+            indexes[2 * i] = (capture[2 * i] - str->u.str8) >> shift;
+            indexes[2 * i + 1] = (capture[2 * i + 1] - str->u.str8) >> shift;
+        } else {
+            indexes[2 * i] = -1;
+            indexes[2 * i + 1] = -1;
+        }
+    }
+}
+
+/* return TRUE if the RegExp.prototype methods can directly use the
+   matching engine on 'rx' instead of calling 'exec'. 'is_global' and
+   'full_unicode' are deduced from the 'flags' property. */
+static int js_regexp_is_fast(JSContext *ctx, JSValueConst rx,
+                             BOOL is_global, BOOL full_unicode)
+{
+    JSRegExp *re;
+    int res, re_flags;
+
+    res = js_is_standard_regexp(ctx, rx);
+    if (res <= 0)
+        return res;
+    re = js_get_regexp(ctx, rx, FALSE);
+    if (!re)
+        return FALSE;
+    re_flags = lre_get_flags(re->bytecode->u.str8);
+    if (((re_flags & LRE_FLAG_GLOBAL) != 0) != is_global)
+        return FALSE;
+    if (is_global &&
+        ((re_flags & (LRE_FLAG_UNICODE | LRE_FLAG_UNICODE_SETS)) != 0) != full_unicode)
+        return FALSE;
+    return TRUE;
+}
+
+typedef enum {
+    JS_REPLACE_PART_STRING, /* rep[a, b) */
+    JS_REPLACE_PART_CAPTURE, /* capture a */
+    JS_REPLACE_PART_PREFIX, /* $` */
+    JS_REPLACE_PART_SUFFIX, /* $' */
+} JSReplacePartEnum;
+
+typedef struct {
+    JSReplacePartEnum type : 8;
+    int a, b;
+} JSReplacePart;
+
+typedef struct {
+    JSContext *ctx;
+    JSReplacePart *tab;
+    int count;
+    int size;
+} JSReplaceParts;
+
+static int js_replace_add_part(JSReplaceParts *s, JSReplacePartEnum type,
+                               int a, int b)
+{
+    JSReplacePart *pt;
+
+    if (type == JS_REPLACE_PART_STRING && a == b)
+        return 0;
+    if (js_resize_array(s->ctx, (void **)&s->tab, sizeof(s->tab[0]),
+                        &s->size, s->count + 1))
+        return -1;
+    pt = &s->tab[s->count++];
+    pt->type = type;
+    pt->a = a;
+    pt->b = b;
+    return 0;
+}
+
+/* Parse the replacement string once with the same rules as
+   GetSubstitution(). 'group_names' is NULL if no named groups. */
+static int js_replace_parse(JSReplaceParts *s, JSString *rp,
+                            int capture_count, const char *group_names)
+{
+    JSContext *ctx = s->ctx;
+    int len, i, j, j0, k, k1, c, c1, idx;
+    const char *name, *ptr;
+    JSValue name_val;
+
+    len = rp->len;
+    i = 0;
+    for(;;) {
+        j = string_indexof_char(rp, '$', i);
+        if (j < 0 || j + 1 >= len)
+            break;
+        if (js_replace_add_part(s, JS_REPLACE_PART_STRING, i, j))
+            return -1;
+        j0 = j++;
+        c = string_get(rp, j++);
+        if (c == '$') {
+            if (js_replace_add_part(s, JS_REPLACE_PART_STRING, j0, j0 + 1))
+                return -1;
+        } else if (c == '&') {
+            if (js_replace_add_part(s, JS_REPLACE_PART_CAPTURE, 0, 0))
+                return -1;
+        } else if (c == '`') {
+            if (js_replace_add_part(s, JS_REPLACE_PART_PREFIX, 0, 0))
+                return -1;
+        } else if (c == '\'') {
+            if (js_replace_add_part(s, JS_REPLACE_PART_SUFFIX, 0, 0))
+                return -1;
+        } else if (c >= '0' && c <= '9') {
+            k = c - '0';
+            if (j < len) {
+                c1 = string_get(rp, j);
+                if (c1 >= '0' && c1 <= '9') {
+                    k1 = k * 10 + c1 - '0';
+                    if (k1 >= 1 && k1 < capture_count) {
+                        k = k1;
+                        j++;
+                    }
+                }
+            }
+            if (k >= 1 && k < capture_count) {
+                if (js_replace_add_part(s, JS_REPLACE_PART_CAPTURE, k, 0))
+                    return -1;
+            } else {
+                goto norep;
+            }
+        } else if (c == '<' && group_names) {
+            k = string_indexof_char(rp, '>', j);
+            if (k < 0)
+                goto norep;
+            name_val = js_sub_string(ctx, rp, j, k);
+            if (JS_IsException(name_val))
+                return -1;
+            name = JS_ToCString(ctx, name_val);
+            JS_FreeValue(ctx, name_val);
+            if (!name)
+                return -1;
+            /* an unknown group is replaced by the empty string */
+            ptr = group_names;
+            for(idx = 1; idx < capture_count; idx++) {
+                if (!strcmp(ptr, name))
+                    break;
+                ptr += strlen(ptr) + 1;
+            }
+            JS_FreeCString(ctx, name);
+            if (idx < capture_count &&
+                js_replace_add_part(s, JS_REPLACE_PART_CAPTURE, idx, 0))
+                return -1;
+            j = k + 1;
+        } else {
+        norep:
+            if (js_replace_add_part(s, JS_REPLACE_PART_STRING, j0, j))
+                return -1;
+        }
+        i = j;
+    }
+    return js_replace_add_part(s, JS_REPLACE_PART_STRING, i, len);
+}
+
+static int js_replace_concat(StringBuffer *b, const JSReplaceParts *s,
+                             JSString *rp, JSString *sp, const int *indexes)
+{
+    const JSReplacePart *pt;
+    int i, ret;
+
+    for(i = 0; i < s->count; i++) {
+        pt = &s->tab[i];
+        switch(pt->type) {
+        case JS_REPLACE_PART_STRING:
+            ret = string_buffer_concat(b, rp, pt->a, pt->b);
+            break;
+        case JS_REPLACE_PART_CAPTURE:
+            ret = 0;
+            if (indexes[2 * pt->a] >= 0) {
+                ret = string_buffer_concat(b, sp, indexes[2 * pt->a],
+                                           indexes[2 * pt->a + 1]);
+            }
+            break;
+        case JS_REPLACE_PART_PREFIX:
+            ret = string_buffer_concat(b, sp, 0, indexes[0]);
+            break;
+        case JS_REPLACE_PART_SUFFIX:
+            ret = string_buffer_concat(b, sp, indexes[1], sp->len);
+            break;
+        default:
+            abort();
+        }
+        if (ret)
+            return -1;
+    }
+    return 0;
+}
+
+/* call the replacement function for the match 'indexes' */
+static JSValue js_replace_call(JSContext *ctx, JSValueConst func,
+                               JSValueConst str_val, const int *indexes,
+                               int capture_count, const char *group_names)
+{
+    JSString *sp = JS_VALUE_GET_STRING(str_val);
+    JSValue *args, groups, val, ret;
+    int i, n;
+
+    args = js_malloc(ctx, sizeof(args[0]) * (capture_count + 3));
+    if (!args)
+        return JS_EXCEPTION;
+    ret = JS_EXCEPTION;
+    groups = JS_UNDEFINED;
+    n = 0;
+    if (group_names) {
+        groups = JS_NewObjectProto(ctx, JS_NULL);
+        if (JS_IsException(groups))
+            goto done;
+    }
+    for(i = 0; i < capture_count; i++) {
+        val = JS_UNDEFINED;
+        if (indexes[2 * i] >= 0) {
+            val = js_sub_string(ctx, sp, indexes[2 * i], indexes[2 * i + 1]);
+            if (JS_IsException(val))
+                goto done;
+        }
+        if (group_names && i > 0) {
+            if (*group_names &&
+                JS_DefinePropertyValueStr(ctx, groups, group_names,
+                                          JS_DupValue(ctx, val),
+                                          JS_PROP_C_W_E | JS_PROP_THROW) < 0) {
+                JS_FreeValue(ctx, val);
+                goto done;
+            }
+            group_names += strlen(group_names) + 1;
+        }
+        args[n++] = val;
+    }
+    args[n++] = JS_NewInt32(ctx, indexes[0]);
+    args[n++] = JS_DupValue(ctx, str_val);
+    if (!JS_IsUndefined(groups)) {
+        args[n++] = groups;
+        groups = JS_UNDEFINED;
+    }
+    ret = JS_ToStringFree(ctx, JS_Call(ctx, func, JS_UNDEFINED, n,
+                                       (JSValueConst *)args));
+ done:
+    for(i = 0; i < n; i++)
+        JS_FreeValue(ctx, args[i]);
+    JS_FreeValue(ctx, groups);
+    js_free(ctx, args);
+    return ret;
+}
+
+/* Fast path of RegExp.prototype[Symbol.replace] when 'rx' is a
+   standard regexp: the matches are directly appended to the result
+   without creating the match result objects. 'rep' is the replacement
+   string or a function if 'functional' is TRUE. */
+static JSValue JS_RegExpReplace(JSContext *ctx, JSValueConst this_val,
+                                JSValueConst str_val, JSValueConst rep,
+                                BOOL functional)
 {
     JSRegExp *re = js_get_regexp(ctx, this_val, TRUE);
-    JSString *str;
-    JSValue str_val, val;
+    JSString *str, *rp;
+    JSValue val, rep_str, bc_val;
     uint8_t *re_bytecode;
-    int ret;
-    uint8_t **capture, *str_buf;
-    int capture_count, shift, re_flags;
-    int next_src_pos, start, end;
+    const char *group_names;
+    int ret, i;
+    uint8_t **capture;
+    int *indexes, *matches;
+    int capture_count, re_flags, full_unicode;
+    int next_src_pos, start, end, match_count, match_size;
     int64_t last_index;
     StringBuffer b_s, *b = &b_s;
+    JSReplaceParts parts_s, *parts = &parts_s;
 
     if (!re)
         return JS_EXCEPTION;
 
     string_buffer_init(ctx, b, 0);
-
+    parts->ctx = ctx;
+    parts->tab = NULL;
+    parts->count = 0;
+    parts->size = 0;
     capture = NULL;
-    str_val = JS_ToString(ctx, arg);
-    if (JS_IsException(str_val))
+    matches = NULL;
+    match_count = 0;
+    match_size = 0;
+    /* the replacement function may recompile the regexp */
+    bc_val = JS_DupValue(ctx, JS_MKPTR(JS_TAG_STRING, re->bytecode));
+
+    /* RegExpBuiltinExec() always reads lastIndex */
+    val = JS_GetProperty(ctx, this_val, JS_ATOM_lastIndex);
+    if (JS_IsException(val) || JS_ToLengthFree(ctx, &last_index, val))
         goto fail;
     str = JS_VALUE_GET_STRING(str_val);
     re_bytecode = re->bytecode->u.str8;
     re_flags = lre_get_flags(re_bytecode);
-    if ((re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY)) == 0) {
+    if ((re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY)) == 0)
         last_index = 0;
-    } else {
-        val = JS_GetProperty(ctx, this_val, JS_ATOM_lastIndex);
-        if (JS_IsException(val) || JS_ToLengthFree(ctx, &last_index, val))
-            goto fail;
-    }
+    full_unicode = (re_flags & (LRE_FLAG_UNICODE | LRE_FLAG_UNICODE_SETS)) != 0;
     capture_count = lre_get_capture_count(re_bytecode);
-    if (capture_count > 0) {
-        capture = js_malloc(ctx, sizeof(capture[0]) * capture_count * 2);
-        if (!capture)
+    group_names = lre_get_groupnames(re_bytecode);
+    /* the captures and their indexes */
+    capture = js_malloc(ctx, sizeof(capture[0]) * capture_count * 2 +
+                        sizeof(indexes[0]) * capture_count * 2);
+    if (!capture)
+        goto fail;
+    indexes = (int *)(capture + capture_count * 2);
+    if (!functional) {
+        if (js_replace_parse(parts, JS_VALUE_GET_STRING(rep), capture_count,
+                             group_names))
             goto fail;
     }
-    shift = str->is_wide_char;
-    str_buf = str->u.str8;
     next_src_pos = 0;
     for (;;) {
-        if (last_index > str->len)
-            break;
-
-        ret = lre_exec(capture, re_bytecode,
-                       str_buf, last_index, str->len, shift, ctx);
-        if (ret != 1) {
-            if (ret >= 0) {
-                if (ret == 2 || (re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY))) {
-                    if (JS_SetProperty(ctx, this_val, JS_ATOM_lastIndex,
-                                       JS_NewInt32(ctx, 0)) < 0)
-                        goto fail;
-                }
-            } else {
-                if (ret == LRE_RET_TIMEOUT) {
-                    JS_ThrowInterrupted(ctx);
-                } else {
-                    JS_ThrowInternalError(ctx, "out of memory in regexp execution");
-                }
+        if (last_index > str->len) {
+            ret = 2;
+        } else {
+            ret = js_regexp_exec_raw(ctx, re, capture, str, last_index);
+            if (ret < 0)
                 goto fail;
+        }
+        if (ret != 1) {
+            if (ret == 2 || (re_flags & (LRE_FLAG_GLOBAL | LRE_FLAG_STICKY))) {
+                if (JS_SetProperty(ctx, this_val, JS_ATOM_lastIndex,
+                                   JS_NewInt32(ctx, 0)) < 0)
+                    goto fail;
             }
             break;
         }
-        start = (capture[0] - str_buf) >> shift;
-        end = (capture[1] - str_buf) >> shift;
-        last_index = end;
-        if (next_src_pos < start) {
+        js_regexp_get_indexes(indexes, capture, capture_count, str);
+        start = indexes[0];
+        end = indexes[1];
+        if (functional) {
+            /* the function is called after all the matches are found */
+            if (js_resize_array(ctx, (void **)&matches, sizeof(matches[0]),
+                                &match_size,
+                                (match_count + 1) * capture_count * 2))
+                goto fail;
+            memcpy(matches + match_count * capture_count * 2, indexes,
+                   sizeof(indexes[0]) * capture_count * 2);
+            match_count++;
+        } else {
             if (string_buffer_concat(b, str, next_src_pos, start))
                 goto fail;
-        }
-        next_src_pos = end;
-        if (!(re_flags & LRE_FLAG_GLOBAL)) {
-            if (JS_SetProperty(ctx, this_val, JS_ATOM_lastIndex,
-                               JS_NewInt32(ctx, end)) < 0)
+            rp = JS_VALUE_GET_STRING(rep);
+            if (js_replace_concat(b, parts, rp, str, indexes))
                 goto fail;
-            break;
+            next_src_pos = end;
         }
-        if (end == start) {
-            if (!(re_flags & LRE_FLAG_UNICODE) || (unsigned)end >= str->len || !str->is_wide_char) {
-                end++;
-            } else {
-                string_getc(str, &end);
+        if (!(re_flags & LRE_FLAG_GLOBAL)) {
+            if (re_flags & LRE_FLAG_STICKY) {
+                if (JS_SetProperty(ctx, this_val, JS_ATOM_lastIndex,
+                                   JS_NewInt32(ctx, end)) < 0)
+                    goto fail;
             }
+            break;
         }
+        if (end == start)
+            end = string_advance_index(str, end, full_unicode);
         last_index = end;
     }
+    for(i = 0; i < match_count; i++) {
+        int *m = matches + i * capture_count * 2;
+        rep_str = js_replace_call(ctx, rep, str_val, m, capture_count,
+                                  group_names);
+        if (JS_IsException(rep_str))
+            goto fail;
+        if (string_buffer_concat(b, str, next_src_pos, m[0]) ||
+            string_buffer_concat_value_free(b, rep_str))
+            goto fail;
+        next_src_pos = m[1];
+    }
     if (string_buffer_concat(b, str, next_src_pos, str->len))
         goto fail;
-    JS_FreeValue(ctx, str_val);
+    JS_FreeValue(ctx, bc_val);
+    js_free(ctx, matches);
+    js_free(ctx, parts->tab);
     js_free(ctx, capture);
     return string_buffer_end(b);
 fail:
-    JS_FreeValue(ctx, str_val);
+    JS_FreeValue(ctx, bc_val);
+    js_free(ctx, matches);
+    js_free(ctx, parts->tab);
     js_free(ctx, capture);
     string_buffer_free(b);
     return JS_EXCEPTION;
 }
 
+/* Fast path of RegExp.prototype[Symbol.match] for a global standard
+   regexp: only the matched strings are created. */
+static JSValue JS_RegExpMatch(JSContext *ctx, JSValueConst this_val,
+                                 JSValueConst str_val)
+{
+    JSRegExp *re = js_get_regexp(ctx, this_val, TRUE);
+    JSString *str;
+    JSValue A, val;
+    uint8_t **capture;
+    int capture_count, ret, start, end, full_unicode, re_flags;
+    int64_t last_index, n;
+
+    if (!re)
+        return JS_EXCEPTION;
+    str = JS_VALUE_GET_STRING(str_val);
+    re_flags = lre_get_flags(re->bytecode->u.str8);
+    full_unicode = (re_flags & (LRE_FLAG_UNICODE | LRE_FLAG_UNICODE_SETS)) != 0;
+    capture_count = lre_get_capture_count(re->bytecode->u.str8);
+    capture = js_malloc(ctx, sizeof(capture[0]) * capture_count * 2);
+    if (!capture)
+        return JS_EXCEPTION;
+    A = JS_NewArray(ctx);
+    if (JS_IsException(A))
+        goto fail;
+    /* lastIndex was set to 0 by the caller */
+    last_index = 0;
+    n = 0;
+    for(;;) {
+        if (last_index > str->len)
+            break;
+        ret = js_regexp_exec_raw(ctx, re, capture, str, last_index);
+        if (ret < 0)
+            goto fail;
+        if (ret == 0)
+            break;
+        start = (capture[0] - str->u.str8) >> str->is_wide_char;
+        end = (capture[1] - str->u.str8) >> str->is_wide_char;
+        val = js_sub_string(ctx, str, start, end);
+        if (JS_IsException(val))
+            goto fail;
+        if (JS_DefinePropertyValueInt64(ctx, A, n++, val,
+                                        JS_PROP_C_W_E | JS_PROP_THROW) < 0)
+            goto fail;
+        if (end == start)
+            end = string_advance_index(str, end, full_unicode);
+        last_index = end;
+    }
+    /* the last failed execution resets lastIndex */
+    if (JS_SetProperty(ctx, this_val, JS_ATOM_lastIndex, JS_NewInt32(ctx, 0)) < 0)
+        goto fail;
+    js_free(ctx, capture);
+    if (n == 0) {
+        JS_FreeValue(ctx, A);
+        return JS_NULL;
+    }
+    return A;
+ fail:
+    js_free(ctx, capture);
+    JS_FreeValue(ctx, A);
+    return JS_EXCEPTION;
+}
+
 static JSValue JS_RegExpExec(JSContext *ctx, JSValueConst r, JSValueConst s)
 {
     JSValue method, ret;
@@ -45572,10 +52371,10 @@ static JSValue js_regexp___RegExpExec(JSContext *ctx, JSValueConst this_val,
 {
     return JS_RegExpExec(ctx, argv[0], argv[1]);
 }
-static JSValue js_regexp___RegExpDelete(JSContext *ctx, JSValueConst this_val,
-                                        int argc, JSValueConst *argv)
+static JSValue js_regexp___RegExpReplace(JSContext *ctx, JSValueConst this_val,
+                                         int argc, JSValueConst *argv)
 {
-    return JS_RegExpDelete(ctx, argv[0], argv[1]);
+    return JS_RegExpReplace(ctx, argv[0], argv[1], argv[2], FALSE);
 }
 #endif
 
@@ -45630,6 +52429,13 @@ static JSValue js_regexp_Symbol_match(JSContext *ctx, JSValueConst this_val,
 
         if (JS_SetProperty(ctx, rx, JS_ATOM_lastIndex, JS_NewInt32(ctx, 0)) < 0)
             goto exception;
+        n = js_regexp_is_fast(ctx, rx, global, fullUnicode);
+        if (n < 0)
+            goto exception;
+        if (n) {
+            A = JS_RegExpMatch(ctx, rx, S);
+            goto done;
+        }
         A = JS_NewArray(ctx);
         if (JS_IsException(A))
             goto exception;
@@ -45663,6 +52469,7 @@ static JSValue js_regexp_Symbol_match(JSContext *ctx, JSValueConst this_val,
             A = JS_NULL;
         }
     }
+ done:
     JS_FreeValue(ctx, result);
     JS_FreeValue(ctx, flags);
     JS_FreeValue(ctx, S);
@@ -45887,28 +52694,6 @@ static int value_buffer_append(ValueBuffer *b, JSValue val)
     return 0;
 }
 
-static int js_is_standard_regexp(JSContext *ctx, JSValueConst rx)
-{
-    JSValue val;
-    int res;
-
-    val = JS_GetProperty(ctx, rx, JS_ATOM_constructor);
-    if (JS_IsException(val))
-        return -1;
-    // rx.constructor === RegExp
-    res = js_same_value(ctx, val, ctx->regexp_ctor);
-    JS_FreeValue(ctx, val);
-    if (res) {
-        val = JS_GetProperty(ctx, rx, JS_ATOM_exec);
-        if (JS_IsException(val))
-            return -1;
-        // rx.exec === RE_exec
-        res = JS_IsCFunction(ctx, val, js_regexp_exec, 0);
-        JS_FreeValue(ctx, val);
-    }
-    return res;
-}
-
 static JSValue js_regexp_Symbol_replace(JSContext *ctx, JSValueConst this_val,
                                         int argc, JSValueConst *argv)
 {
@@ -45967,9 +52752,13 @@ static JSValue js_regexp_Symbol_replace(JSContext *ctx, JSValueConst this_val,
             goto exception;
     }
 
-    if (rp && rp->len == 0 && is_global && js_is_standard_regexp(ctx, rx)) {
-        /* use faster version for simple cases */
-        res = JS_RegExpDelete(ctx, rx, str);
+    n = js_regexp_is_fast(ctx, rx, is_global, fullUnicode);
+    if (n < 0)
+        goto exception;
+    if (n) {
+        /* no need to create the match results */
+        res = JS_RegExpReplace(ctx, rx, str, rp ? rep_val : rep,
+                               functionalReplace);
         goto done;
     }
     for(;;) {
@@ -46166,9 +52955,11 @@ static JSValue js_regexp_Symbol_split(JSContext *ctx, JSValueConst this_val,
     JSValueConst args[2];
     JSValue str, ctor, splitter, A, flags, z, sub;
     JSString *strp;
+    JSRegExp *re;
     uint32_t lim, size, p, q;
-    int unicodeMatching;
+    int unicodeMatching, res, ret, capture_count;
     int64_t lengthA, e, numberOfCaptures, i;
+    uint8_t **capture;
 
     if (!JS_IsObject(rx))
         return JS_ThrowTypeErrorNotAnObject(ctx);
@@ -46178,6 +52969,7 @@ static JSValue js_regexp_Symbol_split(JSContext *ctx, JSValueConst this_val,
     A = JS_UNDEFINED;
     flags = JS_UNDEFINED;
     z = JS_UNDEFINED;
+    capture = NULL;
     str = JS_ToString(ctx, argv[0]);
     if (JS_IsException(str))
         goto exception;
@@ -46223,6 +53015,64 @@ static JSValue js_regexp_Symbol_split(JSContext *ctx, JSValueConst this_val,
             goto add_tail;
         goto done;
     }
+    /* when the splitter is a standard regexp which cannot be accessed
+       from JS code, the matches are done without the 'exec' calls */
+    re = NULL;
+    if (js_same_value(ctx, ctor, ctx->regexp_ctor)) {
+        res = js_is_standard_regexp(ctx, splitter);
+        if (res < 0)
+            goto exception;
+        if (res) {
+            re = js_get_regexp(ctx, splitter, FALSE);
+            if (re && !(lre_get_flags(re->bytecode->u.str8) & LRE_FLAG_STICKY))
+                re = NULL;
+        }
+    }
+    if (re) {
+        capture_count = lre_get_capture_count(re->bytecode->u.str8);
+        capture = js_malloc(ctx, sizeof(capture[0]) * capture_count * 2);
+        if (!capture)
+            goto exception;
+        while (q < size) {
+            ret = js_regexp_exec_raw(ctx, re, capture, strp, q);
+            if (ret < 0)
+                goto exception;
+            if (ret == 0) {
+                q = string_advance_index(strp, q, unicodeMatching);
+                continue;
+            }
+            e = (capture[1] - strp->u.str8) >> strp->is_wide_char;
+            if (e == p) {
+                q = string_advance_index(strp, q, unicodeMatching);
+                continue;
+            }
+            sub = js_sub_string(ctx, strp, p, q);
+            if (JS_IsException(sub))
+                goto exception;
+            if (JS_DefinePropertyValueInt64(ctx, A, lengthA++, sub,
+                                            JS_PROP_C_W_E | JS_PROP_THROW) < 0)
+                goto exception;
+            if (lengthA == lim)
+                goto done;
+            p = e;
+            for(i = 1; i < capture_count; i++) {
+                sub = JS_UNDEFINED;
+                if (capture[2 * i] && capture[2 * i + 1]) {
+                    sub = js_sub_string(ctx, strp,
+                                        (capture[2 * i] - strp->u.str8) >> strp->is_wide_char,
+                                        (capture[2 * i + 1] - strp->u.str8) >> strp->is_wide_char);
+                    if (JS_IsException(sub))
+                        goto exception;
+                }
+                if (JS_DefinePropertyValueInt64(ctx, A, lengthA++, sub, JS_PROP_C_W_E | JS_PROP_THROW) < 0)
+                    goto exception;
+                if (lengthA == lim)
+                    goto done;
+            }
+            q = p;
+        }
+        goto add_tail;
+    }
     while (q < size) {
         if (JS_SetProperty(ctx, splitter, JS_ATOM_lastIndex, JS_NewInt32(ctx, q)) < 0)
             goto exception;
@@ -46282,6 +53132,7 @@ done:
     JS_FreeValue(ctx, splitter);
     JS_FreeValue(ctx, flags);
     JS_FreeValue(ctx, z);
+    js_free(ctx, capture);
     return A;
 }
 
@@ -46289,7 +53140,7 @@ static const JSCFunctionListEntry js_regexp_funcs[] = {
     JS_CFUNC_DEF("escape", 1, js_regexp_escape ),
     JS_CGETSET_DEF("[Symbol.species]", js_get_this, NULL ),
     //JS_CFUNC_DEF("__RegExpExec", 2, js_regexp___RegExpExec ),
-    //JS_CFUNC_DEF("__RegExpDelete", 2, js_regexp___RegExpDelete ),
+    //JS_CFUNC_DEF("__RegExpReplace", 3, js_regexp___RegExpReplace ),
 };
 
 static const JSCFunctionListEntry js_regexp_proto_funcs[] = {
@@ -46491,12 +53342,421 @@ static JSValue json_parse_value(JSParseState *s)
     return JS_EXCEPTION;
 }
 
+/* Fast JSON.parse() for the standard JSON syntax. The syntax errors
+   are not reported: the input is then parsed again with
+   json_parse_value() to get the right error message. */
+
+#define JSON_ATOM_CACHE_SIZE 64 /* must be a power of two */
+
+typedef struct {
+    JSContext *ctx;
+    const uint8_t *ptr;
+    const uint8_t *buf_end;
+    BOOL need_slow; /* syntax error: use the slow parser */
+    JSAtom atom_cache[JSON_ATOM_CACHE_SIZE]; /* recently used keys */
+} JSONFastParseState;
+
+static inline const uint8_t *json_skip_space(const uint8_t *p)
+{
+    while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')
+        p++;
+    return p;
+}
+
+static JSValue json_fast_syntax_error(JSONFastParseState *s)
+{
+    s->need_slow = TRUE;
+    return JS_EXCEPTION;
+}
+
+static BOOL js_atom_equal_str8(JSRuntime *rt, JSAtom atom,
+                               const uint8_t *buf, size_t len)
+{
+    JSString *p;
+    if (__JS_AtomIsTaggedInt(atom))
+        return FALSE;
+    p = rt->atom_array[atom];
+    return (p->len == len && !p->is_wide_char &&
+            !memcmp(p->u.str8, buf, len));
+}
+
+/* return the atom of the ASCII key 'buf'. The most common case is a
+   key following the same keys as a previously parsed object: it is
+   then found in the transitions of the current shape. */
+static JSAtom json_fast_atom(JSONFastParseState *s, JSShape *sh,
+                             const uint8_t *buf, size_t len, BOOL *pis_new)
+{
+    JSContext *ctx = s->ctx;
+    JSRuntime *rt = ctx->rt;
+    JSShape *sh1;
+    JSShapeProperty *pr;
+    JSAtom atom;
+    uint32_t h;
+
+    for(sh1 = sh->transition_first_child; sh1 != NULL;
+        sh1 = sh1->transition_next) {
+        pr = &sh1->prop[sh1->prop_count - 1];
+        if (pr->flags == JS_PROP_C_W_E &&
+            js_atom_equal_str8(rt, pr->atom, buf, len)) {
+            /* the transition implies that the key is not present */
+            *pis_new = TRUE;
+            return JS_DupAtom(ctx, pr->atom);
+        }
+    }
+    *pis_new = FALSE;
+    h = len;
+    if (len > 0)
+        h += buf[0] * 7 + buf[len >> 1] * 31 + buf[len - 1] * 131;
+    h &= JSON_ATOM_CACHE_SIZE - 1;
+    atom = s->atom_cache[h];
+    if (atom != JS_ATOM_NULL && js_atom_equal_str8(rt, atom, buf, len))
+        return JS_DupAtom(ctx, atom);
+    atom = JS_NewAtomLen(ctx, (const char *)buf, len);
+    if (atom != JS_ATOM_NULL) {
+        JS_FreeAtom(ctx, s->atom_cache[h]);
+        s->atom_cache[h] = JS_DupAtom(ctx, atom);
+    }
+    return atom;
+}
+
+/* 's->ptr' points after the opening quote. The first 'len' chars are
+   plain ASCII chars. */
+static JSValue json_fast_string(JSONFastParseState *s, size_t len)
+{
+    const uint8_t *p = s->ptr, *p_next;
+    StringBuffer b_s, *b = &b_s;
+    uint32_t c;
+    int i, h;
+
+    if (p[len] == '\"' && len <= JS_STRING_LEN_MAX) {
+        s->ptr = p + len + 1;
+        return js_new_string8_len(s->ctx, (const char *)p, len);
+    }
+    if (string_buffer_init(s->ctx, b, len + 16))
+        return JS_EXCEPTION;
+    for(;;) {
+        if (string_buffer_write8(b, p, len))
+            goto fail;
+        p += len;
+        c = *p++;
+        if (c == '\"') {
+            break;
+        } else if (c == '\\') {
+            c = *p++;
+            switch(c) {
+            case 'b':   c = '\b'; break;
+            case 'f':   c = '\f'; break;
+            case 'n':   c = '\n'; break;
+            case 'r':   c = '\r'; break;
+            case 't':   c = '\t'; break;
+            case '\"':  break;
+            case '\\':  break;
+            case '/':   break;
+            case 'u':
+                c = 0;
+                for(i = 0; i < 4; i++) {
+                    h = from_hex(*p++);
+                    if (h < 0)
+                        goto syntax_error;
+                    c = (c << 4) | h;
+                }
+                break;
+            default:
+                goto syntax_error;
+            }
+        } else if (c >= 0x80) {
+            c = unicode_from_utf8(p - 1, UTF8_CHAR_LEN_MAX, &p_next);
+            if (c > 0x10FFFF)
+                goto syntax_error;
+            p = p_next;
+        } else {
+            /* control character or end of input */
+            goto syntax_error;
+        }
+        if (string_buffer_putc(b, c))
+            goto fail;
+        len = mem_json_str_len(p, s->buf_end - p);
+    }
+    s->ptr = p;
+    return string_buffer_end(b);
+ syntax_error:
+    s->need_slow = TRUE;
+ fail:
+    string_buffer_free(b);
+    return JS_EXCEPTION;
+}
+
+static JSValue json_fast_number(JSONFastParseState *s)
+{
+    const uint8_t *p, *p_start;
+    JSATODTempMem atod_mem;
+    uint32_t v;
+    int n;
+    double d;
+
+    p = p_start = s->ptr;
+    if (*p == '-')
+        p++;
+    v = 0;
+    if (*p == '0') {
+        p++;
+        n = 1;
+    } else if (is_digit(*p)) {
+        for(n = 0; is_digit(*p); n++)
+            v = v * 10 + (*p++ - '0');
+    } else {
+        return json_fast_syntax_error(s);
+    }
+    if (is_digit(*p))
+        return json_fast_syntax_error(s);
+    if (n <= 9 && *p != '.' && *p != 'e' && *p != 'E') {
+        s->ptr = p;
+        if (*p_start == '-') {
+            if (v == 0)
+                return __JS_NewFloat64(s->ctx, -0.0);
+            return JS_NewInt32(s->ctx, -(int32_t)v);
+        }
+        return JS_NewInt32(s->ctx, v);
+    }
+    if (*p == '.') {
+        p++;
+        if (!is_digit(*p))
+            return json_fast_syntax_error(s);
+        while (is_digit(*p))
+            p++;
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-')
+            p++;
+        if (!is_digit(*p))
+            return json_fast_syntax_error(s);
+        while (is_digit(*p))
+            p++;
+    }
+    s->ptr = p;
+    d = js_atod((const char *)p_start, NULL, 10, 0, &atod_mem);
+    return JS_NewFloat64(s->ctx, d);
+}
+
+static JSValue json_fast_value(JSONFastParseState *s);
+
+static JSValue json_fast_object(JSONFastParseState *s)
+{
+    JSContext *ctx = s->ctx;
+    JSValue obj, val, key;
+    JSObject *p;
+    JSProperty *pr;
+    JSAtom atom;
+    const uint8_t *ptr;
+    size_t len;
+    BOOL is_new;
+    int ret;
+
+    obj = JS_NewObject(ctx);
+    if (JS_IsException(obj))
+        return obj;
+    p = JS_VALUE_GET_OBJ(obj);
+    ptr = json_skip_space(s->ptr);
+    if (*ptr != '}') {
+        for(;;) {
+            if (*ptr != '\"')
+                goto syntax_error;
+            ptr++;
+            len = mem_json_str_len(ptr, s->buf_end - ptr);
+            if (ptr[len] == '\"') {
+                atom = json_fast_atom(s, p->shape, ptr, len, &is_new);
+                ptr += len + 1;
+            } else {
+                s->ptr = ptr;
+                key = json_fast_string(s, len);
+                if (JS_IsException(key))
+                    goto fail;
+                ptr = s->ptr;
+                atom = JS_NewAtomStr(ctx, JS_VALUE_GET_STRING(key));
+                is_new = FALSE;
+            }
+            if (atom == JS_ATOM_NULL)
+                goto fail;
+            ptr = json_skip_space(ptr);
+            if (*ptr != ':') {
+                JS_FreeAtom(ctx, atom);
+                goto syntax_error;
+            }
+            s->ptr = json_skip_space(ptr + 1);
+            val = json_fast_value(s);
+            if (JS_IsException(val)) {
+                JS_FreeAtom(ctx, atom);
+                goto fail;
+            }
+            if (!is_new && find_own_property1(p, atom)) {
+                /* duplicate key: the last value is kept */
+                ret = JS_DefinePropertyValue(ctx, obj, atom, val,
+                                             JS_PROP_C_W_E);
+            } else {
+                pr = add_property(ctx, p, atom, JS_PROP_C_W_E);
+                if (pr) {
+                    pr->u.value = val;
+                    ret = 0;
+                } else {
+                    JS_FreeValue(ctx, val);
+                    ret = -1;
+                }
+            }
+            JS_FreeAtom(ctx, atom);
+            if (ret < 0)
+                goto fail;
+            ptr = json_skip_space(s->ptr);
+            if (*ptr != ',')
+                break;
+            ptr = json_skip_space(ptr + 1);
+        }
+        if (*ptr != '}')
+            goto syntax_error;
+    }
+    s->ptr = ptr + 1;
+    return obj;
+ syntax_error:
+    s->need_slow = TRUE;
+ fail:
+    JS_FreeValue(ctx, obj);
+    return JS_EXCEPTION;
+}
+
+static JSValue json_fast_array(JSONFastParseState *s)
+{
+    JSContext *ctx = s->ctx;
+    JSValue obj, val;
+    const uint8_t *ptr;
+
+    obj = JS_NewArray(ctx);
+    if (JS_IsException(obj))
+        return obj;
+    ptr = json_skip_space(s->ptr);
+    if (*ptr != ']') {
+        for(;;) {
+            s->ptr = ptr;
+            val = json_fast_value(s);
+            if (JS_IsException(val))
+                goto fail;
+            if (add_fast_array_element(ctx, JS_VALUE_GET_OBJ(obj), val, 0) < 0)
+                goto fail;
+            ptr = json_skip_space(s->ptr);
+            if (*ptr != ',')
+                break;
+            ptr = json_skip_space(ptr + 1);
+        }
+        if (*ptr != ']') {
+            s->need_slow = TRUE;
+            goto fail;
+        }
+    }
+    s->ptr = ptr + 1;
+    return obj;
+ fail:
+    JS_FreeValue(ctx, obj);
+    return JS_EXCEPTION;
+}
+
+static BOOL json_match_literal(JSONFastParseState *s, const char *str, int len)
+{
+    const uint8_t *p = s->ptr;
+    int c;
+
+    if (s->buf_end - p < len || memcmp(p, str, len))
+        return FALSE;
+    c = p[len];
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || is_digit(c) ||
+        c == '_' || c == '$' || c >= 0x80)
+        return FALSE;
+    s->ptr = p + len;
+    return TRUE;
+}
+
+/* 's->ptr' points to the first char of the value */
+static JSValue json_fast_value(JSONFastParseState *s)
+{
+    size_t len;
+
+    switch(*s->ptr) {
+    case '{':
+        if (js_check_stack_overflow(s->ctx->rt, 0))
+            break;
+        s->ptr++;
+        return json_fast_object(s);
+    case '[':
+        if (js_check_stack_overflow(s->ctx->rt, 0))
+            break;
+        s->ptr++;
+        return json_fast_array(s);
+    case '\"':
+        s->ptr++;
+        len = mem_json_str_len(s->ptr, s->buf_end - s->ptr);
+        return json_fast_string(s, len);
+    case '-':
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+        return json_fast_number(s);
+    case 't':
+        if (json_match_literal(s, "true", 4))
+            return JS_TRUE;
+        break;
+    case 'f':
+        if (json_match_literal(s, "false", 5))
+            return JS_FALSE;
+        break;
+    case 'n':
+        if (json_match_literal(s, "null", 4))
+            return JS_NULL;
+        break;
+    default:
+        break;
+    }
+    return json_fast_syntax_error(s);
+}
+
+/* return JS_UNINITIALIZED if the input must be parsed with the slow
+   parser. 'buf[buf_len]' must be '\0'. */
+static JSValue json_parse_fast(JSContext *ctx, const uint8_t *buf,
+                               size_t buf_len)
+{
+    JSONFastParseState s_s, *s = &s_s;
+    JSValue val;
+    int i;
+
+    s->ctx = ctx;
+    s->buf_end = buf + buf_len;
+    s->need_slow = FALSE;
+    memset(s->atom_cache, 0, sizeof(s->atom_cache));
+    s->ptr = json_skip_space(buf);
+    val = json_fast_value(s);
+    if (!JS_IsException(val)) {
+        s->ptr = json_skip_space(s->ptr);
+        if (s->ptr != s->buf_end) {
+            JS_FreeValue(ctx, val);
+            val = JS_EXCEPTION;
+            s->need_slow = TRUE;
+        }
+    }
+    for(i = 0; i < JSON_ATOM_CACHE_SIZE; i++)
+        JS_FreeAtom(ctx, s->atom_cache[i]);
+    if (s->need_slow)
+        return JS_UNINITIALIZED;
+    return val;
+}
+
 JSValue JS_ParseJSON2(JSContext *ctx, const char *buf, size_t buf_len,
                       const char *filename, int flags)
 {
     JSParseState s1, *s = &s1;
     JSValue val = JS_UNDEFINED;
 
+    if (!(flags & JS_PARSE_JSON_EXT)) {
+        val = json_parse_fast(ctx, (const uint8_t *)buf, buf_len);
+        if (!JS_IsUninitialized(val))
+            return val;
+        val = JS_UNDEFINED;
+    }
     js_parse_init(ctx, s, buf, buf_len, filename);
     s->ext_json = ((flags & JS_PARSE_JSON_EXT) != 0);
     if (json_next_token(s))
@@ -46521,6 +53781,622 @@ JSValue JS_ParseJSON(JSContext *ctx, const char *buf, size_t buf_len,
     return JS_ParseJSON2(ctx, buf, buf_len, filename, 0);
 }
 
+/* Streaming JSON parser: the input is given in chunks and the values
+   at depth 'emit_depth' are passed to a callback. The enclosing
+   arrays and objects are only validated, so the memory usage does
+   not depend on the document size. */
+
+typedef enum {
+    JSON_LEX_SPACE,   /* between tokens */
+    JSON_LEX_STRING,
+    JSON_LEX_ESCAPE,  /* after '\' */
+    JSON_LEX_UNICODE, /* in a \uXXXX escape */
+    JSON_LEX_UTF8,    /* in a multi-byte UTF-8 sequence */
+    JSON_LEX_NUMBER,
+    JSON_LEX_LITERAL, /* true, false or null */
+    JSON_LEX_DONE,    /* after an error or the end of input */
+} JSONLexStateEnum;
+
+typedef enum {
+    JSON_EXPECT_VALUE,
+    JSON_EXPECT_VALUE_OR_END, /* after '[' */
+    JSON_EXPECT_KEY,
+    JSON_EXPECT_KEY_OR_END,   /* after '{' */
+    JSON_EXPECT_COLON,
+    JSON_EXPECT_COMMA_OR_END,
+    JSON_EXPECT_EOF,
+} JSONExpectEnum;
+
+typedef struct {
+    uint8_t is_object;
+    uint8_t expect; /* JSONExpectEnum */
+    uint32_t idx; /* current array index */
+    JSAtom key; /* current property name */
+    JSValue obj; /* JS_UNDEFINED above the emit depth */
+} JSONParserFrame;
+
+struct JSJSONParser {
+    JSRuntime *rt;
+    JSContext *ctx;
+    int emit_depth;
+    int flags;
+    JSJSONParserFunc *func;
+    void *opaque;
+    uint8_t lex_state; /* JSONLexStateEnum */
+    uint8_t expect; /* JSONExpectEnum at the top level */
+    BOOL is_key; /* the current string is a property name */
+    BOOL in_callback;
+    uint32_t lex_val; /* escape or UTF-8 sequence being decoded */
+    uint32_t lex_min; /* minimum value of the UTF-8 sequence */
+    int lex_len; /* remaining characters in the escape or sequence */
+    StringBuffer sb; /* current string */
+    DynBuf tok; /* current number or literal */
+    JSONParserFrame *stack;
+    int stack_len;
+    int stack_size;
+    int64_t pos; /* absolute position of the current chunk */
+    int64_t tok_pos; /* absolute position of the current token */
+    int64_t line_start; /* absolute position of the current line */
+    int line_num;
+};
+
+static int __attribute__((format(printf, 3, 4)))
+json_parser_error(JSJSONParser *p, int64_t pos, const char *fmt, ...)
+{
+    JSContext *ctx = p->ctx;
+    va_list ap;
+
+    va_start(ap, fmt);
+    JS_ThrowError2(ctx, JS_SYNTAX_ERROR, fmt, ap, FALSE);
+    va_end(ap);
+    build_backtrace(ctx, ctx->rt->current_exception, "<input>",
+                    p->line_num + 1, (int)(pos - p->line_start) + 1, 0);
+    return -1;
+}
+
+JSJSONParser *JS_NewJSONParser(JSContext *ctx, int emit_depth, int flags,
+                               JSJSONParserFunc *func, void *opaque)
+{
+    JSJSONParser *p;
+
+    if (emit_depth < 0) {
+        JS_ThrowRangeError(ctx, "invalid depth");
+        return NULL;
+    }
+    p = js_mallocz(ctx, sizeof(*p));
+    if (!p)
+        return NULL;
+    p->rt = ctx->rt;
+    p->ctx = ctx;
+    p->emit_depth = emit_depth;
+    p->flags = flags;
+    p->func = func;
+    p->opaque = opaque;
+    p->lex_state = JSON_LEX_SPACE;
+    p->expect = JSON_EXPECT_VALUE;
+    js_dbuf_init(ctx, &p->tok);
+    return p;
+}
+
+/* may be called from a finalizer */
+void JS_FreeJSONParser(JSJSONParser *p)
+{
+    JSRuntime *rt = p->rt;
+    int i;
+
+    for(i = 0; i < p->stack_len; i++) {
+        JS_FreeAtomRT(rt, p->stack[i].key);
+        JS_FreeValueRT(rt, p->stack[i].obj);
+    }
+    js_free_rt(rt, p->stack);
+    js_free_rt(rt, p->sb.str);
+    dbuf_free(&p->tok);
+    js_free_rt(rt, p);
+}
+
+static uint8_t *json_parser_expect(JSJSONParser *p)
+{
+    if (p->stack_len == 0)
+        return &p->expect;
+    else
+        return &p->stack[p->stack_len - 1].expect;
+}
+
+static int json_parser_unexpected(JSJSONParser *p, int64_t pos, int c)
+{
+    if (c < 0)
+        return json_parser_error(p, pos, "Unexpected end of JSON input");
+    else if (*json_parser_expect(p) == JSON_EXPECT_EOF)
+        return json_parser_error(p, pos, "unexpected data at the end");
+    else if (c >= 0x20 && c < 0x7f)
+        return json_parser_error(p, pos, "unexpected token: '%c'", c);
+    else
+        return json_parser_error(p, pos, "unexpected character");
+}
+
+/* a value is complete at the current depth */
+static int json_parser_value(JSJSONParser *p, JSValue val)
+{
+    JSContext *ctx = p->ctx;
+    JSONParserFrame *f;
+    JSValue key;
+    int depth, ret;
+
+    depth = p->stack_len;
+    f = depth > 0 ? &p->stack[depth - 1] : NULL;
+    if (depth > p->emit_depth) {
+        if (f->is_object)
+            ret = JS_DefinePropertyValue(ctx, f->obj, f->key, val,
+                                         JS_PROP_C_W_E);
+        else
+            ret = JS_DefinePropertyValueUint32(ctx, f->obj, f->idx, val,
+                                               JS_PROP_C_W_E);
+        if (ret < 0)
+            return -1;
+    } else if (depth == p->emit_depth) {
+        if (!f)
+            key = JS_UNDEFINED;
+        else if (f->is_object)
+            key = JS_AtomToString(ctx, f->key);
+        else
+            key = JS_NewUint32(ctx, f->idx);
+        if (JS_IsException(key)) {
+            JS_FreeValue(ctx, val);
+            return -1;
+        }
+        p->in_callback = TRUE;
+        ret = p->func(ctx, key, val, p->opaque);
+        p->in_callback = FALSE;
+        JS_FreeValue(ctx, key);
+        JS_FreeValue(ctx, val);
+        if (ret < 0)
+            return -1;
+    } else {
+        JS_FreeValue(ctx, val);
+    }
+    if (f) {
+        f->expect = JSON_EXPECT_COMMA_OR_END;
+    } else if (p->flags & JS_JSON_PARSER_MULTI) {
+        p->expect = JSON_EXPECT_VALUE;
+    } else {
+        p->expect = JSON_EXPECT_EOF;
+    }
+    return 0;
+}
+
+static int json_parser_open(JSJSONParser *p, BOOL is_object)
+{
+    JSContext *ctx = p->ctx;
+    JSONParserFrame *f;
+    JSValue obj;
+
+    if (p->stack_len >= p->emit_depth) {
+        if (is_object)
+            obj = JS_NewObject(ctx);
+        else
+            obj = JS_NewArray(ctx);
+        if (JS_IsException(obj))
+            return -1;
+    } else {
+        obj = JS_UNDEFINED;
+    }
+    if (js_resize_array(ctx, (void **)&p->stack, sizeof(p->stack[0]),
+                        &p->stack_size, p->stack_len + 1)) {
+        JS_FreeValue(ctx, obj);
+        return -1;
+    }
+    f = &p->stack[p->stack_len++];
+    f->is_object = is_object;
+    f->expect = is_object ? JSON_EXPECT_KEY_OR_END : JSON_EXPECT_VALUE_OR_END;
+    f->idx = 0;
+    f->key = JS_ATOM_NULL;
+    f->obj = obj;
+    return 0;
+}
+
+static int json_parser_close(JSJSONParser *p)
+{
+    JSONParserFrame *f;
+
+    f = &p->stack[--p->stack_len];
+    JS_FreeAtom(p->ctx, f->key);
+    return json_parser_value(p, f->obj);
+}
+
+static BOOL json_is_number(const uint8_t *p, const uint8_t *end)
+{
+    if (p < end && *p == '-')
+        p++;
+    if (p < end && *p == '0') {
+        p++;
+    } else {
+        if (p >= end || !is_digit(*p))
+            return FALSE;
+        while (p < end && is_digit(*p))
+            p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        if (p >= end || !is_digit(*p))
+            return FALSE;
+        while (p < end && is_digit(*p))
+            p++;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < end && (*p == '+' || *p == '-'))
+            p++;
+        if (p >= end || !is_digit(*p))
+            return FALSE;
+        while (p < end && is_digit(*p))
+            p++;
+    }
+    return p == end;
+}
+
+static inline BOOL json_is_number_char(int c)
+{
+    return is_digit(c) || c == '-' || c == '+' || c == '.' ||
+        c == 'e' || c == 'E';
+}
+
+static inline BOOL json_is_literal_char(int c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        is_digit(c) || c == '_' || c == '$';
+}
+
+/* 'buf[len]' must not be a number character */
+static int json_parser_number(JSJSONParser *p, const uint8_t *buf, size_t len)
+{
+    JSATODTempMem atod_mem;
+    double d;
+
+    if (!json_is_number(buf, buf + len))
+        return json_parser_error(p, p->tok_pos, "invalid number");
+    d = js_atod((const char *)buf, NULL, 10, 0, &atod_mem);
+    return json_parser_value(p, JS_NewFloat64(p->ctx, d));
+}
+
+static int json_parser_literal(JSJSONParser *p, const uint8_t *buf, size_t len)
+{
+    JSValue val;
+
+    if (len == 4 && !memcmp(buf, "true", 4)) {
+        val = JS_TRUE;
+    } else if (len == 5 && !memcmp(buf, "false", 5)) {
+        val = JS_FALSE;
+    } else if (len == 4 && !memcmp(buf, "null", 4)) {
+        val = JS_NULL;
+    } else {
+        return json_parser_error(p, p->tok_pos, "unexpected token: '%.*s'",
+                                 (int)min_int(len, 32), buf);
+    }
+    return json_parser_value(p, val);
+}
+
+/* end of a number or literal split across chunks */
+static int json_parser_token_end(JSJSONParser *p)
+{
+    int ret;
+
+    if (dbuf_putc(&p->tok, '\0'))
+        return -1;
+    if (p->lex_state == JSON_LEX_NUMBER)
+        ret = json_parser_number(p, p->tok.buf, p->tok.size - 1);
+    else
+        ret = json_parser_literal(p, p->tok.buf, p->tok.size - 1);
+    p->tok.size = 0;
+    p->lex_state = JSON_LEX_SPACE;
+    return ret;
+}
+
+static int json_parser_string_end(JSJSONParser *p)
+{
+    JSContext *ctx = p->ctx;
+    JSONParserFrame *f;
+    JSValue val;
+    JSAtom atom;
+
+    p->lex_state = JSON_LEX_SPACE;
+    val = string_buffer_end(&p->sb);
+    if (JS_IsException(val))
+        return -1;
+    if (!p->is_key)
+        return json_parser_value(p, val);
+    atom = JS_NewAtomStr(ctx, JS_VALUE_GET_STRING(val));
+    if (atom == JS_ATOM_NULL)
+        return -1;
+    f = &p->stack[p->stack_len - 1];
+    JS_FreeAtom(ctx, f->key);
+    f->key = atom;
+    f->expect = JSON_EXPECT_COLON;
+    return 0;
+}
+
+static int json_parser_feed(JSJSONParser *p, const uint8_t *buf, size_t len)
+{
+    const uint8_t *ptr, *end, *p0;
+    JSONParserFrame *f;
+    uint8_t *pexpect;
+    uint32_t c;
+    int h;
+
+#define POS(ptr) (p->pos + ((ptr) - buf))
+
+    ptr = buf;
+    end = buf + len;
+    while (ptr < end) {
+        switch(p->lex_state) {
+        case JSON_LEX_SPACE:
+            c = *ptr;
+            if (c == ' ' || c == '\t' || c == '\r') {
+                ptr++;
+                break;
+            }
+            if (c == '\n') {
+                ptr++;
+                p->line_num++;
+                p->line_start = POS(ptr);
+                break;
+            }
+            p->tok_pos = POS(ptr);
+            pexpect = json_parser_expect(p);
+            switch(c) {
+            case '\"':
+                if (*pexpect == JSON_EXPECT_KEY ||
+                    *pexpect == JSON_EXPECT_KEY_OR_END) {
+                    p->is_key = TRUE;
+                } else if (*pexpect == JSON_EXPECT_VALUE ||
+                           *pexpect == JSON_EXPECT_VALUE_OR_END) {
+                    p->is_key = FALSE;
+                } else {
+                    goto unexpected;
+                }
+                if (string_buffer_init(p->ctx, &p->sb, 16))
+                    return -1;
+                p->lex_state = JSON_LEX_STRING;
+                ptr++;
+                break;
+            case '{':
+            case '[':
+                if (*pexpect != JSON_EXPECT_VALUE &&
+                    *pexpect != JSON_EXPECT_VALUE_OR_END)
+                    goto unexpected;
+                if (json_parser_open(p, c == '{'))
+                    return -1;
+                ptr++;
+                break;
+            case '}':
+            case ']':
+                if (p->stack_len == 0)
+                    goto unexpected;
+                f = &p->stack[p->stack_len - 1];
+                if (f->is_object != (c == '}') ||
+                    (f->expect != JSON_EXPECT_COMMA_OR_END &&
+                     f->expect != JSON_EXPECT_KEY_OR_END &&
+                     f->expect != JSON_EXPECT_VALUE_OR_END))
+                    goto unexpected;
+                if (json_parser_close(p))
+                    return -1;
+                ptr++;
+                break;
+            case ':':
+                if (*pexpect != JSON_EXPECT_COLON)
+                    goto unexpected;
+                *pexpect = JSON_EXPECT_VALUE;
+                ptr++;
+                break;
+            case ',':
+                if (*pexpect != JSON_EXPECT_COMMA_OR_END)
+                    goto unexpected;
+                f = &p->stack[p->stack_len - 1];
+                if (f->is_object) {
+                    f->expect = JSON_EXPECT_KEY;
+                } else {
+                    f->expect = JSON_EXPECT_VALUE;
+                    f->idx++;
+                }
+                ptr++;
+                break;
+            default:
+                if (*pexpect != JSON_EXPECT_VALUE &&
+                    *pexpect != JSON_EXPECT_VALUE_OR_END)
+                    goto unexpected;
+                if (c == '-' || is_digit(c)) {
+                    p->lex_state = JSON_LEX_NUMBER;
+                } else if (c >= 'a' && c <= 'z') {
+                    p->lex_state = JSON_LEX_LITERAL;
+                } else {
+                unexpected:
+                    return json_parser_unexpected(p, POS(ptr), c);
+                }
+                /* fast path when the token is not split */
+                p0 = ptr++;
+                if (p->lex_state == JSON_LEX_NUMBER) {
+                    while (ptr < end && json_is_number_char(*ptr))
+                        ptr++;
+                    if (ptr < end) {
+                        p->lex_state = JSON_LEX_SPACE;
+                        if (json_parser_number(p, p0, ptr - p0))
+                            return -1;
+                        break;
+                    }
+                } else {
+                    while (ptr < end && json_is_literal_char(*ptr))
+                        ptr++;
+                    if (ptr < end) {
+                        p->lex_state = JSON_LEX_SPACE;
+                        if (json_parser_literal(p, p0, ptr - p0))
+                            return -1;
+                        break;
+                    }
+                }
+                if (dbuf_put(&p->tok, p0, ptr - p0))
+                    return -1;
+                break;
+            }
+            break;
+        case JSON_LEX_NUMBER:
+        case JSON_LEX_LITERAL:
+            p0 = ptr;
+            if (p->lex_state == JSON_LEX_NUMBER) {
+                while (ptr < end && json_is_number_char(*ptr))
+                    ptr++;
+            } else {
+                while (ptr < end && json_is_literal_char(*ptr))
+                    ptr++;
+            }
+            if (dbuf_put(&p->tok, p0, ptr - p0))
+                return -1;
+            if (ptr < end) {
+                if (json_parser_token_end(p))
+                    return -1;
+            }
+            break;
+        case JSON_LEX_STRING:
+            p0 = ptr;
+            ptr += mem_json_str_len(ptr, end - ptr);
+            if (ptr > p0) {
+                if (string_buffer_write8(&p->sb, p0, ptr - p0))
+                    return -1;
+            }
+            if (ptr >= end)
+                break;
+            c = *ptr++;
+            if (c == '\"') {
+                if (json_parser_string_end(p))
+                    return -1;
+            } else if (c == '\\') {
+                p->lex_state = JSON_LEX_ESCAPE;
+            } else if (c < 0x20) {
+                return json_parser_error(p, POS(ptr - 1), "Bad control character in string literal");
+            } else {
+                if (c >= 0xc2 && c <= 0xdf) {
+                    p->lex_val = c & 0x1f;
+                    p->lex_len = 1;
+                    p->lex_min = 0x80;
+                } else if (c >= 0xe0 && c <= 0xef) {
+                    p->lex_val = c & 0x0f;
+                    p->lex_len = 2;
+                    p->lex_min = 0x800;
+                } else if (c >= 0xf0 && c <= 0xf4) {
+                    p->lex_val = c & 0x07;
+                    p->lex_len = 3;
+                    p->lex_min = 0x10000;
+                } else {
+                    goto bad_utf8;
+                }
+                p->lex_state = JSON_LEX_UTF8;
+            }
+            break;
+        case JSON_LEX_UTF8:
+            c = *ptr++;
+            if ((c & 0xc0) != 0x80) {
+            bad_utf8:
+                return json_parser_error(p, POS(ptr - 1), "Bad UTF-8 sequence");
+            }
+            p->lex_val = (p->lex_val << 6) | (c & 0x3f);
+            if (--p->lex_len == 0) {
+                if (p->lex_val < p->lex_min || p->lex_val > 0x10FFFF)
+                    goto bad_utf8;
+                if (string_buffer_putc(&p->sb, p->lex_val))
+                    return -1;
+                p->lex_state = JSON_LEX_STRING;
+            }
+            break;
+        case JSON_LEX_ESCAPE:
+            c = *ptr++;
+            switch(c) {
+            case 'b':   c = '\b'; break;
+            case 'f':   c = '\f'; break;
+            case 'n':   c = '\n'; break;
+            case 'r':   c = '\r'; break;
+            case 't':   c = '\t'; break;
+            case '\\':  break;
+            case '/':   break;
+            case '\"':  break;
+            case 'u':
+                p->lex_val = 0;
+                p->lex_len = 4;
+                p->lex_state = JSON_LEX_UNICODE;
+                continue;
+            default:
+                return json_parser_error(p, POS(ptr - 1), "Bad escaped character");
+            }
+            if (string_buffer_putc8(&p->sb, c))
+                return -1;
+            p->lex_state = JSON_LEX_STRING;
+            break;
+        case JSON_LEX_UNICODE:
+            h = from_hex(*ptr++);
+            if (h < 0)
+                return json_parser_error(p, POS(ptr - 1), "Bad Unicode escape");
+            p->lex_val = (p->lex_val << 4) | h;
+            if (--p->lex_len == 0) {
+                if (string_buffer_putc16(&p->sb, p->lex_val))
+                    return -1;
+                p->lex_state = JSON_LEX_STRING;
+            }
+            break;
+        default:
+            abort();
+        }
+    }
+#undef POS
+    p->pos += len;
+    return 0;
+}
+
+static int json_parser_check(JSJSONParser *p)
+{
+    if (p->in_callback) {
+        JS_ThrowTypeError(p->ctx, "JSON parser is busy");
+        return -1;
+    }
+    if (p->lex_state == JSON_LEX_DONE) {
+        JS_ThrowTypeError(p->ctx, "JSON parser is closed");
+        return -1;
+    }
+    return 0;
+}
+
+int JS_JSONParserFeed(JSJSONParser *p, const uint8_t *buf, size_t len)
+{
+    if (json_parser_check(p))
+        return -1;
+    if (json_parser_feed(p, buf, len)) {
+        p->lex_state = JSON_LEX_DONE;
+        return -1;
+    }
+    return 0;
+}
+
+int JS_JSONParserEnd(JSJSONParser *p)
+{
+    int ret = 0;
+
+    if (json_parser_check(p))
+        return -1;
+    switch(p->lex_state) {
+    case JSON_LEX_NUMBER:
+    case JSON_LEX_LITERAL:
+        ret = json_parser_token_end(p);
+        break;
+    case JSON_LEX_SPACE:
+        break;
+    default:
+        ret = json_parser_error(p, p->pos, "Unexpected end of JSON input");
+        break;
+    }
+    if (ret == 0 && (p->stack_len != 0 ||
+                     (p->expect == JSON_EXPECT_VALUE &&
+                      !(p->flags & JS_JSON_PARSER_MULTI)))) {
+        ret = json_parser_error(p, p->pos, "Unexpected end of JSON input");
+    }
+    p->lex_state = JSON_LEX_DONE;
+    return ret;
+}
 static JSValue internalize_json_property(JSContext *ctx, JSValueConst holder,
                                          JSAtom name, JSValueConst reviver)
 {
@@ -46624,22 +54500,68 @@ static JSValue js_json_parse(JSContext *ctx, JSValueConst this_val,
     return obj;
 }
 
+#define JSON_KEY_CACHE_SIZE 128 /* must be a power of two */
+
+typedef struct {
+    JSAtom atom;
+    JSValue str; /* quoted key followed by ':' */
+} JSONKeyCacheEntry;
+
 typedef struct JSONStringifyContext {
     JSValueConst replacer_func;
-    JSValue stack;
+    JSObject **stack; /* objects being serialized */
+    int stack_len;
+    int stack_size;
     JSValue property_list;
     JSValue gap;
     JSValue empty;
+    BOOL fast_ok; /* no replacer and no gap */
     StringBuffer *b;
+    JSONKeyCacheEntry key_cache[JSON_KEY_CACHE_SIZE];
 } JSONStringifyContext;
 
+static int js_json_quote_char(StringBuffer *b, uint32_t c)
+{
+    char buf[16];
+
+    switch(c) {
+    case '\t':
+        c = 't';
+        goto quote;
+    case '\r':
+        c = 'r';
+        goto quote;
+    case '\n':
+        c = 'n';
+        goto quote;
+    case '\b':
+        c = 'b';
+        goto quote;
+    case '\f':
+        c = 'f';
+        goto quote;
+    case '\"':
+    case '\\':
+    quote:
+        if (string_buffer_putc8(b, '\\'))
+            return -1;
+        return string_buffer_putc8(b, c);
+    default:
+        if (c < 32 || is_surrogate(c)) {
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            return string_buffer_puts8(b, buf);
+        } else {
+            return string_buffer_putc(b, c);
+        }
+    }
+}
+
 static int JS_ToQuotedString(JSContext *ctx, StringBuffer *b, JSValueConst val1)
 {
     JSValue val;
     JSString *p;
-    int i;
+    int i, n;
     uint32_t c;
-    char buf[16];
 
     val = JS_ToStringCheckObject(ctx, val1);
     if (JS_IsException(val))
@@ -46648,42 +54570,29 @@ static int JS_ToQuotedString(JSContext *ctx, StringBuffer *b, JSValueConst val1)
 
     if (string_buffer_putc8(b, '\"'))
         goto fail;
-    for(i = 0; i < p->len; ) {
-        c = string_getc(p, &i);
-        switch(c) {
-        case '\t':
-            c = 't';
-            goto quote;
-        case '\r':
-            c = 'r';
-            goto quote;
-        case '\n':
-            c = 'n';
-            goto quote;
-        case '\b':
-            c = 'b';
-            goto quote;
-        case '\f':
-            c = 'f';
-            goto quote;
-        case '\"':
-        case '\\':
-        quote:
-            if (string_buffer_putc8(b, '\\'))
-                goto fail;
-            if (string_buffer_putc8(b, c))
+    if (!p->is_wide_char) {
+        /* copy the runs of chars which need no quoting */
+        for(i = 0; i < p->len; i++) {
+            n = mem_json_str_len(p->u.str8 + i, p->len - i);
+            if (string_buffer_write8(b, p->u.str8 + i, n))
                 goto fail;
-            break;
-        default:
-            if (c < 32 || is_surrogate(c)) {
-                snprintf(buf, sizeof(buf), "\\u%04x", c);
-                if (string_buffer_puts8(b, buf))
+            i += n;
+            if (i >= p->len)
+                break;
+            c = p->u.str8[i];
+            if (c >= 0x80) {
+                if (string_buffer_putc8(b, c))
                     goto fail;
             } else {
-                if (string_buffer_putc(b, c))
+                if (js_json_quote_char(b, c))
                     goto fail;
             }
-            break;
+        }
+    } else {
+        for(i = 0; i < p->len; ) {
+            c = string_getc(p, &i);
+            if (js_json_quote_char(b, c))
+                goto fail;
         }
     }
     if (string_buffer_putc8(b, '\"'))
@@ -46759,6 +54668,219 @@ exception:
     return JS_EXCEPTION;
 }
 
+static int js_json_push(JSContext *ctx, JSONStringifyContext *jsc, JSObject *p)
+{
+    int i;
+
+    for(i = 0; i < jsc->stack_len; i++) {
+        if (jsc->stack[i] == p) {
+            JS_ThrowTypeError(ctx, "circular reference");
+            return -1;
+        }
+    }
+    if (js_resize_array(ctx, (void **)&jsc->stack, sizeof(jsc->stack[0]),
+                        &jsc->stack_size, jsc->stack_len + 1))
+        return -1;
+    jsc->stack[jsc->stack_len++] = p;
+    return 0;
+}
+
+/* Fast path when there is no replacer and no gap: the properties of
+   the ordinary objects are read directly from their shape. */
+
+static int js_json_to_str(JSContext *ctx, JSONStringifyContext *jsc,
+                          JSValueConst holder, JSValue val,
+                          JSValueConst indent);
+
+/* return TRUE if no 'toJSON' property can be found in 'p' or its
+   prototypes without side effect */
+static BOOL js_json_is_plain(JSObject *p)
+{
+    for(;;) {
+        if (p->class_id != JS_CLASS_OBJECT && p->class_id != JS_CLASS_ARRAY)
+            return FALSE;
+        if (find_own_property1(p, JS_ATOM_toJSON))
+            return FALSE;
+        p = p->shape->proto;
+        if (!p)
+            return TRUE;
+    }
+}
+
+/* return TRUE if the fast path can be used for 'p' */
+static BOOL js_json_is_fast(JSContext *ctx, JSObject *p)
+{
+    JSShapeProperty *prs;
+    uint32_t idx;
+    int i;
+
+    if (!js_json_is_plain(p))
+        return FALSE;
+    if (p->class_id == JS_CLASS_OBJECT) {
+        /* the array index keys come first in the enumeration order */
+        prs = get_shape_prop(p->shape);
+        for(i = 0; i < p->shape->prop_count; i++, prs++) {
+            if (prs->atom != JS_ATOM_NULL &&
+                JS_AtomIsArrayIndex(ctx, &idx, prs->atom))
+                return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/* output '"key":' */
+static int js_json_put_key(JSContext *ctx, JSONStringifyContext *jsc,
+                           JSAtom atom)
+{
+    JSONKeyCacheEntry *e;
+    StringBuffer b_s, *b = &b_s;
+    JSValue str;
+    JSString *p;
+
+    e = &jsc->key_cache[atom & (JSON_KEY_CACHE_SIZE - 1)];
+    if (e->atom != atom) {
+        str = JS_AtomToString(ctx, atom);
+        if (JS_IsException(str))
+            return -1;
+        string_buffer_init(ctx, b, 16);
+        if (JS_ToQuotedString(ctx, b, str) || string_buffer_putc8(b, ':')) {
+            JS_FreeValue(ctx, str);
+            string_buffer_free(b);
+            return -1;
+        }
+        JS_FreeValue(ctx, str);
+        str = string_buffer_end(b);
+        if (JS_IsException(str))
+            return -1;
+        JS_FreeAtom(ctx, e->atom);
+        JS_FreeValue(ctx, e->str);
+        e->atom = JS_DupAtom(ctx, atom);
+        e->str = str;
+    }
+    p = JS_VALUE_GET_STRING(e->str);
+    return string_buffer_concat(jsc->b, p, 0, p->len);
+}
+
+/* output the property 'atom' (or the element 'idx' if atom =
+   JS_ATOM_NULL) of 'holder' whose value is 'v'. */
+static int js_json_put_prop(JSContext *ctx, JSONStringifyContext *jsc,
+                            JSValueConst holder, JSValue v,
+                            JSAtom atom, int64_t idx, BOOL *phas_content)
+{
+    JSValue key;
+
+    switch(JS_VALUE_GET_NORM_TAG(v)) {
+    case JS_TAG_OBJECT:
+        if (js_json_is_plain(JS_VALUE_GET_OBJ(v)))
+            break;
+        /* fall through */
+    case JS_TAG_SHORT_BIG_INT:
+    case JS_TAG_BIG_INT:
+        /* generic case: may call toJSON() */
+        if (atom != JS_ATOM_NULL)
+            key = JS_AtomToString(ctx, atom);
+        else
+            key = JS_ToStringFree(ctx, JS_NewInt64(ctx, idx));
+        if (JS_IsException(key)) {
+            JS_FreeValue(ctx, v);
+            return -1;
+        }
+        v = js_json_check(ctx, jsc, holder, v, key);
+        JS_FreeValue(ctx, key);
+        if (JS_IsException(v))
+            return -1;
+        break;
+    case JS_TAG_UNDEFINED:
+    case JS_TAG_SYMBOL:
+        JS_FreeValue(ctx, v);
+        v = JS_UNDEFINED;
+        break;
+    default:
+        break;
+    }
+    if (atom == JS_ATOM_NULL) {
+        if (JS_IsUndefined(v))
+            v = JS_NULL;
+    } else {
+        if (JS_IsUndefined(v))
+            return 0;
+        if (*phas_content)
+            string_buffer_putc8(jsc->b, ',');
+        if (js_json_put_key(ctx, jsc, atom)) {
+            JS_FreeValue(ctx, v);
+            return -1;
+        }
+        *phas_content = TRUE;
+    }
+    return js_json_to_str(ctx, jsc, holder, v, jsc->empty);
+}
+
+/* 'val' is an ordinary object or an array such as js_json_is_fast()
+   is TRUE */
+static int js_json_to_str_fast(JSContext *ctx, JSONStringifyContext *jsc,
+                               JSValueConst val)
+{
+    JSObject *p = JS_VALUE_GET_OBJ(val);
+    JSShape *sh;
+    JSShapeProperty *prs;
+    JSValue v;
+    int64_t i, len;
+    BOOL has_content;
+
+    if (js_json_push(ctx, jsc, p))
+        return -1;
+    if (p->class_id == JS_CLASS_ARRAY) {
+        if (js_get_length64(ctx, &len, val))
+            return -1;
+        string_buffer_putc8(jsc->b, '[');
+        for(i = 0; i < len; i++) {
+            if (i > 0)
+                string_buffer_putc8(jsc->b, ',');
+            /* the array may be modified by a toJSON() method */
+            if (likely(p->fast_array && i < p->u.array.count)) {
+                v = js_array_get_element(ctx, p, i);
+            } else {
+                v = JS_GetPropertyInt64(ctx, val, i);
+                if (JS_IsException(v))
+                    return -1;
+            }
+            if (js_json_put_prop(ctx, jsc, val, v, JS_ATOM_NULL, i, NULL))
+                return -1;
+        }
+        string_buffer_putc8(jsc->b, ']');
+    } else {
+        /* keep the initial shape to enumerate the keys even if the
+           object is modified by a toJSON() method */
+        sh = js_dup_shape(p->shape);
+        string_buffer_putc8(jsc->b, '{');
+        has_content = FALSE;
+        prs = get_shape_prop(sh);
+        for(i = 0; i < sh->prop_count; i++, prs++) {
+            if (prs->atom == JS_ATOM_NULL ||
+                !(prs->flags & JS_PROP_ENUMERABLE) ||
+                !JS_AtomIsString(ctx, prs->atom))
+                continue;
+            if (likely(p->shape == sh &&
+                       (prs->flags & JS_PROP_TMASK) == JS_PROP_NORMAL)) {
+                v = JS_DupValue(ctx, p->prop[i].u.value);
+            } else {
+                v = JS_GetProperty(ctx, val, prs->atom);
+                if (JS_IsException(v))
+                    goto fail;
+            }
+            if (js_json_put_prop(ctx, jsc, val, v, prs->atom, 0, &has_content))
+                goto fail;
+        }
+        js_free_shape(ctx->rt, sh);
+        string_buffer_putc8(jsc->b, '}');
+    }
+    jsc->stack_len--;
+    return 0;
+ fail:
+    js_free_shape(ctx->rt, sh);
+    return -1;
+}
+
 static int js_json_to_str(JSContext *ctx, JSONStringifyContext *jsc,
                           JSValueConst holder, JSValue val,
                           JSValueConst indent)
@@ -46783,6 +54905,11 @@ static int js_json_to_str(JSContext *ctx, JSONStringifyContext *jsc,
     if (JS_IsObject(val)) {
         p = JS_VALUE_GET_OBJ(val);
         cl = p->class_id;
+        if (jsc->fast_ok && js_json_is_fast(ctx, p)) {
+            ret = js_json_to_str_fast(ctx, jsc, val);
+            JS_FreeValue(ctx, val);
+            return ret;
+        }
         if (cl == JS_CLASS_STRING) {
             val = JS_ToStringFree(ctx, val);
             if (JS_IsException(val))
@@ -46799,13 +54926,8 @@ static int js_json_to_str(JSContext *ctx, JSONStringifyContext *jsc,
             set_value(ctx, &val, JS_DupValue(ctx, p->u.object_data));
             goto concat_primitive;
         }
-        v = js_array_includes(ctx, jsc->stack, 1, (JSValueConst *)&val);
-        if (JS_IsException(v))
+        if (js_json_push(ctx, jsc, p))
             goto exception;
-        if (JS_ToBoolFree(ctx, v)) {
-            JS_ThrowTypeError(ctx, "circular reference");
-            goto exception;
-        }
         indent1 = JS_ConcatString(ctx, JS_DupValue(ctx, indent), JS_DupValue(ctx, jsc->gap));
         if (JS_IsException(indent1))
             goto exception;
@@ -46820,9 +54942,6 @@ static int js_json_to_str(JSContext *ctx, JSONStringifyContext *jsc,
             sep = JS_DupValue(ctx, jsc->empty);
             sep1 = JS_DupValue(ctx, jsc->empty);
         }
-        v = js_array_push(ctx, jsc->stack, 1, (JSValueConst *)&val, 0);
-        if (check_exception_free(ctx, v))
-            goto exception;
         ret = JS_IsArray(ctx, val);
         if (ret < 0)
             goto exception;
@@ -46899,8 +55018,7 @@ static int js_json_to_str(JSContext *ctx, JSONStringifyContext *jsc,
             }
             string_buffer_putc8(jsc->b, '}');
         }
-        if (check_exception_free(ctx, js_array_pop(ctx, jsc->stack, 0, NULL, 0)))
-            goto exception;
+        jsc->stack_len--;
         JS_FreeValue(ctx, val);
         JS_FreeValue(ctx, tab);
         JS_FreeValue(ctx, sep);
@@ -46915,15 +55033,25 @@ static int js_json_to_str(JSContext *ctx, JSONStringifyContext *jsc,
     case JS_TAG_STRING_ROPE:
         return JS_ToQuotedStringFree(ctx, jsc->b, val);
     case JS_TAG_FLOAT64:
-        if (!isfinite(JS_VALUE_GET_FLOAT64(val))) {
-            val = JS_NULL;
+        {
+            JSDTOATempMem dtoa_mem;
+            char buf[64];
+            double d = JS_VALUE_GET_FLOAT64(val);
+            if (!isfinite(d))
+                return string_buffer_puts8(jsc->b, "null");
+            len = js_dtoa(buf, d, 10, 0, JS_DTOA_FORMAT_FREE, &dtoa_mem);
+            return string_buffer_write8(jsc->b, (uint8_t *)buf, len);
         }
-        goto concat_value;
     case JS_TAG_INT:
+        {
+            char buf[16];
+            len = i32toa(buf, JS_VALUE_GET_INT(val));
+            return string_buffer_write8(jsc->b, (uint8_t *)buf, len);
+        }
     case JS_TAG_BOOL:
+        return string_buffer_puts8(jsc->b, JS_VALUE_GET_BOOL(val) ? "true" : "false");
     case JS_TAG_NULL:
-    concat_value:
-        return string_buffer_concat_value_free(jsc->b, val);
+        return string_buffer_puts8(jsc->b, "null");
     case JS_TAG_SHORT_BIG_INT:
     case JS_TAG_BIG_INT:
         /* reject big numbers: use toJSON method to override */
@@ -46954,7 +55082,9 @@ JSValue JS_JSONStringify(JSContext *ctx, JSValueConst obj,
     int64_t i, j, n;
 
     jsc->replacer_func = JS_UNDEFINED;
-    jsc->stack = JS_UNDEFINED;
+    jsc->stack = NULL;
+    jsc->stack_len = 0;
+    jsc->stack_size = 0;
     jsc->property_list = JS_UNDEFINED;
     jsc->gap = JS_UNDEFINED;
     jsc->b = &b_s;
@@ -46962,10 +55092,12 @@ JSValue JS_JSONStringify(JSContext *ctx, JSValueConst obj,
     ret = JS_UNDEFINED;
     wrapper = JS_UNDEFINED;
 
+    for(i = 0; i < JSON_KEY_CACHE_SIZE; i++) {
+        jsc->key_cache[i].atom = JS_ATOM_NULL;
+        jsc->key_cache[i].str = JS_UNDEFINED;
+    }
+
     string_buffer_init(ctx, jsc->b, 0);
-    jsc->stack = JS_NewArray(ctx);
-    if (JS_IsException(jsc->stack))
-        goto exception;
     if (JS_IsFunction(ctx, replacer)) {
         jsc->replacer_func = replacer;
     } else {
@@ -47044,6 +55176,9 @@ JSValue JS_JSONStringify(JSContext *ctx, JSValueConst obj,
     JS_FreeValue(ctx, space);
     if (JS_IsException(jsc->gap))
         goto exception;
+    jsc->fast_ok = (JS_IsUndefined(jsc->replacer_func) &&
+                    JS_IsUndefined(jsc->property_list) &&
+                    JS_IsEmptyString(jsc->gap));
     wrapper = JS_NewObject(ctx);
     if (JS_IsException(wrapper))
         goto exception;
@@ -47074,7 +55209,11 @@ done:
     JS_FreeValue(ctx, jsc->empty);
     JS_FreeValue(ctx, jsc->gap);
     JS_FreeValue(ctx, jsc->property_list);
-    JS_FreeValue(ctx, jsc->stack);
+    js_free(ctx, jsc->stack);
+    for(i = 0; i < JSON_KEY_CACHE_SIZE; i++) {
+        JS_FreeAtom(ctx, jsc->key_cache[i].atom);
+        JS_FreeValue(ctx, jsc->key_cache[i].str);
+    }
     return ret;
 }
 
@@ -52899,6 +61038,108 @@ void JS_DetachArrayBuffer(JSContext *ctx, JSValueConst obj)
     }
 }
 
+/* Detach the ArrayBuffer 'obj' and return its data, allocated with
+   malloc(), so that it can be given to another runtime with
+   JS_NewTransferredArrayBuffer(). The data is not copied if the
+   runtime uses the default allocator. Return NULL if exception. */
+/* TRUE if the data of 'abuf' can be given to another runtime without
+   copying it */
+static BOOL js_array_buffer_is_transferable(JSRuntime *rt,
+                                            JSArrayBuffer *abuf)
+{
+    if (abuf->free_func == js_transfer_free)
+        return TRUE;
+    return (abuf->free_func == js_array_buffer_free &&
+            rt->mf.js_malloc == js_def_malloc &&
+            !js_nursery_contains(rt, abuf->data) &&
+            !js_slab_find(rt, abuf->data));
+}
+
+/* Detach the ArrayBuffers of 'tab' and return their data allocated
+   with malloc() in 'data_tab' and their length in 'len_tab'. In case
+   of exception, none of the ArrayBuffers is detached. */
+int JS_TransferArrayBuffers(JSContext *ctx, uint8_t **data_tab,
+                            size_t *len_tab, JSValueConst *tab, int count)
+{
+    JSRuntime *rt = ctx->rt;
+    JSArrayBuffer *abuf;
+    uint8_t *data;
+    int i;
+
+    if (js_check_transfer_tab(ctx, tab, count))
+        return -1;
+    /* copy the data which cannot be transferred, so that the
+       ArrayBuffers are only modified when no error can happen */
+    for(i = 0; i < count; i++) {
+        abuf = JS_GetOpaque(tab[i], JS_CLASS_ARRAY_BUFFER);
+        data_tab[i] = NULL;
+        if (!js_array_buffer_is_transferable(rt, abuf)) {
+            data = js_transfer_malloc(max_int(abuf->byte_length, 1));
+            if (!data) {
+                while (i-- > 0)
+                    js_transfer_free(rt, NULL, data_tab[i]);
+                JS_ThrowOutOfMemory(ctx);
+                return -1;
+            }
+            memcpy(data, abuf->data, abuf->byte_length);
+            data_tab[i] = data;
+        }
+    }
+    for(i = 0; i < count; i++) {
+        abuf = JS_GetOpaque(tab[i], JS_CLASS_ARRAY_BUFFER);
+        if (data_tab[i]) {
+            if (abuf->free_func)
+                abuf->free_func(rt, abuf->opaque, abuf->data);
+        } else {
+            data_tab[i] = abuf->data;
+            if (abuf->free_func == js_array_buffer_free) {
+                /* the block is removed from the runtime */
+                rt->malloc_state.malloc_count--;
+                rt->malloc_state.malloc_size -=
+                    js_def_malloc_usable_size(abuf->data) + MALLOC_OVERHEAD;
+            }
+        }
+        len_tab[i] = abuf->byte_length;
+        /* the data is no longer owned by the ArrayBuffer */
+        abuf->free_func = NULL;
+        JS_DetachArrayBuffer(ctx, tab[i]);
+    }
+    return 0;
+}
+
+uint8_t *JS_TransferArrayBuffer(JSContext *ctx, size_t *psize,
+                                JSValueConst obj)
+{
+    uint8_t *data;
+    if (JS_TransferArrayBuffers(ctx, &data, psize, &obj, 1))
+        return NULL;
+    return data;
+}
+
+/* Create an ArrayBuffer from the data returned by
+   JS_TransferArrayBuffer(). 'buf' is freed in case of exception. */
+JSValue JS_NewTransferredArrayBuffer(JSContext *ctx, uint8_t *buf, size_t len)
+{
+    JSRuntime *rt = ctx->rt;
+    JSValue obj;
+
+    if (rt->mf.js_malloc == js_def_malloc) {
+        /* the block is added to the runtime */
+        obj = JS_NewArrayBuffer(ctx, buf, len, js_array_buffer_free, NULL,
+                                FALSE);
+        if (!JS_IsException(obj)) {
+            rt->malloc_state.malloc_count++;
+            rt->malloc_state.malloc_size +=
+                js_def_malloc_usable_size(buf) + MALLOC_OVERHEAD;
+        }
+    } else {
+        obj = JS_NewArrayBuffer(ctx, buf, len, js_transfer_free, NULL, FALSE);
+    }
+    if (JS_IsException(obj))
+        js_transfer_free(rt, NULL, buf);
+    return obj;
+}
+
 /* get an ArrayBuffer or SharedArrayBuffer */
 static JSArrayBuffer *js_get_array_buffer(JSContext *ctx, JSValueConst obj)
 {
@@ -381,9 +381,33 @@ void JS_SetRuntimeOpaque(JSRuntime *rt, void *opaque);
 typedef void JS_MarkFunc(JSRuntime *rt, JSGCObjectHeader *gp);
 void JS_MarkValue(JSRuntime *rt, JSValueConst val, JS_MarkFunc *mark_func);
 void JS_RunGC(JSRuntime *rt);
+/* incremental cycle collection, 'budget' and 'max_pause' are in
+   microseconds */
+void JS_RunGCStep(JSRuntime *rt, int64_t budget);
+void JS_SetGCMaxPause(JSRuntime *rt, int64_t max_pause);
+int64_t JS_GetGCMaxPause(JSRuntime *rt);
+/* bump allocation region for the short lived objects. Must be
+   called before the first context is created. */
+int JS_SetNurserySize(JSRuntime *rt, size_t size);
+/* size class allocator for the small blocks (disabled by
+   default). The blocks are counted in the memory limit with their
+   size class, the arenas are not. */
+#define JS_SLAB_ENABLED       (1 << 0)
+/* return the empty arenas to the system */
+#define JS_SLAB_RELEASE_EMPTY (1 << 1)
+void JS_SetSlabAllocator(JSRuntime *rt, int flags);
+/* maximum number of compiled regexps kept by the runtime (default =
+   256). 0 disables the cache. */
+void JS_SetRegExpCacheSize(JSRuntime *rt, int max_count);
 JS_BOOL JS_IsLiveObject(JSRuntime *rt, JSValueConst obj);
 
 JSContext *JS_NewContext(JSRuntime *rt);
+/* create a context containing a copy of the objects of 'tmpl'
+   (builtins, globals and objects defined by the embedder) without
+   running its initialization. Only the plain objects, arrays and
+   native functions can be copied. Return NULL with an exception in
+   case of error. */
+JSContext *JS_NewContextFromTemplate(JSRuntime *rt, JSContext *tmpl);
 void JS_FreeContext(JSContext *s);
 JSContext *JS_DupContext(JSContext *ctx);
 void *JS_GetContextOpaque(JSContext *ctx);
@@ -433,13 +457,26 @@ typedef struct JSMemoryUsage {
     int64_t atom_count, atom_size;
     int64_t str_count, str_size;
     int64_t obj_count, obj_size;
-    int64_t prop_count, prop_size;
+    int64_t prop_count, prop_size; /* prop_size: out-of-line arrays only */
+    int64_t inline_prop_count, inline_prop_size; /* included in obj_size */
     int64_t shape_count, shape_size;
+    int64_t shape_transition_count, shape_transition_max_fan_out;
     int64_t js_func_count, js_func_size, js_func_code_size;
     int64_t js_func_pc2line_count, js_func_pc2line_size;
+    int64_t js_func_lazy_count; /* lazy functions created since the
+                                   runtime creation */
+    int64_t js_func_lazy_compiled_count; /* ... which were compiled */
     int64_t c_func_count, array_count;
     int64_t fast_array_count, fast_array_elements;
+    int64_t fast_array_size; /* depends on the element kinds */
     int64_t binary_object_count, binary_object_size;
+    int64_t regexp_cache_count, regexp_cache_size;
+    int64_t regexp_cache_hit_count, regexp_cache_miss_count;
+    int64_t regexp_nfa_count; /* lre_exec() calls which switched to the
+                                 linear time engine */
+    int64_t nursery_size, nursery_used_chunks; /* nursery_size: region size */
+    int64_t slab_arena_count, slab_arena_size; /* not in malloc_size */
+    int64_t slab_used_count, slab_used_size;
 } JSMemoryUsage;
 
 void JS_ComputeMemoryUsage(JSRuntime *rt, JSMemoryUsage *s);
@@ -859,12 +896,38 @@ JSValue JS_ParseJSON2(JSContext *ctx, const char *buf, size_t buf_len,
 JSValue JS_JSONStringify(JSContext *ctx, JSValueConst obj,
                          JSValueConst replacer, JSValueConst space0);
 
+/* Streaming JSON parser. 'func' is called for each value at depth
+   'emit_depth' (0 = top level values). 'key' is the property name or
+   the array index of the value in its parent, or undefined for a top
+   level value. 'func' returns < 0 to raise an exception. */
+typedef struct JSJSONParser JSJSONParser;
+typedef int JSJSONParserFunc(JSContext *ctx, JSValueConst key,
+                             JSValueConst val, void *opaque);
+#define JS_JSON_PARSER_MULTI (1 << 0) /* accept a sequence of JSON values */
+JSJSONParser *JS_NewJSONParser(JSContext *ctx, int emit_depth, int flags,
+                               JSJSONParserFunc *func, void *opaque);
+/* 'buf' contains UTF-8 text. Return -1 if exception. */
+int JS_JSONParserFeed(JSJSONParser *p, const uint8_t *buf, size_t len);
+/* signal the end of the input. Return -1 if exception. */
+int JS_JSONParserEnd(JSJSONParser *p);
+void JS_FreeJSONParser(JSJSONParser *p);
+
 typedef void JSFreeArrayBufferDataFunc(JSRuntime *rt, void *opaque, void *ptr);
 JSValue JS_NewArrayBuffer(JSContext *ctx, uint8_t *buf, size_t len,
                           JSFreeArrayBufferDataFunc *free_func, void *opaque,
                           JS_BOOL is_shared);
 JSValue JS_NewArrayBufferCopy(JSContext *ctx, const uint8_t *buf, size_t len);
 void JS_DetachArrayBuffer(JSContext *ctx, JSValueConst obj);
+/* detach an ArrayBuffer and return its data allocated with malloc() */
+uint8_t *JS_TransferArrayBuffer(JSContext *ctx, size_t *psize,
+                                JSValueConst obj);
+/* same as JS_TransferArrayBuffer() for several ArrayBuffers. In case
+   of exception, none of them is detached. */
+int JS_TransferArrayBuffers(JSContext *ctx, uint8_t **data_tab,
+                            size_t *len_tab, JSValueConst *tab, int count);
+/* create an ArrayBuffer owning a buffer returned by
+   JS_TransferArrayBuffer() */
+JSValue JS_NewTransferredArrayBuffer(JSContext *ctx, uint8_t *buf, size_t len);
 uint8_t *JS_GetArrayBuffer(JSContext *ctx, size_t *psize, JSValueConst obj);
 
 typedef enum JSTypedArrayEnum {
@@ -923,6 +986,17 @@ void JS_SetCanBlock(JSRuntime *rt, JS_BOOL can_block);
 #define JS_STRIP_DEBUG  (1 << 1) /* strip all debug info including source code */
 void JS_SetStripInfo(JSRuntime *rt, int flags);
 int JS_GetStripInfo(JSRuntime *rt);
+/* enable or disable the property access inline caches (enabled by default) */
+void JS_SetInlineCacheEnabled(JSRuntime *rt, JS_BOOL enabled);
+/* enable or disable the lazy compilation of the nested functions
+   (enabled by default). When enabled, the bytecode of a function is
+   generated on its first call. */
+void JS_SetLazyCompilationEnabled(JSRuntime *rt, JS_BOOL enabled);
+/* enable or disable the baseline JIT (enabled by default when built
+   with CONFIG_JIT, no effect otherwise) */
+void JS_SetJITEnabled(JSRuntime *rt, JS_BOOL enabled);
+/* number of calls and loop iterations before a function is compiled */
+void JS_SetJITThreshold(JSRuntime *rt, int threshold);
 
 /* set the [IsHTMLDDA] internal slot */
 void JS_SetIsHTMLDDA(JSContext *ctx, JSValueConst obj);
@@ -975,10 +1049,16 @@ int JS_ExecutePendingJob(JSRuntime *rt, JSContext **pctx);
 #define JS_WRITE_OBJ_REFERENCE (1 << 3) /* allow object references to
                                            encode arbitrary object
                                            graph */
+#define JS_WRITE_OBJ_MALLOC    (1 << 4) /* the result is allocated with
+                                           malloc() */
 uint8_t *JS_WriteObject(JSContext *ctx, size_t *psize, JSValueConst obj,
                         int flags);
 uint8_t *JS_WriteObject2(JSContext *ctx, size_t *psize, JSValueConst obj,
                          int flags, uint8_t ***psab_tab, size_t *psab_tab_len);
+/* the ArrayBuffers of 'transfer_tab' are not copied */
+uint8_t *JS_WriteObject3(JSContext *ctx, size_t *psize, JSValueConst obj,
+                         int flags, uint8_t ***psab_tab, size_t *psab_tab_len,
+                         JSValueConst *transfer_tab, int transfer_len);
 
 #define JS_READ_OBJ_BYTECODE  (1 << 0) /* allow function/module */
 #define JS_READ_OBJ_ROM_DATA  (1 << 1) /* avoid duplicating 'buf' data */
@@ -986,6 +1066,25 @@ uint8_t *JS_WriteObject2(JSContext *ctx, size_t *psize, JSValueConst obj,
 #define JS_READ_OBJ_REFERENCE (1 << 3) /* allow object references */
 JSValue JS_ReadObject(JSContext *ctx, const uint8_t *buf, size_t buf_len,
                       int flags);
+JSValue JS_ReadObject2(JSContext *ctx, const uint8_t *buf, size_t buf_len,
+                       int flags, JSValueConst *transfer_tab, int transfer_len);
+typedef void JSFreeBytecodeImageFunc(JSRuntime *rt, void *opaque,
+                                     const uint8_t *buf, size_t buf_len);
+/* Same as JS_ReadObject() but the nested functions are only read on
+   their first call. 'buf' is not modified and must remain valid until
+   'free_func' is called (e.g. it can be a read-only file mapping).
+   'free_func' can be NULL. */
+JSValue JS_ReadObjectImage(JSContext *ctx, const uint8_t *buf, size_t buf_len,
+                           int flags, JSFreeBytecodeImageFunc *free_func,
+                           void *opaque);
+/* Save the objects of 'ctx' which differ from the new context
+   'base_ctx'. 'base_ctx' must belong to the same runtime and be
+   created the same way as the context given to JS_ReadSnapshot(). The
+   builtin objects are saved as references. Return NULL in case of
+   exception, otherwise the result must be freed with js_free(). */
+uint8_t *JS_WriteSnapshot(JSContext *ctx, JSContext *base_ctx, size_t *psize);
+/* restore a snapshot in a new context. Return -1 in case of exception. */
+int JS_ReadSnapshot(JSContext *ctx, const uint8_t *buf, size_t buf_len);
 /* instantiate and evaluate a bytecode function. Only used when
    reading a script or module with JS_ReadObject() */
 JSValue JS_EvalFunction(JSContext *ctx, JSValue fun_obj);
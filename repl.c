@@ -0,0 +1,1669 @@
+/* File generated automatically by the QuickJS compiler. */
+
+#include <inttypes.h>
+
+const uint32_t qjsc_repl_size = 13280;
+
+const uint8_t qjsc_repl[13280] = {
+ 0x07, 0xd6, 0x02, 0x0e, 0x72, 0x65, 0x70, 0x6c,
+ 0x2e, 0x6a, 0x73, 0x06, 0x73, 0x74, 0x64, 0x04,
+ 0x6f, 0x73, 0x10, 0x69, 0x73, 0x46, 0x69, 0x6e,
+ 0x69, 0x74, 0x65, 0x14, 0x70, 0x61, 0x72, 0x73,
+ 0x65, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x08, 0x1b,
+ 0x5b, 0x30, 0x6d, 0x08, 0x6e, 0x6f, 0x6e, 0x65,
+ 0x0a, 0x1b, 0x5b, 0x33, 0x30, 0x6d, 0x0a, 0x62,
+ 0x6c, 0x61, 0x63, 0x6b, 0x0a, 0x1b, 0x5b, 0x33,
+ 0x31, 0x6d, 0x06, 0x72, 0x65, 0x64, 0x0a, 0x1b,
+ 0x5b, 0x33, 0x32, 0x6d, 0x0a, 0x67, 0x72, 0x65,
+ 0x65, 0x6e, 0x0a, 0x1b, 0x5b, 0x33, 0x33, 0x6d,
+ 0x0c, 0x79, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x0a,
+ 0x1b, 0x5b, 0x33, 0x34, 0x6d, 0x08, 0x62, 0x6c,
+ 0x75, 0x65, 0x0a, 0x1b, 0x5b, 0x33, 0x35, 0x6d,
+ 0x0e, 0x6d, 0x61, 0x67, 0x65, 0x6e, 0x74, 0x61,
+ 0x0a, 0x1b, 0x5b, 0x33, 0x36, 0x6d, 0x08, 0x63,
+ 0x79, 0x61, 0x6e, 0x0a, 0x1b, 0x5b, 0x33, 0x37,
+ 0x6d, 0x0a, 0x77, 0x68, 0x69, 0x74, 0x65, 0x0e,
+ 0x1b, 0x5b, 0x33, 0x30, 0x3b, 0x31, 0x6d, 0x08,
+ 0x67, 0x72, 0x61, 0x79, 0x08, 0x67, 0x72, 0x65,
+ 0x79, 0x0e, 0x1b, 0x5b, 0x33, 0x31, 0x3b, 0x31,
+ 0x6d, 0x14, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74,
+ 0x5f, 0x72, 0x65, 0x64, 0x0e, 0x1b, 0x5b, 0x33,
+ 0x32, 0x3b, 0x31, 0x6d, 0x18, 0x62, 0x72, 0x69,
+ 0x67, 0x68, 0x74, 0x5f, 0x67, 0x72, 0x65, 0x65,
+ 0x6e, 0x0e, 0x1b, 0x5b, 0x33, 0x33, 0x3b, 0x31,
+ 0x6d, 0x1a, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74,
+ 0x5f, 0x79, 0x65, 0x6c, 0x6c, 0x6f, 0x77, 0x0e,
+ 0x1b, 0x5b, 0x33, 0x34, 0x3b, 0x31, 0x6d, 0x16,
+ 0x62, 0x72, 0x69, 0x67, 0x68, 0x74, 0x5f, 0x62,
+ 0x6c, 0x75, 0x65, 0x0e, 0x1b, 0x5b, 0x33, 0x35,
+ 0x3b, 0x31, 0x6d, 0x1c, 0x62, 0x72, 0x69, 0x67,
+ 0x68, 0x74, 0x5f, 0x6d, 0x61, 0x67, 0x65, 0x6e,
+ 0x74, 0x61, 0x0e, 0x1b, 0x5b, 0x33, 0x36, 0x3b,
+ 0x31, 0x6d, 0x16, 0x62, 0x72, 0x69, 0x67, 0x68,
+ 0x74, 0x5f, 0x63, 0x79, 0x61, 0x6e, 0x0e, 0x1b,
+ 0x5b, 0x33, 0x37, 0x3b, 0x31, 0x6d, 0x18, 0x62,
+ 0x72, 0x69, 0x67, 0x68, 0x74, 0x5f, 0x77, 0x68,
+ 0x69, 0x74, 0x65, 0x0e, 0x63, 0x6f, 0x6d, 0x6d,
+ 0x65, 0x6e, 0x74, 0x0a, 0x72, 0x65, 0x67, 0x65,
+ 0x78, 0x0e, 0x6b, 0x65, 0x79, 0x77, 0x6f, 0x72,
+ 0x64, 0x08, 0x74, 0x79, 0x70, 0x65, 0x14, 0x69,
+ 0x64, 0x65, 0x6e, 0x74, 0x69, 0x66, 0x69, 0x65,
+ 0x72, 0x0a, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x0c,
+ 0x72, 0x65, 0x73, 0x75, 0x6c, 0x74, 0x12, 0x65,
+ 0x72, 0x72, 0x6f, 0x72, 0x5f, 0x6d, 0x73, 0x67,
+ 0x0c, 0x71, 0x6a, 0x73, 0x20, 0x3e, 0x20, 0x0c,
+ 0x20, 0x20, 0x2e, 0x2e, 0x2e, 0x20, 0x02, 0x01,
+ 0x02, 0x02, 0x02, 0x03, 0x02, 0x04, 0x02, 0x05,
+ 0x02, 0x06, 0x02, 0x07, 0x02, 0x08, 0x02, 0x09,
+ 0x02, 0x0a, 0x02, 0x0b, 0x02, 0x0d, 0x02, 0x0e,
+ 0x02, 0x10, 0x02, 0x11, 0x02, 0x12, 0x02, 0x13,
+ 0x02, 0x14, 0x02, 0x18, 0x02, 0x19, 0x06, 0x1b,
+ 0x4f, 0x41, 0x06, 0x1b, 0x4f, 0x42, 0x06, 0x1b,
+ 0x4f, 0x43, 0x06, 0x1b, 0x4f, 0x44, 0x06, 0x1b,
+ 0x4f, 0x46, 0x06, 0x1b, 0x4f, 0x48, 0x0c, 0x1b,
+ 0x5b, 0x31, 0x3b, 0x35, 0x43, 0x0c, 0x1b, 0x5b,
+ 0x31, 0x3b, 0x35, 0x44, 0x08, 0x1b, 0x5b, 0x31,
+ 0x7e, 0x08, 0x1b, 0x5b, 0x33, 0x7e, 0x08, 0x1b,
+ 0x5b, 0x34, 0x7e, 0x08, 0x1b, 0x5b, 0x35, 0x7e,
+ 0x08, 0x1b, 0x5b, 0x36, 0x7e, 0x06, 0x1b, 0x5b,
+ 0x41, 0x06, 0x1b, 0x5b, 0x42, 0x06, 0x1b, 0x5b,
+ 0x43, 0x06, 0x1b, 0x5b, 0x44, 0x06, 0x1b, 0x5b,
+ 0x46, 0x06, 0x1b, 0x5b, 0x48, 0x04, 0x1b, 0x7f,
+ 0x04, 0x1b, 0x62, 0x04, 0x1b, 0x64, 0x04, 0x1b,
+ 0x66, 0x04, 0x1b, 0x6b, 0x04, 0x1b, 0x6c, 0x04,
+ 0x1b, 0x74, 0x04, 0x1b, 0x75, 0x02, 0x7f, 0x10,
+ 0x74, 0x65, 0x72, 0x6d, 0x49, 0x6e, 0x69, 0x74,
+ 0x0c, 0x66, 0x69, 0x6c, 0x65, 0x6e, 0x6f, 0x0c,
+ 0x69, 0x73, 0x61, 0x74, 0x74, 0x79, 0x1a, 0x74,
+ 0x74, 0x79, 0x47, 0x65, 0x74, 0x57, 0x69, 0x6e,
+ 0x53, 0x69, 0x7a, 0x65, 0x12, 0x74, 0x74, 0x79,
+ 0x53, 0x65, 0x74, 0x52, 0x61, 0x77, 0x0c, 0x73,
+ 0x69, 0x67, 0x6e, 0x61, 0x6c, 0x0c, 0x53, 0x49,
+ 0x47, 0x49, 0x4e, 0x54, 0x1c, 0x73, 0x65, 0x74,
+ 0x52, 0x65, 0x61, 0x64, 0x48, 0x61, 0x6e, 0x64,
+ 0x6c, 0x65, 0x72, 0x1c, 0x73, 0x69, 0x67, 0x69,
+ 0x6e, 0x74, 0x5f, 0x68, 0x61, 0x6e, 0x64, 0x6c,
+ 0x65, 0x72, 0x16, 0x68, 0x61, 0x6e, 0x64, 0x6c,
+ 0x65, 0x5f, 0x62, 0x79, 0x74, 0x65, 0x22, 0x74,
+ 0x65, 0x72, 0x6d, 0x5f, 0x72, 0x65, 0x61, 0x64,
+ 0x5f, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x72,
+ 0x08, 0x72, 0x65, 0x61, 0x64, 0x0c, 0x62, 0x75,
+ 0x66, 0x66, 0x65, 0x72, 0x10, 0x69, 0x73, 0x5f,
+ 0x61, 0x6c, 0x70, 0x68, 0x61, 0x02, 0x41, 0x02,
+ 0x5a, 0x02, 0x61, 0x02, 0x7a, 0x10, 0x69, 0x73,
+ 0x5f, 0x64, 0x69, 0x67, 0x69, 0x74, 0x0e, 0x69,
+ 0x73, 0x5f, 0x77, 0x6f, 0x72, 0x64, 0x02, 0x5f,
+ 0x02, 0x24, 0x14, 0x75, 0x63, 0x73, 0x5f, 0x6c,
+ 0x65, 0x6e, 0x67, 0x74, 0x68, 0x14, 0x63, 0x68,
+ 0x61, 0x72, 0x43, 0x6f, 0x64, 0x65, 0x41, 0x74,
+ 0x2a, 0x69, 0x73, 0x5f, 0x74, 0x72, 0x61, 0x69,
+ 0x6c, 0x69, 0x6e, 0x67, 0x5f, 0x73, 0x75, 0x72,
+ 0x72, 0x6f, 0x67, 0x61, 0x74, 0x65, 0x16, 0x63,
+ 0x6f, 0x64, 0x65, 0x50, 0x6f, 0x69, 0x6e, 0x74,
+ 0x41, 0x74, 0x16, 0x69, 0x73, 0x5f, 0x62, 0x61,
+ 0x6c, 0x61, 0x6e, 0x63, 0x65, 0x64, 0x04, 0x28,
+ 0x29, 0x04, 0x5b, 0x5d, 0x04, 0x7b, 0x7d, 0x20,
+ 0x70, 0x72, 0x69, 0x6e, 0x74, 0x5f, 0x63, 0x6f,
+ 0x6c, 0x6f, 0x72, 0x5f, 0x74, 0x65, 0x78, 0x74,
+ 0x08, 0x70, 0x75, 0x74, 0x73, 0x12, 0x73, 0x75,
+ 0x62, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x12,
+ 0x70, 0x72, 0x69, 0x6e, 0x74, 0x5f, 0x63, 0x73,
+ 0x69, 0x04, 0x1b, 0x5b, 0x16, 0x6d, 0x6f, 0x76,
+ 0x65, 0x5f, 0x63, 0x75, 0x72, 0x73, 0x6f, 0x72,
+ 0x06, 0x6d, 0x69, 0x6e, 0x02, 0x43, 0x02, 0x44,
+ 0x0c, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65, 0x04,
+ 0x20, 0x08, 0x06, 0x1b, 0x5b, 0x4a, 0x06, 0x6f,
+ 0x75, 0x74, 0x0a, 0x66, 0x6c, 0x75, 0x73, 0x68,
+ 0x0c, 0x69, 0x6e, 0x73, 0x65, 0x72, 0x74, 0x1a,
+ 0x71, 0x75, 0x6f, 0x74, 0x65, 0x64, 0x5f, 0x69,
+ 0x6e, 0x73, 0x65, 0x72, 0x74, 0x14, 0x71, 0x75,
+ 0x6f, 0x74, 0x65, 0x5f, 0x66, 0x6c, 0x61, 0x67,
+ 0x0a, 0x61, 0x62, 0x6f, 0x72, 0x74, 0x06, 0x63,
+ 0x6d, 0x64, 0x14, 0x63, 0x75, 0x72, 0x73, 0x6f,
+ 0x72, 0x5f, 0x70, 0x6f, 0x73, 0x0a, 0x61, 0x6c,
+ 0x65, 0x72, 0x74, 0x22, 0x62, 0x65, 0x67, 0x69,
+ 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x5f, 0x6f, 0x66,
+ 0x5f, 0x6c, 0x69, 0x6e, 0x65, 0x16, 0x65, 0x6e,
+ 0x64, 0x5f, 0x6f, 0x66, 0x5f, 0x6c, 0x69, 0x6e,
+ 0x65, 0x18, 0x66, 0x6f, 0x72, 0x77, 0x61, 0x72,
+ 0x64, 0x5f, 0x63, 0x68, 0x61, 0x72, 0x0c, 0x63,
+ 0x68, 0x61, 0x72, 0x41, 0x74, 0x1a, 0x62, 0x61,
+ 0x63, 0x6b, 0x77, 0x61, 0x72, 0x64, 0x5f, 0x63,
+ 0x68, 0x61, 0x72, 0x22, 0x73, 0x6b, 0x69, 0x70,
+ 0x5f, 0x77, 0x6f, 0x72, 0x64, 0x5f, 0x66, 0x6f,
+ 0x72, 0x77, 0x61, 0x72, 0x64, 0x24, 0x73, 0x6b,
+ 0x69, 0x70, 0x5f, 0x77, 0x6f, 0x72, 0x64, 0x5f,
+ 0x62, 0x61, 0x63, 0x6b, 0x77, 0x61, 0x72, 0x64,
+ 0x18, 0x66, 0x6f, 0x72, 0x77, 0x61, 0x72, 0x64,
+ 0x5f, 0x77, 0x6f, 0x72, 0x64, 0x1a, 0x62, 0x61,
+ 0x63, 0x6b, 0x77, 0x61, 0x72, 0x64, 0x5f, 0x77,
+ 0x6f, 0x72, 0x64, 0x16, 0x61, 0x63, 0x63, 0x65,
+ 0x70, 0x74, 0x5f, 0x6c, 0x69, 0x6e, 0x65, 0x16,
+ 0x68, 0x69, 0x73, 0x74, 0x6f, 0x72, 0x79, 0x5f,
+ 0x61, 0x64, 0x64, 0x08, 0x70, 0x75, 0x73, 0x68,
+ 0x20, 0x70, 0x72, 0x65, 0x76, 0x69, 0x6f, 0x75,
+ 0x73, 0x5f, 0x68, 0x69, 0x73, 0x74, 0x6f, 0x72,
+ 0x79, 0x1a, 0x68, 0x69, 0x73, 0x74, 0x6f, 0x72,
+ 0x79, 0x5f, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x0e,
+ 0x68, 0x69, 0x73, 0x74, 0x6f, 0x72, 0x79, 0x18,
+ 0x6e, 0x65, 0x78, 0x74, 0x5f, 0x68, 0x69, 0x73,
+ 0x74, 0x6f, 0x72, 0x79, 0x1c, 0x68, 0x69, 0x73,
+ 0x74, 0x6f, 0x72, 0x79, 0x5f, 0x73, 0x65, 0x61,
+ 0x72, 0x63, 0x68, 0x2e, 0x68, 0x69, 0x73, 0x74,
+ 0x6f, 0x72, 0x79, 0x5f, 0x73, 0x65, 0x61, 0x72,
+ 0x63, 0x68, 0x5f, 0x62, 0x61, 0x63, 0x6b, 0x77,
+ 0x61, 0x72, 0x64, 0x2c, 0x68, 0x69, 0x73, 0x74,
+ 0x6f, 0x72, 0x79, 0x5f, 0x73, 0x65, 0x61, 0x72,
+ 0x63, 0x68, 0x5f, 0x66, 0x6f, 0x72, 0x77, 0x61,
+ 0x72, 0x64, 0x1e, 0x64, 0x65, 0x6c, 0x65, 0x74,
+ 0x65, 0x5f, 0x63, 0x68, 0x61, 0x72, 0x5f, 0x64,
+ 0x69, 0x72, 0x16, 0x64, 0x65, 0x6c, 0x65, 0x74,
+ 0x65, 0x5f, 0x63, 0x68, 0x61, 0x72, 0x12, 0x63,
+ 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x5f, 0x64,
+ 0x28, 0x62, 0x61, 0x63, 0x6b, 0x77, 0x61, 0x72,
+ 0x64, 0x5f, 0x64, 0x65, 0x6c, 0x65, 0x74, 0x65,
+ 0x5f, 0x63, 0x68, 0x61, 0x72, 0x1e, 0x74, 0x72,
+ 0x61, 0x6e, 0x73, 0x70, 0x6f, 0x73, 0x65, 0x5f,
+ 0x63, 0x68, 0x61, 0x72, 0x73, 0x1e, 0x74, 0x72,
+ 0x61, 0x6e, 0x73, 0x70, 0x6f, 0x73, 0x65, 0x5f,
+ 0x77, 0x6f, 0x72, 0x64, 0x73, 0x16, 0x75, 0x70,
+ 0x63, 0x61, 0x73, 0x65, 0x5f, 0x77, 0x6f, 0x72,
+ 0x64, 0x16, 0x74, 0x6f, 0x55, 0x70, 0x70, 0x65,
+ 0x72, 0x43, 0x61, 0x73, 0x65, 0x1a, 0x64, 0x6f,
+ 0x77, 0x6e, 0x63, 0x61, 0x73, 0x65, 0x5f, 0x77,
+ 0x6f, 0x72, 0x64, 0x16, 0x74, 0x6f, 0x4c, 0x6f,
+ 0x77, 0x65, 0x72, 0x43, 0x61, 0x73, 0x65, 0x16,
+ 0x6b, 0x69, 0x6c, 0x6c, 0x5f, 0x72, 0x65, 0x67,
+ 0x69, 0x6f, 0x6e, 0x12, 0x6b, 0x69, 0x6c, 0x6c,
+ 0x5f, 0x6c, 0x69, 0x6e, 0x65, 0x24, 0x62, 0x61,
+ 0x63, 0x6b, 0x77, 0x61, 0x72, 0x64, 0x5f, 0x6b,
+ 0x69, 0x6c, 0x6c, 0x5f, 0x6c, 0x69, 0x6e, 0x65,
+ 0x12, 0x6b, 0x69, 0x6c, 0x6c, 0x5f, 0x77, 0x6f,
+ 0x72, 0x64, 0x24, 0x62, 0x61, 0x63, 0x6b, 0x77,
+ 0x61, 0x72, 0x64, 0x5f, 0x6b, 0x69, 0x6c, 0x6c,
+ 0x5f, 0x77, 0x6f, 0x72, 0x64, 0x08, 0x79, 0x61,
+ 0x6e, 0x6b, 0x14, 0x63, 0x6c, 0x69, 0x70, 0x5f,
+ 0x62, 0x6f, 0x61, 0x72, 0x64, 0x12, 0x63, 0x6f,
+ 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x5f, 0x63, 0x10,
+ 0x6c, 0x61, 0x73, 0x74, 0x5f, 0x66, 0x75, 0x6e,
+ 0x2a, 0x72, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e,
+ 0x65, 0x5f, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x5f,
+ 0x70, 0x72, 0x6f, 0x6d, 0x70, 0x74, 0x08, 0x65,
+ 0x78, 0x69, 0x74, 0x3c, 0x0a, 0x28, 0x50, 0x72,
+ 0x65, 0x73, 0x73, 0x20, 0x43, 0x74, 0x72, 0x6c,
+ 0x2d, 0x43, 0x20, 0x61, 0x67, 0x61, 0x69, 0x6e,
+ 0x20, 0x74, 0x6f, 0x20, 0x71, 0x75, 0x69, 0x74,
+ 0x29, 0x0a, 0x0a, 0x72, 0x65, 0x73, 0x65, 0x74,
+ 0x20, 0x67, 0x65, 0x74, 0x5f, 0x63, 0x6f, 0x6e,
+ 0x74, 0x65, 0x78, 0x74, 0x5f, 0x77, 0x6f, 0x72,
+ 0x64, 0x24, 0x67, 0x65, 0x74, 0x5f, 0x63, 0x6f,
+ 0x6e, 0x74, 0x65, 0x78, 0x74, 0x5f, 0x6f, 0x62,
+ 0x6a, 0x65, 0x63, 0x74, 0x08, 0x6c, 0x69, 0x6e,
+ 0x65, 0x06, 0x70, 0x6f, 0x73, 0x06, 0x6f, 0x62,
+ 0x6a, 0x08, 0x62, 0x61, 0x73, 0x65, 0x02, 0x63,
+ 0x02, 0x67, 0x0c, 0x63, 0x6f, 0x6c, 0x6f, 0x72,
+ 0x73, 0x0c, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x73,
+ 0x08, 0x70, 0x72, 0x65, 0x63, 0x0e, 0x65, 0x78,
+ 0x70, 0x42, 0x69, 0x74, 0x73, 0x0e, 0x6c, 0x6f,
+ 0x67, 0x32, 0x5f, 0x31, 0x30, 0x0c, 0x70, 0x73,
+ 0x74, 0x61, 0x74, 0x65, 0x0c, 0x70, 0x72, 0x6f,
+ 0x6d, 0x70, 0x74, 0x08, 0x70, 0x6c, 0x65, 0x6e,
+ 0x06, 0x70, 0x73, 0x31, 0x06, 0x70, 0x73, 0x32,
+ 0x08, 0x75, 0x74, 0x66, 0x38, 0x12, 0x73, 0x68,
+ 0x6f, 0x77, 0x5f, 0x74, 0x69, 0x6d, 0x65, 0x16,
+ 0x73, 0x68, 0x6f, 0x77, 0x5f, 0x63, 0x6f, 0x6c,
+ 0x6f, 0x72, 0x73, 0x1e, 0x65, 0x76, 0x61, 0x6c,
+ 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x5f, 0x74,
+ 0x69, 0x6d, 0x65, 0x12, 0x65, 0x76, 0x61, 0x6c,
+ 0x5f, 0x74, 0x69, 0x6d, 0x65, 0x0a, 0x6d, 0x65,
+ 0x78, 0x70, 0x72, 0x0a, 0x6c, 0x65, 0x76, 0x65,
+ 0x6c, 0x10, 0x6c, 0x61, 0x73, 0x74, 0x5f, 0x63,
+ 0x6d, 0x64, 0x1e, 0x6c, 0x61, 0x73, 0x74, 0x5f,
+ 0x63, 0x75, 0x72, 0x73, 0x6f, 0x72, 0x5f, 0x70,
+ 0x6f, 0x73, 0x10, 0x74, 0x68, 0x69, 0x73, 0x5f,
+ 0x66, 0x75, 0x6e, 0x14, 0x75, 0x74, 0x66, 0x38,
+ 0x5f, 0x73, 0x74, 0x61, 0x74, 0x65, 0x10, 0x75,
+ 0x74, 0x66, 0x38, 0x5f, 0x76, 0x61, 0x6c, 0x0e,
+ 0x74, 0x65, 0x72, 0x6d, 0x5f, 0x66, 0x64, 0x1a,
+ 0x74, 0x65, 0x72, 0x6d, 0x5f, 0x72, 0x65, 0x61,
+ 0x64, 0x5f, 0x62, 0x75, 0x66, 0x14, 0x74, 0x65,
+ 0x72, 0x6d, 0x5f, 0x77, 0x69, 0x64, 0x74, 0x68,
+ 0x1a, 0x74, 0x65, 0x72, 0x6d, 0x5f, 0x63, 0x75,
+ 0x72, 0x73, 0x6f, 0x72, 0x5f, 0x78, 0x1e, 0x67,
+ 0x65, 0x74, 0x5f, 0x63, 0x6f, 0x6d, 0x70, 0x6c,
+ 0x65, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x14, 0x63,
+ 0x6f, 0x6d, 0x70, 0x6c, 0x65, 0x74, 0x69, 0x6f,
+ 0x6e, 0x10, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e,
+ 0x64, 0x73, 0x0c, 0x64, 0x75, 0x70, 0x73, 0x74,
+ 0x72, 0x1a, 0x72, 0x65, 0x61, 0x64, 0x6c, 0x69,
+ 0x6e, 0x65, 0x5f, 0x6b, 0x65, 0x79, 0x73, 0x1c,
+ 0x72, 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e, 0x65,
+ 0x5f, 0x73, 0x74, 0x61, 0x74, 0x65, 0x16, 0x72,
+ 0x65, 0x61, 0x64, 0x6c, 0x69, 0x6e, 0x65, 0x5f,
+ 0x63, 0x62, 0x1c, 0x72, 0x65, 0x61, 0x64, 0x6c,
+ 0x69, 0x6e, 0x65, 0x5f, 0x73, 0x74, 0x61, 0x72,
+ 0x74, 0x16, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65,
+ 0x5f, 0x63, 0x68, 0x61, 0x72, 0x14, 0x68, 0x61,
+ 0x6e, 0x64, 0x6c, 0x65, 0x5f, 0x6b, 0x65, 0x79,
+ 0x10, 0x68, 0x65, 0x78, 0x5f, 0x6d, 0x6f, 0x64,
+ 0x65, 0x28, 0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72,
+ 0x5f, 0x74, 0x6f, 0x5f, 0x73, 0x74, 0x72, 0x69,
+ 0x6e, 0x67, 0x5f, 0x68, 0x65, 0x78, 0x22, 0x65,
+ 0x78, 0x74, 0x72, 0x61, 0x63, 0x74, 0x5f, 0x64,
+ 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x76, 0x65,
+ 0x20, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x5f,
+ 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69, 0x76,
+ 0x65, 0x08, 0x68, 0x65, 0x6c, 0x70, 0x12, 0x63,
+ 0x6d, 0x64, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74,
+ 0x24, 0x63, 0x6d, 0x64, 0x5f, 0x72, 0x65, 0x61,
+ 0x64, 0x6c, 0x69, 0x6e, 0x65, 0x5f, 0x73, 0x74,
+ 0x61, 0x72, 0x74, 0x26, 0x72, 0x65, 0x61, 0x64,
+ 0x6c, 0x69, 0x6e, 0x65, 0x5f, 0x68, 0x61, 0x6e,
+ 0x64, 0x6c, 0x65, 0x5f, 0x63, 0x6d, 0x64, 0x14,
+ 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x5f, 0x63,
+ 0x6d, 0x64, 0x28, 0x65, 0x76, 0x61, 0x6c, 0x5f,
+ 0x61, 0x6e, 0x64, 0x5f, 0x70, 0x72, 0x69, 0x6e,
+ 0x74, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x22,
+ 0x70, 0x72, 0x69, 0x6e, 0x74, 0x5f, 0x65, 0x76,
+ 0x61, 0x6c, 0x5f, 0x72, 0x65, 0x73, 0x75, 0x6c,
+ 0x74, 0x20, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x5f,
+ 0x65, 0x76, 0x61, 0x6c, 0x5f, 0x65, 0x72, 0x72,
+ 0x6f, 0x72, 0x1c, 0x68, 0x61, 0x6e, 0x64, 0x6c,
+ 0x65, 0x5f, 0x63, 0x6d, 0x64, 0x5f, 0x65, 0x6e,
+ 0x64, 0x16, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x69,
+ 0x7a, 0x65, 0x5f, 0x6a, 0x73, 0x2a, 0x20, 0x7e,
+ 0x21, 0x25, 0x5e, 0x26, 0x2a, 0x28, 0x2d, 0x2b,
+ 0x3d, 0x7b, 0x5b, 0x7c, 0x3a, 0x3b, 0x2c, 0x3c,
+ 0x3e, 0x3f, 0x2f, 0x0e, 0x69, 0x6e, 0x64, 0x65,
+ 0x78, 0x4f, 0x66, 0x02, 0x2e, 0x02, 0x27, 0x02,
+ 0x22, 0x02, 0x5d, 0x02, 0x7d, 0x02, 0x2f, 0x10,
+ 0x69, 0x6e, 0x63, 0x6c, 0x75, 0x64, 0x65, 0x73,
+ 0x0a, 0x69, 0x73, 0x4e, 0x61, 0x4e, 0x26, 0x67,
+ 0x65, 0x74, 0x4f, 0x77, 0x6e, 0x50, 0x72, 0x6f,
+ 0x70, 0x65, 0x72, 0x74, 0x79, 0x4e, 0x61, 0x6d,
+ 0x65, 0x73, 0x14, 0x73, 0x74, 0x61, 0x72, 0x74,
+ 0x73, 0x57, 0x69, 0x74, 0x68, 0x08, 0x73, 0x6f,
+ 0x72, 0x74, 0x06, 0x74, 0x61, 0x62, 0x06, 0x63,
+ 0x74, 0x78, 0x0c, 0x73, 0x79, 0x6d, 0x63, 0x6d,
+ 0x70, 0x02, 0x28, 0x02, 0x29, 0x06, 0x6d, 0x61,
+ 0x78, 0x0a, 0x66, 0x6c, 0x6f, 0x6f, 0x72, 0x08,
+ 0x63, 0x65, 0x69, 0x6c, 0x0c, 0x70, 0x61, 0x64,
+ 0x45, 0x6e, 0x64, 0x02, 0x20, 0x0e, 0x74, 0x6f,
+ 0x46, 0x69, 0x78, 0x65, 0x64, 0x1a, 0x66, 0x72,
+ 0x6f, 0x6d, 0x43, 0x6f, 0x64, 0x65, 0x50, 0x6f,
+ 0x69, 0x6e, 0x74, 0x02, 0x1b, 0x02, 0x5b, 0x02,
+ 0x4f, 0x02, 0x3b, 0x02, 0x2d, 0x04, 0x30, 0x78,
+ 0x02, 0x5c, 0x02, 0x68, 0x02, 0x3f, 0x08, 0x6c,
+ 0x6f, 0x61, 0x64, 0x08, 0x74, 0x72, 0x69, 0x6d,
+ 0x16, 0x6c, 0x61, 0x73, 0x74, 0x49, 0x6e, 0x64,
+ 0x65, 0x78, 0x4f, 0x66, 0x06, 0x2e, 0x6a, 0x73,
+ 0x14, 0x6c, 0x6f, 0x61, 0x64, 0x53, 0x63, 0x72,
+ 0x69, 0x70, 0x74, 0x02, 0x78, 0x02, 0x64, 0x02,
+ 0x74, 0x0a, 0x63, 0x6c, 0x65, 0x61, 0x72, 0x0c,
+ 0x1b, 0x5b, 0x48, 0x1b, 0x5b, 0x4a, 0x02, 0x71,
+ 0x26, 0x55, 0x6e, 0x6b, 0x6e, 0x6f, 0x77, 0x6e,
+ 0x20, 0x64, 0x69, 0x72, 0x65, 0x63, 0x74, 0x69,
+ 0x76, 0x65, 0x3a, 0x20, 0x2c, 0x5c, 0x68, 0x20,
+ 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+ 0x20, 0x74, 0x68, 0x69, 0x73, 0x20, 0x68, 0x65,
+ 0x6c, 0x70, 0x0a, 0x16, 0x5c, 0x78, 0x20, 0x20,
+ 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x36,
+ 0x68, 0x65, 0x78, 0x61, 0x64, 0x65, 0x63, 0x69,
+ 0x6d, 0x61, 0x6c, 0x20, 0x6e, 0x75, 0x6d, 0x62,
+ 0x65, 0x72, 0x20, 0x64, 0x69, 0x73, 0x70, 0x6c,
+ 0x61, 0x79, 0x0a, 0x16, 0x5c, 0x64, 0x20, 0x20,
+ 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x2e,
+ 0x64, 0x65, 0x63, 0x69, 0x6d, 0x61, 0x6c, 0x20,
+ 0x6e, 0x75, 0x6d, 0x62, 0x65, 0x72, 0x20, 0x64,
+ 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x0a, 0x16,
+ 0x5c, 0x74, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
+ 0x20, 0x20, 0x20, 0x2c, 0x74, 0x6f, 0x67, 0x67,
+ 0x6c, 0x65, 0x20, 0x74, 0x69, 0x6d, 0x69, 0x6e,
+ 0x67, 0x20, 0x64, 0x69, 0x73, 0x70, 0x6c, 0x61,
+ 0x79, 0x0a, 0x3e, 0x5c, 0x63, 0x6c, 0x65, 0x61,
+ 0x72, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x63,
+ 0x6c, 0x65, 0x61, 0x72, 0x20, 0x74, 0x68, 0x65,
+ 0x20, 0x74, 0x65, 0x72, 0x6d, 0x69, 0x6e, 0x61,
+ 0x6c, 0x0a, 0x22, 0x5c, 0x71, 0x20, 0x20, 0x20,
+ 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x65,
+ 0x78, 0x69, 0x74, 0x0a, 0x06, 0x73, 0x65, 0x6c,
+ 0x3a, 0x51, 0x75, 0x69, 0x63, 0x6b, 0x4a, 0x53,
+ 0x20, 0x2d, 0x20, 0x54, 0x79, 0x70, 0x65, 0x20,
+ 0x22, 0x5c, 0x68, 0x22, 0x20, 0x66, 0x6f, 0x72,
+ 0x20, 0x68, 0x65, 0x6c, 0x70, 0x0a, 0x08, 0x20,
+ 0x20, 0x20, 0x20, 0x06, 0x6e, 0x6f, 0x77, 0x14,
+ 0x65, 0x76, 0x61, 0x6c, 0x53, 0x63, 0x72, 0x69,
+ 0x70, 0x74, 0x22, 0x62, 0x61, 0x63, 0x6b, 0x74,
+ 0x72, 0x61, 0x63, 0x65, 0x5f, 0x62, 0x61, 0x72,
+ 0x72, 0x69, 0x65, 0x72, 0x02, 0x6e, 0x1a, 0x5f,
+ 0x5f, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x4f, 0x62,
+ 0x6a, 0x65, 0x63, 0x74, 0x0e, 0x54, 0x68, 0x72,
+ 0x6f, 0x77, 0x3a, 0x20, 0x04, 0x67, 0x63, 0x02,
+ 0x7c, 0x6a, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x7c,
+ 0x63, 0x61, 0x73, 0x65, 0x7c, 0x63, 0x61, 0x74,
+ 0x63, 0x68, 0x7c, 0x63, 0x6f, 0x6e, 0x74, 0x69,
+ 0x6e, 0x75, 0x65, 0x7c, 0x64, 0x65, 0x62, 0x75,
+ 0x67, 0x67, 0x65, 0x72, 0x7c, 0x64, 0x65, 0x66,
+ 0x61, 0x75, 0x6c, 0x74, 0x7c, 0x64, 0x65, 0x6c,
+ 0x65, 0x74, 0x65, 0x7c, 0x64, 0x6f, 0x7c, 0x5e,
+ 0x65, 0x6c, 0x73, 0x65, 0x7c, 0x66, 0x69, 0x6e,
+ 0x61, 0x6c, 0x6c, 0x79, 0x7c, 0x66, 0x6f, 0x72,
+ 0x7c, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+ 0x6e, 0x7c, 0x69, 0x66, 0x7c, 0x69, 0x6e, 0x7c,
+ 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65,
+ 0x6f, 0x66, 0x7c, 0x6e, 0x65, 0x77, 0x7c, 0x5e,
+ 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x7c, 0x73,
+ 0x77, 0x69, 0x74, 0x63, 0x68, 0x7c, 0x74, 0x68,
+ 0x69, 0x73, 0x7c, 0x74, 0x68, 0x72, 0x6f, 0x77,
+ 0x7c, 0x74, 0x72, 0x79, 0x7c, 0x74, 0x79, 0x70,
+ 0x65, 0x6f, 0x66, 0x7c, 0x77, 0x68, 0x69, 0x6c,
+ 0x65, 0x7c, 0x77, 0x69, 0x74, 0x68, 0x7c, 0x5a,
+ 0x63, 0x6c, 0x61, 0x73, 0x73, 0x7c, 0x63, 0x6f,
+ 0x6e, 0x73, 0x74, 0x7c, 0x65, 0x6e, 0x75, 0x6d,
+ 0x7c, 0x69, 0x6d, 0x70, 0x6f, 0x72, 0x74, 0x7c,
+ 0x65, 0x78, 0x70, 0x6f, 0x72, 0x74, 0x7c, 0x65,
+ 0x78, 0x74, 0x65, 0x6e, 0x64, 0x73, 0x7c, 0x73,
+ 0x75, 0x70, 0x65, 0x72, 0x7c, 0x66, 0x69, 0x6d,
+ 0x70, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x73,
+ 0x7c, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x66, 0x61,
+ 0x63, 0x65, 0x7c, 0x6c, 0x65, 0x74, 0x7c, 0x70,
+ 0x61, 0x63, 0x6b, 0x61, 0x67, 0x65, 0x7c, 0x70,
+ 0x72, 0x69, 0x76, 0x61, 0x74, 0x65, 0x7c, 0x70,
+ 0x72, 0x6f, 0x74, 0x65, 0x63, 0x74, 0x65, 0x64,
+ 0x7c, 0x28, 0x70, 0x75, 0x62, 0x6c, 0x69, 0x63,
+ 0x7c, 0x73, 0x74, 0x61, 0x74, 0x69, 0x63, 0x7c,
+ 0x79, 0x69, 0x65, 0x6c, 0x64, 0x7c, 0x4e, 0x75,
+ 0x6e, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x64,
+ 0x7c, 0x6e, 0x75, 0x6c, 0x6c, 0x7c, 0x74, 0x72,
+ 0x75, 0x65, 0x7c, 0x66, 0x61, 0x6c, 0x73, 0x65,
+ 0x7c, 0x49, 0x6e, 0x66, 0x69, 0x6e, 0x69, 0x74,
+ 0x79, 0x7c, 0x4e, 0x61, 0x4e, 0x7c, 0x1e, 0x65,
+ 0x76, 0x61, 0x6c, 0x7c, 0x61, 0x72, 0x67, 0x75,
+ 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x7c, 0x0c, 0x61,
+ 0x77, 0x61, 0x69, 0x74, 0x7c, 0x7a, 0x7c, 0x74,
+ 0x68, 0x69, 0x73, 0x7c, 0x73, 0x75, 0x70, 0x65,
+ 0x72, 0x7c, 0x75, 0x6e, 0x64, 0x65, 0x66, 0x69,
+ 0x6e, 0x65, 0x64, 0x7c, 0x6e, 0x75, 0x6c, 0x6c,
+ 0x7c, 0x74, 0x72, 0x75, 0x65, 0x7c, 0x66, 0x61,
+ 0x6c, 0x73, 0x65, 0x7c, 0x49, 0x6e, 0x66, 0x69,
+ 0x6e, 0x69, 0x74, 0x79, 0x7c, 0x4e, 0x61, 0x4e,
+ 0x7c, 0x61, 0x72, 0x67, 0x75, 0x6d, 0x65, 0x6e,
+ 0x74, 0x73, 0x7c, 0x14, 0x7c, 0x76, 0x6f, 0x69,
+ 0x64, 0x7c, 0x76, 0x61, 0x72, 0x7c, 0x02, 0x2b,
+ 0x02, 0x60, 0x02, 0x7b, 0x14, 0x70, 0x75, 0x73,
+ 0x68, 0x5f, 0x73, 0x74, 0x61, 0x74, 0x65, 0x14,
+ 0x6c, 0x61, 0x73, 0x74, 0x5f, 0x73, 0x74, 0x61,
+ 0x74, 0x65, 0x12, 0x70, 0x6f, 0x70, 0x5f, 0x73,
+ 0x74, 0x61, 0x74, 0x65, 0x26, 0x70, 0x61, 0x72,
+ 0x73, 0x65, 0x5f, 0x62, 0x6c, 0x6f, 0x63, 0x6b,
+ 0x5f, 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+ 0x0a, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x02, 0x69,
+ 0x06, 0x73, 0x74, 0x72, 0x24, 0x70, 0x61, 0x72,
+ 0x73, 0x65, 0x5f, 0x6c, 0x69, 0x6e, 0x65, 0x5f,
+ 0x63, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x18,
+ 0x70, 0x61, 0x72, 0x73, 0x65, 0x5f, 0x73, 0x74,
+ 0x72, 0x69, 0x6e, 0x67, 0x16, 0x70, 0x61, 0x72,
+ 0x73, 0x65, 0x5f, 0x72, 0x65, 0x67, 0x65, 0x78,
+ 0x18, 0x70, 0x61, 0x72, 0x73, 0x65, 0x5f, 0x6e,
+ 0x75, 0x6d, 0x62, 0x65, 0x72, 0x20, 0x70, 0x61,
+ 0x72, 0x73, 0x65, 0x5f, 0x69, 0x64, 0x65, 0x6e,
+ 0x74, 0x69, 0x66, 0x69, 0x65, 0x72, 0x12, 0x73,
+ 0x65, 0x74, 0x5f, 0x73, 0x74, 0x79, 0x6c, 0x65,
+ 0x0d, 0xcc, 0x03, 0x02, 0xce, 0x03, 0x02, 0xd0,
+ 0x03, 0x02, 0x00, 0x00, 0x02, 0x00, 0x01, 0xfe,
+ 0x01, 0x00, 0x01, 0x01, 0xfe, 0x01, 0x01, 0x00,
+ 0x0c, 0x23, 0x27, 0x00, 0x00, 0x20, 0x02, 0x01,
+ 0xa4, 0x01, 0x00, 0x00, 0x00, 0x02, 0x02, 0x01,
+ 0x0f, 0x00, 0xce, 0x03, 0x00, 0x0d, 0xd0, 0x03,
+ 0x01, 0x0d, 0x08, 0xec, 0x02, 0x29, 0xc2, 0x00,
+ 0x39, 0x8d, 0x00, 0x00, 0x00, 0xf1, 0x0e, 0x06,
+ 0x2f, 0x0c, 0xfa, 0x26, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0x00, 0x01, 0x74, 0x01, 0x02, 0x02, 0x47,
+ 0xbb, 0x08, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x01,
+ 0x0c, 0xc2, 0x00, 0xc5, 0x28, 0xc2, 0x01, 0xc5,
+ 0x29, 0xc2, 0x02, 0xc5, 0x2a, 0xc2, 0x03, 0xc5,
+ 0x2b, 0xc2, 0x04, 0xc5, 0x2c, 0xc2, 0x05, 0xc5,
+ 0x2d, 0xc2, 0x06, 0xc5, 0x2e, 0xc2, 0x07, 0xc5,
+ 0x2f, 0xc2, 0x08, 0xc5, 0x30, 0xc2, 0x09, 0xc5,
+ 0x31, 0xc2, 0x0a, 0xc5, 0x32, 0xc2, 0x0b, 0xc5,
+ 0x33, 0xc2, 0x0c, 0xc5, 0x34, 0xc2, 0x0d, 0xc5,
+ 0x35, 0xc2, 0x0e, 0xc5, 0x36, 0xc2, 0x0f, 0xc5,
+ 0x37, 0xc2, 0x10, 0xc5, 0x38, 0xc2, 0x11, 0xc5,
+ 0x39, 0xc2, 0x12, 0xc5, 0x3a, 0xc2, 0x13, 0xc5,
+ 0x3b, 0xc2, 0x14, 0xc5, 0x3c, 0xc2, 0x15, 0xc5,
+ 0x3d, 0xc2, 0x16, 0xc5, 0x3e, 0xc2, 0x17, 0xc5,
+ 0x3f, 0xc2, 0x18, 0xc5, 0x40, 0xc2, 0x19, 0xc5,
+ 0x41, 0xc2, 0x1a, 0xc5, 0x42, 0xc2, 0x1b, 0xc5,
+ 0x43, 0xc2, 0x1c, 0xc5, 0x44, 0xc2, 0x1d, 0xc5,
+ 0x45, 0xc2, 0x1e, 0xc5, 0x46, 0xc2, 0x1f, 0xc5,
+ 0x47, 0xc2, 0x20, 0xc5, 0x48, 0xc2, 0x21, 0xc5,
+ 0x49, 0xc2, 0x22, 0xc5, 0x4a, 0xc2, 0x23, 0xc5,
+ 0x4b, 0xc2, 0x24, 0xc5, 0x4c, 0xc2, 0x25, 0xc5,
+ 0x4d, 0xc2, 0x26, 0xc5, 0x4e, 0xc2, 0x27, 0xc5,
+ 0x4f, 0xc2, 0x28, 0xc5, 0x50, 0xc2, 0x29, 0xc5,
+ 0x51, 0xc2, 0x2a, 0xc5, 0x52, 0xc2, 0x2b, 0xc5,
+ 0x53, 0xc2, 0x2c, 0xc5, 0x54, 0xc2, 0x2d, 0xc5,
+ 0x55, 0xc2, 0x2e, 0xc5, 0x56, 0xc2, 0x2f, 0xc5,
+ 0x57, 0xc2, 0x30, 0xc5, 0x58, 0xc2, 0x31, 0xc5,
+ 0x59, 0xc2, 0x32, 0xc5, 0x5a, 0xc2, 0x33, 0xc5,
+ 0x5b, 0xc2, 0x34, 0xc5, 0x5c, 0xc2, 0x35, 0xc5,
+ 0x5e, 0xc2, 0x36, 0xc5, 0x62, 0xc2, 0x37, 0xc5,
+ 0x63, 0xc2, 0x38, 0xc5, 0x64, 0xc2, 0x39, 0xc5,
+ 0x65, 0xc2, 0x3a, 0xc5, 0x67, 0xc2, 0x3b, 0xc5,
+ 0x68, 0xc2, 0x3c, 0xc5, 0x69, 0xc2, 0x3d, 0xc5,
+ 0x6a, 0xc2, 0x3e, 0xc5, 0x6b, 0xc2, 0x3f, 0xc5,
+ 0x6c, 0xc2, 0x40, 0xc5, 0x6d, 0xc2, 0x41, 0xc5,
+ 0x6e, 0xc2, 0x42, 0xc5, 0x6f, 0xc2, 0x43, 0xc5,
+ 0x70, 0xc2, 0x44, 0xc5, 0x71, 0xc2, 0x45, 0xc5,
+ 0x72, 0xc2, 0x46, 0xc5, 0x73, 0xd3, 0x68, 0x01,
+ 0x00, 0x44, 0xe8, 0x00, 0x00, 0x00, 0xd3, 0x68,
+ 0x00, 0x00, 0x44, 0xe7, 0x00, 0x00, 0x00, 0xd3,
+ 0x42, 0x9d, 0x00, 0x00, 0x00, 0xcb, 0xd3, 0x42,
+ 0xa1, 0x00, 0x00, 0x00, 0xcc, 0xd3, 0x42, 0x9e,
+ 0x00, 0x00, 0x00, 0xcd, 0xd3, 0x42, 0xa7, 0x00,
+ 0x00, 0x00, 0xce, 0xd3, 0x42, 0xa5, 0x00, 0x00,
+ 0x00, 0xc5, 0x04, 0xd3, 0x42, 0xe9, 0x00, 0x00,
+ 0x00, 0xc5, 0x05, 0xd3, 0x42, 0xea, 0x00, 0x00,
+ 0x00, 0xc5, 0x06, 0x0b, 0x04, 0xeb, 0x00, 0x00,
+ 0x00, 0x4e, 0xec, 0x00, 0x00, 0x00, 0x04, 0xed,
+ 0x00, 0x00, 0x00, 0x4e, 0xee, 0x00, 0x00, 0x00,
+ 0x04, 0xef, 0x00, 0x00, 0x00, 0x4e, 0xf0, 0x00,
+ 0x00, 0x00, 0x04, 0xf1, 0x00, 0x00, 0x00, 0x4e,
+ 0xf2, 0x00, 0x00, 0x00, 0x04, 0xf3, 0x00, 0x00,
+ 0x00, 0x4e, 0xf4, 0x00, 0x00, 0x00, 0x04, 0xf5,
+ 0x00, 0x00, 0x00, 0x4e, 0xf6, 0x00, 0x00, 0x00,
+ 0x04, 0xf7, 0x00, 0x00, 0x00, 0x4e, 0xf8, 0x00,
+ 0x00, 0x00, 0x04, 0xf9, 0x00, 0x00, 0x00, 0x4e,
+ 0xfa, 0x00, 0x00, 0x00, 0x04, 0xfb, 0x00, 0x00,
+ 0x00, 0x4e, 0xfc, 0x00, 0x00, 0x00, 0x04, 0xfd,
+ 0x00, 0x00, 0x00, 0x4e, 0xfe, 0x00, 0x00, 0x00,
+ 0x04, 0xfd, 0x00, 0x00, 0x00, 0x4e, 0xff, 0x00,
+ 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x00, 0x4e,
+ 0x01, 0x01, 0x00, 0x00, 0x04, 0x02, 0x01, 0x00,
+ 0x00, 0x4e, 0x03, 0x01, 0x00, 0x00, 0x04, 0x04,
+ 0x01, 0x00, 0x00, 0x4e, 0x05, 0x01, 0x00, 0x00,
+ 0x04, 0x06, 0x01, 0x00, 0x00, 0x4e, 0x07, 0x01,
+ 0x00, 0x00, 0x04, 0x08, 0x01, 0x00, 0x00, 0x4e,
+ 0x09, 0x01, 0x00, 0x00, 0x04, 0x0a, 0x01, 0x00,
+ 0x00, 0x4e, 0x0b, 0x01, 0x00, 0x00, 0x04, 0x0c,
+ 0x01, 0x00, 0x00, 0x4e, 0x0d, 0x01, 0x00, 0x00,
+ 0xc5, 0x07, 0x0b, 0x04, 0x03, 0x01, 0x00, 0x00,
+ 0x4e, 0x16, 0x00, 0x00, 0x00, 0x04, 0xfc, 0x00,
+ 0x00, 0x00, 0x4e, 0x0e, 0x01, 0x00, 0x00, 0x04,
+ 0x0b, 0x01, 0x00, 0x00, 0x4e, 0x4a, 0x00, 0x00,
+ 0x00, 0x04, 0xfa, 0x00, 0x00, 0x00, 0x4e, 0x0f,
+ 0x01, 0x00, 0x00, 0x04, 0xf2, 0x00, 0x00, 0x00,
+ 0x4e, 0x48, 0x00, 0x00, 0x00, 0x04, 0x0d, 0x01,
+ 0x00, 0x00, 0x4e, 0x10, 0x01, 0x00, 0x00, 0x04,
+ 0x05, 0x01, 0x00, 0x00, 0x4e, 0x1b, 0x00, 0x00,
+ 0x00, 0x04, 0x09, 0x01, 0x00, 0x00, 0x4e, 0x11,
+ 0x01, 0x00, 0x00, 0x04, 0x03, 0x01, 0x00, 0x00,
+ 0x4e, 0x12, 0x01, 0x00, 0x00, 0x04, 0xf0, 0x00,
+ 0x00, 0x00, 0x4e, 0x13, 0x01, 0x00, 0x00, 0x04,
+ 0x0d, 0x01, 0x00, 0x00, 0x4e, 0x14, 0x01, 0x00,
+ 0x00, 0x04, 0x01, 0x01, 0x00, 0x00, 0x4e, 0x15,
+ 0x01, 0x00, 0x00, 0xc5, 0x08, 0x26, 0x00, 0x00,
+ 0xc5, 0x09, 0xc3, 0xc5, 0x0a, 0xc3, 0xc5, 0x0e,
+ 0xc3, 0xc5, 0x0f, 0xb7, 0xc5, 0x10, 0x04, 0x16,
+ 0x01, 0x00, 0x00, 0xc5, 0x11, 0x04, 0x17, 0x01,
+ 0x00, 0x00, 0xc5, 0x12, 0x0a, 0xc5, 0x13, 0x09,
+ 0xc5, 0x14, 0x0a, 0xc5, 0x15, 0xb7, 0xc5, 0x17,
+ 0xc3, 0xc5, 0x18, 0xb7, 0xc5, 0x19, 0xc3, 0xc5,
+ 0x1a, 0xb7, 0xc5, 0x1b, 0xc3, 0xc5, 0x1c, 0xb7,
+ 0xc5, 0x1d, 0x09, 0xc5, 0x21, 0xb7, 0xc5, 0x22,
+ 0xb7, 0xc5, 0x23, 0xb7, 0xc5, 0x27, 0x0b, 0xc4,
+ 0x3a, 0x4e, 0x18, 0x01, 0x00, 0x00, 0xc4, 0x3d,
+ 0x4e, 0x19, 0x01, 0x00, 0x00, 0xc4, 0x57, 0x4e,
+ 0x1a, 0x01, 0x00, 0x00, 0xc4, 0x4b, 0x4e, 0x1b,
+ 0x01, 0x00, 0x00, 0xc4, 0x3b, 0x4e, 0x1c, 0x01,
+ 0x00, 0x00, 0xc4, 0x3c, 0x4e, 0x1d, 0x01, 0x00,
+ 0x00, 0xc4, 0x38, 0x4e, 0x1e, 0x01, 0x00, 0x00,
+ 0xc4, 0x4c, 0x4e, 0x1f, 0x01, 0x00, 0x00, 0xc4,
+ 0x5c, 0x4e, 0x20, 0x01, 0x00, 0x00, 0xc4, 0x42,
+ 0x4e, 0x21, 0x01, 0x00, 0x00, 0xc4, 0x52, 0x4e,
+ 0x22, 0x01, 0x00, 0x00, 0xc4, 0x42, 0x4e, 0x23,
+ 0x01, 0x00, 0x00, 0xc4, 0x45, 0x4e, 0x24, 0x01,
+ 0x00, 0x00, 0xc4, 0x44, 0x4e, 0x25, 0x01, 0x00,
+ 0x00, 0xc4, 0x37, 0x4e, 0x26, 0x01, 0x00, 0x00,
+ 0xc4, 0x39, 0x4e, 0x27, 0x01, 0x00, 0x00, 0xc4,
+ 0x39, 0x4e, 0x28, 0x01, 0x00, 0x00, 0xc4, 0x4d,
+ 0x4e, 0x29, 0x01, 0x00, 0x00, 0xc4, 0x58, 0x4e,
+ 0x2a, 0x01, 0x00, 0x00, 0xc4, 0x56, 0x4e, 0x2b,
+ 0x01, 0x00, 0x00, 0xc4, 0x44, 0x4e, 0x2c, 0x01,
+ 0x00, 0x00, 0xc4, 0x45, 0x4e, 0x2d, 0x01, 0x00,
+ 0x00, 0xc4, 0x3c, 0x4e, 0x2e, 0x01, 0x00, 0x00,
+ 0xc4, 0x3d, 0x4e, 0x2f, 0x01, 0x00, 0x00, 0xc4,
+ 0x40, 0x4e, 0x30, 0x01, 0x00, 0x00, 0xc4, 0x41,
+ 0x4e, 0x31, 0x01, 0x00, 0x00, 0xc4, 0x40, 0x4e,
+ 0x32, 0x01, 0x00, 0x00, 0xc4, 0x41, 0x4e, 0x33,
+ 0x01, 0x00, 0x00, 0xc4, 0x3a, 0x4e, 0x34, 0x01,
+ 0x00, 0x00, 0xc4, 0x4a, 0x4e, 0x35, 0x01, 0x00,
+ 0x00, 0xc4, 0x3b, 0x4e, 0x36, 0x01, 0x00, 0x00,
+ 0xc4, 0x47, 0x4e, 0x37, 0x01, 0x00, 0x00, 0xc4,
+ 0x48, 0x4e, 0x38, 0x01, 0x00, 0x00, 0xc4, 0x44,
+ 0x4e, 0x39, 0x01, 0x00, 0x00, 0xc4, 0x45, 0x4e,
+ 0x3a, 0x01, 0x00, 0x00, 0xc4, 0x3c, 0x4e, 0x3b,
+ 0x01, 0x00, 0x00, 0xc4, 0x3d, 0x4e, 0x3c, 0x01,
+ 0x00, 0x00, 0xc4, 0x3b, 0x4e, 0x3d, 0x01, 0x00,
+ 0x00, 0xc4, 0x3a, 0x4e, 0x3e, 0x01, 0x00, 0x00,
+ 0xc4, 0x55, 0x4e, 0x3f, 0x01, 0x00, 0x00, 0xc4,
+ 0x41, 0x4e, 0x40, 0x01, 0x00, 0x00, 0xc4, 0x54,
+ 0x4e, 0x41, 0x01, 0x00, 0x00, 0xc4, 0x40, 0x4e,
+ 0x42, 0x01, 0x00, 0x00, 0xc4, 0x53, 0x4e, 0x43,
+ 0x01, 0x00, 0x00, 0xc4, 0x50, 0x4e, 0x44, 0x01,
+ 0x00, 0x00, 0xc4, 0x4e, 0x4e, 0x45, 0x01, 0x00,
+ 0x00, 0xc4, 0x4f, 0x4e, 0x46, 0x01, 0x00, 0x00,
+ 0xc4, 0x4c, 0x4e, 0x47, 0x01, 0x00, 0x00, 0xc5,
+ 0x5d, 0x09, 0xc5, 0x66, 0xc4, 0x28, 0xf0, 0x0e,
+ 0xc4, 0x6b, 0xf0, 0x29, 0x0c, 0xae, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0x90, 0x05, 0x00, 0x01,
+ 0x00, 0x04, 0x07, 0x00, 0x8b, 0x01, 0x00, 0x00,
+ 0x24, 0x01, 0x00, 0x00, 0x0c, 0x00, 0x26, 0x01,
+ 0x00, 0x01, 0x0c, 0x00, 0x29, 0x01, 0x00, 0x25,
+ 0x01, 0x00, 0x2a, 0x01, 0x68, 0x01, 0x00, 0x42,
+ 0x0d, 0x00, 0x00, 0x00, 0x43, 0x49, 0x01, 0x00,
+ 0x00, 0x24, 0x00, 0x00, 0xe3, 0xbf, 0x50, 0xe5,
+ 0x68, 0x03, 0x00, 0x43, 0x4a, 0x01, 0x00, 0x00,
+ 0xdf, 0x24, 0x01, 0x00, 0xec, 0x35, 0x68, 0x03,
+ 0x00, 0x42, 0x4b, 0x01, 0x00, 0x00, 0xec, 0x14,
+ 0x68, 0x03, 0x00, 0x43, 0x4b, 0x01, 0x00, 0x00,
+ 0xdf, 0x24, 0x01, 0x00, 0xcf, 0xec, 0x05, 0xc7,
+ 0xb7, 0x48, 0xe5, 0x68, 0x03, 0x00, 0x42, 0x4c,
+ 0x01, 0x00, 0x00, 0xec, 0x0e, 0x68, 0x03, 0x00,
+ 0x43, 0x4c, 0x01, 0x00, 0x00, 0xdf, 0x24, 0x01,
+ 0x00, 0x0e, 0x68, 0x03, 0x00, 0x43, 0x4d, 0x01,
+ 0x00, 0x00, 0x68, 0x03, 0x00, 0x42, 0x4e, 0x01,
+ 0x00, 0x00, 0x60, 0x04, 0x00, 0x24, 0x02, 0x00,
+ 0x0e, 0x39, 0xb0, 0x00, 0x00, 0x00, 0x11, 0xbf,
+ 0x40, 0x21, 0x01, 0x00, 0x61, 0x05, 0x00, 0x68,
+ 0x03, 0x00, 0x43, 0x4f, 0x01, 0x00, 0x00, 0xdf,
+ 0x60, 0x06, 0x00, 0x24, 0x02, 0x00, 0x29, 0x0c,
+ 0x15, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xa0,
+ 0x05, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x04,
+ 0x00, 0xa2, 0x05, 0x2b, 0x01, 0xdf, 0xba, 0xf1,
+ 0x29, 0x0c, 0x41, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xa4, 0x05, 0x00, 0x02, 0x00, 0x06, 0x04,
+ 0x00, 0x28, 0x00, 0x00, 0x01, 0x0c, 0x00, 0x24,
+ 0x01, 0x00, 0x25, 0x01, 0x00, 0x2b, 0x01, 0x68,
+ 0x00, 0x00, 0x43, 0x53, 0x01, 0x00, 0x00, 0xe0,
+ 0xe1, 0x42, 0x54, 0x01, 0x00, 0x00, 0xb7, 0xe1,
+ 0xeb, 0x24, 0x04, 0x00, 0xcb, 0xb7, 0xcc, 0xc8,
+ 0xc7, 0xa5, 0xec, 0x0b, 0xe2, 0xe1, 0xc8, 0x48,
+ 0xf1, 0x0e, 0x95, 0x01, 0xee, 0xf2, 0x29, 0x0c,
+ 0x78, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xa2,
+ 0x05, 0x01, 0x00, 0x01, 0x04, 0x04, 0x00, 0x5f,
+ 0x00, 0x00, 0x13, 0x01, 0x00, 0x64, 0x01, 0x00,
+ 0x22, 0x01, 0x00, 0x23, 0x01, 0xdf, 0x98, 0xec,
+ 0x06, 0xe0, 0xd3, 0xf1, 0x0e, 0x29, 0xe1, 0xb7,
+ 0xae, 0xec, 0x24, 0xd3, 0xc0, 0x80, 0x00, 0xa8,
+ 0xec, 0x1d, 0xd3, 0xc0, 0xc0, 0x00, 0xa5, 0xec,
+ 0x16, 0xe2, 0xbd, 0xa2, 0xd3, 0xbf, 0x3f, 0xaf,
+ 0xb1, 0xe6, 0xe1, 0x90, 0xe9, 0xb7, 0xad, 0xec,
+ 0x33, 0xe0, 0xe2, 0xf1, 0x0e, 0x29, 0xd3, 0xc0,
+ 0xc0, 0x00, 0xa8, 0xec, 0x21, 0xd3, 0xc0, 0xf8,
+ 0x00, 0xa5, 0xec, 0x1a, 0xb8, 0xd3, 0xc0, 0xe0,
+ 0x00, 0xa8, 0x9f, 0xd3, 0xc0, 0xf0, 0x00, 0xa8,
+ 0x9f, 0xe5, 0xd3, 0xb8, 0xbd, 0xe1, 0xa0, 0xa2,
+ 0xb8, 0xa0, 0xaf, 0xe6, 0x29, 0xb7, 0xe5, 0xe0,
+ 0xd3, 0xf1, 0x0e, 0x29, 0x0c, 0x42, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xaa, 0x05, 0x01, 0x00,
+ 0x01, 0x02, 0x00, 0x00, 0x35, 0x00, 0xd3, 0x99,
+ 0x04, 0x4a, 0x00, 0x00, 0x00, 0xad, 0x11, 0xec,
+ 0x2a, 0x0e, 0xd3, 0x04, 0x56, 0x01, 0x00, 0x00,
+ 0xa8, 0x11, 0xec, 0x09, 0x0e, 0xd3, 0x04, 0x57,
+ 0x01, 0x00, 0x00, 0xa6, 0x11, 0xed, 0x14, 0x0e,
+ 0xd3, 0x04, 0x58, 0x01, 0x00, 0x00, 0xa8, 0x11,
+ 0xec, 0x09, 0x0e, 0xd3, 0x04, 0x59, 0x01, 0x00,
+ 0x00, 0xa6, 0x28, 0x0c, 0x2c, 0x00, 0x00, 0x00,
+ 0x43, 0x02, 0x01, 0xb4, 0x05, 0x01, 0x00, 0x01,
+ 0x02, 0x00, 0x02, 0x19, 0x00, 0xd3, 0x99, 0x04,
+ 0x4a, 0x00, 0x00, 0x00, 0xad, 0x11, 0xec, 0x0e,
+ 0x0e, 0xd3, 0xc1, 0x00, 0xa8, 0x11, 0xec, 0x06,
+ 0x0e, 0xd3, 0xc1, 0x01, 0xa6, 0x28, 0x07, 0x02,
+ 0x30, 0x07, 0x02, 0x39, 0x0c, 0x40, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xb6, 0x05, 0x01, 0x00,
+ 0x01, 0x02, 0x02, 0x00, 0x2d, 0x00, 0x00, 0x2c,
+ 0x01, 0x00, 0x2d, 0x01, 0xd3, 0x99, 0x04, 0x4a,
+ 0x00, 0x00, 0x00, 0xad, 0x11, 0xec, 0x22, 0x0e,
+ 0xdf, 0xd3, 0xf1, 0x11, 0xed, 0x1b, 0x0e, 0xe0,
+ 0xd3, 0xf1, 0x11, 0xed, 0x14, 0x0e, 0xd3, 0x04,
+ 0x5c, 0x01, 0x00, 0x00, 0xab, 0x11, 0xed, 0x09,
+ 0x0e, 0xd3, 0x04, 0x5d, 0x01, 0x00, 0x00, 0xab,
+ 0x28, 0x0c, 0x3f, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xbc, 0x05, 0x01, 0x04, 0x01, 0x03, 0x00,
+ 0x00, 0x32, 0x00, 0xd3, 0xeb, 0xce, 0xb7, 0xcb,
+ 0xb7, 0xcd, 0xc9, 0xca, 0xa5, 0xec, 0x25, 0xd3,
+ 0x43, 0x5f, 0x01, 0x00, 0x00, 0xc9, 0x24, 0x01,
+ 0x00, 0xd0, 0x01, 0x00, 0xdc, 0x00, 0x00, 0xa5,
+ 0x11, 0xed, 0x09, 0x0e, 0xc8, 0x01, 0x00, 0xe0,
+ 0x00, 0x00, 0xa8, 0xec, 0x03, 0x95, 0x00, 0x95,
+ 0x02, 0xee, 0xd8, 0xc7, 0x28, 0x0c, 0x36, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xc0, 0x05, 0x01,
+ 0x01, 0x01, 0x03, 0x00, 0x00, 0x29, 0x00, 0xd3,
+ 0x99, 0x04, 0x4a, 0x00, 0x00, 0x00, 0xae, 0xec,
+ 0x03, 0x09, 0x28, 0xd3, 0x43, 0x61, 0x01, 0x00,
+ 0x00, 0xb7, 0x24, 0x01, 0x00, 0xcf, 0x01, 0x00,
+ 0xdc, 0x00, 0x00, 0xa8, 0x11, 0xec, 0x09, 0x0e,
+ 0xc7, 0x01, 0x00, 0xe0, 0x00, 0x00, 0xa5, 0x28,
+ 0x0c, 0x30, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xc4, 0x05, 0x02, 0x00, 0x02, 0x03, 0x00, 0x00,
+ 0x23, 0x00, 0xd3, 0xd4, 0x9f, 0x11, 0x04, 0x63,
+ 0x01, 0x00, 0x00, 0xad, 0xed, 0x13, 0x11, 0x04,
+ 0x64, 0x01, 0x00, 0x00, 0xad, 0xed, 0x0a, 0x11,
+ 0x04, 0x65, 0x01, 0x00, 0x00, 0xad, 0xec, 0x03,
+ 0x0a, 0x28, 0x0e, 0x09, 0x28, 0x0c, 0x79, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xcc, 0x05, 0x03,
+ 0x03, 0x03, 0x06, 0x03, 0x00, 0x63, 0x00, 0x00,
+ 0x00, 0x0c, 0x00, 0x07, 0x01, 0x00, 0x08, 0x01,
+ 0xd4, 0xcc, 0xc8, 0xd3, 0xeb, 0xa5, 0xec, 0x5b,
+ 0xd5, 0xc8, 0xcf, 0x48, 0xcd, 0xc8, 0x91, 0xd0,
+ 0xd3, 0xeb, 0xa5, 0xec, 0x08, 0xd5, 0xc8, 0x48,
+ 0xc9, 0xab, 0xed, 0xf2, 0x68, 0x00, 0x00, 0x43,
+ 0x67, 0x01, 0x00, 0x00, 0xe0, 0xe1, 0xc9, 0x48,
+ 0x11, 0xed, 0x07, 0x0e, 0x04, 0x16, 0x00, 0x00,
+ 0x00, 0x48, 0x24, 0x01, 0x00, 0x0e, 0x68, 0x00,
+ 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0xd3, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xc7, 0xc8, 0x24, 0x02,
+ 0x00, 0x24, 0x01, 0x00, 0x0e, 0x68, 0x00, 0x00,
+ 0x43, 0x67, 0x01, 0x00, 0x00, 0xe0, 0x04, 0xec,
+ 0x00, 0x00, 0x00, 0x48, 0x24, 0x01, 0x00, 0x0e,
+ 0xee, 0xa1, 0x29, 0x0c, 0x2d, 0x00, 0x00, 0x00,
+ 0x43, 0x02, 0x01, 0xd2, 0x05, 0x02, 0x00, 0x02,
+ 0x05, 0x01, 0x00, 0x1d, 0x00, 0x00, 0x00, 0x0c,
+ 0x68, 0x00, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00,
+ 0x04, 0x6a, 0x01, 0x00, 0x00, 0xd3, 0xb8, 0xac,
+ 0xec, 0x04, 0xd3, 0xee, 0x02, 0xc3, 0x9f, 0xd4,
+ 0x9f, 0x24, 0x01, 0x00, 0x29, 0x0c, 0xbe, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xd6, 0x05, 0x01,
+ 0x02, 0x01, 0x04, 0x05, 0x00, 0xa1, 0x01, 0x00,
+ 0x00, 0x27, 0x01, 0x00, 0x26, 0x01, 0x00, 0x00,
+ 0x0c, 0x00, 0x04, 0x01, 0x00, 0x33, 0x01, 0xd3,
+ 0xb7, 0xa7, 0xec, 0x4d, 0xd3, 0xb7, 0xac, 0x6c,
+ 0x97, 0x00, 0x00, 0x00, 0xdf, 0xe0, 0xb8, 0xa0,
+ 0xab, 0xec, 0x19, 0x68, 0x02, 0x00, 0x43, 0x67,
+ 0x01, 0x00, 0x00, 0x04, 0x21, 0x01, 0x00, 0x00,
+ 0x24, 0x01, 0x00, 0x0e, 0xb7, 0xe3, 0xd3, 0x90,
+ 0xd7, 0xee, 0xda, 0xe2, 0x43, 0x6c, 0x01, 0x00,
+ 0x00, 0xe0, 0xb8, 0xa0, 0xdf, 0xa0, 0xd3, 0x24,
+ 0x02, 0x00, 0xcc, 0x60, 0x04, 0x00, 0xc8, 0x04,
+ 0x6d, 0x01, 0x00, 0x00, 0xf2, 0x0e, 0xd3, 0xc8,
+ 0xa0, 0xd7, 0xdf, 0xc8, 0x9f, 0xe3, 0xee, 0xb5,
+ 0xd3, 0x8e, 0xd7, 0xd3, 0xb7, 0xac, 0xec, 0x48,
+ 0xdf, 0xb7, 0xab, 0xec, 0x22, 0x60, 0x04, 0x00,
+ 0xb8, 0x04, 0x56, 0x01, 0x00, 0x00, 0xf2, 0x0e,
+ 0x60, 0x04, 0x00, 0xe0, 0xb8, 0xa0, 0x04, 0x6d,
+ 0x01, 0x00, 0x00, 0xf2, 0x0e, 0xd3, 0x90, 0xd7,
+ 0xe0, 0xb8, 0xa0, 0xe3, 0xee, 0xd6, 0xe2, 0x43,
+ 0x6c, 0x01, 0x00, 0x00, 0xd3, 0xdf, 0x24, 0x02,
+ 0x00, 0xcc, 0x60, 0x04, 0x00, 0xc8, 0x04, 0x6e,
+ 0x01, 0x00, 0x00, 0xf2, 0x0e, 0xd3, 0xc8, 0xa0,
+ 0xd7, 0xdf, 0xc8, 0xa0, 0xe3, 0xee, 0xb5, 0x29,
+ 0x0c, 0x51, 0x01, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xde, 0x05, 0x00, 0x05, 0x00, 0x06, 0x0d, 0x00,
+ 0x9c, 0x02, 0x00, 0x00, 0x1a, 0x01, 0x00, 0x1c,
+ 0x01, 0x00, 0x15, 0x01, 0x00, 0x1d, 0x01, 0x00,
+ 0x00, 0x0c, 0x00, 0x34, 0x01, 0x00, 0x2f, 0x01,
+ 0x00, 0x18, 0x01, 0x00, 0x73, 0x01, 0x00, 0x32,
+ 0x01, 0x00, 0x27, 0x01, 0x00, 0x26, 0x01, 0x00,
+ 0x1b, 0x01, 0xdf, 0xe0, 0xac, 0x6c, 0xc6, 0x00,
+ 0x00, 0x00, 0xe1, 0x98, 0xec, 0x32, 0xe0, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xb7, 0xe2, 0x24, 0x02,
+ 0x00, 0xdf, 0x43, 0x68, 0x01, 0x00, 0x00, 0xb7,
+ 0xe2, 0x24, 0x02, 0x00, 0xab, 0xec, 0x19, 0x68,
+ 0x04, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0xdf,
+ 0x43, 0x68, 0x01, 0x00, 0x00, 0xe2, 0x24, 0x01,
+ 0x00, 0x24, 0x01, 0x00, 0x0e, 0xee, 0x53, 0x60,
+ 0x05, 0x00, 0x60, 0x06, 0x00, 0xe0, 0x43, 0x68,
+ 0x01, 0x00, 0x00, 0xb7, 0xe2, 0x24, 0x02, 0x00,
+ 0xf1, 0x8e, 0xf1, 0x0e, 0xe1, 0xec, 0x2e, 0x60,
+ 0x07, 0x00, 0xec, 0x0e, 0x60, 0x07, 0x00, 0x04,
+ 0x21, 0x01, 0x00, 0x00, 0x9f, 0xdf, 0x9f, 0xee,
+ 0x02, 0xdf, 0xd1, 0xeb, 0xdf, 0xeb, 0xa0, 0xce,
+ 0x60, 0x08, 0x00, 0xc9, 0xf1, 0xc5, 0x04, 0x60,
+ 0x09, 0x00, 0xc9, 0xca, 0xc4, 0x04, 0xb9, 0x48,
+ 0xf3, 0x0e, 0xee, 0x0e, 0x68, 0x04, 0x00, 0x43,
+ 0x67, 0x01, 0x00, 0x00, 0xdf, 0x24, 0x01, 0x00,
+ 0x0e, 0x60, 0x0a, 0x00, 0x60, 0x06, 0x00, 0xdf,
+ 0xf1, 0x9f, 0x60, 0x0b, 0x00, 0x9e, 0x62, 0x0a,
+ 0x00, 0xb7, 0xab, 0xec, 0x12, 0x68, 0x04, 0x00,
+ 0x43, 0x67, 0x01, 0x00, 0x00, 0x04, 0x70, 0x01,
+ 0x00, 0x00, 0x24, 0x01, 0x00, 0x0e, 0x68, 0x04,
+ 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0x04, 0x71,
+ 0x01, 0x00, 0x00, 0x24, 0x01, 0x00, 0x0e, 0xdf,
+ 0xe4, 0xdf, 0xeb, 0xe6, 0x60, 0x0c, 0x00, 0xe2,
+ 0xa7, 0xec, 0x19, 0x60, 0x05, 0x00, 0x60, 0x06,
+ 0x00, 0xdf, 0x43, 0x68, 0x01, 0x00, 0x00, 0xe2,
+ 0x60, 0x0c, 0x00, 0x24, 0x02, 0x00, 0xf1, 0xf1,
+ 0x0e, 0xee, 0x1f, 0x60, 0x0c, 0x00, 0xe2, 0xa5,
+ 0xec, 0x18, 0x60, 0x05, 0x00, 0x60, 0x06, 0x00,
+ 0xdf, 0x43, 0x68, 0x01, 0x00, 0x00, 0x60, 0x0c,
+ 0x00, 0xe2, 0x24, 0x02, 0x00, 0xf1, 0x8e, 0xf1,
+ 0x0e, 0x60, 0x0c, 0x00, 0xe6, 0x68, 0x04, 0x00,
+ 0x42, 0x72, 0x01, 0x00, 0x00, 0x43, 0x73, 0x01,
+ 0x00, 0x00, 0x24, 0x00, 0x00, 0x29, 0x0c, 0x35,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xe8, 0x05,
+ 0x01, 0x00, 0x01, 0x04, 0x02, 0x00, 0x22, 0x00,
+ 0x00, 0x1a, 0x01, 0x00, 0x1b, 0x01, 0xd3, 0xec,
+ 0x1f, 0xdf, 0x43, 0x68, 0x01, 0x00, 0x00, 0xb7,
+ 0xe0, 0x24, 0x02, 0x00, 0xd3, 0x9f, 0xdf, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xe0, 0x24, 0x01, 0x00,
+ 0x9f, 0xe3, 0xe0, 0xd3, 0xeb, 0x9f, 0xe4, 0x29,
+ 0x0c, 0x14, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xea, 0x05, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00,
+ 0x03, 0x00, 0xec, 0x05, 0x21, 0x01, 0x0a, 0xe3,
+ 0x29, 0x0c, 0x1c, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xee, 0x05, 0x00, 0x00, 0x00, 0x01, 0x02,
+ 0x00, 0x07, 0x00, 0xf0, 0x05, 0x1a, 0x01, 0xf2,
+ 0x05, 0x1b, 0x01, 0xc3, 0xe3, 0xb7, 0xe4, 0xbf,
+ 0xfe, 0x28, 0x0c, 0x0e, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xf4, 0x05, 0x00, 0x00, 0x00, 0x00,
+ 0x00, 0x00, 0x01, 0x00, 0x29, 0x0c, 0x14, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xf6, 0x05, 0x00,
+ 0x00, 0x00, 0x01, 0x01, 0x00, 0x03, 0x00, 0xf2,
+ 0x05, 0x1b, 0x01, 0xb7, 0xe3, 0x29, 0x0c, 0x19,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xf8, 0x05,
+ 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x04, 0x00,
+ 0xf2, 0x05, 0x1b, 0x01, 0xf0, 0x05, 0x1a, 0x01,
+ 0xe0, 0xeb, 0xe3, 0x29, 0x0c, 0x36, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xfa, 0x05, 0x00, 0x00,
+ 0x00, 0x04, 0x03, 0x00, 0x1d, 0x00, 0xf2, 0x05,
+ 0x1b, 0x01, 0xf0, 0x05, 0x1a, 0x01, 0xc0, 0x05,
+ 0x30, 0x01, 0xdf, 0xe0, 0xeb, 0xa5, 0xec, 0x17,
+ 0xdf, 0x91, 0xe3, 0xe1, 0xe0, 0x43, 0x7e, 0x01,
+ 0x00, 0x00, 0xdf, 0x24, 0x01, 0x00, 0xf1, 0xec,
+ 0x06, 0xdf, 0x91, 0xe3, 0xee, 0xee, 0x29, 0x0c,
+ 0x35, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xfe,
+ 0x05, 0x00, 0x00, 0x00, 0x04, 0x03, 0x00, 0x1c,
+ 0x00, 0xf2, 0x05, 0x1b, 0x01, 0xc0, 0x05, 0x30,
+ 0x01, 0xf0, 0x05, 0x1a, 0x01, 0xdf, 0xb7, 0xa7,
+ 0xec, 0x17, 0xdf, 0x90, 0xe3, 0xe0, 0xe1, 0x43,
+ 0x7e, 0x01, 0x00, 0x00, 0xdf, 0x24, 0x01, 0x00,
+ 0xf1, 0xec, 0x06, 0xdf, 0x90, 0xe3, 0xee, 0xee,
+ 0x29, 0x0c, 0x48, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0x80, 0x06, 0x01, 0x00, 0x01, 0x04, 0x02,
+ 0x00, 0x35, 0x00, 0x00, 0x1a, 0x01, 0x00, 0x2e,
+ 0x01, 0xd3, 0xdf, 0xeb, 0xa5, 0xec, 0x15, 0xe0,
+ 0xdf, 0x43, 0x7e, 0x01, 0x00, 0x00, 0xd3, 0x24,
+ 0x01, 0x00, 0xf1, 0x98, 0xec, 0x06, 0xd3, 0x91,
+ 0xd7, 0xee, 0xe7, 0xd3, 0xdf, 0xeb, 0xa5, 0xec,
+ 0x14, 0xe0, 0xdf, 0x43, 0x7e, 0x01, 0x00, 0x00,
+ 0xd3, 0x24, 0x01, 0x00, 0xf1, 0xec, 0x06, 0xd3,
+ 0x91, 0xd7, 0xee, 0xe8, 0xd3, 0x28, 0x0c, 0x4a,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0x82, 0x06,
+ 0x01, 0x00, 0x01, 0x05, 0x02, 0x00, 0x37, 0x00,
+ 0x00, 0x2e, 0x01, 0x00, 0x1a, 0x01, 0xd3, 0xb7,
+ 0xa7, 0xec, 0x17, 0xdf, 0xe0, 0x43, 0x7e, 0x01,
+ 0x00, 0x00, 0xd3, 0xb8, 0xa0, 0x24, 0x01, 0x00,
+ 0xf1, 0x98, 0xec, 0x06, 0xd3, 0x90, 0xd7, 0xee,
+ 0xe6, 0xd3, 0xb7, 0xa7, 0xec, 0x16, 0xdf, 0xe0,
+ 0x43, 0x7e, 0x01, 0x00, 0x00, 0xd3, 0xb8, 0xa0,
+ 0x24, 0x01, 0x00, 0xf1, 0xec, 0x06, 0xd3, 0x90,
+ 0xd7, 0xee, 0xe7, 0xd3, 0x28, 0x0c, 0x1a, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0x84, 0x06, 0x00,
+ 0x00, 0x00, 0x02, 0x02, 0x00, 0x05, 0x00, 0xf2,
+ 0x05, 0x1b, 0x01, 0x80, 0x06, 0x3e, 0x01, 0xe0,
+ 0xdf, 0xf1, 0xe3, 0x29, 0x0c, 0x1a, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0x86, 0x06, 0x00, 0x00,
+ 0x00, 0x02, 0x02, 0x00, 0x05, 0x00, 0xf2, 0x05,
+ 0x1b, 0x01, 0x82, 0x06, 0x3f, 0x01, 0xe0, 0xdf,
+ 0xf1, 0xe3, 0x29, 0x0c, 0x30, 0x00, 0x00, 0x00,
+ 0x43, 0x02, 0x01, 0x88, 0x06, 0x00, 0x00, 0x00,
+ 0x03, 0x03, 0x00, 0x17, 0x00, 0xce, 0x03, 0x00,
+ 0x0c, 0x8a, 0x06, 0x43, 0x01, 0xf0, 0x05, 0x1a,
+ 0x01, 0x68, 0x00, 0x00, 0x43, 0x67, 0x01, 0x00,
+ 0x00, 0x04, 0x21, 0x01, 0x00, 0x00, 0x24, 0x01,
+ 0x00, 0x0e, 0xe0, 0xe1, 0xf1, 0x0e, 0xb6, 0x28,
+ 0x0c, 0x25, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0x8a, 0x06, 0x01, 0x00, 0x01, 0x03, 0x02, 0x00,
+ 0x12, 0x00, 0x00, 0x09, 0x01, 0x00, 0x1e, 0x01,
+ 0xd3, 0xec, 0x0c, 0xdf, 0x43, 0x86, 0x01, 0x00,
+ 0x00, 0xd3, 0x24, 0x01, 0x00, 0x0e, 0xdf, 0xeb,
+ 0xe4, 0x29, 0x0c, 0x3d, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0x8e, 0x06, 0x00, 0x00, 0x00, 0x03,
+ 0x04, 0x00, 0x20, 0x00, 0x90, 0x06, 0x1e, 0x01,
+ 0x92, 0x06, 0x09, 0x01, 0xf0, 0x05, 0x1a, 0x01,
+ 0xf2, 0x05, 0x1b, 0x01, 0xdf, 0xb7, 0xa7, 0xec,
+ 0x1b, 0xdf, 0xe0, 0xeb, 0xab, 0xec, 0x0c, 0xe0,
+ 0x43, 0x86, 0x01, 0x00, 0x00, 0xe1, 0x24, 0x01,
+ 0x00, 0x0e, 0xdf, 0x90, 0xe3, 0xe0, 0xdf, 0x48,
+ 0xe9, 0xeb, 0xe6, 0x29, 0x0c, 0x2f, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0x94, 0x06, 0x00, 0x00,
+ 0x00, 0x03, 0x04, 0x00, 0x12, 0x00, 0x90, 0x06,
+ 0x1e, 0x01, 0x92, 0x06, 0x09, 0x01, 0xf0, 0x05,
+ 0x1a, 0x01, 0xf2, 0x05, 0x1b, 0x01, 0xdf, 0xe0,
+ 0xeb, 0xb8, 0xa0, 0xa5, 0xec, 0x0a, 0xdf, 0x91,
+ 0xe3, 0xe0, 0xdf, 0x48, 0xe9, 0xeb, 0xe6, 0x29,
+ 0x0c, 0x56, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0x96, 0x06, 0x01, 0x03, 0x01, 0x05, 0x04, 0x00,
+ 0x3d, 0x00, 0x00, 0x1b, 0x01, 0x00, 0x09, 0x01,
+ 0x00, 0x1e, 0x01, 0x00, 0x1a, 0x01, 0xdf, 0xcb,
+ 0xb8, 0xcc, 0xc8, 0xe0, 0xeb, 0xa6, 0xec, 0x33,
+ 0xe0, 0xeb, 0xc8, 0xd3, 0x9c, 0x9f, 0xe1, 0x9f,
+ 0xe0, 0xeb, 0x9e, 0xcd, 0xe0, 0xc9, 0x48, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xb7, 0xc7, 0x24, 0x02,
+ 0x00, 0xe2, 0x43, 0x68, 0x01, 0x00, 0x00, 0xb7,
+ 0xc7, 0x24, 0x02, 0x00, 0xab, 0xec, 0x08, 0xc9,
+ 0xe5, 0xe0, 0xc9, 0x48, 0xe6, 0x29, 0x95, 0x01,
+ 0xee, 0xc9, 0x29, 0x0c, 0x16, 0x00, 0x00, 0x00,
+ 0x43, 0x02, 0x01, 0x98, 0x06, 0x00, 0x00, 0x00,
+ 0x02, 0x01, 0x00, 0x05, 0x00, 0x96, 0x06, 0x46,
+ 0x01, 0xdf, 0xb6, 0x23, 0x01, 0x00, 0x0c, 0x16,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0x9a, 0x06,
+ 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x05, 0x00,
+ 0x96, 0x06, 0x46, 0x01, 0xdf, 0xb8, 0x23, 0x01,
+ 0x00, 0x0c, 0x82, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0x9c, 0x06, 0x01, 0x02, 0x01, 0x04, 0x05,
+ 0x00, 0x66, 0x00, 0x00, 0x1b, 0x01, 0x00, 0x30,
+ 0x01, 0x00, 0x1a, 0x01, 0x00, 0x20, 0x01, 0x00,
+ 0x51, 0x01, 0xdf, 0xcb, 0xd3, 0xb7, 0xa5, 0xec,
+ 0x15, 0x94, 0x00, 0xe0, 0xe1, 0x43, 0x7e, 0x01,
+ 0x00, 0x00, 0xc7, 0x24, 0x01, 0x00, 0xf1, 0xec,
+ 0x05, 0x94, 0x00, 0xee, 0xef, 0xc7, 0xb8, 0x9f,
+ 0xcc, 0xe0, 0xe1, 0x43, 0x7e, 0x01, 0x00, 0x00,
+ 0xc8, 0x24, 0x01, 0x00, 0xf1, 0xec, 0x05, 0x95,
+ 0x01, 0xee, 0xef, 0xc7, 0xb7, 0xa8, 0xec, 0x30,
+ 0xc7, 0xe1, 0xeb, 0xa5, 0xec, 0x2a, 0xe2, 0x60,
+ 0x04, 0x00, 0xad, 0xec, 0x0a, 0x60, 0x04, 0x00,
+ 0xc7, 0xc8, 0xd3, 0xf3, 0x0e, 0x29, 0xe1, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xb7, 0xc7, 0x24, 0x02,
+ 0x00, 0xe1, 0x43, 0x68, 0x01, 0x00, 0x00, 0xc8,
+ 0x24, 0x01, 0x00, 0x9f, 0xe5, 0xc7, 0xe3, 0x29,
+ 0x0c, 0x15, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0x9e, 0x06, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00,
+ 0x04, 0x00, 0x9c, 0x06, 0x49, 0x01, 0xdf, 0xb8,
+ 0xf1, 0x29, 0x0c, 0x38, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xa0, 0x06, 0x00, 0x00, 0x00, 0x03,
+ 0x03, 0x00, 0x1f, 0x00, 0xf0, 0x05, 0x1a, 0x01,
+ 0xce, 0x03, 0x00, 0x0c, 0x9c, 0x06, 0x49, 0x01,
+ 0xdf, 0xeb, 0xb7, 0xab, 0xec, 0x15, 0x68, 0x01,
+ 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0x04, 0x21,
+ 0x01, 0x00, 0x00, 0x24, 0x01, 0x00, 0x0e, 0xbf,
+ 0xfd, 0x28, 0xe1, 0xb8, 0xf1, 0x0e, 0x29, 0x0c,
+ 0x15, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xa2,
+ 0x06, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x04,
+ 0x00, 0x9c, 0x06, 0x49, 0x01, 0xdf, 0xb6, 0xf1,
+ 0x29, 0x0c, 0x64, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xa4, 0x06, 0x00, 0x01, 0x00, 0x06, 0x02,
+ 0x00, 0x51, 0x00, 0x00, 0x1b, 0x01, 0x00, 0x1a,
+ 0x01, 0xdf, 0xcb, 0xe0, 0xeb, 0xb8, 0xa7, 0xec,
+ 0x49, 0xc7, 0xb7, 0xa7, 0xec, 0x44, 0xc7, 0xe0,
+ 0xeb, 0xab, 0xec, 0x03, 0x94, 0x00, 0xe0, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xb7, 0xc7, 0xb8, 0xa0,
+ 0x24, 0x02, 0x00, 0xe0, 0x43, 0x68, 0x01, 0x00,
+ 0x00, 0xc7, 0xc7, 0xb8, 0x9f, 0x24, 0x02, 0x00,
+ 0x9f, 0xe0, 0x43, 0x68, 0x01, 0x00, 0x00, 0xc7,
+ 0xb8, 0xa0, 0xc7, 0x24, 0x02, 0x00, 0x9f, 0xe0,
+ 0x43, 0x68, 0x01, 0x00, 0x00, 0xc7, 0xb8, 0x9f,
+ 0x24, 0x01, 0x00, 0x9f, 0xe4, 0xc7, 0xb8, 0x9f,
+ 0xe3, 0x29, 0x0c, 0x70, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xa6, 0x06, 0x00, 0x04, 0x00, 0x05,
+ 0x04, 0x00, 0x57, 0x00, 0x00, 0x3f, 0x01, 0x00,
+ 0x1b, 0x01, 0x00, 0x3e, 0x01, 0x00, 0x1a, 0x01,
+ 0xdf, 0xe0, 0xf1, 0xcb, 0xe1, 0xc7, 0xf1, 0xcc,
+ 0xe1, 0xe0, 0xf1, 0xcd, 0xdf, 0xc9, 0xf1, 0xce,
+ 0xc7, 0xc8, 0xa5, 0xec, 0x42, 0xc8, 0xe0, 0xa6,
+ 0xec, 0x3d, 0xe0, 0xca, 0xa6, 0xec, 0x38, 0xca,
+ 0xc9, 0xa5, 0xec, 0x33, 0xe2, 0x43, 0x68, 0x01,
+ 0x00, 0x00, 0xb7, 0xc7, 0x24, 0x02, 0x00, 0xe2,
+ 0x43, 0x68, 0x01, 0x00, 0x00, 0xca, 0xc9, 0x24,
+ 0x02, 0x00, 0x9f, 0xe2, 0x43, 0x68, 0x01, 0x00,
+ 0x00, 0xc8, 0xca, 0x24, 0x02, 0x00, 0x9f, 0xe2,
+ 0x43, 0x68, 0x01, 0x00, 0x00, 0xc7, 0xc8, 0x24,
+ 0x02, 0x00, 0x9f, 0xe6, 0xc9, 0xe4, 0x29, 0x0c,
+ 0x46, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xa8,
+ 0x06, 0x00, 0x01, 0x00, 0x05, 0x03, 0x00, 0x30,
+ 0x00, 0x00, 0x3e, 0x01, 0x00, 0x1b, 0x01, 0x00,
+ 0x1a, 0x01, 0xdf, 0xe0, 0xf1, 0xcb, 0xe1, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xb7, 0xe0, 0x24, 0x02,
+ 0x00, 0xe1, 0x43, 0x68, 0x01, 0x00, 0x00, 0xe0,
+ 0xc7, 0x24, 0x02, 0x00, 0x43, 0x95, 0x01, 0x00,
+ 0x00, 0x24, 0x00, 0x00, 0x9f, 0xe1, 0x43, 0x68,
+ 0x01, 0x00, 0x00, 0xc7, 0x24, 0x01, 0x00, 0x9f,
+ 0xe5, 0x29, 0x0c, 0x46, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xac, 0x06, 0x00, 0x01, 0x00, 0x05,
+ 0x03, 0x00, 0x30, 0x00, 0x00, 0x3e, 0x01, 0x00,
+ 0x1b, 0x01, 0x00, 0x1a, 0x01, 0xdf, 0xe0, 0xf1,
+ 0xcb, 0xe1, 0x43, 0x68, 0x01, 0x00, 0x00, 0xb7,
+ 0xe0, 0x24, 0x02, 0x00, 0xe1, 0x43, 0x68, 0x01,
+ 0x00, 0x00, 0xe0, 0xc7, 0x24, 0x02, 0x00, 0x43,
+ 0x97, 0x01, 0x00, 0x00, 0x24, 0x00, 0x00, 0x9f,
+ 0xe1, 0x43, 0x68, 0x01, 0x00, 0x00, 0xc7, 0x24,
+ 0x01, 0x00, 0x9f, 0xe5, 0x29, 0x0c, 0x7d, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xb0, 0x06, 0x03,
+ 0x01, 0x03, 0x04, 0x06, 0x00, 0x5e, 0x00, 0x00,
+ 0x1a, 0x01, 0x00, 0x20, 0x01, 0x00, 0x51, 0x01,
+ 0x00, 0x0a, 0x01, 0x00, 0x1b, 0x01, 0x00, 0x1f,
+ 0x01, 0xdf, 0x43, 0x68, 0x01, 0x00, 0x00, 0xd3,
+ 0xd4, 0x24, 0x02, 0x00, 0xcb, 0xe0, 0xe1, 0xae,
+ 0xec, 0x05, 0xc7, 0xe6, 0xee, 0x10, 0xd5, 0xb7,
+ 0xa5, 0xec, 0x07, 0xc7, 0xe2, 0x9f, 0xe6, 0xee,
+ 0x05, 0xe2, 0xc7, 0x9f, 0xe6, 0xdf, 0x43, 0x68,
+ 0x01, 0x00, 0x00, 0xb7, 0xd3, 0x24, 0x02, 0x00,
+ 0xdf, 0x43, 0x68, 0x01, 0x00, 0x00, 0xd4, 0x24,
+ 0x01, 0x00, 0x9f, 0xe3, 0x60, 0x04, 0x00, 0xd4,
+ 0xa7, 0xec, 0x0d, 0x60, 0x04, 0x00, 0xd4, 0xd3,
+ 0xa0, 0xa0, 0x61, 0x04, 0x00, 0xee, 0x0c, 0x60,
+ 0x04, 0x00, 0xd3, 0xa7, 0xec, 0x05, 0xd3, 0x61,
+ 0x04, 0x00, 0xe1, 0x61, 0x05, 0x00, 0x29, 0x0c,
+ 0x20, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xb2,
+ 0x06, 0x00, 0x00, 0x00, 0x04, 0x03, 0x00, 0x07,
+ 0x00, 0xb0, 0x06, 0x51, 0x01, 0xf2, 0x05, 0x1b,
+ 0x01, 0xf0, 0x05, 0x1a, 0x01, 0xdf, 0xe0, 0xe1,
+ 0xeb, 0xb8, 0xf3, 0x29, 0x0c, 0x1b, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xb4, 0x06, 0x00, 0x00,
+ 0x00, 0x04, 0x02, 0x00, 0x06, 0x00, 0xb0, 0x06,
+ 0x51, 0x01, 0xf2, 0x05, 0x1b, 0x01, 0xdf, 0xb7,
+ 0xe0, 0xb6, 0xf3, 0x29, 0x0c, 0x21, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xb6, 0x06, 0x00, 0x00,
+ 0x00, 0x04, 0x03, 0x00, 0x08, 0x00, 0xb0, 0x06,
+ 0x51, 0x01, 0xf2, 0x05, 0x1b, 0x01, 0x80, 0x06,
+ 0x3e, 0x01, 0xdf, 0xe0, 0xe1, 0xe0, 0xf1, 0xb8,
+ 0xf3, 0x29, 0x0c, 0x21, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xb8, 0x06, 0x00, 0x00, 0x00, 0x04,
+ 0x03, 0x00, 0x08, 0x00, 0xb0, 0x06, 0x51, 0x01,
+ 0x82, 0x06, 0x3f, 0x01, 0xf2, 0x05, 0x1b, 0x01,
+ 0xdf, 0xe0, 0xe1, 0xf1, 0xe1, 0xb6, 0xf3, 0x29,
+ 0x0c, 0x19, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xba, 0x06, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00,
+ 0x04, 0x00, 0xe8, 0x05, 0x36, 0x01, 0xbc, 0x06,
+ 0x0a, 0x01, 0xdf, 0xe0, 0xf1, 0x29, 0x0c, 0x56,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xbe, 0x06,
+ 0x00, 0x00, 0x00, 0x03, 0x04, 0x00, 0x39, 0x00,
+ 0xc0, 0x06, 0x20, 0x01, 0xbe, 0x06, 0x57, 0x01,
+ 0xce, 0x03, 0x00, 0x0c, 0xc2, 0x06, 0x62, 0x01,
+ 0xdf, 0xe0, 0xad, 0xec, 0x20, 0x68, 0x02, 0x00,
+ 0x43, 0x67, 0x01, 0x00, 0x00, 0x04, 0x21, 0x01,
+ 0x00, 0x00, 0x24, 0x01, 0x00, 0x0e, 0x68, 0x02,
+ 0x00, 0x43, 0xa2, 0x01, 0x00, 0x00, 0xb7, 0x24,
+ 0x01, 0x00, 0x0e, 0x29, 0x68, 0x02, 0x00, 0x43,
+ 0x67, 0x01, 0x00, 0x00, 0x04, 0xa3, 0x01, 0x00,
+ 0x00, 0x24, 0x01, 0x00, 0x0e, 0xe2, 0xf0, 0x0e,
+ 0x29, 0x0c, 0x1a, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xc8, 0x06, 0x00, 0x00, 0x00, 0x01, 0x02,
+ 0x00, 0x05, 0x00, 0xf0, 0x05, 0x1a, 0x01, 0xf2,
+ 0x05, 0x1b, 0x01, 0xc3, 0xe3, 0xb7, 0xe4, 0x29,
+ 0x0c, 0x2d, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xca, 0x06, 0x02, 0x01, 0x02, 0x04, 0x01, 0x00,
+ 0x1d, 0x00, 0x00, 0x2e, 0x01, 0xc3, 0xcb, 0xd4,
+ 0xb7, 0xa7, 0xec, 0x15, 0xdf, 0xd3, 0xd4, 0xb8,
+ 0xa0, 0x48, 0xf1, 0xec, 0x0c, 0xd4, 0x90, 0xd8,
+ 0xd3, 0xd4, 0x48, 0xc7, 0x9f, 0xcb, 0xee, 0xe8,
+ 0xc7, 0x28, 0x0c, 0xc3, 0x03, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xcc, 0x06, 0x02, 0x06, 0x02, 0x05,
+ 0x77, 0x02, 0xae, 0x02, 0x08, 0xce, 0x06, 0x00,
+ 0x01, 0x00, 0xd0, 0x06, 0x00, 0x01, 0x00, 0xd2,
+ 0x06, 0x00, 0x00, 0x00, 0xd4, 0x06, 0x00, 0x01,
+ 0x00, 0xd6, 0x06, 0x00, 0x02, 0x00, 0x10, 0x00,
+ 0x01, 0x00, 0xe6, 0x01, 0x00, 0x01, 0x00, 0x9e,
+ 0x01, 0x00, 0x01, 0x00, 0xd8, 0x06, 0x00, 0x03,
+ 0xba, 0x02, 0x00, 0x01, 0xc2, 0x02, 0x01, 0x01,
+ 0xbc, 0x02, 0x02, 0x01, 0xce, 0x02, 0x03, 0x01,
+ 0xca, 0x02, 0x04, 0x01, 0xd2, 0x03, 0x05, 0x01,
+ 0xd4, 0x03, 0x06, 0x01, 0xda, 0x06, 0x07, 0x01,
+ 0xdc, 0x06, 0x08, 0x01, 0x92, 0x06, 0x09, 0x01,
+ 0xbc, 0x06, 0x0a, 0x01, 0xde, 0x06, 0x0b, 0x01,
+ 0xe0, 0x06, 0x0c, 0x01, 0xe2, 0x06, 0x0d, 0x01,
+ 0xe4, 0x06, 0x0e, 0x01, 0xe6, 0x06, 0x0f, 0x01,
+ 0xe8, 0x06, 0x10, 0x01, 0xea, 0x06, 0x11, 0x01,
+ 0xec, 0x06, 0x12, 0x01, 0xee, 0x06, 0x13, 0x01,
+ 0xf0, 0x06, 0x14, 0x01, 0xf2, 0x06, 0x15, 0x01,
+ 0xf4, 0x06, 0x16, 0x01, 0xf6, 0x06, 0x17, 0x01,
+ 0xf8, 0x06, 0x18, 0x01, 0xfa, 0x06, 0x19, 0x01,
+ 0xf0, 0x05, 0x1a, 0x01, 0xf2, 0x05, 0x1b, 0x01,
+ 0xfc, 0x06, 0x1c, 0x01, 0xfe, 0x06, 0x1d, 0x01,
+ 0x90, 0x06, 0x1e, 0x01, 0x80, 0x07, 0x1f, 0x01,
+ 0xc0, 0x06, 0x20, 0x01, 0xec, 0x05, 0x21, 0x01,
+ 0x82, 0x07, 0x22, 0x01, 0x84, 0x07, 0x23, 0x01,
+ 0x86, 0x07, 0x24, 0x01, 0x88, 0x07, 0x25, 0x01,
+ 0x8a, 0x07, 0x26, 0x01, 0x8c, 0x07, 0x27, 0x01,
+ 0x90, 0x05, 0x28, 0x01, 0xa0, 0x05, 0x29, 0x01,
+ 0xa4, 0x05, 0x2a, 0x01, 0xa2, 0x05, 0x2b, 0x01,
+ 0xaa, 0x05, 0x2c, 0x01, 0xb4, 0x05, 0x2d, 0x01,
+ 0xb6, 0x05, 0x2e, 0x01, 0xbc, 0x05, 0x2f, 0x01,
+ 0xc0, 0x05, 0x30, 0x01, 0xc4, 0x05, 0x31, 0x01,
+ 0xcc, 0x05, 0x32, 0x01, 0xd2, 0x05, 0x33, 0x01,
+ 0xd6, 0x05, 0x34, 0x01, 0xde, 0x05, 0x35, 0x01,
+ 0xe8, 0x05, 0x36, 0x01, 0xea, 0x05, 0x37, 0x01,
+ 0xee, 0x05, 0x38, 0x01, 0xf4, 0x05, 0x39, 0x01,
+ 0xf6, 0x05, 0x3a, 0x01, 0xf8, 0x05, 0x3b, 0x01,
+ 0xfa, 0x05, 0x3c, 0x01, 0xfe, 0x05, 0x3d, 0x01,
+ 0x80, 0x06, 0x3e, 0x01, 0x82, 0x06, 0x3f, 0x01,
+ 0x84, 0x06, 0x40, 0x01, 0x86, 0x06, 0x41, 0x01,
+ 0x88, 0x06, 0x42, 0x01, 0x8a, 0x06, 0x43, 0x01,
+ 0x8e, 0x06, 0x44, 0x01, 0x94, 0x06, 0x45, 0x01,
+ 0x96, 0x06, 0x46, 0x01, 0x98, 0x06, 0x47, 0x01,
+ 0x9a, 0x06, 0x48, 0x01, 0x9c, 0x06, 0x49, 0x01,
+ 0x9e, 0x06, 0x4a, 0x01, 0xa0, 0x06, 0x4b, 0x01,
+ 0xa2, 0x06, 0x4c, 0x01, 0xa4, 0x06, 0x4d, 0x01,
+ 0xa6, 0x06, 0x4e, 0x01, 0xa8, 0x06, 0x4f, 0x01,
+ 0xac, 0x06, 0x50, 0x01, 0xb0, 0x06, 0x51, 0x01,
+ 0xb2, 0x06, 0x52, 0x01, 0xb4, 0x06, 0x53, 0x01,
+ 0xb6, 0x06, 0x54, 0x01, 0xb8, 0x06, 0x55, 0x01,
+ 0xba, 0x06, 0x56, 0x01, 0xbe, 0x06, 0x57, 0x01,
+ 0xc8, 0x06, 0x58, 0x01, 0xca, 0x06, 0x59, 0x01,
+ 0xcc, 0x06, 0x5a, 0x01, 0x8e, 0x07, 0x5b, 0x01,
+ 0x90, 0x07, 0x5c, 0x01, 0x92, 0x07, 0x5d, 0x01,
+ 0x94, 0x07, 0x5e, 0x01, 0x96, 0x07, 0x5f, 0x01,
+ 0x98, 0x07, 0x60, 0x01, 0x9a, 0x07, 0x61, 0x01,
+ 0xc2, 0x06, 0x62, 0x01, 0x9c, 0x07, 0x63, 0x01,
+ 0x9e, 0x07, 0x64, 0x01, 0xa0, 0x07, 0x65, 0x01,
+ 0xa2, 0x07, 0x66, 0x01, 0xa4, 0x07, 0x67, 0x01,
+ 0xa6, 0x07, 0x68, 0x01, 0xa8, 0x07, 0x69, 0x01,
+ 0xaa, 0x07, 0x6a, 0x01, 0xac, 0x07, 0x6b, 0x01,
+ 0xae, 0x07, 0x6c, 0x01, 0xb0, 0x07, 0x6d, 0x01,
+ 0xb2, 0x07, 0x6e, 0x01, 0xb4, 0x07, 0x6f, 0x01,
+ 0xb6, 0x07, 0x70, 0x01, 0xb8, 0x07, 0x71, 0x01,
+ 0xba, 0x07, 0x72, 0x01, 0xbc, 0x07, 0x73, 0x01,
+ 0xce, 0x03, 0x00, 0x0c, 0xd0, 0x03, 0x01, 0x0c,
+ 0x0c, 0x03, 0xc5, 0x04, 0x08, 0xce, 0x0c, 0x00,
+ 0xc5, 0x05, 0xd4, 0xb7, 0xa6, 0x11, 0xed, 0x16,
+ 0x0e, 0x04, 0xdf, 0x01, 0x00, 0x00, 0x43, 0xe0,
+ 0x01, 0x00, 0x00, 0xd3, 0xd4, 0xb8, 0xa0, 0x48,
+ 0x24, 0x01, 0x00, 0xb7, 0xa8, 0xec, 0x03, 0xdf,
+ 0x28, 0xd4, 0xb9, 0xa8, 0x6c, 0x00, 0x01, 0x00,
+ 0x00, 0xd3, 0xd4, 0xb8, 0xa0, 0x48, 0x04, 0xe1,
+ 0x01, 0x00, 0x00, 0xad, 0x6c, 0xf0, 0x00, 0x00,
+ 0x00, 0xd4, 0x90, 0xd8, 0x0b, 0xcb, 0xd3, 0xd4,
+ 0xb8, 0xa0, 0x48, 0xd1, 0x11, 0x04, 0xe2, 0x01,
+ 0x00, 0x00, 0xad, 0xed, 0x0a, 0x11, 0x04, 0xe3,
+ 0x01, 0x00, 0x00, 0xad, 0xec, 0x07, 0x04, 0x58,
+ 0x01, 0x00, 0x00, 0x28, 0x11, 0x04, 0xe4, 0x01,
+ 0x00, 0x00, 0xad, 0xec, 0x05, 0x26, 0x00, 0x00,
+ 0x28, 0x11, 0x04, 0xe5, 0x01, 0x00, 0x00, 0xad,
+ 0xec, 0x03, 0x0b, 0x28, 0x11, 0x04, 0xe6, 0x01,
+ 0x00, 0x00, 0xad, 0xec, 0x07, 0xc1, 0x00, 0xc1,
+ 0x01, 0x34, 0x28, 0x60, 0x2f, 0x00, 0xc9, 0xf1,
+ 0x6c, 0x9a, 0x00, 0x00, 0x00, 0x60, 0x5a, 0x00,
+ 0xd3, 0xd4, 0xf2, 0xcc, 0x04, 0x03, 0x00, 0x00,
+ 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x04, 0x01,
+ 0x00, 0x00, 0x00, 0x04, 0x08, 0x00, 0x00, 0x00,
+ 0x26, 0x04, 0x00, 0x43, 0xe7, 0x01, 0x00, 0x00,
+ 0xc8, 0x24, 0x01, 0x00, 0x11, 0xed, 0x0b, 0x0e,
+ 0x39, 0xe8, 0x01, 0x00, 0x00, 0xc8, 0x8f, 0xf1,
+ 0x98, 0xec, 0x0d, 0x39, 0x3c, 0x00, 0x00, 0x00,
+ 0xc8, 0x32, 0x01, 0x00, 0x01, 0x00, 0x28, 0xd4,
+ 0xc8, 0xeb, 0xa0, 0xba, 0xa8, 0xec, 0x1d, 0xd3,
+ 0xd4, 0xc8, 0xeb, 0xa0, 0xb8, 0xa0, 0x48, 0x04,
+ 0xe6, 0x01, 0x00, 0x00, 0xad, 0xec, 0x0d, 0x39,
+ 0xab, 0x00, 0x00, 0x00, 0x11, 0xc3, 0xc8, 0x21,
+ 0x02, 0x00, 0x28, 0x60, 0x5b, 0x00, 0xd3, 0xd4,
+ 0xc8, 0xeb, 0xa0, 0xf2, 0xcf, 0xf5, 0x11, 0xed,
+ 0x04, 0x0e, 0xc7, 0xf4, 0xec, 0x03, 0xc7, 0x28,
+ 0xc7, 0xdf, 0xad, 0xec, 0x13, 0xc7, 0xc8, 0x48,
+ 0xf4, 0xec, 0x0d, 0x39, 0x3c, 0x00, 0x00, 0x00,
+ 0xc8, 0x32, 0x01, 0x00, 0x01, 0x00, 0x28, 0xc7,
+ 0xc8, 0x48, 0x28, 0x0b, 0x28, 0x29, 0x07, 0x02,
+ 0x20, 0x07, 0xfc, 0x01, 0x00, 0x00, 0x01, 0x00,
+ 0x13, 0x00, 0x00, 0x00, 0x05, 0x00, 0x58, 0x00,
+ 0x00, 0x00, 0x0c, 0x06, 0x00, 0x00, 0x00, 0x06,
+ 0x0b, 0xf5, 0xff, 0xff, 0xff, 0x0f, 0x00, 0x01,
+ 0x20, 0x00, 0x10, 0x00, 0x0e, 0x01, 0x01, 0x00,
+ 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+ 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x01, 0x00,
+ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+ 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x02, 0x00,
+ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+ 0xff, 0xff, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00,
+ 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00,
+ 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x0d, 0x00,
+ 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x06, 0x00,
+ 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0x08, 0x00,
+ 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+ 0xff, 0xff, 0x0c, 0x3f, 0x01, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0x8e, 0x07, 0x02, 0x0a, 0x02, 0x04,
+ 0x03, 0x01, 0xe2, 0x01, 0x00, 0x00, 0x59, 0x01,
+ 0x00, 0x5a, 0x01, 0x00, 0x00, 0x01, 0xdf, 0xd3,
+ 0xd4, 0xf2, 0xcb, 0xe0, 0xd3, 0xd4, 0xc7, 0xeb,
+ 0xa0, 0xf2, 0xcd, 0x26, 0x00, 0x00, 0xce, 0xb7,
+ 0xc5, 0x04, 0xc9, 0xcc, 0xc4, 0x04, 0xbf, 0x0a,
+ 0xa5, 0xec, 0x67, 0xc8, 0xf5, 0xed, 0x63, 0xc8,
+ 0x06, 0xae, 0xec, 0x5e, 0xe1, 0x43, 0xe9, 0x01,
+ 0x00, 0x00, 0xc8, 0x24, 0x01, 0x00, 0xc5, 0x07,
+ 0xb7, 0xc5, 0x05, 0xc4, 0x05, 0xc4, 0x07, 0xeb,
+ 0xa5, 0xec, 0x38, 0xc4, 0x07, 0xc4, 0x05, 0x48,
+ 0xc6, 0x08, 0x99, 0x04, 0x4a, 0x00, 0x00, 0x00,
+ 0xab, 0xec, 0x24, 0xc3, 0xc4, 0x08, 0x8f, 0x9f,
+ 0xc4, 0x08, 0xac, 0xec, 0x1a, 0xc4, 0x08, 0x43,
+ 0xea, 0x01, 0x00, 0x00, 0xc7, 0x24, 0x01, 0x00,
+ 0xec, 0x0d, 0xca, 0x43, 0x86, 0x01, 0x00, 0x00,
+ 0xc4, 0x08, 0x24, 0x01, 0x00, 0x0e, 0x95, 0x05,
+ 0xee, 0xc2, 0xe1, 0x43, 0x61, 0x00, 0x00, 0x00,
+ 0xc8, 0x24, 0x01, 0x00, 0xcc, 0x95, 0x04, 0xee,
+ 0x94, 0xca, 0xeb, 0xb8, 0xa7, 0xec, 0x45, 0xc2,
+ 0x00, 0xc5, 0x09, 0xc2, 0x00, 0x0e, 0xca, 0x43,
+ 0xeb, 0x01, 0x00, 0x00, 0x64, 0x09, 0x00, 0x24,
+ 0x01, 0x00, 0x0e, 0xb8, 0xc6, 0x05, 0xc5, 0x04,
+ 0xc4, 0x04, 0xca, 0xeb, 0xa5, 0xec, 0x1d, 0xca,
+ 0xc4, 0x04, 0x48, 0xca, 0xc4, 0x04, 0xb8, 0xa0,
+ 0x48, 0xac, 0xec, 0x0c, 0xca, 0xc4, 0x05, 0x93,
+ 0xc5, 0x05, 0xca, 0xc4, 0x04, 0x48, 0x4b, 0x95,
+ 0x04, 0xee, 0xde, 0xca, 0xc4, 0x05, 0x44, 0x30,
+ 0x00, 0x00, 0x00, 0x0b, 0xca, 0x4e, 0xec, 0x01,
+ 0x00, 0x00, 0xc7, 0xeb, 0x4e, 0xa8, 0x01, 0x00,
+ 0x00, 0xc9, 0x4e, 0xed, 0x01, 0x00, 0x00, 0x28,
+ 0x0c, 0x41, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xdc, 0x07, 0x02, 0x00, 0x02, 0x03, 0x00, 0x00,
+ 0x34, 0x00, 0xd3, 0xb7, 0x48, 0xd4, 0xb7, 0x48,
+ 0xac, 0xec, 0x1b, 0xd3, 0xb7, 0x48, 0x04, 0x5c,
+ 0x01, 0x00, 0x00, 0xab, 0xec, 0x03, 0xb8, 0x28,
+ 0xd4, 0xb7, 0x48, 0x04, 0x5c, 0x01, 0x00, 0x00,
+ 0xab, 0xec, 0x03, 0xb6, 0x28, 0xd3, 0xd4, 0xa5,
+ 0xec, 0x03, 0xb6, 0x28, 0xd3, 0xd4, 0xa7, 0xec,
+ 0x04, 0xb8, 0x8f, 0x28, 0xb7, 0x28, 0x0c, 0xbb,
+ 0x01, 0x00, 0x00, 0x43, 0x02, 0x01, 0x90, 0x07,
+ 0x00, 0x0d, 0x00, 0x07, 0x0a, 0x00, 0x8f, 0x03,
+ 0x00, 0x00, 0x5b, 0x01, 0x00, 0x1a, 0x01, 0x00,
+ 0x1b, 0x01, 0x00, 0x36, 0x01, 0x00, 0x20, 0x01,
+ 0x00, 0x5c, 0x01, 0x00, 0x04, 0x01, 0x00, 0x26,
+ 0x01, 0x00, 0x00, 0x0c, 0x00, 0x62, 0x01, 0xdf,
+ 0xe0, 0xe1, 0xf2, 0xd0, 0x42, 0xec, 0x01, 0x00,
+ 0x00, 0xcf, 0xeb, 0xb7, 0xad, 0xec, 0x02, 0x29,
+ 0xc7, 0xb7, 0x48, 0xd1, 0xeb, 0xc5, 0x05, 0xb8,
+ 0xce, 0xca, 0xc7, 0xeb, 0xa5, 0xec, 0x2a, 0xc7,
+ 0xca, 0x48, 0xc5, 0x06, 0xb7, 0xc5, 0x04, 0xc4,
+ 0x04, 0xc4, 0x05, 0xa5, 0xec, 0x17, 0xc4, 0x06,
+ 0xc4, 0x04, 0x48, 0xc9, 0xc4, 0x04, 0x48, 0xae,
+ 0xec, 0x07, 0xc4, 0x04, 0xc5, 0x05, 0xee, 0x05,
+ 0x95, 0x04, 0xee, 0xe4, 0x95, 0x03, 0xee, 0xd2,
+ 0xc8, 0x42, 0xa8, 0x01, 0x00, 0x00, 0xce, 0xca,
+ 0xc4, 0x05, 0xa5, 0xec, 0x0b, 0xe2, 0xc9, 0xca,
+ 0x48, 0xf1, 0x0e, 0x95, 0x03, 0xee, 0xf1, 0x60,
+ 0x04, 0x00, 0x60, 0x05, 0x00, 0xad, 0xec, 0x42,
+ 0xc7, 0xeb, 0xb8, 0xab, 0xec, 0x3c, 0xc8, 0x42,
+ 0xed, 0x01, 0x00, 0x00, 0xc7, 0xb7, 0x48, 0x48,
+ 0xc6, 0x0c, 0xf7, 0xec, 0x1a, 0xe2, 0x04, 0xef,
+ 0x01, 0x00, 0x00, 0xf1, 0x0e, 0xc4, 0x0c, 0xeb,
+ 0xb7, 0xab, 0xec, 0x1e, 0xe2, 0x04, 0xf0, 0x01,
+ 0x00, 0x00, 0xf1, 0x0e, 0xee, 0x14, 0xc4, 0x0c,
+ 0x99, 0x04, 0x4b, 0x00, 0x00, 0x00, 0xab, 0xec,
+ 0x09, 0xe2, 0x04, 0xe1, 0x01, 0x00, 0x00, 0xf1,
+ 0x0e, 0x60, 0x04, 0x00, 0x60, 0x05, 0x00, 0xad,
+ 0x6c, 0xdc, 0x00, 0x00, 0x00, 0xc7, 0xeb, 0xb9,
+ 0xa8, 0x6c, 0xd3, 0x00, 0x00, 0x00, 0xb7, 0xc5,
+ 0x07, 0xb7, 0xce, 0xca, 0xc7, 0xeb, 0xa5, 0xec,
+ 0x18, 0x60, 0x06, 0x00, 0x43, 0xf1, 0x01, 0x00,
+ 0x00, 0xc4, 0x07, 0xc7, 0xca, 0x48, 0xeb, 0x24,
+ 0x02, 0x00, 0xc5, 0x07, 0x95, 0x03, 0xee, 0xe4,
+ 0xb9, 0x96, 0x07, 0x60, 0x06, 0x00, 0x43, 0xf1,
+ 0x01, 0x00, 0x00, 0xb8, 0x60, 0x06, 0x00, 0x43,
+ 0xf2, 0x01, 0x00, 0x00, 0x60, 0x07, 0x00, 0xb8,
+ 0x9f, 0xc4, 0x07, 0x9d, 0x24, 0x01, 0x00, 0x24,
+ 0x02, 0x00, 0xc5, 0x09, 0x60, 0x06, 0x00, 0x43,
+ 0xf3, 0x01, 0x00, 0x00, 0xc7, 0xeb, 0xc4, 0x09,
+ 0x9d, 0x24, 0x01, 0x00, 0xc5, 0x0b, 0x68, 0x08,
+ 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0x04, 0x21,
+ 0x01, 0x00, 0x00, 0x24, 0x01, 0x00, 0x0e, 0xb7,
+ 0xc5, 0x0a, 0xc4, 0x0a, 0xc4, 0x0b, 0xa5, 0xec,
+ 0x58, 0xb7, 0xc5, 0x08, 0xc4, 0x08, 0xc4, 0x09,
+ 0xa5, 0xec, 0x39, 0xc4, 0x08, 0xc4, 0x0b, 0x9c,
+ 0xc4, 0x0a, 0x9f, 0xd2, 0xc7, 0xeb, 0xa8, 0xed,
+ 0x2b, 0xc7, 0xca, 0x48, 0xcd, 0xc4, 0x08, 0xc4,
+ 0x09, 0xb8, 0xa0, 0xac, 0xec, 0x0d, 0xc9, 0x43,
+ 0xf4, 0x01, 0x00, 0x00, 0xc4, 0x07, 0x24, 0x01,
+ 0x00, 0xcd, 0x68, 0x08, 0x00, 0x43, 0x67, 0x01,
+ 0x00, 0x00, 0xc9, 0x24, 0x01, 0x00, 0x0e, 0x95,
+ 0x08, 0xee, 0xc2, 0x68, 0x08, 0x00, 0x43, 0x67,
+ 0x01, 0x00, 0x00, 0x04, 0x21, 0x01, 0x00, 0x00,
+ 0x24, 0x01, 0x00, 0x0e, 0x95, 0x0a, 0xee, 0xa3,
+ 0x60, 0x09, 0x00, 0xf0, 0x0e, 0x29, 0x0c, 0x1d,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0x94, 0x07,
+ 0x02, 0x01, 0x02, 0x02, 0x00, 0x00, 0x10, 0x00,
+ 0xc3, 0xcb, 0xd4, 0x92, 0xd8, 0xb7, 0xa7, 0xec,
+ 0x06, 0xd3, 0x96, 0x00, 0xee, 0xf5, 0xc7, 0x28,
+ 0x0c, 0x47, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xc2, 0x06, 0x00, 0x00, 0x00, 0x03, 0x07, 0x00,
+ 0x1e, 0x00, 0xce, 0x03, 0x00, 0x0c, 0xe6, 0x06,
+ 0x0f, 0x01, 0x8c, 0x07, 0x27, 0x01, 0xbc, 0x05,
+ 0x2f, 0x01, 0x8a, 0x07, 0x26, 0x01, 0xfc, 0x06,
+ 0x1c, 0x01, 0xfe, 0x06, 0x1d, 0x01, 0x68, 0x00,
+ 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0xe0, 0x24,
+ 0x01, 0x00, 0x0e, 0xe2, 0xe0, 0xf1, 0x60, 0x04,
+ 0x00, 0x9e, 0xe5, 0xc3, 0x61, 0x05, 0x00, 0xb7,
+ 0x61, 0x06, 0x00, 0x29, 0x0c, 0xc1, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0x9c, 0x07, 0x02, 0x01,
+ 0x02, 0x05, 0x11, 0x00, 0x80, 0x01, 0x00, 0x00,
+ 0x1a, 0x01, 0x00, 0x1b, 0x01, 0x00, 0x1e, 0x01,
+ 0x00, 0x09, 0x01, 0x00, 0x61, 0x01, 0x00, 0x0f,
+ 0x01, 0x00, 0x0e, 0x01, 0x00, 0x18, 0x01, 0x00,
+ 0x5e, 0x01, 0x00, 0x10, 0x01, 0x00, 0x12, 0x01,
+ 0x00, 0x14, 0x01, 0x00, 0x17, 0x01, 0x00, 0x11,
+ 0x01, 0x00, 0x62, 0x01, 0x00, 0x35, 0x01, 0x00,
+ 0x60, 0x01, 0xd3, 0x11, 0xed, 0x03, 0x0e, 0xc3,
+ 0xe7, 0xeb, 0xe4, 0xe2, 0xeb, 0xe5, 0xd4, 0x61,
+ 0x04, 0x00, 0x60, 0x06, 0x00, 0x61, 0x05, 0x00,
+ 0x60, 0x07, 0x00, 0xec, 0x22, 0x60, 0x05, 0x00,
+ 0x60, 0x08, 0x00, 0x04, 0xf5, 0x01, 0x00, 0x00,
+ 0x60, 0x09, 0x00, 0x60, 0x05, 0x00, 0xeb, 0xa0,
+ 0xf2, 0x9f, 0x62, 0x05, 0x00, 0x60, 0x0a, 0x00,
+ 0x9f, 0x61, 0x05, 0x00, 0xee, 0x36, 0x60, 0x0b,
+ 0x00, 0xec, 0x20, 0x60, 0x0c, 0x00, 0xc0, 0xe8,
+ 0x03, 0x9d, 0xcb, 0x60, 0x05, 0x00, 0xc7, 0x43,
+ 0xf6, 0x01, 0x00, 0x00, 0xbd, 0x24, 0x01, 0x00,
+ 0x04, 0xf5, 0x01, 0x00, 0x00, 0x9f, 0x9f, 0x61,
+ 0x05, 0x00, 0x60, 0x05, 0x00, 0xeb, 0x61, 0x09,
+ 0x00, 0x60, 0x05, 0x00, 0x60, 0x0d, 0x00, 0x9f,
+ 0x61, 0x05, 0x00, 0x60, 0x0e, 0x00, 0xf0, 0x0e,
+ 0x60, 0x0f, 0x00, 0xf0, 0x0e, 0xb7, 0x61, 0x10,
+ 0x00, 0x29, 0x0c, 0xa6, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0x9e, 0x07, 0x01, 0x01, 0x01, 0x03,
+ 0x04, 0x02, 0x86, 0x01, 0x00, 0x00, 0x01, 0x01,
+ 0x00, 0x60, 0x01, 0x00, 0x5f, 0x01, 0x00, 0x65,
+ 0x01, 0xdf, 0x43, 0xf7, 0x01, 0x00, 0x00, 0xd3,
+ 0x24, 0x01, 0x00, 0xcb, 0xe0, 0x11, 0xb7, 0xad,
+ 0xec, 0x14, 0xc7, 0x04, 0xf8, 0x01, 0x00, 0x00,
+ 0xab, 0xec, 0x06, 0xc7, 0xe5, 0xb8, 0xe4, 0x29,
+ 0xe2, 0xc7, 0xf1, 0x0e, 0x29, 0x11, 0xb8, 0xad,
+ 0xec, 0x24, 0xe1, 0xc7, 0x9f, 0xe5, 0xc7, 0x04,
+ 0xf9, 0x01, 0x00, 0x00, 0xab, 0xec, 0x04, 0xb9,
+ 0xe4, 0x29, 0xc7, 0x04, 0xfa, 0x01, 0x00, 0x00,
+ 0xab, 0xec, 0x04, 0xba, 0xe4, 0x29, 0xe2, 0xe1,
+ 0xf1, 0x0e, 0xb7, 0xe4, 0x29, 0x11, 0xb9, 0xad,
+ 0xec, 0x26, 0xe1, 0xc7, 0x9f, 0xe5, 0xc7, 0x04,
+ 0xfb, 0x01, 0x00, 0x00, 0xab, 0x11, 0xed, 0x0e,
+ 0x0e, 0xc7, 0xc1, 0x00, 0xa8, 0x11, 0xec, 0x06,
+ 0x0e, 0xc7, 0xc1, 0x01, 0xa6, 0x98, 0xec, 0x17,
+ 0xe2, 0xe1, 0xf1, 0x0e, 0xb7, 0xe4, 0x29, 0x11,
+ 0xba, 0xad, 0xec, 0x0b, 0xe1, 0xc7, 0x9f, 0xe5,
+ 0xe2, 0xe1, 0xf1, 0x0e, 0xb7, 0xe4, 0x29, 0x07,
+ 0x02, 0x30, 0x07, 0x02, 0x39, 0x0c, 0xe5, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xa0, 0x07, 0x01,
+ 0x01, 0x01, 0x05, 0x0d, 0x00, 0xb0, 0x01, 0x00,
+ 0x00, 0x21, 0x01, 0x00, 0x2f, 0x01, 0x00, 0x36,
+ 0x01, 0x00, 0x5d, 0x01, 0x00, 0x1f, 0x01, 0x00,
+ 0x61, 0x01, 0x00, 0x1a, 0x01, 0x00, 0x01, 0x0c,
+ 0x00, 0x24, 0x01, 0x00, 0x20, 0x01, 0x00, 0x39,
+ 0x01, 0x00, 0x1b, 0x01, 0x00, 0x35, 0x01, 0xdf,
+ 0xec, 0x10, 0xe0, 0xd3, 0xf1, 0xb8, 0xad, 0xec,
+ 0x05, 0xe1, 0xd3, 0xf1, 0x0e, 0x09, 0xe3, 0xee,
+ 0x7a, 0xe2, 0xd3, 0x48, 0xcf, 0xec, 0x55, 0xc7,
+ 0x61, 0x04, 0x00, 0xc7, 0xd3, 0xf1, 0x11, 0xb6,
+ 0xad, 0xec, 0x09, 0x60, 0x05, 0x00, 0x60, 0x06,
+ 0x00, 0xf1, 0x29, 0x11, 0xbf, 0xfe, 0xad, 0xec,
+ 0x07, 0x60, 0x05, 0x00, 0x07, 0xf1, 0x29, 0x11,
+ 0xbf, 0xfd, 0xad, 0xec, 0x26, 0x68, 0x07, 0x00,
+ 0x43, 0x4d, 0x01, 0x00, 0x00, 0x68, 0x07, 0x00,
+ 0x42, 0x4e, 0x01, 0x00, 0x00, 0x07, 0x24, 0x02,
+ 0x00, 0x0e, 0x68, 0x07, 0x00, 0x43, 0x4f, 0x01,
+ 0x00, 0x00, 0x60, 0x08, 0x00, 0x07, 0x24, 0x02,
+ 0x00, 0x29, 0x0e, 0x60, 0x04, 0x00, 0x61, 0x09,
+ 0x00, 0xee, 0x20, 0xe0, 0xd3, 0xf1, 0xb8, 0xad,
+ 0xec, 0x14, 0xd3, 0x04, 0xf5, 0x01, 0x00, 0x00,
+ 0xa8, 0xec, 0x0b, 0xe1, 0xd3, 0xf1, 0x0e, 0xe1,
+ 0x61, 0x09, 0x00, 0xee, 0x06, 0x60, 0x0a, 0x00,
+ 0xf0, 0x0e, 0x60, 0x0b, 0x00, 0xb7, 0xa5, 0xec,
+ 0x04, 0xb7, 0xee, 0x14, 0x60, 0x0b, 0x00, 0x60,
+ 0x06, 0x00, 0xeb, 0xa7, 0xec, 0x07, 0x60, 0x06,
+ 0x00, 0xeb, 0xee, 0x04, 0x60, 0x0b, 0x00, 0x61,
+ 0x0b, 0x00, 0x60, 0x0c, 0x00, 0xf0, 0x29, 0x0c,
+ 0x34, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xa4,
+ 0x07, 0x01, 0x01, 0x01, 0x05, 0x00, 0x00, 0x27,
+ 0x00, 0xd3, 0xb7, 0xa5, 0xec, 0x0c, 0xd3, 0x8e,
+ 0xd7, 0x04, 0xfc, 0x01, 0x00, 0x00, 0xcb, 0xee,
+ 0x03, 0xc3, 0xcb, 0xc7, 0x04, 0xfd, 0x01, 0x00,
+ 0x00, 0xd3, 0x43, 0x39, 0x00, 0x00, 0x00, 0xbf,
+ 0x10, 0x24, 0x01, 0x00, 0x9f, 0x9f, 0xcf, 0x28,
+ 0x0c, 0x3c, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xa6, 0x07, 0x01, 0x01, 0x01, 0x04, 0x01, 0x00,
+ 0x2c, 0x00, 0x00, 0x2c, 0x01, 0xd3, 0xb7, 0x48,
+ 0x04, 0xfe, 0x01, 0x00, 0x00, 0xae, 0xec, 0x03,
+ 0xc3, 0x28, 0xb8, 0xcb, 0xc7, 0xd3, 0xeb, 0xa5,
+ 0xec, 0x0d, 0xdf, 0xd3, 0xc7, 0x48, 0xf1, 0x98,
+ 0xed, 0x05, 0x95, 0x00, 0xee, 0xef, 0xd3, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xb8, 0xc7, 0x25, 0x02,
+ 0x00, 0x0c, 0x0b, 0x01, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xa8, 0x07, 0x02, 0x04, 0x02, 0x04, 0x04,
+ 0x00, 0xf1, 0x01, 0x00, 0x00, 0x6a, 0x01, 0x00,
+ 0x00, 0x0c, 0x00, 0x66, 0x01, 0x00, 0x14, 0x01,
+ 0xd3, 0x04, 0xff, 0x01, 0x00, 0x00, 0xad, 0x11,
+ 0xed, 0x14, 0x0e, 0xd3, 0x04, 0x00, 0x02, 0x00,
+ 0x00, 0xad, 0x11, 0xed, 0x09, 0x0e, 0xd3, 0x04,
+ 0xd5, 0x01, 0x00, 0x00, 0xab, 0xec, 0x07, 0xdf,
+ 0xf0, 0x0e, 0xef, 0xcc, 0x00, 0xd3, 0x04, 0x01,
+ 0x02, 0x00, 0x00, 0xad, 0xec, 0x4b, 0xd4, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xd3, 0xeb, 0xb8, 0x9f,
+ 0x24, 0x01, 0x00, 0x43, 0x02, 0x02, 0x00, 0x00,
+ 0x24, 0x00, 0x00, 0xd2, 0x43, 0x03, 0x02, 0x00,
+ 0x00, 0x04, 0xe1, 0x01, 0x00, 0x00, 0x24, 0x01,
+ 0x00, 0xca, 0x43, 0x03, 0x02, 0x00, 0x00, 0x04,
+ 0xe6, 0x01, 0x00, 0x00, 0x24, 0x01, 0x00, 0xa6,
+ 0xec, 0x08, 0x04, 0x04, 0x02, 0x00, 0x00, 0x96,
+ 0x03, 0x68, 0x01, 0x00, 0x43, 0x05, 0x02, 0x00,
+ 0x00, 0xca, 0x24, 0x01, 0x00, 0x0e, 0x09, 0x28,
+ 0xd3, 0x04, 0x06, 0x02, 0x00, 0x00, 0xad, 0xec,
+ 0x05, 0x0a, 0xe5, 0xee, 0x6b, 0xd3, 0x04, 0x07,
+ 0x02, 0x00, 0x00, 0xad, 0xec, 0x05, 0x09, 0xe5,
+ 0xee, 0x5e, 0xd3, 0x04, 0x08, 0x02, 0x00, 0x00,
+ 0xad, 0xec, 0x06, 0xe2, 0x98, 0xe6, 0xee, 0x50,
+ 0xd3, 0x04, 0x09, 0x02, 0x00, 0x00, 0xad, 0xec,
+ 0x14, 0x68, 0x01, 0x00, 0x43, 0x67, 0x01, 0x00,
+ 0x00, 0x04, 0x0a, 0x02, 0x00, 0x00, 0x24, 0x01,
+ 0x00, 0x0e, 0xee, 0x34, 0xd3, 0x04, 0x0b, 0x02,
+ 0x00, 0x00, 0xad, 0xec, 0x10, 0x68, 0x01, 0x00,
+ 0x43, 0xa2, 0x01, 0x00, 0x00, 0xb7, 0x24, 0x01,
+ 0x00, 0x0e, 0xee, 0x1c, 0x68, 0x01, 0x00, 0x43,
+ 0x67, 0x01, 0x00, 0x00, 0x04, 0x0c, 0x02, 0x00,
+ 0x00, 0xd3, 0x9f, 0x04, 0x21, 0x01, 0x00, 0x00,
+ 0x9f, 0x24, 0x01, 0x00, 0x0e, 0x09, 0x28, 0x0a,
+ 0x28, 0x0c, 0x88, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xaa, 0x07, 0x00, 0x01, 0x00, 0x05, 0x03,
+ 0x01, 0x51, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x66,
+ 0x01, 0x00, 0x14, 0x01, 0xc2, 0x00, 0xcb, 0x68,
+ 0x00, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0x04,
+ 0x0d, 0x02, 0x00, 0x00, 0x04, 0x0e, 0x02, 0x00,
+ 0x00, 0x9f, 0xc7, 0xe0, 0xf1, 0x9f, 0x04, 0x0f,
+ 0x02, 0x00, 0x00, 0x9f, 0x04, 0x10, 0x02, 0x00,
+ 0x00, 0x9f, 0xc7, 0xe0, 0x98, 0xf1, 0x9f, 0x04,
+ 0x11, 0x02, 0x00, 0x00, 0x9f, 0x04, 0x12, 0x02,
+ 0x00, 0x00, 0x9f, 0xc7, 0xe1, 0xf1, 0x9f, 0x04,
+ 0x13, 0x02, 0x00, 0x00, 0x9f, 0x04, 0x14, 0x02,
+ 0x00, 0x00, 0x9f, 0x04, 0x15, 0x02, 0x00, 0x00,
+ 0x9f, 0x24, 0x01, 0x00, 0x29, 0x0c, 0x1c, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xac, 0x08, 0x01,
+ 0x00, 0x01, 0x01, 0x00, 0x00, 0x0f, 0x00, 0xd3,
+ 0xec, 0x07, 0x04, 0x7f, 0x00, 0x00, 0x00, 0x28,
+ 0x04, 0xf5, 0x01, 0x00, 0x00, 0x28, 0x0c, 0x29,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xac, 0x07,
+ 0x00, 0x00, 0x00, 0x03, 0x02, 0x00, 0x14, 0x00,
+ 0xce, 0x03, 0x00, 0x0c, 0xae, 0x07, 0x6c, 0x01,
+ 0x68, 0x00, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00,
+ 0x04, 0x17, 0x02, 0x00, 0x00, 0x24, 0x01, 0x00,
+ 0x0e, 0xe0, 0xf0, 0x29, 0x0c, 0x29, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xae, 0x07, 0x00, 0x00,
+ 0x00, 0x04, 0x04, 0x00, 0x0c, 0x00, 0x9c, 0x07,
+ 0x63, 0x01, 0x94, 0x07, 0x5e, 0x01, 0xfa, 0x06,
+ 0x19, 0x01, 0xb0, 0x07, 0x6d, 0x01, 0xdf, 0xe0,
+ 0x04, 0x18, 0x02, 0x00, 0x00, 0xe1, 0xf2, 0xe2,
+ 0xf2, 0x29, 0x0c, 0x1d, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xb0, 0x07, 0x01, 0x00, 0x01, 0x02,
+ 0x02, 0x00, 0x0a, 0x00, 0x00, 0x6e, 0x01, 0x00,
+ 0x6c, 0x01, 0xdf, 0xd3, 0xf1, 0x98, 0xec, 0x04,
+ 0xe0, 0xf0, 0x0e, 0x29, 0x0c, 0x93, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xb2, 0x07, 0x01, 0x02,
+ 0x01, 0x04, 0x08, 0x00, 0x6e, 0x00, 0x00, 0x6a,
+ 0x01, 0x00, 0x68, 0x01, 0x00, 0x69, 0x01, 0x00,
+ 0x18, 0x01, 0x00, 0x73, 0x01, 0x00, 0x0e, 0x01,
+ 0x00, 0x19, 0x01, 0x00, 0x6f, 0x01, 0xd3, 0xf5,
+ 0xec, 0x05, 0xc3, 0xd7, 0x09, 0x28, 0xd3, 0x04,
+ 0x00, 0x02, 0x00, 0x00, 0xad, 0xec, 0x06, 0xdf,
+ 0xf0, 0x0e, 0x09, 0x28, 0xe0, 0xd3, 0xf1, 0xd0,
+ 0xeb, 0xb7, 0xa7, 0xec, 0x18, 0xe1, 0xc8, 0xd3,
+ 0xf2, 0x98, 0xec, 0x03, 0x09, 0x28, 0xd3, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0xc8, 0xeb, 0xb8, 0x9f,
+ 0x24, 0x01, 0x00, 0xd7, 0xd3, 0xc3, 0xad, 0xec,
+ 0x03, 0x09, 0x28, 0xe2, 0xec, 0x0b, 0xe2, 0x04,
+ 0x21, 0x01, 0x00, 0x00, 0x9f, 0xd3, 0x9f, 0xd7,
+ 0x60, 0x04, 0x00, 0xd3, 0xf1, 0xcf, 0xb7, 0x48,
+ 0x61, 0x05, 0x00, 0xc7, 0xb8, 0x48, 0x61, 0x06,
+ 0x00, 0x60, 0x05, 0x00, 0xec, 0x05, 0xd3, 0xe6,
+ 0x09, 0x28, 0xc3, 0xe6, 0x60, 0x07, 0x00, 0xd3,
+ 0xf1, 0x0e, 0x0a, 0x28, 0x0c, 0x65, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xb4, 0x07, 0x01, 0x02,
+ 0x01, 0x06, 0x05, 0x00, 0x49, 0x00, 0x00, 0x16,
+ 0x01, 0x00, 0x01, 0x0c, 0x00, 0x00, 0x0c, 0x00,
+ 0x70, 0x01, 0x00, 0x71, 0x01, 0x6f, 0x39, 0x00,
+ 0x00, 0x00, 0x68, 0x01, 0x00, 0x43, 0x19, 0x02,
+ 0x00, 0x00, 0x24, 0x00, 0x00, 0xe3, 0x68, 0x02,
+ 0x00, 0x43, 0x1a, 0x02, 0x00, 0x00, 0xd3, 0x0b,
+ 0x0a, 0x4e, 0x1b, 0x02, 0x00, 0x00, 0x0a, 0x4e,
+ 0x87, 0x00, 0x00, 0x00, 0x24, 0x02, 0x00, 0xcf,
+ 0x43, 0x81, 0x00, 0x00, 0x00, 0xe2, 0x60, 0x04,
+ 0x00, 0x24, 0x02, 0x00, 0x0e, 0x0e, 0x29, 0xcc,
+ 0x6f, 0x0c, 0x00, 0x00, 0x00, 0x60, 0x04, 0x00,
+ 0xc8, 0xf1, 0x0e, 0x0e, 0x29, 0x30, 0x0c, 0x03,
+ 0x01, 0x00, 0x00, 0x43, 0x02, 0x01, 0xb6, 0x07,
+ 0x01, 0x01, 0x01, 0x04, 0x0b, 0x00, 0xd4, 0x01,
+ 0x00, 0x00, 0x17, 0x01, 0x00, 0x01, 0x0c, 0x00,
+ 0x16, 0x01, 0x00, 0x00, 0x0c, 0x00, 0x07, 0x01,
+ 0x00, 0x08, 0x01, 0x00, 0x66, 0x01, 0x00, 0x04,
+ 0x01, 0x00, 0x67, 0x01, 0x00, 0x00, 0x03, 0x00,
+ 0x72, 0x01, 0x0a, 0xcb, 0xd3, 0x42, 0x42, 0x00,
+ 0x00, 0x00, 0xd7, 0x68, 0x01, 0x00, 0x43, 0x19,
+ 0x02, 0x00, 0x00, 0x24, 0x00, 0x00, 0xe1, 0xa0,
+ 0xe3, 0x68, 0x03, 0x00, 0x43, 0x67, 0x01, 0x00,
+ 0x00, 0x60, 0x04, 0x00, 0x60, 0x05, 0x00, 0x42,
+ 0x14, 0x01, 0x00, 0x00, 0x48, 0x24, 0x01, 0x00,
+ 0x0e, 0x60, 0x06, 0x00, 0xec, 0x5e, 0xd3, 0x99,
+ 0x04, 0x48, 0x00, 0x00, 0x00, 0xab, 0xec, 0x26,
+ 0xd3, 0x60, 0x07, 0x00, 0x43, 0xf2, 0x01, 0x00,
+ 0x00, 0xd3, 0x24, 0x01, 0x00, 0xad, 0xec, 0x16,
+ 0x68, 0x03, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00,
+ 0x60, 0x08, 0x00, 0xd3, 0xf1, 0x24, 0x01, 0x00,
+ 0x0e, 0x09, 0xcb, 0xee, 0x2f, 0xd3, 0x99, 0x04,
+ 0x8e, 0x00, 0x00, 0x00, 0xab, 0xec, 0x25, 0x68,
+ 0x03, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00, 0x60,
+ 0x08, 0x00, 0xd3, 0xf1, 0x24, 0x01, 0x00, 0x0e,
+ 0x68, 0x03, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00,
+ 0x04, 0x1c, 0x02, 0x00, 0x00, 0x24, 0x01, 0x00,
+ 0x0e, 0x09, 0xcb, 0xc7, 0xec, 0x0e, 0x68, 0x03,
+ 0x00, 0x43, 0x1d, 0x02, 0x00, 0x00, 0xd3, 0x24,
+ 0x01, 0x00, 0x0e, 0x68, 0x03, 0x00, 0x43, 0x67,
+ 0x01, 0x00, 0x00, 0x04, 0x21, 0x01, 0x00, 0x00,
+ 0x24, 0x01, 0x00, 0x0e, 0x68, 0x03, 0x00, 0x43,
+ 0x67, 0x01, 0x00, 0x00, 0x60, 0x04, 0x00, 0x42,
+ 0xec, 0x00, 0x00, 0x00, 0x24, 0x01, 0x00, 0x0e,
+ 0x60, 0x09, 0x00, 0xd3, 0x44, 0x5c, 0x01, 0x00,
+ 0x00, 0x60, 0x0a, 0x00, 0xf0, 0x29, 0x0c, 0x7b,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xb8, 0x07,
+ 0x01, 0x00, 0x01, 0x04, 0x04, 0x00, 0x62, 0x00,
+ 0x00, 0x00, 0x0c, 0x00, 0x07, 0x01, 0x00, 0x08,
+ 0x01, 0x00, 0x72, 0x01, 0x68, 0x00, 0x00, 0x43,
+ 0x67, 0x01, 0x00, 0x00, 0xe0, 0xe1, 0x42, 0x15,
+ 0x01, 0x00, 0x00, 0x48, 0x24, 0x01, 0x00, 0x0e,
+ 0xd3, 0x39, 0x9f, 0x00, 0x00, 0x00, 0xa9, 0x98,
+ 0xec, 0x12, 0x68, 0x00, 0x00, 0x43, 0x67, 0x01,
+ 0x00, 0x00, 0x04, 0x1e, 0x02, 0x00, 0x00, 0x24,
+ 0x01, 0x00, 0x0e, 0x68, 0x00, 0x00, 0x43, 0x1d,
+ 0x02, 0x00, 0x00, 0xd3, 0x24, 0x01, 0x00, 0x0e,
+ 0x68, 0x00, 0x00, 0x43, 0x67, 0x01, 0x00, 0x00,
+ 0x04, 0x21, 0x01, 0x00, 0x00, 0x24, 0x01, 0x00,
+ 0x0e, 0x68, 0x00, 0x00, 0x43, 0x67, 0x01, 0x00,
+ 0x00, 0xe0, 0x42, 0xec, 0x00, 0x00, 0x00, 0x24,
+ 0x01, 0x00, 0x0e, 0xe2, 0xf0, 0x29, 0x0c, 0x2a,
+ 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xba, 0x07,
+ 0x00, 0x00, 0x00, 0x02, 0x03, 0x00, 0x11, 0x00,
+ 0xfa, 0x06, 0x19, 0x01, 0xce, 0x03, 0x00, 0x0c,
+ 0xae, 0x07, 0x6c, 0x01, 0xb7, 0xe3, 0x68, 0x01,
+ 0x00, 0x43, 0x1f, 0x02, 0x00, 0x00, 0x24, 0x00,
+ 0x00, 0x0e, 0xe1, 0xf0, 0x29, 0x0c, 0x3e, 0x06,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xbc, 0x07, 0x01,
+ 0x17, 0x01, 0x04, 0x03, 0x0a, 0x8f, 0x04, 0x00,
+ 0x00, 0x2e, 0x01, 0x00, 0x31, 0x01, 0x00, 0x2d,
+ 0x01, 0xc2, 0x00, 0xc5, 0x0a, 0xc2, 0x01, 0xc5,
+ 0x0b, 0xc2, 0x02, 0xc5, 0x0c, 0xc2, 0x03, 0xc5,
+ 0x0d, 0xc2, 0x04, 0xc5, 0x0e, 0xc2, 0x05, 0xc5,
+ 0x0f, 0xc2, 0x06, 0xc5, 0x10, 0xc2, 0x07, 0xc5,
+ 0x11, 0xc2, 0x08, 0xc5, 0x15, 0xc2, 0x09, 0xc5,
+ 0x16, 0xd3, 0xeb, 0xce, 0xc3, 0xc5, 0x05, 0xb7,
+ 0xc5, 0x06, 0xb8, 0xc5, 0x08, 0x26, 0x00, 0x00,
+ 0xc5, 0x09, 0x04, 0x20, 0x02, 0x00, 0x00, 0x04,
+ 0x21, 0x02, 0x00, 0x00, 0x9f, 0x04, 0x22, 0x02,
+ 0x00, 0x00, 0x9f, 0x04, 0x23, 0x02, 0x00, 0x00,
+ 0x9f, 0x04, 0x24, 0x02, 0x00, 0x00, 0x9f, 0x04,
+ 0x25, 0x02, 0x00, 0x00, 0x9f, 0x04, 0x26, 0x02,
+ 0x00, 0x00, 0x9f, 0x04, 0x27, 0x02, 0x00, 0x00,
+ 0x9f, 0x04, 0x28, 0x02, 0x00, 0x00, 0x9f, 0x04,
+ 0x29, 0x02, 0x00, 0x00, 0x9f, 0xc5, 0x12, 0x04,
+ 0x2a, 0x02, 0x00, 0x00, 0xc5, 0x13, 0x04, 0x2b,
+ 0x02, 0x00, 0x00, 0xc5, 0x14, 0xb7, 0xcb, 0xc7,
+ 0xca, 0xa5, 0x6c, 0x75, 0x01, 0x00, 0x00, 0x07,
+ 0xc5, 0x04, 0xc7, 0xcd, 0xd3, 0xc7, 0x93, 0xcb,
+ 0x48, 0xd0, 0x11, 0x04, 0xf5, 0x01, 0x00, 0x00,
+ 0xad, 0xed, 0x1c, 0x11, 0x04, 0x20, 0x01, 0x00,
+ 0x00, 0xad, 0xed, 0x13, 0x11, 0x04, 0x23, 0x01,
+ 0x00, 0x00, 0xad, 0xed, 0x0a, 0x11, 0x04, 0x21,
+ 0x01, 0x00, 0x00, 0xad, 0xec, 0x04, 0x0e, 0xee,
+ 0xc7, 0x11, 0x04, 0x2c, 0x02, 0x00, 0x00, 0xad,
+ 0xed, 0x0a, 0x11, 0x04, 0xfc, 0x01, 0x00, 0x00,
+ 0xad, 0xec, 0x18, 0xc7, 0xca, 0xa5, 0xec, 0x0d,
+ 0xd3, 0xc7, 0x48, 0xc8, 0xab, 0xec, 0x06, 0x95,
+ 0x00, 0x0e, 0xee, 0xa4, 0xb8, 0xc5, 0x08, 0x0e,
+ 0xee, 0x9e, 0x11, 0x04, 0xe6, 0x01, 0x00, 0x00,
+ 0xad, 0xec, 0x44, 0xc7, 0xca, 0xa5, 0xec, 0x13,
+ 0xd3, 0xc7, 0x48, 0x04, 0x7f, 0x00, 0x00, 0x00,
+ 0xab, 0xec, 0x08, 0xc4, 0x0d, 0xf0, 0x0e, 0xef,
+ 0xe7, 0x00, 0xc7, 0xca, 0xa5, 0xec, 0x13, 0xd3,
+ 0xc7, 0x48, 0x04, 0xe6, 0x01, 0x00, 0x00, 0xab,
+ 0xec, 0x08, 0xc4, 0x0e, 0xf0, 0x0e, 0xef, 0xd0,
+ 0x00, 0xc4, 0x08, 0xec, 0x0b, 0xc4, 0x10, 0xf0,
+ 0x0e, 0xb7, 0xc5, 0x08, 0xef, 0xc2, 0x00, 0xb8,
+ 0xc5, 0x08, 0x0e, 0xef, 0x53, 0xff, 0x11, 0x04,
+ 0xe2, 0x01, 0x00, 0x00, 0xad, 0xed, 0x13, 0x11,
+ 0x04, 0xe3, 0x01, 0x00, 0x00, 0xad, 0xed, 0x0a,
+ 0x11, 0x04, 0x2d, 0x02, 0x00, 0x00, 0xad, 0xec,
+ 0x0c, 0xc4, 0x0f, 0xc8, 0xf1, 0x0e, 0xb7, 0xc5,
+ 0x08, 0xef, 0x95, 0x00, 0x11, 0x04, 0xef, 0x01,
+ 0x00, 0x00, 0xad, 0xed, 0x13, 0x11, 0x04, 0xf9,
+ 0x01, 0x00, 0x00, 0xad, 0xed, 0x0a, 0x11, 0x04,
+ 0x2e, 0x02, 0x00, 0x00, 0xad, 0xec, 0x0f, 0xb8,
+ 0xc5, 0x08, 0x95, 0x06, 0xc4, 0x0a, 0xc8, 0xf1,
+ 0x0e, 0x0e, 0xef, 0x04, 0xff, 0x11, 0x04, 0xf0,
+ 0x01, 0x00, 0x00, 0xad, 0xed, 0x13, 0x11, 0x04,
+ 0xe4, 0x01, 0x00, 0x00, 0xad, 0xed, 0x0a, 0x11,
+ 0x04, 0xe5, 0x01, 0x00, 0x00, 0xad, 0xec, 0x25,
+ 0xb7, 0xc5, 0x08, 0xc4, 0x06, 0xb7, 0xa7, 0xec,
+ 0x13, 0xe0, 0xc4, 0x0b, 0xf0, 0xc8, 0xf2, 0xec,
+ 0x0b, 0x94, 0x06, 0xc4, 0x0c, 0xf0, 0x0e, 0x0e,
+ 0xef, 0xce, 0xfe, 0x04, 0x13, 0x01, 0x00, 0x00,
+ 0xc5, 0x04, 0xee, 0x2c, 0xe1, 0xc8, 0xf1, 0xec,
+ 0x0a, 0xc4, 0x11, 0xf0, 0x0e, 0xb7, 0xc5, 0x08,
+ 0xee, 0x1e, 0xdf, 0xc8, 0xf1, 0x11, 0xed, 0x09,
+ 0x0e, 0xc8, 0x04, 0x5d, 0x01, 0x00, 0x00, 0xab,
+ 0xec, 0x07, 0xc4, 0x15, 0xf0, 0x0e, 0xee, 0x08,
+ 0xb8, 0xc5, 0x08, 0x0e, 0xef, 0x9a, 0xfe, 0x0e,
+ 0xc4, 0x04, 0x6c, 0x94, 0xfe, 0xff, 0xff, 0xc4,
+ 0x16, 0xc9, 0xc7, 0xf2, 0x0e, 0xef, 0x89, 0xfe,
+ 0xc4, 0x16, 0xca, 0xca, 0xf2, 0x0e, 0xc4, 0x05,
+ 0xc4, 0x06, 0xc4, 0x09, 0x26, 0x03, 0x00, 0x28,
+ 0x0c, 0x15, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xde, 0x08, 0x01, 0x00, 0x01, 0x02, 0x01, 0x00,
+ 0x05, 0x00, 0x00, 0x05, 0x01, 0xdf, 0xd3, 0x9f,
+ 0xe3, 0x29, 0x0c, 0x1d, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xe0, 0x08, 0x01, 0x00, 0x01, 0x04,
+ 0x01, 0x00, 0x0d, 0x00, 0x00, 0x05, 0x01, 0xdf,
+ 0x43, 0x68, 0x01, 0x00, 0x00, 0xdf, 0xeb, 0xb8,
+ 0xa0, 0x25, 0x01, 0x00, 0x0c, 0x27, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xe2, 0x08, 0x01, 0x00,
+ 0x01, 0x05, 0x02, 0x00, 0x14, 0x00, 0x00, 0x0b,
+ 0x01, 0x00, 0x05, 0x01, 0xdf, 0xf0, 0xd7, 0xe0,
+ 0x43, 0x68, 0x01, 0x00, 0x00, 0xb7, 0xe0, 0xeb,
+ 0xb8, 0xa0, 0x24, 0x02, 0x00, 0xe4, 0xd3, 0x28,
+ 0x0c, 0x6e, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01,
+ 0xe4, 0x08, 0x00, 0x00, 0x00, 0x03, 0x06, 0x00,
+ 0x49, 0x00, 0xe6, 0x08, 0x04, 0x01, 0xde, 0x08,
+ 0x0a, 0x01, 0xe8, 0x08, 0x00, 0x01, 0xb8, 0x08,
+ 0x03, 0x01, 0xea, 0x08, 0x00, 0x03, 0xe2, 0x08,
+ 0x0c, 0x01, 0x04, 0x0e, 0x01, 0x00, 0x00, 0xe3,
+ 0xe0, 0x04, 0xe6, 0x01, 0x00, 0x00, 0xf1, 0x0e,
+ 0xe1, 0x91, 0xe5, 0xe1, 0xe2, 0xb8, 0xa0, 0xa5,
+ 0xec, 0x31, 0x60, 0x04, 0x00, 0xe1, 0x48, 0x04,
+ 0x7f, 0x00, 0x00, 0x00, 0xab, 0xec, 0x1f, 0x60,
+ 0x04, 0x00, 0xe1, 0xb8, 0x9f, 0x48, 0x04, 0xe6,
+ 0x01, 0x00, 0x00, 0xab, 0xec, 0x10, 0xe1, 0xb9,
+ 0x9f, 0xe5, 0x60, 0x05, 0x00, 0x04, 0xe6, 0x01,
+ 0x00, 0x00, 0xf1, 0x0e, 0x29, 0xe1, 0x91, 0xe5,
+ 0xee, 0xca, 0x29, 0x0c, 0x3c, 0x00, 0x00, 0x00,
+ 0x43, 0x02, 0x01, 0xec, 0x08, 0x00, 0x00, 0x00,
+ 0x02, 0x04, 0x00, 0x1f, 0x00, 0xe6, 0x08, 0x04,
+ 0x01, 0xe8, 0x08, 0x00, 0x01, 0xb8, 0x08, 0x03,
+ 0x01, 0xea, 0x08, 0x00, 0x03, 0x04, 0x0e, 0x01,
+ 0x00, 0x00, 0xe3, 0xe0, 0x91, 0xe4, 0xe0, 0xe1,
+ 0xa5, 0xec, 0x11, 0xe2, 0xe0, 0x48, 0x04, 0x21,
+ 0x01, 0x00, 0x00, 0xab, 0xed, 0x06, 0xe0, 0x91,
+ 0xe4, 0xee, 0xec, 0x29, 0x0c, 0x6e, 0x00, 0x00,
+ 0x00, 0x43, 0x02, 0x01, 0xee, 0x08, 0x01, 0x00,
+ 0x01, 0x03, 0x07, 0x00, 0x4c, 0x00, 0x00, 0x04,
+ 0x01, 0x00, 0x0a, 0x01, 0x00, 0x00, 0x01, 0x00,
+ 0x03, 0x01, 0x00, 0x01, 0x01, 0x00, 0x00, 0x03,
+ 0x00, 0x0c, 0x01, 0x04, 0x4a, 0x00, 0x00, 0x00,
+ 0xe3, 0xe0, 0xd3, 0xf1, 0x0e, 0xe1, 0xe2, 0xa5,
+ 0xec, 0x3d, 0x60, 0x05, 0x00, 0xe1, 0x93, 0xe5,
+ 0x48, 0x62, 0x04, 0x00, 0x04, 0x21, 0x01, 0x00,
+ 0x00, 0xab, 0xec, 0x09, 0x04, 0x13, 0x01, 0x00,
+ 0x00, 0xe3, 0xee, 0xe2, 0x60, 0x04, 0x00, 0x04,
+ 0xfe, 0x01, 0x00, 0x00, 0xab, 0xec, 0x0b, 0xe1,
+ 0xe2, 0xa8, 0xed, 0x13, 0xe1, 0x91, 0xe5, 0xee,
+ 0xcd, 0x60, 0x04, 0x00, 0xd3, 0xab, 0xec, 0xc6,
+ 0x60, 0x06, 0x00, 0xf0, 0x0e, 0x29, 0x29, 0x0c,
+ 0xf6, 0x00, 0x00, 0x00, 0x43, 0x02, 0x01, 0xf0,
+ 0x08, 0x00, 0x00, 0x00, 0x03, 0x09, 0x00, 0xc4,
+ 0x01, 0x00, 0xe6, 0x08, 0x04, 0x01, 0xde, 0x08,
+ 0x0a, 0x01, 0xe8, 0x08, 0x00, 0x01, 0xb8, 0x08,
+ 0x03, 0x01, 0xd6, 0x06, 0x01, 0x01, 0xea, 0x08,
+ 0x00, 0x03, 0xe0, 0x08, 0x0b, 0x01, 0xe2, 0x08,
+ 0x0c, 0x01, 0xb6, 0x05, 0x00, 0x00, 0x04, 0x0f,
+ 0x01, 0x00, 0x00, 0xe3, 0xe0, 0x04, 0xe6, 0x01,
+ 0x00, 0x00, 0xf1, 0x0e, 0xe1, 0xe2, 0xa5, 0x6c,
+ 0xb1, 0x00, 0x00, 0x00, 0x60, 0x05, 0x00, 0xe1,
+ 0x93, 0xe5, 0x48, 0x62, 0x04, 0x00, 0x04, 0x21,
+ 0x01, 0x00, 0x00, 0xab, 0xec, 0x09, 0x04, 0x13,
+ 0x01, 0x00, 0x00, 0xe3, 0xee, 0xdf, 0x60, 0x04,
+ 0x00, 0x04, 0xfe, 0x01, 0x00, 0x00, 0xab, 0xec,
+ 0x0b, 0xe1, 0xe2, 0xa5, 0xec, 0xcf, 0xe1, 0x91,
+ 0xe5, 0xee, 0xca, 0x60, 0x06, 0x00, 0xf0, 0x04,
+ 0xf9, 0x01, 0x00, 0x00, 0xab, 0xec, 0x13, 0x60,
+ 0x04, 0x00, 0x04, 0xe4, 0x01, 0x00, 0x00, 0xab,
+ 0xec, 0xb3, 0x60, 0x07, 0x00, 0xf0, 0x0e, 0xee,
+ 0xac, 0x60, 0x04, 0x00, 0x04, 0xf9, 0x01, 0x00,
+ 0x00, 0xab, 0xec, 0x2e, 0xe0, 0x04, 0xf9, 0x01,
+ 0x00, 0x00, 0xf1, 0x0e, 0x60, 0x05, 0x00, 0xe1,
+ 0x48, 0x04, 0xf9, 0x01, 0x00, 0x00, 0xab, 0x11,
+ 0xed, 0x0d, 0x0e, 0x60, 0x05, 0x00, 0xe1, 0x48,
+ 0x04, 0xe4, 0x01, 0x00, 0x00, 0xab, 0x6c, 0x7d,
+ 0xff, 0xff, 0xff, 0xe1, 0x91, 0xe5, 0xef, 0x75,
+ 0xff, 0x60, 0x04, 0x00, 0x04, 0xe6, 0x01, 0x00,
+ 0x00, 0xab, 0x6c, 0x69, 0xff, 0xff, 0xff, 0x60,
+ 0x07, 0x00, 0xf0, 0x0e, 0xe1, 0xe2, 0xa5, 0xec,
+ 0x11, 0x60, 0x08, 0x00, 0x60, 0x05, 0x00, 0xe1,
+ 0x48, 0xf1, 0xec, 0x06, 0xe1, 0x91, 0xe5, 0xee,
+ 0xec, 0x29, 0x0c, 0x62, 0x00, 0x00, 0x00, 0x43,
+ 0x02, 0x01, 0xf2, 0x08, 0x00, 0x00, 0x00, 0x03,
+ 0x05, 0x00, 0x41, 0x00, 0xe6, 0x08, 0x04, 0x01,
+ 0xe8, 0x08, 0x00, 0x01, 0xb8, 0x08, 0x03, 0x01,
+ 0xb6, 0x05, 0x00, 0x00, 0xea, 0x08, 0x00, 0x03,
+ 0x04, 0x48, 0x00, 0x00, 0x00, 0xe3, 0xe0, 0xe1,
+ 0xa5, 0xec, 0x36, 0xe2, 0x60, 0x04, 0x00, 0xe0,
+ 0x48, 0xf1, 0x11, 0xed, 0x25, 0x0e, 0x60, 0x04,
+ 0x00, 0xe0, 0x48, 0x04, 0xe1, 0x01, 0x00, 0x00,
+ 0xab, 0xec, 0x1e, 0xe0, 0xe1, 0xb8, 0xa0, 0xab,
+ 0x11, 0xed, 0x0f, 0x0e, 0x60, 0x04, 0x00, 0xe0,
+ 0xb8, 0x9f, 0x48, 0x04, 0xe1, 0x01, 0x00, 0x00,
+ 0xac, 0xec, 0x06, 0xe0, 0x91, 0xe4, 0xee, 0xc7,
+ 0x29, 0x0c, 0xdf, 0x00, 0x00, 0x00, 0x43, 0x02,
+ 0x01, 0xf4, 0x08, 0x00, 0x02, 0x00, 0x05, 0x0a,
+ 0x00, 0xb3, 0x01, 0x00, 0x00, 0x08, 0x01, 0x00,
+ 0x00, 0x01, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00,
+ 0x00, 0x00, 0x03, 0x00, 0x02, 0x01, 0x00, 0x12,
+ 0x01, 0x00, 0x04, 0x01, 0x00, 0x13, 0x01, 0x00,
+ 0x14, 0x01, 0xb8, 0xe3, 0xe0, 0xe1, 0xa5, 0xec,
+ 0x0f, 0xe2, 0x60, 0x04, 0x00, 0xe0, 0x48, 0xf1,
+ 0xec, 0x06, 0xe0, 0x91, 0xe4, 0xee, 0xee, 0x04,
+ 0x20, 0x02, 0x00, 0x00, 0x60, 0x04, 0x00, 0x43,
+ 0x68, 0x01, 0x00, 0x00, 0x60, 0x05, 0x00, 0xe0,
+ 0x24, 0x02, 0x00, 0x9f, 0x04, 0x20, 0x02, 0x00,
+ 0x00, 0x9f, 0xcb, 0x60, 0x06, 0x00, 0x43, 0xe0,
+ 0x01, 0x00, 0x00, 0xc7, 0x24, 0x01, 0x00, 0xb7,
+ 0xa8, 0xec, 0x1c, 0x04, 0x10, 0x01, 0x00, 0x00,
+ 0x61, 0x07, 0x00, 0x60, 0x08, 0x00, 0x43, 0xe0,
+ 0x01, 0x00, 0x00, 0xc7, 0x24, 0x01, 0x00, 0xb7,
+ 0xa8, 0xec, 0x03, 0xb7, 0xe3, 0x29, 0xe0, 0xcc,
+ 0xc8, 0xe1, 0xa5, 0xec, 0x12, 0x60, 0x04, 0x00,
+ 0xc8, 0x48, 0x04, 0xf5, 0x01, 0x00, 0x00, 0xab,
+ 0xec, 0x05, 0x95, 0x01, 0xee, 0xeb, 0xc8, 0xe1,
+ 0xa5, 0xec, 0x17, 0x60, 0x04, 0x00, 0xc8, 0x48,
+ 0x04, 0xef, 0x01, 0x00, 0x00, 0xab, 0xec, 0x0a,
+ 0x04, 0x1b, 0x00, 0x00, 0x00, 0x61, 0x07, 0x00,
+ 0x29, 0x60, 0x09, 0x00, 0x43, 0xe0, 0x01, 0x00,
+ 0x00, 0xc7, 0x24, 0x01, 0x00, 0xb7, 0xa8, 0xec,
+ 0x0a, 0x04, 0x11, 0x01, 0x00, 0x00, 0x61, 0x07,
+ 0x00, 0x29, 0x04, 0x12, 0x01, 0x00, 0x00, 0x61,
+ 0x07, 0x00, 0xb7, 0xe3, 0x29, 0x0c, 0x3e, 0x00,
+ 0x00, 0x00, 0x43, 0x02, 0x01, 0xf6, 0x08, 0x02,
+ 0x00, 0x02, 0x03, 0x02, 0x00, 0x2b, 0x00, 0x00,
+ 0x09, 0x01, 0x00, 0x04, 0x01, 0xdf, 0xeb, 0xd3,
+ 0xa5, 0xec, 0x12, 0xdf, 0x43, 0x86, 0x01, 0x00,
+ 0x00, 0x04, 0x16, 0x00, 0x00, 0x00, 0x24, 0x01,
+ 0x00, 0x0e, 0xee, 0xea, 0xdf, 0xeb, 0xd4, 0xa5,
+ 0xec, 0x0e, 0xdf, 0x43, 0x86, 0x01, 0x00, 0x00,
+ 0xe0, 0x24, 0x01, 0x00, 0x0e, 0xee, 0xee, 0x29,
+};
+
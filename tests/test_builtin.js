@@ -341,6 +341,48 @@ function test_string()
     assert("abc".padStart(Infinity, ""), "abc");
 }
 
+function test_string_search()
+{
+    var s, w, i, n;
+
+    /* long strings to use the vectorized loops */
+    s = "ab".repeat(100) + "abc" + "ab".repeat(100);
+    w = "ā" + s;
+    assert(s.indexOf("abc"), 200);
+    assert(w.indexOf("abc"), 201);
+    assert(s.indexOf("abc", 201), -1);
+    assert(s.lastIndexOf("ab"), 401);
+    assert(s.lastIndexOf("abc"), 200);
+    assert(w.lastIndexOf("abc", 200), -1);
+    assert(s.indexOf("c"), 202);
+    assert(w.lastIndexOf("c"), 203);
+    assert(s.indexOf("ā"), -1);
+    assert(s.indexOf("aā"), -1);
+    assert(w.indexOf("āa"), 0);
+    assert(s.includes("bcab"), true);
+    assert(w.includes("bcb"), false);
+    assert(s.lastIndexOf("", 5), 5);
+
+    /* each position and length */
+    for(n = 1; n < 5; n++) {
+        for(i = 0; i < 70; i++) {
+            s = "x".repeat(i) + "yz".substring(0, n - 1) + "y" + "x".repeat(70);
+            w = ("Ă" + s).substring(1);
+            assert(s.indexOf("yz".substring(0, n - 1) + "y"), i);
+            assert(w.indexOf("yz".substring(0, n - 1) + "y"), i);
+            assert(s.lastIndexOf("yz".substring(0, n - 1) + "y"), i);
+            assert(w.lastIndexOf("yz".substring(0, n - 1) + "y"), i);
+        }
+    }
+
+    s = "a,bb,,ccc,".repeat(10);
+    assert(s.split(",").length, 41);
+    assert(s.split(",,").length, 11);
+    assert(("ā" + s).split("c").length, 31);
+    assert(s.replaceAll("bb", "b").length, 90);
+    assert(s.replaceAll(",", "ā").indexOf(","), -1);
+}
+
 function test_math()
 {
     var a;
@@ -600,6 +642,112 @@ function test_json()
     assert_json_error('\n{ "a": @x }"');
 }
 
+function test_json_parse_fast()
+{
+    var a, b, s, i;
+
+    /* objects with the same layout share their shape */
+    a = JSON.parse('[{"x":1,"y":2},{"x":3,"y":4},{"y":5,"x":6},{"x":7}]');
+    assert(Object.keys(a[1]).join(), "x,y");
+    assert(Object.keys(a[2]).join(), "y,x");
+    assert(Object.keys(a[3]).join(), "x");
+    assert(a[1].x + a[1].y + a[2].x + a[2].y + a[3].x, 25);
+
+    /* duplicate, numeric and special keys */
+    a = JSON.parse('{"a":1,"b":2,"a":3,"1":4,"0":5,"__proto__":6,"\\u0062":7,"\u00e9":8}');
+    assert(Object.keys(a).join(), "0,1,a,b,__proto__,\u00e9");
+    assert(a.a, 3);
+    assert(a.b, 7);
+    assert(Object.getPrototypeOf(a), Object.prototype);
+    assert(Object.getOwnPropertyDescriptor(a, "__proto__").value, 6);
+
+    /* numbers */
+    a = JSON.parse('[0,-0,1,-1,999999999,-999999999,2147483647,-2147483648,2147483648,1e3,1.5,-1E-2,123456789012345678901]');
+    b = [0,-0,1,-1,999999999,-999999999,2147483647,-2147483648,2147483648,1e3,1.5,-1E-2,123456789012345678901];
+    for(i = 0; i < b.length; i++)
+        assert(a[i], b[i]);
+
+    /* strings */
+    s = "x".repeat(40);
+    assert(JSON.parse('"' + s + '"'), s);
+    assert(JSON.parse('"' + s + '\\n\\u00e9\u20ac\ud83d\ude00' + s + '"'),
+           s + "\n\u00e9\u20ac\ud83d\ude00" + s);
+    assert(JSON.parse('"\\ud800"'), "\ud800");
+
+    /* errors are reported by the generic parser */
+    for (s of [ "", " ", "[1,]", "{\"a\":1,}", "01", "-", "1.", "1e", "tru", "truex",
+                "[1 2]", "\"\\x\"", "\"a\tb\"", "\"abc", "nul", "{\"a\" 1}",
+                "[", "1 2", "\u00a01" ]) {
+        assert_throws(SyntaxError, () => JSON.parse(s));
+    }
+    assert_json_error('\n[1, @]');
+    assert(JSON.parse("[".repeat(1000) + "]".repeat(1000)).length, 1);
+    assert_throws(SyntaxError, () => JSON.parse("[".repeat(100000)));
+}
+
+function test_json_stringify_fast()
+{
+    var a, b, o, s, i;
+
+    /* key order, non enumerable properties and skipped values */
+    o = { b: 1, a: "x", 2: true, 1: null, u: undefined, f: function() {},
+          [Symbol("s")]: 1 };
+    Object.defineProperty(o, "h", { value: 1, enumerable: false });
+    assert(JSON.stringify(o), '{"1":null,"2":true,"b":1,"a":"x"}');
+    assert(JSON.stringify([undefined, function() {}, Symbol()]), '[null,null,null]');
+
+    /* numbers and strings */
+    assert(JSON.stringify([0, -0, 1.5, -1e21, NaN, Infinity, -2147483648]),
+           '[0,0,1.5,-1e+21,null,null,-2147483648]');
+    s = "x".repeat(40);
+    assert(JSON.stringify({ [s + "\n"]: s + "\"\\\u0001é\ud800" }),
+           '{"' + s + '\\n":"' + s + '\\"\\\\\\u0001é\\ud800"}');
+
+    /* objects sharing a shape use the cached keys */
+    a = [];
+    for(i = 0; i < 10; i++)
+        a.push({ id: i, name: "n" + i, v: [i, i + 0.5] });
+    b = JSON.parse(JSON.stringify(a));
+    assert(b.length, 10);
+    assert(b[9].name, "n9");
+    assert(b[9].v[1], 9.5);
+
+    /* toJSON, getters and class instances */
+    Object.prototype.toJSON = function() { return "P"; };
+    try {
+        assert(JSON.stringify({ a: 1 }), '"P"');
+    } finally {
+        delete Object.prototype.toJSON;
+    }
+    assert(JSON.stringify({ a: { toJSON(k) { return k + "!"; } } }), '{"a":"a!"}');
+    assert(JSON.stringify({ get a() { return 2; } }), '{"a":2}');
+    assert(JSON.stringify([new Date(0), new Map(), new Number(3), 1n < 2]),
+           '["1970-01-01T00:00:00.000Z",{},3,true]');
+    class C { constructor() { this.x = 1; } };
+    assert(JSON.stringify(new C()), '{"x":1}');
+
+    /* mutation while serializing */
+    o = { a: { toJSON() { delete o.b; o.c = 3; return 1; } }, b: 2 };
+    assert(JSON.stringify(o), '{"a":1}');
+    a = [1, { toJSON() { a.length = 2; a[1] = 0; return 5; } }, 3];
+    assert(JSON.stringify(a), '[1,5,null]');
+    o = { get a() { o.b = 9; return 1; }, b: 2 };
+    assert(JSON.stringify(o), '{"a":1,"b":9}');
+
+    /* cycles */
+    o = { a: [1] };
+    o.a.push(o);
+    assert_throws(TypeError, () => JSON.stringify(o));
+    o = { x: 1 };
+    assert(JSON.stringify([o, o, { y: o }]), '[{"x":1},{"x":1},{"y":{"x":1}}]');
+
+    /* the generic path gives the same result */
+    o = { a: [1, "b", { c: null }], d: -0 };
+    assert(JSON.stringify(o, null, 1), '{\n "a": [\n  1,\n  "b",\n  {\n   "c": null\n  }\n ],\n "d": 0\n}');
+    assert(JSON.stringify(o, (k, v) => v), JSON.stringify(o));
+    assert(JSON.stringify(o, ["a"]), '{"a":[1,"b",{}]}');
+}
+
 function test_date()
 {
     // Date Time String format is YYYY-MM-DDTHH:mm:ss.sssZ
@@ -798,6 +946,261 @@ function test_regexp()
     assert(a.indices[0][1], 2);
 }
 
+function test_regexp_prefilter()
+{
+    var s, a, re;
+
+    s = "INFO x\n".repeat(1000) + "ERROR: 42\nERROR: 7\n";
+    a = /ERROR: (\d+)/.exec(s);
+    assert(a.index, 7000);
+    assert(a[1], "42");
+    assert(s.match(/ERROR: (\d+)/g).join(), "ERROR: 42,ERROR: 7");
+    assert(/(\d+) FATAL/.test(s), false);
+    assert(/(\d+)\nERROR/.exec(s)[1], "42");
+    assert(/WARN|ERROR/.exec(s).index, 7000);
+    assert(/x*ERROR/.exec(s).index, 7000);
+    assert(/error/i.exec(s).index, 7000);
+    assert(/ERROR/y.test(s), false);
+
+    /* case insensitive and 16 bit strings */
+    assert(/k/ui.exec("a\u212a").index, 1);
+    assert(/ks/ui.exec("\u212a\u017f").index, 0);
+    assert(/[\u0100-\uffff]a/.exec("é\u0101a").index, 1);
+    assert("é ERROR: 1".match(/ERROR: (\d)/)[1], "1");
+
+    /* never start a match in the middle of a surrogate pair */
+    assert(/[\udc00-\udfff]/u.exec("\u{10000}\udc00").index, 2);
+    assert(/[\udc00-\udfff]/.exec("\u{10000}").index, 1);
+
+    re = /(a)|b/g;
+    assert("xbxa".replace(re, "[$1]"), "x[]x[a]");
+}
+
+function test_regexp_nfa()
+{
+    var s, a, t, n;
+
+    /* exponential with a backtracking engine */
+    s = "a".repeat(5000) + "!b";
+    assert(/(a+)+b/.test(s), false);
+    assert(/(a|aa)+b/.test(s), false);
+    assert(/^(\w+\s?)+$/.test("hello world ".repeat(300) + "!"), false);
+
+    /* same captures as the backtracking engine */
+    s = "a".repeat(3000) + "!aab";
+    a = /(a|aa)+(b)/.exec(s);
+    assert(a.index, 3001);
+    assert(a[1], "a");
+    assert(a[2], "b");
+    a = /(x+x+)+y(z)?/.exec("x".repeat(3000) + "!xxxy");
+    assert(a.index, 3001);
+    assert(a[1], "xxx");
+    assert(a[2], undefined);
+
+    /* quantified atoms which can match the empty string */
+    s = "a".repeat(28) + "!bc";
+    t = Date.now();
+    a = /(a*)*b/.exec(s);
+    assert(a.index, 29);
+    assert(a[1], undefined);
+    assert(/(?:a*)*b/.exec(s).index, 29);
+    a = /(a*)+b/.exec(s);
+    assert(a.index, 29);
+    assert(a[1], "");
+    a = /(a|a?)+b/.exec(s);
+    assert(a.index, 29);
+    assert(a[1], "");
+    assert(/(?:a*?)*b/.exec(s).index, 29);
+    a = /(a|)*b/.exec("a".repeat(3000) + "!aab");
+    assert(a.index, 3001);
+    assert(a[1], "a");
+    assert(Date.now() - t < 5000);
+
+    /* lazy loops and empty iterations: same captures as the
+       backtracking engine on the short string */
+    s = "a".repeat(28) + "x";
+    n = std.getMemoryUsage().regexp_nfa_count;
+    assert(/(a*?)*?c/.exec("aac")[1], "a");
+    assert(std.getMemoryUsage().regexp_nfa_count, n);
+    a = /(a*?)*?c/.exec(s + "aac");
+    assert(std.getMemoryUsage().regexp_nfa_count, n + 1);
+    assert(a.index, 29);
+    assert(a[1], "a");
+    a = /(a*?)*c/.exec(s + "aac");
+    assert(a.index, 29);
+    assert(a[1], "a");
+    a = /((a*)*?|b)*c/.exec(s + "abac");
+    assert(a.index, 29);
+    assert(a[1], "a");
+    assert(a[2], "a");
+    a = /(?:(a?)b?)*?c/.exec(s + "abac");
+    assert(a.index, 29);
+    assert(a[1], "a");
+}
+
+function test_regexp_jit()
+{
+    var tab, i, j, re, s, a, r;
+
+    /* the native code (if any) is used after a few executions */
+    tab = [
+        [ /a(b+)c/, "xxabbbc", "abbbc,bbb" ],
+        [ /^(\w+)\s(\d{2,4})$/m, "foo\nhello 123\nbar", "hello 123,hello,123" ],
+        [ /[a-z]+@[a-z]+\.com/i, "mail: John@Example.COM", "John@Example.COM" ],
+        [ /(a|ab)(c|bcd)(d*)/, "abcd", "abcd,a,bcd," ],
+        [ /\bfoo\b/, "afoo foo", "foo" ],
+        [ /x*y/, "xxxxz", "null" ],
+        [ /.*?(\d+)/s, "abc\n123", "abc\n123,123" ],
+        [ /(?:(a)|b)*c/, "ab".repeat(2000) + "c", "ab".repeat(2000) + "c,a" ],
+        [ /a{3,5}?$/, "aaaaaaa", "aaaaa" ],
+        [ /\u00e9+/i, "\u00c9\u00e9", "\u00c9\u00e9" ],
+        [ /(a)\1|(?=b)b/, "xaab", "aa,a" ], /* not supported by the JIT */
+    ];
+    for(i = 0; i < tab.length; i++) {
+        re = tab[i][0];
+        s = tab[i][1];
+        for(j = 0; j < 5; j++) {
+            a = re.exec(s);
+            r = (a === null) ? "null" : a.map((x) => x === undefined ? "" : x).join();
+            assert(r, tab[i][2], re.source);
+        }
+    }
+
+    re = /(\w+)=(\d+)/g;
+    s = "a=1 bb=22 ccc=333 ".repeat(100);
+    for(j = 0; j < 5; j++)
+        assert(s.replace(re, "$2:$1").slice(0, 17), "1:a 22:bb 333:ccc");
+
+    /* recompiled regexp */
+    re = /a+/;
+    for(j = 0; j < 5; j++)
+        re.exec("aaa");
+    re.compile("b+");
+    assert(re.exec("aabbb")[0], "bbb");
+    /* 16 bit strings use the interpreter */
+    assert(re.exec("\u0100bb")[0], "bb");
+}
+
+function test_regexp_cache()
+{
+    var a, b, i;
+
+    /* the compiled regexps are shared but not the objects */
+    a = new RegExp("(\\d+)-(\\d+)", "g");
+    b = new RegExp("(\\d+)-(\\d+)", "g");
+    assert(a !== b);
+    assert(a.exec("1-2 3-4")[0], "1-2");
+    assert(a.lastIndex, 3);
+    assert(b.lastIndex, 0);
+    assert(b.exec("5-6")[2], "6");
+
+    /* same flags in a different order */
+    a = new RegExp("x.", "si");
+    b = new RegExp("x.", "is");
+    assert(a.flags, "is");
+    assert(b.test("X\n"), true);
+    assert(new RegExp("x.", "i").test("X\n"), false);
+    assert(new RegExp("x.").source, "x.");
+
+    /* 8 and 16 bit patterns */
+    assert(new RegExp("\u00e9").test("\u00e9"), true);
+    assert(new RegExp("\u0101").test("\u0101"), true);
+    assert(new RegExp("\u00e9").test("\u0101"), false);
+
+    /* the errors are not cached */
+    for(i = 0; i < 2; i++)
+        assert_throws(SyntaxError, () => new RegExp("(", "g"));
+
+    a = /a/;
+    a.compile("b", "g");
+    assert(a.test("b"), true);
+    assert(new RegExp("b", "g").global, true);
+}
+
+function test_regexp_replace_fast()
+{
+    var a, re, args;
+
+    /* replacement patterns */
+    assert("a1b22c".replace(/(\d)(\d)?/g, "[$1|$2|$&|$$|$0|$3]"),
+           "a[1||1|$|$0|$3]b[2|2|22|$|$0|$3]c");
+    assert("abc".replace(/b/, "$`$'"), "aacc");
+    assert("abc".replace(/b/, "$"), "a$c");
+    assert("abcdefghijkl".replace(/(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)/, "$11$01$111"),
+           "k" + "a" + "k1" + "l");
+    assert("2024-05".replace(/(?<y>\d+)-(?<m>\d+)/, "$<m>/$<y>$<z>"), "05/2024");
+    assert("ab".replace(/(a)/, "$<x>"), "$<x>b");
+    assert("ab".replace(/(?<x>a)/, "$<x"), "$<xb");
+
+    /* function replacement */
+    args = [];
+    a = "x1y2".replace(/(?<d>\d)|(z)/g, function () {
+        args.push(Array.prototype.slice.call(arguments));
+        return "<" + arguments[0] + ">";
+    });
+    assert(a, "x<1>y<2>");
+    assert(args.length, 2);
+    assert(args[1][0], "2");
+    assert(args[1][2], undefined);
+    assert(args[1][3], 3);
+    assert(args[1][4], "x1y2");
+    assert(args[1][5].d, "2");
+    assert(Object.getPrototypeOf(args[1][5]), null);
+    assert("aaa".replace(/a/g, () => 1), "111");
+    /* the function may recompile the regexp */
+    re = /(?<n>a)/g;
+    assert("aa".replace(re, function (m, p1, pos, s, g) {
+        re.compile("b");
+        return g.n + pos;
+    }), "a0a1");
+
+    /* empty matches and unicode */
+    assert("abc".replace(/x*/g, "-"), "-a-b-c-");
+    assert("😀".replace(/(?:)/gu, "-"), "-😀-");
+    assert("😀".replace(/(?:)/gv, "-"), "-😀-");
+    assert("😀".replace(/(?:)/g, "-"), "-\ud83d-\ude00-");
+
+    /* lastIndex */
+    re = /a/g;
+    re.lastIndex = 3;
+    assert("aXa".replace(re, "b"), "bXb");
+    assert(re.lastIndex, 0);
+    re = /a/y;
+    re.lastIndex = 1;
+    assert("aab".replace(re, "c"), "acb");
+    assert(re.lastIndex, 2);
+    assert("aab".replace(re, "c"), "aab");
+    assert(re.lastIndex, 0);
+    re = /a/;
+    re.lastIndex = 1;
+    assert("aa".replace(re, "b"), "ba");
+    assert(re.lastIndex, 1);
+    re = /a/g;
+    Object.defineProperty(re, "lastIndex", { writable: false });
+    assert_throws(TypeError, () => "a".replace(re, "b"));
+
+    /* match */
+    assert("a1b22".match(/\d/g).join(), "1,2,2");
+    assert("ab".match(/\d/g), null);
+    assert("ab".match(/(?:)/g).length, 3);
+    re = /a/g;
+    re.lastIndex = 5;
+    assert("aa".match(re).length, 2);
+    assert(re.lastIndex, 0);
+
+    /* split */
+    assert("a,b,,c".split(/,/).join("|"), "a|b||c");
+    assert("a1b2c".split(/(\d)/).join("|"), "a|1|b|2|c");
+    assert("a1b".split(/(\d)|(x)/).length, 4);
+    assert("a1b".split(/(\d)|(x)/)[2], undefined);
+    assert("a,b,c".split(/,/, 2).join("|"), "a|b");
+    assert("a1b2c".split(/(\d)/, 2).join("|"), "a|1");
+    assert("abc".split(/(?:)/).join("|"), "a|b|c");
+    assert("😀x".split(/(?:)/u).length, 2);
+    assert("".split(/x/).length, 1);
+    assert("".split(/(?:)/).length, 0);
+}
+
 function test_symbol()
 {
     var a, b, obj, c;
@@ -969,6 +1372,41 @@ function test_weak_ref()
     }
 }
 
+function test_gc_step()
+{
+    var w, tab, i, a, b, live;
+
+    /* cycles are freed by the incremental steps */
+    tab = [];
+    for(i = 0; i < 100; i++) {
+        a = { };
+        b = { a: a };
+        a.b = b;
+        tab.push(new WeakRef(b));
+    }
+    a = b = null;
+    w = (function() {
+        var f = function() { return f; };
+        return new WeakRef(f);
+    })();
+    std.gcStep(1000000);
+    live = 0;
+    for(i = 0; i < tab.length; i++) {
+        if (tab[i].deref())
+            live++;
+    }
+    assert(live, 0);
+    assert(w.deref(), undefined);
+
+    /* live objects are kept */
+    a = { };
+    a.self = a;
+    w = new WeakRef(a);
+    std.gcStep(1000000);
+    assert(w.deref(), a);
+    assert(a.self, a);
+}
+
 function test_finalization_registry()
 {
     {
@@ -992,6 +1430,188 @@ function test_finalization_registry()
     std.gc();
 }
 
+function test_shape_transitions()
+{
+    var a, b, i, j, o, tab;
+
+    function make(keys, v) {
+        var o = {};
+        for(var i = 0; i < keys.length; i++)
+            o[keys[i]] = v + i;
+        return o;
+    }
+
+    /* same properties in different orders */
+    for(i = 0; i < 3; i++) {
+        a = make(["x", "y", "z"], i);
+        b = make(["x", "z", "y"], i);
+        assert(Object.keys(a).join(), "x,y,z");
+        assert(Object.keys(b).join(), "x,z,y");
+        assert(a.y, i + 1);
+        assert(b.y, i + 2);
+        /* the intermediate shapes are pruned by the GC */
+        std.gc();
+    }
+
+    /* modifying an object does not change the others */
+    a = make(["x", "y"], 0);
+    b = make(["x", "y"], 0);
+    delete a.x;
+    a.z = 1;
+    assert(Object.keys(a).join(), "y,z");
+    assert(Object.keys(b).join(), "x,y");
+    Object.defineProperty(b, "y", { enumerable: false });
+    o = make(["x", "y"], 0);
+    assert(Object.keys(o).join(), "x,y");
+    assert(Object.keys(b).join(), "x");
+
+    /* large objects and large fan-out */
+    tab = [];
+    for(i = 0; i < 100; i++) {
+        o = {};
+        for(j = 0; j < 40; j++)
+            o["p" + ((i + j) % 100)] = j;
+        tab.push(o);
+    }
+    std.gc();
+    for(i = 0; i < 100; i++) {
+        o = tab[i];
+        assert(Object.keys(o).length, 40);
+        assert(o["p" + ((i + 39) % 100)], 39);
+    }
+}
+
+function test_array_kinds()
+{
+    var a, b, i;
+
+    /* int32 -> float64 -> generic */
+    a = [1, 2, 3];
+    a.push(4);
+    assert(a.join(), "1,2,3,4");
+    a[1] = 2.5;
+    assert(a.join(), "1,2.5,3,4");
+    a.push(-0);
+    assert(Object.is(a[4], -0));
+    a[0] = "x";
+    assert(a.join(), "x,2.5,3,4,0");
+    a[2] = { v: 1 };
+    assert(a[2].v, 1);
+
+    /* large ints and -0 do not fit the int32 kind */
+    a = [1];
+    a.push(2 ** 31);
+    a.push(-0);
+    assert(a[1], 2147483648);
+    assert(Object.is(a[2], -0));
+
+    /* pop, shift, reverse */
+    a = [1, 2, 3, 4];
+    assert(a.pop(), 4);
+    assert(a.shift(), 1);
+    assert(a.join(), "2,3");
+    a = [1.5, 2.5, 3.5];
+    assert(a.shift(), 1.5);
+    a.reverse();
+    assert(a.join(), "3.5,2.5");
+    a = [1, 2, 3, 4, 5];
+    a.reverse();
+    assert(a.join(), "5,4,3,2,1");
+
+    /* default sort uses the string order */
+    a = [10, 9, 1, -1, -10, 100, 0, -2147483648, 2147483647, 2];
+    a.sort();
+    assert(a.join(), "-1,-10,-2147483648,0,1,10,100,2,2147483647,9");
+    a = [3, 1, 2];
+    a.sort((x, y) => x - y);
+    assert(a.join(), "1,2,3");
+    a = [0.5, 10, 2];
+    a.sort();
+    assert(a.join(), "0.5,10,2");
+
+    /* fill */
+    a = [1, 2, 3, 4];
+    a.fill(7, 1, 3);
+    assert(a.join(), "1,7,7,4");
+    a.fill(0.5, 2);
+    assert(a.join(), "1,7,0.5,0.5");
+    a.fill("s", 3);
+    assert(a.join(), "1,7,0.5,s");
+
+    /* indexOf and includes */
+    a = [1, 2, 3];
+    assert(a.indexOf(2), 1);
+    assert(a.indexOf(2.0), 1);
+    assert(a.indexOf(2.5), -1);
+    assert(a.indexOf("2"), -1);
+    assert(a.includes(3, 1), true);
+    assert(a.includes(1, 1), false);
+    assert(a.indexOf(-0), -1);
+    a = [1.5, NaN, 0];
+    assert(a.indexOf(NaN), -1);
+    assert(a.includes(NaN), true);
+    assert(a.indexOf(-0), 2);
+    assert(a.includes(-0), true);
+    assert(a.indexOf(1.5), 0);
+
+    /* copyWithin, length truncation, delete */
+    a = [1, 2, 3, 4, 5];
+    a.copyWithin(0, 3);
+    assert(a.join(), "4,5,3,4,5");
+    a = [1.5, 2.5, 3.5, 4.5];
+    a.copyWithin(1, 0, 2);
+    assert(a.join(), "1.5,1.5,2.5,4.5");
+    a.length = 2;
+    assert(a.join(), "1.5,1.5");
+    a = [1, 2, 3];
+    delete a[2];
+    assert(a.length, 3);
+    assert(2 in a, false);
+    delete a[0];
+    assert(0 in a, false);
+    assert(a[1], 2);
+
+    /* spread, apply and iteration */
+    a = [1, 2.5, 3];
+    b = [...a];
+    assert(b.join(), "1,2.5,3");
+    assert(Math.max.apply(null, a), 3);
+    assert(Math.min(...[4, 5, 6]), 4);
+    b = 0;
+    for (i of a)
+        b += i;
+    assert(b, 6.5);
+    assert(a.map((x) => x * 2).join(), "2,5,6");
+    assert([1, 2, 3].reduce((x, y) => x + y), 6);
+    assert(a.slice(1).join(), "2.5,3");
+    assert(a.at(-1), 3);
+    assert(a.with(0, "z").join(), "z,2.5,3");
+    assert(a.toReversed().join(), "3,2.5,1");
+    assert([3, 1, 2].toSorted().join(), "1,2,3");
+    assert(JSON.stringify([1, 2.5, null]), "[1,2.5,null]");
+
+    /* map, filter, forEach and reduce with a callback modifying the array */
+    a = [1, 2, 3, 4];
+    b = a.map((x, i) => { if (i == 1) a[2] = 3.5; return x * 2; });
+    assert(b.join(), "2,4,7,8");
+    b = a.map((x, i) => i == 2 ? "s" : x + 0.5);
+    assert(b.join(), "1.5,2.5,s,4.5");
+    a = [1, 2, 3, 4];
+    b = a.filter((x, i) => { if (i == 0) a.length = 2; return true; });
+    assert(b.join(), "1,2");
+    a = [1.5, 2.5, 3.5];
+    b = [];
+    a.forEach((x, i) => { if (i == 0) a[1] = "x"; b.push(x); });
+    assert(b.join(), "1.5,x,3.5");
+    a = [1, 2, 3, 4];
+    assert(a.reduce((s, x, i) => { if (i == 1) a.pop(); return s + x; }), 6);
+    a = [1, 2.5, 3];
+    assert(a.reduceRight((s, x, i) => { if (i == 1) a[0] = 10; return s + x; }, 0), 15.5);
+    b = Object.freeze([]);
+    class A extends Array { static get [Symbol.species]() { return function () { return b; }; } }
+    assert_throws(TypeError, () => A.from([1, 2]).map((x) => x));
+}
+
 function test_generator()
 {
     function *f() {
@@ -1165,20 +1785,31 @@ test();
 test_function();
 test_enum();
 test_array();
+test_array_kinds();
 test_string();
+test_string_search();
 test_math();
 test_number();
 test_eval();
 test_typed_array();
 test_json();
+test_json_parse_fast();
+test_json_stringify_fast();
 test_date();
 test_regexp();
+test_regexp_prefilter();
+test_regexp_nfa();
+test_regexp_jit();
+test_regexp_cache();
+test_regexp_replace_fast();
 test_symbol();
 test_map();
 test_weak_map();
 test_weak_map_cycles();
 test_weak_ref();
+test_gc_step();
 test_finalization_registry();
+test_shape_transitions();
 test_generator();
 test_rope();
 test_line_column_numbers();
@@ -0,0 +1,219 @@
+/*
+ * Test of JS_NewContextFromTemplate()
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "../quickjs.h"
+
+#define CLONE_COUNT 3
+
+static int test_failed;
+
+static void check(int cond, const char *msg)
+{
+    if (!cond) {
+        fprintf(stderr, "test_context_template: %s\n", msg);
+        test_failed = 1;
+    }
+}
+
+static void dump_error(JSContext *ctx)
+{
+    JSValue exc;
+    const char *str;
+
+    exc = JS_GetException(ctx);
+    str = JS_ToCString(ctx, exc);
+    fprintf(stderr, "test_context_template: exception: %s\n",
+            str ? str : "?");
+    JS_FreeCString(ctx, str);
+    JS_FreeValue(ctx, exc);
+}
+
+/* evaluate 'expr' and compare its string conversion with 'expected' */
+static void check_eval(JSContext *ctx, const char *expr, const char *expected)
+{
+    JSValue val;
+    const char *str;
+
+    val = JS_Eval(ctx, expr, strlen(expr), "<test>", JS_EVAL_TYPE_GLOBAL);
+    if (JS_IsException(val)) {
+        dump_error(ctx);
+        check(0, expr);
+        return;
+    }
+    str = JS_ToCString(ctx, val);
+    if (!str || strcmp(str, expected) != 0) {
+        fprintf(stderr, "test_context_template: %s: got '%s', expected '%s'\n",
+                expr, str ? str : "?", expected);
+        test_failed = 1;
+    }
+    JS_FreeCString(ctx, str);
+    JS_FreeValue(ctx, val);
+}
+
+static JSValue js_twice(JSContext *ctx, JSValueConst this_val,
+                        int argc, JSValueConst *argv)
+{
+    int v;
+    if (JS_ToInt32(ctx, &v, argv[0]))
+        return JS_EXCEPTION;
+    return JS_NewInt32(ctx, v * 2);
+}
+
+static JSContext *new_template(JSRuntime *rt)
+{
+    JSContext *ctx;
+    JSValue global_obj, obj;
+    static const char init[] =
+        "var config = { list: [1, 2, { name: 'x' }], big: 10n,"
+        "               date: new Date(0), str: new String('s') };"
+        "Object.defineProperty(config, 'getter',"
+        "                      { get: Object.getOwnPropertyDescriptor(Map.prototype, 'size').get });"
+        "Array.prototype.tmplTag = 'tmpl';";
+
+    ctx = JS_NewContext(rt);
+    if (!ctx)
+        return NULL;
+    global_obj = JS_GetGlobalObject(ctx);
+    JS_SetPropertyStr(ctx, global_obj, "twice",
+                      JS_NewCFunction(ctx, js_twice, "twice", 1));
+    obj = JS_NewObject(ctx);
+    JS_SetPropertyStr(ctx, obj, "v", JS_NewString(ctx, "host"));
+    JS_SetPropertyStr(ctx, global_obj, "hostObj", obj);
+    JS_FreeValue(ctx, global_obj);
+    JS_FreeValue(ctx, JS_Eval(ctx, init, strlen(init), "<init>",
+                              JS_EVAL_TYPE_GLOBAL));
+    return ctx;
+}
+
+/* the state of a fresh clone of the template */
+static void check_template_state(JSContext *ctx)
+{
+    check_eval(ctx, "twice(21)", "42");
+    check_eval(ctx, "hostObj.v", "host");
+    check_eval(ctx, "config.list.length + ' ' + config.list[2].name", "3 x");
+    check_eval(ctx, "config.big * 2n", "20");
+    check_eval(ctx, "config.date.getTime() + ' ' + config.str.length", "0 1");
+    check_eval(ctx, "[].tmplTag", "tmpl");
+    check_eval(ctx, "typeof clonedTag + ' ' + ({}).protoTag", "undefined undefined");
+    /* the intrinsics are the ones of the clone */
+    check_eval(ctx, "config.list instanceof Array && "
+               "Object.getPrototypeOf([]) === Array.prototype && "
+               "Object.getPrototypeOf(config) === Object.prototype && "
+               "Object.getPrototypeOf(twice) === Function.prototype",
+               "true");
+    check_eval(ctx, "try { null.x } catch (e) { e instanceof TypeError }",
+               "true");
+    check_eval(ctx, "JSON.stringify([1, 'a', /b+/.exec('abb')[0]]) + "
+               "[3, 1, 2].sort().join()", "[1,\"a\",\"bb\"]1,2,3");
+    check_eval(ctx, "typeof Promise + typeof Proxy + typeof WeakRef",
+               "functionfunctionfunction");
+}
+
+static void test_clones(JSRuntime *rt)
+{
+    JSContext *tmpl, *tab[CLONE_COUNT], *ctx;
+    char buf[256];
+    int i;
+
+    tmpl = new_template(rt);
+    check(tmpl != NULL, "template creation");
+    for(i = 0; i < CLONE_COUNT; i++) {
+        tab[i] = JS_NewContextFromTemplate(rt, tmpl);
+        if (!tab[i]) {
+            dump_error(tmpl);
+            check(0, "clone creation");
+            return;
+        }
+    }
+
+    /* modify the globals and the intrinsics of each clone */
+    for(i = 0; i < CLONE_COUNT; i++) {
+        ctx = tab[i];
+        check_template_state(ctx);
+        snprintf(buf, sizeof(buf),
+                 "globalThis.clonedTag = %d; Object.prototype.protoTag = %d;"
+                 "config.list.push(%d); hostObj.v = 'v%d';"
+                 "Array.prototype.tmplTag = 't%d'; Math.max = null;",
+                 i, i, i, i, i);
+        JS_FreeValue(ctx, JS_Eval(ctx, buf, strlen(buf), "<test>",
+                                  JS_EVAL_TYPE_GLOBAL));
+    }
+    for(i = 0; i < CLONE_COUNT; i++) {
+        ctx = tab[i];
+        snprintf(buf, sizeof(buf), "%d %d 1,2,[object Object],%d v%d t%d null",
+                 i, i, i, i, i);
+        check_eval(ctx, "clonedTag + ' ' + ({}).protoTag + ' ' + config.list "
+                   "+ ' ' + hostObj.v + ' ' + [].tmplTag + ' ' + Math.max",
+                   buf);
+    }
+    /* the template is not modified */
+    check_template_state(tmpl);
+
+    /* free the template before its clones */
+    JS_FreeContext(tmpl);
+    JS_RunGC(rt);
+    check_eval(tab[0], "config.list.length + ' ' + twice(2)", "4 4");
+
+    /* clone a clone */
+    ctx = JS_NewContextFromTemplate(rt, tab[1]);
+    if (!ctx) {
+        dump_error(tab[1]);
+        check(0, "clone of a clone");
+    } else {
+        check_eval(ctx, "clonedTag + ' ' + config.list + ' ' + [].tmplTag",
+                   "1 1,2,[object Object],1 t1");
+        JS_FreeValue(ctx, JS_Eval(ctx, "config.list.pop(); clonedTag = 9",
+                                  strlen("config.list.pop(); clonedTag = 9"),
+                                  "<test>", JS_EVAL_TYPE_GLOBAL));
+        check_eval(ctx, "clonedTag + ' ' + config.list.length", "9 3");
+        check_eval(tab[1], "clonedTag + ' ' + config.list.length", "1 4");
+        JS_FreeContext(ctx);
+    }
+
+    for(i = 0; i < CLONE_COUNT; i++)
+        JS_FreeContext(tab[i]);
+}
+
+static void test_unsupported(JSRuntime *rt)
+{
+    JSContext *tmpl, *ctx;
+    JSValue exc;
+    const char *str;
+    static const char init[] = "globalThis.f = function () { return 1; }";
+
+    tmpl = JS_NewContext(rt);
+    JS_FreeValue(tmpl, JS_Eval(tmpl, init, strlen(init), "<init>",
+                               JS_EVAL_TYPE_GLOBAL));
+    ctx = JS_NewContextFromTemplate(rt, tmpl);
+    check(ctx == NULL, "the bytecode functions must be rejected");
+    if (ctx) {
+        JS_FreeContext(ctx);
+    } else {
+        exc = JS_GetException(tmpl);
+        str = JS_ToCString(tmpl, exc);
+        check(str && !strcmp(str, "TypeError: unsupported object in the "
+                             "context template"), "rejection exception");
+        JS_FreeCString(tmpl, str);
+        JS_FreeValue(tmpl, exc);
+    }
+    /* the template is still usable */
+    check_eval(tmpl, "f()", "1");
+    JS_FreeContext(tmpl);
+}
+
+int main(int argc, char **argv)
+{
+    JSRuntime *rt;
+
+    rt = JS_NewRuntime();
+    test_clones(rt);
+    test_unsupported(rt);
+    JS_FreeRuntime(rt);
+    if (test_failed)
+        return 1;
+    printf("test_context_template: OK\n");
+    return 0;
+}
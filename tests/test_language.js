@@ -622,12 +622,281 @@ function test_optional_chaining()
     assert((a?.["b"])().c, 42);
 }
 
+/* property accesses whose inline cache must be invalidated */
+function test_inline_properties()
+{
+    var i, j, o, tab;
+
+    function C(n) {
+        for(var i = 0; i < n; i++)
+            this["p" + i] = i;
+    }
+
+    /* the objects grow past their inline slots */
+    tab = [];
+    for(i = 0; i < 20; i++)
+        tab.push(new C(i));
+    for(i = 0; i < 20; i++) {
+        o = tab[i];
+        assert(Object.keys(o).length, i);
+        for(j = 0; j < i; j++)
+            assert(o["p" + j], j);
+    }
+
+    /* property deletion compacts the properties */
+    o = new C(20);
+    for(i = 0; i < 18; i++)
+        delete o["p" + i];
+    assert(Object.keys(o).join(), "p18,p19");
+    o.q = 1;
+    assert(o.p19 + o.q, 20);
+
+    o = { a: 1, b: 2 };
+    Object.defineProperty(o, "c", { get: function() { return 3; } });
+    Object.freeze(o);
+    assert(o.a + o.b + o.c, 6);
+}
+
+function test_inline_cache()
+{
+    var i, r, a, proto, objs;
+
+    function get_x(o) { return o.x; }
+    function set_x(o, v) { o.x = v; }
+
+    /* polymorphic then megamorphic site */
+    objs = [ { x: 1 }, { a: 0, x: 2 }, { b: 0, x: 3 }, { c: 0, x: 4 },
+             { d: 0, x: 5 }, { e: 0, x: 6 } ];
+    for(i = 0; i < 3; i++) {
+        r = 0;
+        for(a of objs)
+            r += get_x(a);
+        assert(r, 21, "inline cache");
+    }
+
+    /* prototype chain modifications */
+    proto = { x: 1 };
+    a = Object.create(Object.create(proto));
+    assert(get_x(a), 1);
+    proto.x = 2;
+    assert(get_x(a), 2);
+    Object.getPrototypeOf(a).x = 3;
+    assert(get_x(a), 3);
+    delete Object.getPrototypeOf(a).x;
+    assert(get_x(a), 2);
+    Object.defineProperty(proto, "x", { get() { return 4; } });
+    assert(get_x(a), 4);
+    Object.setPrototypeOf(Object.getPrototypeOf(a), { x: 5 });
+    assert(get_x(a), 5);
+    a.x = 6;
+    assert(get_x(a), 6);
+
+    /* own properties */
+    a = { x: 1, y: 2 };
+    set_x(a, 2);
+    assert(get_x(a), 2);
+    delete a.x;
+    assert(get_x(a), undefined);
+    a.x = 3;
+    Object.freeze(a);
+    assert_throws(TypeError, () => { "use strict"; a.x = 4; });
+    assert(get_x(a), 3);
+    a = Object.defineProperty({}, "x", { value: 1, writable: true });
+    set_x(a, 2);
+    Object.defineProperty(a, "x", { writable: false });
+    set_x(a, 3);
+    assert(get_x(a), 2);
+
+    /* array objects */
+    a = [1, 2];
+    assert(get_x(a), undefined);
+    Array.prototype.x = 7;
+    assert(get_x(a), 7);
+    delete Array.prototype.x;
+    assert(get_x(a), undefined);
+}
+
+/* the loops are long enough to be compiled when the JIT is enabled */
+function test_jit()
+{
+    var i, r, s, a, o;
+
+    function sum(n) {
+        var s = 0;
+        for(var i = 0; i < n; i++)
+            s += i;
+        return s;
+    }
+    assert(sum(100000), 4999950000, "int overflow");
+
+    /* mixed types in the same loop */
+    a = [ 1, 2.5, "a", null, undefined, true, -0, 1n ];
+    r = [];
+    for(i = 0; i < 2000; i++) {
+        s = a[i % a.length];
+        if (typeof s === "bigint")
+            r.push(s + 1n);
+        else
+            r.push(s + 1);
+    }
+    assert(r.slice(0, 8).join(), "2,3.5,a1,1,NaN,2,1,2");
+    r = 0;
+    for(i = 0; i < 2000; i++) {
+        r = (r * 31 + i) | 0;
+        r ^= r >>> 3;
+        r = (r << 1) >> 1;
+    }
+    assert(r, 1050056484, "bitwise ops");
+    assert(0 * -1, -0);
+    for(i = 0; i < 2000; i++)
+        s = (i - 2000) * 0;
+    assert(Object.is(s, -0), true, "-0 result");
+    for(i = 0; i < 2000; i++)
+        s = 0xffffffff >>> (i & 1);
+    assert(s, 0x7fffffff);
+    s = "";
+    for(i = 0; i < 2000; i++)
+        s += "x";
+    assert(s.length, 2000);
+    for(i = 0, s = 0; i < 2000; i++)
+        s += (i < NaN) + (i == "1") + (i === 1);
+    assert(s, 2);
+
+    /* property accesses, calls and exceptions in hot loops */
+    o = { x: 0 };
+    for(i = 0; i < 2000; i++) {
+        o.x = o.x + 1;
+        a[i & 7] = Math.max(i, 5);
+    }
+    assert(o.x, 2000);
+    assert(a[7], 1999);
+    r = 0;
+    for(i = 0; i < 2000; i++) {
+        try {
+            if (i % 100 == 99)
+                null.x;
+        } catch(e) {
+            r++;
+        }
+    }
+    assert(r, 20, "exceptions");
+    assert_throws(ReferenceError, () => {
+        for(let j = 0; j < 2000; j++) {
+            if (j == 1500)
+                z;
+            let z = j;
+        }
+    });
+}
+
 function test_unicode_ident()
 {
     var Ãµ = 3;
     assert(typeof õ, "undefined");
 }
 
+/* nested functions are compiled on their first call */
+function test_lazy_function()
+{
+    var x = 1, fns, i, o, f;
+    let y = 2;
+    const z = 3;
+
+    function sum(n) {
+        var s = 0;
+        for(var i = 0; i < n; i++)
+            s += x + y + z + i;
+        return n > 0 ? s + sum(n - 1) : 0;
+    }
+    assert(sum(3), 40);
+    assert(sum.toString().slice(0, 16), "function sum(n) ");
+    assert(sum.lineNumber, 805);
+
+    function inc() {
+        var t = 0;
+        for(var i = 0; i < 2; i++)
+            t += i;
+        x += t;
+        try {
+            z = t;
+        } catch(e) {
+            return e.name;
+        }
+    }
+    assert(inc(), "TypeError");
+    assert(x, 2);
+
+    /* several closures sharing the same lazily compiled function */
+    fns = [];
+    for(let j = 0; j < 3; j++) {
+        fns.push(function () {
+            var r = 0;
+            for(var k = 0; k < 2; k++)
+                r += j * 10 + k;
+            { let x = "inner"; r += x.length; }
+            return r + x;
+        });
+    }
+    assert(fns.map((f) => f()).join(), "8,28,48");
+
+    /* this, arguments and new.target in arrow functions */
+    function F(a) {
+        var g = () => {
+            var r = [];
+            for(var k = 0; k < 2; k++)
+                r.push(this.v, arguments[k], typeof new.target);
+            return r.join();
+        };
+        this.v = a;
+        this.r = g();
+    }
+    assert(new F(4).r, "4,4,function,4,,function");
+
+    /* methods, super and private fields */
+    class A {
+        #p = 5;
+        m() { return 1; }
+        get p() {
+            var r = this.#p;
+            for(var k = 0; k < 2; k++)
+                r += k;
+            return r;
+        }
+    }
+    class B extends A {
+        m() {
+            var r = 0;
+            for(var k = 0; k < 2; k++)
+                r += super.m() + k;
+            return (() => r + super.m() * 10)();
+        }
+    }
+    o = new B();
+    assert(o.m(), 13);
+    assert(o.p, 6);
+
+    function* gen(n) {
+        for(var k = 0; k < n; k++) {
+            var a = k * 2, b = a + 1;
+            yield a + b + x;
+        }
+    }
+    assert([...gen(3)].join(), "3,7,11");
+
+    function thrower() {
+        var a = 1, b = 2;
+        for(var k = 0; k < 2; k++)
+            a += b;
+        throw Error("e" + a);
+    }
+    try {
+        thrower();
+    } catch(e) {
+        assert(e.message, "e5");
+        assert(e.stack.includes("test_language.js:890"), true);
+    }
+}
+
 test_op1();
 test_cvt();
 test_eq();
@@ -652,3 +921,7 @@ test_parse_semicolon();
 test_optional_chaining();
 test_parse_arrow_function();
 test_unicode_ident();
+test_inline_cache();
+test_inline_properties();
+test_jit();
+test_lazy_function();
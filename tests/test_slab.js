@@ -0,0 +1,55 @@
+/* run with --slab or --slab-release and --std */
+"use strict";
+
+function assert(actual, expected, message) {
+    if (arguments.length == 1)
+        expected = true;
+
+    if (actual === expected)
+        return;
+
+    throw Error("assertion failed: got |" + actual + "|" +
+                ", expected |" + expected + "|" +
+                (message ? " (" + message + ")" : ""));
+}
+
+function test_accounting()
+{
+    var m0, m1, tab, i, n;
+
+    n = 10000;
+    std.gc();
+    m0 = std.getMemoryUsage();
+    tab = [];
+    for(i = 0; i < n; i++)
+        tab.push({ x: i });
+    m1 = std.getMemoryUsage();
+    assert(m1.slab_arena_count > 0, true, "slab enabled");
+    /* each object block is counted with its size class */
+    assert(m1.malloc_count - m0.malloc_count >= n, true, "malloc_count");
+    assert(m1.malloc_size - m0.malloc_size >= n * 32, true, "malloc_size");
+    assert(m1.slab_used_count - m0.slab_used_count >= n, true, "slab_used_count");
+    tab = null;
+    std.gc();
+    m1 = std.getMemoryUsage();
+    assert(m1.malloc_count - m0.malloc_count < n / 10, true, "freed malloc_count");
+    assert(m1.malloc_size - m0.malloc_size < n * 3, true, "freed malloc_size");
+}
+
+/* the GC threshold must follow the live blocks, not the arenas */
+function test_cyclic_garbage()
+{
+    var i, a, b, m;
+
+    for(i = 0; i < 1000000; i++) {
+        a = {};
+        b = { a };
+        a.b = b;
+    }
+    m = std.getMemoryUsage();
+    assert(m.slab_arena_size < 16 << 20, true, "slab_arena_size");
+    assert(m.malloc_size < 16 << 20, true, "malloc_size");
+}
+
+test_accounting();
+test_cyclic_garbage();
@@ -19,6 +19,20 @@ function assert(actual, expected, message) {
                 (message ? " (" + message + ")" : ""));
 }
 
+function assert_throws(expected_error, func)
+{
+    var err = false;
+    try {
+        func();
+    } catch(e) {
+        err = true;
+        if (!(e instanceof expected_error))
+            throw Error("unexpected exception type: " + e);
+    }
+    if (!err)
+        throw Error("expected exception");
+}
+
 // load more elaborate version of assert if available
 try { std.loadScript("test_assert.js"); } catch(e) {}
 
@@ -104,6 +118,37 @@ function test_getline()
     f.close();
 }
 
+function test_utf8()
+{
+    var f, str, i, tab, bytes;
+
+    tab = [ "", "hello", "café", "€", "😀",
+            "x".repeat(100) + "é" + "y".repeat(40) + "ā" + "z".repeat(20),
+            "é".repeat(50) + "a".repeat(33) + "中".repeat(10),
+            "\ud800", "a\udc00b" ];
+    for(i = 0; i < tab.length; i++) {
+        str = tab[i];
+        f = std.tmpfile();
+        /* convert the same string twice */
+        f.puts(str);
+        f.puts(str);
+        f.seek(0, std.SEEK_SET);
+        assert(f.readAsString(), str + str);
+        f.close();
+    }
+
+    /* invalid sequences give U+FFFD */
+    bytes = [ 0x61, 0xc3, 0x28, 0x62, 0xe2, 0x82, 0x63, 0xff, 0x64 ];
+    f = std.tmpfile();
+    for(i = 0; i < 20; i++)
+        f.putByte(0x41);
+    for(i = 0; i < bytes.length; i++)
+        f.putByte(bytes[i]);
+    f.seek(0, std.SEEK_SET);
+    assert(f.readAsString(), "A".repeat(20) + "a\ufffd(b\ufffdc\ufffdd");
+    f.close();
+}
+
 function test_popen()
 {
     var str, f, fname = "tmp_file.txt";
@@ -152,6 +197,55 @@ c\\vd", // multi-line strings, '\v' escape
     assert(obj[7], -0.2);
 }
 
+function test_json_parser()
+{
+    var text, res, p, i, buf, n;
+
+    function parse(text, options, chunk_size) {
+        var res = [], p, i;
+        p = new std.JSONParser((val, key) => res.push([key, val]), options);
+        for(i = 0; i < text.length; i += chunk_size)
+            p.feed(text.substring(i, i + chunk_size));
+        p.end();
+        return JSON.stringify(res);
+    }
+
+    text = '{"a": [1, -2.5e1, "x\\u00e9\\n\\"\u20ac", true, null], "b": {"c": []}}';
+    for(i = 1; i <= 4; i++) {
+        assert(parse(text, undefined, i), JSON.stringify([[undefined, JSON.parse(text)]]));
+        assert(parse(text, { depth: 1 }, i),
+               '[["a",[1,-25,"x\u00e9\\n\\"\u20ac",true,null]],["b",{"c":[]}]]');
+        assert(parse(text, { depth: 2 }, i),
+               '[[0,1],[1,-25],[2,"x\u00e9\\n\\"\u20ac"],[3,true],[4,null],["c",[]]]');
+        assert(parse('1 [2]\n{"a":3} "s"', { multi: true }, i),
+               '[[null,1],[null,[2]],[null,{"a":3}],[null,"s"]]');
+    }
+
+    /* the input may be split inside a UTF-8 sequence */
+    buf = new Uint8Array([0x5b, 0x22, 0xc3, 0xa9, 0xe2, 0x82, 0xac, 0x22, 0x5d]);
+    res = [];
+    p = new std.JSONParser((val) => res.push(val));
+    for(i = 0; i < buf.length; i++)
+        p.feed(buf.buffer, i, 1);
+    p.end();
+    assert(res[0][0], "\u00e9\u20ac");
+    assert_throws(TypeError, () => p.feed("1"));
+
+    for (text of [ "", "[1,]", '{"a" 1}', "[1 2]", "01", "1.", '"abc', "[", "1 2", "tru", '"\\x"' ]) {
+        assert_throws(SyntaxError, () => parse(text, undefined, 1));
+    }
+
+    /* only the current element is kept in memory */
+    n = 0;
+    p = new std.JSONParser((val, key) => { assert(val.id, key); n++; }, { depth: 1 });
+    p.feed("[");
+    for(i = 0; i < 10000; i++)
+        p.feed((i ? ',' : '') + '{"id":' + i + ',"name":"item"}');
+    p.feed("]");
+    p.end();
+    assert(n, 10000);
+}
+
 function test_os()
 {
     var fd, fpath, fname, fdir, buf, buf2, i, files, err, fdate, st, link_path;
@@ -286,6 +380,46 @@ function test_timer()
         os.clearTimeout(th[i]);
 }
 
+function test_timer_order()
+{
+    var log = [], th, i, ids = [], count = 0;
+
+    os.setTimeout(function () {
+        log.push("b");
+        Promise.resolve().then(() => log.push("b.job"));
+    }, 5);
+    os.setTimeout(() => log.push("a"), 1);
+    th = os.setTimeout(() => log.push("c"), 5);
+    os.setTimeout(function () { log.push("d"); os.clearTimeout(th); }, 3);
+    /* many timers, half of them removed */
+    for(i = 0; i < 1000; i++)
+        ids.push(os.setTimeout(() => count++, 10 + (i % 7)));
+    for(i = 0; i < 1000; i += 2)
+        os.clearTimeout(ids[i]);
+    os.setTimeout(function () {
+        assert(log.join(), "a,d,b,b.job");
+        assert(count, 500);
+    }, 50);
+}
+
+function test_rw_handler()
+{
+    var fds, buf;
+
+    fds = os.pipe();
+    buf = new Uint8Array(16);
+    os.setReadHandler(fds[0], function () {
+        assert(os.read(fds[0], buf.buffer, 0, buf.length), 4);
+        os.setReadHandler(fds[0], null);
+        os.close(fds[0]);
+        os.close(fds[1]);
+    });
+    os.setWriteHandler(fds[1], function () {
+        os.write(fds[1], buf.buffer, 0, 4);
+        os.setWriteHandler(fds[1], null);
+    });
+}
+
 /* test closure variable handling when freeing asynchronous
    function */
 function test_async_gc()
@@ -322,15 +456,112 @@ function test_async_promise_rejection()
     os.setTimeout(() => { assert(counter, 3) }, 10);
 }
 
+function test_bytecode_cache()
+{
+    var dir = "tmp_bc_cache", main = "tmp_bc_main.js", dep = "tmp_bc_dep.js";
+    var i, files, err, f;
+
+    function write_file(fname, str) {
+        var f = std.open(fname, "w");
+        f.puts(str);
+        f.close();
+    }
+
+    function run() {
+        var fds, pid, f, str;
+        fds = os.pipe();
+        pid = os.exec(["./qjs", "--bytecode-cache", dir, main], {
+            stdout: fds[1], block: false, usePath: false });
+        os.close(fds[1]);
+        f = std.fdopen(fds[0], "r");
+        str = f.readAsString();
+        f.close();
+        os.waitpid(pid, 0);
+        return str;
+    }
+
+    if (os.stat("./qjs")[1] != 0)
+        return;
+    write_file(dep, "export function f(a) { return a * 2; }\n");
+    write_file(main, "import { f } from './tmp_bc_dep.js';\n" +
+               "function g() { throw Error('x'); }\n" +
+               "function h(a) { return a + 1; }\n" +
+               "try { g(); } catch(e) { print(f(21), e.stack.split('\\n')[0], String(h).length); }\n");
+    /* the second run uses the cache */
+    for(i = 0; i < 2; i++)
+        assert(run(), "42     at g (tmp_bc_main.js:2:27) 31\n");
+    [files, err] = os.readdir(dir);
+    assert(err, 0);
+    files = files.filter((n) => n.endsWith(".qbc"));
+    assert(files.length, 2);
+
+    /* a modified source is compiled again */
+    write_file(dep, "export function f(a) { return a * 3; }\n");
+    assert(run(), "63     at g (tmp_bc_main.js:2:27) 31\n");
+
+    [files, err] = os.readdir(dir);
+    for(f of files) {
+        if (f != "." && f != "..")
+            os.remove(dir + "/" + f);
+    }
+    os.remove(dir);
+    os.remove(main);
+    os.remove(dep);
+}
+
+function test_snapshot()
+{
+    var snap = "tmp_snap.bin", init = "tmp_snap_init.js";
+    var f;
+
+    function run(args) {
+        var fds, pid, f, str;
+        fds = os.pipe();
+        pid = os.exec(["./qjs"].concat(args), {
+            stdout: fds[1], block: false, usePath: false });
+        os.close(fds[1]);
+        f = std.fdopen(fds[0], "r");
+        str = f.readAsString();
+        f.close();
+        os.waitpid(pid, 0);
+        return str;
+    }
+
+    if (os.stat("./qjs")[1] != 0)
+        return;
+    f = std.open(init, "w");
+    f.puts("var counter = (function () { var n = 10; return () => n++; })();\n" +
+           "class Point { constructor(x) { this.x = x; } get double() { return this.x * 2; } }\n" +
+           "var tag = Symbol('tag'), m = new Map([['a', [1, 2.5, 'x']], [tag, /b+/g]]);\n" +
+           "Array.prototype.last = function () { return this[this.length - 1]; };\n" +
+           "delete globalThis.escape;\n" +
+           "counter();\n");
+    f.close();
+    run(["--save-snapshot", snap, init]);
+    assert(run(["--snapshot", snap, "-e",
+                "print(counter(), new Point(4).double, m.get('a').last(), " +
+                "m.get(tag).test('abb'), m.get(tag).lastIndex, " +
+                "typeof escape, typeof unescape)"]),
+           "11 8 x true 3 undefined function\n");
+    os.remove(snap);
+    os.remove(init);
+}
+
 test_printf();
 test_file1();
 test_file2();
 test_getline();
+test_utf8();
 test_popen();
 test_os();
 test_os_exec();
+test_bytecode_cache();
+test_snapshot();
 test_timer();
+test_timer_order();
+test_rw_handler();
 test_ext_json();
+test_json_parser();
 test_async_gc();
 test_async_promise_rejection();
 
@@ -21,6 +21,35 @@ function assert(actual, expected, message) {
 
 var worker;
 
+/* the buffer given to std.JSONParser.feed() may be detached by a
+   conversion or by the callback */
+function test_json_parser_detach()
+{
+    var ab, p, res;
+
+    function detach(ab) {
+        worker.postMessage({ type: "ignore" }, [ ab ]);
+    }
+
+    ab = new Uint8Array([0x5b, 0x31, 0x5d]).buffer; /* "[1]" */
+    p = new std.JSONParser((val) => {});
+    try {
+        p.feed(ab, { valueOf() { detach(ab); return 0; } });
+        assert(false);
+    } catch(e) {
+        assert(e instanceof TypeError);
+    }
+
+    ab = new Uint8Array([0x5b, 0x31, 0x2c, 0x32, 0x5d]).buffer; /* "[1,2]" */
+    res = [];
+    p = new std.JSONParser((val) => { res.push(val); if (res.length == 1) detach(ab); },
+                           { depth: 1 });
+    p.feed(ab);
+    p.end();
+    assert(res.join(), "1,2");
+    assert(ab.byteLength, 0);
+}
+
 function test_worker()
 {
     var counter;
@@ -47,6 +76,41 @@ function test_worker()
                 let buf = ev.buf;
                 /* check that the SharedArrayBuffer was modified */
                 assert(buf[2], 10);
+                /* test ArrayBuffer transfer */
+                let ab = new ArrayBuffer(100000);
+                let a = new Uint8Array(ab);
+                a[5] = 1;
+                /* nothing is detached if the transfer list is invalid */
+                let ab2 = new ArrayBuffer(10);
+                let err = null;
+                try {
+                    worker.postMessage({ type: "ignore" }, [ ab2, ab, ab2 ]);
+                } catch(e) {
+                    err = e;
+                }
+                assert(err instanceof TypeError);
+                err = null;
+                try {
+                    worker.postMessage({ type: "ignore" }, [ ab, {} ]);
+                } catch(e) {
+                    err = e;
+                }
+                assert(err instanceof TypeError);
+                assert(ab.byteLength, 100000);
+                assert(ab2.byteLength, 10);
+                assert(a[5], 1);
+                worker.postMessage({ type: "transfer", buf: a }, [ ab ]);
+                /* the sender ArrayBuffer is detached */
+                assert(ab.byteLength, 0);
+                assert(a.length, 0);
+            }
+            break;
+        case "transfer_done":
+            {
+                let a = ev.buf;
+                assert(a.length, 100000);
+                assert(a[5], 2);
+                test_json_parser_detach();
                 worker.postMessage({ type: "abort" });
             }
             break;
@@ -17,6 +17,12 @@ function handle_msg(e) {
         ev.buf[2] = 10;
         parent.postMessage({ type: "sab_done", buf: ev.buf });
         break;
+    case "transfer":
+        /* modify and send back the transferred ArrayBuffer */
+        ev.buf[5]++;
+        parent.postMessage({ type: "transfer_done", buf: ev.buf },
+                           [ ev.buf.buffer ]);
+        break;
     }
 }
 